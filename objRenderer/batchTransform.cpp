@@ -0,0 +1,284 @@
+// batchTransform
+// Version 3.1
+//
+// Description
+// These functions transform the InstanceTransform (scale, rotation quaternion, and position) of many instances of the object into the INSTANCEDATA structures read by the vertex shader from the instance buffer.
+//
+// The InstanceTransforms are stored as a structure of arrays (InstanceTransformArrays), so one SIMD register holds the same member of four (SSE) or eight (AVX2) instances,
+// and the rotation matrix of each of them is found with the same instructions that DirectXMath uses to find one. Only the stores rearrange the results: each group of four rows is transposed (_MM_TRANSPOSE4_PS)
+// so that each instance's six rows are written one after another, i.e., the INSTANCEDATA structures are written in order and can be written directly to a mapped D3D11_USAGE_DYNAMIC buffer.
+// The instances are divided among the threads of the job system (see jobSystem.h) when there are enough of them. Each range of instances is independent, so the result is the same for any number of threads.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Batch instance transform Header File.
+#include "batchTransform.h"
+
+// Vector Container Class.
+#include <vector>											// Vector class member functions resize, etc.
+
+// Job system Header File.
+#include "jobSystem.h"
+
+// SIMD Intrinsic Functions.
+// SSE2 is part of every x64 processor, and is assumed for x86 processors (DirectXMath assumes it too). AVX2 is used only when the program is compiled for it (/arch:AVX2, or -mavx2).
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define BATCH_TRANSFORM_SSE
+#include <immintrin.h>										// SSE and AVX intrinsic functions, e.g., _mm_mul_ps, _mm256_i32gather_ps.
+#endif
+
+//***
+// External Variable Global Definitions.
+//***
+
+bool BatchTransformSimdEnabled = true;
+
+// End: External Variable Global Definitions.
+
+// Constants of the TransformInstances function.
+static const int BatchTransformParallelMinimum = 4096;		// The instances are divided among the worker threads only if each thread gets at least this many instances.
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// InstanceWorldMatrix function: Definition
+//   This function returns the world matrix of the instance placed in the world by Transform, i.e., the matrix whose first three columns are stored in INSTANCEDATA.World.
+XMMATRIX InstanceWorldMatrix(const InstanceTransform& Transform)
+{
+	return XMMatrixScaling(Transform.Scale, Transform.Scale, Transform.Scale)
+		* XMMatrixRotationQuaternion(XMLoadFloat4(&Transform.Rotation))
+		* XMMatrixTranslation(Transform.Position.x, Transform.Position.y, Transform.Position.z);
+}
+
+// ResizeInstanceTransforms function: Definition
+//   This function sets the number of instances of Transforms to InstancesTotal. Added instances have the default InstanceTransform: no rotation, at the origin, with a scale of 1.
+void ResizeInstanceTransforms(InstanceTransformArrays& Transforms, int InstancesTotal)
+{
+	Transforms.RotationX.resize(InstancesTotal, 0.0f);
+	Transforms.RotationY.resize(InstancesTotal, 0.0f);
+	Transforms.RotationZ.resize(InstancesTotal, 0.0f);
+	Transforms.RotationW.resize(InstancesTotal, 1.0f);
+	Transforms.PositionX.resize(InstancesTotal, 0.0f);
+	Transforms.PositionY.resize(InstancesTotal, 0.0f);
+	Transforms.PositionZ.resize(InstancesTotal, 0.0f);
+	Transforms.Scale.resize(InstancesTotal, 1.0f);
+}
+
+// SetInstanceTransform function: Definition
+//   This function stores Transform as the InstanceTransform of instance Instance of Transforms.
+void SetInstanceTransform(InstanceTransformArrays& Transforms, int Instance, const InstanceTransform& Transform)
+{
+	Transforms.RotationX[Instance] = Transform.Rotation.x;
+	Transforms.RotationY[Instance] = Transform.Rotation.y;
+	Transforms.RotationZ[Instance] = Transform.Rotation.z;
+	Transforms.RotationW[Instance] = Transform.Rotation.w;
+	Transforms.PositionX[Instance] = Transform.Position.x;
+	Transforms.PositionY[Instance] = Transform.Position.y;
+	Transforms.PositionZ[Instance] = Transform.Position.z;
+	Transforms.Scale[Instance] = Transform.Scale;
+}
+
+// GetInstanceTransform function: Definition
+//   This function returns the InstanceTransform of instance Instance of Transforms.
+InstanceTransform GetInstanceTransform(const InstanceTransformArrays& Transforms, int Instance)
+{
+	InstanceTransform transform;
+	transform.Rotation = XMFLOAT4(Transforms.RotationX[Instance], Transforms.RotationY[Instance], Transforms.RotationZ[Instance], Transforms.RotationW[Instance]);
+	transform.Position = XMFLOAT3(Transforms.PositionX[Instance], Transforms.PositionY[Instance], Transforms.PositionZ[Instance]);
+	transform.Scale = Transforms.Scale[Instance];
+	return transform;
+}
+
+// InstanceFill function: Definition
+//   This function fills Result, the INSTANCEDATA structure of the instance placed in the world by Transform, with DirectXMath functions.
+//   The world matrix is scale, then rotation, then translation. Its first three columns are the rows of the transposed rotation matrix, scaled, with the translation in the fourth component.
+static void InstanceFill(const InstanceTransform& Transform, INSTANCEDATA& Result)
+{
+	// The rows of the transposed rotation matrix. The fourth component of each of the first three rows is 0.
+	XMMATRIX rotation = XMMatrixTranspose(XMMatrixRotationQuaternion(XMLoadFloat4(&Transform.Rotation)));
+
+	XMStoreFloat4(&Result.World[0], XMVectorSetW(XMVectorScale(rotation.r[0], Transform.Scale), Transform.Position.x));
+	XMStoreFloat4(&Result.World[1], XMVectorSetW(XMVectorScale(rotation.r[1], Transform.Scale), Transform.Position.y));
+	XMStoreFloat4(&Result.World[2], XMVectorSetW(XMVectorScale(rotation.r[2], Transform.Scale), Transform.Position.z));
+	XMStoreFloat4(&Result.Normal[0], rotation.r[0]);
+	XMStoreFloat4(&Result.Normal[1], rotation.r[1]);
+	XMStoreFloat4(&Result.Normal[2], rotation.r[2]);
+}
+
+#ifdef BATCH_TRANSFORM_SSE
+// BatchTransformStore4 function: Definition
+//   This function writes the INSTANCEDATA structures of four consecutive instances, Result[0] to Result[3], from the members of their rows held one instance per SIMD lane:
+//   Rotation[j][c] is component c of row j of the transposed rotation matrix, Scale is the scale, and Position[j] is component j of the position.
+//   Each row is transposed from one component per register to one instance per register, and each instance's six rows are then written one after another.
+static inline void BatchTransformStore4(const __m128 Rotation[3][3], __m128 Scale, const __m128 Position[3], INSTANCEDATA* Result)
+{
+	__m128 world[3][4], normal[3][4];
+	for (int j = 0; j < 3; j++)
+	{
+		world[j][0] = _mm_mul_ps(Rotation[j][0], Scale);
+		world[j][1] = _mm_mul_ps(Rotation[j][1], Scale);
+		world[j][2] = _mm_mul_ps(Rotation[j][2], Scale);
+		world[j][3] = Position[j];
+		_MM_TRANSPOSE4_PS(world[j][0], world[j][1], world[j][2], world[j][3]);
+
+		normal[j][0] = Rotation[j][0];
+		normal[j][1] = Rotation[j][1];
+		normal[j][2] = Rotation[j][2];
+		normal[j][3] = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(normal[j][0], normal[j][1], normal[j][2], normal[j][3]);
+	}
+
+	for (int k = 0; k < 4; k++)
+	{
+		_mm_storeu_ps(&Result[k].World[0].x, world[0][k]);
+		_mm_storeu_ps(&Result[k].World[1].x, world[1][k]);
+		_mm_storeu_ps(&Result[k].World[2].x, world[2][k]);
+		_mm_storeu_ps(&Result[k].Normal[0].x, normal[0][k]);
+		_mm_storeu_ps(&Result[k].Normal[1].x, normal[1][k]);
+		_mm_storeu_ps(&Result[k].Normal[2].x, normal[2][k]);
+	}
+}
+
+// BatchTransformSse function: Definition
+//   This function fills Result[i] for four consecutive i from the InstanceTransforms of instances First[0] to First[3] of Transforms (or First to First + 3, if Instances is nullptr), four instances at a time.
+//   The transposed rotation matrix of a unit quaternion (x, y, z, w) is:
+//     1 - 2(yy + zz)   2(xy - zw)       2(xz + yw)
+//     2(xy + zw)       1 - 2(xx + zz)   2(yz - xw)
+//     2(xz - yw)       2(yz + xw)       1 - 2(xx + yy)
+static inline void BatchTransformSse(const InstanceTransformArrays& Transforms, const int* Instances, int First, INSTANCEDATA* Result)
+{
+	__m128 x, y, z, w, scale, position[3];
+	if (Instances == nullptr)
+	{
+		x = _mm_loadu_ps(&Transforms.RotationX[First]);
+		y = _mm_loadu_ps(&Transforms.RotationY[First]);
+		z = _mm_loadu_ps(&Transforms.RotationZ[First]);
+		w = _mm_loadu_ps(&Transforms.RotationW[First]);
+		scale = _mm_loadu_ps(&Transforms.Scale[First]);
+		position[0] = _mm_loadu_ps(&Transforms.PositionX[First]);
+		position[1] = _mm_loadu_ps(&Transforms.PositionY[First]);
+		position[2] = _mm_loadu_ps(&Transforms.PositionZ[First]);
+	}
+	else
+	{
+		const int* i = Instances + First;
+		x = _mm_setr_ps(Transforms.RotationX[i[0]], Transforms.RotationX[i[1]], Transforms.RotationX[i[2]], Transforms.RotationX[i[3]]);
+		y = _mm_setr_ps(Transforms.RotationY[i[0]], Transforms.RotationY[i[1]], Transforms.RotationY[i[2]], Transforms.RotationY[i[3]]);
+		z = _mm_setr_ps(Transforms.RotationZ[i[0]], Transforms.RotationZ[i[1]], Transforms.RotationZ[i[2]], Transforms.RotationZ[i[3]]);
+		w = _mm_setr_ps(Transforms.RotationW[i[0]], Transforms.RotationW[i[1]], Transforms.RotationW[i[2]], Transforms.RotationW[i[3]]);
+		scale = _mm_setr_ps(Transforms.Scale[i[0]], Transforms.Scale[i[1]], Transforms.Scale[i[2]], Transforms.Scale[i[3]]);
+		position[0] = _mm_setr_ps(Transforms.PositionX[i[0]], Transforms.PositionX[i[1]], Transforms.PositionX[i[2]], Transforms.PositionX[i[3]]);
+		position[1] = _mm_setr_ps(Transforms.PositionY[i[0]], Transforms.PositionY[i[1]], Transforms.PositionY[i[2]], Transforms.PositionY[i[3]]);
+		position[2] = _mm_setr_ps(Transforms.PositionZ[i[0]], Transforms.PositionZ[i[1]], Transforms.PositionZ[i[2]], Transforms.PositionZ[i[3]]);
+	}
+
+	__m128 one = _mm_set1_ps(1.0f);
+	__m128 x2 = _mm_add_ps(x, x), y2 = _mm_add_ps(y, y), z2 = _mm_add_ps(z, z);
+	__m128 xx = _mm_mul_ps(x, x2), yy = _mm_mul_ps(y, y2), zz = _mm_mul_ps(z, z2);
+	__m128 xy = _mm_mul_ps(x, y2), xz = _mm_mul_ps(x, z2), yz = _mm_mul_ps(y, z2);
+	__m128 xw = _mm_mul_ps(w, x2), yw = _mm_mul_ps(w, y2), zw = _mm_mul_ps(w, z2);
+
+	__m128 rotation[3][3] = {
+		{ _mm_sub_ps(one, _mm_add_ps(yy, zz)), _mm_sub_ps(xy, zw), _mm_add_ps(xz, yw) },
+		{ _mm_add_ps(xy, zw), _mm_sub_ps(one, _mm_add_ps(xx, zz)), _mm_sub_ps(yz, xw) },
+		{ _mm_sub_ps(xz, yw), _mm_add_ps(yz, xw), _mm_sub_ps(one, _mm_add_ps(xx, yy)) } };
+	BatchTransformStore4(rotation, scale, position, Result);
+}
+
+#ifdef __AVX2__
+// BatchTransformAvx2 function: Definition
+//   This function fills Result[i] for eight consecutive i, as the BatchTransformSse function does for four, eight instances at a time. The rows are stored four instances at a time by the BatchTransformStore4 function.
+static inline void BatchTransformAvx2(const InstanceTransformArrays& Transforms, const int* Instances, int First, INSTANCEDATA* Result)
+{
+	__m256 x, y, z, w, scale, position[3];
+	if (Instances == nullptr)
+	{
+		x = _mm256_loadu_ps(&Transforms.RotationX[First]);
+		y = _mm256_loadu_ps(&Transforms.RotationY[First]);
+		z = _mm256_loadu_ps(&Transforms.RotationZ[First]);
+		w = _mm256_loadu_ps(&Transforms.RotationW[First]);
+		scale = _mm256_loadu_ps(&Transforms.Scale[First]);
+		position[0] = _mm256_loadu_ps(&Transforms.PositionX[First]);
+		position[1] = _mm256_loadu_ps(&Transforms.PositionY[First]);
+		position[2] = _mm256_loadu_ps(&Transforms.PositionZ[First]);
+	}
+	else
+	{
+		__m256i i = _mm256_loadu_si256((const __m256i*)(Instances + First));
+		x = _mm256_i32gather_ps(Transforms.RotationX.data(), i, 4);
+		y = _mm256_i32gather_ps(Transforms.RotationY.data(), i, 4);
+		z = _mm256_i32gather_ps(Transforms.RotationZ.data(), i, 4);
+		w = _mm256_i32gather_ps(Transforms.RotationW.data(), i, 4);
+		scale = _mm256_i32gather_ps(Transforms.Scale.data(), i, 4);
+		position[0] = _mm256_i32gather_ps(Transforms.PositionX.data(), i, 4);
+		position[1] = _mm256_i32gather_ps(Transforms.PositionY.data(), i, 4);
+		position[2] = _mm256_i32gather_ps(Transforms.PositionZ.data(), i, 4);
+	}
+
+	__m256 one = _mm256_set1_ps(1.0f);
+	__m256 x2 = _mm256_add_ps(x, x), y2 = _mm256_add_ps(y, y), z2 = _mm256_add_ps(z, z);
+	__m256 xx = _mm256_mul_ps(x, x2), yy = _mm256_mul_ps(y, y2), zz = _mm256_mul_ps(z, z2);
+	__m256 xy = _mm256_mul_ps(x, y2), xz = _mm256_mul_ps(x, z2), yz = _mm256_mul_ps(y, z2);
+	__m256 xw = _mm256_mul_ps(w, x2), yw = _mm256_mul_ps(w, y2), zw = _mm256_mul_ps(w, z2);
+
+	__m256 rotation[3][3] = {
+		{ _mm256_sub_ps(one, _mm256_add_ps(yy, zz)), _mm256_sub_ps(xy, zw), _mm256_add_ps(xz, yw) },
+		{ _mm256_add_ps(xy, zw), _mm256_sub_ps(one, _mm256_add_ps(xx, zz)), _mm256_sub_ps(yz, xw) },
+		{ _mm256_sub_ps(xz, yw), _mm256_add_ps(yz, xw), _mm256_sub_ps(one, _mm256_add_ps(xx, yy)) } };
+
+	// Store the lower four instances, then the upper four.
+	for (int half = 0; half < 2; half++)
+	{
+		__m128 rotation4[3][3], position4[3];
+		for (int j = 0; j < 3; j++)
+		{
+			for (int c = 0; c < 3; c++)
+				rotation4[j][c] = half == 0 ? _mm256_castps256_ps128(rotation[j][c]) : _mm256_extractf128_ps(rotation[j][c], 1);
+			position4[j] = half == 0 ? _mm256_castps256_ps128(position[j]) : _mm256_extractf128_ps(position[j], 1);
+		}
+		__m128 scale4 = half == 0 ? _mm256_castps256_ps128(scale) : _mm256_extractf128_ps(scale, 1);
+		BatchTransformStore4(rotation4, scale4, position4, Result + half * 4);
+	}
+}
+#endif
+#endif
+
+// BatchTransformRange function: Definition
+//   This function fills Result[i] for each i from Begin to End - 1, eight (AVX2) or four (SSE) instances at a time while enough remain, and then one at a time.
+static void BatchTransformRange(const InstanceTransformArrays& Transforms, const int* Instances, int Begin, int End, INSTANCEDATA* Result)
+{
+	int i = Begin;
+#ifdef BATCH_TRANSFORM_SSE
+	if (BatchTransformSimdEnabled)
+	{
+#ifdef __AVX2__
+		for (; i + 8 <= End; i += 8)
+			BatchTransformAvx2(Transforms, Instances, i, Result + i);
+#endif
+		for (; i + 4 <= End; i += 4)
+			BatchTransformSse(Transforms, Instances, i, Result + i);
+	}
+#endif
+	for (; i < End; i++)
+		InstanceFill(GetInstanceTransform(Transforms, Instances != nullptr ? Instances[i] : i), Result[i]);
+}
+
+// TransformInstances function: Definition
+//   This function fills Result[i], for each i from 0 to InstancesTotal - 1, with the INSTANCEDATA structure of instance Instances[i] of Transforms, or of instance i if Instances is nullptr.
+//   Instances allows a subset of the instances (e.g., those not culled) to be written in any order (e.g., grouped by level of detail) without first copying their InstanceTransforms.
+//   The instances are divided among the worker threads when there are enough of them. Result must have room for InstancesTotal INSTANCEDATA structures.
+void TransformInstances(const InstanceTransformArrays& Transforms, const int* Instances, int InstancesTotal, INSTANCEDATA* Result)
+{
+	JobParallelFor(InstancesTotal, BatchTransformParallelMinimum, [&](int Begin, int End)
+		{
+			BatchTransformRange(Transforms, Instances, Begin, End, Result);
+		});
+}
@@ -0,0 +1,82 @@
+// batchTransform Header File
+// Version 3.1
+//
+// Description
+// Batch instance transform Header File
+// This header file contains the declarations used to store the scale, rotation, and position of many instances of the object as a structure of arrays, and to transform them, several instances at a time with SIMD instructions and divided among the worker threads,
+// into the INSTANCEDATA structures (world matrix and normal matrix) read by the vertex shader from the instance buffer.
+// None of these functions use Direct3D. Include it in all source files that place or transform instances of the object, e.g., the instanceBuilder functions and the objRenderer program.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Wavefront .obj file I/O Header File.
+// Includes the DirectXMath Header File and the Vector Container Class.
+#include "objReader.h"
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the InstanceTransform 'named structure' data type.
+// An InstanceTransform places one instance of the object in the world: the object is scaled, then rotated, then translated.
+// The scale is the same along every axis, so the vertex normal vectors are transformed by the rotation alone, and the bounds of the object (its bounding sphere, and the normal cones of its meshlets) remain valid after the transformation.
+struct InstanceTransform {
+	XMFLOAT4 Rotation = { 0.0f, 0.0f, 0.0f, 1.0f };			// The rotation, as a unit quaternion (see XMQuaternionRotationRollPitchYaw, etc.).
+	XMFLOAT3 Position = { 0.0f, 0.0f, 0.0f };				// The translation, i.e., the position of the object's origin in the world.
+	float Scale = 1.0f;										// The scale.
+};
+
+// Declare the InstanceTransformArrays 'named structure' data type.
+// The InstanceTransform of every instance, stored as a structure of arrays: element i of each array is one member of the InstanceTransform of instance i.
+// Each SIMD register then holds the same member of consecutive instances, so several instances are transformed by each instruction, without rearranging the members first.
+struct InstanceTransformArrays {
+	std::vector<float> RotationX, RotationY, RotationZ, RotationW;	// The rotation quaternion of each instance.
+	std::vector<float> PositionX, PositionY, PositionZ;		// The position of each instance.
+	std::vector<float> Scale;								// The scale of each instance.
+};
+
+// Declare the INSTANCEDATA 'named structure' data type.
+// An INSTANCEDATA holds the transformations of one instance of the object, read by the vertex shader from the instance buffer (the second vertex buffer, whose input elements are D3D11_INPUT_PER_INSTANCE_DATA).
+// Each matrix is stored as its first three columns, i.e., a transformed coordinate is the dot product of one row with the untransformed (x, y, z, 1): the fourth column of an affine transformation is always (0, 0, 0, 1) and is not stored.
+// If the INSTANCEDATA structure is changed then the instance input element descriptions (defined in objRenderer.cpp) and the INSTANCE structure (defined in shaders.hlsl) must be changed accordingly.
+struct INSTANCEDATA {
+	XMFLOAT4 World[3];										// The world matrix: scale, rotation, and translation. DXGI_FORMAT_R32G32B32A32_FLOAT x 3.
+	XMFLOAT4 Normal[3];										// The matrix that transforms the vertex normal vectors, i.e., the rotation. The fourth component of each row is 0. DXGI_FORMAT_R32G32B32A32_FLOAT x 3.
+};
+
+// End: Structure Declarations.
+
+//***
+// External Variable Global Declarations.
+//***
+
+// BatchTransformSimdEnabled selects whether the TransformInstances function transforms several instances at a time with SSE (four instances) or AVX2 (eight instances, when the program is compiled for AVX2) instructions. It is true by default.
+// When it is false, or the processor is not an x86 or x64 processor, each instance is transformed on its own with DirectXMath functions. The INSTANCEDATA structures are the same either way, to within rounding.
+extern bool BatchTransformSimdEnabled;
+
+// End: External Variable Global Declarations.
+
+//***
+// Global Function Declarations.
+//***
+
+XMMATRIX InstanceWorldMatrix(const InstanceTransform& Transform);																	// The InstanceWorldMatrix function returns the world matrix of an instance.
+void ResizeInstanceTransforms(InstanceTransformArrays& Transforms, int InstancesTotal);											// The ResizeInstanceTransforms function sets the number of instances of Transforms. Added instances have the default InstanceTransform.
+void SetInstanceTransform(InstanceTransformArrays& Transforms, int Instance, const InstanceTransform& Transform);				// The SetInstanceTransform function stores the InstanceTransform of one instance of Transforms.
+InstanceTransform GetInstanceTransform(const InstanceTransformArrays& Transforms, int Instance);									// The GetInstanceTransform function returns the InstanceTransform of one instance of Transforms.
+void TransformInstances(const InstanceTransformArrays& Transforms, const int* Instances, int InstancesTotal, INSTANCEDATA* Result);	// The TransformInstances function fills Result[i] with the INSTANCEDATA structure of instance Instances[i] (or instance i, if Instances is nullptr) of Transforms, for each of InstancesTotal instances.
+
+// End: Global Function Declarations.
+
+// End: Global Declarations.
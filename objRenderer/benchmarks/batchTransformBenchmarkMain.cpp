@@ -0,0 +1,152 @@
+// batchTransformBenchmarkMain
+// Version 3.1
+//
+// Description
+// The batchTransformBenchmark program measures how many instance matrices (INSTANCEDATA structures) per second the TransformInstances function fills, in total and per thread, apart from the objRenderer program, on any platform, e.g., Linux (see CMakeLists.txt).
+// It transforms the same random instances with 1 job system thread, doubling, up to the maximum, each with the SIMD path (SSE, or AVX2 when the program is compiled for it) and with DirectXMath functions alone,
+// and prints the fastest of several repetitions of each.
+// Matrices per second per thread stays about the same as threads are added while the work is limited by the processors, and falls when it is limited by memory bandwidth, or when there are more threads than processors.
+//
+// Usage
+// batchTransformBenchmark [-instances Count] [-repetitions Count] [-threads MaximumThreads]
+//   -instances    The number of instances transformed each repetition. The default is 1000000.
+//   -repetitions  The number of times the instances are transformed with each number of threads; the fastest is reported. The default is 20.
+//   -threads      The largest number of job system threads. The default is the number of processors.
+// It returns 0 on success, or 1 if an argument is not valid.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Batch instance transform Header File.
+#include "batchTransform.h"
+
+// Job system Header File.
+#include "jobSystem.h"
+
+// Standard Input and Output Functions.
+#include <cstdio>											// printf, fprintf.
+
+// Standard Library Functions.
+#include <cstdlib>											// atoi.
+
+// String Functions.
+#include <cstring>											// strcmp.
+
+// Steady Clock.
+#include <chrono>											// Steady clock, used to time the TransformInstances function.
+
+// Thread Functions.
+#include <thread>											// Thread class member function hardware_concurrency.
+
+// Mathematical Functions.
+#include <cmath>											// Mathematical functions sin, cos.
+
+// Using Declarations and Directives.
+using std::vector;
+using std::strcmp;
+using std::atoi;
+using std::thread;
+namespace chrono = std::chrono;
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// PrintUsage function: Definition
+static int PrintUsage()
+{
+	fprintf(stderr, "Usage: batchTransformBenchmark [-instances Count] [-repetitions Count] [-threads MaximumThreads]\n");
+	return 1;
+}
+
+// BenchmarkTransform function: Definition
+//   This function transforms every instance of Transforms into Result Repetitions times, and returns the fastest time, in seconds.
+static double BenchmarkTransform(const InstanceTransformArrays& Transforms, vector<INSTANCEDATA>& Result, int Repetitions)
+{
+	double fastest = 0.0;
+	for (int r = 0; r < Repetitions; r++)
+	{
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		TransformInstances(Transforms, nullptr, (int)Result.size(), Result.data());
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		if (r == 0 || seconds < fastest)
+			fastest = seconds;
+	}
+	return fastest;
+}
+
+// main function: Definition
+int main(int argc, char* argv[])
+{
+	int instancesTotal = 1000000;
+	int repetitions = 20;
+	int maximumThreads = (int)thread::hardware_concurrency();
+	if (maximumThreads < 1)									// hardware_concurrency returns 0 if the number of hardware threads cannot be determined.
+		maximumThreads = 1;
+
+	// Read the command line arguments.
+	for (int a = 1; a < argc; a++)
+	{
+		bool hasValue = a + 1 < argc;
+		if (strcmp(argv[a], "-instances") == 0 && hasValue)
+			instancesTotal = atoi(argv[++a]);
+		else if (strcmp(argv[a], "-repetitions") == 0 && hasValue)
+			repetitions = atoi(argv[++a]);
+		else if (strcmp(argv[a], "-threads") == 0 && hasValue)
+			maximumThreads = atoi(argv[++a]);
+		else
+			return PrintUsage();
+	}
+	if (instancesTotal < 1 || repetitions < 1 || maximumThreads < 1)
+		return PrintUsage();
+
+	// The instances are spread over a grid, each turned and scaled differently, as the objRenderer program places them.
+	InstanceTransformArrays transforms;
+	ResizeInstanceTransforms(transforms, instancesTotal);
+	for (int i = 0; i < instancesTotal; i++)
+	{
+		InstanceTransform transform;
+		float angle = (float)i * 0.01f;
+		transform.Rotation = XMFLOAT4(0.0f, sinf(angle * 0.5f), 0.0f, cosf(angle * 0.5f));
+		transform.Position = XMFLOAT3((float)(i % 1000), 0.0f, (float)(i / 1000));
+		transform.Scale = 1.0f + (float)(i % 7) * 0.1f;
+		SetInstanceTransform(transforms, i, transform);
+	}
+	vector<INSTANCEDATA> result(instancesTotal);
+
+#ifdef __AVX2__
+	const char* simdName = "AVX2";
+#else
+	const char* simdName = "SSE";
+#endif
+	printf("%d instances, %d bytes each, %u processors, fastest of %d repetitions\n", instancesTotal, (int)sizeof(INSTANCEDATA), thread::hardware_concurrency(), repetitions);
+	printf("%8s %12s %18s %18s %18s %18s\n", "Threads", "Path", "Seconds", "Matrices/s", "Matrices/s/thread", "GB/s written");
+	for (int threads = 1; ; threads = threads * 2 < maximumThreads ? threads * 2 : maximumThreads)
+	{
+		JobSystemShutdown();								// JobSystemThreads is read when the job system is started.
+		JobSystemThreads = threads;
+		for (int simd = 1; simd >= 0; simd--)
+		{
+			BatchTransformSimdEnabled = simd == 1;
+			double seconds = BenchmarkTransform(transforms, result, repetitions);
+			double matricesPerSecond = seconds > 0.0 ? instancesTotal / seconds : 0.0;
+			printf("%8d %12s %18.6f %18.0f %18.0f %18.2f\n", threads, simd == 1 ? simdName : "DirectXMath", seconds, matricesPerSecond, matricesPerSecond / threads,
+				matricesPerSecond * sizeof(INSTANCEDATA) / 1.0e9);
+		}
+		if (threads == maximumThreads)
+			break;
+	}
+	BatchTransformSimdEnabled = true;
+	JobSystemShutdown();
+
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
+
+// End: Function Definitions.
@@ -0,0 +1,166 @@
+// instanceBuilderBenchmarkMain
+// Version 3.1
+//
+// Description
+// The instanceBuilderBenchmark program measures how many instances per second the BuildInstanceBatches function culls, assigns a level of detail, groups into batches, and writes to the instance buffer, apart from the objRenderer program,
+// on any platform, e.g., Linux (see CMakeLists.txt).
+// The instances are placed, and seen, as the objRenderer program places and sees them: two in front of the camera, and the rest on a square grid behind them, most of it beyond the far plane.
+// It batches the same instances with 1 job system thread, doubling, up to the maximum, and prints the fastest of several repetitions of each, with the number of instances drawn and of batches, which are the same for every number of threads.
+//
+// Usage
+// instanceBuilderBenchmark [-instances Count] [-repetitions Count] [-threads MaximumThreads]
+//   -instances    The number of instances batched each repetition. The default is 100000.
+//   -repetitions  The number of times the instances are batched with each number of threads; the fastest is reported. The default is 20.
+//   -threads      The largest number of job system threads. The default is the number of processors.
+// It returns 0 on success, 1 if an argument is not valid, or 2 if the number of threads changed the instances drawn.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Instance data Header File.
+#include "instanceBuilder.h"
+
+// Job system Header File.
+#include "jobSystem.h"
+
+// Standard Input and Output Functions.
+#include <cstdio>											// printf, fprintf.
+
+// Standard Library Functions.
+#include <cstdlib>											// atoi.
+
+// String Functions.
+#include <cstring>											// strcmp.
+
+// Steady Clock.
+#include <chrono>											// Steady clock, used to time the BuildInstanceBatches function.
+
+// Thread Functions.
+#include <thread>											// Thread class member function hardware_concurrency.
+
+// Mathematical Functions.
+#include <cmath>											// Mathematical functions sin, cos, sqrt, ceil, tan.
+
+// Using Declarations and Directives.
+using std::vector;
+using std::strcmp;
+using std::atoi;
+using std::thread;
+namespace chrono = std::chrono;
+
+// The bounding sphere of the object, in object space.
+static const XMFLOAT3 BenchmarkBoundsCenter(0.0f, 0.0f, 0.0f);
+static const float BenchmarkBoundsRadius = 2.0f;
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// PrintUsage function: Definition
+static int PrintUsage()
+{
+	fprintf(stderr, "Usage: instanceBuilderBenchmark [-instances Count] [-repetitions Count] [-threads MaximumThreads]\n");
+	return 1;
+}
+
+// main function: Definition
+int main(int argc, char* argv[])
+{
+	int instancesTotal = 100000;
+	int repetitions = 20;
+	int maximumThreads = (int)thread::hardware_concurrency();
+	if (maximumThreads < 1)									// hardware_concurrency returns 0 if the number of hardware threads cannot be determined.
+		maximumThreads = 1;
+
+	// Read the command line arguments.
+	for (int a = 1; a < argc; a++)
+	{
+		bool hasValue = a + 1 < argc;
+		if (strcmp(argv[a], "-instances") == 0 && hasValue)
+			instancesTotal = atoi(argv[++a]);
+		else if (strcmp(argv[a], "-repetitions") == 0 && hasValue)
+			repetitions = atoi(argv[++a]);
+		else if (strcmp(argv[a], "-threads") == 0 && hasValue)
+			maximumThreads = atoi(argv[++a]);
+		else
+			return PrintUsage();
+	}
+	if (instancesTotal < 1 || repetitions < 1 || maximumThreads < 1)
+		return PrintUsage();
+
+	// The instances, placed as the PlaceObjectInstances function of the objRenderer program places them, each turned differently.
+	InstanceTransformArrays transforms;
+	ResizeInstanceTransforms(transforms, instancesTotal);
+	int gridTotal = instancesTotal - 2;
+	int side = gridTotal > 0 ? (int)std::ceil(std::sqrt((float)gridTotal)) : 1;
+	float spacing = 2.5f * BenchmarkBoundsRadius;
+	for (int i = 0; i < instancesTotal; i++)
+	{
+		InstanceTransform transform;
+		float angle = (float)i * 0.01f;
+		transform.Rotation = XMFLOAT4(0.0f, std::sin(angle * 0.5f), 0.0f, std::cos(angle * 0.5f));
+		if (i == 1)
+			transform.Position = XMFLOAT3(0.0f, 3.0f, 0.0f);
+		else if (i > 1)
+			transform.Position = XMFLOAT3(((i - 2) % side - (side - 1) * 0.5f) * spacing, 0.0f, -((i - 2) / side + 1) * spacing);
+		SetInstanceTransform(transforms, i, transform);
+	}
+
+	// The camera of the objRenderer program, and four levels of detail, each with twice the geometric error of the one before it, so the instances drawn are divided among all four.
+	XMVECTOR eye = XMVectorSet(0.0f, 9.0f, 24.0f, 0.0f);
+	float fovAngleY = XMConvertToRadians(45.0f);
+	XMMATRIX matViewProjection = XMMatrixMultiply(XMMatrixLookAtLH(eye, XMVectorSet(0.0f, 0.0f, 0.0f, 0.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)),
+		XMMatrixPerspectiveFovLH(fovAngleY, 800.0f / 600.0f, 1.0f, 100.0f));
+	float projectionScale = (600.0f / 2.0f) / std::tan(fovAngleY / 2.0f);
+	MeshLod lods[4];
+	for (int l = 1; l < 4; l++)
+		lods[l].Error = 0.02f * (float)(1 << l);
+
+	vector<INSTANCEDATA> result(instancesTotal);
+	vector<int> order;
+	vector<InstanceBatch> batches;
+	printf("%d instances, %u processors, fastest of %d repetitions\n", instancesTotal, thread::hardware_concurrency(), repetitions);
+	printf("%8s %18s %18s %18s %10s %10s\n", "Threads", "Seconds", "Instances/s", "Instances/s/thread", "Drawn", "Batches");
+	int firstDrawn = -1;
+	bool same = true;
+	for (int threads = 1; ; threads = threads * 2 < maximumThreads ? threads * 2 : maximumThreads)
+	{
+		JobSystemShutdown();								// JobSystemThreads is read when the job system is started.
+		JobSystemThreads = threads;
+		double fastest = 0.0;
+		int drawn = 0;
+		for (int r = 0; r < repetitions; r++)
+		{
+			chrono::steady_clock::time_point start = chrono::steady_clock::now();
+			drawn = BuildInstanceBatches(transforms, matViewProjection, eye, projectionScale, BenchmarkBoundsCenter, BenchmarkBoundsRadius, lods, 4, result.data(), order, batches);
+			double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+			if (r == 0 || seconds < fastest)
+				fastest = seconds;
+		}
+		if (firstDrawn < 0)
+			firstDrawn = drawn;
+		same = same && drawn == firstDrawn;
+		double instancesPerSecond = fastest > 0.0 ? instancesTotal / fastest : 0.0;
+		printf("%8d %18.6f %18.0f %18.0f %10d %10d\n", threads, fastest, instancesPerSecond, instancesPerSecond / threads, drawn, (int)batches.size());
+		if (threads == maximumThreads)
+			break;
+	}
+	JobSystemShutdown();
+
+	if (!same)
+	{
+		fprintf(stderr, "The number of instances drawn depends on the number of threads.\n");
+		return 2;
+	}
+
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
+
+// End: Function Definitions.
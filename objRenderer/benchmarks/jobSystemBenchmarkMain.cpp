@@ -0,0 +1,179 @@
+// jobSystemBenchmarkMain
+// Version 3.1
+//
+// Description
+// The jobSystemBenchmark program measures the throughput of the job system, in jobs per second, apart from the objRenderer program, on any platform, e.g., Linux (see CMakeLists.txt).
+// The jobs do no work of their own, so the time measured is the cost of creating, queuing, stealing, running, and finishing them. With 1 job system thread, doubling, up to the maximum, it runs:
+//   Flat       Jobs started by the main thread, as children of one job, and run mostly by the other threads, which steal them from the main thread's queue.
+//   Fan-out    Jobs started by jobs: the main thread starts one job per 100 jobs, each of which starts 100 children, as the objRenderer program's frame jobs start their own work.
+//   ParallelFor  JobParallelFor function calls, each divided into as many ranges as it allows (JobRangesPerThread per thread); each range is counted as a job.
+//                With 1 thread the JobParallelFor function calls Function once, without jobs, so this shows the cost of the call alone.
+// and prints the fastest of several repetitions of each.
+//
+// Usage
+// jobSystemBenchmark [-jobs Count] [-repetitions Count] [-threads MaximumThreads]
+//   -jobs         The number of jobs run each repetition. The default is 1000000.
+//   -repetitions  The number of times the jobs are run with each number of threads; the fastest is reported. The default is 5.
+//   -threads      The largest number of job system threads. The default is the number of processors.
+// It returns 0 on success, 1 if an argument is not valid, or 2 if a job did not run exactly once.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Job system Header File.
+#include "jobSystem.h"
+
+// Standard Input and Output Functions.
+#include <cstdio>											// printf, fprintf.
+
+// Standard Library Functions.
+#include <cstdlib>											// atoi.
+
+// String Functions.
+#include <cstring>											// strcmp.
+
+// Steady Clock.
+#include <chrono>											// Steady clock, used to time the jobs.
+
+// Thread Functions.
+#include <thread>											// Thread class member function hardware_concurrency.
+
+// Using Declarations and Directives.
+using std::strcmp;
+using std::atoi;
+using std::thread;
+using std::atomic;
+namespace chrono = std::chrono;
+
+// The number of children started by each job of the fan-out benchmark.
+static const int BenchmarkFanOut = 100;
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// PrintUsage function: Definition
+static int PrintUsage()
+{
+	fprintf(stderr, "Usage: jobSystemBenchmark [-jobs Count] [-repetitions Count] [-threads MaximumThreads]\n");
+	return 1;
+}
+
+// RunFlat function: Definition
+//   This function starts JobsTotal empty jobs from the main thread, as children of one job, and waits for them. It returns the number of jobs started, or -1 if a different number ran.
+static int RunFlat(int JobsTotal)
+{
+	atomic<int> runs(0);
+	Job* root = JobCreate(nullptr, nullptr);
+	for (int j = 0; j < JobsTotal; j++)
+		JobRun(JobCreate([&runs] { runs.fetch_add(1, std::memory_order_relaxed); }, root));
+	JobRun(root);
+	JobWait(root);
+	return runs == JobsTotal ? JobsTotal : -1;
+}
+
+// RunFanOut function: Definition
+//   This function starts one job per BenchmarkFanOut jobs from the main thread, each of which starts BenchmarkFanOut empty children, and waits for them all. It returns the number of jobs started, including the jobs that start children, or -1 if a different number ran.
+static int RunFanOut(int JobsTotal)
+{
+	atomic<int> runs(0);
+	int parentsTotal = JobsTotal / (BenchmarkFanOut + 1);
+	Job* root = JobCreate(nullptr, nullptr);
+	for (int j = 0; j < parentsTotal; j++)
+	{
+		Job* parent = JobCreate(nullptr, root);
+		parent->Function = [&runs, parent] {
+			runs.fetch_add(1, std::memory_order_relaxed);
+			for (int c = 0; c < BenchmarkFanOut; c++)
+				JobRun(JobCreate([&runs] { runs.fetch_add(1, std::memory_order_relaxed); }, parent));
+		};
+		JobRun(parent);
+	}
+	JobRun(root);
+	JobWait(root);
+	return runs == parentsTotal * (BenchmarkFanOut + 1) ? (int)runs : -1;
+}
+
+// RunParallelFor function: Definition
+//   This function calls the JobParallelFor function until about JobsTotal ranges have been run, each range handling one element. It returns the number of ranges, or -1 if an element was not handled exactly once.
+static int RunParallelFor(int JobsTotal)
+{
+	atomic<int> runs(0);
+	int rangesPerCall = JobSystemThreadsTotal() * 4;		// JobRangesPerThread.
+	int callsTotal = JobsTotal / rangesPerCall;
+	for (int call = 0; call < callsTotal; call++)
+		JobParallelFor(rangesPerCall, 1, [&runs](int Begin, int End) { runs.fetch_add(End - Begin, std::memory_order_relaxed); });
+	return runs == callsTotal * rangesPerCall ? (int)runs : -1;
+}
+
+// main function: Definition
+int main(int argc, char* argv[])
+{
+	int jobsTotal = 1000000;
+	int repetitions = 5;
+	int maximumThreads = (int)thread::hardware_concurrency();
+	if (maximumThreads < 1)									// hardware_concurrency returns 0 if the number of hardware threads cannot be determined.
+		maximumThreads = 1;
+
+	// Read the command line arguments.
+	for (int a = 1; a < argc; a++)
+	{
+		bool hasValue = a + 1 < argc;
+		if (strcmp(argv[a], "-jobs") == 0 && hasValue)
+			jobsTotal = atoi(argv[++a]);
+		else if (strcmp(argv[a], "-repetitions") == 0 && hasValue)
+			repetitions = atoi(argv[++a]);
+		else if (strcmp(argv[a], "-threads") == 0 && hasValue)
+			maximumThreads = atoi(argv[++a]);
+		else
+			return PrintUsage();
+	}
+	if (jobsTotal < BenchmarkFanOut + 1 || repetitions < 1 || maximumThreads < 1)
+		return PrintUsage();
+
+	struct Benchmark { const char* Name; int (*Run)(int); };
+	const Benchmark benchmarks[] = { { "Flat", RunFlat }, { "Fan-out", RunFanOut }, { "ParallelFor", RunParallelFor } };
+
+	printf("%d jobs, %u processors, fastest of %d repetitions\n", jobsTotal, thread::hardware_concurrency(), repetitions);
+	printf("%8s %12s %12s %14s %14s %16s\n", "Threads", "Benchmark", "Jobs", "Seconds", "Jobs/s", "Jobs/s/thread");
+	for (int threads = 1; ; threads = threads * 2 < maximumThreads ? threads * 2 : maximumThreads)
+	{
+		JobSystemShutdown();								// JobSystemThreads is read when the job system is started.
+		JobSystemThreads = threads;
+		for (const Benchmark& benchmark : benchmarks)
+		{
+			double fastest = 0.0;
+			int runs = 0;
+			for (int r = 0; r < repetitions; r++)
+			{
+				chrono::steady_clock::time_point start = chrono::steady_clock::now();
+				runs = benchmark.Run(jobsTotal);
+				double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+				if (runs < 0)
+				{
+					fprintf(stderr, "%s benchmark, %d threads: a job did not run exactly once.\n", benchmark.Name, threads);
+					JobSystemShutdown();
+					return 2;
+				}
+				if (r == 0 || seconds < fastest)
+					fastest = seconds;
+			}
+			double jobsPerSecond = fastest > 0.0 ? runs / fastest : 0.0;
+			printf("%8d %12s %12d %14.6f %14.0f %16.0f\n", threads, benchmark.Name, runs, fastest, jobsPerSecond, jobsPerSecond / threads);
+		}
+		if (threads == maximumThreads)
+			break;
+	}
+	JobSystemShutdown();
+
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
+
+// End: Function Definitions.
@@ -0,0 +1,215 @@
+// objReaderBenchmarkMain
+// Version 3.1
+//
+// Description
+// The objReaderBenchmark program runs the Wavefront .obj file benchmark suite (see objReaderBenchmark.h) from the command line, apart from the objRenderer program, on any platform, e.g., Linux (see CMakeLists.txt).
+// It generates, loads, and deletes one synthetic Wavefront .obj file for each shape, number of triangles, and fraction of shared vertex attribute statements, writes the results to a .csv file, and prints them as a table.
+//
+// Usage
+// objReaderBenchmark [-faces Shape [-maximumexponent Exponent] | -threadscaling MaximumThreads [-shape Shape]] [-maximum Triangles] [-repetitions Count] [-threads Count] [-stream] [-nodedup] [-directory Directory] [-output FileName]
+//   -faces        Rather than the suite, benchmark one Shape (Grid, Sphere, or Scan) from 1000 triangles, doubling, up to the maximum, and print how the time grows with the number of triangles (see RunObjReaderFaceScaling).
+//   -maximumexponent  With -faces, fail (return 1) if the time grows faster than the number of triangles to the power Exponent, e.g., 1.5 to catch quadratic growth.
+//   -threadscaling  Rather than the suite, benchmark one file of the maximum number of triangles with 1 thread, doubling, up to MaximumThreads (at most 64), print the speedup of each over 1 thread,
+//                 and fail if any loads a different Mesh than 1 thread (see RunObjReaderThreadScaling). -shape selects the Shape of the file; the default is Scan.
+//   -maximum      The largest number of triangles generated (1000 to 50000000). The default is 1000000.
+//   -repetitions  The number of times each file is loaded; the fastest is reported. The default is 3.
+//   -threads      The number of threads the LoadObj function parses with (LoadObjOptions::Threads). The default is 0, i.e., one per processor.
+//   -stream       Read each file with a stream (LoadObjOptions::MemoryMapped false) rather than mapping it into memory.
+//   -nodedup      Merge vertex attribute sets by their statement numbers rather than their values (LoadObjOptions::DedupByAttributes false).
+//   -chunkbytes   The smallest chunk a file is split into for the threads (LoadObjOptions::MinimumChunkBytes). The default is 1048576.
+//   -directory    The directory the files are generated in. The default is the current directory.
+//   -output       The .csv file the results are written to. The default is objReaderBenchmark.csv.
+// It returns 0 on success, or 1 if an argument is not valid, a file cannot be written or loaded, the time grows faster than -maximumexponent allows, or a number of threads loads a different Mesh than 1 thread.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Wavefront .obj file benchmark Header File.
+// Includes the Wavefront .obj file I/O Header File.
+#include "objReaderBenchmark.h"
+
+// Standard Input and Output Functions.
+#include <cstdio>											// printf, fprintf.
+
+// Standard Library Functions.
+#include <cstdlib>											// strtoull, strtod, atoi.
+
+// Thread Functions.
+#include <thread>											// Thread class member function hardware_concurrency.
+
+// String Functions.
+#include <cstring>											// strcmp.
+
+// Using Declarations and Directives.
+using std::vector;
+using std::strcmp;
+using std::strtoull;
+using std::strtod;
+using std::atoi;
+using std::thread;
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// PrintUsage function: Definition
+static int PrintUsage()
+{
+	fprintf(stderr, "Usage: objReaderBenchmark [-faces Shape [-maximumexponent Exponent] | -threadscaling MaximumThreads [-shape Shape]] [-maximum Triangles] [-repetitions Count] [-threads Count] [-stream] [-nodedup] [-chunkbytes Bytes] [-directory Directory] [-output FileName]\n");
+	return 1;
+}
+
+// RunFaceScaling function: Definition
+//   This function benchmarks Shape with the RunObjReaderFaceScaling function and prints, for each file, its time and the time per triangle, which stays about the same from file to file if the time grows linearly, then the fitted exponent.
+static int RunFaceScaling(ObjShape Shape, unsigned long long MaximumTriangles, const LoadObjOptions& Options, int Repetitions, const char* Directory, const char* OutputFileName, double MaximumExponent)
+{
+	vector<ObjBenchmarkResult> results;
+	double exponent;
+	if (RunObjReaderFaceScaling(Directory, Shape, MaximumTriangles, Options, Repetitions, OutputFileName, results, exponent) == 1 || results.empty())
+	{
+		fprintf(stderr, "objReaderBenchmark: a file could not be generated, loaded, or written.\n");
+		return 1;
+	}
+
+	printf("%-7s %10s %10s %10s %14s %12s\n", "Shape", "Triangles", "Vertices", "Total s", "Triangles/s", "ns/triangle");
+	for (const ObjBenchmarkResult& result : results)
+		printf("%-7s %10d %10d %10.5f %14.0f %12.1f\n", ObjShapeNames[result.Shape], result.PrimitivesTotal, result.VertexAttributeSetsTotal, result.TotalSeconds, result.TrianglesPerSecond,
+			result.PrimitivesTotal > 0 ? result.TotalSeconds * 1.0e9 / result.PrimitivesTotal : 0.0);
+	printf("Time grows as triangles^%.2f (1.00 is linear, 2.00 is quadratic).\n", exponent);
+	printf("Results written to %s\n", OutputFileName);
+
+	if (MaximumExponent > 0.0 && exponent > MaximumExponent)
+	{
+		fprintf(stderr, "objReaderBenchmark: the time grows as triangles^%.2f, faster than the maximum of triangles^%.2f.\n", exponent, MaximumExponent);
+		return 1;
+	}
+
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
+
+// RunThreadScaling function: Definition
+//   This function benchmarks one file of Shape with the RunObjReaderThreadScaling function and prints, for each number of threads, its time, its speedup over 1 thread, and its efficiency, i.e., the speedup divided by the number of threads.
+//   No number of threads can be faster than the number of processors, whose count is printed first.
+static int RunThreadScaling(ObjShape Shape, unsigned long long TrianglesTotal, int MaximumThreads, const LoadObjOptions& Options, int Repetitions, const char* Directory, const char* OutputFileName)
+{
+	vector<ObjBenchmarkResult> results;
+	int failed = RunObjReaderThreadScaling(Directory, Shape, TrianglesTotal, MaximumThreads, Options, Repetitions, OutputFileName, results);
+	if (results.empty())
+	{
+		fprintf(stderr, "objReaderBenchmark: a file could not be generated, loaded, or written.\n");
+		return 1;
+	}
+
+	printf("%s, %d triangles, %zu bytes, %zu-byte chunks, %u processors\n", ObjShapeNames[Shape], results[0].PrimitivesTotal, results[0].FileBytes, Options.MinimumChunkBytes, thread::hardware_concurrency());
+	printf("%8s %10s %14s %9s %11s\n", "Threads", "Total s", "Triangles/s", "Speedup", "Efficiency");
+	for (const ObjBenchmarkResult& result : results)
+	{
+		double speedup = result.TotalSeconds > 0.0 ? results[0].TotalSeconds / result.TotalSeconds : 0.0;
+		printf("%8d %10.5f %14.0f %9.2f %10.0f%%\n", result.Threads, result.TotalSeconds, result.TrianglesPerSecond, speedup, speedup * 100.0 / result.Threads);
+	}
+	printf("Results written to %s\n", OutputFileName);
+
+	if (failed)
+	{
+		fprintf(stderr, "objReaderBenchmark: %d threads did not load the same Mesh as 1 thread, or a file could not be loaded or written.\n", results.back().Threads);
+		return 1;
+	}
+
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
+
+// main function: Definition
+int main(int argc, char* argv[])
+{
+	unsigned long long maximumTriangles = 1000000;
+	int repetitions = 3;
+	const char* directory = ".";
+	const char* outputFileName = "objReaderBenchmark.csv";
+	LoadObjOptions options;
+	int faceScalingShape = -1;								// The shape benchmarked by -faces, or -1 to run the suite.
+	double maximumExponent = 0.0;							// The largest exponent allowed by -maximumexponent, or 0 for any.
+	int maximumThreads = 0;									// The largest number of threads benchmarked by -threadscaling, or 0 to run the suite.
+	int threadScalingShape = OBJ_SHAPE_SCAN;				// The shape benchmarked by -threadscaling.
+
+	// Read the command line arguments.
+	for (int a = 1; a < argc; a++)
+	{
+		bool hasValue = a + 1 < argc;
+		if (strcmp(argv[a], "-maximum") == 0 && hasValue)
+			maximumTriangles = strtoull(argv[++a], nullptr, 10);
+		else if (strcmp(argv[a], "-faces") == 0 && hasValue)
+		{
+			a++;
+			for (int shape = 0; shape < OBJ_SHAPES_TOTAL; shape++)
+				if (strcmp(argv[a], ObjShapeNames[shape]) == 0)
+					faceScalingShape = shape;
+			if (faceScalingShape == -1)
+				return PrintUsage();
+		}
+		else if (strcmp(argv[a], "-threadscaling") == 0 && hasValue)
+			maximumThreads = atoi(argv[++a]);
+		else if (strcmp(argv[a], "-shape") == 0 && hasValue)
+		{
+			a++;
+			threadScalingShape = -1;
+			for (int shape = 0; shape < OBJ_SHAPES_TOTAL; shape++)
+				if (strcmp(argv[a], ObjShapeNames[shape]) == 0)
+					threadScalingShape = shape;
+			if (threadScalingShape == -1)
+				return PrintUsage();
+		}
+		else if (strcmp(argv[a], "-chunkbytes") == 0 && hasValue)
+			options.MinimumChunkBytes = (size_t)strtoull(argv[++a], nullptr, 10);
+		else if (strcmp(argv[a], "-maximumexponent") == 0 && hasValue)
+			maximumExponent = strtod(argv[++a], nullptr);
+		else if (strcmp(argv[a], "-repetitions") == 0 && hasValue)
+			repetitions = atoi(argv[++a]);
+		else if (strcmp(argv[a], "-threads") == 0 && hasValue)
+			options.Threads = atoi(argv[++a]);
+		else if (strcmp(argv[a], "-stream") == 0)
+			options.MemoryMapped = false;
+		else if (strcmp(argv[a], "-nodedup") == 0)
+			options.DedupByAttributes = false;
+		else if (strcmp(argv[a], "-directory") == 0 && hasValue)
+			directory = argv[++a];
+		else if (strcmp(argv[a], "-output") == 0 && hasValue)
+			outputFileName = argv[++a];
+		else
+			return PrintUsage();
+	}
+	if (maximumTriangles < 1000 || repetitions < 1 || options.Threads < 0 || options.MinimumChunkBytes == 0 || maximumThreads < 0 || maximumThreads > 64)
+		return PrintUsage();
+
+	if (maximumThreads > 0)
+		return RunThreadScaling((ObjShape)threadScalingShape, maximumTriangles, maximumThreads, options, repetitions, directory, outputFileName);
+	if (faceScalingShape != -1)
+		return RunFaceScaling((ObjShape)faceScalingShape, maximumTriangles, options, repetitions, directory, outputFileName, maximumExponent);
+
+	// Run the suite. The .csv file is rewritten after each file is benchmarked, so the results of a long suite are kept if it is stopped.
+	vector<ObjBenchmarkResult> results;
+	if (RunObjReaderBenchmarks(directory, maximumTriangles, options, repetitions, outputFileName, results) == 1 || results.empty())
+	{
+		fprintf(stderr, "objReaderBenchmark: a file could not be generated, loaded, or written.\n");
+		return 1;
+	}
+
+	// Print the results.
+	printf("%-7s %10s %10s %7s %12s %9s %9s %9s %9s %9s %8s %14s\n", "Shape", "Triangles", "Vertices", "Shared", "Bytes", "Io s", "Tokens s", "Merge s", "Faces s", "Total s", "MB/s", "Triangles/s");
+	for (const ObjBenchmarkResult& result : results)
+		printf("%-7s %10d %10d %7.2f %12zu %9.4f %9.4f %9.4f %9.4f %9.4f %8.1f %14.0f\n", ObjShapeNames[result.Shape], result.PrimitivesTotal, result.VertexAttributeSetsTotal, result.SharedFraction, result.FileBytes,
+			result.IoSeconds, result.TokenizeSeconds, result.MergeSeconds, result.FacesSeconds, result.TotalSeconds, result.MegabytesPerSecond, result.TrianglesPerSecond);
+	printf("Results written to %s\n", outputFileName);
+
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
+
+// End: Function Definitions.
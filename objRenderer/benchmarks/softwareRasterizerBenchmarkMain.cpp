@@ -0,0 +1,197 @@
+// softwareRasterizerBenchmarkMain
+// Version 3.1
+//
+// Description
+// The softwareRasterizerBenchmark program measures the frames per second of the software rasterizer (the BenchmarkSoftwareRasterizer function), apart from the objRenderer program, on any platform, e.g., Linux (see CMakeLists.txt).
+// It renders the scene the objRenderer program draws, Text.obj textured with Wood.png and seen from the objRenderer program's camera, at 800x600 (the objRenderer program's window) and 3840x2160 (4K),
+// each with 1 sample per pixel and with 4 (4x MSAA, as the swap chain is created with), and each with and without SSE instructions (SoftwareRasterizerSimdEnabled). The frames rendered with and without them must be the same.
+// The last frame of each is written to a .bmp file in the current directory, e.g., softwareRasterizer_800x600_4x.bmp.
+//
+// Usage
+// softwareRasterizerBenchmark [-frames Count] [-instances Count] [-threads Count] [-directory Directory] [-nosave]
+//   -frames     The number of frames rendered at each resolution and number of samples. The default is 100.
+//   -instances  The number of instances of the object, placed as the PlaceObjectInstances function of the objRenderer program places them. The default is 2, as in the objRenderer program.
+//   -threads    The number of job system threads. The default is the number of processors.
+//   -directory  The directory holding Text.obj and Wood.png. The default is the current directory.
+//   -nosave     Do not write the .bmp files.
+// It returns 0 on success, 1 if an argument is not valid or Text.obj cannot be loaded, or 2 if the frames rendered with and without SSE instructions differ.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Software rasterizer Header File.
+// Includes the Batch instance transform Header File (the InstanceTransformArrays structure and the TransformInstances function) and the Image file I/O Header File.
+#include "softwareRasterizer.h"
+
+// Job system Header File.
+#include "jobSystem.h"
+
+// Standard Input and Output Functions.
+#include <cstdio>											// printf, fprintf, snprintf.
+
+// Standard Library Functions.
+#include <cstdlib>											// atoi.
+
+// String Functions.
+#include <cstring>											// strcmp.
+
+// Standard Encapsulated Data and Functions for Manipulating String Data.
+#include <string>											// String class, used to build the file names.
+
+// Mathematical Functions.
+#include <cmath>											// Mathematical functions sqrtf, ceilf, tanf.
+
+// Using Declarations and Directives.
+using std::vector;
+using std::string;
+using std::strcmp;
+using std::atoi;
+
+// The rotation of the instances, in radians: the first instance, and every other instance, is turned by SceneAngle around the y-axis, and the second instance the other way, as in a frame of the objRenderer program.
+static const float SceneAngle = 0.6f;
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// PrintUsage function: Definition
+static int PrintUsage()
+{
+	fprintf(stderr, "Usage: softwareRasterizerBenchmark [-frames Count] [-instances Count] [-threads Count] [-directory Directory] [-nosave]\n");
+	return 1;
+}
+
+// PlaceInstances function: Definition
+//   This function places InstancesTotal instances of an object of radius BoundsRadius as the PlaceObjectInstances function of the objRenderer program does, turns them as the AnimateObjectInstances function does, and writes their INSTANCEDATA structures to Result.
+static void PlaceInstances(int InstancesTotal, float BoundsRadius, vector<INSTANCEDATA>& Result)
+{
+	InstanceTransformArrays transforms;
+	ResizeInstanceTransforms(transforms, InstancesTotal);
+	int gridTotal = InstancesTotal - 2;
+	int side = gridTotal > 0 ? (int)ceilf(sqrtf((float)gridTotal)) : 1;
+	for (int i = 0; i < InstancesTotal; i++)
+	{
+		InstanceTransform transform = GetInstanceTransform(transforms, i);
+		XMStoreFloat4(&transform.Rotation, XMQuaternionRotationRollPitchYaw(0.0f, i == 1 ? -SceneAngle : SceneAngle, 0.0f));
+		if (i == 1)
+			transform.Position.y = 3.0f;
+		else if (i >= 2)
+		{
+			int row = (i - 2) / side, column = (i - 2) % side;
+			transform.Position.x = (column - (side - 1) * 0.5f) * 2.5f * BoundsRadius;
+			transform.Position.z = -(row + 1) * 2.5f * BoundsRadius;
+		}
+		SetInstanceTransform(transforms, i, transform);
+	}
+	Result.resize(InstancesTotal);
+	TransformInstances(transforms, nullptr, InstancesTotal, Result.data());
+}
+
+// SceneConstants function: Definition
+//   This function returns the constants of a frame of the objRenderer program drawn at Width x Height pixels: its camera, light, and ambient light.
+static SoftwareShaderConstants SceneConstants(int Width, int Height)
+{
+	XMMATRIX matView = XMMatrixLookAtLH(XMVectorSet(0.0f, 9.0f, 24.0f, 0.0f), XMVectorSet(0.0f, 0.0f, 0.0f, 0.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+	XMMATRIX matProjection = XMMatrixPerspectiveFovLH(XMConvertToRadians(45), (float)Width / (float)Height, 1.0f, 100.0f);
+	SoftwareShaderConstants constants;
+	XMStoreFloat4x4(&constants.matViewProjection, matView * matProjection);
+	constants.LightVector = XMFLOAT4(1.0f, 1.0f, 1.0f, 0.0f);
+	constants.LightColor = XMFLOAT4(0.5f, 0.5f, 0.5f, 1.0f);
+	constants.AmbientColor = XMFLOAT4(0.2f, 0.2f, 0.2f, 1.0f);
+	return constants;
+}
+
+// main function: Definition
+int main(int argc, char* argv[])
+{
+	int framesTotal = 100;
+	int instancesTotal = 2;
+	string directory = ".";
+	bool save = true;
+
+	// Read the command line arguments.
+	for (int a = 1; a < argc; a++)
+	{
+		bool hasValue = a + 1 < argc;
+		if (strcmp(argv[a], "-frames") == 0 && hasValue)
+			framesTotal = atoi(argv[++a]);
+		else if (strcmp(argv[a], "-instances") == 0 && hasValue)
+			instancesTotal = atoi(argv[++a]);
+		else if (strcmp(argv[a], "-threads") == 0 && hasValue)
+			JobSystemThreads = atoi(argv[++a]);
+		else if (strcmp(argv[a], "-directory") == 0 && hasValue)
+			directory = argv[++a];
+		else if (strcmp(argv[a], "-nosave") == 0)
+			save = false;
+		else
+			return PrintUsage();
+	}
+	if (framesTotal < 1 || instancesTotal < 1 || JobSystemThreads < 0)
+		return PrintUsage();
+
+	// Load the object and its texture image, as the InitGraphics function does. If the texture image cannot be read, the software rasterizer samples (0, 0, 0, 0), as a shader does when no texture is bound.
+	Mesh mesh;
+	LoadObjOptions options;
+	if (LoadObj((directory + "/Text.obj").c_str(), options, mesh) != 0 || mesh.VertexAttributeSetsTotal == 0)
+	{
+		fprintf(stderr, "%s/Text.obj cannot be loaded.\n", directory.c_str());
+		return 1;
+	}
+	Image texture;
+	if (LoadPngFile((directory + "/Wood.png").c_str(), texture) != 0)
+		fprintf(stderr, "%s/Wood.png cannot be loaded; the object is drawn untextured.\n", directory.c_str());
+
+	float boundsRadius = 0.0f;
+	for (const VERTEX& vertex : mesh.Vertices)
+		boundsRadius = fmaxf(boundsRadius, sqrtf(vertex.GeometricVertex.x * vertex.GeometricVertex.x + vertex.GeometricVertex.y * vertex.GeometricVertex.y + vertex.GeometricVertex.z * vertex.GeometricVertex.z));
+	vector<INSTANCEDATA> instances;
+	PlaceInstances(instancesTotal, boundsRadius, instances);
+	SoftwareDraw draw = { mesh.PrimitivesTotal * 3, 0, instancesTotal, 0 };
+
+	printf("Text.obj: %d triangles, %d instances, %d job system threads, %d frames\n", mesh.PrimitivesTotal, instancesTotal, JobSystemThreadsTotal(), framesTotal);
+	printf("%12s %8s %12s %12s %16s\n", "Resolution", "Samples", "SSE fps", "Scalar fps", "SSE Mpixels/s");
+	const int resolutions[2][2] = { { 800, 600 }, { 3840, 2160 } };
+	int result = 0;
+	for (const int* resolution : resolutions)
+	{
+		int width = resolution[0], height = resolution[1];
+		SoftwareShaderConstants constants = SceneConstants(width, height);
+		for (int sampleCount : { 1, 4 })
+		{
+			SoftwareRenderTarget target;
+			CreateSoftwareRenderTarget(target, width, height, sampleCount);
+			Image simdFrame, scalarFrame;
+			SoftwareRasterizerSimdEnabled = true;
+			double simdFps = BenchmarkSoftwareRasterizer(target, mesh.Vertices.data(), mesh.Indices.data(), instances.data(), &draw, 1, constants, texture, framesTotal, simdFrame);
+			SoftwareRasterizerSimdEnabled = false;
+			double scalarFps = BenchmarkSoftwareRasterizer(target, mesh.Vertices.data(), mesh.Indices.data(), instances.data(), &draw, 1, constants, texture, framesTotal, scalarFrame);
+			SoftwareRasterizerSimdEnabled = true;
+
+			char name[64];
+			snprintf(name, sizeof(name), "%dx%d", width, height);
+			printf("%12s %7dx %12.1f %12.1f %16.1f\n", name, sampleCount, simdFps, scalarFps, simdFps * width * height / 1.0e6);
+			if (simdFrame.Pixels != scalarFrame.Pixels)
+			{
+				fprintf(stderr, "%s, %dx: the frames rendered with and without SSE instructions differ.\n", name, sampleCount);
+				result = 2;
+			}
+			if (save)
+			{
+				snprintf(name, sizeof(name), "softwareRasterizer_%dx%d_%dx.bmp", width, height, sampleCount);
+				SaveBmpFile(name, simdFrame);
+			}
+		}
+	}
+	JobSystemShutdown();
+
+	// Return to the calling program with the return code.
+	return result;
+}
+
+// End: Function Definitions.
@@ -0,0 +1,403 @@
+// directxmath Header File (portable build)
+// Version 3.1
+//
+// Description
+// Portable DirectXMath Header File
+// This header file stands in for the Windows SDK's DirectXMath.h when the modules of the objRenderer program that do not use Direct3D are built on another platform, e.g., Linux (see CMakeLists.txt).
+// It declares only the DirectXMath types and functions those modules, their tests, and their benchmarks use, in the DirectX namespace, with the same names, conventions, and results (to within rounding) as DirectXMath:
+// vectors are rows, a matrix is an array of four row vectors (XMMATRIX::r), and a vector is transformed by multiplying it on the left of a matrix, so XMMatrixMultiply(A, B) applies A and then B.
+// Each function is written as DirectXMath writes it without intrinsics (_XM_NO_INTRINSICS_), i.e., one component at a time, so the batchTransform tests compare the SSE and AVX2 paths with an independent, scalar result.
+// It is never used by the Visual Studio project, which includes the Windows SDK's DirectXMath.h.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Mathematical Functions.
+#include <cmath>											// Mathematical functions sinf, cosf, sqrtf, tanf.
+
+// Defines.
+// DirectXMath functions are declared with the __vectorcall calling convention on Windows. Other platforms have only one calling convention.
+#define XM_CALLCONV
+
+namespace DirectX
+{
+	//***
+	// Constants.
+	//***
+
+	constexpr float XM_PI = 3.141592654f;
+	constexpr float XM_2PI = 6.283185307f;
+	constexpr float XM_PIDIV2 = 1.570796327f;
+	constexpr float XM_PIDIV4 = 0.785398163f;
+
+	//***
+	// Structure Declarations.
+	//***
+
+	// A vector of four floating-point components, held in a SIMD register by DirectXMath.
+	struct alignas(16) XMVECTOR {
+		float vector4_f32[4];
+	};
+
+	// Vector parameters: passed by value in registers by DirectXMath, and by constant reference here.
+	typedef const XMVECTOR& FXMVECTOR;
+	typedef const XMVECTOR& GXMVECTOR;
+	typedef const XMVECTOR& HXMVECTOR;
+	typedef const XMVECTOR& CXMVECTOR;
+
+	// A 4x4 matrix of four row vectors.
+	struct alignas(16) XMMATRIX {
+		XMVECTOR r[4];
+
+		XMMATRIX() = default;
+		XMMATRIX(FXMVECTOR R0, FXMVECTOR R1, FXMVECTOR R2, CXMVECTOR R3) : r{ R0, R1, R2, R3 } {}
+		XMMATRIX(float m00, float m01, float m02, float m03, float m10, float m11, float m12, float m13,
+				 float m20, float m21, float m22, float m23, float m30, float m31, float m32, float m33)
+			: r{ { { m00, m01, m02, m03 } }, { { m10, m11, m12, m13 } }, { { m20, m21, m22, m23 } }, { { m30, m31, m32, m33 } } } {}
+
+		XMMATRIX operator*(const XMMATRIX& M) const;
+		XMMATRIX& operator*=(const XMMATRIX& M) { *this = *this * M; return *this; }
+	};
+
+	// Matrix parameters.
+	typedef const XMMATRIX& FXMMATRIX;
+	typedef const XMMATRIX& CXMMATRIX;
+
+	// Vectors and matrices as they are stored in memory.
+	struct XMFLOAT2 {
+		float x;
+		float y;
+
+		XMFLOAT2() = default;
+		constexpr XMFLOAT2(float _x, float _y) : x(_x), y(_y) {}
+	};
+
+	struct XMFLOAT3 {
+		float x;
+		float y;
+		float z;
+
+		XMFLOAT3() = default;
+		constexpr XMFLOAT3(float _x, float _y, float _z) : x(_x), y(_y), z(_z) {}
+	};
+
+	struct XMFLOAT4 {
+		float x;
+		float y;
+		float z;
+		float w;
+
+		XMFLOAT4() = default;
+		constexpr XMFLOAT4(float _x, float _y, float _z, float _w) : x(_x), y(_y), z(_z), w(_w) {}
+	};
+
+	struct XMFLOAT4X4 {
+		union {
+			struct {
+				float _11, _12, _13, _14;
+				float _21, _22, _23, _24;
+				float _31, _32, _33, _34;
+				float _41, _42, _43, _44;
+			};
+			float m[4][4];
+		};
+
+		XMFLOAT4X4() = default;
+		float operator()(int Row, int Column) const { return m[Row][Column]; }
+		float& operator()(int Row, int Column) { return m[Row][Column]; }
+	};
+
+	// End: Structure Declarations.
+
+	//***
+	// Scalar Functions.
+	//***
+
+	inline constexpr float XMConvertToRadians(float fDegrees) { return fDegrees * (XM_PI / 180.0f); }
+	inline constexpr float XMConvertToDegrees(float fRadians) { return fRadians * (180.0f / XM_PI); }
+
+	//***
+	// Load and Store Functions.
+	//***
+
+	inline XMVECTOR XM_CALLCONV XMLoadFloat3(const XMFLOAT3* pSource) { return { { pSource->x, pSource->y, pSource->z, 0.0f } }; }
+	inline XMVECTOR XM_CALLCONV XMLoadFloat4(const XMFLOAT4* pSource) { return { { pSource->x, pSource->y, pSource->z, pSource->w } }; }
+	inline void XM_CALLCONV XMStoreFloat3(XMFLOAT3* pDestination, FXMVECTOR V) { *pDestination = XMFLOAT3(V.vector4_f32[0], V.vector4_f32[1], V.vector4_f32[2]); }
+	inline void XM_CALLCONV XMStoreFloat4(XMFLOAT4* pDestination, FXMVECTOR V) { *pDestination = XMFLOAT4(V.vector4_f32[0], V.vector4_f32[1], V.vector4_f32[2], V.vector4_f32[3]); }
+
+	inline XMMATRIX XM_CALLCONV XMLoadFloat4x4(const XMFLOAT4X4* pSource)
+	{
+		XMMATRIX M;
+		for (int i = 0; i < 4; i++)
+			for (int j = 0; j < 4; j++)
+				M.r[i].vector4_f32[j] = pSource->m[i][j];
+		return M;
+	}
+
+	inline void XM_CALLCONV XMStoreFloat4x4(XMFLOAT4X4* pDestination, FXMMATRIX M)
+	{
+		for (int i = 0; i < 4; i++)
+			for (int j = 0; j < 4; j++)
+				pDestination->m[i][j] = M.r[i].vector4_f32[j];
+	}
+
+	//***
+	// Vector Functions.
+	//***
+
+	inline XMVECTOR XM_CALLCONV XMVectorSet(float x, float y, float z, float w) { return { { x, y, z, w } }; }
+	inline XMVECTOR XM_CALLCONV XMVectorZero() { return { { 0.0f, 0.0f, 0.0f, 0.0f } }; }
+	inline XMVECTOR XM_CALLCONV XMVectorReplicate(float Value) { return { { Value, Value, Value, Value } }; }
+	inline XMVECTOR XM_CALLCONV XMVectorSplatX(FXMVECTOR V) { return XMVectorReplicate(V.vector4_f32[0]); }
+	inline XMVECTOR XM_CALLCONV XMVectorSplatY(FXMVECTOR V) { return XMVectorReplicate(V.vector4_f32[1]); }
+	inline XMVECTOR XM_CALLCONV XMVectorSplatZ(FXMVECTOR V) { return XMVectorReplicate(V.vector4_f32[2]); }
+	inline XMVECTOR XM_CALLCONV XMVectorSplatW(FXMVECTOR V) { return XMVectorReplicate(V.vector4_f32[3]); }
+	inline float XM_CALLCONV XMVectorGetX(FXMVECTOR V) { return V.vector4_f32[0]; }
+	inline float XM_CALLCONV XMVectorGetY(FXMVECTOR V) { return V.vector4_f32[1]; }
+	inline float XM_CALLCONV XMVectorGetZ(FXMVECTOR V) { return V.vector4_f32[2]; }
+	inline float XM_CALLCONV XMVectorGetW(FXMVECTOR V) { return V.vector4_f32[3]; }
+	inline XMVECTOR XM_CALLCONV XMVectorSetW(FXMVECTOR V, float w) { return { { V.vector4_f32[0], V.vector4_f32[1], V.vector4_f32[2], w } }; }
+
+	inline XMVECTOR XM_CALLCONV XMVectorAdd(FXMVECTOR V1, FXMVECTOR V2)
+	{
+		return { { V1.vector4_f32[0] + V2.vector4_f32[0], V1.vector4_f32[1] + V2.vector4_f32[1], V1.vector4_f32[2] + V2.vector4_f32[2], V1.vector4_f32[3] + V2.vector4_f32[3] } };
+	}
+
+	inline XMVECTOR XM_CALLCONV XMVectorSubtract(FXMVECTOR V1, FXMVECTOR V2)
+	{
+		return { { V1.vector4_f32[0] - V2.vector4_f32[0], V1.vector4_f32[1] - V2.vector4_f32[1], V1.vector4_f32[2] - V2.vector4_f32[2], V1.vector4_f32[3] - V2.vector4_f32[3] } };
+	}
+
+	inline XMVECTOR XM_CALLCONV XMVectorMultiply(FXMVECTOR V1, FXMVECTOR V2)
+	{
+		return { { V1.vector4_f32[0] * V2.vector4_f32[0], V1.vector4_f32[1] * V2.vector4_f32[1], V1.vector4_f32[2] * V2.vector4_f32[2], V1.vector4_f32[3] * V2.vector4_f32[3] } };
+	}
+
+	inline XMVECTOR XM_CALLCONV XMVectorMultiplyAdd(FXMVECTOR V1, FXMVECTOR V2, FXMVECTOR V3)
+	{
+		return { { V1.vector4_f32[0] * V2.vector4_f32[0] + V3.vector4_f32[0], V1.vector4_f32[1] * V2.vector4_f32[1] + V3.vector4_f32[1],
+				   V1.vector4_f32[2] * V2.vector4_f32[2] + V3.vector4_f32[2], V1.vector4_f32[3] * V2.vector4_f32[3] + V3.vector4_f32[3] } };
+	}
+
+	inline XMVECTOR XM_CALLCONV XMVectorScale(FXMVECTOR V, float ScaleFactor)
+	{
+		return { { V.vector4_f32[0] * ScaleFactor, V.vector4_f32[1] * ScaleFactor, V.vector4_f32[2] * ScaleFactor, V.vector4_f32[3] * ScaleFactor } };
+	}
+
+	inline XMVECTOR XM_CALLCONV XMVectorNegate(FXMVECTOR V) { return { { -V.vector4_f32[0], -V.vector4_f32[1], -V.vector4_f32[2], -V.vector4_f32[3] } }; }
+
+	inline XMVECTOR XM_CALLCONV XMVectorMin(FXMVECTOR V1, FXMVECTOR V2)
+	{
+		XMVECTOR Result;
+		for (int i = 0; i < 4; i++)
+			Result.vector4_f32[i] = V1.vector4_f32[i] < V2.vector4_f32[i] ? V1.vector4_f32[i] : V2.vector4_f32[i];
+		return Result;
+	}
+
+	inline XMVECTOR XM_CALLCONV XMVectorMax(FXMVECTOR V1, FXMVECTOR V2)
+	{
+		XMVECTOR Result;
+		for (int i = 0; i < 4; i++)
+			Result.vector4_f32[i] = V1.vector4_f32[i] > V2.vector4_f32[i] ? V1.vector4_f32[i] : V2.vector4_f32[i];
+		return Result;
+	}
+
+	inline XMVECTOR XM_CALLCONV XMVectorSqrt(FXMVECTOR V)
+	{
+		return { { sqrtf(V.vector4_f32[0]), sqrtf(V.vector4_f32[1]), sqrtf(V.vector4_f32[2]), sqrtf(V.vector4_f32[3]) } };
+	}
+
+	inline bool XM_CALLCONV XMVector3Greater(FXMVECTOR V1, FXMVECTOR V2)
+	{
+		return V1.vector4_f32[0] > V2.vector4_f32[0] && V1.vector4_f32[1] > V2.vector4_f32[1] && V1.vector4_f32[2] > V2.vector4_f32[2];
+	}
+
+	inline bool XM_CALLCONV XMVector4GreaterOrEqual(FXMVECTOR V1, FXMVECTOR V2)
+	{
+		return V1.vector4_f32[0] >= V2.vector4_f32[0] && V1.vector4_f32[1] >= V2.vector4_f32[1] && V1.vector4_f32[2] >= V2.vector4_f32[2] && V1.vector4_f32[3] >= V2.vector4_f32[3];
+	}
+
+	// The dot product, length, and normalization of the x, y, and z components, replicated into every component, as DirectXMath returns them.
+	inline XMVECTOR XM_CALLCONV XMVector3Dot(FXMVECTOR V1, FXMVECTOR V2)
+	{
+		return XMVectorReplicate(V1.vector4_f32[0] * V2.vector4_f32[0] + V1.vector4_f32[1] * V2.vector4_f32[1] + V1.vector4_f32[2] * V2.vector4_f32[2]);
+	}
+
+	inline XMVECTOR XM_CALLCONV XMVector3Cross(FXMVECTOR V1, FXMVECTOR V2)
+	{
+		return { { V1.vector4_f32[1] * V2.vector4_f32[2] - V1.vector4_f32[2] * V2.vector4_f32[1],
+				   V1.vector4_f32[2] * V2.vector4_f32[0] - V1.vector4_f32[0] * V2.vector4_f32[2],
+				   V1.vector4_f32[0] * V2.vector4_f32[1] - V1.vector4_f32[1] * V2.vector4_f32[0], 0.0f } };
+	}
+
+	inline XMVECTOR XM_CALLCONV XMVector3LengthSq(FXMVECTOR V) { return XMVector3Dot(V, V); }
+	inline XMVECTOR XM_CALLCONV XMVector3Length(FXMVECTOR V) { return XMVectorSqrt(XMVector3LengthSq(V)); }
+
+	inline XMVECTOR XM_CALLCONV XMVector3Normalize(FXMVECTOR V)
+	{
+		float length = XMVectorGetX(XMVector3Length(V));
+		if (length > 0.0f)
+			length = 1.0f / length;
+		return XMVectorScale(V, length);
+	}
+
+	// The x, y, and z components of V transformed by M as a point (w = 1), divided by the transformed w.
+	inline XMVECTOR XM_CALLCONV XMVector3TransformCoord(FXMVECTOR V, FXMMATRIX M)
+	{
+		XMVECTOR Result;
+		for (int j = 0; j < 4; j++)
+			Result.vector4_f32[j] = V.vector4_f32[0] * M.r[0].vector4_f32[j] + V.vector4_f32[1] * M.r[1].vector4_f32[j] + V.vector4_f32[2] * M.r[2].vector4_f32[j] + M.r[3].vector4_f32[j];
+		return XMVectorScale(Result, 1.0f / Result.vector4_f32[3]);
+	}
+
+	// A plane (a, b, c, d) scaled so its normal (a, b, c) is a unit vector.
+	inline XMVECTOR XM_CALLCONV XMPlaneNormalize(FXMVECTOR P)
+	{
+		float length = sqrtf(P.vector4_f32[0] * P.vector4_f32[0] + P.vector4_f32[1] * P.vector4_f32[1] + P.vector4_f32[2] * P.vector4_f32[2]);
+		if (length > 0.0f)
+			length = 1.0f / length;
+		return XMVectorScale(P, length);
+	}
+
+	//***
+	// Quaternion Functions.
+	//***
+
+	// The product Q2 * Q1, i.e., the rotation Q1 followed by the rotation Q2, as DirectXMath defines it.
+	inline XMVECTOR XM_CALLCONV XMQuaternionMultiply(FXMVECTOR Q1, FXMVECTOR Q2)
+	{
+		const float* a = Q2.vector4_f32;
+		const float* b = Q1.vector4_f32;
+		return { { a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1],
+				   a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0],
+				   a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3],
+				   a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2] } };
+	}
+
+	inline XMVECTOR XM_CALLCONV XMQuaternionConjugate(FXMVECTOR Q) { return { { -Q.vector4_f32[0], -Q.vector4_f32[1], -Q.vector4_f32[2], Q.vector4_f32[3] } }; }
+
+	// The rotation about the z axis (Roll), then the x axis (Pitch), then the y axis (Yaw).
+	inline XMVECTOR XM_CALLCONV XMQuaternionRotationRollPitchYaw(float Pitch, float Yaw, float Roll)
+	{
+		float sp = sinf(0.5f * Pitch), cp = cosf(0.5f * Pitch);
+		float sy = sinf(0.5f * Yaw), cy = cosf(0.5f * Yaw);
+		float sr = sinf(0.5f * Roll), cr = cosf(0.5f * Roll);
+		return { { cr * sp * cy + sr * cp * sy,
+				   cr * cp * sy - sr * sp * cy,
+				   sr * cp * cy - cr * sp * sy,
+				   cr * cp * cy + sr * sp * sy } };
+	}
+
+	// V rotated by the unit quaternion RotationQuaternion.
+	inline XMVECTOR XM_CALLCONV XMVector3Rotate(FXMVECTOR V, FXMVECTOR RotationQuaternion)
+	{
+		XMVECTOR A = XMVectorSetW(V, 0.0f);
+		XMVECTOR Result = XMQuaternionMultiply(XMQuaternionConjugate(RotationQuaternion), A);
+		return XMQuaternionMultiply(Result, RotationQuaternion);
+	}
+
+	//***
+	// Matrix Functions.
+	//***
+
+	inline XMMATRIX XM_CALLCONV XMMatrixIdentity()
+	{
+		return XMMATRIX(1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+	}
+
+	inline XMMATRIX XM_CALLCONV XMMatrixMultiply(FXMMATRIX M1, CXMMATRIX M2)
+	{
+		XMMATRIX Result;
+		for (int i = 0; i < 4; i++)
+			for (int j = 0; j < 4; j++)
+				Result.r[i].vector4_f32[j] = M1.r[i].vector4_f32[0] * M2.r[0].vector4_f32[j] + M1.r[i].vector4_f32[1] * M2.r[1].vector4_f32[j]
+										   + M1.r[i].vector4_f32[2] * M2.r[2].vector4_f32[j] + M1.r[i].vector4_f32[3] * M2.r[3].vector4_f32[j];
+		return Result;
+	}
+
+	inline XMMATRIX XMMATRIX::operator*(const XMMATRIX& M) const { return XMMatrixMultiply(*this, M); }
+
+	inline XMMATRIX XM_CALLCONV XMMatrixTranspose(FXMMATRIX M)
+	{
+		XMMATRIX Result;
+		for (int i = 0; i < 4; i++)
+			for (int j = 0; j < 4; j++)
+				Result.r[i].vector4_f32[j] = M.r[j].vector4_f32[i];
+		return Result;
+	}
+
+	inline XMMATRIX XM_CALLCONV XMMatrixScaling(float ScaleX, float ScaleY, float ScaleZ)
+	{
+		return XMMATRIX(ScaleX, 0.0f, 0.0f, 0.0f, 0.0f, ScaleY, 0.0f, 0.0f, 0.0f, 0.0f, ScaleZ, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+	}
+
+	inline XMMATRIX XM_CALLCONV XMMatrixTranslation(float OffsetX, float OffsetY, float OffsetZ)
+	{
+		return XMMATRIX(1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, OffsetX, OffsetY, OffsetZ, 1.0f);
+	}
+
+	inline XMMATRIX XM_CALLCONV XMMatrixRotationX(float Angle)
+	{
+		float s = sinf(Angle), c = cosf(Angle);
+		return XMMATRIX(1.0f, 0.0f, 0.0f, 0.0f, 0.0f, c, s, 0.0f, 0.0f, -s, c, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+	}
+
+	inline XMMATRIX XM_CALLCONV XMMatrixRotationY(float Angle)
+	{
+		float s = sinf(Angle), c = cosf(Angle);
+		return XMMATRIX(c, 0.0f, -s, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, s, 0.0f, c, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+	}
+
+	inline XMMATRIX XM_CALLCONV XMMatrixRotationZ(float Angle)
+	{
+		float s = sinf(Angle), c = cosf(Angle);
+		return XMMATRIX(c, s, 0.0f, 0.0f, -s, c, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+	}
+
+	inline XMMATRIX XM_CALLCONV XMMatrixRotationQuaternion(FXMVECTOR Quaternion)
+	{
+		float x = Quaternion.vector4_f32[0], y = Quaternion.vector4_f32[1], z = Quaternion.vector4_f32[2], w = Quaternion.vector4_f32[3];
+		float xx = x * (x + x), yy = y * (y + y), zz = z * (z + z);
+		float xy = x * (y + y), xz = x * (z + z), yz = y * (z + z);
+		float wx = w * (x + x), wy = w * (y + y), wz = w * (z + z);
+		return XMMATRIX(1.0f - yy - zz, xy + wz, xz - wy, 0.0f,
+						xy - wz, 1.0f - xx - zz, yz + wx, 0.0f,
+						xz + wy, yz - wx, 1.0f - xx - yy, 0.0f,
+						0.0f, 0.0f, 0.0f, 1.0f);
+	}
+
+	// A left-handed view matrix: the camera at EyePosition, looking toward FocusPosition, with UpDirection up.
+	inline XMMATRIX XM_CALLCONV XMMatrixLookAtLH(FXMVECTOR EyePosition, FXMVECTOR FocusPosition, FXMVECTOR UpDirection)
+	{
+		XMVECTOR R2 = XMVector3Normalize(XMVectorSubtract(FocusPosition, EyePosition));
+		XMVECTOR R0 = XMVector3Normalize(XMVector3Cross(UpDirection, R2));
+		XMVECTOR R1 = XMVector3Cross(R2, R0);
+		XMVECTOR NegEyePosition = XMVectorNegate(EyePosition);
+		XMMATRIX M(XMVectorSetW(R0, XMVectorGetX(XMVector3Dot(R0, NegEyePosition))),
+				   XMVectorSetW(R1, XMVectorGetX(XMVector3Dot(R1, NegEyePosition))),
+				   XMVectorSetW(R2, XMVectorGetX(XMVector3Dot(R2, NegEyePosition))),
+				   XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f));
+		return XMMatrixTranspose(M);
+	}
+
+	// A left-handed perspective projection matrix, mapping depths from NearZ to FarZ onto 0 to 1.
+	inline XMMATRIX XM_CALLCONV XMMatrixPerspectiveFovLH(float FovAngleY, float AspectRatio, float NearZ, float FarZ)
+	{
+		float height = cosf(0.5f * FovAngleY) / sinf(0.5f * FovAngleY);
+		float width = height / AspectRatio;
+		float range = FarZ / (FarZ - NearZ);
+		return XMMATRIX(width, 0.0f, 0.0f, 0.0f, 0.0f, height, 0.0f, 0.0f, 0.0f, 0.0f, range, 1.0f, 0.0f, 0.0f, -range * NearZ, 0.0f);
+	}
+
+	// End: Global Declarations.
+}
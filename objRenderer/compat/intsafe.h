@@ -0,0 +1,27 @@
+// intsafe Header File (portable build)
+// Version 3.1
+//
+// Description
+// Portable DWORD Header File
+// This header file stands in for the Windows SDK's intsafe.h when the modules of the objRenderer program that do not use Direct3D are built on another platform, e.g., Linux (see CMakeLists.txt).
+// It declares only the DWORD data type, as the 32-bit unsigned integer it is on Windows, so index arrays and binary mesh cache files have the same layout on every platform.
+// It is never used by the Visual Studio project, which includes the Windows SDK's intsafe.h.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Fixed Width Integer Types.
+#include <cstdint>											// Required for the uint32_t data type.
+
+// The DWORD data type: a 32-bit unsigned integer.
+typedef std::uint32_t DWORD;
+
+// End: Global Declarations.
@@ -0,0 +1,99 @@
+// frameClock
+// Version 3.1
+//
+// Description
+// These functions schedule frames and fixed timesteps: the simulation advances by whole timesteps of the time that has passed, and the frames are spaced at least one frame interval apart.
+// Each frame's start is scheduled one frame interval after the previous frame's scheduled start, not after its actual start, so a frame that starts a little late or early does not change the average frame rate.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Frame clock Header File.
+#include "frameClock.h"
+
+// Steady Clock.
+#include <chrono>											// Steady clock, returned by the FrameClockNow function.
+
+//***
+// External Variable Global Definitions.
+//***
+
+int SimulationStepsPerSecond = 120;
+int FrameRateLimit = 60;
+int PresentSyncInterval = 0;
+
+// End: External Variable Global Definitions.
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// CreateFrameClock function: Definition
+void CreateFrameClock(FrameClock& Clock, int StepsPerSecond, int FramesPerSecond)
+{
+	Clock = FrameClock();
+	Clock.StepNanoseconds = 1000000000LL / (StepsPerSecond > 0 ? StepsPerSecond : 1);
+	Clock.FrameNanoseconds = FramesPerSecond > 0 ? 1000000000LL / FramesPerSecond : 0;
+}
+
+// FrameClockNow function: Definition
+long long FrameClockNow(void)
+{
+	return (long long)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// FrameClockWaitTime function: Definition
+//   The first frame may always start at once.
+long long FrameClockWaitTime(const FrameClock& Clock, long long Now)
+{
+	if (!Clock.Started || Clock.FrameNanoseconds == 0 || Now >= Clock.NextFrame)
+		return 0;
+	return Clock.NextFrame - Now;
+}
+
+// FrameClockBeginFrame function: Definition
+//   This function adds the time since the previous frame started to the time not yet simulated, and removes from it as many whole timesteps as fit, which it returns.
+//   The first frame simulates nothing. The time since the previous frame started is limited to FRAME_CLOCK_MAXIMUM_ELAPSED, and a clock that goes backwards is treated as no time passing.
+//   If the frame rate is capped, the next frame is scheduled one frame interval after this frame was scheduled; if that time has already passed, i.e., the program has fallen a whole frame behind,
+//   the schedule restarts one frame interval from Now, so the frames missed are not rendered in a burst to catch up.
+int FrameClockBeginFrame(FrameClock& Clock, long long Now)
+{
+	if (!Clock.Started)
+	{
+		Clock.Started = true;
+		Clock.Previous = Now;
+		Clock.NextFrame = Now;
+	}
+
+	long long elapsed = Now - Clock.Previous;
+	if (elapsed < 0)
+		elapsed = 0;
+	if (elapsed > FRAME_CLOCK_MAXIMUM_ELAPSED)
+	{
+		Clock.DroppedNanoseconds += elapsed - FRAME_CLOCK_MAXIMUM_ELAPSED;
+		elapsed = FRAME_CLOCK_MAXIMUM_ELAPSED;
+	}
+	Clock.Previous = Now;
+
+	Clock.Accumulator += elapsed;
+	long long steps = Clock.Accumulator / Clock.StepNanoseconds;
+	Clock.Accumulator -= steps * Clock.StepNanoseconds;
+	Clock.Alpha = (float)((double)Clock.Accumulator / (double)Clock.StepNanoseconds);
+
+	if (Clock.FrameNanoseconds != 0)
+	{
+		Clock.NextFrame += Clock.FrameNanoseconds;
+		if (Clock.NextFrame <= Now)
+			Clock.NextFrame = Now + Clock.FrameNanoseconds;
+	}
+
+	Clock.Frames++;
+	Clock.Steps += (unsigned long long)steps;
+	return (int)steps;
+}
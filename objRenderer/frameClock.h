@@ -0,0 +1,80 @@
+// frameClock Header File
+// Version 3.1
+//
+// Description
+// Frame clock Header File
+// This header file contains the declarations used to schedule the frames of the objRenderer program: when to render the next frame, and how many fixed timesteps of simulation (e.g., animation) to run before rendering it.
+// The simulation always advances by the same fixed timestep, so motion runs at the same speed at any frame rate. The time left over after the last whole timestep is returned as the fraction Alpha of a timestep,
+// so the frame can be rendered between the previous and the current simulation state (interpolated), and motion stays smooth when the frame rate is not a multiple of the timestep rate.
+// A frame cap limits the frame rate: the calling program waits (e.g., with MsgWaitForMultipleObjects) until the time returned by the FrameClockWaitTime function has passed, instead of rendering frames no one sees.
+// Every function is passed the current time instead of reading a clock, so the schedule can be tested with any sequence of times, e.g., on Linux against a mock clock. None of these functions use Direct3D or the Windows API.
+// Include it in all source files that schedule frames, e.g., the objRenderer program.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Defines.
+// The longest time, in nanoseconds, a single frame may advance the simulation (a quarter of a second). A longer gap, e.g., while the window is dragged or the program is stopped in a debugger,
+// is dropped instead of simulated, so the program neither runs hundreds of timesteps in one frame (falling further behind) nor jumps the animation ahead.
+#define FRAME_CLOCK_MAXIMUM_ELAPSED 250000000LL
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the FrameClock 'named structure' data type.
+// A FrameClock holds the schedule of frames and fixed timesteps. All times are in nanoseconds, on the same clock as the Now parameter of each function (e.g., the FrameClockNow function).
+struct FrameClock {
+	long long StepNanoseconds = 0;							// The fixed timestep of the simulation.
+	long long FrameNanoseconds = 0;							// The shortest time between the starts of two frames, or 0 if the frame rate is not capped.
+	bool Started = false;									// True once the first frame has started.
+	long long Previous = 0;									// The time the previous frame started.
+	long long Accumulator = 0;								// The time not yet simulated: less than one timestep after each frame starts.
+	long long NextFrame = 0;								// The time the next frame is scheduled to start, if the frame rate is capped.
+	float Alpha = 0.0f;										// The fraction, from 0 up to (excluding) 1, of a timestep between the current simulation state and the time the frame started: Accumulator / StepNanoseconds.
+
+	unsigned long long Frames = 0;							// The number of frames started.
+	unsigned long long Steps = 0;							// The number of timesteps run.
+	long long DroppedNanoseconds = 0;						// The time not simulated because a frame started more than FRAME_CLOCK_MAXIMUM_ELAPSED after the previous frame.
+};
+
+// End: Structure Declarations.
+
+//***
+// External Variable Global Declarations.
+//***
+
+// SimulationStepsPerSecond is the number of fixed timesteps the objRenderer program simulates per second. It is 120 by default.
+extern int SimulationStepsPerSecond;
+//
+// FrameRateLimit is the most frames per second the objRenderer program renders. It is 60 by default. 0 renders frames as fast as possible, which keeps one CPU core busy.
+extern int FrameRateLimit;
+//
+// PresentSyncInterval is the sync interval the objRenderer program presents each frame with. It is 0 by default: the frame is presented immediately, without waiting for the vertical blank.
+// 1 waits for the next vertical blank (vertical sync), which blocks in Present instead of spinning, and limits the frame rate to the display's refresh rate; set FrameRateLimit to 0 to rely on it alone.
+extern int PresentSyncInterval;
+
+// End: External Variable Global Declarations.
+
+//***
+// Global Function Declarations.
+//***
+
+void CreateFrameClock(FrameClock& Clock, int StepsPerSecond, int FramesPerSecond);		// The CreateFrameClock function sets Clock to a schedule of StepsPerSecond timesteps per second, and at most FramesPerSecond frames per second (0 for no limit).
+long long FrameClockNow(void);															// The FrameClockNow function returns the time, in nanoseconds, of a steady clock.
+long long FrameClockWaitTime(const FrameClock& Clock, long long Now);					// The FrameClockWaitTime function returns the time, in nanoseconds, from Now until the next frame may start, or 0 if it may start now.
+int FrameClockBeginFrame(FrameClock& Clock, long long Now);								// The FrameClockBeginFrame function starts a frame at time Now, and returns the number of timesteps to simulate before rendering it. It sets Clock.Alpha.
+
+// End: Global Function Declarations.
+
+// End: Global Declarations.
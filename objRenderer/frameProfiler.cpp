@@ -0,0 +1,223 @@
+// frameProfiler
+// Version 3.1
+//
+// Description
+// These functions time the stages of each frame, record each time into a lock-free ring buffer of FRAME_PROFILER_SAMPLES samples, and summarize the samples of each stage as percentiles.
+// Any thread may record a sample: it claims the next slot of the ring buffer with one atomic increment, and marks the slot with a sequence number before and after writing it,
+// so the thread summarizing the samples skips a slot that is being written, or was overwritten while it was read, instead of waiting for it.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Frame profiler Header File.
+#include "frameProfiler.h"
+
+// Atomic Class.
+#include <atomic>											// Atomic class, used to claim and mark the slots of the ring buffer.
+
+// Steady Clock.
+#include <chrono>											// Steady clock, used to time the stages.
+
+// Algorithm Functions.
+#include <algorithm>										// Algorithm functions nth_element, max_element.
+
+// Vector Container Class.
+#include <vector>											// Vector class, used to gather the samples of a stage.
+
+// File Stream Functions.
+#include <fstream>											// File stream class member functions, used to write the .csv and .json files.
+
+// Using Declarations and Directives.
+using std::atomic;
+using std::vector;
+using std::ofstream;
+using std::memory_order_relaxed;
+using std::memory_order_acquire;
+using std::memory_order_release;
+
+//***
+// External Variable Global Definitions.
+//***
+
+bool FrameProfilerEnabled = false;
+const char* FrameProfilerFileName = "objRenderer.profile";
+bool FrameProfilerGpuEnabled = false;
+const char* const ProfileStageNames[PROFILE_STAGES_TOTAL] = { "Frame", "Transform", "Wait", "Clear", "Sort", "Constants", "Draw", "Software", "Present", "GpuFrame", "GpuDraw" };
+
+// End: External Variable Global Definitions.
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the ProfileSample 'named structure' data type.
+// One slot of the ring buffer. Sample number n is written to slot n % FRAME_PROFILER_SAMPLES: Sequence is set to 2n + 1 while it is written, and to 2n + 2 once it is written.
+// The other members are atomic too, so that a slot read while it is being overwritten is a detected race, not undefined behavior; they are read and written without ordering, which costs the same as ordinary loads and stores.
+struct ProfileSample {
+	atomic<unsigned long long> Sequence{ 0 };
+	atomic<unsigned long long> Frame{ 0 };
+	atomic<long long> Nanoseconds{ 0 };
+	atomic<int> Stage{ 0 };
+};
+
+// End: Structure Declarations.
+
+// The ring buffer, the number of samples ever recorded, and the number of the current frame.
+static ProfileSample ProfileSamples[FRAME_PROFILER_SAMPLES];
+static atomic<unsigned long long> ProfileSamplesTotal{ 0 };
+static atomic<unsigned long long> ProfileFrame{ 0 };
+
+// The time each stage started on the calling thread (see the ProfilerBegin function).
+static thread_local long long ProfileStageStart[PROFILE_STAGES_TOTAL];
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// ProfilerTime function: Definition
+long long ProfilerTime(void)
+{
+	return (long long)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ProfilerBeginFrame function: Definition
+void ProfilerBeginFrame(void)
+{
+	ProfileFrame.fetch_add(1, memory_order_relaxed);
+}
+
+// ProfilerFrame function: Definition
+unsigned long long ProfilerFrame(void)
+{
+	return ProfileFrame.load(memory_order_relaxed);
+}
+
+// ProfilerBegin function: Definition
+void ProfilerBegin(int Stage)
+{
+	ProfileStageStart[Stage] = ProfilerTime();
+}
+
+// ProfilerEnd function: Definition
+void ProfilerEnd(int Stage)
+{
+	ProfilerRecord(Stage, ProfileFrame.load(memory_order_relaxed), ProfilerTime() - ProfileStageStart[Stage]);
+}
+
+// ProfilerRecord function: Definition
+//   This function claims the next slot of the ring buffer, overwriting the oldest sample once the ring buffer is full, and writes the sample to it.
+void ProfilerRecord(int Stage, unsigned long long Frame, long long Nanoseconds)
+{
+	unsigned long long n = ProfileSamplesTotal.fetch_add(1, memory_order_relaxed);
+	ProfileSample& sample = ProfileSamples[n % FRAME_PROFILER_SAMPLES];
+	sample.Sequence.store(2 * n + 1, memory_order_relaxed);
+	std::atomic_thread_fence(memory_order_release);			// The slot is marked as being written before any member is written.
+	sample.Frame.store(Frame, memory_order_relaxed);
+	sample.Nanoseconds.store(Nanoseconds, memory_order_relaxed);
+	sample.Stage.store(Stage, memory_order_relaxed);
+	sample.Sequence.store(2 * n + 2, memory_order_release);	// The members are written before the slot is marked as written.
+}
+
+// ProfilerReset function: Definition
+//   This function discards every sample by marking every slot as never written. It must not be called while another thread records a sample.
+void ProfilerReset(void)
+{
+	for (ProfileSample& sample : ProfileSamples)
+		sample.Sequence.store(0, memory_order_relaxed);
+	ProfileSamplesTotal.store(0, memory_order_relaxed);
+}
+
+// GetProfileStatistics function: Definition
+//   This function gathers the times of Stage from the most recent FRAME_PROFILER_SAMPLES samples, skipping any slot being written or overwritten while it is read, and finds their percentiles by partial sorting.
+//   The k-th percentile is the smallest time that at least k percent of the samples do not exceed (the nearest-rank method).
+void GetProfileStatistics(int Stage, ProfileStatistics& Statistics)
+{
+	Statistics = ProfileStatistics();
+
+	unsigned long long total = ProfileSamplesTotal.load(memory_order_acquire);
+	unsigned long long first = total > FRAME_PROFILER_SAMPLES ? total - FRAME_PROFILER_SAMPLES : 0;
+	vector<long long> times;
+	for (unsigned long long n = first; n < total; n++)
+	{
+		const ProfileSample& sample = ProfileSamples[n % FRAME_PROFILER_SAMPLES];
+		unsigned long long sequence = sample.Sequence.load(memory_order_acquire);
+		if (sequence != 2 * n + 2)
+			continue;										// The sample is being written, or has been overwritten by a newer sample.
+		int stage = sample.Stage.load(memory_order_relaxed);
+		long long nanoseconds = sample.Nanoseconds.load(memory_order_relaxed);
+		std::atomic_thread_fence(memory_order_acquire);		// The members are read before the slot's mark is read again.
+		if (sample.Sequence.load(memory_order_relaxed) != sequence)
+			continue;										// The sample was overwritten while it was read.
+		if (stage == Stage)
+			times.push_back(nanoseconds);
+	}
+	if (times.empty())
+		return;
+
+	double sum = 0.0;
+	for (long long time : times)
+		sum += (double)time;
+	auto percentile = [&](size_t Percent)
+	{
+		size_t rank = (Percent * times.size() + 99) / 100;	// The nearest rank, from 1 to the number of samples: Percent percent of the number of samples, rounded up.
+		rank = rank < 1 ? 1 : rank;
+		std::nth_element(times.begin(), times.begin() + (rank - 1), times.end());
+		return times[rank - 1] / 1e6;
+	};
+	Statistics.Samples = (unsigned int)times.size();
+	Statistics.Mean = sum / times.size() / 1e6;
+	Statistics.Maximum = *std::max_element(times.begin(), times.end()) / 1e6;
+	Statistics.P50 = percentile(50);
+	Statistics.P95 = percentile(95);
+	Statistics.P99 = percentile(99);
+}
+
+// SaveProfileCsv function: Definition
+//   This function writes a header line, then one line per stage with samples: the stage's name, number of samples, and mean, 50th, 95th, and 99th percentile, and maximum time in milliseconds.
+int SaveProfileCsv(const char* FileName)
+{
+	ofstream file(FileName, std::ios::out | std::ios::trunc);
+	if (!file)
+		return 1;
+	file << "Stage,Samples,MeanMs,P50Ms,P95Ms,P99Ms,MaximumMs\n";
+	for (int stage = 0; stage < PROFILE_STAGES_TOTAL; stage++)
+	{
+		ProfileStatistics statistics;
+		GetProfileStatistics(stage, statistics);
+		if (statistics.Samples == 0)
+			continue;
+		file << ProfileStageNames[stage] << ',' << statistics.Samples << ',' << statistics.Mean << ',' << statistics.P50 << ',' << statistics.P95 << ',' << statistics.P99 << ',' << statistics.Maximum << '\n';
+	}
+	file.close();
+	return file ? 0 : 1;
+}
+
+// SaveProfileJson function: Definition
+//   This function writes one JSON object: "frames", the number of the last frame, and "stages", an object with one member per stage with samples, named after the stage, holding the same statistics as the .csv file.
+int SaveProfileJson(const char* FileName)
+{
+	ofstream file(FileName, std::ios::out | std::ios::trunc);
+	if (!file)
+		return 1;
+	file << "{\n  \"frames\": " << ProfilerFrame() << ",\n  \"stages\": {";
+	bool first = true;
+	for (int stage = 0; stage < PROFILE_STAGES_TOTAL; stage++)
+	{
+		ProfileStatistics statistics;
+		GetProfileStatistics(stage, statistics);
+		if (statistics.Samples == 0)
+			continue;
+		file << (first ? "\n" : ",\n") << "    \"" << ProfileStageNames[stage] << "\": { \"samples\": " << statistics.Samples << ", \"meanMs\": " << statistics.Mean << ", \"p50Ms\": " << statistics.P50
+			<< ", \"p95Ms\": " << statistics.P95 << ", \"p99Ms\": " << statistics.P99 << ", \"maximumMs\": " << statistics.Maximum << " }";
+		first = false;
+	}
+	file << "\n  }\n}\n";
+	file.close();
+	return file ? 0 : 1;
+}
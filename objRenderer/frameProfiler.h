@@ -0,0 +1,124 @@
+// frameProfiler Header File
+// Version 3.1
+//
+// Description
+// Frame profiler Header File
+// This header file contains the declarations used to time each stage of a frame (e.g., transform, clear, bind, constant update, draw, and present) on the CPU, and optionally on the GPU, and report where the frame time goes:
+// the number of samples, mean, 50th, 95th, and 99th percentiles, and maximum time of each stage over the most recent FRAME_PROFILER_SAMPLES samples, written to a .csv file and a .json file.
+// Each time is recorded into a lock-free ring buffer, so stages timed by the job system's threads (e.g., the frame job) are recorded without a lock, and recording costs two clock reads and a few atomic stores.
+// frameProfilerTest measures the cost of timing every stage of a frame, and checks that it is under 1% of a frame of 1 millisecond.
+// None of these functions use Direct3D; the GPU times are measured by the calling program (e.g., with D3D11_QUERY_TIMESTAMP queries) and recorded with the ProfilerRecord function. Include it in all source files that time frames, e.g., the objRenderer program.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Defines.
+// FRAME_PROFILER_ENABLED selects whether the PROFILE_FRAME, PROFILE_BEGIN, and PROFILE_END macros time anything. Define it as 0 (e.g., in the project's preprocessor definitions) to compile every timer out of the program: the macros are then empty statements, and cost nothing.
+#ifndef FRAME_PROFILER_ENABLED
+#define FRAME_PROFILER_ENABLED 1
+#endif
+//
+// The number of samples held by the ring buffer. A power of two. Each sample is one time of one stage in one frame, so it holds the most recent FRAME_PROFILER_SAMPLES / (stages timed per frame) frames.
+#define FRAME_PROFILER_SAMPLES 32768
+
+//***
+// Enumeration Declarations.
+//***
+
+// The stages of a frame. The CPU stages are timed by the PROFILE_BEGIN and PROFILE_END macros; the GPU stages are recorded by the calling program from timestamp queries.
+enum ProfileStage {
+	PROFILE_STAGE_FRAME,									// The whole frame on the CPU, from the start of RenderFrame to the return from Present.
+	PROFILE_STAGE_TRANSFORM,								// The frame job: rotating, culling, and batching the instances, writing the instance buffer, and culling meshlets. Timed on the thread that runs it.
+	PROFILE_STAGE_WAIT,										// Waiting for the frame job to finish.
+	PROFILE_STAGE_CLEAR,									// Clearing the render target and depth buffer.
+	PROFILE_STAGE_SORT,										// Sorting the draws of the render queue. The vertex buffers, index buffer, shaders, and texture are bound by the Draw stage, only when they change.
+	PROFILE_STAGE_CONSTANTS,								// Retiring finished frames and writing the constant buffers.
+	PROFILE_STAGE_DRAW,										// The DrawIndexedInstanced calls.
+	PROFILE_STAGE_SOFTWARE,									// Rendering the frame with the software rasterizer, when SoftwareRasterizerEnabled is true.
+	PROFILE_STAGE_PRESENT,									// Present.
+	PROFILE_STAGE_GPU_FRAME,								// The whole frame on the GPU, when FrameProfilerGpuEnabled is true.
+	PROFILE_STAGE_GPU_DRAW,									// The draws on the GPU, when FrameProfilerGpuEnabled is true.
+	PROFILE_STAGES_TOTAL
+};
+
+// End: Enumeration Declarations.
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the ProfileStatistics 'named structure' data type.
+// The times of one stage over the samples in the ring buffer, in milliseconds.
+struct ProfileStatistics {
+	unsigned int Samples = 0;								// The number of samples of the stage. The other members are 0 if it is 0.
+	double Mean = 0.0;
+	double P50 = 0.0;										// The 50th percentile (median): half the samples took at most this long.
+	double P95 = 0.0;
+	double P99 = 0.0;
+	double Maximum = 0.0;
+};
+
+// End: Structure Declarations.
+
+//***
+// External Variable Global Declarations.
+//***
+
+// FrameProfilerEnabled selects whether the objRenderer program times each stage of each frame. It is false by default.
+// When it is true, the statistics are written to FrameProfilerFileName followed by ".csv" and ".json" ("objRenderer.profile.csv" and "objRenderer.profile.json" by default) when F2 is pressed, and when the program ends.
+extern bool FrameProfilerEnabled;
+extern const char* FrameProfilerFileName;
+//
+// FrameProfilerGpuEnabled selects whether the GPU stages are also timed, with timestamp queries. It is false by default. It has no effect unless FrameProfilerEnabled is true.
+extern bool FrameProfilerGpuEnabled;
+//
+// The names of the stages, as written to the .csv and .json files.
+extern const char* const ProfileStageNames[PROFILE_STAGES_TOTAL];
+
+// End: External Variable Global Declarations.
+
+//***
+// Global Function Declarations.
+//***
+
+long long ProfilerTime(void);																// The ProfilerTime function returns the time, in nanoseconds, of a steady clock.
+void ProfilerBeginFrame(void);																// The ProfilerBeginFrame function starts the next frame: the samples recorded from now on belong to it.
+unsigned long long ProfilerFrame(void);														// The ProfilerFrame function returns the number of the current frame.
+void ProfilerBegin(int Stage);																// The ProfilerBegin function starts timing Stage on the calling thread.
+void ProfilerEnd(int Stage);																// The ProfilerEnd function records the time since the ProfilerBegin function was called for Stage on the calling thread.
+void ProfilerRecord(int Stage, unsigned long long Frame, long long Nanoseconds);			// The ProfilerRecord function records one time of Stage in frame number Frame, e.g., a time measured on the GPU.
+void ProfilerReset(void);																	// The ProfilerReset function discards every sample.
+void GetProfileStatistics(int Stage, ProfileStatistics& Statistics);						// The GetProfileStatistics function returns the statistics of Stage over the samples in the ring buffer.
+int SaveProfileCsv(const char* FileName);													// The SaveProfileCsv function writes the statistics of every stage with samples to a .csv file, one line per stage. It returns 0 on success, or 1 if the file cannot be written.
+int SaveProfileJson(const char* FileName);													// The SaveProfileJson function writes the statistics of every stage with samples to a .json file. It returns 0 on success, or 1 if the file cannot be written.
+
+// End: Global Function Declarations.
+
+//***
+// Macro Definitions.
+//***
+
+// The PROFILE_FRAME, PROFILE_BEGIN, and PROFILE_END macros call the ProfilerBeginFrame, ProfilerBegin, and ProfilerEnd functions when FrameProfilerEnabled is true, and compile to nothing when FRAME_PROFILER_ENABLED is 0.
+#if FRAME_PROFILER_ENABLED
+#define PROFILE_FRAME() do { if (FrameProfilerEnabled) ProfilerBeginFrame(); } while (0)
+#define PROFILE_BEGIN(Stage) do { if (FrameProfilerEnabled) ProfilerBegin(Stage); } while (0)
+#define PROFILE_END(Stage) do { if (FrameProfilerEnabled) ProfilerEnd(Stage); } while (0)
+#else
+#define PROFILE_FRAME() do { } while (0)
+#define PROFILE_BEGIN(Stage) do { } while (0)
+#define PROFILE_END(Stage) do { } while (0)
+#endif
+
+// End: Macro Definitions.
+
+// End: Global Declarations.
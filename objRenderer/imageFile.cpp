@@ -0,0 +1,493 @@
+// imageFile
+// Version 3.1
+//
+// Description
+// These functions read a texture image from a .png file, and write a rendered image to a .bmp file.
+// A .png file holds its rows of pixels compressed with the DEFLATE method (in a zlib stream split among its IDAT chunks), each row first filtered against the row above it. The LoadPngFile function inflates the stream,
+// reverses each row's filter, and expands every pixel to four 8-bit components. Only the features of .png files written by common image editors for textures are supported: 8 bits per component, and no interlacing.
+// The Huffman codes are decoded one bit at a time from canonical code lengths, which is simple and fast enough for a texture image read once.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Image file I/O Header File.
+#include "imageFile.h"
+
+// Read-only memory-mapped file I/O Header File.
+#include "mappedFile.h"
+
+// File Stream Functions.
+#include <fstream>											// File stream class member functions write, close, etc.
+
+// Memory Functions.
+#include <cstring>											// Memory functions memcmp.
+
+// Using Declarations and Directives.
+using std::vector;
+using std::ofstream;
+using std::ios;
+using std::memcmp;
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the InflateStream 'named structure' data type.
+// The state of the inflation of one zlib stream: the compressed bytes, the position of the next bit to read, and the inflated bytes.
+struct InflateStream {
+	const unsigned char* Data;								// The compressed bytes.
+	size_t Size;											// The number of compressed bytes.
+	size_t Position;										// The byte holding the next bit to read.
+	int BitPosition;										// The next bit to read in Data[Position], from 0 (least significant) to 7.
+	bool Overrun;											// True if a read went past the last compressed byte, i.e., the stream is truncated.
+	vector<unsigned char> Output;							// The inflated bytes.
+};
+
+// Declare the InflateHuffman 'named structure' data type.
+// A canonical Huffman code: Counts[n] is the number of codes of n bits, and Symbols lists the symbols in order of their codes.
+struct InflateHuffman {
+	short Counts[16];
+	short Symbols[288];
+};
+
+// End: Structure Declarations.
+
+// The base length and number of extra bits of each length symbol (257 to 285), and the base distance and number of extra bits of each distance symbol (0 to 29), from the DEFLATE specification (RFC 1951).
+static const short InflateLengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const short InflateLengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const short InflateDistanceBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+static const short InflateDistanceExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+// The order in which the code lengths of the code length code are stored in a dynamic Huffman block.
+static const unsigned char InflateCodeLengthOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+// The first eight bytes of every .png file.
+static const unsigned char PngSignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// InflateBits function: Definition
+//   This function reads Count bits (at most 16) from Stream, least significant bit first, and returns them. It returns 0 for each bit past the end of the stream, and sets Stream.Overrun.
+static int InflateBits(InflateStream& Stream, int Count)
+{
+	int value = 0;
+	for (int bit = 0; bit < Count; bit++)
+	{
+		if (Stream.Position >= Stream.Size)
+		{
+			Stream.Overrun = true;
+			return 0;
+		}
+		value |= ((Stream.Data[Stream.Position] >> Stream.BitPosition) & 1) << bit;
+		if (++Stream.BitPosition == 8)
+		{
+			Stream.BitPosition = 0;
+			Stream.Position++;
+		}
+	}
+	return value;
+}
+
+// InflateBuildHuffman function: Definition
+//   This function builds the canonical Huffman code of LengthsTotal symbols from the code length of each symbol (0 if the symbol is not used).
+//   It returns 0 on success, or 1 if the code lengths describe more codes than there are bit patterns (an incomplete code is allowed, as it is by zlib, for codes of one symbol).
+static int InflateBuildHuffman(InflateHuffman& Huffman, const unsigned char* Lengths, int LengthsTotal)
+{
+	for (int n = 0; n < 16; n++)
+		Huffman.Counts[n] = 0;
+	for (int s = 0; s < LengthsTotal; s++)
+		Huffman.Counts[Lengths[s]]++;
+
+	int left = 1;											// The number of bit patterns not yet used by a code.
+	for (int n = 1; n < 16; n++)
+	{
+		left = left * 2 - Huffman.Counts[n];
+		if (left < 0)
+			return 1;
+	}
+
+	short offsets[16];										// The location in Symbols of the first symbol of each code length.
+	offsets[1] = 0;
+	for (int n = 1; n < 15; n++)
+		offsets[n + 1] = offsets[n] + Huffman.Counts[n];
+	for (int s = 0; s < LengthsTotal; s++)
+		if (Lengths[s] != 0)
+			Huffman.Symbols[offsets[Lengths[s]]++] = (short)s;
+	return 0;
+}
+
+// InflateDecode function: Definition
+//   This function reads one code of Huffman from Stream, one bit at a time, and returns its symbol, or -1 if the bits are not a code of Huffman.
+static int InflateDecode(InflateStream& Stream, const InflateHuffman& Huffman)
+{
+	int code = 0;											// The bits read so far, most significant bit first, as Huffman codes are stored.
+	int first = 0;											// The first code of the current length.
+	int index = 0;											// The location in Symbols of the first symbol of the current length.
+	for (int n = 1; n < 16; n++)
+	{
+		code |= InflateBits(Stream, 1);
+		int count = Huffman.Counts[n];
+		if (code - first < count)
+			return Huffman.Symbols[index + code - first];
+		index += count;
+		first = (first + count) << 1;
+		code <<= 1;
+	}
+	return -1;
+}
+
+// InflateBlock function: Definition
+//   This function inflates the symbols of one compressed block of Stream with the literal/length code Lengths and the distance code Distances, until the end-of-block symbol.
+//   It returns 0 on success, or 1 if the block is invalid.
+static int InflateBlock(InflateStream& Stream, const InflateHuffman& Lengths, const InflateHuffman& Distances)
+{
+	while (true)
+	{
+		int symbol = InflateDecode(Stream, Lengths);
+		if (symbol < 0 || Stream.Overrun)
+			return 1;
+		if (symbol < 256)
+		{
+			Stream.Output.push_back((unsigned char)symbol);
+			continue;
+		}
+		if (symbol == 256)
+			return 0;										// The end of the block.
+
+		symbol -= 257;
+		if (symbol >= 29)
+			return 1;
+		int length = InflateLengthBase[symbol] + InflateBits(Stream, InflateLengthExtra[symbol]);
+		int distanceSymbol = InflateDecode(Stream, Distances);
+		if (distanceSymbol < 0 || distanceSymbol >= 30)
+			return 1;
+		size_t distance = InflateDistanceBase[distanceSymbol] + InflateBits(Stream, InflateDistanceExtra[distanceSymbol]);
+		if (distance > Stream.Output.size())
+			return 1;
+
+		// Copy one byte at a time, as the copied bytes may overlap the bytes being written (e.g., a run of one repeated byte has a distance of 1).
+		size_t from = Stream.Output.size() - distance;
+		for (int i = 0; i < length; i++)
+		{
+			unsigned char copied = Stream.Output[from + i];		// Read before push_back, which may move the bytes.
+			Stream.Output.push_back(copied);
+		}
+	}
+}
+
+// Inflate function: Definition
+//   This function inflates the zlib stream of Size bytes at Data (a two-byte header, DEFLATE blocks, and a checksum, which is not checked) and appends the inflated bytes to Output.
+//   It returns 0 on success, or 1 if the stream is invalid.
+static int Inflate(const unsigned char* Data, size_t Size, vector<unsigned char>& Output)
+{
+	if (Size < 2 || (Data[0] & 0x0F) != 8 || ((Data[0] << 8) | Data[1]) % 31 != 0 || (Data[1] & 0x20) != 0)
+		return 1;											// Not a DEFLATE zlib stream without a preset dictionary.
+
+	InflateStream stream = { Data, Size, 2, 0, false, vector<unsigned char>() };
+	stream.Output.swap(Output);
+	int result = 0;
+	int last = 0;
+	while (!last && result == 0)
+	{
+		last = InflateBits(stream, 1);
+		int type = InflateBits(stream, 2);
+		if (type == 0)
+		{
+			// A stored block: skip to the next byte, then copy LEN bytes, following LEN and its complement NLEN.
+			if (stream.BitPosition != 0)
+			{
+				stream.BitPosition = 0;
+				stream.Position++;
+			}
+			if (stream.Position + 4 > stream.Size)
+				result = 1;
+			else
+			{
+				size_t length = stream.Data[stream.Position] | (stream.Data[stream.Position + 1] << 8);
+				size_t complement = stream.Data[stream.Position + 2] | (stream.Data[stream.Position + 3] << 8);
+				stream.Position += 4;
+				if (length != (~complement & 0xFFFF) || stream.Position + length > stream.Size)
+					result = 1;
+				else
+				{
+					stream.Output.insert(stream.Output.end(), stream.Data + stream.Position, stream.Data + stream.Position + length);
+					stream.Position += length;
+				}
+			}
+		}
+		else if (type == 1)
+		{
+			// A block compressed with the fixed Huffman codes.
+			unsigned char lengths[288 + 30];
+			for (int s = 0; s < 288; s++)
+				lengths[s] = s < 144 ? 8 : s < 256 ? 9 : s < 280 ? 7 : 8;
+			for (int s = 0; s < 30; s++)
+				lengths[288 + s] = 5;
+			InflateHuffman lengthCode, distanceCode;
+			InflateBuildHuffman(lengthCode, lengths, 288);
+			InflateBuildHuffman(distanceCode, lengths + 288, 30);
+			result = InflateBlock(stream, lengthCode, distanceCode);
+		}
+		else if (type == 2)
+		{
+			// A block compressed with dynamic Huffman codes, whose code lengths are themselves compressed with a code length code.
+			int lengthsTotal = InflateBits(stream, 5) + 257;
+			int distancesTotal = InflateBits(stream, 5) + 1;
+			int codeLengthsTotal = InflateBits(stream, 4) + 4;
+			if (lengthsTotal > 286 || distancesTotal > 30)
+			{
+				result = 1;
+				break;
+			}
+			unsigned char codeLengths[19] = {};
+			for (int i = 0; i < codeLengthsTotal; i++)
+				codeLengths[InflateCodeLengthOrder[i]] = (unsigned char)InflateBits(stream, 3);
+			InflateHuffman codeLengthCode;
+			if (InflateBuildHuffman(codeLengthCode, codeLengths, 19) == 1)
+			{
+				result = 1;
+				break;
+			}
+
+			unsigned char lengths[286 + 30];
+			int count = 0;
+			while (count < lengthsTotal + distancesTotal && result == 0)
+			{
+				int symbol = InflateDecode(stream, codeLengthCode);
+				if (symbol < 0 || stream.Overrun)
+					result = 1;
+				else if (symbol < 16)
+					lengths[count++] = (unsigned char)symbol;
+				else
+				{
+					// Symbol 16 repeats the previous length 3 to 6 times, and symbols 17 and 18 repeat a length of zero 3 to 10 and 11 to 138 times.
+					int repeated = 0, times;
+					if (symbol == 16)
+					{
+						if (count == 0)
+						{
+							result = 1;
+							break;
+						}
+						repeated = lengths[count - 1];
+						times = 3 + InflateBits(stream, 2);
+					}
+					else if (symbol == 17)
+						times = 3 + InflateBits(stream, 3);
+					else
+						times = 11 + InflateBits(stream, 7);
+					if (count + times > lengthsTotal + distancesTotal)
+						result = 1;
+					else
+						while (times-- > 0)
+							lengths[count++] = (unsigned char)repeated;
+				}
+			}
+			if (result == 1)
+				break;
+
+			InflateHuffman lengthCode, distanceCode;
+			if (InflateBuildHuffman(lengthCode, lengths, lengthsTotal) == 1 || InflateBuildHuffman(distanceCode, lengths + lengthsTotal, distancesTotal) == 1)
+				result = 1;
+			else
+				result = InflateBlock(stream, lengthCode, distanceCode);
+		}
+		else
+			result = 1;										// Block type 3 is reserved.
+		if (stream.Overrun)
+			result = 1;
+	}
+
+	stream.Output.swap(Output);
+	return result;
+}
+
+// PngReadUInt32 function: Definition
+//   This function returns the 32-bit unsigned integer stored most significant byte first at Data, as every integer of a .png file is stored.
+static unsigned int PngReadUInt32(const unsigned char* Data)
+{
+	return ((unsigned int)Data[0] << 24) | ((unsigned int)Data[1] << 16) | ((unsigned int)Data[2] << 8) | (unsigned int)Data[3];
+}
+
+// PngPaeth function: Definition
+//   This function returns whichever of the pixel to the left (Left), above (Up), and above and to the left (UpLeft) is closest to Left + Up - UpLeft, which the Paeth filter predicts a component from.
+static int PngPaeth(int Left, int Up, int UpLeft)
+{
+	int estimate = Left + Up - UpLeft;
+	int distanceLeft = estimate > Left ? estimate - Left : Left - estimate;
+	int distanceUp = estimate > Up ? estimate - Up : Up - estimate;
+	int distanceUpLeft = estimate > UpLeft ? estimate - UpLeft : UpLeft - estimate;
+	if (distanceLeft <= distanceUp && distanceLeft <= distanceUpLeft)
+		return Left;
+	return distanceUp <= distanceUpLeft ? Up : UpLeft;
+}
+
+// LoadPngFile function: Definition
+//   This function maps the .png file FileName into memory, gathers its IHDR, PLTE, tRNS, and IDAT chunks, inflates the pixel data, reverses the filter of each row, and expands each pixel to red, green, blue, and alpha.
+//   Grayscale pixels are copied to red, green, and blue. Pixels without alpha have an alpha of 255, unless a palette entry has an alpha in the tRNS chunk.
+int LoadPngFile(const char* FileName, Image& Result)
+{
+	Result = Image();
+
+	MappedFile file;
+	if (MapFile(FileName, file) == 1)
+		return 1;											// The file cannot be opened.
+
+	const unsigned char* data = (const unsigned char*)file.Data;
+	if (file.Size < 8 || memcmp(data, PngSignature, 8) != 0)
+	{
+		UnmapFile(file);
+		return 1;											// Not a .png file.
+	}
+
+	// Gather the chunks. Each chunk is a 4-byte length, a 4-byte type, the data, and a 4-byte checksum (not checked).
+	int width = 0, height = 0, colorType = -1, channels = 0;
+	unsigned char palette[256][4];							// The color of each palette entry, with the alpha from the tRNS chunk, if any.
+	for (int p = 0; p < 256; p++)
+		palette[p][0] = palette[p][1] = palette[p][2] = 0, palette[p][3] = 255;
+	vector<unsigned char> compressed;						// The data of every IDAT chunk, in order, i.e., the zlib stream.
+	int result = 0;
+	for (size_t position = 8; position + 12 <= file.Size; )
+	{
+		size_t length = PngReadUInt32(data + position);
+		const unsigned char* type = data + position + 4;
+		const unsigned char* chunk = data + position + 8;
+		if (length > file.Size - position - 12)
+		{
+			result = 1;
+			break;
+		}
+		if (memcmp(type, "IHDR", 4) == 0 && length >= 13)
+		{
+			width = (int)PngReadUInt32(chunk);
+			height = (int)PngReadUInt32(chunk + 4);
+			colorType = chunk[9];
+			channels = colorType == 0 ? 1 : colorType == 2 ? 3 : colorType == 3 ? 1 : colorType == 4 ? 2 : colorType == 6 ? 4 : 0;
+			if (chunk[8] != 8 || channels == 0 || chunk[12] != 0 || width <= 0 || height <= 0 || width > (1 << 16) || height > (1 << 16))
+			{
+				result = 1;									// Not 8 bits per component, an unknown color type, interlaced, or too large.
+				break;
+			}
+		}
+		else if (memcmp(type, "PLTE", 4) == 0)
+		{
+			for (size_t p = 0; p < length / 3 && p < 256; p++)
+				palette[p][0] = chunk[p * 3], palette[p][1] = chunk[p * 3 + 1], palette[p][2] = chunk[p * 3 + 2];
+		}
+		else if (memcmp(type, "tRNS", 4) == 0 && colorType == 3)
+		{
+			for (size_t p = 0; p < length && p < 256; p++)
+				palette[p][3] = chunk[p];
+		}
+		else if (memcmp(type, "IDAT", 4) == 0)
+			compressed.insert(compressed.end(), chunk, chunk + length);
+		else if (memcmp(type, "IEND", 4) == 0)
+			break;
+		position += length + 12;
+	}
+	UnmapFile(file);
+	if (result == 1 || channels == 0)
+		return 1;
+
+	// Inflate the rows. Each row is one filter type byte followed by width * channels bytes.
+	size_t stride = (size_t)width * channels;
+	vector<unsigned char> filtered;
+	filtered.reserve((stride + 1) * height);
+	if (Inflate(compressed.data(), compressed.size(), filtered) == 1 || filtered.size() < (stride + 1) * height)
+		return 1;
+
+	// Reverse the filter of each row. Each filter predicts a component from the component of the pixel to the left (a), above (b), or above and to the left (c), which are 0 outside the image.
+	vector<unsigned char> rows(stride * height);
+	for (int y = 0; y < height; y++)
+	{
+		int filter = filtered[y * (stride + 1)];
+		const unsigned char* source = filtered.data() + y * (stride + 1) + 1;
+		unsigned char* row = rows.data() + y * stride;
+		const unsigned char* above = y > 0 ? row - stride : nullptr;
+		for (size_t i = 0; i < stride; i++)
+		{
+			int a = i >= (size_t)channels ? row[i - channels] : 0;
+			int b = above ? above[i] : 0;
+			int c = above && i >= (size_t)channels ? above[i - channels] : 0;
+			int prediction;
+			switch (filter)
+			{
+			case 0: prediction = 0; break;					// None.
+			case 1: prediction = a; break;					// Sub.
+			case 2: prediction = b; break;					// Up.
+			case 3: prediction = (a + b) / 2; break;		// Average.
+			case 4: prediction = PngPaeth(a, b, c); break;	// Paeth.
+			default: return 1;
+			}
+			row[i] = (unsigned char)(source[i] + prediction);
+		}
+	}
+
+	// Expand each pixel to red, green, blue, and alpha.
+	Result.Width = width;
+	Result.Height = height;
+	Result.Pixels.resize((size_t)width * height * 4);
+	for (size_t p = 0; p < (size_t)width * height; p++)
+	{
+		const unsigned char* source = rows.data() + p * channels;
+		unsigned char* pixel = Result.Pixels.data() + p * 4;
+		switch (colorType)
+		{
+		case 0: pixel[0] = pixel[1] = pixel[2] = source[0]; pixel[3] = 255; break;
+		case 2: pixel[0] = source[0]; pixel[1] = source[1]; pixel[2] = source[2]; pixel[3] = 255; break;
+		case 3: for (int c = 0; c < 4; c++) pixel[c] = palette[source[0]][c]; break;
+		case 4: pixel[0] = pixel[1] = pixel[2] = source[0]; pixel[3] = source[1]; break;
+		case 6: for (int c = 0; c < 4; c++) pixel[c] = source[c]; break;
+		}
+	}
+	return 0;
+}
+
+// SaveBmpFile function: Definition
+//   This function writes Source to FileName as a 24-bit .bmp file: a 14-byte file header, a 40-byte BITMAPINFOHEADER, and the rows of blue, green, and red components, from the bottom row, each padded to a multiple of 4 bytes.
+int SaveBmpFile(const char* FileName, const Image& Source)
+{
+	size_t rowBytes = ((size_t)Source.Width * 3 + 3) & ~(size_t)3;
+	size_t fileBytes = 54 + rowBytes * Source.Height;
+
+	unsigned char header[54] = { 'B', 'M' };
+	auto store32 = [&header](int Offset, unsigned int Value)
+		{
+			for (int b = 0; b < 4; b++)
+				header[Offset + b] = (unsigned char)(Value >> (b * 8));
+		};
+	store32(2, (unsigned int)fileBytes);					// The size of the file.
+	store32(10, 54);										// The offset of the pixels.
+	store32(14, 40);										// The size of the BITMAPINFOHEADER.
+	store32(18, (unsigned int)Source.Width);
+	store32(22, (unsigned int)Source.Height);				// A positive height: the rows are stored from the bottom row.
+	header[26] = 1;											// One plane.
+	header[28] = 24;										// 24 bits per pixel.
+
+	ofstream file(FileName, ios::binary);
+	if (!file)
+		return 1;
+	file.write((const char*)header, sizeof(header));
+	vector<unsigned char> row(rowBytes, 0);
+	for (int y = Source.Height - 1; y >= 0; y--)
+	{
+		const unsigned char* pixel = Source.Pixels.data() + (size_t)y * Source.Width * 4;
+		for (int x = 0; x < Source.Width; x++, pixel += 4)
+		{
+			row[x * 3] = pixel[2];
+			row[x * 3 + 1] = pixel[1];
+			row[x * 3 + 2] = pixel[0];
+		}
+		file.write((const char*)row.data(), rowBytes);
+	}
+	file.close();
+	return file ? 0 : 1;
+}
@@ -0,0 +1,48 @@
+// imageFile Header File
+// Version 3.1
+//
+// Description
+// Image file I/O Header File
+// This header file contains the declarations used to read a texture image from a .png file, and to write a rendered image to a .bmp file, into and from memory the CPU can read, without Direct3D or the Windows Imaging Component.
+// Include it in all source files that read or write image files, e.g., the softwareRasterizer functions and the objRenderer program.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Vector Container Class.
+#include <vector>											// Vector class, used to hold the pixels of an image.
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the Image 'named structure' data type.
+// An Image holds Width x Height pixels, row by row from the top row, each pixel as four 8-bit components: red, green, blue, and alpha, i.e., the layout of DXGI_FORMAT_R8G8B8A8_UNORM.
+struct Image {
+	int Width = 0;											// The width of the image, in pixels.
+	int Height = 0;											// The height of the image, in pixels.
+	std::vector<unsigned char> Pixels;						// Width * Height * 4 components. The component c of pixel (x, y) is Pixels[(y * Width + x) * 4 + c].
+};
+
+// End: Structure Declarations.
+
+//***
+// Global Function Declarations.
+//***
+
+int LoadPngFile(const char* FileName, Image& Result);		// The LoadPngFile function reads a non-interlaced .png file with 8 bits per component (grayscale, RGB, palette, grayscale with alpha, or RGBA) into Result. It returns 0 on success, or 1 if the file cannot be opened or is not such a .png file.
+int SaveBmpFile(const char* FileName, const Image& Source);	// The SaveBmpFile function writes Source to a 24-bit .bmp file, without its alpha components. It returns 0 on success, or 1 if the file cannot be written.
+
+// End: Global Function Declarations.
+
+// End: Global Declarations.
@@ -0,0 +1,148 @@
+// instanceBuilder
+// Version 3.1
+//
+// Description
+// These functions fill the instance buffer read by the vertex shader when the objRenderer program draws many instances of the object with DrawIndexedInstanced: one INSTANCEDATA structure (world matrix and normal matrix) per instance.
+//
+// Drawing each instance with its own UpdateSubresource call and DrawIndexed call costs the CPU one constant buffer copy and one draw call per instance, which limits the number of instances long before the GPU is busy.
+// With an instance buffer, every instance with the same level of detail is drawn by one DrawIndexedInstanced call.
+// The instances are culled against the viewing frustum and grouped by level of detail with a counting sort, and their INSTANCEDATA structures are then written by the TransformInstances function (see batchTransform.h),
+// so the buffer is written once, in order, which suits a mapped D3D11_USAGE_DYNAMIC buffer. Both passes are divided among the threads of the job system (see jobSystem.h) when there are enough instances.
+// None of these functions use Direct3D, so they can be called (and timed) without a device.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Instance data Header File.
+#include "instanceBuilder.h"
+
+// Vector Container Class.
+#include <vector>											// Vector class member functions assign, resize, push_back, etc.
+
+// Meshlet (cluster) Header File.
+// Declares the ExtractFrustumPlanes function.
+#include "meshletBuilder.h"
+
+// Job system Header File.
+#include "jobSystem.h"
+
+// Using Declarations and Directives.
+using std::vector;
+
+//***
+// External Variable Global Definitions.
+//***
+
+int ObjectInstancesTotal = 2;
+int InstancesDrawn = 0;
+
+// End: External Variable Global Definitions.
+
+// Constants of the BuildInstanceBatches function.
+static const int InstanceCullParallelMinimum = 4096;		// The instances are divided among the worker threads for culling only if each thread gets at least this many instances.
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// BuildInstanceBatches function: Definition
+//   This function fills the instance buffer, Result, with the INSTANCEDATA structures of the instances of Transforms that are not culled, grouped by level of detail, and returns the number of them.
+//   1. An instance is culled if its bounding sphere (BoundsCenter and BoundsRadius, in object space) is entirely outside one of the six planes of the viewing frustum of matViewProjection, the combined view and projection matrix.
+//      Otherwise its level of detail is selected from its distance to EyePosition (see the SelectMeshLod function), as for a single instance. Each instance is independent, so this is divided among the worker threads.
+//   2. The instances not culled are ordered by level of detail, with a counting sort, so each level of detail is one range of the instance buffer.
+//      Batches receives one InstanceBatch per level of detail that has at least one instance, and Order[s] receives the index in Transforms of the instance written to Result[s].
+//   3. The INSTANCEDATA structures are written to Result in that order by the TransformInstances function.
+//   Result must have room for one INSTANCEDATA structure per instance. Each structure is written once.
+int BuildInstanceBatches(const InstanceTransformArrays& Transforms, FXMMATRIX matViewProjection, FXMVECTOR EyePosition, float ProjectionScale,
+	const XMFLOAT3& BoundsCenter, float BoundsRadius, const MeshLod* Lods, int LodsTotal, INSTANCEDATA* Result, vector<int>& Order, vector<InstanceBatch>& Batches)
+{
+	//***
+	// 1. Cull each instance, and select the level of detail of those not culled.
+	//***
+
+	// The planes are found in world space, and transposed so that the distances from the center of a bounding sphere to four planes are found together (see the CullMeshlets function).
+	XMVECTOR planes[6];
+	ExtractFrustumPlanes(matViewProjection, planes);
+	XMMATRIX planes0123 = XMMatrixTranspose(XMMATRIX(planes[0], planes[1], planes[2], planes[3]));
+	XMMATRIX planes4545 = XMMatrixTranspose(XMMATRIX(planes[4], planes[5], planes[4], planes[5]));
+
+	int instancesTotal = (int)Transforms.Scale.size();
+	XMVECTOR center = XMLoadFloat3(&BoundsCenter);
+	vector<signed char> instanceLod(instancesTotal);		// The level of detail of each instance, or -1 if it is culled. MESH_LOD_LEVELS_MAXIMUM is less than 128.
+
+	JobParallelFor(instancesTotal, InstanceCullParallelMinimum, [&](int Begin, int End)
+		{
+			for (int i = Begin; i < End; i++)
+			{
+				// The bounding sphere of the instance, in world space. The scale is the same along every axis, so the sphere remains a sphere.
+				float scale = Transforms.Scale[i];
+				XMVECTOR rotation = XMVectorSet(Transforms.RotationX[i], Transforms.RotationY[i], Transforms.RotationZ[i], Transforms.RotationW[i]);
+				XMVECTOR position = XMVectorSet(Transforms.PositionX[i], Transforms.PositionY[i], Transforms.PositionZ[i], 0.0f);
+				XMVECTOR worldCenter = XMVectorAdd(XMVector3Rotate(XMVectorScale(center, scale), rotation), position);
+				float radius = BoundsRadius * scale;
+
+				// The frustum test: the sphere is outside if its center is further than its radius behind any plane.
+				XMVECTOR x = XMVectorSplatX(worldCenter);
+				XMVECTOR y = XMVectorSplatY(worldCenter);
+				XMVECTOR z = XMVectorSplatZ(worldCenter);
+				XMVECTOR negativeRadius = XMVectorReplicate(-radius);
+				XMVECTOR distance0123 = XMVectorMultiplyAdd(x, planes0123.r[0], XMVectorMultiplyAdd(y, planes0123.r[1], XMVectorMultiplyAdd(z, planes0123.r[2], planes0123.r[3])));
+				XMVECTOR distance4545 = XMVectorMultiplyAdd(x, planes4545.r[0], XMVectorMultiplyAdd(y, planes4545.r[1], XMVectorMultiplyAdd(z, planes4545.r[2], planes4545.r[3])));
+				if (!XMVector4GreaterOrEqual(distance0123, negativeRadius) || !XMVector4GreaterOrEqual(distance4545, negativeRadius))
+				{
+					instanceLod[i] = -1;
+					continue;
+				}
+
+				// SelectMeshLod compares the geometric error in object space, so the distance from the camera to the nearest point of the sphere is converted to object space.
+				float distance = XMVectorGetX(XMVector3Length(XMVectorSubtract(worldCenter, EyePosition))) - radius;
+				instanceLod[i] = (signed char)SelectMeshLod(Lods, LodsTotal, distance / scale, ProjectionScale, MeshLodPixelError);
+			}
+		});
+
+	// End: 1. Cull each instance, and select the level of detail of those not culled.
+
+	//***
+	// 2. Order the instances not culled by level of detail.
+	//***
+
+	int lodInstances[MESH_LOD_LEVELS_MAXIMUM] = {};			// The number of instances of each level of detail.
+	for (int i = 0; i < instancesTotal; i++)
+		if (instanceLod[i] >= 0)
+			lodInstances[instanceLod[i]]++;
+
+	// One batch per level of detail with at least one instance. slot[l] is the location in Result of the next instance of level of detail l.
+	int slot[MESH_LOD_LEVELS_MAXIMUM];
+	int drawn = 0;
+	Batches.clear();
+	for (int lod = 0; lod < LodsTotal; lod++)
+	{
+		slot[lod] = drawn;
+		if (lodInstances[lod] > 0)
+			Batches.push_back({ lod, drawn, lodInstances[lod] });
+		drawn += lodInstances[lod];
+	}
+
+	Order.resize(drawn);
+	for (int i = 0; i < instancesTotal; i++)
+		if (instanceLod[i] >= 0)
+			Order[slot[instanceLod[i]]++] = i;
+
+	// End: 2. Order the instances not culled by level of detail.
+
+	//***
+	// 3. Write the INSTANCEDATA structures of the instances not culled, in that order.
+	//***
+
+	TransformInstances(Transforms, Order.data(), drawn, Result);
+
+	// End: 3. Write the INSTANCEDATA structures of the instances not culled, in that order.
+
+	return drawn;
+}
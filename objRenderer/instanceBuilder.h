@@ -0,0 +1,67 @@
+// instanceBuilder Header File
+// Version 3.1
+//
+// Description
+// Instance data Header File
+// This header file contains the declarations used to draw many instances of the object with one DrawIndexedInstanced call per level of detail, instead of one UpdateSubresource call and one DrawIndexed call per instance:
+// the functions that cull the instances outside the viewing frustum, group the others by level of detail, and fill the instance buffer with their INSTANCEDATA structures (see batchTransform.h).
+// None of these functions use Direct3D. Include it in all source files that draw instances of the object, e.g., the objRenderer program.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Mesh simplification Header File.
+// Declares the MeshLod structure, and includes the Wavefront .obj file I/O Header File (the DirectXMath Header File and the Vector Container Class).
+#include "meshSimplifier.h"
+
+// Batch instance transform Header File.
+// Declares the InstanceTransform, InstanceTransformArrays, and INSTANCEDATA structures.
+#include "batchTransform.h"
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the InstanceBatch 'named structure' data type.
+// A range of consecutive INSTANCEDATA structures of the instance buffer that are drawn with the same level of detail, i.e., by one DrawIndexedInstanced call.
+struct InstanceBatch {
+	int Lod;												// The level of detail (see MeshLods) of every instance of the batch.
+	int FirstInstance;										// The location, in the instance buffer, of the first INSTANCEDATA structure of the batch.
+	int InstancesTotal;										// The total number of instances of the batch.
+};
+
+// End: Structure Declarations.
+
+//***
+// External Variable Global Declarations.
+//***
+
+// ObjectInstancesTotal is the number of instances of the object drawn by the objRenderer program. It is 2 by default: the rotating object, and a second instance above it rotating the other way.
+// Further instances are placed on a square grid behind the first two, so that drawing from 2 to 100000 instances can be compared.
+extern int ObjectInstancesTotal;
+//
+// InstancesDrawn is the number of instances of the object that were not culled in the most recent frame.
+extern int InstancesDrawn;
+
+// End: External Variable Global Declarations.
+
+//***
+// Global Function Declarations.
+//***
+
+int BuildInstanceBatches(const InstanceTransformArrays& Transforms, FXMMATRIX matViewProjection, FXMVECTOR EyePosition, float ProjectionScale,
+	const XMFLOAT3& BoundsCenter, float BoundsRadius, const MeshLod* Lods, int LodsTotal, INSTANCEDATA* Result, std::vector<int>& Order, std::vector<InstanceBatch>& Batches);	// The BuildInstanceBatches function culls the instances outside the viewing frustum, selects the level of detail of the others, and fills their INSTANCEDATA structures grouped by level of detail. It returns the number of instances not culled.
+
+// End: Global Function Declarations.
+
+// End: Global Declarations.
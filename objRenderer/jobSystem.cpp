@@ -0,0 +1,296 @@
+// jobSystem
+// Version 3.1
+//
+// Description
+// These functions run jobs on a pool of worker threads. Each thread (the worker threads, and the main thread, which starts the job system) has its own queue of jobs. A thread adds the jobs it starts to the back of its own queue,
+// and runs jobs from the back of its own queue first, i.e., the job it started most recently, whose data is most likely still in its cache. A thread whose queue is empty steals a job from the front of another thread's queue,
+// i.e., the oldest job, which is most likely to start more work. So work started by one thread is spread among every thread without a single shared queue for which all threads would contend.
+//
+// A job may create and start children, and a job is not finished until every one of its children is finished. A thread waiting for a job runs other jobs until it is finished, so a job may wait for the jobs it starts
+// (e.g., a job calls the JobParallelFor function) without blocking a thread. Worker threads that find no job sleep on a condition variable until a job is started.
+//
+// The worker threads are started by the first job run. Jobs must be run and waited for only by the main thread, the worker threads, and the jobs they run.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Job system Header File.
+#include "jobSystem.h"
+
+// Vector Container Class.
+#include <vector>											// Vector class member functions emplace_back, clear, etc.
+
+// Double-Ended Queue Container Class.
+#include <deque>											// Deque class member functions push_back, pop_back, pop_front, etc.
+
+// Algorithm Functions.
+#include <algorithm>										// Algorithm functions min.
+
+// Memory Management.
+#include <memory>											// Unique pointer class, make_unique.
+
+// Thread Support.
+#include <thread>											// Thread class member functions join, hardware_concurrency, etc. This thread namespace function yield.
+#include <mutex>											// Mutex class, lock_guard class, unique_lock class.
+#include <condition_variable>								// Condition variable class member functions wait, notify_one, etc.
+
+// Using Declarations and Directives.
+using std::vector;
+using std::deque;
+using std::min;
+using std::unique_ptr;
+using std::make_unique;
+using std::thread;
+using std::mutex;
+using std::lock_guard;
+using std::unique_lock;
+using std::condition_variable;
+using std::atomic;
+using std::function;
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the JobQueue 'named structure' data type.
+// The queue of the jobs started by one thread and not yet run. Its owner takes jobs from the back, and the other threads steal jobs from the front.
+// The queue is protected by its own mutex, so threads contend only when one steals from another, or both steal from the same queue.
+struct JobQueue {
+	mutex Mutex;											// Protects Jobs.
+	deque<Job*> Jobs;										// The jobs started by the owner and not yet run.
+};
+
+// End: Structure Declarations.
+
+//***
+// External Variable Global Definitions.
+//***
+
+int JobSystemThreads = 0;
+
+// End: External Variable Global Definitions.
+
+// The state of the job system.
+static vector<unique_ptr<JobQueue>> JobQueues;				// The queue of each thread. Queue 0 belongs to the main thread, and queue t to worker thread t.
+static vector<thread> JobWorkers;							// The worker threads. There is one less worker thread than the number of threads, as the main thread also runs jobs.
+static atomic<int> JobsQueued(0);							// The number of jobs in every queue, so that sleeping worker threads are woken only when there is a job to run.
+static atomic<bool> JobSystemStopping(false);				// True when the worker threads are to return.
+static mutex JobSleepMutex;									// Protects the sleep of the worker threads, i.e., orders JobsQueued and JobSystemStopping with JobSleepWake.
+static condition_variable JobSleepWake;						// Notified when a job is started, or the worker threads are stopped.
+static thread_local int JobThreadIndex = 0;					// The index of the calling thread's queue. It is 0 for the main thread (and any other thread that is not a worker thread).
+
+// JobSpinsBeforeSleep is the number of times an idle worker thread looks for a job to steal before it sleeps, so that a worker thread finishing one job is not put to sleep just before the next job is started.
+static const int JobSpinsBeforeSleep = 64;
+
+// JobRangesPerThread is the number of ranges per thread into which the JobParallelFor function divides its work (if the work is large enough), so that a thread that finishes its ranges early steals ranges from threads that are still busy.
+static const int JobRangesPerThread = 4;
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// JobNext function: Definition
+//   This function takes the next job for the calling thread to run: the newest job in its own queue, or else the oldest job in another thread's queue. It returns nullptr if every queue is empty.
+static Job* JobNext(void)
+{
+	int queuesTotal = (int)JobQueues.size();
+	for (int q = 0; q < queuesTotal; q++)
+	{
+		int queueIndex = (JobThreadIndex + q) % queuesTotal;	// The calling thread's queue first, then the queues of the following threads, so thieves start from different queues.
+		JobQueue& queue = *JobQueues[queueIndex];
+		lock_guard<mutex> lock(queue.Mutex);
+		if (queue.Jobs.empty())
+			continue;
+
+		Job* job;
+		if (q == 0)
+		{
+			job = queue.Jobs.back();
+			queue.Jobs.pop_back();
+		}
+		else
+		{
+			job = queue.Jobs.front();
+			queue.Jobs.pop_front();
+		}
+		JobsQueued--;
+		return job;
+	}
+	return nullptr;
+}
+
+// JobFinish function: Definition
+//   This function records that the function of a job, or one of its children, is finished. If the job is then finished, its parent is told in turn, and the job is deleted, unless it has no parent, in which case it is deleted by the JobWait function.
+//   The parent is read before the job is marked finished, as a job without a parent may be deleted by the thread waiting for it as soon as it is marked finished.
+static void JobFinish(Job* FinishedJob)
+{
+	Job* parent = FinishedJob->Parent;
+	if (FinishedJob->Unfinished.fetch_sub(1) != 1)
+		return;
+	if (parent)
+	{
+		JobFinish(parent);
+		delete FinishedJob;
+	}
+}
+
+// JobExecute function: Definition
+//   This function runs the function of a job, then records that it is finished.
+static void JobExecute(Job* ExecutedJob)
+{
+	if (ExecutedJob->Function)
+		ExecutedJob->Function();
+	JobFinish(ExecutedJob);
+}
+
+// JobWorker function: Definition
+//   This function is the body of each worker thread. It runs jobs until none are left, then looks for a job to steal several times, then sleeps until a job is started, until the worker threads are stopped.
+static void JobWorker(int ThreadIndex)
+{
+	JobThreadIndex = ThreadIndex;
+	int spins = 0;
+	while (!JobSystemStopping)
+	{
+		Job* job = JobNext();
+		if (job)
+		{
+			JobExecute(job);
+			spins = 0;
+			continue;
+		}
+		if (++spins < JobSpinsBeforeSleep)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+		unique_lock<mutex> lock(JobSleepMutex);
+		JobSleepWake.wait(lock, [] { return JobSystemStopping || JobsQueued > 0; });
+		spins = 0;
+	}
+}
+
+// JobSystemStart function: Definition
+//   This function creates a queue per thread and starts the worker threads, if they are not started. The calling thread is the main thread, and owns queue 0.
+static void JobSystemStart(void)
+{
+	if (!JobQueues.empty())
+		return;
+
+	int threadsTotal = JobSystemThreadsTotal();
+	for (int t = 0; t < threadsTotal; t++)
+		JobQueues.push_back(make_unique<JobQueue>());
+
+	JobSystemStopping = false;
+	for (int t = 1; t < threadsTotal; t++)
+		JobWorkers.emplace_back(JobWorker, t);
+}
+
+// JobSystemThreadsTotal function: Definition
+//   This function returns the number of threads that run jobs, including the main thread: the number of queues, if the job system is started, or else JobSystemThreads, or the number of hardware threads if it is 0.
+//   The number of hardware threads is found once, as hardware_concurrency may query the operating system each time it is called.
+int JobSystemThreadsTotal(void)
+{
+	if (!JobQueues.empty())
+		return (int)JobQueues.size();
+
+	static const int hardwareThreads = (int)thread::hardware_concurrency();
+	int threadsTotal = JobSystemThreads > 0 ? JobSystemThreads : hardwareThreads;
+	return threadsTotal > 1 ? threadsTotal : 1;				// hardware_concurrency returns 0 if the number of hardware threads cannot be determined.
+}
+
+// JobCreate function: Definition
+//   This function creates a job that runs Function. If Parent is not nullptr the job is a child of Parent, which is then not finished until the job is finished; Parent must not be finished yet, i.e., the child must be created
+//   before Parent is run, or by a job that Parent is waiting for (e.g., by Parent's own function). The job is not started until it is passed to the JobRun function.
+Job* JobCreate(const function<void(void)>& Function, Job* Parent)
+{
+	Job* newJob = new Job;
+	newJob->Function = Function;
+	newJob->Parent = Parent;
+	newJob->Unfinished = 1;
+	if (Parent)
+		Parent->Unfinished++;
+	return newJob;
+}
+
+// JobRun function: Definition
+//   This function starts a job, i.e., adds it to the back of the calling thread's queue, and wakes a sleeping worker thread to steal it.
+//   The job may be run by any thread at any time after this, so the data it uses must remain valid until it is finished.
+void JobRun(Job* NewJob)
+{
+	JobSystemStart();
+
+	JobQueue& queue = *JobQueues[JobThreadIndex];
+	{
+		lock_guard<mutex> lock(queue.Mutex);
+		queue.Jobs.push_back(NewJob);
+	}
+	JobsQueued++;
+
+	// Lock and unlock JobSleepMutex before notifying, so a worker thread that has just found JobsQueued to be 0 is waiting on JobSleepWake, and is woken, before the notification.
+	{
+		lock_guard<mutex> lock(JobSleepMutex);
+	}
+	JobSleepWake.notify_one();
+}
+
+// JobWait function: Definition
+//   This function returns when a job without a parent, started by the JobRun function, is finished, and deletes it. While the job is not finished the calling thread runs other jobs (usually the job itself, or its children).
+void JobWait(Job* RootJob)
+{
+	while (RootJob->Unfinished > 0)
+	{
+		Job* job = JobNext();
+		if (job)
+			JobExecute(job);
+		else
+			std::this_thread::yield();						// The remaining work is being run by other threads.
+	}
+	delete RootJob;
+}
+
+// JobParallelFor function: Definition
+//   This function divides the range [0, Count) into consecutive ranges of at least Minimum elements (at most JobRangesPerThread ranges per thread), and runs Function(Begin, End) for each range as a child job of a single job,
+//   which the calling thread then waits for. It may be called by a job, e.g., to divide one stage of a frame's work. A range too small to divide is handled by the calling thread alone.
+void JobParallelFor(int Count, int Minimum, const function<void(int, int)>& Function)
+{
+	int threadsTotal = JobSystemThreadsTotal();
+	int rangesTotal = threadsTotal > 1 ? min(threadsTotal * JobRangesPerThread, Count / (Minimum > 1 ? Minimum : 1)) : 1;
+	if (rangesTotal <= 1)
+	{
+		if (Count > 0)
+			Function(0, Count);
+		return;
+	}
+
+	// The children are created before the parent is run, as the parent has no function of its own.
+	Job* parent = JobCreate(nullptr, nullptr);
+	for (int range = 0; range < rangesTotal; range++)
+	{
+		int begin = (int)((long long)Count * range / rangesTotal);
+		int end = (int)((long long)Count * (range + 1) / rangesTotal);
+		JobRun(JobCreate([&Function, begin, end] { Function(begin, end); }, parent));
+	}
+	JobRun(parent);
+	JobWait(parent);
+}
+
+// JobSystemShutdown function: Definition
+//   This function stops the worker threads and waits for them to return. Every job must be finished. Jobs run after this start the job system again.
+void JobSystemShutdown(void)
+{
+	{
+		lock_guard<mutex> lock(JobSleepMutex);
+		JobSystemStopping = true;
+	}
+	JobSleepWake.notify_all();
+	for (thread& worker : JobWorkers)
+		worker.join();
+	JobWorkers.clear();
+	JobQueues.clear();
+}
@@ -0,0 +1,68 @@
+// jobSystem Header File
+// Version 3.1
+//
+// Description
+// Job system Header File
+// This header file contains the declarations used to run the CPU work of each frame (e.g., animating, culling, and transforming the instances of the object) as jobs on a pool of worker threads that steal jobs from each other,
+// together with a parallel-for function that divides a range of work into jobs.
+// Include it in all source files that run jobs, e.g., the batchTransform and instanceBuilder functions and the objRenderer program.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Function Class.
+#include <functional>										// Function class, used to pass the work of each job.
+
+// Atomic Operations.
+#include <atomic>											// Atomic class, used to count the unfinished work of each job.
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the Job 'named structure' data type.
+// A Job is a function run once by one of the threads of the job system, created by the JobCreate function and started by the JobRun function.
+// A job is finished when its function has returned and every one of its children (the jobs created with it as their Parent) is finished, so waiting for a job waits for all the work it started.
+// A job with a Parent is deleted by the job system when it is finished. A job without a Parent must be waited for, exactly once, by the JobWait function, which deletes it.
+struct Job {
+	std::function<void(void)> Function;						// The work of the job. It may be empty, for a job that only gathers children.
+	Job* Parent;											// The job that is not finished until this job is finished, or nullptr.
+	std::atomic<int> Unfinished;							// 1 until the function has returned, plus 1 for each child that is not finished.
+};
+
+// End: Structure Declarations.
+
+//***
+// External Variable Global Declarations.
+//***
+
+// JobSystemThreads is the number of threads that run jobs, including the thread that starts the job system (the main thread). It is 0 by default, meaning one thread per hardware thread (std::thread::hardware_concurrency).
+// It is read when the job system is started, i.e., when a job is first run.
+extern int JobSystemThreads;
+
+// End: External Variable Global Declarations.
+
+//***
+// Global Function Declarations.
+//***
+
+int JobSystemThreadsTotal(void);																			// The JobSystemThreadsTotal function returns the number of threads that run jobs, including the main thread.
+Job* JobCreate(const std::function<void(void)>& Function, Job* Parent);										// The JobCreate function creates a job that runs Function, as a child of Parent (or nullptr). It does not start the job.
+void JobRun(Job* NewJob);																					// The JobRun function starts a job created by the JobCreate function, i.e., adds it to the calling thread's queue, from which it is run by this thread or stolen by another.
+void JobWait(Job* RootJob);																					// The JobWait function runs other jobs until a job without a Parent is finished, and then deletes it.
+void JobParallelFor(int Count, int Minimum, const std::function<void(int, int)>& Function);				// The JobParallelFor function divides the range [0, Count) into consecutive ranges of at least Minimum elements, runs Function(Begin, End) for each range as a job, and returns when every range is done.
+void JobSystemShutdown(void);																				// The JobSystemShutdown function stops and joins the worker threads. It must be called before the program ends if the job system was started.
+
+// End: Global Function Declarations.
+
+// End: Global Declarations.
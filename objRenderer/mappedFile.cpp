@@ -0,0 +1,130 @@
+// mappedFile
+// Version 3.1
+//
+// Description
+// These functions map an entire file into memory for reading, and unmap it.
+// A memory-mapped file is read by the operating system's virtual memory manager directly into the pages of the calling program's address space, on demand, so no intermediate copy of the file is made.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Read-only memory-mapped file I/O Header File.
+#include "mappedFile.h"
+
+// Operating System Header Files.
+#ifdef _WIN32
+#include <windows.h>										// CreateFile, CreateFileMapping, MapViewOfFile, etc.
+#else
+#include <fcntl.h>											// open.
+#include <sys/mman.h>										// mmap, munmap, madvise.
+#include <sys/stat.h>										// fstat.
+#include <unistd.h>											// close.
+#endif
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// MapFile function: Definition
+int MapFile(const char* FileName, MappedFile& File)
+{
+	File = MappedFile();
+
+#ifdef _WIN32
+	// Open the file for reading. FILE_FLAG_SEQUENTIAL_SCAN tells the operating system that the file will be read from beginning to end, so it reads ahead.
+	HANDLE fileHandle = CreateFileA(FileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		// Cannot open the file.
+		return 1;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize))
+	{
+		CloseHandle(fileHandle);
+		return 1;
+	}
+	File.FileHandle = fileHandle;
+	File.Size = (size_t)fileSize.QuadPart;
+
+	// An empty file cannot be mapped. It is returned as a MappedFile with Data = nullptr and Size = 0.
+	if (File.Size == 0)
+		return 0;
+
+	HANDLE mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mappingHandle == NULL)
+	{
+		UnmapFile(File);
+		return 1;
+	}
+	File.MappingHandle = mappingHandle;
+
+	File.Data = (const char*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if (File.Data == nullptr)
+	{
+		UnmapFile(File);
+		return 1;
+	}
+#else
+	// Open the file for reading.
+	int fileDescriptor = open(FileName, O_RDONLY);
+	if (fileDescriptor < 0)
+	{
+		// Cannot open the file.
+		return 1;
+	}
+
+	struct stat fileStatus;
+	if (fstat(fileDescriptor, &fileStatus) != 0)
+	{
+		close(fileDescriptor);
+		return 1;
+	}
+	File.Size = (size_t)fileStatus.st_size;
+
+	// An empty file cannot be mapped. It is returned as a MappedFile with Data = nullptr and Size = 0.
+	if (File.Size == 0)
+	{
+		close(fileDescriptor);
+		return 0;
+	}
+
+	void* data = mmap(nullptr, File.Size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	close(fileDescriptor);									// The mapping remains valid after the file descriptor is closed.
+	if (data == MAP_FAILED)
+	{
+		File = MappedFile();
+		return 1;
+	}
+	madvise(data, File.Size, MADV_SEQUENTIAL);				// The file will be read from beginning to end, so the operating system should read ahead.
+	File.Data = (const char*)data;
+#endif
+
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
+
+// UnmapFile function: Definition
+void UnmapFile(MappedFile& File)
+{
+#ifdef _WIN32
+	if (File.Data != nullptr)
+		UnmapViewOfFile(File.Data);
+	if (File.MappingHandle != nullptr)
+		CloseHandle((HANDLE)File.MappingHandle);
+	if (File.FileHandle != nullptr)
+		CloseHandle((HANDLE)File.FileHandle);
+#else
+	if (File.Data != nullptr)
+		munmap((void*)File.Data, File.Size);
+#endif
+
+	File = MappedFile();
+}
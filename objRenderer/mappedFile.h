@@ -0,0 +1,51 @@
+// mappedFile Header File
+// Version 3.1
+//
+// Description
+// Read-only memory-mapped file I/O Header File
+// This header file contains the declarations used to map an entire file into memory for reading, so that the file's contents can be parsed in place through a pointer, without copying them into a stream or a string.
+// Include it in all source files that map files into memory, e.g., the objReader function source file.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Standard Definitions.
+#include <cstddef>											// Required for the size_t data type.
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the MappedFile 'named structure' data type.
+// A MappedFile describes one file mapped into memory for reading. Data points to the first byte of the file and Size is the number of bytes in the file.
+// The file's contents are not null-terminated; Data + Size points one byte past the last byte of the file.
+// The remaining members are operating system handles, used only by the UnmapFile function.
+struct MappedFile {
+	const char* Data = nullptr;								// A pointer to the first byte of the file mapped into memory. nullptr if the file is empty.
+	size_t Size = 0;										// The number of bytes in the file.
+	void* FileHandle = nullptr;								// Windows only: the handle returned by CreateFile.
+	void* MappingHandle = nullptr;							// Windows only: the handle returned by CreateFileMapping.
+};
+
+// End: Structure Declarations.
+
+//***
+// Global Function Declarations.
+//***
+
+int MapFile(const char* FileName, MappedFile& File);		// The MapFile function maps the entire file FileName into memory for reading. It returns 0 on success, or 1 if the file cannot be opened or mapped.
+void UnmapFile(MappedFile& File);							// The UnmapFile function unmaps a file mapped by the MapFile function, and resets File to an empty MappedFile.
+
+// End: Global Function Declarations.
+
+// End: Global Declarations.
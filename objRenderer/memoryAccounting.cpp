@@ -0,0 +1,94 @@
+// memoryAccounting
+// Version 3.1
+//
+// Description
+// These functions record the bytes held in each category of memory, and the most bytes each category has held, and write them to a .csv file.
+// The bytes of each category are atomic, so any thread may set or read them.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Memory accounting Header File.
+#include "memoryAccounting.h"
+
+// Process memory usage Header File.
+// Declares the GetProcessMemoryUsage function.
+#include "processMemory.h"
+
+// Atomic Class.
+#include <atomic>											// Atomic class, used to hold the bytes of each category.
+
+// File Stream Functions.
+#include <fstream>											// File stream class member functions, used to write the .csv file.
+
+// Using Declarations and Directives.
+using std::atomic;
+using std::ofstream;
+using std::memory_order_relaxed;
+
+// The bytes held in each category, and the most bytes each has held.
+static atomic<size_t> MemoryBytes[MEMORY_CATEGORIES_TOTAL];
+static atomic<size_t> MemoryPeakBytes[MEMORY_CATEGORIES_TOTAL];
+
+//***
+// External Variable Global Definitions.
+//***
+
+const char* const MemoryCategoryNames[MEMORY_CATEGORIES_TOTAL] = { "CpuMesh", "GpuVertex", "GpuIndex", "Texture", "Shader", "Constant", "Staging" };
+const char* MemoryReportFileName = "objRenderer.memory.csv";
+
+// End: External Variable Global Definitions.
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// SetMemoryBytes function: Definition
+void SetMemoryBytes(MemoryCategory Category, size_t Bytes)
+{
+	MemoryBytes[Category].store(Bytes, memory_order_relaxed);
+	size_t peak = MemoryPeakBytes[Category].load(memory_order_relaxed);
+	while (Bytes > peak && !MemoryPeakBytes[Category].compare_exchange_weak(peak, Bytes, memory_order_relaxed))
+		;													// Another thread raised the peak; compare with its value.
+}
+
+// GetMemoryBytes function: Definition
+size_t GetMemoryBytes(MemoryCategory Category)
+{
+	return MemoryBytes[Category].load(memory_order_relaxed);
+}
+
+// GetMemoryReport function: Definition
+void GetMemoryReport(MemoryReport& Report)
+{
+	Report = MemoryReport();
+	for (int category = 0; category < MEMORY_CATEGORIES_TOTAL; category++)
+	{
+		Report.Bytes[category] = MemoryBytes[category].load(memory_order_relaxed);
+		Report.PeakBytes[category] = MemoryPeakBytes[category].load(memory_order_relaxed);
+		Report.TotalBytes += Report.Bytes[category];
+	}
+	GetProcessMemoryUsage(Report.ResidentBytes, Report.PeakResidentBytes);
+}
+
+// SaveMemoryReportCsv function: Definition
+//   The last lines are the sum of every category, and the resident set size of the process.
+int SaveMemoryReportCsv(const char* FileName, const MemoryReport& Report)
+{
+	ofstream file(FileName, std::ios::out | std::ios::trunc);
+	if (!file)
+		return 1;
+	file << "Category,Bytes,PeakBytes\n";
+	for (int category = 0; category < MEMORY_CATEGORIES_TOTAL; category++)
+		file << MemoryCategoryNames[category] << ',' << Report.Bytes[category] << ',' << Report.PeakBytes[category] << '\n';
+	file << "Total," << Report.TotalBytes << ",\n";
+	file << "Resident," << Report.ResidentBytes << ',' << Report.PeakResidentBytes << '\n';
+	file.close();
+	return file ? 0 : 1;
+}
@@ -0,0 +1,84 @@
+// memoryAccounting Header File
+// Version 3.1
+//
+// Description
+// Memory accounting Header File
+// This header file contains the declarations used to report how many bytes the objRenderer program holds in each category of memory: CPU copies of meshes, GPU vertex buffers and index buffers, textures, shader bytecode, constant buffers, and staging buffers.
+// The calling program sets the bytes of a category whenever they change (SetMemoryBytes function), and the highest value each category has reached is kept with it, so the report shows where memory is held, e.g., which data is held twice, once by the CPU and once by the GPU.
+// The bytes are those requested by the calling program; drivers and allocators may round them up. The resident set size of the process (see processMemory.h) is reported with them.
+// None of these functions use Direct3D. Include it in all source files that report memory by category, e.g., the objRenderer program.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Standard Definitions.
+#include <cstddef>											// Required for the size_t data type.
+
+//***
+// Enumeration Declarations.
+//***
+
+// The categories of memory reported.
+enum MemoryCategory {
+	MEMORY_CPU_MESH,										// Vertex attributes, indices, and meshlets held by the CPU, including meshes waiting to be uploaded and compressed copies (see meshResidency.h).
+	MEMORY_GPU_VERTEX,										// Vertex buffers, including the instance buffer.
+	MEMORY_GPU_INDEX,										// Index buffers.
+	MEMORY_TEXTURE,											// Texture images, every level of their mipmap chains.
+	MEMORY_SHADER,											// Shader bytecode held by the CPU.
+	MEMORY_CONSTANT,										// Constant buffers, including the upload ring.
+	MEMORY_STAGING,											// Staging buffers used to upload meshes.
+	MEMORY_CATEGORIES_TOTAL
+};
+
+// End: Enumeration Declarations.
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the MemoryReport 'named structure' data type.
+// The bytes held in each category, and by the process, when the report was made.
+struct MemoryReport {
+	size_t Bytes[MEMORY_CATEGORIES_TOTAL] = {};				// The bytes held in each category.
+	size_t PeakBytes[MEMORY_CATEGORIES_TOTAL] = {};			// The most bytes held in each category since the program started.
+	size_t TotalBytes = 0;									// The sum of Bytes.
+	size_t ResidentBytes = 0;								// The resident set size (working set size on Windows) of the process, in bytes, or 0 if it cannot be determined.
+	size_t PeakResidentBytes = 0;							// The peak resident set size (peak working set size on Windows) of the process, in bytes.
+};
+
+// End: Structure Declarations.
+
+//***
+// External Variable Global Declarations.
+//***
+
+// The category names written by the SaveMemoryReportCsv function.
+extern const char* const MemoryCategoryNames[MEMORY_CATEGORIES_TOTAL];
+//
+// MemoryReportFileName is the .csv file the objRenderer program writes its memory report to when F2 is pressed, and when the program ends. It is "objRenderer.memory.csv" by default.
+extern const char* MemoryReportFileName;
+
+// End: External Variable Global Declarations.
+
+//***
+// Global Function Declarations.
+//***
+
+void SetMemoryBytes(MemoryCategory Category, size_t Bytes);							// The SetMemoryBytes function records that Bytes bytes are now held in Category.
+size_t GetMemoryBytes(MemoryCategory Category);										// The GetMemoryBytes function returns the bytes held in Category.
+void GetMemoryReport(MemoryReport& Report);											// The GetMemoryReport function sets Report to the bytes held in every category, and by the process.
+int SaveMemoryReportCsv(const char* FileName, const MemoryReport& Report);			// The SaveMemoryReportCsv function writes a header line and one line per category (and one for the process) to a .csv file. It returns 0 on success, or 1 if the file cannot be written.
+
+// End: Global Function Declarations.
+
+// End: Global Declarations.
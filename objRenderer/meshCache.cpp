@@ -0,0 +1,287 @@
+// meshCache
+// Version 3.1
+//
+// Description
+// These functions save the final OurVertices and OurIndices arrays of a Wavefront .obj file, its levels of detail, and its meshlets, to a binary mesh cache file (.objbin file), and load them back by mapping the cache file into memory.
+// Loading a binary mesh cache file does no parsing: the VERTEX structures and DWORD indices are copied by the operating system from the file directly into the calling program's address space, in the exact layout used by the vertex buffer and index buffer.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Binary mesh cache (.objbin file) I/O Header File.
+// Includes the Wavefront .obj file I/O Header File and the read-only memory-mapped file I/O Header File.
+#include "meshCache.h"
+
+// Mesh optimization Header File.
+#include "meshOptimizer.h"
+
+// Vertex welding Header File.
+#include "vertexWelder.h"
+
+// Mesh simplification Header File.
+#include "meshSimplifier.h"
+
+// Standard Encapsulated Data and Functions for Manipulating String Data.
+#include <string>											// String class member functions c_str, etc.
+
+// File Stream Functions.
+#include <fstream>											// File stream class member functions write, close, etc.
+
+// File System Functions.
+#include <filesystem>										// File system functions file_size, last_write_time, rename, remove.
+
+// Memory Functions.
+#include <cstring>											// Memory functions memcpy, memcmp, memset.
+
+// Limits of Integral Types.
+#include <climits>											// INT_MAX.
+
+// Using Declarations and Directives.
+using std::string;
+using std::ofstream;
+using std::ios;
+using std::error_code;
+using std::memcmp;
+using std::memcpy;
+using std::memset;
+namespace fs = std::filesystem;
+
+//***
+// External Variable Global Definitions.
+//***
+
+bool MeshCacheEnabled = true;
+
+// End: External Variable Global Definitions.
+
+// The first eight bytes of every binary mesh cache file.
+static const char MeshCacheMagic[8] = { 'O', 'B', 'J', 'B', 'I', 'N', '\0', '\0' };
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// MeshCacheFileName function: Definition
+//   This function returns the name of the binary mesh cache file of a source Wavefront .obj file, i.e., the source file name followed by "bin" (Text.obj -> Text.objbin).
+static string MeshCacheFileName(const char* SourceFileName)
+{
+	return string(SourceFileName) + "bin";
+}
+
+// MeshCacheOptions function: Definition
+//   This function returns the objReader and mesh optimization options that affect the contents of OurVertices and OurIndices, one bit per option.
+//   A binary mesh cache file saved with different options is out of date.
+//   When vertex welding is enabled, the upper 16 bits hold a hash of its tolerances, so a binary mesh cache file welded with different tolerances is also out of date.
+static unsigned int MeshCacheOptions(void)
+{
+	unsigned int options = 0;
+	if (objReaderDedupByAttributes)
+		options |= 1u << 0;
+	if (MeshOptimizerVertexCacheEnabled)
+		options |= 1u << 1;
+	if (MeshOptimizerVertexFetchEnabled)
+		options |= 1u << 2;
+	if (MeshSimplifierLodEnabled)
+		options |= 1u << 3;
+	if (VertexWelderEnabled)
+	{
+		options |= 1u << 4;
+		const float tolerances[3] = { VertexWelderTolerances.PositionTolerance, VertexWelderTolerances.NormalAngleDegrees, VertexWelderTolerances.TextureCoordinateTolerance };
+		unsigned int h = 2166136261u;
+		for (int i = 0; i <= 2; i++)
+		{
+			unsigned int bits;
+			memcpy(&bits, &tolerances[i], sizeof(bits));
+			h = (h ^ bits) * 16777619u;
+		}
+		options |= (h ^ (h >> 16)) << 16;
+	}
+	return options;
+}
+
+// MeshCacheSourceStamp function: Definition
+//   This function returns the size and last write time of the source Wavefront .obj file, which identify the version of the source file a binary mesh cache file was saved from.
+//   It returns 0 on success, or 1 if the source file does not exist.
+static int MeshCacheSourceStamp(const char* SourceFileName, unsigned long long& SourceSize, long long& SourceWriteTime)
+{
+	error_code error;
+	SourceSize = (unsigned long long)fs::file_size(SourceFileName, error);
+	if (error)
+		return 1;
+	SourceWriteTime = (long long)fs::last_write_time(SourceFileName, error).time_since_epoch().count();
+	if (error)
+		return 1;
+	return 0;
+}
+
+// MeshCacheIndicesValid function: Definition
+//   This function returns true if every one of the IndicesTotal indices of Indices refers to one of VerticesTotal VERTEX structures, i.e., is less than VerticesTotal.
+//   The largest index is found first and compared once, so the loop has no branch and the compiler can vectorize it.
+static bool MeshCacheIndicesValid(const DWORD* Indices, unsigned long long IndicesTotal, unsigned int VerticesTotal)
+{
+	DWORD largest = 0;
+	for (unsigned long long i = 0; i < IndicesTotal; i++)
+		largest = Indices[i] > largest ? Indices[i] : largest;
+	return IndicesTotal == 0 || largest < VerticesTotal;
+}
+
+// MeshCacheLoad function: Definition
+//   This function maps the binary mesh cache file of SourceFileName into memory and checks that it is valid:
+//   - The header's magic, version, VERTEX size, and objReader options match this program.
+//   - The header's source size and source last write time match the source Wavefront .obj file, i.e., the source file has not changed since the cache file was saved.
+//   - The file's size matches the header's VertexAttributeSetsTotal, PrimitivesTotal, LodsTotal, LodIndicesTotal, and MeshletsTotal, every level of detail and meshlet lies within the index buffer, and the meshlets of every level of detail lie within Meshlets.
+//   - Every index, of level of detail 0 and of the other levels of detail, is less than VertexAttributeSetsTotal, so a damaged cache file cannot make the GPU, or a function reading the mesh on the CPU, read past the vertices.
+//   It returns 0 if the cache file is valid, in which case View.Vertices, View.Indices, View.Lods, View.LodIndices, and View.Meshlets point into the mapped cache file, or 1 otherwise, in which case View is empty.
+int MeshCacheLoad(const char* SourceFileName, MeshCacheView& View)
+{
+	View = MeshCacheView();
+
+	unsigned long long sourceSize;
+	long long sourceWriteTime;
+	if (MeshCacheSourceStamp(SourceFileName, sourceSize, sourceWriteTime) == 1)
+		return 1;
+
+	if (MapFile(MeshCacheFileName(SourceFileName).c_str(), View.File) == 1)
+		return 1;											// There is no binary mesh cache file.
+
+	// Check the header.
+	MeshCacheHeader header;
+	if (View.File.Size < sizeof(MeshCacheHeader))
+	{
+		MeshCacheUnload(View);
+		return 1;
+	}
+	memcpy(&header, View.File.Data, sizeof(MeshCacheHeader));
+	unsigned long long expectedSize = sizeof(MeshCacheHeader) + (unsigned long long)header.VertexAttributeSetsTotal * sizeof(VERTEX) + (unsigned long long)header.PrimitivesTotal * 3 * sizeof(DWORD) +
+		(unsigned long long)header.LodsTotal * sizeof(MeshLod) + (unsigned long long)header.LodIndicesTotal * sizeof(DWORD) + (unsigned long long)header.MeshletsTotal * sizeof(Meshlet);
+	if (memcmp(header.Magic, MeshCacheMagic, sizeof(MeshCacheMagic)) != 0 ||
+		header.Version != MESH_CACHE_VERSION ||
+		header.VertexSize != sizeof(VERTEX) ||
+		header.Options != MeshCacheOptions() ||
+		header.SourceSize != sourceSize ||
+		header.SourceWriteTime != sourceWriteTime ||
+		header.LodsTotal == 0 ||
+		header.VertexAttributeSetsTotal > INT_MAX || header.PrimitivesTotal > INT_MAX / 3 || header.LodsTotal > INT_MAX || header.LodIndicesTotal > INT_MAX || header.MeshletsTotal > INT_MAX ||	// Each count is stored in an int of the MeshCacheView.
+		View.File.Size != expectedSize)
+	{
+		// The binary mesh cache file is out of date or damaged.
+		MeshCacheUnload(View);
+		return 1;
+	}
+
+	// The VERTEX structures follow the header, the DWORD indices follow the VERTEX structures, the MeshLod structures follow the DWORD indices, the DWORD indices of the levels of detail follow the MeshLod structures,
+	// and the Meshlet structures follow the DWORD indices of the levels of detail.
+	View.Vertices = (const VERTEX*)(View.File.Data + sizeof(MeshCacheHeader));
+	View.Indices = (const DWORD*)(View.Vertices + header.VertexAttributeSetsTotal);
+	View.Lods = (const MeshLod*)(View.Indices + (size_t)header.PrimitivesTotal * 3);
+	View.LodIndices = (const DWORD*)(View.Lods + header.LodsTotal);
+	View.Meshlets = (const Meshlet*)(View.LodIndices + header.LodIndicesTotal);
+	View.VertexAttributeSetsTotal = (int)header.VertexAttributeSetsTotal;
+	View.PrimitivesTotal = (int)header.PrimitivesTotal;
+	View.LodsTotal = (int)header.LodsTotal;
+	View.LodIndicesTotal = (int)header.LodIndicesTotal;
+	View.MeshletsTotal = (int)header.MeshletsTotal;
+
+	// Check that every index refers to a VERTEX structure. The indices of level of detail 0 and those of the other levels of detail are separated by the MeshLod structures, so they are checked separately.
+	if (!MeshCacheIndicesValid(View.Indices, (unsigned long long)header.PrimitivesTotal * 3, header.VertexAttributeSetsTotal) ||
+		!MeshCacheIndicesValid(View.LodIndices, header.LodIndicesTotal, header.VertexAttributeSetsTotal))
+	{
+		// The binary mesh cache file is damaged. The calling program parses the Wavefront .obj file instead.
+		MeshCacheUnload(View);
+		return 1;
+	}
+
+	// Check that every level of detail, and every meshlet, lies within the index buffer, i.e., the indices followed by the indices of the levels of detail, and that the meshlets of every level of detail lie within the Meshlet structures.
+	unsigned long long indicesTotal = (unsigned long long)header.PrimitivesTotal * 3 + header.LodIndicesTotal;
+	for (int l = 0; l < View.LodsTotal; l++)
+	{
+		MeshLod lod;
+		memcpy(&lod, &View.Lods[l], sizeof(MeshLod));
+		if (lod.FirstIndex < 0 || lod.PrimitivesTotal < 0 ||
+			(unsigned long long)lod.FirstIndex + (unsigned long long)lod.PrimitivesTotal * 3 > indicesTotal ||
+			lod.FirstMeshlet < 0 || lod.MeshletsTotal < 0 ||
+			(unsigned long long)lod.FirstMeshlet + (unsigned long long)lod.MeshletsTotal > header.MeshletsTotal)
+		{
+			MeshCacheUnload(View);
+			return 1;
+		}
+	}
+	for (int m = 0; m < View.MeshletsTotal; m++)
+	{
+		Meshlet meshlet;
+		memcpy(&meshlet, &View.Meshlets[m], sizeof(Meshlet));
+		if (meshlet.FirstIndex < 0 || meshlet.PrimitivesTotal < 0 ||
+			(unsigned long long)meshlet.FirstIndex + (unsigned long long)meshlet.PrimitivesTotal * 3 > indicesTotal)
+		{
+			MeshCacheUnload(View);
+			return 1;
+		}
+	}
+
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
+
+// MeshCacheUnload function: Definition
+void MeshCacheUnload(MeshCacheView& View)
+{
+	UnmapFile(View.File);
+	View = MeshCacheView();
+}
+
+// MeshCacheSave function: Definition
+//   This function saves a binary mesh cache file for SourceFileName, including the levels of detail Lods (at least level of detail 0), the indices LodIndices of the levels of detail that follow level of detail 0, and the meshlets of every level of detail.
+//   The file is first written under a temporary name and then renamed, so a program loading the cache file at the same time never sees a partially written file.
+//   It returns 0 on success, or 1 if the file cannot be written.
+int MeshCacheSave(const char* SourceFileName, const VERTEX* Vertices, int VertexAttributeSetsTotal, const DWORD* Indices, int PrimitivesTotal, const MeshLod* Lods, int LodsTotal, const DWORD* LodIndices, int LodIndicesTotal, const Meshlet* Meshlets, int MeshletsTotal)
+{
+	MeshCacheHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.Magic, MeshCacheMagic, sizeof(MeshCacheMagic));
+	header.Version = MESH_CACHE_VERSION;
+	header.VertexSize = sizeof(VERTEX);
+	header.Options = MeshCacheOptions();
+	header.VertexAttributeSetsTotal = (unsigned int)VertexAttributeSetsTotal;
+	header.PrimitivesTotal = (unsigned int)PrimitivesTotal;
+	header.LodsTotal = (unsigned int)LodsTotal;
+	header.LodIndicesTotal = (unsigned int)LodIndicesTotal;
+	header.MeshletsTotal = (unsigned int)MeshletsTotal;
+	if (MeshCacheSourceStamp(SourceFileName, header.SourceSize, header.SourceWriteTime) == 1)
+		return 1;
+
+	string cacheFileName = MeshCacheFileName(SourceFileName);
+	string temporaryFileName = cacheFileName + ".tmp";
+
+	ofstream cache(temporaryFileName, ios::out | ios::binary | ios::trunc);
+	if (!cache)
+		return 1;
+	cache.write((const char*)&header, sizeof(header));
+	cache.write((const char*)Vertices, (std::streamsize)VertexAttributeSetsTotal * sizeof(VERTEX));
+	cache.write((const char*)Indices, (std::streamsize)PrimitivesTotal * 3 * sizeof(DWORD));
+	cache.write((const char*)Lods, (std::streamsize)LodsTotal * sizeof(MeshLod));
+	cache.write((const char*)LodIndices, (std::streamsize)LodIndicesTotal * sizeof(DWORD));
+	cache.write((const char*)Meshlets, (std::streamsize)MeshletsTotal * sizeof(Meshlet));
+	cache.close();
+
+	error_code error;
+	if (!cache)
+	{
+		fs::remove(temporaryFileName, error);
+		return 1;
+	}
+	fs::rename(temporaryFileName, cacheFileName, error);
+	if (error)
+	{
+		fs::remove(temporaryFileName, error);
+		return 1;
+	}
+
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
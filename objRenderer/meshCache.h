@@ -0,0 +1,107 @@
+// meshCache Header File
+// Version 3.1
+//
+// Description
+// Binary mesh cache (.objbin file) I/O Header File
+// This header file contains the declarations used to save the final OurVertices and OurIndices arrays of a Wavefront .obj file, its levels of detail, and its meshlets, to a binary cache file, and to load them back without parsing the Wavefront .obj file.
+// Include it in all source files that load or save a binary mesh cache, e.g., the objRenderer program.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Wavefront .obj file I/O Header File.
+// Declares the VERTEX structure and the DWORD data type.
+#include "objReader.h"
+
+// Read-only memory-mapped file I/O Header File.
+#include "mappedFile.h"
+
+// Mesh simplification Header File.
+// Declares the MeshLod structure.
+#include "meshSimplifier.h"
+
+// Meshlet (cluster) Header File.
+// Declares the Meshlet structure.
+#include "meshletBuilder.h"
+
+// Defines.
+// The version of the binary mesh cache file format. Increment it whenever the file format, the VERTEX structure, or the way objReader builds OurVertices and OurIndices changes, so that existing cache files are rebuilt.
+#define MESH_CACHE_VERSION 3
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the MeshCacheHeader 'named structure' data type.
+// A binary mesh cache file is named after its source Wavefront .obj file, followed by "bin" (e.g., Text.objbin for Text.obj), and is comprised of:
+//   1. A MeshCacheHeader.
+//   2. VertexAttributeSetsTotal VERTEX structures, i.e., the contents of OurVertices.
+//   3. PrimitivesTotal * 3 DWORD indices, i.e., the contents of OurIndices.
+//   4. LodsTotal MeshLod structures, i.e., the contents of MeshLods.
+//   5. LodIndicesTotal DWORD indices, i.e., the contents of MeshLodIndices.
+//   6. MeshletsTotal Meshlet structures, i.e., the contents of Meshlets.
+// The header's size is a multiple of 8 bytes, so the VERTEX structures and DWORD indices that follow it are aligned when the file is mapped into memory.
+// The cache file is valid only while the source Wavefront .obj file has the same size and last write time as when the cache file was saved.
+struct MeshCacheHeader {
+	char Magic[8];											// "OBJBIN" followed by two null characters.
+	unsigned int Version;									// MESH_CACHE_VERSION.
+	unsigned int VertexSize;								// sizeof(VERTEX).
+	unsigned long long SourceSize;							// The size, in bytes, of the source Wavefront .obj file.
+	long long SourceWriteTime;								// The last write time of the source Wavefront .obj file, as a count of file clock ticks.
+	unsigned int Options;									// The objReader and mesh optimization options that affect OurVertices and OurIndices (see the MeshCacheOptions function).
+	unsigned int VertexAttributeSetsTotal;					// The total number of VERTEX structures.
+	unsigned int PrimitivesTotal;							// The total number of triangle primitives. There are PrimitivesTotal * 3 DWORD indices.
+	unsigned int LodsTotal;									// The total number of MeshLod structures. At least 1 (level of detail 0).
+	unsigned int LodIndicesTotal;							// The total number of DWORD indices of the levels of detail that follow level of detail 0.
+	unsigned int MeshletsTotal;								// The total number of Meshlet structures.
+};
+
+// Declare the MeshCacheView 'named structure' data type.
+// A MeshCacheView describes a binary mesh cache file loaded by the MeshCacheLoad function.
+// Vertices and Indices point directly into the memory-mapped cache file, and remain valid until the MeshCacheUnload function is called.
+struct MeshCacheView {
+	MappedFile File;										// The memory-mapped binary mesh cache file.
+	const VERTEX* Vertices = nullptr;						// The cached contents of OurVertices.
+	const DWORD* Indices = nullptr;							// The cached contents of OurIndices.
+	int VertexAttributeSetsTotal = 0;						// The total number of VERTEX structures in Vertices.
+	int PrimitivesTotal = 0;								// The total number of triangle primitives. There are PrimitivesTotal * 3 indices in Indices.
+	const MeshLod* Lods = nullptr;							// The cached contents of MeshLods.
+	int LodsTotal = 0;										// The total number of MeshLod structures in Lods.
+	const DWORD* LodIndices = nullptr;						// The cached contents of MeshLodIndices.
+	int LodIndicesTotal = 0;								// The total number of indices in LodIndices.
+	const Meshlet* Meshlets = nullptr;						// The cached contents of Meshlets.
+	int MeshletsTotal = 0;									// The total number of Meshlet structures in Meshlets.
+};
+
+// End: Structure Declarations.
+
+//***
+// External Variable Global Declarations.
+//***
+
+// MeshCacheEnabled selects whether the objRenderer program loads and saves binary mesh cache files. It is true by default.
+extern bool MeshCacheEnabled;
+
+// End: External Variable Global Declarations.
+
+//***
+// Global Function Declarations.
+//***
+
+int MeshCacheLoad(const char* SourceFileName, MeshCacheView& View);								// The MeshCacheLoad function maps the binary mesh cache file of SourceFileName into memory. It returns 0 if the cache file is valid, or 1 if it is missing, out of date, or damaged.
+void MeshCacheUnload(MeshCacheView& View);															// The MeshCacheUnload function unmaps a binary mesh cache file loaded by the MeshCacheLoad function.
+int MeshCacheSave(const char* SourceFileName, const VERTEX* Vertices, int VertexAttributeSetsTotal, const DWORD* Indices, int PrimitivesTotal, const MeshLod* Lods, int LodsTotal, const DWORD* LodIndices, int LodIndicesTotal, const Meshlet* Meshlets, int MeshletsTotal);	// The MeshCacheSave function saves a binary mesh cache file for SourceFileName. It returns 0 on success, or 1 if the file cannot be written.
+
+// End: Global Function Declarations.
+
+// End: Global Declarations.
@@ -0,0 +1,338 @@
+// meshOptimizer
+// Version 3.1
+//
+// Description
+// These functions reorder the triangles of an index array so that the GPU's post-transform vertex cache is used more effectively, and measure how effectively it is used.
+//
+// The GPU runs the vertex shader for each index of the index buffer, unless the vertex referenced by the index was transformed recently and its result is still in the post-transform vertex cache.
+// When triangles are drawn in the order the face element statements appear in the Wavefront .obj file, neighboring triangles are often far apart in the index buffer, so the same vertex is transformed several times.
+// Reordering the triangles so that neighboring triangles are drawn one after another reduces the number of vertices transformed, without changing the image, except where overlapping triangles are drawn without depth testing.
+//
+// The GPU reads each vertex it transforms from the vertex buffer in memory, one cache line at a time. When OurVertices is in the order the sets of vertex attributes were first found in the Wavefront .obj file, rather than the order the index buffer references them,
+// consecutive vertices fetched are often in different cache lines. Reordering OurVertices into the order the index buffer first references them means that a cache line read for one vertex usually also holds the next vertices fetched.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Mesh optimization Header File.
+#include "meshOptimizer.h"
+
+// Vector Container Class.
+#include <vector>											// Vector class member functions push_back, data, etc.
+
+// Mathematical Functions.
+#include <cmath>											// Mathematical function pow.
+
+// Using Declarations and Directives.
+using std::vector;
+using std::pow;
+
+//***
+// External Variable Global Definitions.
+//***
+
+bool MeshOptimizerVertexCacheEnabled = true;
+VertexCacheStatistics VertexCacheBefore;
+VertexCacheStatistics VertexCacheAfter;
+bool MeshOptimizerVertexFetchEnabled = true;
+VertexFetchStatistics VertexFetchBefore;
+VertexFetchStatistics VertexFetchAfter;
+
+// End: External Variable Global Definitions.
+
+// Scoring constants of the OptimizeVertexCache function (see the VertexCacheScore function).
+static const float VertexCacheDecayPower = 1.5f;			// How quickly the score of a vertex decreases as it moves toward the end of the cache.
+static const float VertexCacheLastTriangleScore = 0.75f;	// The score of the three vertices of the triangle drawn last. It is less than that of the next few vertices in the cache, so that the next triangle is not drawn in the same strip direction, which tends to leave behind vertices that then fall out of the cache.
+static const float VertexValenceBoostScale = 2.0f;			// How strongly vertices referenced by few remaining triangles are preferred, so that they are finished off instead of being left behind.
+static const float VertexValenceBoostPower = 0.5f;
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// AnalyzeVertexCache function: Definition
+//   This function simulates drawing the triangles of Indices in order through a first-in, first-out post-transform vertex cache of CacheSize vertices, and returns the number of vertices transformed in Statistics.
+//   A vertex is in the cache if it was one of the last CacheSize vertices transformed. Each vertex records when it was last transformed (CacheTime), so no cache needs to be stored.
+void AnalyzeVertexCache(const DWORD* Indices, int PrimitivesTotal, int VertexAttributeSetsTotal, int CacheSize, VertexCacheStatistics& Statistics)
+{
+	Statistics = VertexCacheStatistics();
+	if (PrimitivesTotal <= 0 || VertexAttributeSetsTotal <= 0)
+		return;
+
+	vector<long long> CacheTime(VertexAttributeSetsTotal, 0);	// The value of Time when each vertex was last transformed, or 0 if it has not been transformed.
+	long long Time = (long long)CacheSize + 1;				// Incremented each time a vertex is transformed. It starts above CacheSize so that a vertex with CacheTime 0 is not in the cache.
+	int VerticesReferenced = 0;
+
+	for (long long i = 0; i < (long long)PrimitivesTotal * 3; i++)
+	{
+		DWORD vertex = Indices[i];
+		if (Time - CacheTime[vertex] <= CacheSize)
+			continue;										// The vertex is in the cache.
+		if (CacheTime[vertex] == 0)
+			VerticesReferenced++;
+		CacheTime[vertex] = Time++;
+		Statistics.VerticesTransformed++;
+	}
+
+	Statistics.ACMR = (double)Statistics.VerticesTransformed / PrimitivesTotal;
+	Statistics.ATVR = (double)Statistics.VerticesTransformed / VerticesReferenced;
+}
+
+// Declare the VertexCacheScoreTable 'named structure' data type.
+// The two parts of the score of a vertex (see the VertexCacheScore function), computed once for each cache position and for small numbers of remaining triangles, because pow is slow.
+static const int VertexValenceTableSize = 32;
+struct VertexCacheScoreTable {
+	float Position[VERTEX_CACHE_OPTIMIZE_SIZE];				// The score of a vertex at each position in the cache.
+	float Valence[VertexValenceTableSize];					// The score of a vertex referenced by each number of remaining triangles.
+
+	VertexCacheScoreTable()
+	{
+		for (int i = 0; i < VERTEX_CACHE_OPTIMIZE_SIZE; i++)
+		{
+			if (i < 3)
+				Position[i] = VertexCacheLastTriangleScore;	// The vertex is one of the three vertices of the triangle drawn last.
+			else
+				Position[i] = pow(1.0f - (float)(i - 3) / (VERTEX_CACHE_OPTIMIZE_SIZE - 3), VertexCacheDecayPower);
+		}
+		Valence[0] = 0.0f;
+		for (int i = 1; i < VertexValenceTableSize; i++)
+			Valence[i] = VertexValenceBoostScale * pow((float)i, -VertexValenceBoostPower);
+	}
+};
+
+// VertexCacheScore function: Definition
+//   This function returns the score of a vertex, i.e., how much drawing a triangle that references this vertex next is preferred, from the vertex's position in the least recently used cache (-1 if not in the cache), and the number of triangles referencing it that have not been drawn yet.
+//   The score of a triangle is the sum of the scores of its three vertices.
+static float VertexCacheScore(int CachePosition, int TrianglesRemaining)
+{
+	static const VertexCacheScoreTable table;
+
+	// A vertex referenced by no remaining triangle does not matter.
+	if (TrianglesRemaining == 0)
+		return -1.0f;
+
+	float score = CachePosition >= 0 ? table.Position[CachePosition] : 0.0f;
+	if (TrianglesRemaining < VertexValenceTableSize)
+		score += table.Valence[TrianglesRemaining];
+	else
+		score += VertexValenceBoostScale * pow((float)TrianglesRemaining, -VertexValenceBoostPower);
+	return score;
+}
+
+// OptimizeVertexCache function: Definition
+//   This function reorders the triangles of Indices, greedily drawing next the remaining triangle with the highest score (Tom Forsyth, "Linear-Speed Vertex Cache Optimisation").
+//   Only triangles that reference a vertex in the cache are scored after each triangle is drawn, so the time taken is proportional to the number of triangles.
+//   When no remaining triangle references a vertex in the cache, the next remaining triangle in the original order is drawn.
+//   The three indices of each triangle are not reordered, so the winding order (clockwise, for DirectX) of each triangle is unchanged.
+void OptimizeVertexCache(DWORD* Indices, int PrimitivesTotal, int VertexAttributeSetsTotal)
+{
+	if (PrimitivesTotal <= 0 || VertexAttributeSetsTotal <= 0)
+		return;
+
+	// For each vertex, the triangles that reference it and have not been drawn yet:
+	// The triangles of vertex v are Adjacency[AdjacencyOffset[v]] to Adjacency[AdjacencyOffset[v] + TrianglesRemaining[v] - 1]. A triangle is removed by moving the last triangle of the vertex into its place.
+	vector<int> TrianglesRemaining(VertexAttributeSetsTotal, 0);
+	for (long long i = 0; i < (long long)PrimitivesTotal * 3; i++)
+		TrianglesRemaining[Indices[i]]++;
+	vector<int> AdjacencyOffset(VertexAttributeSetsTotal + 1, 0);
+	for (int v = 0; v < VertexAttributeSetsTotal; v++)
+		AdjacencyOffset[v + 1] = AdjacencyOffset[v] + TrianglesRemaining[v];
+	vector<int> Adjacency((size_t)PrimitivesTotal * 3);
+	{
+		vector<int> AdjacencyCursor(AdjacencyOffset.begin(), AdjacencyOffset.end() - 1);
+		for (int t = 0; t < PrimitivesTotal; t++)
+			for (int k = 0; k <= 2; k++)
+				Adjacency[AdjacencyCursor[Indices[t * 3 + k]]++] = t;
+	}
+
+	// The score of each vertex. The score of a triangle is computed when it is needed.
+	vector<int> CachePosition(VertexAttributeSetsTotal, -1);
+	vector<float> VertexScore(VertexAttributeSetsTotal);
+	for (int v = 0; v < VertexAttributeSetsTotal; v++)
+		VertexScore[v] = VertexCacheScore(-1, TrianglesRemaining[v]);
+
+	// The least recently used cache, most recently used vertex first. Three extra entries hold the vertices pushed out of the cache by the triangle just drawn.
+	int Cache[VERTEX_CACHE_OPTIMIZE_SIZE + 3];
+	int CacheTotal = 0;
+	int NewCache[VERTEX_CACHE_OPTIMIZE_SIZE + 3];
+
+	vector<char> Drawn(PrimitivesTotal, 0);
+	vector<DWORD> Output;
+	Output.reserve((size_t)PrimitivesTotal * 3);
+	int NextInOrder = 0;									// No triangle before this one remains to be drawn.
+
+	int best = 0;											// The triangle drawn next. The first triangle is drawn first, as in the original order.
+	for (int drawnTotal = 0; drawnTotal < PrimitivesTotal; drawnTotal++)
+	{
+		if (best < 0)
+		{
+			// No remaining triangle references a vertex in the cache. Draw the next remaining triangle in the original order.
+			while (Drawn[NextInOrder])
+				NextInOrder++;
+			best = NextInOrder;
+		}
+
+		// Draw triangle best, and remove it from the triangles of its vertices.
+		Drawn[best] = 1;
+		const DWORD* triangle = &Indices[best * 3];
+		Output.insert(Output.end(), triangle, triangle + 3);
+		for (int k = 0; k <= 2; k++)
+		{
+			int v = (int)triangle[k];
+			int* triangles = &Adjacency[AdjacencyOffset[v]];
+			int last = TrianglesRemaining[v] - 1;
+			for (int j = 0; j <= last; j++)
+			{
+				if (triangles[j] == best)
+				{
+					triangles[j] = triangles[last];
+					break;
+				}
+			}
+			TrianglesRemaining[v]--;
+		}
+
+		// Move the vertices of triangle best to the front of the cache.
+		int NewCacheTotal = 0;
+		for (int k = 0; k <= 2; k++)
+		{
+			int v = (int)triangle[k];
+			if (NewCacheTotal > 0 && NewCache[0] == v) continue;
+			if (NewCacheTotal > 1 && NewCache[1] == v) continue;
+			NewCache[NewCacheTotal++] = v;
+		}
+		for (int i = 0; i < CacheTotal; i++)
+		{
+			int v = Cache[i];
+			if (v != (int)triangle[0] && v != (int)triangle[1] && v != (int)triangle[2])
+				NewCache[NewCacheTotal++] = v;
+		}
+
+		// Update the scores of the vertices in the cache, and of the vertices pushed out of it.
+		for (int i = 0; i < NewCacheTotal; i++)
+		{
+			int v = NewCache[i];
+			CachePosition[v] = i < VERTEX_CACHE_OPTIMIZE_SIZE ? i : -1;
+			VertexScore[v] = VertexCacheScore(CachePosition[v], TrianglesRemaining[v]);
+		}
+		CacheTotal = NewCacheTotal < VERTEX_CACHE_OPTIMIZE_SIZE ? NewCacheTotal : VERTEX_CACHE_OPTIMIZE_SIZE;
+		for (int i = 0; i < CacheTotal; i++)
+			Cache[i] = NewCache[i];
+
+		// Score the remaining triangles of these vertices, and find the remaining triangle with the highest score.
+		best = -1;
+		float bestScore = -1.0f;
+		for (int i = 0; i < NewCacheTotal; i++)
+		{
+			int v = NewCache[i];
+			const int* triangles = &Adjacency[AdjacencyOffset[v]];
+			for (int j = 0; j < TrianglesRemaining[v]; j++)
+			{
+				int t = triangles[j];
+				float score = VertexScore[Indices[t * 3]] + VertexScore[Indices[t * 3 + 1]] + VertexScore[Indices[t * 3 + 2]];
+				if (score > bestScore)
+				{
+					bestScore = score;
+					best = t;
+				}
+			}
+		}
+	}
+
+	// Replace the indices with the reordered indices.
+	for (size_t i = 0; i < Output.size(); i++)
+		Indices[i] = Output[i];
+}
+
+// AnalyzeVertexFetch function: Definition
+//   This function simulates drawing the triangles of Indices in order, and returns the number of bytes read from memory to fetch the vertices transformed, each of VertexSize bytes, in Statistics.
+//   A vertex is transformed, and therefore fetched, when it is not in a first-in, first-out post-transform vertex cache of VERTEX_CACHE_ANALYZE_SIZE vertices (see the AnalyzeVertexCache function).
+//   Fetching a vertex reads each cache line it overlaps that is not among the VERTEX_FETCH_CACHE_LINES cache lines most recently read.
+void AnalyzeVertexFetch(const DWORD* Indices, int PrimitivesTotal, int VertexAttributeSetsTotal, int VertexSize, VertexFetchStatistics& Statistics)
+{
+	Statistics = VertexFetchStatistics();
+	if (PrimitivesTotal <= 0 || VertexAttributeSetsTotal <= 0)
+		return;
+
+	vector<long long> CacheTime(VertexAttributeSetsTotal, 0);	// The post-transform vertex cache (see the AnalyzeVertexCache function).
+	long long Time = (long long)VERTEX_CACHE_ANALYZE_SIZE + 1;
+	vector<char> Referenced(VertexAttributeSetsTotal, 0);
+	long long VerticesReferenced = 0;
+
+	// The memory cache, most recently used cache line first. Each entry is the address of a cache line divided by VERTEX_FETCH_CACHE_LINE_BYTES.
+	long long Lines[VERTEX_FETCH_CACHE_LINES];
+	int LinesTotal = 0;
+
+	for (long long i = 0; i < (long long)PrimitivesTotal * 3; i++)
+	{
+		DWORD vertex = Indices[i];
+		if (!Referenced[vertex])
+		{
+			Referenced[vertex] = 1;
+			VerticesReferenced++;
+		}
+		if (Time - CacheTime[vertex] <= VERTEX_CACHE_ANALYZE_SIZE)
+			continue;										// The vertex is in the post-transform vertex cache, so it is not fetched.
+		CacheTime[vertex] = Time++;
+
+		// Fetch each cache line the vertex overlaps.
+		long long first = (long long)vertex * VertexSize / VERTEX_FETCH_CACHE_LINE_BYTES;
+		long long last = ((long long)vertex * VertexSize + VertexSize - 1) / VERTEX_FETCH_CACHE_LINE_BYTES;
+		for (long long line = first; line <= last; line++)
+		{
+			int found = 0;
+			while (found < LinesTotal && Lines[found] != line)
+				found++;
+			if (found == LinesTotal)
+			{
+				// The cache line is not in the memory cache: read it, pushing out the least recently used cache line if the memory cache is full.
+				Statistics.BytesFetched += VERTEX_FETCH_CACHE_LINE_BYTES;
+				if (LinesTotal < VERTEX_FETCH_CACHE_LINES)
+					LinesTotal++;
+				found = LinesTotal - 1;
+			}
+			// Move the cache line to the front of the memory cache.
+			for (int j = found; j > 0; j--)
+				Lines[j] = Lines[j - 1];
+			Lines[0] = line;
+		}
+	}
+
+	Statistics.Overfetch = (double)Statistics.BytesFetched / ((double)VerticesReferenced * VertexSize);
+}
+
+// OptimizeVertexFetch function: Definition
+//   This function reorders Vertices into the order in which Indices first references them, and replaces each index with the new position of the vertex it references.
+//   Vertices not referenced by Indices are moved after all referenced vertices, in their original order, so the number of vertices is unchanged.
+void OptimizeVertexFetch(VERTEX* Vertices, DWORD* Indices, int PrimitivesTotal, int VertexAttributeSetsTotal)
+{
+	if (PrimitivesTotal <= 0 || VertexAttributeSetsTotal <= 0)
+		return;
+
+	// Remap[v] is the new position of the vertex at position v, or -1 until it is known.
+	vector<int> Remap(VertexAttributeSetsTotal, -1);
+	int next = 0;
+	for (long long i = 0; i < (long long)PrimitivesTotal * 3; i++)
+	{
+		DWORD vertex = Indices[i];
+		if (Remap[vertex] < 0)
+			Remap[vertex] = next++;
+		Indices[i] = (DWORD)Remap[vertex];
+	}
+	for (int v = 0; v < VertexAttributeSetsTotal; v++)
+		if (Remap[v] < 0)
+			Remap[v] = next++;
+
+	// Move each vertex to its new position.
+	vector<VERTEX> Reordered(VertexAttributeSetsTotal);
+	for (int v = 0; v < VertexAttributeSetsTotal; v++)
+		Reordered[Remap[v]] = Vertices[v];
+	for (int v = 0; v < VertexAttributeSetsTotal; v++)
+		Vertices[v] = Reordered[v];
+}
@@ -0,0 +1,92 @@
+// meshOptimizer Header File
+// Version 3.1
+//
+// Description
+// Mesh optimization Header File
+// This header file contains the declarations used to reorder the triangles of OurIndices so that the GPU's post-transform vertex cache is used more effectively, to reorder OurVertices so that the GPU fetches them from memory more effectively,
+// and to measure how effectively both are used.
+// Include it in all source files that optimize meshes, e.g., the objRenderer program.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Wavefront .obj file I/O Header File.
+// Declares the DWORD data type.
+#include "objReader.h"
+
+// Defines.
+// The number of vertices held by the post-transform vertex cache simulated by the AnalyzeVertexCache function (a first-in, first-out cache), and assumed by the OptimizeVertexCache function (a least recently used cache).
+// The actual size is not reported by DirectX and varies by GPU; these are the sizes commonly used for measurement and optimization.
+#define VERTEX_CACHE_ANALYZE_SIZE 16
+#define VERTEX_CACHE_OPTIMIZE_SIZE 32
+// The size, in bytes, of one line of the memory cache from which the GPU fetches vertices, and the number of lines it holds, as simulated by the AnalyzeVertexFetch function (a least recently used cache).
+#define VERTEX_FETCH_CACHE_LINE_BYTES 64
+#define VERTEX_FETCH_CACHE_LINES 64
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the VertexCacheStatistics 'named structure' data type.
+// How effectively a post-transform vertex cache is used when drawing the triangles of an index array in order, as measured by the AnalyzeVertexCache function.
+// A vertex is transformed (i.e., the vertex shader is run for it) each time it is referenced by an index and is not in the cache.
+struct VertexCacheStatistics {
+	int VerticesTransformed = 0;							// The number of times the vertex shader is run.
+	double ACMR = 0.0;										// Average cache miss ratio: VerticesTransformed per triangle. At least about 0.5 for a large closed mesh, and at most 3.0 (no reuse).
+	double ATVR = 0.0;										// Average transform to vertex ratio: VerticesTransformed per vertex referenced. At least 1.0 (each vertex is transformed once).
+};
+
+// Declare the VertexFetchStatistics 'named structure' data type.
+// How effectively vertices are fetched from memory when drawing the triangles of an index array in order, as measured by the AnalyzeVertexFetch function.
+// A vertex is fetched each time it is transformed (see VertexCacheStatistics). Memory is read one cache line at a time, so fetching a vertex reads every cache line it overlaps that is not already in the memory cache.
+struct VertexFetchStatistics {
+	long long BytesFetched = 0;								// The number of bytes read from memory.
+	double Overfetch = 0.0;									// BytesFetched divided by the size of the vertices referenced. 1.0 when each vertex is read from memory once.
+};
+
+// End: Structure Declarations.
+
+//***
+// External Variable Global Declarations.
+//***
+
+// MeshOptimizerVertexCacheEnabled selects whether the objRenderer program reorders the triangles of OurIndices with the OptimizeVertexCache function after parsing the Wavefront .obj file. It is true by default.
+// Set it to false for a Wavefront .obj file whose face element statements must be drawn in file order, e.g., because overlapping triangles are drawn on top of each other without depth testing.
+extern bool MeshOptimizerVertexCacheEnabled;
+//
+// VertexCacheBefore and VertexCacheAfter are the VertexCacheStatistics of OurIndices before and after the most recent vertex cache optimization by the objRenderer program.
+extern VertexCacheStatistics VertexCacheBefore;
+extern VertexCacheStatistics VertexCacheAfter;
+//
+// MeshOptimizerVertexFetchEnabled selects whether the objRenderer program reorders OurVertices with the OptimizeVertexFetch function after reordering the triangles of OurIndices. It is true by default.
+// The triangles are drawn in the same order either way.
+extern bool MeshOptimizerVertexFetchEnabled;
+//
+// VertexFetchBefore and VertexFetchAfter are the VertexFetchStatistics of OurVertices and OurIndices before and after the most recent vertex fetch optimization by the objRenderer program.
+extern VertexFetchStatistics VertexFetchBefore;
+extern VertexFetchStatistics VertexFetchAfter;
+
+// End: External Variable Global Declarations.
+
+//***
+// Global Function Declarations.
+//***
+
+void AnalyzeVertexCache(const DWORD* Indices, int PrimitivesTotal, int VertexAttributeSetsTotal, int CacheSize, VertexCacheStatistics& Statistics);	// The AnalyzeVertexCache function simulates drawing the triangles of Indices in order through a first-in, first-out post-transform vertex cache of CacheSize vertices.
+void OptimizeVertexCache(DWORD* Indices, int PrimitivesTotal, int VertexAttributeSetsTotal);														// The OptimizeVertexCache function reorders the triangles of Indices to reduce the number of vertices transformed. The vertices of each triangle, and therefore its winding order, are unchanged.
+void AnalyzeVertexFetch(const DWORD* Indices, int PrimitivesTotal, int VertexAttributeSetsTotal, int VertexSize, VertexFetchStatistics& Statistics);	// The AnalyzeVertexFetch function simulates fetching the vertices, of VertexSize bytes each, transformed when drawing the triangles of Indices in order.
+void OptimizeVertexFetch(VERTEX* Vertices, DWORD* Indices, int PrimitivesTotal, int VertexAttributeSetsTotal);										// The OptimizeVertexFetch function reorders Vertices into the order in which Indices first references them, and changes Indices to match. The triangles drawn are unchanged.
+
+// End: Global Function Declarations.
+
+// End: Global Declarations.
@@ -0,0 +1,107 @@
+// meshResidency
+// Version 3.1
+//
+// Description
+// These functions compress the vertex attributes and indices of a mesh without loss, so the CPU can keep a smaller copy of a mesh once it has been uploaded to GPU memory, and decompress them again.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Mesh residency Header File.
+// Includes the Vector Container Class.
+#include "meshResidency.h"
+
+//***
+// External Variable Global Definitions.
+//***
+
+MeshResidency MeshResidencyPolicy = MESH_RESIDENCY_DROP;
+
+// End: External Variable Global Definitions.
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// meshResidencyPut function: Definition
+//   This function appends Value as a variable-length integer: 7 bits per byte, least significant first, with the high bit of each byte set if another byte follows.
+static void meshResidencyPut(std::vector<unsigned char>& Data, unsigned int Value)
+{
+	while (Value >= 0x80)
+	{
+		Data.push_back((unsigned char)(Value | 0x80));
+		Value >>= 7;
+	}
+	Data.push_back((unsigned char)Value);
+}
+
+// CompressVertexWords function: Definition
+//   The words of the first vertex are XORed with 0, i.e., written as they are.
+void CompressVertexWords(const unsigned int* Words, size_t WordsTotal, int Stride, CompressedWords& Result)
+{
+	Result = CompressedWords();
+	Result.WordsTotal = WordsTotal;
+	Result.Stride = Stride;
+	Result.Data.reserve(WordsTotal * 2);
+	for (size_t w = 0; w < WordsTotal; w++)
+		meshResidencyPut(Result.Data, Words[w] ^ (w >= (size_t)Stride ? Words[w - Stride] : 0));
+	Result.Data.shrink_to_fit();
+}
+
+// CompressIndexWords function: Definition
+//   The difference from the previous index is "zigzag" encoded, i.e., 0, -1, 1, -2, 2, ... are written as 0, 1, 2, 3, 4, ..., so small differences of either sign take few bytes.
+void CompressIndexWords(const unsigned int* Words, size_t WordsTotal, CompressedWords& Result)
+{
+	Result = CompressedWords();
+	Result.WordsTotal = WordsTotal;
+	Result.Stride = 0;
+	Result.Data.reserve(WordsTotal * 2);
+	unsigned int previous = 0;
+	for (size_t w = 0; w < WordsTotal; w++)
+	{
+		unsigned int difference = Words[w] - previous;		// The difference, modulo 2 to the power of 32.
+		meshResidencyPut(Result.Data, (difference << 1) ^ (unsigned int)-(int)(difference >> 31));
+		previous = Words[w];
+	}
+	Result.Data.shrink_to_fit();
+}
+
+// DecompressWords function: Definition
+//   Compressed.Stride is 0 for indices (see the CompressIndexWords function), or the number of words per vertex for vertex attributes.
+int DecompressWords(const CompressedWords& Compressed, unsigned int* Words)
+{
+	const unsigned char* data = Compressed.Data.data();
+	const unsigned char* end = data + Compressed.Data.size();
+	unsigned int previous = 0;
+	for (size_t w = 0; w < Compressed.WordsTotal; w++)
+	{
+		// Read one variable-length integer of at most 5 bytes.
+		unsigned int value = 0;
+		int shift = 0;
+		for (;;)
+		{
+			if (data == end || shift > 28)
+				return 1;									// The data ends early, or the integer is longer than 32 bits.
+			unsigned char byte = *data++;
+			value |= (unsigned int)(byte & 0x7F) << shift;
+			shift += 7;
+			if ((byte & 0x80) == 0)
+				break;
+		}
+
+		if (Compressed.Stride == 0)
+		{
+			previous += (value >> 1) ^ (unsigned int)-(int)(value & 1);
+			Words[w] = previous;
+		}
+		else
+			Words[w] = value ^ (w >= (size_t)Compressed.Stride ? Words[w - Compressed.Stride] : 0);
+	}
+	return data == end ? 0 : 1;
+}
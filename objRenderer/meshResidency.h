@@ -0,0 +1,82 @@
+// meshResidency Header File
+// Version 3.1
+//
+// Description
+// Mesh residency Header File
+// This header file contains the declarations used to decide what happens to the CPU's copy of a mesh once it has been uploaded to GPU memory (MeshResidencyPolicy), and to keep that copy compressed.
+// Once a mesh is uploaded, the GPU's copy is the one drawn, and the CPU's copy of its vertex attributes and indices is only needed to read the mesh again, e.g., to build collision data or to upload it again after the device is lost.
+// Keeping it doubles the memory the mesh uses; dropping it means the mesh must be loaded again (e.g., from the binary mesh cache file) if it is needed; keeping it compressed is a compromise between the two.
+// The compression is lossless, and works on 32-bit words, so it needs no knowledge of the VERTEX structure:
+//   The vertex attributes are compressed one field at a time: each word is XORed with the same word of the previous vertex, which leaves only the bits that differ, and written as a variable-length integer of 1 to 5 bytes.
+//   Attributes that repeat from vertex to vertex (e.g., the normal vectors of a flat surface) take 1 byte, and coordinates that differ only in their last bits take 3 or 4.
+//   The indices are compressed as the difference from the previous index, written as a variable-length integer. Indices ordered for the GPU's caches (see meshOptimizer.h) mostly differ by little, and take 1 or 2 bytes.
+// None of these functions use Direct3D. Include it in all source files that drop or compress the CPU's copies of meshes, e.g., the objRenderer program.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Standard Definitions.
+#include <cstddef>											// Required for the size_t data type.
+
+// Vector Container Class.
+#include <vector>											// Vector class, used to hold the compressed words.
+
+//***
+// Enumeration Declarations.
+//***
+
+// What happens to the CPU's copy of a mesh once the mesh is uploaded.
+enum MeshResidency {
+	MESH_RESIDENCY_KEEP,									// The copy is kept as it is, without any unused capacity.
+	MESH_RESIDENCY_DROP,									// The copy is freed.
+	MESH_RESIDENCY_COMPRESSED								// The copy is compressed, and the uncompressed copy freed.
+};
+
+// End: Enumeration Declarations.
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the CompressedWords 'named structure' data type.
+// An array of 32-bit words compressed by the CompressVertexWords or CompressIndexWords function.
+struct CompressedWords {
+	std::vector<unsigned char> Data;						// The compressed words.
+	size_t WordsTotal = 0;									// The number of words compressed.
+	int Stride = 0;											// The number of words per vertex, for vertex attributes; 0 for indices.
+};
+
+// End: Structure Declarations.
+
+//***
+// External Variable Global Declarations.
+//***
+
+// MeshResidencyPolicy selects what the objRenderer program does with its copy of the vertex attributes and indices of the object once they are uploaded to the vertex buffer and index buffer. It is MESH_RESIDENCY_DROP by default.
+// When the objRenderer program uploads the object again (F3, as after the device is lost), the copy kept is used as it is, the compressed copy is decompressed, and a dropped copy is loaded again from the binary mesh cache file.
+// The software rasterizer keeps a separate copy of its own when SoftwareRasterizerEnabled is true, whatever the policy.
+extern MeshResidency MeshResidencyPolicy;
+
+// End: External Variable Global Declarations.
+
+//***
+// Global Function Declarations.
+//***
+
+void CompressVertexWords(const unsigned int* Words, size_t WordsTotal, int Stride, CompressedWords& Result);	// The CompressVertexWords function compresses WordsTotal words of vertex attributes, Stride words per vertex, into Result.
+void CompressIndexWords(const unsigned int* Words, size_t WordsTotal, CompressedWords& Result);					// The CompressIndexWords function compresses WordsTotal indices into Result.
+int DecompressWords(const CompressedWords& Compressed, unsigned int* Words);									// The DecompressWords function writes the Compressed.WordsTotal words of Compressed to Words. It returns 0 on success, or 1 if Compressed is damaged.
+
+// End: Global Function Declarations.
+
+// End: Global Declarations.
@@ -0,0 +1,632 @@
+// meshSimplifier
+// Version 3.1
+//
+// Description
+// These functions simplify the triangles of an index array by repeatedly collapsing an edge, i.e., moving one vertex onto a neighboring vertex, which removes the triangles shared by the two vertices,
+// and build from the simplified triangles a chain of levels of detail, each drawn with the same vertex buffer as the unsimplified triangles.
+//
+// The cost of each collapse is measured with quadric error metrics (Michael Garland and Paul S. Heckbert, "Surface Simplification Using Quadric Error Metrics"):
+// each vertex holds a quadric, the sum of the squared distances to the planes of the triangles it has absorbed, so the cost of moving it is the distance from its new position to those planes.
+//
+// Vertices of OurVertices with the same geometric vertex but different vertex normal vectors or vertex texture coordinates (an attribute seam, e.g., the edge of a texture, or a hard edge between two faces) are moved together,
+// and only along the seam, so that no crack opens in the surface and no texture coordinate is stretched across the seam. The vertices of an open edge of the surface (a border) are moved only along the border.
+// The vertex attributes of OurVertices are never changed; a simplified triangle references the vertex attributes of the vertices it was collapsed onto.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Mesh simplification Header File.
+#include "meshSimplifier.h"
+
+// Vector Container Class.
+#include <vector>											// Vector class member functions push_back, insert, data, etc.
+
+// Unordered Map Container Class.
+#include <unordered_map>									// Unordered map class member functions reserve, try_emplace, etc.
+
+// Algorithm Functions.
+#include <algorithm>										// Algorithm functions sort, fill, min, max.
+
+// Mathematical Functions.
+#include <cmath>											// Mathematical functions sqrt, fabs.
+
+// Memory Functions.
+#include <cstring>											// Memory functions memcpy, memmove.
+
+// Floating-Point Limits.
+#include <cfloat>											// FLT_MAX.
+
+// Job system Header File.
+#include "jobSystem.h"
+
+// Using Declarations and Directives.
+using std::vector;
+using std::unordered_map;
+using std::sort;
+using std::fill;
+using std::min;
+using std::max;
+using std::sqrt;
+using std::fabs;
+using std::memcpy;
+using std::memmove;
+
+//***
+// External Variable Global Definitions.
+//***
+
+bool MeshSimplifierLodEnabled = true;
+float MeshLodPixelError = 1.0f;
+vector<MeshLod> MeshLods;
+vector<DWORD> MeshLodIndices;
+
+// End: External Variable Global Definitions.
+
+// Constants of the SimplifyMesh and BuildMeshLods functions.
+static const float MeshSimplifierBorderWeight = 10.0f;		// How strongly the vertices of a border are kept on the border, relative to the triangles' own planes.
+static const float MeshSimplifierAttributeWeight = 1e-4f;	// How strongly collapses that change the vertex normal vectors and vertex texture coordinates of triangles are avoided, relative to the squared distance (as a fraction of the size of the object) moved.
+static const float MeshSimplifierFlipLimit = 1e-2f;			// A collapse is not made if it turns a remaining triangle by 90 degrees or more, i.e., the cosine of the angle between its normals before and after is less than this.
+static const int MeshSimplifierValenceMaximum = 256;		// A vertex referenced by more triangles than this is never moved, which limits the time taken to find the cost of moving it.
+static const int MeshSimplifierPassesMaximum = 256;			// The maximum number of passes of the SimplifyMesh function. Each pass collapses every edge it can without two collapses changing the same triangle.
+static const int MeshSimplifierParallelMinimum = 16384;		// A range of work is divided among the job system's threads only if each range gets at least this many elements.
+static const float MeshLodReduction = 0.5f;					// Each level of detail is simplified to at most this fraction of the triangles of the level of detail before it.
+static const float MeshLodMinimumReduction = 0.85f;			// A level of detail is not kept unless it has at most this fraction of the triangles of the level of detail before it, i.e., simplification has stopped making progress.
+
+// Declare the MeshQuadric 'named structure' data type.
+// A MeshQuadric is the symmetric 4x4 matrix of a quadric error metric, i.e., the sum of Weight x (n . p + d)^2 over a set of planes (n, d), evaluated at a point p.
+// Only the 10 distinct elements of the matrix are stored: A (the 3x3 matrix n n^T), b (the vector d n), and c (d^2).
+// The quadric of a position uses that position as its origin, i.e., p is measured from the position. Because p and d are then small, the error is not lost to rounding when the terms of the sum, which are large far from the origin, cancel.
+struct MeshQuadric {
+	float a00 = 0.0f, a11 = 0.0f, a22 = 0.0f, a10 = 0.0f, a20 = 0.0f, a21 = 0.0f;
+	float b0 = 0.0f, b1 = 0.0f, b2 = 0.0f;
+	float c = 0.0f;
+	float Weight = 0.0f;									// The sum of the weights of the planes, used to average the squared distances.
+};
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// MeshQuadricAddPlane function: Definition
+//   This function adds the plane n . p + d = 0, where n is a unit vector, with the weight Weight, to Quadric.
+static void MeshQuadricAddPlane(MeshQuadric& Quadric, const XMFLOAT3& n, float d, float Weight)
+{
+	Quadric.a00 += Weight * n.x * n.x;
+	Quadric.a11 += Weight * n.y * n.y;
+	Quadric.a22 += Weight * n.z * n.z;
+	Quadric.a10 += Weight * n.y * n.x;
+	Quadric.a20 += Weight * n.z * n.x;
+	Quadric.a21 += Weight * n.z * n.y;
+	Quadric.b0 += Weight * d * n.x;
+	Quadric.b1 += Weight * d * n.y;
+	Quadric.b2 += Weight * d * n.z;
+	Quadric.c += Weight * d * d;
+	Quadric.Weight += Weight;
+}
+
+// MeshQuadricAdd function: Definition
+//   This function adds the planes of Other to Quadric.
+static void MeshQuadricAdd(MeshQuadric& Quadric, const MeshQuadric& Other)
+{
+	Quadric.a00 += Other.a00;
+	Quadric.a11 += Other.a11;
+	Quadric.a22 += Other.a22;
+	Quadric.a10 += Other.a10;
+	Quadric.a20 += Other.a20;
+	Quadric.a21 += Other.a21;
+	Quadric.b0 += Other.b0;
+	Quadric.b1 += Other.b1;
+	Quadric.b2 += Other.b2;
+	Quadric.c += Other.c;
+	Quadric.Weight += Other.Weight;
+}
+
+// MeshQuadricTranslate function: Definition
+//   This function moves the origin of Quadric by t, i.e., from o to o + t, without changing the planes: b becomes b + A t, and c becomes c + t^T A t + 2 b . t.
+static void MeshQuadricTranslate(MeshQuadric& Quadric, const XMFLOAT3& t)
+{
+	float at0 = Quadric.a00 * t.x + Quadric.a10 * t.y + Quadric.a20 * t.z;
+	float at1 = Quadric.a10 * t.x + Quadric.a11 * t.y + Quadric.a21 * t.z;
+	float at2 = Quadric.a20 * t.x + Quadric.a21 * t.y + Quadric.a22 * t.z;
+	Quadric.c += at0 * t.x + at1 * t.y + at2 * t.z + 2.0f * (Quadric.b0 * t.x + Quadric.b1 * t.y + Quadric.b2 * t.z);
+	Quadric.b0 += at0;
+	Quadric.b1 += at1;
+	Quadric.b2 += at2;
+}
+
+// MeshQuadricError function: Definition
+//   This function returns the weighted average of the squared distances from the point p, measured from the origin of Quadric, to the planes of Quadric.
+static float MeshQuadricError(const MeshQuadric& Quadric, const XMFLOAT3& p)
+{
+	float rx = Quadric.a00 * p.x + Quadric.a10 * p.y + Quadric.a20 * p.z + Quadric.b0 * 2.0f;
+	float ry = Quadric.a10 * p.x + Quadric.a11 * p.y + Quadric.a21 * p.z + Quadric.b1 * 2.0f;
+	float rz = Quadric.a20 * p.x + Quadric.a21 * p.y + Quadric.a22 * p.z + Quadric.b2 * 2.0f;
+	float error = rx * p.x + ry * p.y + rz * p.z + Quadric.c;
+	return Quadric.Weight > 0.0f ? fabs(error) / Quadric.Weight : 0.0f;
+}
+
+// MeshSimplifierNormal function: Definition
+//   This function returns the normal of the triangle p0, p1, p2, whose length is twice the triangle's area.
+static XMFLOAT3 MeshSimplifierNormal(const XMFLOAT3& p0, const XMFLOAT3& p1, const XMFLOAT3& p2)
+{
+	XMFLOAT3 e1(p1.x - p0.x, p1.y - p0.y, p1.z - p0.z);
+	XMFLOAT3 e2(p2.x - p0.x, p2.y - p0.y, p2.z - p0.z);
+	return XMFLOAT3(e1.y * e2.z - e1.z * e2.y, e1.z * e2.x - e1.x * e2.z, e1.x * e2.y - e1.y * e2.x);
+}
+
+// MeshSimplifierDot function: Definition
+static float MeshSimplifierDot(const XMFLOAT3& a, const XMFLOAT3& b)
+{
+	return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+// Declare the MeshSimplifierNeighbor 'named structure' data type.
+// A neighboring position of a position, i.e., one that shares at least one triangle with it.
+struct MeshSimplifierNeighbor {
+	int Position;											// The neighboring position.
+	int TrianglesShared;									// The number of triangles shared by both positions. 1 if the edge between them is a border edge.
+};
+
+// Declare the MeshSimplifierWedge 'named structure' data type.
+// A vertex (wedge) of a position that is moved by a collapse, and the vertex of the destination position onto which it is moved.
+struct MeshSimplifierWedge {
+	DWORD Vertex;											// The vertex of the position that is moved.
+	long long Destination;									// The vertex onto which it is moved, -1 if no triangle shares both, or -2 if triangles share it with more than one vertex of the destination position.
+};
+
+// Declare the MeshSimplifierState 'named structure' data type.
+// All variables used while simplifying one set of triangles, from the first collapse to the last, so that the levels of detail of the BuildMeshLods function are made by one simplification that is stopped at each level of detail,
+// and the quadric of each position always holds the planes of the unsimplified triangles it has absorbed.
+// Collapses are made on positions (geometric vertices) rather than on vertices, because OurVertices holds one vertex per unique set of vertex attributes, so several vertices may share a position.
+struct MeshSimplifierState {
+	const VERTEX* Vertices = nullptr;						// The vertices referenced by the triangles. They are never changed.
+	vector<int> Position;									// The position of each vertex.
+	vector<XMFLOAT3> Point;									// The geometric vertex of each position, scaled so that the object's largest dimension is 1.0, so that costs do not depend on the object's size.
+	float Extent = 0.0f;									// The object's largest dimension, in object space.
+	int PositionsTotal = 0;									// The total number of array elements in Point.
+	vector<DWORD> Indices;									// The remaining triangles, three indices of Vertices per triangle primitive.
+	int PrimitivesTotal = 0;								// The total number of remaining triangles.
+	vector<int> TriangleFirst;								// The remaining triangles of position p are TriangleList[TriangleFirst[p]] to TriangleList[TriangleFirst[p + 1] - 1].
+	vector<int> TriangleList;
+	vector<MeshQuadric> Quadric;							// The quadric of each position.
+	vector<float> CollapseCost;								// The cost of the least costly collapse of each position, or FLT_MAX if it cannot be moved.
+	vector<float> CollapseError;							// The average squared distance moved by the least costly collapse of each position, i.e., its cost without the cost of changing vertex attributes.
+	vector<int> CollapseDestination;						// The position onto which the least costly collapse of each position moves it.
+	vector<char> Locked;									// Whether a position, or one of its triangles, has been changed by a collapse in this pass. Only the least costly collapse of such a position must be found again in the next pass.
+	vector<DWORD> Remap;									// The vertex onto which each vertex is moved.
+	vector<unsigned long long> Order;						// The positions with a collapse, in order of increasing cost: the cost's bits in the upper 32 bits, and the position in the lower 32 bits.
+	float Error = 0.0f;										// The largest CollapseError of the collapses made, i.e., the square of the geometric error of the remaining triangles, scaled like Point.
+};
+
+// MeshSimplifierFindTriangles function: Definition
+//   This function finds the remaining triangles of each position (TriangleFirst and TriangleList).
+static void MeshSimplifierFindTriangles(MeshSimplifierState& State)
+{
+	fill(State.TriangleFirst.begin(), State.TriangleFirst.end(), 0);
+	for (size_t i = 0; i < (size_t)State.PrimitivesTotal * 3; i++)
+		State.TriangleFirst[State.Position[State.Indices[i]] + 1]++;
+	for (int p = 0; p < State.PositionsTotal; p++)
+		State.TriangleFirst[p + 1] += State.TriangleFirst[p];
+	State.TriangleList.resize((size_t)State.PrimitivesTotal * 3);
+	vector<int> next(State.TriangleFirst.begin(), State.TriangleFirst.end() - 1);
+	for (int t = 0; t < State.PrimitivesTotal; t++)
+		for (int c = 0; c < 3; c++)
+			State.TriangleList[next[State.Position[State.Indices[(size_t)t * 3 + c]]]++] = t;
+}
+
+// MeshSimplifierFindNeighbors function: Definition
+//   This function finds the neighboring positions of position p, and the number of remaining triangles each shares with p.
+static void MeshSimplifierFindNeighbors(const MeshSimplifierState& State, int p, vector<MeshSimplifierNeighbor>& Neighbors)
+{
+	Neighbors.clear();
+	for (int k = State.TriangleFirst[p]; k < State.TriangleFirst[p + 1]; k++)
+	{
+		const DWORD* triangle = &State.Indices[(size_t)State.TriangleList[k] * 3];
+		for (int c = 0; c < 3; c++)
+		{
+			int q = State.Position[triangle[c]];
+			if (q == p)
+				continue;
+			size_t n = 0;
+			while (n < Neighbors.size() && Neighbors[n].Position != q)
+				n++;
+			if (n == Neighbors.size())
+				Neighbors.push_back({ q, 0 });
+			Neighbors[n].TrianglesShared++;
+		}
+	}
+}
+
+// MeshSimplifierRemoveLines function: Definition
+//   This function removes the triangles that have collapsed to a line or a point, i.e., that reference the same position twice. The order of the remaining triangles is unchanged.
+static void MeshSimplifierRemoveLines(MeshSimplifierState& State)
+{
+	int remaining = 0;
+	for (int t = 0; t < State.PrimitivesTotal; t++)
+	{
+		const DWORD* triangle = &State.Indices[(size_t)t * 3];
+		int p0 = State.Position[triangle[0]], p1 = State.Position[triangle[1]], p2 = State.Position[triangle[2]];
+		if (p0 == p1 || p1 == p2 || p2 == p0)
+			continue;
+		memmove(&State.Indices[(size_t)remaining * 3], triangle, 3 * sizeof(DWORD));
+		remaining++;
+	}
+	State.PrimitivesTotal = remaining;
+	State.Indices.resize((size_t)remaining * 3);
+}
+
+// MeshSimplifierBegin function: Definition
+//   This function prepares State to simplify the triangles of Indices:
+//   1. Finds the position of each vertex.
+//   2. Finds the quadric of each position: the sum of the planes of its triangles, weighted by area, and of the planes through its border edges perpendicular to their triangle, weighted by the squared length of the edge.
+//      Each position is considered independently, so this is divided among threads.
+static void MeshSimplifierBegin(MeshSimplifierState& State, const VERTEX* Vertices, int VertexAttributeSetsTotal, const DWORD* Indices, int PrimitivesTotal)
+{
+	//***
+	// 1. Find the position of each vertex.
+	//***
+
+	State.Vertices = Vertices;
+	State.Position.resize(VertexAttributeSetsTotal);
+	XMFLOAT3 minimum = Vertices[0].GeometricVertex, maximum = Vertices[0].GeometricVertex;
+	for (int i = 1; i < VertexAttributeSetsTotal; i++)
+	{
+		const XMFLOAT3& p = Vertices[i].GeometricVertex;
+		minimum = XMFLOAT3(min(minimum.x, p.x), min(minimum.y, p.y), min(minimum.z, p.z));
+		maximum = XMFLOAT3(max(maximum.x, p.x), max(maximum.y, p.y), max(maximum.z, p.z));
+	}
+	State.Extent = max(maximum.x - minimum.x, max(maximum.y - minimum.y, maximum.z - minimum.z));
+	float scale = State.Extent > 0.0f ? 1.0f / State.Extent : 1.0f;
+
+	// The key of a position is its three coordinates, compared bit for bit.
+	struct PositionKey {
+		unsigned int x, y, z;
+		bool operator==(const PositionKey& Other) const { return x == Other.x && y == Other.y && z == Other.z; }
+	};
+	struct PositionKeyHash {
+		size_t operator()(const PositionKey& Key) const { return (size_t)(Key.x * 73856093u ^ Key.y * 19349663u ^ Key.z * 83492791u); }
+	};
+	unordered_map<PositionKey, int, PositionKeyHash> positions;
+	positions.reserve(VertexAttributeSetsTotal);
+	for (int i = 0; i < VertexAttributeSetsTotal; i++)
+	{
+		const XMFLOAT3& p = Vertices[i].GeometricVertex;
+		PositionKey key;
+		memcpy(&key.x, &p.x, sizeof(float));
+		memcpy(&key.y, &p.y, sizeof(float));
+		memcpy(&key.z, &p.z, sizeof(float));
+		auto found = positions.try_emplace(key, (int)State.Point.size());
+		if (found.second)
+			State.Point.push_back(XMFLOAT3((p.x - minimum.x) * scale, (p.y - minimum.y) * scale, (p.z - minimum.z) * scale));
+		State.Position[i] = found.first->second;
+	}
+	State.PositionsTotal = (int)State.Point.size();
+
+	State.Indices.assign(Indices, Indices + (size_t)PrimitivesTotal * 3);
+	State.PrimitivesTotal = PrimitivesTotal;
+	MeshSimplifierRemoveLines(State);
+
+	State.TriangleFirst.resize((size_t)State.PositionsTotal + 1);
+	State.Quadric.assign(State.PositionsTotal, MeshQuadric());
+	State.CollapseCost.resize(State.PositionsTotal);
+	State.CollapseError.resize(State.PositionsTotal);
+	State.CollapseDestination.resize(State.PositionsTotal);
+	State.Locked.assign(State.PositionsTotal, 1);			// The least costly collapse of every position must be found.
+	State.Remap.resize(VertexAttributeSetsTotal);
+	for (int i = 0; i < VertexAttributeSetsTotal; i++)
+		State.Remap[i] = (DWORD)i;
+
+	// End: 1. Find the position of each vertex.
+
+	//***
+	// 2. Find the quadric of each position.
+	//***
+
+	MeshSimplifierFindTriangles(State);
+	JobParallelFor(State.PositionsTotal, MeshSimplifierParallelMinimum, [&State](int Begin, int End)
+	{
+		vector<MeshSimplifierNeighbor> neighbors;
+		for (int p = Begin; p < End; p++)
+		{
+			for (int k = State.TriangleFirst[p]; k < State.TriangleFirst[p + 1]; k++)
+			{
+				const DWORD* triangle = &State.Indices[(size_t)State.TriangleList[k] * 3];
+				XMFLOAT3 n = MeshSimplifierNormal(State.Point[State.Position[triangle[0]]], State.Point[State.Position[triangle[1]]], State.Point[State.Position[triangle[2]]]);
+				float length = sqrt(MeshSimplifierDot(n, n));
+				if (length == 0.0f)
+					continue;
+				n = XMFLOAT3(n.x / length, n.y / length, n.z / length);
+				MeshQuadricAddPlane(State.Quadric[p], n, 0.0f, length * 0.5f);	// The plane of the triangle passes through p, the origin of its quadric.
+			}
+
+			MeshSimplifierFindNeighbors(State, p, neighbors);
+			for (const MeshSimplifierNeighbor& neighbor : neighbors)
+			{
+				if (neighbor.TrianglesShared != 1)
+					continue;
+				// Find the triangle of the border edge.
+				for (int k = State.TriangleFirst[p]; k < State.TriangleFirst[p + 1]; k++)
+				{
+					const DWORD* triangle = &State.Indices[(size_t)State.TriangleList[k] * 3];
+					if (State.Position[triangle[0]] != neighbor.Position && State.Position[triangle[1]] != neighbor.Position && State.Position[triangle[2]] != neighbor.Position)
+						continue;
+					XMFLOAT3 normal = MeshSimplifierNormal(State.Point[State.Position[triangle[0]]], State.Point[State.Position[triangle[1]]], State.Point[State.Position[triangle[2]]]);
+					const XMFLOAT3& a = State.Point[p];
+					const XMFLOAT3& b = State.Point[neighbor.Position];
+					XMFLOAT3 edge(b.x - a.x, b.y - a.y, b.z - a.z);
+					XMFLOAT3 n(edge.y * normal.z - edge.z * normal.y, edge.z * normal.x - edge.x * normal.z, edge.x * normal.y - edge.y * normal.x);
+					float length = sqrt(MeshSimplifierDot(n, n));
+					if (length > 0.0f)
+					{
+						n = XMFLOAT3(n.x / length, n.y / length, n.z / length);
+						MeshQuadricAddPlane(State.Quadric[p], n, 0.0f, MeshSimplifierDot(edge, edge) * MeshSimplifierBorderWeight);	// The plane of the border edge passes through p, the origin of its quadric.
+					}
+					break;
+				}
+			}
+		}
+	});
+
+	// End: 2. Find the quadric of each position.
+}
+
+// MeshSimplifierFindCollapse function: Definition
+//   This function finds the least costly collapse of position p, i.e., the neighboring position onto which moving p adds the least error, in CollapseCost, CollapseError, and CollapseDestination.
+//   A position p may be moved onto a neighboring position q only if:
+//   - Every vertex of p shares a triangle with exactly one vertex of q, which it is moved onto. This keeps an attribute seam on the seam, and keeps each side of the seam with its own vertex attributes.
+//   - If p is on a border, the edge from p to q is a border edge. This keeps a border on the border.
+//   - No remaining triangle of p is turned over (see MeshSimplifierFlipLimit).
+static void MeshSimplifierFindCollapse(MeshSimplifierState& State, int p, vector<MeshSimplifierNeighbor>& Neighbors, vector<MeshSimplifierWedge>& Wedges)
+{
+	State.CollapseCost[p] = FLT_MAX;
+	int valence = State.TriangleFirst[p + 1] - State.TriangleFirst[p];
+	if (valence == 0 || valence > MeshSimplifierValenceMaximum)
+		return;
+
+	MeshSimplifierFindNeighbors(State, p, Neighbors);
+	bool border = false;
+	for (const MeshSimplifierNeighbor& neighbor : Neighbors)
+		border = border || neighbor.TrianglesShared == 1;
+
+	for (const MeshSimplifierNeighbor& neighbor : Neighbors)
+	{
+		int q = neighbor.Position;
+		if (border && neighbor.TrianglesShared != 1)
+			continue;										// A border position is moved only along a border edge.
+		const XMFLOAT3& from = State.Point[p];
+		const XMFLOAT3& to = State.Point[q];
+		float error = MeshQuadricError(State.Quadric[p], XMFLOAT3(to.x - from.x, to.y - from.y, to.z - from.z));
+		if (error >= State.CollapseCost[p])
+			continue;
+
+		// Pair each vertex of p with the vertex of q it shares a triangle with.
+		// Every triangle of p references one of its vertices, so this also finds every vertex of p that is referenced.
+		Wedges.clear();
+		bool turned = false;
+		for (int k = State.TriangleFirst[p]; k < State.TriangleFirst[p + 1] && !turned; k++)
+		{
+			const DWORD* triangle = &State.Indices[(size_t)State.TriangleList[k] * 3];
+			int corner = State.Position[triangle[0]] == p ? 0 : State.Position[triangle[1]] == p ? 1 : 2;
+			int shared = State.Position[triangle[0]] == q ? 0 : State.Position[triangle[1]] == q ? 1 : State.Position[triangle[2]] == q ? 2 : -1;
+			size_t w = 0;
+			while (w < Wedges.size() && Wedges[w].Vertex != triangle[corner])
+				w++;
+			if (w == Wedges.size())
+				Wedges.push_back({ triangle[corner], -1 });
+			if (shared >= 0)
+			{
+				if (Wedges[w].Destination == -1)
+					Wedges[w].Destination = triangle[shared];
+				else if (Wedges[w].Destination != (long long)triangle[shared])
+					Wedges[w].Destination = -2;
+				continue;									// This triangle is removed by the collapse.
+			}
+
+			// This triangle remains. It must not be turned over by moving p onto q.
+			XMFLOAT3 before[3], after[3];
+			for (int c = 0; c < 3; c++)
+			{
+				before[c] = State.Point[State.Position[triangle[c]]];
+				after[c] = c == corner ? State.Point[q] : before[c];
+			}
+			XMFLOAT3 n0 = MeshSimplifierNormal(before[0], before[1], before[2]);
+			XMFLOAT3 n1 = MeshSimplifierNormal(after[0], after[1], after[2]);
+			turned = MeshSimplifierDot(n0, n1) <= MeshSimplifierFlipLimit * sqrt(MeshSimplifierDot(n0, n0) * MeshSimplifierDot(n1, n1));
+		}
+		if (turned)
+			continue;
+
+		// The cost of changing the vertex attributes of the remaining triangles of p, from those of each vertex of p to those of the vertex it is moved onto.
+		float cost = error;
+		bool paired = true;
+		for (const MeshSimplifierWedge& wedge : Wedges)
+		{
+			if (wedge.Destination < 0)
+			{
+				paired = false;
+				break;
+			}
+			const VERTEX& a = State.Vertices[wedge.Vertex];
+			const VERTEX& b = State.Vertices[wedge.Destination];
+			float dnx = a.VertexNormalVector.x - b.VertexNormalVector.x, dny = a.VertexNormalVector.y - b.VertexNormalVector.y, dnz = a.VertexNormalVector.z - b.VertexNormalVector.z;
+			float du = a.VertexTextureCoordinate.x - b.VertexTextureCoordinate.x, dv = a.VertexTextureCoordinate.y - b.VertexTextureCoordinate.y;
+			cost += MeshSimplifierAttributeWeight * (dnx * dnx + dny * dny + dnz * dnz + du * du + dv * dv);
+		}
+		if (!paired || cost >= State.CollapseCost[p])
+			continue;
+
+		State.CollapseCost[p] = cost;
+		State.CollapseError[p] = error;
+		State.CollapseDestination[p] = q;
+	}
+}
+
+// MeshSimplifierContinue function: Definition
+//   This function collapses edges of the remaining triangles of State until at most TargetPrimitivesTotal triangles remain, or no more edges can be collapsed. Each pass:
+//   1. Finds the remaining triangles of each position (on the calling thread), and the least costly collapse of each position changed by the previous pass (divided among threads, because each position is considered independently).
+//   2. Makes collapses in order of increasing cost (on the calling thread), skipping any collapse that would change a triangle already changed by another collapse in this pass, until the target is reached.
+//      A collapse of p onto q changes every triangle of p, so it locks p and every position of p's triangles against other collapses in this pass.
+//   3. Moves the vertices of the triangles (divided among threads), and removes the triangles that have collapsed to a line.
+//   The result is the same for any number of threads.
+static void MeshSimplifierContinue(MeshSimplifierState& State, int TargetPrimitivesTotal)
+{
+	for (int pass = 0; pass < MeshSimplifierPassesMaximum && State.PrimitivesTotal > TargetPrimitivesTotal; pass++)
+	{
+		//***
+		// 1. Find the remaining triangles of each position, and the least costly collapse of each position.
+		//***
+
+		// The least costly collapse of a position changes only if its triangles or its quadric have changed, i.e., if it was locked by a collapse in the previous pass, because no position is ever moved other than by being removed.
+		MeshSimplifierFindTriangles(State);
+		JobParallelFor(State.PositionsTotal, MeshSimplifierParallelMinimum, [&State](int Begin, int End)
+		{
+			vector<MeshSimplifierNeighbor> neighbors;
+			vector<MeshSimplifierWedge> wedges;
+			for (int p = Begin; p < End; p++)
+				if (State.Locked[p])
+					MeshSimplifierFindCollapse(State, p, neighbors, wedges);
+		});
+
+		// End: 1. Find the remaining triangles of each position, and the least costly collapse of each position.
+
+		//***
+		// 2. Make collapses in order of increasing cost, until the target is reached.
+		//***
+
+		// Costs are never negative, so the order of their bits is the order of their values. Equal costs are ordered by position.
+		State.Order.clear();
+		for (int p = 0; p < State.PositionsTotal; p++)
+			if (State.CollapseCost[p] != FLT_MAX)
+			{
+				unsigned int bits;
+				memcpy(&bits, &State.CollapseCost[p], sizeof(float));
+				State.Order.push_back((unsigned long long)bits << 32 | (unsigned int)p);
+			}
+		sort(State.Order.begin(), State.Order.end());
+
+		fill(State.Locked.begin(), State.Locked.end(), 0);
+		int removed = 0;
+		int collapses = 0;
+		for (unsigned long long order : State.Order)
+		{
+			if (State.PrimitivesTotal - removed <= TargetPrimitivesTotal)
+				break;
+			int p = (int)(order & 0xFFFFFFFFu);
+			int q = State.CollapseDestination[p];
+			if (State.Locked[p] || State.Locked[q])
+				continue;
+
+			for (int k = State.TriangleFirst[p]; k < State.TriangleFirst[p + 1]; k++)
+			{
+				const DWORD* triangle = &State.Indices[(size_t)State.TriangleList[k] * 3];
+				int corner = State.Position[triangle[0]] == p ? 0 : State.Position[triangle[1]] == p ? 1 : 2;
+				for (int c = 0; c < 3; c++)
+				{
+					State.Locked[State.Position[triangle[c]]] = 1;
+					if (State.Position[triangle[c]] == q)
+					{
+						State.Remap[triangle[corner]] = triangle[c];
+						removed++;
+					}
+				}
+			}
+			const XMFLOAT3& from = State.Point[p];
+			const XMFLOAT3& to = State.Point[q];
+			MeshQuadricTranslate(State.Quadric[p], XMFLOAT3(to.x - from.x, to.y - from.y, to.z - from.z));
+			MeshQuadricAdd(State.Quadric[q], State.Quadric[p]);
+			State.Error = max(State.Error, State.CollapseError[p]);
+			collapses++;
+		}
+		if (collapses == 0)
+			break;											// No edge can be collapsed.
+
+		// End: 2. Make collapses in order of increasing cost, until the target is reached.
+
+		//***
+		// 3. Move the vertices of the triangles, and remove the triangles that have collapsed to a line.
+		//***
+
+		JobParallelFor(State.PrimitivesTotal * 3, MeshSimplifierParallelMinimum, [&State](int Begin, int End)
+		{
+			for (int i = Begin; i < End; i++)
+				State.Indices[i] = State.Remap[State.Indices[i]];
+		});
+		MeshSimplifierRemoveLines(State);
+
+		// End: 3. Move the vertices of the triangles, and remove the triangles that have collapsed to a line.
+	}
+}
+
+// SimplifyMesh function: Definition
+//   This function collapses edges of the triangles of Indices until at most TargetPrimitivesTotal triangles remain, or no more edges can be collapsed, and returns the remaining triangles in Result.
+//   ResultError is the geometric error of Result, in object space: the square root of the largest average squared distance from a moved position to the planes of the triangles it absorbed.
+//   It returns the number of triangles in Result.
+int SimplifyMesh(const VERTEX* Vertices, int VertexAttributeSetsTotal, const DWORD* Indices, int PrimitivesTotal, int TargetPrimitivesTotal, vector<DWORD>& Result, float& ResultError)
+{
+	if (PrimitivesTotal <= TargetPrimitivesTotal || VertexAttributeSetsTotal <= 0)
+	{
+		Result.assign(Indices, Indices + (size_t)PrimitivesTotal * 3);
+		ResultError = 0.0f;
+		return PrimitivesTotal;
+	}
+
+	MeshSimplifierState state;
+	MeshSimplifierBegin(state, Vertices, VertexAttributeSetsTotal, Indices, PrimitivesTotal);
+	MeshSimplifierContinue(state, TargetPrimitivesTotal);
+	Result.swap(state.Indices);
+	ResultError = sqrt(state.Error) * state.Extent;
+	return state.PrimitivesTotal;
+}
+
+// BuildMeshLods function: Definition
+//   This function builds the levels of detail of the triangles of Indices:
+//   Lods[0] is level of detail 0, i.e., Indices itself, at the start of the index buffer.
+//   Each following level of detail has at most half the triangles of the one before it, and its indices are appended to LodIndices, which follows Indices in the index buffer.
+//   The levels of detail are made by one simplification, stopped at each level of detail, so the geometric error of each is measured from level of detail 0.
+//   No more levels of detail are built when simplification stops making progress (e.g., when little more than the object's borders and seams remain), or when there are MESH_LOD_LEVELS_MAXIMUM levels of detail.
+void BuildMeshLods(const VERTEX* Vertices, int VertexAttributeSetsTotal, const DWORD* Indices, int PrimitivesTotal, vector<MeshLod>& Lods, vector<DWORD>& LodIndices)
+{
+	Lods.assign(1, MeshLod());
+	Lods[0].PrimitivesTotal = PrimitivesTotal;
+	LodIndices.clear();
+	if (PrimitivesTotal <= 0 || VertexAttributeSetsTotal <= 0)
+		return;
+
+	MeshSimplifierState state;
+	MeshSimplifierBegin(state, Vertices, VertexAttributeSetsTotal, Indices, PrimitivesTotal);
+	while (Lods.size() < MESH_LOD_LEVELS_MAXIMUM)
+	{
+		int previous = Lods.back().PrimitivesTotal;
+		MeshSimplifierContinue(state, (int)(previous * MeshLodReduction));
+		if (state.PrimitivesTotal == 0 || state.PrimitivesTotal > previous * MeshLodMinimumReduction)
+			break;
+
+		MeshLod lod;
+		lod.FirstIndex = PrimitivesTotal * 3 + (int)LodIndices.size();
+		lod.PrimitivesTotal = state.PrimitivesTotal;
+		lod.Error = sqrt(state.Error) * state.Extent;
+		Lods.push_back(lod);
+		LodIndices.insert(LodIndices.end(), state.Indices.begin(), state.Indices.end());
+	}
+}
+
+// SelectMeshLod function: Definition
+//   This function returns the level of detail of Lods with the fewest triangles whose geometric error, projected onto the screen, is at most PixelError pixels.
+//   Distance is the distance from the camera to the nearest point of the object, in world space. ProjectionScale is the number of pixels covered by one unit of world space at a distance of one unit,
+//   i.e., half the height of the screen in pixels divided by the tangent of half the vertical field of view.
+int SelectMeshLod(const MeshLod* Lods, int LodsTotal, float Distance, float ProjectionScale, float PixelError)
+{
+	if (Distance <= 0.0f)
+		return 0;											// The camera is inside the object.
+
+	int lod = 0;
+	while (lod + 1 < LodsTotal && Lods[lod + 1].Error * ProjectionScale <= PixelError * Distance)
+		lod++;
+	return lod;
+}
@@ -0,0 +1,77 @@
+// meshSimplifier Header File
+// Version 3.1
+//
+// Description
+// Mesh simplification Header File
+// This header file contains the declarations used to simplify the triangles of OurIndices with quadric error metrics, and to build from them a chain of levels of detail (LODs), each drawn with fewer triangles than the one before,
+// together with the geometric error of each level of detail, so that the objRenderer program can draw a distant object with fewer triangles without a visible difference.
+// Include it in all source files that simplify meshes or select levels of detail, e.g., the objRenderer program.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Wavefront .obj file I/O Header File.
+// Declares the VERTEX structure and the DWORD data type, and includes the Vector Container Class.
+#include "objReader.h"
+
+// Defines.
+// The maximum number of levels of detail built by the BuildMeshLods function, including level of detail 0 (the unsimplified triangles of OurIndices).
+#define MESH_LOD_LEVELS_MAXIMUM 8
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the MeshLod 'named structure' data type.
+// A MeshLod describes one level of detail: a range of the index buffer drawn with the same vertex buffer as every other level of detail.
+// Level of detail 0 is OurIndices, at the start of the index buffer. Each following level of detail is appended to the index buffer from MeshLodIndices.
+// If the MeshLod structure is changed then MESH_CACHE_VERSION (see meshCache.h) must be incremented, because MeshLod structures are saved in the binary mesh cache file.
+struct MeshLod {
+	int FirstIndex = 0;										// The location, in the index buffer, of the first index of this level of detail.
+	int PrimitivesTotal = 0;								// The total number of triangle primitives of this level of detail. There are PrimitivesTotal * 3 indices.
+	float Error = 0.0f;										// The geometric error of this level of detail: an estimate of the largest distance, in object space, between its triangles and the triangles of level of detail 0 (see SimplifyMesh). 0.0f for level of detail 0.
+	int FirstMeshlet = 0;									// The location, in Meshlets (see meshletBuilder.h), of the first meshlet of this level of detail.
+	int MeshletsTotal = 0;									// The total number of meshlets of this level of detail. Together they cover its triangles in index buffer order.
+};
+
+// End: Structure Declarations.
+
+//***
+// External Variable Global Declarations.
+//***
+
+// MeshSimplifierLodEnabled selects whether the objRenderer program builds levels of detail with the BuildMeshLods function after parsing the Wavefront .obj file. It is true by default.
+// When it is false, MeshLods holds only level of detail 0 and the object is always drawn with every triangle of OurIndices.
+extern bool MeshSimplifierLodEnabled;
+//
+// MeshLodPixelError is the largest geometric error, in pixels on the screen, of the level of detail selected by the SelectMeshLod function. It is 1.0f by default, i.e., a simplified level of detail differs from the unsimplified triangles by at most one pixel.
+extern float MeshLodPixelError;
+//
+// MeshLods is the array of levels of detail of the object, built by the BuildMeshLods function or loaded from the binary mesh cache file. MeshLods[0] is level of detail 0, and the geometric error of each following level of detail is at least that of the one before.
+// MeshLodIndices is the array of indices of every level of detail except level of detail 0, in order. The index buffer is OurIndices followed by MeshLodIndices.
+extern std::vector<MeshLod> MeshLods;
+extern std::vector<DWORD> MeshLodIndices;
+
+// End: External Variable Global Declarations.
+
+//***
+// Global Function Declarations.
+//***
+
+int SimplifyMesh(const VERTEX* Vertices, int VertexAttributeSetsTotal, const DWORD* Indices, int PrimitivesTotal, int TargetPrimitivesTotal, std::vector<DWORD>& Result, float& ResultError);	// The SimplifyMesh function collapses edges of the triangles of Indices until at most TargetPrimitivesTotal triangles remain, or no edge can be collapsed, and returns the remaining triangles in Result and their geometric error in ResultError. It returns the number of triangles in Result.
+void BuildMeshLods(const VERTEX* Vertices, int VertexAttributeSetsTotal, const DWORD* Indices, int PrimitivesTotal, std::vector<MeshLod>& Lods, std::vector<DWORD>& LodIndices);				// The BuildMeshLods function builds the levels of detail of the triangles of Indices, each with about half the triangles of the one before.
+int SelectMeshLod(const MeshLod* Lods, int LodsTotal, float Distance, float ProjectionScale, float PixelError);																				// The SelectMeshLod function returns the level of detail with the fewest triangles whose geometric error, projected onto the screen from Distance, is at most PixelError pixels.
+
+// End: Global Function Declarations.
+
+// End: Global Declarations.
@@ -0,0 +1,121 @@
+// meshUpload
+// Version 3.1
+//
+// Description
+// These functions queue static vertex buffers and index buffers for upload to GPU memory, and plan each frame's uploads so that no frame uploads more than the frame budget of bytes.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Mesh upload manager Header File.
+// Includes the Vector Container Class and the Double-Ended Queue Container Class.
+#include "meshUpload.h"
+
+//***
+// External Variable Global Definitions.
+//***
+
+size_t MeshUploadFrameBudget = 8 * 1048576;
+
+// End: External Variable Global Definitions.
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// CreateMeshUploader function: Definition
+void CreateMeshUploader(MeshUploader& Uploader, size_t FrameBudget)
+{
+	Uploader = MeshUploader();
+	Uploader.FrameBudget = FrameBudget;
+}
+
+// MeshUploadEnqueue function: Definition
+//   A buffer no larger than the frame budget is uploaded whole, as D3D11_USAGE_IMMUTABLE; a larger buffer can only be uploaded in pieces, so it is staged.
+void MeshUploadEnqueue(MeshUploader& Uploader, int Buffer, std::vector<unsigned char>& Data)
+{
+	MeshUploadRequest request;
+	request.Buffer = Buffer;
+	request.Method = Uploader.FrameBudget == 0 || Data.size() <= Uploader.FrameBudget ? MESH_UPLOAD_IMMUTABLE : MESH_UPLOAD_STAGED;
+	request.Data.swap(Data);
+	request.Uploaded = 0;
+	Uploader.Pending.push_back(std::move(request));
+}
+
+// MeshUploadFrame function: Definition
+//   The buffers are uploaded in the order they were queued, so a buffer is never delayed by buffers queued after it.
+//   An immutable buffer that does not fit in what is left of the budget waits for the next frame, and so does every buffer after it; a staged buffer takes as much of the budget as is left.
+//   The pieces of staged buffers are placed one after the other in the staging buffer, which therefore needs to be the frame budget in size.
+void MeshUploadFrame(MeshUploader& Uploader, std::vector<MeshUploadCopy>& Copies)
+{
+	Copies.clear();
+	Uploader.Completed.clear();
+
+	size_t remaining = Uploader.FrameBudget;				// The bytes of the budget left in this frame, if it is limited.
+	size_t staged = 0;										// The bytes written to the staging buffer in this frame.
+	size_t uploaded = 0;									// The bytes uploaded in this frame.
+	while (!Uploader.Pending.empty())
+	{
+		MeshUploadRequest& request = Uploader.Pending.front();
+		size_t bufferSize = request.Data.size();
+
+		MeshUploadCopy copy;
+		copy.Buffer = request.Buffer;
+		copy.Method = request.Method;
+		copy.Create = request.Uploaded == 0;
+		copy.BufferSize = bufferSize;
+		copy.Offset = request.Uploaded;
+		copy.StagingOffset = 0;
+		if (request.Method == MESH_UPLOAD_IMMUTABLE)
+		{
+			if (Uploader.FrameBudget != 0 && bufferSize > remaining)
+				break;										// Wait for the next frame's budget.
+			copy.Size = bufferSize;
+		}
+		else
+		{
+			if (remaining == 0)
+				break;
+			copy.Size = bufferSize - request.Uploaded < remaining ? bufferSize - request.Uploaded : remaining;
+			copy.StagingOffset = staged;
+			staged += copy.Size;
+		}
+		copy.Data = request.Data.data() + copy.Offset;
+		request.Uploaded += copy.Size;
+		copy.Complete = request.Uploaded == bufferSize;
+		if (Uploader.FrameBudget != 0)
+			remaining -= copy.Size;
+		uploaded += copy.Size;
+		Copies.push_back(copy);
+
+		// Keep the data of a completed buffer until the next frame, so the uploads planned for it remain valid.
+		if (copy.Complete)
+		{
+			if (request.Method == MESH_UPLOAD_IMMUTABLE)
+				Uploader.BuffersImmutable++;
+			else
+				Uploader.BuffersStaged++;
+			Uploader.Completed.push_back(std::move(request));
+			Uploader.Pending.pop_front();
+		}
+	}
+
+	if (!Copies.empty())
+		Uploader.Frames++;
+	Uploader.Copies += Copies.size();
+	Uploader.BytesUploaded += uploaded;
+	if (uploaded > Uploader.LargestFrameBytes)
+		Uploader.LargestFrameBytes = uploaded;
+}
+
+// MeshUploadPending function: Definition
+bool MeshUploadPending(const MeshUploader& Uploader)
+{
+	return !Uploader.Pending.empty();
+}
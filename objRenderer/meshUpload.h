@@ -0,0 +1,113 @@
+// meshUpload Header File
+// Version 3.1
+//
+// Description
+// Mesh upload manager Header File
+// This header file contains the declarations used to schedule the upload of static meshes (vertex buffers and index buffers whose contents never change) to GPU memory, a limited number of bytes per frame.
+// A static buffer is best created with D3D11_USAGE_IMMUTABLE and its initial data, which lets the driver place it in memory only the GPU can read quickly, rather than D3D11_USAGE_DYNAMIC, which must stay where the CPU can write it.
+// But creating or copying many large buffers in one frame takes long enough to be seen as a hitch, so the uploads are queued and each frame uploads at most MeshUploadFrameBudget bytes, oldest first:
+//   A buffer no larger than the budget is created whole, as D3D11_USAGE_IMMUTABLE with its initial data, in the first frame with enough of the budget left.
+//   A buffer larger than the budget is created empty, as D3D11_USAGE_DEFAULT, and copied to in pieces of at most the budget, one or more frames in a row, through a staging buffer:
+//   every piece copied in a frame is written to the staging buffer with one map, then copied from it to its buffer (e.g., with the CopySubresourceRegion member function).
+// The MeshUploadFrame function only plans each frame's uploads (MeshUploadCopy structures); the calling program creates the buffers and copies the data. None of these functions use Direct3D, so the schedule can be tested, e.g., on Linux.
+// Include it in all source files that upload static meshes, e.g., the objRenderer program.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Standard Definitions.
+#include <cstddef>											// Required for the size_t data type.
+
+// Vector Container Class.
+#include <vector>											// Vector class, used to hold the data of each buffer, and to return each frame's uploads.
+
+// Double-Ended Queue Container Class.
+#include <deque>											// Deque class, used to hold the buffers not yet uploaded.
+
+//***
+// Enumeration Declarations.
+//***
+
+// The ways a buffer is uploaded.
+enum MeshUploadMethod {
+	MESH_UPLOAD_IMMUTABLE,									// Created whole with its initial data, as D3D11_USAGE_IMMUTABLE.
+	MESH_UPLOAD_STAGED										// Created empty, as D3D11_USAGE_DEFAULT, and copied to through a staging buffer.
+};
+
+// End: Enumeration Declarations.
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the MeshUploadRequest 'named structure' data type.
+// One buffer queued for upload.
+struct MeshUploadRequest {
+	int Buffer;												// The calling program's identifier of the buffer.
+	MeshUploadMethod Method;								// The way the buffer is uploaded, chosen when it is queued.
+	std::vector<unsigned char> Data;						// The contents of the buffer.
+	size_t Uploaded;										// The number of bytes, from the start of Data, already uploaded.
+};
+
+// Declare the MeshUploadCopy 'named structure' data type.
+// One upload planned by the MeshUploadFrame function: create the buffer, copy Size bytes to it at Offset, or both.
+struct MeshUploadCopy {
+	int Buffer;												// The calling program's identifier of the buffer.
+	MeshUploadMethod Method;								// The way the buffer is uploaded.
+	bool Create;											// True if the buffer must be created first: with Data as its initial data (MESH_UPLOAD_IMMUTABLE), or empty, BufferSize bytes (MESH_UPLOAD_STAGED).
+	bool Complete;											// True if this is the last upload of the buffer, i.e., the buffer may be drawn with after it.
+	size_t BufferSize;										// The size, in bytes, of the whole buffer.
+	size_t Offset;											// The location, in bytes, in the buffer of the data copied. 0 for MESH_UPLOAD_IMMUTABLE.
+	size_t Size;											// The number of bytes copied. BufferSize for MESH_UPLOAD_IMMUTABLE.
+	size_t StagingOffset;									// The location, in bytes, in the staging buffer to write the data copied to. Only used by MESH_UPLOAD_STAGED.
+	const unsigned char* Data;								// The data copied. It remains valid until the next call of the MeshUploadFrame function.
+};
+
+// Declare the MeshUploader 'named structure' data type.
+// A MeshUploader holds the buffers waiting to be uploaded, in the order they were queued.
+struct MeshUploader {
+	size_t FrameBudget = 0;									// The most bytes uploaded per frame, or 0 for no limit, e.g., while a loading screen is shown.
+	std::deque<MeshUploadRequest> Pending;					// The buffers not yet completely uploaded, oldest first.
+	std::vector<MeshUploadRequest> Completed;				// The buffers completed by the last call of the MeshUploadFrame function, kept until the next call so the data of its uploads remains valid.
+
+	unsigned long long Frames = 0;							// The number of calls of the MeshUploadFrame function that uploaded anything.
+	unsigned long long BuffersImmutable = 0;				// The number of buffers completely uploaded with each method.
+	unsigned long long BuffersStaged = 0;
+	unsigned long long Copies = 0;							// The number of uploads (MeshUploadCopy structures) planned.
+	unsigned long long BytesUploaded = 0;					// The number of bytes uploaded.
+	size_t LargestFrameBytes = 0;							// The most bytes uploaded by one frame.
+};
+
+// End: Structure Declarations.
+
+//***
+// External Variable Global Declarations.
+//***
+
+// MeshUploadFrameBudget is the most bytes of static meshes the objRenderer program uploads per frame. It is 8 MB by default. 0 uploads every queued mesh in the next frame, however large.
+extern size_t MeshUploadFrameBudget;
+
+// End: External Variable Global Declarations.
+
+//***
+// Global Function Declarations.
+//***
+
+void CreateMeshUploader(MeshUploader& Uploader, size_t FrameBudget);									// The CreateMeshUploader function sets Uploader to an empty queue that uploads at most FrameBudget bytes per frame (0 for no limit).
+void MeshUploadEnqueue(MeshUploader& Uploader, int Buffer, std::vector<unsigned char>& Data);			// The MeshUploadEnqueue function queues the upload of buffer Buffer with the contents Data, which it takes (Data is left empty).
+void MeshUploadFrame(MeshUploader& Uploader, std::vector<MeshUploadCopy>& Copies);						// The MeshUploadFrame function sets Copies to the uploads of the current frame, at most the frame budget of bytes in total, in the order they must be made.
+bool MeshUploadPending(const MeshUploader& Uploader);													// The MeshUploadPending function returns true if any buffer is not yet completely uploaded.
+
+// End: Global Function Declarations.
+
+// End: Global Declarations.
@@ -0,0 +1,248 @@
+// meshletBuilder
+// Version 3.1
+//
+// Description
+// These functions partition the triangles of an index array into meshlets (clusters) of at most MESHLET_VERTICES_MAXIMUM vertices and MESHLET_PRIMITIVES_MAXIMUM triangles, compute the bounds of each meshlet,
+// and cull whole meshlets on the CPU before an instance of the object is drawn, so that the GPU is not given triangles that are outside the viewing frustum or that face away from the camera.
+//
+// A meshlet is a run of consecutive triangles of the index buffer, which, once the triangles are ordered for the post-transform vertex cache, is a compact patch of the surface with a small bounding sphere and a narrow normal cone.
+// Culling tests each meshlet's bounding sphere against the six planes of the viewing frustum, four planes at a time with DirectXMath vector functions, and its normal cone against the direction to the camera.
+// Neither test uses Direct3D, so CullMeshlets can be called (and tested) without a device.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Meshlet (cluster) Header File.
+#include "meshletBuilder.h"
+
+// Vector Container Class.
+#include <vector>											// Vector class member functions push_back, assign, data, etc.
+
+// Algorithm Functions.
+#include <algorithm>										// Algorithm functions min, max.
+
+// Mathematical Functions.
+#include <cmath>											// Mathematical functions sqrt.
+
+// Using Declarations and Directives.
+using std::vector;
+using std::min;
+using std::max;
+using std::sqrt;
+
+//***
+// External Variable Global Definitions.
+//***
+
+bool MeshletCullingEnabled = true;
+vector<Meshlet> Meshlets;
+MeshletCullStatistics MeshletCulling;
+
+// End: External Variable Global Definitions.
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// MeshletNewVertices function: Definition
+//   This function returns the number of distinct vertices of the triangle Triangle (three indices) that are not yet in the meshlet Stamp, i.e., whose VertexStamp is not Stamp.
+static int MeshletNewVertices(const DWORD* Triangle, const vector<int>& VertexStamp, int Stamp)
+{
+	int count = 0;
+	for (int i = 0; i < 3; i++)
+		if (VertexStamp[Triangle[i]] != Stamp && (i < 1 || Triangle[i] != Triangle[0]) && (i < 2 || Triangle[i] != Triangle[1]))
+			count++;
+	return count;
+}
+
+// MeshletComputeBounds function: Definition
+//   This function computes the bounding sphere, axis-aligned bounding box, and normal cone of Result from its PrimitivesTotal triangles, Indices.
+//   The normal cone is the one used by meshoptimizer (Arseny Kapoulkine): its axis is the area-weighted average of the triangle normals, and its apex is the point on the axis behind the plane of every triangle,
+//   so that a camera sees the back of every triangle whenever the direction from the camera to the apex is within the cone.
+static void MeshletComputeBounds(const VERTEX* Vertices, const DWORD* Indices, int PrimitivesTotal, Meshlet& Result)
+{
+	// The axis-aligned bounding box, and the bounding sphere around its center.
+	XMVECTOR minimum = XMLoadFloat3(&Vertices[Indices[0]].GeometricVertex);
+	XMVECTOR maximum = minimum;
+	for (int i = 1; i < PrimitivesTotal * 3; i++)
+	{
+		XMVECTOR p = XMLoadFloat3(&Vertices[Indices[i]].GeometricVertex);
+		minimum = XMVectorMin(minimum, p);
+		maximum = XMVectorMax(maximum, p);
+	}
+	XMVECTOR center = XMVectorScale(XMVectorAdd(minimum, maximum), 0.5f);
+	XMVECTOR radius = XMVectorZero();
+	for (int i = 0; i < PrimitivesTotal * 3; i++)
+		radius = XMVectorMax(radius, XMVector3LengthSq(XMVectorSubtract(XMLoadFloat3(&Vertices[Indices[i]].GeometricVertex), center)));
+	XMStoreFloat3(&Result.BoundsMinimum, minimum);
+	XMStoreFloat3(&Result.BoundsMaximum, maximum);
+	XMStoreFloat3(&Result.Center, center);
+	Result.Radius = XMVectorGetX(XMVectorSqrt(radius));
+
+	// The axis of the normal cone. The length of the cross product of two edges of a triangle is twice its area.
+	XMVECTOR axis = XMVectorZero();
+	for (int t = 0; t < PrimitivesTotal; t++)
+	{
+		XMVECTOR p0 = XMLoadFloat3(&Vertices[Indices[t * 3 + 0]].GeometricVertex);
+		XMVECTOR p1 = XMLoadFloat3(&Vertices[Indices[t * 3 + 1]].GeometricVertex);
+		XMVECTOR p2 = XMLoadFloat3(&Vertices[Indices[t * 3 + 2]].GeometricVertex);
+		axis = XMVectorAdd(axis, XMVector3Cross(XMVectorSubtract(p1, p0), XMVectorSubtract(p2, p0)));
+	}
+	Result.ConeApex = Result.Center;
+	Result.ConeAxis = XMFLOAT3(0.0f, 0.0f, 0.0f);
+	Result.ConeCutoff = 1.0f;								// Never culled as facing away, unless a narrower cone is found below.
+	if (XMVectorGetX(XMVector3LengthSq(axis)) <= 0.0f)
+		return;												// The triangles face in no average direction, e.g., they are all degenerate.
+	axis = XMVector3Normalize(axis);
+
+	// The spread of the normal cone: the smallest cosine of the angle between the axis and a triangle normal.
+	// The apex: the point furthest along the axis behind the center that is behind the plane of every triangle.
+	float spread = 1.0f;
+	float apexDistance = 0.0f;
+	for (int t = 0; t < PrimitivesTotal; t++)
+	{
+		XMVECTOR p0 = XMLoadFloat3(&Vertices[Indices[t * 3 + 0]].GeometricVertex);
+		XMVECTOR p1 = XMLoadFloat3(&Vertices[Indices[t * 3 + 1]].GeometricVertex);
+		XMVECTOR p2 = XMLoadFloat3(&Vertices[Indices[t * 3 + 2]].GeometricVertex);
+		XMVECTOR normal = XMVector3Cross(XMVectorSubtract(p1, p0), XMVectorSubtract(p2, p0));
+		if (XMVectorGetX(XMVector3LengthSq(normal)) <= 0.0f)
+			continue;										// A degenerate triangle is never drawn, and has no normal.
+		normal = XMVector3Normalize(normal);
+		float cosine = XMVectorGetX(XMVector3Dot(normal, axis));
+		spread = min(spread, cosine);
+		if (cosine > 0.0f)
+			apexDistance = max(apexDistance, XMVectorGetX(XMVector3Dot(XMVectorSubtract(center, p0), normal)) / cosine);
+	}
+	if (spread < MESHLET_CONE_MINIMUM_SPREAD)
+		return;
+
+	XMStoreFloat3(&Result.ConeAxis, axis);
+	XMStoreFloat3(&Result.ConeApex, XMVectorSubtract(center, XMVectorScale(axis, apexDistance)));
+	Result.ConeCutoff = sqrt(1.0f - spread * spread);		// The sine of the angle between the axis and the triangle normal furthest from it.
+}
+
+// MeshletAppend function: Definition
+//   This function appends to Meshlets the meshlet of PrimitivesTotal triangles, Indices, found at FirstIndex in the index buffer.
+static void MeshletAppend(const VERTEX* Vertices, const DWORD* Indices, int FirstIndex, int PrimitivesTotal, int VerticesTotal, vector<Meshlet>& Meshlets)
+{
+	Meshlet meshlet;
+	meshlet.FirstIndex = FirstIndex;
+	meshlet.PrimitivesTotal = PrimitivesTotal;
+	meshlet.VerticesTotal = VerticesTotal;
+	MeshletComputeBounds(Vertices, Indices, PrimitivesTotal, meshlet);
+	Meshlets.push_back(meshlet);
+}
+
+// BuildMeshlets function: Definition
+//   This function partitions the PrimitivesTotal triangles of Indices, which are found at FirstIndex in the index buffer, into meshlets of at most MESHLET_VERTICES_MAXIMUM vertices and MESHLET_PRIMITIVES_MAXIMUM triangles,
+//   appended to Meshlets in index buffer order. Each meshlet is the longest run of consecutive triangles that fits, so the triangles are neither reordered nor changed.
+//   The triangles should first be reordered by the OptimizeVertexCache function: it draws neighboring triangles one after another, so a run of consecutive triangles is a compact patch of the surface,
+//   as compact as a meshlet grown triangle by triangle from its neighbors (which would reorder the triangles and lose some of the vertex cache reuse).
+void BuildMeshlets(const VERTEX* Vertices, int VertexAttributeSetsTotal, const DWORD* Indices, int FirstIndex, int PrimitivesTotal, vector<Meshlet>& Meshlets)
+{
+	if (PrimitivesTotal <= 0)
+		return;
+
+	vector<int> vertexStamp(VertexAttributeSetsTotal, -1);	// The meshlet that most recently referenced each vertex.
+	int stamp = 0;											// The current meshlet.
+	int verticesTotal = 0;									// The total number of distinct vertices of the current meshlet.
+	int begin = 0;											// The first triangle of the current meshlet.
+
+	for (int t = 0; t < PrimitivesTotal; t++)
+	{
+		int added = MeshletNewVertices(&Indices[t * 3], vertexStamp, stamp);
+		if (t - begin == MESHLET_PRIMITIVES_MAXIMUM || verticesTotal + added > MESHLET_VERTICES_MAXIMUM)
+		{
+			// The triangle does not fit: end the current meshlet, and begin a new meshlet with the triangle.
+			MeshletAppend(Vertices, &Indices[begin * 3], FirstIndex + begin * 3, t - begin, verticesTotal, Meshlets);
+			begin = t;
+			stamp++;
+			verticesTotal = 0;
+			added = MeshletNewVertices(&Indices[t * 3], vertexStamp, stamp);
+		}
+		verticesTotal += added;
+		for (int i = 0; i < 3; i++)
+			vertexStamp[Indices[t * 3 + i]] = stamp;
+	}
+	MeshletAppend(Vertices, &Indices[begin * 3], FirstIndex + begin * 3, PrimitivesTotal - begin, verticesTotal, Meshlets);
+}
+
+// ExtractFrustumPlanes function: Definition
+//   This function finds the six planes of the viewing frustum of matFinal, in the space that matFinal projects from (object space for the combined world, view, and projection matrix of an instance, or world space for the combined view and projection matrix),
+//   directly from matFinal (Gil Gribb and Klaus Hartmann, "Fast Extraction of Viewing Frustum Planes from the World-View-Projection Matrix"), so no bounds need to be transformed to test them.
+//   Each plane is scaled so that its normal is a unit vector pointing into the frustum, i.e., (x, y, z, 1) . plane is the distance of a point in front of it.
+void ExtractFrustumPlanes(FXMMATRIX matFinal, XMVECTOR Planes[6])
+{
+	// A point projected by matFinal is inside the frustum if -w <= x <= w, -w <= y <= w, and 0 <= z <= w, so each plane is a sum or difference of two columns of matFinal, i.e., rows of its transpose.
+	XMMATRIX columns = XMMatrixTranspose(matFinal);
+	Planes[0] = XMPlaneNormalize(XMVectorAdd(columns.r[3], columns.r[0]));		// Left.
+	Planes[1] = XMPlaneNormalize(XMVectorSubtract(columns.r[3], columns.r[0]));	// Right.
+	Planes[2] = XMPlaneNormalize(XMVectorAdd(columns.r[3], columns.r[1]));		// Bottom.
+	Planes[3] = XMPlaneNormalize(XMVectorSubtract(columns.r[3], columns.r[1]));	// Top.
+	Planes[4] = XMPlaneNormalize(columns.r[2]);									// Near.
+	Planes[5] = XMPlaneNormalize(XMVectorSubtract(columns.r[3], columns.r[2]));	// Far.
+}
+
+// CullMeshlets function: Definition
+//   This function tests each of the MeshletsTotal meshlets of Meshlets, in index buffer order, and appends each range of consecutive meshlets that are not culled to Runs (which is first emptied).
+//   A meshlet is culled if:
+//   - Its bounding sphere is entirely outside one of the six planes of the viewing frustum of matFinal (the combined world, view, and projection matrix of the instance), or
+//   - Its normal cone shows that every one of its triangles faces away from EyePosition, the position of the camera in object space, and so would be culled by the rasterizer.
+//   The planes are found in object space (see the ExtractFrustumPlanes function), so no bounds are transformed.
+//   The counts of meshlets and triangles tested, culled, and drawn are added to Statistics. It returns the number of runs.
+int CullMeshlets(const Meshlet* Meshlets, int MeshletsTotal, FXMMATRIX matFinal, FXMVECTOR EyePosition, vector<MeshletRun>& Runs, MeshletCullStatistics& Statistics)
+{
+	Runs.clear();
+
+	XMVECTOR planes[6];
+	ExtractFrustumPlanes(matFinal, planes);
+
+	// Transpose the planes, so that each vector holds the same component of four planes, and the distances from a point to four planes are found together.
+	// The second set of four repeats the near and far planes.
+	XMMATRIX planes0123 = XMMatrixTranspose(XMMATRIX(planes[0], planes[1], planes[2], planes[3]));
+	XMMATRIX planes4545 = XMMatrixTranspose(XMMATRIX(planes[4], planes[5], planes[4], planes[5]));
+
+	for (int m = 0; m < MeshletsTotal; m++)
+	{
+		const Meshlet& meshlet = Meshlets[m];
+		Statistics.MeshletsTested++;
+		Statistics.PrimitivesTested += meshlet.PrimitivesTotal;
+
+		// The frustum test: the sphere is outside if its center is further than its radius behind any plane.
+		XMVECTOR x = XMVectorReplicate(meshlet.Center.x);
+		XMVECTOR y = XMVectorReplicate(meshlet.Center.y);
+		XMVECTOR z = XMVectorReplicate(meshlet.Center.z);
+		XMVECTOR negativeRadius = XMVectorReplicate(-meshlet.Radius);
+		XMVECTOR distance0123 = XMVectorMultiplyAdd(x, planes0123.r[0], XMVectorMultiplyAdd(y, planes0123.r[1], XMVectorMultiplyAdd(z, planes0123.r[2], planes0123.r[3])));
+		XMVECTOR distance4545 = XMVectorMultiplyAdd(x, planes4545.r[0], XMVectorMultiplyAdd(y, planes4545.r[1], XMVectorMultiplyAdd(z, planes4545.r[2], planes4545.r[3])));
+		if (!XMVector4GreaterOrEqual(distance0123, negativeRadius) || !XMVector4GreaterOrEqual(distance4545, negativeRadius))
+		{
+			Statistics.MeshletsOutsideFrustum++;
+			continue;
+		}
+
+		// The normal cone test: every triangle faces away from the camera if the direction from the camera to the apex is within the cone.
+		XMVECTOR apexDirection = XMVectorSubtract(XMLoadFloat3(&meshlet.ConeApex), EyePosition);
+		if (XMVector3Greater(XMVector3Dot(apexDirection, XMLoadFloat3(&meshlet.ConeAxis)), XMVectorScale(XMVector3Length(apexDirection), meshlet.ConeCutoff)))
+		{
+			Statistics.MeshletsFacingAway++;
+			continue;
+		}
+
+		// Draw the meshlet, with the meshlet before it if that is drawn too.
+		Statistics.PrimitivesDrawn += meshlet.PrimitivesTotal;
+		if (!Runs.empty() && Runs.back().FirstIndex + Runs.back().PrimitivesTotal * 3 == meshlet.FirstIndex)
+			Runs.back().PrimitivesTotal += meshlet.PrimitivesTotal;
+		else
+			Runs.push_back({ meshlet.FirstIndex, meshlet.PrimitivesTotal });
+	}
+
+	Statistics.Runs += (int)Runs.size();
+	return (int)Runs.size();
+}
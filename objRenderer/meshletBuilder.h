@@ -0,0 +1,103 @@
+// meshletBuilder Header File
+// Version 3.1
+//
+// Description
+// Meshlet (cluster) Header File
+// This header file contains the declarations used to partition the triangles of OurIndices, and of each level of detail, into meshlets: small clusters of at most MESHLET_VERTICES_MAXIMUM vertices and MESHLET_PRIMITIVES_MAXIMUM triangles,
+// each with a bounding sphere, an axis-aligned bounding box, and a normal cone, and to cull whole meshlets that are outside the viewing frustum or face away from the camera before they are drawn.
+// Include it in all source files that build or cull meshlets, e.g., the objRenderer program.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Wavefront .obj file I/O Header File.
+// Declares the VERTEX structure and the DWORD data type, and includes the DirectXMath Header File and the Vector Container Class.
+#include "objReader.h"
+
+// Defines.
+// The largest number of vertices and triangles of one meshlet. These are the sizes commonly used for meshlets, which keep a meshlet small enough that its normal cone is narrow.
+#define MESHLET_VERTICES_MAXIMUM 64
+#define MESHLET_PRIMITIVES_MAXIMUM 124
+//
+// A meshlet's normal cone is not used for culling if the cosine of the angle between its axis and the triangle normal furthest from it is less than this, i.e., its triangles face in almost every direction.
+#define MESHLET_CONE_MINIMUM_SPREAD 0.1f
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the Meshlet 'named structure' data type.
+// A Meshlet is a range of consecutive triangles of the index buffer, together with the bounds used to cull it. All bounds are in object space.
+// The normal cone contains the normal of every triangle of the meshlet: every triangle faces away from a camera at EyePosition if dot(normalize(ConeApex - EyePosition), ConeAxis) > ConeCutoff.
+// If the Meshlet structure is changed then MESH_CACHE_VERSION (see meshCache.h) must be incremented, because Meshlet structures are saved in the binary mesh cache file.
+struct Meshlet {
+	XMFLOAT3 Center;										// The center of the bounding sphere.
+	float Radius;											// The radius of the bounding sphere.
+	XMFLOAT3 BoundsMinimum;									// The minimum corner of the axis-aligned bounding box.
+	XMFLOAT3 BoundsMaximum;									// The maximum corner of the axis-aligned bounding box.
+	XMFLOAT3 ConeApex;										// The apex of the normal cone, on the axis behind the triangles of the meshlet.
+	XMFLOAT3 ConeAxis;										// The unit axis of the normal cone, i.e., the average direction the triangles of the meshlet face, or (0, 0, 0) if they face in no average direction.
+	float ConeCutoff;										// The sine of the angle between the axis and the triangle normal furthest from it, or 1.0f if the meshlet is never culled as facing away (its triangles face in too many directions).
+	int FirstIndex;											// The location, in the index buffer, of the first index of the meshlet.
+	int PrimitivesTotal;									// The total number of triangle primitives of the meshlet. There are PrimitivesTotal * 3 indices.
+	int VerticesTotal;										// The total number of distinct vertices referenced by the meshlet.
+};
+
+// Declare the MeshletRun 'named structure' data type.
+// A range of consecutive triangles of the index buffer drawn by one DrawIndexed call: one or more consecutive meshlets that were not culled.
+struct MeshletRun {
+	int FirstIndex;											// The location, in the index buffer, of the first index to draw.
+	int PrimitivesTotal;									// The total number of triangle primitives to draw.
+};
+
+// Declare the MeshletCullStatistics 'named structure' data type.
+// How many meshlets and triangles were tested, culled, and drawn by the CullMeshlets function.
+struct MeshletCullStatistics {
+	int MeshletsTested = 0;									// The number of meshlets tested.
+	int MeshletsOutsideFrustum = 0;							// The number of meshlets culled because their bounding sphere is outside the viewing frustum.
+	int MeshletsFacingAway = 0;								// The number of meshlets culled because all their triangles face away from the camera.
+	int PrimitivesTested = 0;								// The number of triangles of the meshlets tested.
+	int PrimitivesDrawn = 0;								// The number of triangles of the meshlets not culled.
+	int Runs = 0;											// The number of ranges of the index buffer to draw, i.e., DrawIndexed calls.
+};
+
+// End: Structure Declarations.
+
+//***
+// External Variable Global Declarations.
+//***
+
+// MeshletCullingEnabled selects whether the objRenderer program culls meshlets before drawing an instance of the object. It is true by default.
+// When it is false, every triangle of the selected level of detail is drawn with one DrawIndexed call, as before meshlets were built.
+extern bool MeshletCullingEnabled;
+//
+// Meshlets is the array of meshlets of every level of detail of the object, built by the BuildMeshlets function or loaded from the binary mesh cache file.
+// The meshlets of level of detail l are Meshlets[MeshLods[l].FirstMeshlet] to Meshlets[MeshLods[l].FirstMeshlet + MeshLods[l].MeshletsTotal - 1], in index buffer order.
+extern std::vector<Meshlet> Meshlets;
+//
+// MeshletCulling is the MeshletCullStatistics of every instance of the object drawn in the most recent frame.
+extern MeshletCullStatistics MeshletCulling;
+
+// End: External Variable Global Declarations.
+
+//***
+// Global Function Declarations.
+//***
+
+void BuildMeshlets(const VERTEX* Vertices, int VertexAttributeSetsTotal, const DWORD* Indices, int FirstIndex, int PrimitivesTotal, std::vector<Meshlet>& Meshlets);	// The BuildMeshlets function partitions the triangles of Indices, which are found at FirstIndex in the index buffer, into meshlets of consecutive triangles appended to Meshlets.
+void ExtractFrustumPlanes(FXMMATRIX matFinal, XMVECTOR Planes[6]);																												// The ExtractFrustumPlanes function finds the six planes of the viewing frustum of matFinal, in the space matFinal projects from.
+int CullMeshlets(const Meshlet* Meshlets, int MeshletsTotal, FXMMATRIX matFinal, FXMVECTOR EyePosition, std::vector<MeshletRun>& Runs, MeshletCullStatistics& Statistics);				// The CullMeshlets function culls the meshlets outside the viewing frustum of matFinal, or facing away from EyePosition (in object space), and returns the ranges of the index buffer to draw in Runs. It returns the number of runs.
+
+// End: Global Function Declarations.
+
+// End: Global Declarations.
@@ -2,7 +2,8 @@
 // Version 3.1
 //
 // Description
-// This function parses a Wavefront .obj file for a single 3D object's descriptive information and assigns it to the external global variables used by the calling program when rendering the object.
+// These functions parse a Wavefront .obj file for a single 3D object's descriptive information.
+// The LoadObj function returns it in a Mesh, and the objReader function assigns it to the external global variables used by the calling program when rendering the object.
 //
 // Authorship
 // Robert John Tortorelli
@@ -27,6 +28,35 @@
 // String stream class member functions.
 #include <sstream>											// String stream class member functions getline, etc.
 
+// Unordered Map Container Class.
+#include <unordered_map>									// Unordered map class member functions find, emplace, reserve, etc. A hash table providing constant time lookup.
+
+// Memory Functions.
+#include <cstring>											// Memory functions memcpy, memchr.
+
+// Character Conversion Functions.
+#include <charconv>											// Character conversion function from_chars.
+#include <system_error>										// Error code enumeration errc, returned by from_chars.
+
+// Thread Class.
+#include <thread>											// Thread class member functions join, hardware_concurrency, etc.
+#include <functional>										// Function ref, used to pass a reference to a thread function.
+
+// Polymorphic Memory Resources.
+#include <memory_resource>									// Memory resource classes monotonic_buffer_resource, new_delete_resource, etc., and the containers pmr::unordered_map, etc. that allocate from them.
+
+// Steady Clock.
+#include <chrono>											// Steady clock, used to time the phases of parsing (LoadObjStatistics).
+
+// File System Functions.
+#include <filesystem>										// File system function file_size.
+
+// Read-only memory-mapped file I/O Header File.
+#include "mappedFile.h"
+
+// Process memory usage Header File.
+#include "processMemory.h"
+
 // Using Declarations and Directives.
 // Using declarations such as using std::string;   bring one identifier	 in the named namespace into scope.
 // Using directives	  such as using namespace std; bring all identifiers in the named namespace into scope.
@@ -39,6 +69,18 @@ using std::stof;
 using std::string;
 using std::vector;
 using std::istringstream;
+using std::streamoff;
+using std::unordered_map;
+using std::memcpy;
+using std::memchr;
+using std::from_chars;
+using std::from_chars_result;
+using std::errc;
+using std::thread;
+using std::error_code;
+namespace pmr = std::pmr;
+namespace chrono = std::chrono;
+namespace fs = std::filesystem;
 
 //***
 // External Variable Global Definitions.
@@ -48,23 +90,143 @@ using std::istringstream;
 // See the associated header file for declarations and descriptions of these external variables.
 vector<VERTEX> OurVertices;	int OurVerticesi = -1;	int VertexAttributeSetsTotal = 0;
 vector<DWORD> OurIndices;	int OurIndicesi = -1;	int PrimitivesTotal = 0;
+bool objReaderDedupByAttributes = true;
+const char* objReaderFileName = "Text.obj";
+bool objReaderMemoryMapped = true;
+int objReaderThreads = 0;
+size_t objReaderMinimumChunkBytes = 1 << 20;
+LoadObjStatistics objReaderStatistics;
 
 // End: External Variable Global Definitions.
 
-// Declare variables used to parse the Wavefront .obj file.
-// Intermediate arrays to temporarily store all vertex attributes before they are copied to the array variable OurVertices:
-//   Each intermediate array is a one-dimensional array of structures, where each array element (each structure) contains vertex attributes of a given type for one vertex.
-//   v  is the intermediate array of structures for geometric vertices,			where each structure contains three floating-point values (x, y, z).
-//   vt is the intermediate array of structures for vertex texture coordinates, where each structure contains two   floating-point values (x, y; usually named U, V in computer graphics).
-//   vn is the intermediate array of structures for vertex normal vectors,		where each structure contains three floating-point values (x, y, z).
-//   Each intermediate array is indexed by a variable, vi, vni, or vti, initialized to -1, that is incremented by 1 each time a new vertex attribute is stored in the intermediate array.
-vector<XMFLOAT3> v;  int vi = -1;							// Geometric vertices		  dynamically allocated intermediate array, and index (v[vi]).
-vector<XMFLOAT2> vt; int vti = -1;							// Vertex texture coordinates dynamically allocated intermediate array, and index (vt[vti]).
-vector<XMFLOAT3> vn; int vni = -1;							// Vertex normal vectors	  dynamically allocated intermediate array, and index (vn[vni]).
-// Intermediate array variable OurIndicesFaceTriplet temporarily stores three indices of array variable OurVertices. Each index is derived from one of the three face element triplets in a face element statement (e.g., v1/vt1/vn1) that represent the set of vertex attributes for one of the three vertices of a triangle.
-// The three indices are stored in the counter-clockwise drawing order specified by the order of face element statements in the Wavefront .obj file. These indices will be converted to the clockwise drawing order used by DirectX, and then stored in the array variable OurIndices.
-int OurIndicesFaceTriplet[3];
-int OurIndicesFaceTripleti;									// The index variable OurIndicesFaceTripleti of intermediate array variable OurIndicesFaceTriplet[OurIndicesFaceTripleti].
+// Hash tables used to test whether a candidate set of vertex attributes is unique, i.e., has this set of vertex attributes been previously found in the Wavefront .obj file and stored in array variable OurVertices?
+// Each hash table maps a key to the index of the element of array variable OurVertices that was first stored for that key. A lookup takes constant time, so the Wavefront .obj file is parsed in time proportional to the number of face element triplets,
+// rather than in time proportional to the number of face element triplets multiplied by the number of unique sets of vertex attributes, as it would be if array variable OurVertices were searched element by element.
+//
+// OurVerticesByFaceTriplet is keyed by the face element triplet (fv, fvt, fvn) itself. An identical face element triplet always refers to an identical set of vertex attributes, so a face element triplet found in this hash table needs no further test.
+// OurVerticesByAttributes  is keyed by the set of vertex attributes after conversion to the DirectX format. It is only searched when the face element triplet has not been previously found.
+//   Two different face element triplets can still refer to an identical set of vertex attributes when the Wavefront .obj file contains duplicate vertex attribute statements, and such sets of vertex attributes must be merged exactly as the element by element search merged them.
+//   Set LoadObjOptions::DedupByAttributes to false to skip this hash table when the vertex attribute statements of the Wavefront .obj file are known to be unique, in which case OurVertices and OurIndices are unchanged and parsing is faster.
+// A set of vertex attributes containing a NaN is not equal (==) to any set of vertex attributes, not even itself, so the element by element search never merged it, even with the set of vertex attributes of the same face element triplet.
+// Neither hash table remembers it, so each occurrence of its face element triplet is stored as a new set of vertex attributes, as before.
+struct FaceTripletKey {										// Face element triplet (fv, fvt, fvn), with the face element indices already adjusted to the C++ format.
+	int fv;
+	int fvt;
+	int fvn;
+	bool operator==(const FaceTripletKey& other) const { return fv == other.fv && fvt == other.fvt && fvn == other.fvn; }
+};
+struct FaceTripletKeyHash {
+	size_t operator()(const FaceTripletKey& key) const
+	{
+		// Combine the three face element indices into one 64-bit value and mix its bits, so that neighboring face element triplets are spread across the hash table.
+		unsigned long long h = (unsigned long long)(unsigned int)key.fv;
+		h = h * 0x9E3779B97F4A7C15ULL + (unsigned int)key.fvt;
+		h = h * 0x9E3779B97F4A7C15ULL + (unsigned int)key.fvn;
+		h ^= h >> 29;
+		return (size_t)h;
+	}
+};
+struct VertexAttributesHash {
+	size_t operator()(const VERTEX& vertex) const
+	{
+		// Hash the eight floating-point values of the set of vertex attributes.
+		// Adding 0.0f converts -0.0f to 0.0f, because -0.0f == 0.0f is true and both must therefore produce the same hash value.
+		const float values[8] = { vertex.GeometricVertex.x, vertex.GeometricVertex.y, vertex.GeometricVertex.z,
+								  vertex.VertexNormalVector.x, vertex.VertexNormalVector.y, vertex.VertexNormalVector.z,
+								  vertex.VertexTextureCoordinate.x, vertex.VertexTextureCoordinate.y };
+		unsigned long long h = 0xCBF29CE484222325ULL;
+		for (int i = 0; i <= 7; i++)
+		{
+			float value = values[i] + 0.0f;
+			unsigned int bits;
+			memcpy(&bits, &value, sizeof(bits));
+			h = (h ^ bits) * 0x100000001B3ULL;
+		}
+		return (size_t)(h ^ (h >> 32));
+	}
+};
+struct VertexAttributesEqual {
+	bool operator()(const VERTEX& a, const VERTEX& b) const
+	{
+		// The same comparison (==) of each floating-point value that was previously used to search array variable OurVertices element by element.
+		return a.GeometricVertex.x == b.GeometricVertex.x && a.GeometricVertex.y == b.GeometricVertex.y && a.GeometricVertex.z == b.GeometricVertex.z &&
+			   a.VertexTextureCoordinate.x == b.VertexTextureCoordinate.x && a.VertexTextureCoordinate.y == b.VertexTextureCoordinate.y &&
+			   a.VertexNormalVector.x == b.VertexNormalVector.x && a.VertexNormalVector.y == b.VertexNormalVector.y && a.VertexNormalVector.z == b.VertexNormalVector.z;
+	}
+};
+
+// The estimated average size, in bytes, of one statement of a Wavefront .obj file, e.g., "v 0.500000 -0.500000 0.500000" or "f 1/1/1 2/2/1 3/3/1".
+// Used by the objReaderParseStream function to reserve memory from the size of the Wavefront .obj file, assuming that a quarter of the statements are of each of the four supported types (v, vt, vn, and f).
+// It is deliberately larger than the average, so that memory is not reserved that will not be used; an array that needs more memory than reserved grows as usual.
+static const size_t objReaderStatementBytesEstimate = 32;
+
+// Declare the objReaderArenaUpstream class.
+// The memory resource from which the arena of an objReaderState obtains memory. It obtains memory with the global operator new, and counts the bytes obtained (LoadObjStatistics::ArenaBytes).
+class objReaderArenaUpstream : public pmr::memory_resource {
+public:
+	size_t Bytes = 0;										// The total number of bytes obtained.
+
+private:
+	void* do_allocate(size_t bytes, size_t alignment) override { Bytes += bytes; return pmr::new_delete_resource()->allocate(bytes, alignment); }
+	void do_deallocate(void* p, size_t bytes, size_t alignment) override { pmr::new_delete_resource()->deallocate(p, bytes, alignment); }
+	bool do_is_equal(const pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+// Declare the objReaderState 'named structure' data type.
+// An objReaderState holds all variables used to parse one Wavefront .obj file. Each call of the LoadObj function declares its own objReaderState, so no variable used while parsing is shared between calls,
+// and any number of Wavefront .obj files can be parsed at the same time by different threads.
+// Within the functions that parse a Wavefront .obj file, OurVertices and OurIndices refer to the Vertices and Indices of the Mesh being loaded, not to the external global variables of the same name.
+struct objReaderState {
+	objReaderState(const LoadObjOptions& options, Mesh& result) : Options(options), OurVertices(result.Vertices), OurIndices(result.Indices) {}
+
+	const LoadObjOptions& Options;							// The options the Wavefront .obj file is loaded with.
+	vector<VERTEX>& OurVertices;							// The array of unique sets of vertex attributes of the Mesh being loaded.
+	int OurVerticesi = -1;									// The index variable OurVerticesi of array variable OurVertices[OurVerticesi].
+	vector<DWORD>& OurIndices;								// The array of indices of the Mesh being loaded.
+	int OurIndicesi = -1;									// The index variable OurIndicesi of array variable OurIndices[OurIndicesi].
+
+	// Declare variables used to parse the Wavefront .obj file.
+	// Intermediate arrays to temporarily store all vertex attributes before they are copied to the array variable OurVertices:
+	//   Each intermediate array is a one-dimensional array of structures, where each array element (each structure) contains vertex attributes of a given type for one vertex.
+	//   v  is the intermediate array of structures for geometric vertices,			where each structure contains three floating-point values (x, y, z).
+	//   vt is the intermediate array of structures for vertex texture coordinates, where each structure contains two   floating-point values (x, y; usually named U, V in computer graphics).
+	//   vn is the intermediate array of structures for vertex normal vectors,		where each structure contains three floating-point values (x, y, z).
+	//   Each intermediate array is indexed by a variable, vi, vni, or vti, initialized to -1, that is incremented by 1 each time a new vertex attribute is stored in the intermediate array.
+	vector<XMFLOAT3> v;  int vi = -1;						// Geometric vertices		  dynamically allocated intermediate array, and index (v[vi]).
+	vector<XMFLOAT2> vt; int vti = -1;						// Vertex texture coordinates dynamically allocated intermediate array, and index (vt[vti]).
+	vector<XMFLOAT3> vn; int vni = -1;						// Vertex normal vectors	  dynamically allocated intermediate array, and index (vn[vni]).
+	// Intermediate array variable OurIndicesFaceTriplet temporarily stores three indices of array variable OurVertices. Each index is derived from one of the three face element triplets in a face element statement (e.g., v1/vt1/vn1) that represent the set of vertex attributes for one of the three vertices of a triangle.
+	// The three indices are stored in the counter-clockwise drawing order specified by the order of face element statements in the Wavefront .obj file. These indices will be converted to the clockwise drawing order used by DirectX, and then stored in the array variable OurIndices.
+	int OurIndicesFaceTriplet[3];
+	int OurIndicesFaceTripleti;								// The index variable OurIndicesFaceTripleti of intermediate array variable OurIndicesFaceTriplet[OurIndicesFaceTripleti].
+
+	// The arena holding the hash tables.
+	// A hash table allocates one small block of memory per element. The arena hands these out sequentially from large blocks, and never frees them individually: all of them are freed at once when the objReaderState is destroyed, i.e., when the LoadObj function returns.
+	// The arena must be declared before the hash tables, so that it is destroyed after them.
+	objReaderArenaUpstream ArenaUpstream;
+	pmr::monotonic_buffer_resource Arena{ &ArenaUpstream };
+
+	// Hash tables used to test whether a candidate set of vertex attributes is unique (see above).
+	pmr::unordered_map<FaceTripletKey, int, FaceTripletKeyHash> OurVerticesByFaceTriplet{ &Arena };
+	pmr::unordered_map<VERTEX, int, VertexAttributesHash, VertexAttributesEqual> OurVerticesByAttributes{ &Arena };
+
+	// Statistics.
+	size_t FileBytes = 0;									// See LoadObjStatistics.
+	size_t IntermediateBytes = 0;							// See LoadObjStatistics.
+	double IoSeconds = 0.0;									// See LoadObjStatistics.
+	double TokenizeSeconds = 0.0;							// See LoadObjStatistics.
+	double MergeSeconds = 0.0;								// See LoadObjStatistics.
+	double FacesSeconds = 0.0;								// See LoadObjStatistics.
+};
+
+// Return the time, in seconds, since Start, and set Start to the current time, so that consecutive phases are timed by consecutive calls.
+static double objReaderLap(chrono::steady_clock::time_point& Start)
+{
+	chrono::steady_clock::time_point now = chrono::steady_clock::now();
+	double seconds = chrono::duration<double>(now - Start).count();
+	Start = now;
+	return seconds;
+}
 
 // End: Global Declarations.
 
@@ -72,29 +234,183 @@ int OurIndicesFaceTripleti;									// The index variable OurIndicesFaceTripleti
 // Function Definitions.
 //***
 
-// objReader function: Definition
-int objReader(void)
+// objReaderFaceTriplet function: Definition
+//   This function processes one face element triplet (fv, fvt, fvn), with the face element indices already adjusted to the C++ format.
+//   It stores the associated set of vertex attributes in array variable OurVertices if it is unique, appends a new element to array variable OurIndices, and stores the index of the associated element of array variable OurVertices in intermediate array variable OurIndicesFaceTriplet.
+static void objReaderFaceTriplet(objReaderState& state, int fv, int fvt, int fvn)
 {
-	ifstream obj;											// Declare the input file stream object representing the Wavefront .obj file.
-	string stringtext;										// Holds one statement of the input file stream object representing the Wavefront .obj file.
+	// Create a new element of dynamic array variable OurIndices.
+	state.OurIndicesFaceTripleti++;					// Update the index variable OurIndicesFaceTripleti of the 3 element intermediate array variable OurIndicesFaceTriplet[OurIndicesFaceTripleti].
+	state.OurIndicesi++;								// Update the index variable OurIndicesi of array variable OurIndices[OurIndicesi].
+	state.OurIndices.emplace_back();					// The only OurIndices.emplace_back() statement, executed once for each face element triplet in all face element statements. Each face element triplet corresponds to a set of vertex attributes.
 
-	// Wavefront .obj file format requirements:
-	// - Supported and required statements are:
-	//   Vertex attribute statements: geometric vertex statements (v x y z), vertex texture coordinate statements (vt u v), and vertex normal vector statements (vn x y z).
-	//
-	//   Face element statements: f v1/vt1/vn1 v2/vt2/vn2 v3/vt3/vn3
-	//   These specify three triplets, one triplet (e.g., v1/vt1/vn1) for each of the three vertices of a triangle, where v1, v2, v3 are geometric vertex indices, vt1, vt2, vt3 are vertex texture coordinate indices, and vn1, vn2, vn3 are vertex normal vector indices.
-	//   These indices are positive numbers referring to vertex attribute statements by the order in which the vertex attribute statements appear in the Wavefront .obj file.
+	// The candidate set of vertex attributes is comprised of v[fv], vt[fvt], and vn[fvn].
+	// Test if the candidate set of vertex attributes is unique, i.e., has this set of vertex attributes been previously found in the Wavefront .obj file and stored in array variable OurVertices?
+	// This is done to avoid storing duplicate (non-unique) sets of vertex attributes in array variable OurVertices.
 	//
-	//   Vertex attribute statements are listed first, and will therefore be parsed before any face element statements.
-	//   The order of the face element statements determines the order in which the triangles must be drawn. This order is important when dealing with overlapping triangles, as the later triangles will be drawn on top of the earlier ones. Face element statements are parsed in this order.
-	//   All other statements are ignored.
-	// - No spaces are permitted before or after a slash ('/').
-	// - Statements can start in any column.
-	// - Statements can be logically joined with the line continuation character ( \ ) at the end of a line. (This is *not* supported by this program)
+	// The uniqueness of a given candidate set of these vertex attributes is first determined by whether the associated face element triplet is unique (hash table OurVerticesByFaceTriplet). This is possible because an identical face element triplet always refers to an identical set of vertex attributes.
+	// If the face element triplet is unique, the candidate set of vertex attributes itself is tested (hash table OurVerticesByAttributes), because although all geometric vertices are usually unique, and all vertex texture coordinates are usually unique, and all vertex normal vertices are usually unique in a Wavefront .obj file, this is not guaranteed.
+	// (If geometric vertices are non-unique, or vertex texture coordinates are non-unique, or vertex normal vertices are non-unique, then two face element triplets comprised of different indices might mistakenly appear to be different but could still point to an identical (non-unique) set of vertex attributes)
+	FaceTripletKey tripletKey = { fv, fvt, fvn };
+	auto tripletFound = state.OurVerticesByFaceTriplet.find(tripletKey);
+	if (tripletFound != state.OurVerticesByFaceTriplet.end())
+	{
+		// The face element triplet is non-unique, so the candidate set of vertex attributes is non-unique, and no new set of vertex attributes is created and stored in the array variable OurVertices.
+		// The new element of intermediate array variable OurIndicesFaceTriplet is assigned the index of the element of array variable OurVertices, which contains the set of vertex attributes previously found.
+		state.OurIndicesFaceTriplet[state.OurIndicesFaceTripleti] = tripletFound->second;
+		return;
+	}
+
+	// The candidate set of vertex attributes, converted to the DirectX format.
+	VERTEX candidate;
+	candidate.GeometricVertex.x =		  state.v[fv].x;
+	candidate.GeometricVertex.y =		  state.v[fv].y;
+	candidate.GeometricVertex.z =		  state.v[fv].z * -1.0f;						// Invert the geometric vertex's Z coordinate, to adjust it from the Wavefront .obj file format to the DirectX format.
+
+	candidate.VertexTextureCoordinate.x = state.vt[fvt].x;
+	candidate.VertexTextureCoordinate.y = 1.0f - state.vt[fvt].y;					// Invert the vertex texture coordinate's V coordinate, to adjust it from the Wavefront .obj file format to the DirectX format.
+
+	candidate.VertexNormalVector.x =	  state.vn[fvn].x;
+	candidate.VertexNormalVector.y =	  state.vn[fvn].y;
+	candidate.VertexNormalVector.z =	  state.vn[fvn].z * -1.0f;					// Invert the vertex normal vector's Z coordinate, to adjust it the Wavefront .obj file format to the DirectX format.
+
+	if (state.Options.DedupByAttributes)
+	{
+		auto attributesFound = state.OurVerticesByAttributes.find(candidate);
+		if (attributesFound != state.OurVerticesByAttributes.end())
+		{
+			// The candidate set of vertex attributes is non-unique, so no new set of vertex attributes is created and stored in the array variable OurVertices.
+			// The new element of intermediate array variable OurIndicesFaceTriplet is assigned the index of the element of array variable OurVertices, which contains the set of vertex attributes previously found.
+			// The face element triplet is remembered, so that its next occurrence is found in hash table OurVerticesByFaceTriplet.
+			state.OurIndicesFaceTriplet[state.OurIndicesFaceTripleti] = attributesFound->second;
+			state.OurVerticesByFaceTriplet.emplace(tripletKey, attributesFound->second);
+			return;
+		}
+	}
+
+	// The candidate set of vertex attributes is unique, so a new set of vertex attributes is created and stored in the array variable OurVertices.
+	// A   new element of dynamic array variable OurVertices is created, and the candidate set of vertex attributes is assigned to it.
+	// The new element of array variable OurIndicesFaceTriplet is assigned.
+	state.OurVerticesi++;																// Update the index variable OurVerticesi of array variable OurVertices[OurVerticesi].
+	state.OurVertices.emplace_back(candidate);										// The only OurVertices.emplace_back() statement, executed once for each unique set of vertex attributes in all face element statements.
+
+	if (VertexAttributesEqual()(candidate, candidate))									// False if the candidate set of vertex attributes contains a NaN (see above).
+	{
+		state.OurVerticesByFaceTriplet.emplace(tripletKey, state.OurVerticesi);
+		if (state.Options.DedupByAttributes)
+			state.OurVerticesByAttributes.emplace(candidate, state.OurVerticesi);
+	}
+
+	state.OurIndicesFaceTriplet[state.OurIndicesFaceTripleti] = state.OurVerticesi;				// The next element of intermediate array variable OurIndicesFaceTriplet is assigned the index of the next element of array variable OurVertices.
+																				// At this point the drawing order of triangle vertices is still counter-clockwise (Wavefront .obj file) and must be converted to clockwise (DirectX).
+}
+
+// objReaderFace function: Definition
+//   This function processes one face element statement (f v1/vt1/vn1 v2/vt2/vn2 v3/vt3/vn3), whose three face element triplets have been parsed into FaceTriplets[0], FaceTriplets[1], and FaceTriplets[2], in the order they appear in the Wavefront .obj file.
+//   It is called by both the stream parser and the memory-mapped parser, so both parsers produce the same OurVertices and OurIndices.
+//   Relative face element indices have already been converted to absolute ones (see objReaderResolveRelative). Every face element index must then refer to a vertex attribute statement of its type in v, vt, or vn:
+//   a missing face element index (e.g., the vt of v//vn, or a face element statement with fewer than three triplets), which is parsed as 0, a 0, and an index greater than the number of vertex attribute statements of its type are all rejected,
+//   rather than reading outside the intermediate arrays.
+//   It returns 0 on success, or 1 if a face element index is not valid, in which case nothing is stored.
+static int objReaderFace(objReaderState& state, const int FaceTriplets[3][3])
+{
+	const size_t Totals[3] = { state.v.size(), state.vt.size(), state.vn.size() };
+	for (int i = 0; i <= 2; i++)
+		for (int j = 0; j <= 2; j++)
+			if (FaceTriplets[i][j] < 1 || (size_t)FaceTriplets[i][j] > Totals[j])
+				return 1;
+
+	// The statement is a face element statement, therefore all vertex attribute statements in the Wavefront .obj file have previously been read, parsed, and stored in the array variables v, vt, and vn.
+	//   Each of the three triplets (e.g., v1/vt1/vn1) in the face element statement consists of three positive numbers referring to three vertex attribute statements specifying one triangle vertex, which together comprise one set of vertex attributes. This new set of vertex attributes, if unique, is stored in the next sequential element of the array variable OurVertices, which is pointed to by array variable OurIndices.
+	//   This results in storing sets of vertex attributes in array variable OurVertices in the order that the face element statements appear in the Wavefront .obj file, which is the order in which the triangles must be drawn.
+	//   Note: A set of vertex attributes is only stored in array variable OurVertices if it is unique, i.e., if it has not been previously found in the Wavefront .obj file.
+
+	// Process each of the three triplets in the face element statement.
+	state.OurIndicesFaceTripleti = -1;							// Reset the index variable OurIndicesFaceTripleti of intermediate array variable OurIndicesFaceTriplet[OurIndicesFaceTripleti] to -1 for each new face element statement.
+	for (int i = 0; i <= 2; i++)
+	{
+		// Decrement the face element indices by 1 to adjust them from the Wavefront .obj file format to the *C++* format.
+		// The face element indices are decremented by 1 because the C++ index variables vi, vti, and vni of the vertex attribute intermediate array variables v[vi], vt[vti], and vn[vn1] start with 0.
+		//
+		// (Face element indices in the Wavefront .obj file format start with 1, while those in the DirectX format start with 0. However, this program does not use the face element indices directly, so an adjustment *for DirectX* is not necessary.
+		// Regardless, making an adjustment for DirectX effectively makes the face element indices start with 0, which is consistent with the C++ format)
+		objReaderFaceTriplet(state, FaceTriplets[i][0] - 1, FaceTriplets[i][1] - 1, FaceTriplets[i][2] - 1);
+	}
+
+	// Convert the drawing order of triangle vertices in the current face element statement from counter-clockwise (Wavefront .obj file) to clockwise (DirectX).
+	// When rendering an object with DirectX, the drawing order of vertices is determined by the values of the sequential elements of the array variable OurIndices.
+	// The values of these elements are the indices of array variable OurVertices, and would also be sequential, were it not for,
+	// - The need to avoid storing duplicate (non-unique) sets of vertex attributes in array variable OurVertices as discussed above.
+	// - The need to convert the drawing order to clockwise.
 	//
+	// At this point, the three face element triplets in the current face element statement have been processed:
+	// - The associated three sets of vertex attributes				are stored in array variable OurVertices.
+	// - The associated three indices of array variable OurVertices are stored in intermediate array variable OurIndicesFaceTriplet.
+	//   The drawing order of these three indices is counter-clockwise (Wavefront .obj file) in intermediate array variable OurIndicesFaceTriplet, and must be converted to clockwise (DirectX) in array variable OurIndices.
+	// This can be done by reversing the order of processing the second and third set of vertex attributes of each triangle's three vertices, which is equivalent to changing the order by which the elements of array variable OurVertices are referenced by the elements of array variable OurIndices:
+	// - OurVertices[OurVerticesi] is OurVertices[OurIndices[OurIndicesi]], where instead of OurIndices[OurIndicesi] = 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 etc. the drawing order is reversed by reordering OurIndices[OurIndicesi] = 0, 2, 1, 3, 5, 4, 6, 8, 7, 9, 11, 10, etc. (This is done in this program)
+	// - Alternatively, the elements of the array variable OurVertices could be reordered while keeping the elements of the array variable OurIndices[OurIndicesi] = 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 etc. (This is not done in this program)
+	// At this point, OurIndicesi is the index of the last element of array variable OurIndices.
+	// The last three elements of the array variable OurIndices are assigned the values of the elements of the intermediate array variable OurIndicesFaceTriplet, converted to clockwise (DirectX).
+	state.OurIndices[state.OurIndicesi - 2] = state.OurIndicesFaceTriplet[0];								// OurIndicesi - 2 corresponds to the index of the first  element of the three element intermediate array variable OurIndicesFaceTriplet.
+	state.OurIndices[state.OurIndicesi - 1] = state.OurIndicesFaceTriplet[2];								// OurIndicesi - 1 corresponds to the index of the third  element of the three element intermediate array variable OurIndicesFaceTriplet.
+	state.OurIndices[state.OurIndicesi]     = state.OurIndicesFaceTriplet[1];								// OurIndicesi     corresponds to the index of the second element of the three element intermediate array variable OurIndicesFaceTriplet.
+
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
+
+// objReaderResolveRelative function: Definition
+//   This function converts the relative (negative) face element indices of one face element statement to absolute ones. A relative index refers to a vertex attribute statement counting back from the last one before the face element statement:
+//   -1 is the last, -2 the one before it, etc. Counts[0], Counts[1], and Counts[2] are the numbers of v, vt, and vn statements before the face element statement.
+//   A relative index referring before the first vertex attribute statement of its type is converted to 0, which the objReaderFace function rejects.
+static void objReaderResolveRelative(int FaceTriplets[3][3], const size_t Counts[3])
+{
+	for (int i = 0; i <= 2; i++)
+		for (int j = 0; j <= 2; j++)
+			if (FaceTriplets[i][j] < 0)
+			{
+				long long index = (long long)Counts[j] + FaceTriplets[i][j] + 1;
+				FaceTriplets[i][j] = index > 0 ? (int)index : 0;
+			}
+}
+
+// objReaderReserve function: Definition
+//   This function reserves memory for OurVertices, OurIndices, and the hash tables before the face element statements are processed, so that they are not repeatedly reallocated (and the hash tables rehashed) as they grow.
+//   FacesTotal is the number of face element statements, so OurIndices has FacesTotal * 3 elements.
+//   The number of unique sets of vertex attributes is not known until all face element statements are processed. It is at most FacesTotal * 3, and is usually at least the number of elements of the largest of v, vt, and vn, because each vertex attribute statement is usually referenced. The smaller of these two numbers is reserved.
+static void objReaderReserve(objReaderState& state, size_t FacesTotal)
+{
+	size_t VerticesEstimate = state.v.size();
+	if (VerticesEstimate < state.vt.size())
+		VerticesEstimate = state.vt.size();
+	if (VerticesEstimate < state.vn.size())
+		VerticesEstimate = state.vn.size();
+	if (VerticesEstimate > FacesTotal * 3)
+		VerticesEstimate = FacesTotal * 3;
+
+	state.OurIndices.reserve(state.OurIndices.size() + FacesTotal * 3);
+	state.OurVertices.reserve(VerticesEstimate);
+	state.OurVerticesByFaceTriplet.reserve(VerticesEstimate);
+	if (state.Options.DedupByAttributes)
+		state.OurVerticesByAttributes.reserve(VerticesEstimate);
+}
+
+// objReaderParseTriplet function: Declaration
+// Defined with the other scanner functions below, and also used by the objReaderParseStream function to parse face element triplets.
+static inline const char* objReaderParseTriplet(const char* p, const char* end, int Triplet[3]);
+
+// objReaderParseStream function: Definition
+//   This function reads the Wavefront .obj file FileName one statement at a time through an input file stream, and parses each statement through a string stream.
+//   It returns 0 on success, or 1 if the Wavefront .obj file cannot be opened, or a face element index is not valid.
+static int objReaderParseStream(objReaderState& state, const char* FileName)
+{
+	chrono::steady_clock::time_point lap = chrono::steady_clock::now();
+	ifstream obj;											// Declare the input file stream object representing the Wavefront .obj file.
+	string stringtext;										// Holds one statement of the input file stream object representing the Wavefront .obj file.
+
 	// Open the Wavefront .obj file for input.
-	obj.open("Text.obj", ios::in);
+	obj.open(FileName, ios::in);
 	// Check whether the Wavefront .obj file opened successfully. (!obj), (!obj.is_open()), and (obj.fail()) all indicate an error opening the file.
 	if (!obj)												// If not (!) successful (obj) then:
 	{
@@ -104,6 +420,18 @@ int objReader(void)
 		return 1;
 	}
 
+	// The numbers of statements are not known until the Wavefront .obj file has been read, so memory is reserved from an estimate based on the size of the file (see objReaderStatementBytesEstimate).
+	error_code error;
+	state.FileBytes = (size_t)fs::file_size(FileName, error);
+	if (error)
+		state.FileBytes = 0;
+	size_t statementsEstimate = state.FileBytes / objReaderStatementBytesEstimate / 4;
+	state.v.reserve(statementsEstimate); state.vt.reserve(statementsEstimate); state.vn.reserve(statementsEstimate);
+	state.OurIndices.reserve(statementsEstimate * 3);
+	state.OurVerticesByFaceTriplet.reserve(statementsEstimate);
+	if (state.Options.DedupByAttributes)
+		state.OurVerticesByAttributes.reserve(statementsEstimate);
+
 	// Parse the Wavefront .obj file.
 	while (getline(obj, stringtext))						// Read an entire statement, from the input file stream object obj, into the string variable stringtext. At eof getline becomes false and the while loop is exited.
 	{
@@ -115,135 +443,466 @@ int objReader(void)
 		if (type == "v")
 		{
 			// The statement read is a geometric vertex statement. Parse and store it in variable v.
-			vi++;												// Increment the geometric vertex index.
-			v.emplace_back();									// Add a new element to this dynamic intermediate array.
-			lineStream >> v[vi].x >> v[vi].y >> v[vi].z;		// The >> operator extracts the next three values from the lineStream input stream object and stores them in the intermediate array variables v[vi].x, then v[vi].y, then v[vi].z.
+			state.vi++;												// Increment the geometric vertex index.
+			state.v.emplace_back();									// Add a new element to this dynamic intermediate array.
+			lineStream >> state.v[state.vi].x >> state.v[state.vi].y >> state.v[state.vi].z;		// The >> operator extracts the next three values from the lineStream input stream object and stores them in the intermediate array variables v[vi].x, then v[vi].y, then v[vi].z.
 		} else if (type == "vn")
 		{
 			// The statement read is a vertex normal vector statement. Parse and store it in variable vn.
-			vni++;												// Increment the vertex normal vector index.
-			vn.emplace_back();									// Add a new element to this dynamic intermediate array.
-			lineStream >> vn[vni].x >> vn[vni].y >> vn[vni].z;	// The >> operator extracts the next three values from the lineStream input stream object and stores them in the intermediate array variables vn[vni].x, then vn[vni].y, then vn[vni].z.
+			state.vni++;												// Increment the vertex normal vector index.
+			state.vn.emplace_back();									// Add a new element to this dynamic intermediate array.
+			lineStream >> state.vn[state.vni].x >> state.vn[state.vni].y >> state.vn[state.vni].z;	// The >> operator extracts the next three values from the lineStream input stream object and stores them in the intermediate array variables vn[vni].x, then vn[vni].y, then vn[vni].z.
 		} else if (type == "vt")
 		{
 			// The statement read is a vertex texture coordinate statement. Parse and store it in variable vt.
-			vti++;												// Increment the vertex texture coordinate index.
-			vt.emplace_back();									// Add a new element to this dynamic intermediate array.
-			lineStream >> vt[vti].x >> vt[vti].y;				// The >> operator extracts the next two values from the lineStream input stream object and stores them in the intermediate array variables vt[vti].x, then vt[vti].y.
+			state.vti++;												// Increment the vertex texture coordinate index.
+			state.vt.emplace_back();									// Add a new element to this dynamic intermediate array.
+			lineStream >> state.vt[state.vti].x >> state.vt[state.vti].y;				// The >> operator extracts the next two values from the lineStream input stream object and stores them in the intermediate array variables vt[vti].x, then vt[vti].y.
 		} else if (type == "f")
 		{
-			// The statement read is a face element statement, therefore all vertex attribute statements in the Wavefront .obj file have previously been read, parsed, and stored in the array variables v, vt, and vn.
-			// Now parse the face element statement: f v1/vt1/vn1 v2/vt2/vn2 v3/vt3/vn3
-			//   Each of the three triplets (e.g., v1/vt1/vn1) in the face element statement consists of three positive numbers referring to three vertex attribute statements specifying one triangle vertex, which together comprise one set of vertex attributes. This new set of vertex attributes, if unique, is stored in the next sequential element of the array variable OurVertices, which is pointed to by array variable OurIndices.
-			//   This results in storing sets of vertex attributes in array variable OurVertices in the order that the face element statements appear in the Wavefront .obj file, which is the order in which the triangles must be drawn.
-			//   Note: A set of vertex attributes is only stored in array variable OurVertices if it is unique, i.e., if it has not been previously found in the Wavefront .obj file.
-
-			// Parse each of the three triplets in the face element statement.
-			OurIndicesFaceTripleti = -1;					// Reset the index variable OurIndicesFaceTripleti of intermediate array variable OurIndicesFaceTriplet[OurIndicesFaceTripleti] to -1 for each new face element statement.
+			// The statement read is a face element statement: f v1/vt1/vn1 v2/vt2/vn2 v3/vt3/vn3
+			// Parse its three face element triplets, and then process them with the objReaderFace function.
+
+			// Parse each of the three triplets (v/vt/vn) in the face element statement, after the statement type, with the scanner function of the memory-mapped parser,
+			// so that both parsers read a missing face element index (e.g., v//vn) or a relative face element index (e.g., -1/-1/-1) the same way. The >> operator cannot parse a missing index.
+			// tellg returns -1 when the statement ends after its type (a bare "f", which sets eofbit), or the string stream failed, so there is no position to parse from: the face element statement is not valid.
+			streamoff position = lineStream.tellg();
+			if (position < 0)
+			{
+				// A face element statement without face element triplets.
+
+				// Terminate this function with a return code indicating an error.
+				return 1;
+			}
+			int FaceTriplets[3][3];
+			const char* p = stringtext.data() + (size_t)position;
+			const char* end = stringtext.data() + stringtext.size();
 			for (int i = 0; i <= 2; i++)
+				p = objReaderParseTriplet(p, end, FaceTriplets[i]);
+			const size_t Counts[3] = { state.v.size(), state.vt.size(), state.vn.size() };
+			objReaderResolveRelative(FaceTriplets, Counts);
+			if (objReaderFace(state, FaceTriplets) == 1)
 			{
-				// Face element vertex attribute indices of the current face element triplet.
-				int fv;										// Geometric vertex index (v1, or v2, or v3).
-				int fvt;									// Vertex texture coordinate index (vt1, or vt2, or vt3).
-				int fvn;									// Vertex normal vector index (vn1, or vn2, or vn3).
-				char slash = '/';							// The slash character ('/') is a delimiter used to parse the face element.
-
-				// Parse the current triplet (v/vt/vn) in the face element statement, storing the face element indices.
-				lineStream >> fv >> slash >> fvt >> slash >> fvn;
-
-				// Decrement the face element indices by 1 to adjust them from the Wavefront .obj file format to the *C++* format.
-				// The face element indices are decremented by 1 because the C++ index variables vi, vti, and vni of the vertex attribute intermediate array variables v[vi], vt[vti], and vn[vn1] start with 0.
-				//
-				// (Face element indices in the Wavefront .obj file format start with 1, while those in the DirectX format start with 0. However, this program does not use the face element indices directly, so an adjustment *for DirectX* is not necessary.
-				// Regardless, making an adjustment for DirectX effectively makes the face element indices start with 0, which is consistent with the C++ format)
-				fv--; fvt--; fvn--;
-
-				// Create a new element of dynamic array variable OurIndices.
-				OurIndicesFaceTripleti++;					// Update the index variable OurIndicesFaceTripleti of the 3 element intermediate array variable OurIndicesFaceTriplet[OurIndicesFaceTripleti].
-				OurIndicesi++;								// Update the index variable OurIndicesi of array variable OurIndices[OurIndicesi].
-				OurIndices.emplace_back();					// The only OurIndices.emplace_back() statement, executed once for each face element triplet in all face element statements. Each face element triplet corresponds to a set of vertex attributes.
-
-				// The candidate set of vertex attributes is comprised of v[fv], vt[fvt], and vn[fvn].
-				// Test if the candidate set of vertex attributes is unique, i.e., has this set of vertex attributes been previously found in the Wavefront .obj file and stored in array variable OurVertices?
-				// This is done to avoid storing duplicate (non-unique) sets of vertex attributes in array variable OurVertices.
-				//
-				// The uniqueness of a given candidate set of these vertex attributes can alternatively be determined by whether the associated face element triplet is unique. This is possible because although all geometric vertices are unique, and all vertex texture coordinates are unique, and all vertex normal vertices are unique in a Wavefront .obj file, a combination of these three vertex attributes can be non-unique. (This is not done in this program)
-				// (If geometric vertices could be non-unique, or vertex texture coordinates could be non-unique, or vertex normal vertices could be non-unique, then two face element triplets comprised of different indices might mistakenly appear to be different but could still point to an identical (non-unique) set of vertex attributes)
-				bool unique = true;																// Define a semaphore to indicate whether the candidate set of vertex attributes is unique.
-				for (int j = 0; j <= OurVerticesi; j++)
-				{
-					if (OurVertices[j].GeometricVertex.x ==				  v[fv].x		   &&
-						OurVertices[j].GeometricVertex.y ==				  v[fv].y		   &&
-						OurVertices[j].GeometricVertex.z ==				  v[fv].z * -1.0f  &&	// Invert the geometric vertex's Z coordinate, to adjust it from the Wavefront .obj file format to the DirectX format.
-
-						OurVertices[j].VertexTextureCoordinate.x ==		  vt[fvt].x		   &&
-						OurVertices[j].VertexTextureCoordinate.y ==		  1.0f - vt[fvt].y &&	// Invert the vertex texture coordinate's V coordinate, to adjust it from the Wavefront .obj file format to the DirectX format.
-
-						OurVertices[j].VertexNormalVector.x ==			  vn[fvn].x		   &&
-						OurVertices[j].VertexNormalVector.y ==			  vn[fvn].y		   &&
-						OurVertices[j].VertexNormalVector.z ==			  vn[fvn].z * -1.0f)	// Invert the vertex normal vector's Z coordinate, to adjust it the Wavefront .obj file format to the DirectX format.
-					{
-						// The candidate set of vertex attributes is non-unique, so no new set of vertex attributes is created and stored in the array variable OurVertices.
-						// No  new element of array variable OurVertices						is created, as an existing set of vertex attributes is reused.
-						// The new element of intermediate array variable OurIndicesFaceTriplet is assigned the index (the value of variable j) of the element of array variable OurVertices[j], which contains the set of vertex attributes previously found.
-						unique = false;
-						OurIndicesFaceTriplet[OurIndicesFaceTripleti] = j;
-						break;
-					}
-				}
-				if (unique)
-				{
-					// The candidate set of vertex attributes is unique, so a new set of vertex attributes is created and stored in the array variable OurVertices.
-					// A   new element of dynamic array variable OurVertices is created, and the candidate set of vertex attributes is assigned to it.
-					// The new element of array variable OurIndicesFaceTriplet is assigned.
-					OurVerticesi++;																// Update the index variable OurVerticesi of array variable OurVertices[OurVerticesi].
-					OurVertices.emplace_back();													// The only OurVertices.emplace_back() statement, executed once for each unique set of vertex attributes in all face element statements.
-
-					OurVertices[OurVerticesi].GeometricVertex.x =		  v[fv].x;
-					OurVertices[OurVerticesi].GeometricVertex.y =		  v[fv].y;
-					OurVertices[OurVerticesi].GeometricVertex.z =		  v[fv].z * -1.0f;		// Invert the geometric vertex's Z coordinate, to adjust it from the Wavefront .obj file format to the DirectX format.
-
-					OurVertices[OurVerticesi].VertexTextureCoordinate.x = vt[fvt].x;
-					OurVertices[OurVerticesi].VertexTextureCoordinate.y = 1.0f - vt[fvt].y;		// Invert the vertex texture coordinate's V coordinate, to adjust it from the Wavefront .obj file format to the DirectX format.
-
-					OurVertices[OurVerticesi].VertexNormalVector.x =	  vn[fvn].x;
-					OurVertices[OurVerticesi].VertexNormalVector.y =	  vn[fvn].y;
-					OurVertices[OurVerticesi].VertexNormalVector.z =	  vn[fvn].z * -1.0f;	// Invert the vertex normal vector's Z coordinate, to adjust it the Wavefront .obj file format to the DirectX format.
-
-					OurIndicesFaceTriplet[OurIndicesFaceTripleti] = OurVerticesi;				// The next element of intermediate array variable OurIndicesFaceTriplet is assigned the index of the next element of array variable OurVertices.
-																								// At this point the drawing order of triangle vertices is still counter-clockwise (Wavefront .obj file) and must be converted to clockwise (DirectX).
-				}
+				// A face element index is not valid.
+
+				// Terminate this function with a return code indicating an error.
+				return 1;
 			}
-			// Convert the drawing order of triangle vertices in the current face element statement from counter-clockwise (Wavefront .obj file) to clockwise (DirectX).
-			// When rendering an object with DirectX, the drawing order of vertices is determined by the values of the sequential elements of the array variable OurIndices.
-			// The values of these elements are the indices of array variable OurVertices, and would also be sequential, were it not for,
-			// - The need to avoid storing duplicate (non-unique) sets of vertex attributes in array variable OurVertices as discussed above.
-			// - The need to convert the drawing order to clockwise.
-			//
-			// At this point, the three face element triplets in the current face element statement have been processed:
-			// - The associated three sets of vertex attributes				are stored in array variable OurVertices.
-			// - The associated three indices of array variable OurVertices are stored in intermediate array variable OurIndicesFaceTriplet.
-			//   The drawing order of these three indices is counter-clockwise (Wavefront .obj file) in intermediate array variable OurIndicesFaceTriplet, and must be converted to clockwise (DirectX) in array variable OurIndices.
-			// This can be done by reversing the order of processing the second and third set of vertex attributes of each triangle's three vertices, which is equivalent to changing the order by which the elements of array variable OurVertices are referenced by the elements of array variable OurIndices:
-			// - OurVertices[OurVerticesi] is OurVertices[OurIndices[OurIndicesi]], where instead of OurIndices[OurIndicesi] = 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 etc. the drawing order is reversed by reordering OurIndices[OurIndicesi] = 0, 2, 1, 3, 5, 4, 6, 8, 7, 9, 11, 10, etc. (This is done in this program)
-			// - Alternatively, the elements of the array variable OurVertices could be reordered while keeping the elements of the array variable OurIndices[OurIndicesi] = 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 etc. (This is not done in this program)
-			// At this point, OurIndicesi is the index of the last element of array variable OurIndices.
-			// The last three elements of the array variable OurIndices are assigned the values of the elements of the intermediate array variable OurIndicesFaceTriplet, converted to clockwise (DirectX).
-			OurIndices[OurIndicesi - 2] = OurIndicesFaceTriplet[0];								// OurIndicesi - 2 corresponds to the index of the first  element of the three element intermediate array variable OurIndicesFaceTriplet.
-			OurIndices[OurIndicesi - 1] = OurIndicesFaceTriplet[2];								// OurIndicesi - 1 corresponds to the index of the third  element of the three element intermediate array variable OurIndicesFaceTriplet.
-			OurIndices[OurIndicesi]     = OurIndicesFaceTriplet[1];								// OurIndicesi     corresponds to the index of the second element of the three element intermediate array variable OurIndicesFaceTriplet.
 		} else continue;																		// The statement read is not a geometric vertex, vertex texture coordinate, vertex normal vector, or face element statement. Ignore it and continue.
 	}
 	// End of the while loop. The entire Wavefront .obj file has been read and parsed.
+	state.IntermediateBytes = state.v.capacity() * sizeof(XMFLOAT3) + state.vt.capacity() * sizeof(XMFLOAT2) + state.vn.capacity() * sizeof(XMFLOAT3);
 
 	// Close the Wavefront .obj file.
 	obj.close();
+	state.TokenizeSeconds = objReaderLap(lap);
+
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
+
+// Scanner functions used by the objReaderParseMapped function.
+// Each function starts scanning at pointer p, never reads at or past pointer end, and returns a pointer to the first character it did not consume.
+// Unlike the >> operator of a string stream, they do not allocate memory and do not consult the locale.
+static inline bool objReaderIsBlank(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+static inline const char* objReaderSkipBlanks(const char* p, const char* end)
+{
+	while (p < end && objReaderIsBlank(*p))
+		p++;
+	return p;
+}
+
+// Parse one floating-point value with std::from_chars, which converts the characters directly and rounds correctly. If no value can be parsed, value is assigned 0.0f.
+static inline const char* objReaderParseFloat(const char* p, const char* end, float& value)
+{
+	p = objReaderSkipBlanks(p, end);
+	if (p < end && *p == '+')								// std::from_chars does not accept a leading plus sign.
+		p++;
+	from_chars_result result = from_chars(p, end, value);
+	if (result.ec != errc())
+	{
+		value = 0.0f;
+		return p;
+	}
+	return result.ptr;
+}
+
+// Parse one face element index. The loop has a single comparison per digit: subtracting '0' maps every non-digit character to an unsigned value greater than 9.
+// A missing index (no digits) is parsed as 0, and a relative index (a leading minus sign) as a negative value. An index too large for an int is limited to the largest int, so it can never wrap around to a valid or relative index.
+static inline const char* objReaderParseIndex(const char* p, const char* end, int& value)
+{
+	bool negative = p < end && *p == '-';
+	p += negative;
+	unsigned long long index = 0;
+	unsigned int digit;
+	while (p < end && (digit = (unsigned int)(unsigned char)*p - '0') <= 9)
+	{
+		index = index <= 0x7FFFFFFF ? index * 10 + digit : index;
+		p++;
+	}
+	if (index > 0x7FFFFFFF)
+		index = 0x7FFFFFFF;
+	value = negative ? -(int)index : (int)index;
+	return p;
+}
+
+// Parse one face element triplet, v/vt/vn. No spaces are permitted before or after a slash ('/').
+static inline const char* objReaderParseTriplet(const char* p, const char* end, int Triplet[3])
+{
+	p = objReaderSkipBlanks(p, end);
+	p = objReaderParseIndex(p, end, Triplet[0]);
+	p += (p < end && *p == '/');
+	p = objReaderParseIndex(p, end, Triplet[1]);
+	p += (p < end && *p == '/');
+	p = objReaderParseIndex(p, end, Triplet[2]);
+	return p;
+}
+
+// Declare the objReaderChunk 'named structure' data type.
+// An objReaderChunk is one part of the memory-mapped Wavefront .obj file, [Begin, End), starting at the beginning of a statement and ending after the end of a statement.
+// Each chunk is parsed by its own thread into its own intermediate arrays, so no thread writes to memory written by another thread.
+struct objReaderChunk {
+	const char* Begin;										// The first character of the chunk.
+	const char* End;										// One character past the last character of the chunk.
+	vector<XMFLOAT3> v;										// Geometric vertices		   found in the chunk, in the order they appear in the Wavefront .obj file.
+	vector<XMFLOAT2> vt;									// Vertex texture coordinates found in the chunk, in the order they appear in the Wavefront .obj file.
+	vector<XMFLOAT3> vn;									// Vertex normal vectors	   found in the chunk, in the order they appear in the Wavefront .obj file.
+	vector<int> f;											// Face element indices found in the chunk, nine per face element statement (v1, vt1, vn1, v2, vt2, vn2, v3, vt3, vn3), in the order they appear in the Wavefront .obj file.
+
+	// A face element index refers to the vertex attribute statements of the entire Wavefront .obj file, but a chunk only knows the vertex attribute statements it contains itself, so face element indices are validated and resolved when the chunks are merged:
+	vector<size_t> Relative;								// For each face element statement with a relative face element index: its position in f, and the numbers of v, vt, and vn statements in the chunk before it, four per face element statement.
+	long long Excess[3] = { 0, 0, 0 };						// The largest amount by which an absolute v, vt, and vn index exceeds the number of vertex attribute statements of its type in the chunk before its face element statement.
+															// The face element statement refers to a vertex attribute statement after it (which the stream parser has not yet read) if this exceeds the number of vertex attribute statements in the chunks before this one.
+	size_t First[3] = { 0, 0, 0 };							// The numbers of v, vt, and vn statements in the chunks before this one, assigned when the chunks are merged.
+};
+
+// objReaderScanChunk function: Definition
+//   This function parses the statements of one chunk of the memory-mapped Wavefront .obj file in place with a pointer, one statement (line) at a time, into the chunk's intermediate arrays.
+//   No statement is copied: the scanner functions above read the characters of the mapped file directly.
+static void objReaderScanChunk(objReaderChunk& chunk)
+{
+	const char* p = chunk.Begin;							// The current position in the chunk.
+	const char* end = chunk.End;							// One byte past the last byte of the chunk.
+
+	while (p < end)
+	{
+		// Find the end of the current statement. The statement's characters are [p, lineEnd), and the next statement starts after lineEnd.
+		const char* lineEnd = (const char*)memchr(p, '\n', (size_t)(end - p));
+		if (lineEnd == nullptr)
+			lineEnd = end;
+
+		// Find the Wavefront .obj file statement type, the first word of the statement: #, v, vn, vt, f, etc.
+		p = objReaderSkipBlanks(p, lineEnd);
+		const char* type = p;
+		while (p < lineEnd && !objReaderIsBlank(*p))
+			p++;
+		size_t typeLength = (size_t)(p - type);
+
+		if (typeLength == 1 && type[0] == 'v')
+		{
+			// The statement read is a geometric vertex statement. Parse and store it in the chunk's variable v.
+			XMFLOAT3& vertex = chunk.v.emplace_back();
+			p = objReaderParseFloat(p, lineEnd, vertex.x);
+			p = objReaderParseFloat(p, lineEnd, vertex.y);
+			p = objReaderParseFloat(p, lineEnd, vertex.z);
+		} else if (typeLength == 2 && type[0] == 'v' && type[1] == 'n')
+		{
+			// The statement read is a vertex normal vector statement. Parse and store it in the chunk's variable vn.
+			XMFLOAT3& normal = chunk.vn.emplace_back();
+			p = objReaderParseFloat(p, lineEnd, normal.x);
+			p = objReaderParseFloat(p, lineEnd, normal.y);
+			p = objReaderParseFloat(p, lineEnd, normal.z);
+		} else if (typeLength == 2 && type[0] == 'v' && type[1] == 't')
+		{
+			// The statement read is a vertex texture coordinate statement. Parse and store it in the chunk's variable vt.
+			XMFLOAT2& coordinate = chunk.vt.emplace_back();
+			p = objReaderParseFloat(p, lineEnd, coordinate.x);
+			p = objReaderParseFloat(p, lineEnd, coordinate.y);
+		} else if (typeLength == 1 && type[0] == 'f')
+		{
+			// The statement read is a face element statement: f v1/vt1/vn1 v2/vt2/vn2 v3/vt3/vn3
+			// Parse its three face element triplets and store them in the chunk's variable f. They are processed later, in file order, by the objReaderFace function.
+			size_t fi = chunk.f.size();
+			chunk.f.resize(fi + 9);
+			p = objReaderParseTriplet(p, lineEnd, &chunk.f[fi]);
+			p = objReaderParseTriplet(p, lineEnd, &chunk.f[fi + 3]);
+			p = objReaderParseTriplet(p, lineEnd, &chunk.f[fi + 6]);
+
+			// Record what is needed to validate and resolve the face element indices when the chunks are merged.
+			const long long Counts[3] = { (long long)chunk.v.size(), (long long)chunk.vt.size(), (long long)chunk.vn.size() };
+			bool relative = false;
+			for (size_t i = 0; i < 9; i++)
+			{
+				int index = chunk.f[fi + i];
+				relative |= index < 0;
+				if (index - Counts[i % 3] > chunk.Excess[i % 3])
+					chunk.Excess[i % 3] = index - Counts[i % 3];
+			}
+			if (relative)
+				chunk.Relative.insert(chunk.Relative.end(), { fi, chunk.v.size(), chunk.vt.size(), chunk.vn.size() });
+		}
+		// Any other statement is ignored.
+
+		// Continue with the next statement.
+		p = lineEnd + 1;
+	}
+}
+
+// Append the elements of a chunk's intermediate array to the corresponding intermediate array (v, vt, or vn). The chunk's intermediate array is then freed.
+template <typename T>
+static void objReaderAppend(vector<T>& to, vector<T>& from)
+{
+	if (to.empty())
+		to.swap(from);										// The first chunk's elements are not copied.
+	else
+		to.insert(to.end(), from.begin(), from.end());
+	vector<T>().swap(from);
+}
+
+// objReaderParseMapped function: Definition
+//   This function maps the Wavefront .obj file FileName into memory and parses it with one or more threads:
+//   1. Split the file into chunks, one per thread, at statement (line) boundaries.
+//      Chunks smaller than objReaderMinimumChunkBytes are not created, so a small file is parsed by a single thread.
+//
+//   2. Parse all chunks at the same time, each by its own thread, into the chunk's own intermediate arrays (objReaderScanChunk function).
+//      This is where the characters of the file are converted to numbers, which is most of the work of parsing.
+//
+//   3. Merge the chunks in file order, on the calling thread:
+//      - Append the vertex attributes of each chunk to the intermediate arrays v, vt, and vn.
+//        Face element indices refer to vertex attribute statements by their order in the entire Wavefront .obj file, not within a chunk.
+//        Because the chunks are appended in file order, each vertex attribute lands at the same index of v, vt, or vn as it would if the file were parsed by a single thread, so no face element index needs to change.
+//      - Process the face element statements of each chunk, in file order, with the objReaderFace function.
+//        The order of the face element statements determines the order in which the triangles must be drawn, and the order in which unique sets of vertex attributes are stored in OurVertices.
+//        This step is therefore not divided among threads, and OurVertices and OurIndices are identical regardless of the number of threads.
+//        Relative face element indices are converted to absolute ones here, because only now are the numbers of vertex attribute statements in the chunks before each chunk known.
+//   It returns 0 on success, or 1 if the Wavefront .obj file cannot be opened or mapped, or a face element index is not valid.
+static int objReaderParseMapped(objReaderState& state, const char* FileName)
+{
+	chrono::steady_clock::time_point lap = chrono::steady_clock::now();
+	MappedFile obj;											// The Wavefront .obj file, mapped into memory.
+	if (MapFile(FileName, obj) == 1)
+	{
+		// Cannot open the Wavefront .obj file.
+
+		// Terminate this function with a return code indicating an error.
+		return 1;
+	}
+	state.FileBytes = obj.Size;
+	state.IoSeconds = objReaderLap(lap);
+
+	//***
+	// 1. Split the file into chunks, one per thread, at statement (line) boundaries.
+	//***
+
+	size_t threadsTotal = state.Options.Threads > 0 ? (size_t)state.Options.Threads : (size_t)thread::hardware_concurrency();
+	if (threadsTotal == 0)									// hardware_concurrency returns 0 if the number of hardware threads cannot be determined.
+		threadsTotal = 1;
+	size_t minimumChunkBytes = state.Options.MinimumChunkBytes > 0 ? state.Options.MinimumChunkBytes : 1;	// A minimum chunk size of 0 is treated as 1 byte, i.e., no minimum, rather than dividing by 0.
+	size_t chunksTotal = obj.Size / minimumChunkBytes;
+	if (chunksTotal > threadsTotal)
+		chunksTotal = threadsTotal;
+	if (chunksTotal == 0)
+		chunksTotal = 1;
+
+	vector<objReaderChunk> chunks(chunksTotal);
+	const char* end = obj.Data + obj.Size;					// One byte past the last byte of the Wavefront .obj file.
+	const char* chunkBegin = obj.Data;
+	for (size_t c = 0; c < chunksTotal; c++)
+	{
+		// The chunk nominally ends at an equal fraction of the file, and is extended to the end of the statement that contains that position.
+		const char* chunkEnd = end;
+		if (c + 1 < chunksTotal)
+		{
+			chunkEnd = obj.Data + obj.Size / chunksTotal * (c + 1);
+			if (chunkEnd < chunkBegin)
+				chunkEnd = chunkBegin;
+			const char* newline = (const char*)memchr(chunkEnd, '\n', (size_t)(end - chunkEnd));
+			chunkEnd = newline != nullptr ? newline + 1 : end;
+		}
+		chunks[c].Begin = chunkBegin;
+		chunks[c].End = chunkEnd;
+		chunkBegin = chunkEnd;
+	}
+
+	// End: 1. Split the file into chunks, one per thread, at statement (line) boundaries.
+
+	//***
+	// 2. Parse all chunks at the same time, each by its own thread.
+	//    The calling thread parses the first chunk itself.
+	//***
+
+	vector<thread> workers;
+	for (size_t c = 1; c < chunksTotal; c++)
+		workers.emplace_back(objReaderScanChunk, std::ref(chunks[c]));
+	objReaderScanChunk(chunks[0]);
+	for (thread& worker : workers)
+		worker.join();
+
+	// All characters have been converted to numbers. Unmap the Wavefront .obj file.
+	UnmapFile(obj);
+	state.TokenizeSeconds = objReaderLap(lap);
+
+	// End: 2. Parse all chunks at the same time, each by its own thread.
+
+	//***
+	// 3. Merge the chunks in file order.
+	//***
+
+	// Append the vertex attributes of each chunk to the intermediate arrays v, vt, and vn.
+	// The scan has counted every statement, so exactly the memory needed is reserved.
+	size_t vTotal = state.v.size(), vtTotal = state.vt.size(), vnTotal = state.vn.size(), facesTotal = 0;
+	for (objReaderChunk& chunk : chunks)
+	{
+		chunk.First[0] = vTotal; chunk.First[1] = vtTotal; chunk.First[2] = vnTotal;
+		vTotal += chunk.v.size(); vtTotal += chunk.vt.size(); vnTotal += chunk.vn.size(); facesTotal += chunk.f.size() / 9;
+		state.IntermediateBytes += chunk.v.capacity() * sizeof(XMFLOAT3) + chunk.vt.capacity() * sizeof(XMFLOAT2) + chunk.vn.capacity() * sizeof(XMFLOAT3) + chunk.f.capacity() * sizeof(int);
+	}
+	state.v.reserve(vTotal); state.vt.reserve(vtTotal); state.vn.reserve(vnTotal);
+	for (objReaderChunk& chunk : chunks)
+	{
+		objReaderAppend(state.v, chunk.v);
+		objReaderAppend(state.vt, chunk.vt);
+		objReaderAppend(state.vn, chunk.vn);
+	}
+	state.vi = (int)state.v.size() - 1; state.vti = (int)state.vt.size() - 1; state.vni = (int)state.vn.size() - 1;
+	objReaderReserve(state, facesTotal);
+	state.MergeSeconds = objReaderLap(lap);
+
+	// Process the face element statements of each chunk, in file order.
+	for (objReaderChunk& chunk : chunks)
+	{
+		// A face element statement referring to a vertex attribute statement after it is rejected, as the stream parser rejects it.
+		for (int j = 0; j <= 2; j++)
+			if (chunk.Excess[j] > (long long)chunk.First[j])
+			{
+				// A face element index is not valid.
+
+				// Terminate this function with a return code indicating an error.
+				return 1;
+			}
+
+		size_t relative = 0;								// The index of the next face element statement with a relative face element index in chunk.Relative.
+		for (size_t fi = 0; fi + 9 <= chunk.f.size(); fi += 9)
+		{
+			int(*FaceTriplets)[3] = (int(*)[3]) & chunk.f[fi];
+			if (relative < chunk.Relative.size() && chunk.Relative[relative] == fi)
+			{
+				const size_t Counts[3] = { chunk.First[0] + chunk.Relative[relative + 1], chunk.First[1] + chunk.Relative[relative + 2], chunk.First[2] + chunk.Relative[relative + 3] };
+				objReaderResolveRelative(FaceTriplets, Counts);
+				relative += 4;
+			}
+			if (objReaderFace(state, FaceTriplets) == 1)
+			{
+				// A face element index is not valid.
+
+				// Terminate this function with a return code indicating an error.
+				return 1;
+			}
+		}
+		vector<int>().swap(chunk.f);
+	}
+	state.FacesSeconds = objReaderLap(lap);
+
+	// End: 3. Merge the chunks in file order.
+
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
+
+// LoadObj function: Definition
+//   This function parses the Wavefront .obj file FileName and stores its unique sets of vertex attributes and its indices in Result, replacing any previous contents of Result.
+//   All variables used while parsing are local to this call (see objReaderState), so this function may be called by several threads at the same time, each with its own Result.
+//   They are all freed before this function returns, and the memory they used is returned in Statistics, if Statistics is not nullptr.
+//   It returns 0 on success, or 1 if the Wavefront .obj file cannot be opened, or a face element index is missing, 0, or refers to a vertex attribute statement that does not precede it, in which case Result is empty.
+int LoadObj(const char* FileName, const LoadObjOptions& Options, Mesh& Result, LoadObjStatistics* Statistics)
+{
+	// Wavefront .obj file format requirements:
+	// - Supported and required statements are:
+	//   Vertex attribute statements: geometric vertex statements (v x y z), vertex texture coordinate statements (vt u v), and vertex normal vector statements (vn x y z).
+	//
+	//   Face element statements: f v1/vt1/vn1 v2/vt2/vn2 v3/vt3/vn3
+	//   These specify three triplets, one triplet (e.g., v1/vt1/vn1) for each of the three vertices of a triangle, where v1, v2, v3 are geometric vertex indices, vt1, vt2, vt3 are vertex texture coordinate indices, and vn1, vn2, vn3 are vertex normal vector indices.
+	//   These indices are positive numbers referring to vertex attribute statements by the order in which the vertex attribute statements appear in the Wavefront .obj file,
+	//   or negative numbers referring to them relative to the face element statement (-1 is the last vertex attribute statement of its type before it). Every index must refer to a vertex attribute statement before the face element statement.
+	//
+	//   Vertex attribute statements are listed first, and will therefore be parsed before any face element statements.
+	//   The order of the face element statements determines the order in which the triangles must be drawn. This order is important when dealing with overlapping triangles, as the later triangles will be drawn on top of the earlier ones. Face element statements are parsed in this order.
+	//   All other statements are ignored.
+	// - No spaces are permitted before or after a slash ('/').
+	// - Statements can start in any column.
+	// - Statements can be logically joined with the line continuation character ( \ ) at the end of a line. (This is *not* supported by this program)
+	//
+	Result = Mesh();
+	objReaderState state(Options, Result);
+
+	// The Wavefront .obj file is parsed by one of two parsers, which produce the same OurVertices and OurIndices:
+	// - objReaderParseMapped (Options.MemoryMapped is true):  the file is mapped into memory and scanned in place with a pointer.
+	// - objReaderParseStream (Options.MemoryMapped is false): the file is read one statement at a time into a string, and each statement is parsed through a string stream.
+	int result = Options.MemoryMapped ? objReaderParseMapped(state, FileName) : objReaderParseStream(state, FileName);
+	if (result == 1)
+	{
+		// Cannot open the Wavefront .obj file, or a face element index is not valid.
+		Result = Mesh();
+
+		// Terminate this function with a return code indicating an error.
+		return 1;
+	}
+
+	// Assign the total number of unique sets of vertex attributes in array variable OurVertices to Result.VertexAttributeSetsTotal.
+	Result.VertexAttributeSetsTotal = state.OurVerticesi + 1;
+	// Assign the total number of triangle primitives (the total number of array elements in OurIndices / 3) to Result.PrimitivesTotal.
+	Result.PrimitivesTotal = (state.OurIndicesi + 1) / 3;
+
+	// The intermediate arrays and the hash tables are still allocated, so this is when the most memory is used.
+	if (Statistics != nullptr)
+	{
+		*Statistics = LoadObjStatistics();
+		Statistics->FileBytes = state.FileBytes;
+		Statistics->IntermediateBytes = state.IntermediateBytes;
+		Statistics->ArenaBytes = state.ArenaUpstream.Bytes;
+		Statistics->MeshBytes = Result.Vertices.capacity() * sizeof(VERTEX) + Result.Indices.capacity() * sizeof(DWORD);
+		GetProcessMemoryUsage(Statistics->ResidentBytes, Statistics->PeakResidentBytes);
+		Statistics->IoSeconds = state.IoSeconds;
+		Statistics->TokenizeSeconds = state.TokenizeSeconds;
+		Statistics->MergeSeconds = state.MergeSeconds;
+		Statistics->FacesSeconds = state.FacesSeconds;
+	}
+
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
+
+// objReader function: Definition
+//   This function loads the Wavefront .obj file objReaderFileName with the LoadObj function, using the options given by the objReader external global variables,
+//   and assigns the result to the external global variables OurVertices, OurIndices, VertexAttributeSetsTotal, and PrimitivesTotal, replacing their previous contents.
+//   It returns 0 on success, or 1 if the Wavefront .obj file cannot be opened, or a face element index is not valid (see LoadObj).
+int objReader(void)
+{
+	LoadObjOptions options;
+	options.DedupByAttributes = objReaderDedupByAttributes;
+	options.MemoryMapped = objReaderMemoryMapped;
+	options.Threads = objReaderThreads;
+	options.MinimumChunkBytes = objReaderMinimumChunkBytes;
+
+	Mesh mesh;
+	if (LoadObj(objReaderFileName, options, mesh, &objReaderStatistics) == 1)
+	{
+		// Cannot open the Wavefront .obj file, or a face element index is not valid.
+
+		// Terminate this function with a return code indicating an error.
+		return 1;
+	}
 
-	// Assign the total number of unique sets of vertex attributes in array variable OurVertices to the external global variable VertexAttributeSetsTotal.
-	VertexAttributeSetsTotal = OurVerticesi + 1;
-	// Assign the total number of triangle primitives (the total number of array elements in OurIndices / 3) to the external global variable PrimitivesTotal.
-	PrimitivesTotal = (OurIndicesi + 1) / 3;
+	// Move the Mesh's arrays into the external global variables; no vertex attributes or indices are copied.
+	OurVertices.swap(mesh.Vertices);
+	OurIndices.swap(mesh.Indices);
+	VertexAttributeSetsTotal = mesh.VertexAttributeSetsTotal;	OurVerticesi = VertexAttributeSetsTotal - 1;
+	PrimitivesTotal = mesh.PrimitivesTotal;					OurIndicesi = PrimitivesTotal * 3 - 1;
 
 	// Return to the calling program with a return code indicating success.
 	return 0;
-}
\ No newline at end of file
+}
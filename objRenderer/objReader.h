@@ -63,6 +63,44 @@ struct VERTEX {												// Vertex attributes.
 	XMFLOAT2 VertexTextureCoordinate;						// Vertex texture coordinate attribute:	.x, .y		("vt" element in the Wavefront .obj file)
 };
 
+// Declare the Mesh 'named structure' data type.
+// A Mesh holds a single 3D object's unique sets of vertex attributes and indices, as returned by the LoadObj function.
+// Its members correspond to the external global variables OurVertices, OurIndices, VertexAttributeSetsTotal, and PrimitivesTotal (see below).
+struct Mesh {
+	std::vector<VERTEX> Vertices;							// The array of unique sets of vertex attributes (see OurVertices).
+	std::vector<DWORD> Indices;								// The array of non-unique indices of Vertices, three per triangle primitive (see OurIndices).
+	int VertexAttributeSetsTotal = 0;						// The total number of array elements in Vertices.
+	int PrimitivesTotal = 0;								// The total number of triangle primitives. The total number of array elements in Indices is PrimitivesTotal * 3.
+};
+
+// Declare the LoadObjOptions 'named structure' data type.
+// The options used by the LoadObj function to parse a Wavefront .obj file. See the objReader external global variables of the same names (e.g., objReaderDedupByAttributes) for a description of each option.
+struct LoadObjOptions {
+	bool DedupByAttributes = true;
+	bool MemoryMapped = true;
+	int Threads = 0;
+	size_t MinimumChunkBytes = 1 << 20;
+};
+
+// Declare the LoadObjStatistics 'named structure' data type.
+// The memory used by the LoadObj function while parsing a Wavefront .obj file. It is used to estimate how many Wavefront .obj files can be loaded at the same time.
+// All intermediate arrays and hash tables are freed before the LoadObj function returns; only the Mesh remains.
+struct LoadObjStatistics {
+	size_t FileBytes = 0;									// The size, in bytes, of the Wavefront .obj file.
+	size_t IntermediateBytes = 0;							// The memory, in bytes, allocated for the intermediate arrays of vertex attributes and face element indices (v, vt, vn, and the chunks' face element indices).
+	size_t ArenaBytes = 0;									// The memory, in bytes, allocated by the arena holding the hash tables used to test whether a set of vertex attributes is unique.
+	size_t MeshBytes = 0;									// The memory, in bytes, allocated for the Mesh's Vertices and Indices.
+	size_t ResidentBytes = 0;								// The calling process's resident set size (working set size on Windows), in bytes, after parsing and before the intermediate arrays and hash tables are freed, i.e., when the LoadObj function uses the most memory.
+	size_t PeakResidentBytes = 0;							// The calling process's peak resident set size (peak working set size on Windows), in bytes, since the process started.
+
+	// The time, in seconds, spent in each phase of parsing, measured with a steady clock. Their sum is the time spent in the LoadObj function, less a few microseconds.
+	// The stream parser reads, tokenizes, and processes one statement at a time, so all of its time is TokenizeSeconds.
+	double IoSeconds = 0.0;									// Opening and mapping the Wavefront .obj file. The pages of a mapped file are read from disk as they are first scanned, so this excludes reading a file that is not in the file cache.
+	double TokenizeSeconds = 0.0;							// Splitting the file into chunks, and converting its characters to numbers (objReaderScanChunk function), by all threads.
+	double MergeSeconds = 0.0;								// Appending the chunks' vertex attributes in file order, and reserving memory for the Mesh and hash tables.
+	double FacesSeconds = 0.0;								// Processing the face element statements: testing each set of vertex attributes for uniqueness (deduplication) and emitting the indices. The two are interleaved triangle by triangle, so they are timed together.
+};
+
 // End: Structure Declarations.
 
 //***
@@ -87,6 +125,28 @@ extern std::vector<DWORD> OurIndices;						// Dynamically allocated array of DWO
 extern int OurIndicesi;										// The index variable OurIndicesi of array variable OurIndices[OurIndicesi].
 // A cube's 6 sides are comprised of 2 triangle primitives per side, for a total of 6 x 2 = 12 triangle primitives, each triangle primitive comprised of 3 vertices, for a total of 12 x 3 = 36 non-unique geometric vertex indices.
 extern int PrimitivesTotal;									// The total number of triangle primitives comprising a single 3D object, e.g., 12 triangle primitives specify a cube and the total number of array elements in OurIndices is PrimitivesTotal * 3 = 36.
+//
+// objReaderDedupByAttributes selects how the objReader function tests whether a set of vertex attributes is unique. It is true by default.
+//   true:  A set of vertex attributes is unique if no identical face element triplet, and no identical set of vertex attributes, has been previously found. This always produces the same OurVertices and OurIndices.
+//   false: A set of vertex attributes is unique if no identical face element triplet has been previously found. This is faster, and produces the same OurVertices and OurIndices when the vertex attribute statements of the Wavefront .obj file are unique.
+extern bool objReaderDedupByAttributes;
+//
+// objReaderFileName is the name of the Wavefront .obj file parsed by the objReader function. It is "Text.obj" by default.
+extern const char* objReaderFileName;
+//
+// objReaderMemoryMapped selects how the objReader function reads the Wavefront .obj file. It is true by default. Both produce the same OurVertices and OurIndices.
+//   true:  The file is mapped into memory and scanned in place with a pointer, converting numbers with std::from_chars. This is much faster for large files.
+//   false: The file is read one statement at a time with getline, and each statement is parsed with a string stream.
+extern bool objReaderMemoryMapped;
+//
+// objReaderThreads is the number of threads used to parse a memory-mapped Wavefront .obj file. It is 0 by default, meaning one thread per hardware thread (std::thread::hardware_concurrency).
+//   The file is split at statement boundaries into chunks of at least objReaderMinimumChunkBytes bytes (1 MB by default), so a small file, such as a cube, is parsed by a single thread. 0 is treated as 1, i.e., no minimum.
+//   OurVertices and OurIndices are the same for any number of threads.
+extern int objReaderThreads;
+extern size_t objReaderMinimumChunkBytes;
+//
+// objReaderStatistics is the memory used by the most recent call of the objReader function (see LoadObjStatistics).
+extern LoadObjStatistics objReaderStatistics;
 
 // End: External Variable Global Declarations.
 
@@ -95,7 +155,8 @@ extern int PrimitivesTotal;									// The total number of triangle primitives c
 // Function prototypes for functions (e.g., objReader) called by programs (e.g., objRenderer) that include this header file. They are optional in the functions named here (e.g., objReader).
 //***
 
-int objReader(void);										// The objReader function parses a single 3D object's Wavefront .obj file and uses it to populate the external global variables OurVertices and OurIndices.
+int LoadObj(const char* FileName, const LoadObjOptions& Options, Mesh& Result, LoadObjStatistics* Statistics = nullptr);	// The LoadObj function parses a single 3D object's Wavefront .obj file and returns it in Result, and the memory it used in Statistics (if not nullptr). It uses no external global variables, so several threads may call it at the same time.
+int objReader(void);										// The objReader function parses a single 3D object's Wavefront .obj file (objReaderFileName) with the LoadObj function and uses it to populate the external global variables OurVertices and OurIndices.
 
 // End: Global Function Declarations.
 
@@ -0,0 +1,495 @@
+// objReaderBenchmark
+// Version 3.1
+//
+// Description
+// These functions write synthetic Wavefront .obj files and measure how fast the LoadObj function loads them.
+// A synthetic file is a grid of quads mapped onto a surface, written the way Blender writes a Wavefront .obj file: all v statements, then all vt statements, then all vn statements, then all f statements,
+// with six decimal places for geometric vertices and vertex texture coordinates, and four for vertex normal vectors, except for a noisy scan, whose numbers are written with all of their digits.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Wavefront .obj file benchmark Header File.
+// Includes the Wavefront .obj file I/O Header File.
+#include "objReaderBenchmark.h"
+
+// Process memory usage Header File.
+#include "processMemory.h"
+
+// Standard Encapsulated Data and Functions for Manipulating String Data.
+#include <string>											// String class, used to build file names and the output buffer.
+
+// File Stream Functions.
+#include <fstream>											// File stream class member functions write, close, etc.
+
+// Memory Functions.
+#include <cstring>											// Memory function memcmp.
+
+// Character Conversion Functions.
+#include <charconv>											// Character conversion function to_chars.
+
+// Math Functions.
+#include <cmath>											// Math functions sqrt, sin, cos, ceil, log.
+
+// Steady Clock.
+#include <chrono>											// Steady clock, used to time the LoadObj function.
+
+// File System Functions.
+#include <filesystem>										// File system functions file_size, remove.
+
+// Using Declarations and Directives.
+using std::string;
+using std::vector;
+using std::ofstream;
+using std::to_chars;
+using std::chars_format;
+using std::memcmp;
+namespace chrono = std::chrono;
+namespace fs = std::filesystem;
+
+//***
+// External Variable Global Definitions.
+//***
+
+const char* const ObjShapeNames[OBJ_SHAPES_TOTAL] = { "Grid", "Sphere", "Scan" };
+
+// End: External Variable Global Definitions.
+
+// The numbers of triangles, and the fractions of triangles sharing their vertex attribute statements, generated by the RunObjReaderBenchmarks function.
+static const unsigned long long ObjBenchmarkTriangles[] = { 1000, 10000, 100000, 1000000, 10000000, 50000000 };
+static const double ObjBenchmarkSharedFractions[] = { 1.0, 0.5, 0.0 };
+
+// The number of triangles of the smallest file generated by the RunObjReaderFaceScaling function, and of the smallest file its exponent is fitted to.
+static const unsigned long long ObjScalingFirstTriangles = 1000;
+static const int ObjScalingFitTriangles = 16000;
+
+// The size, in bytes, of the buffer the GenerateObj function fills before writing it to the file.
+static const size_t ObjGeneratorBufferBytes = 1 << 20;
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// Return a random number from 0 to 1 (excluding 1) for Index, the same for the same Seed and Index on every platform (the SplitMix64 function).
+static double ObjRandom(unsigned int Seed, unsigned long long Index)
+{
+	unsigned long long z = Index * 0x9E3779B97F4A7C15ULL + ((unsigned long long)Seed << 32) + 0x9E3779B97F4A7C15ULL;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	z ^= z >> 31;
+	return (double)(z >> 11) / 9007199254740992.0;			// The top 53 bits, divided by 2^53.
+}
+
+// Declare the ObjGeneratorVertex 'named structure' data type.
+// One vertex of the grid: the values of its v, vt, and vn statements.
+struct ObjGeneratorVertex {
+	float Position[3];
+	float Coordinate[2];
+	float Normal[3];
+};
+
+// Set Vertex to the vertex of the grid in column i and row j of Options.Shape, a grid of Columns by Rows quads.
+static void ObjGeneratorGetVertex(const ObjGeneratorOptions& Options, unsigned long long Columns, unsigned long long Rows, unsigned long long i, unsigned long long j, ObjGeneratorVertex& Vertex)
+{
+	const double pi = 3.14159265358979323846;
+	double u = (double)i / Columns;
+	double v = (double)j / Rows;
+	Vertex.Coordinate[0] = (float)u;
+	Vertex.Coordinate[1] = (float)v;
+
+	if (Options.Shape == OBJ_SHAPE_SPHERE)
+	{
+		// Column i is a line of longitude, and row j a line of latitude from the north pole (j = 0) to the south pole (j = Rows). The normal vector of a unit sphere is its position.
+		double theta = pi * v;
+		double phi = 2.0 * pi * u;
+		Vertex.Position[0] = Vertex.Normal[0] = (float)(sin(theta) * cos(phi));
+		Vertex.Position[1] = Vertex.Normal[1] = (float)cos(theta);
+		Vertex.Position[2] = Vertex.Normal[2] = (float)(sin(theta) * sin(phi));
+		return;
+	}
+
+	double x = u * 2.0 - 1.0;
+	double y = v * 2.0 - 1.0;
+	if (Options.Shape == OBJ_SHAPE_GRID)
+	{
+		Vertex.Position[0] = (float)x; Vertex.Position[1] = (float)y; Vertex.Position[2] = 0.0f;
+		Vertex.Normal[0] = 0.0f; Vertex.Normal[1] = 0.0f; Vertex.Normal[2] = 1.0f;
+		return;
+	}
+
+	// A noisy scan: a gently waving surface, each vertex moved by up to a third of a quad in x and y, and by random noise in z. The normal vector is the surface's, tilted by random noise.
+	unsigned long long index = (j * (Columns + 1) + i) * 6;
+	double cellX = 2.0 / Columns, cellY = 2.0 / Rows;
+	x += (ObjRandom(Options.Seed, index) - 0.5) * cellX * 0.66;
+	y += (ObjRandom(Options.Seed, index + 1) - 0.5) * cellY * 0.66;
+	double z = 0.1 * sin(3.0 * x) * cos(2.0 * y) + (ObjRandom(Options.Seed, index + 2) - 0.5) * 0.01;
+	double nx = -0.3 * cos(3.0 * x) * cos(2.0 * y) + (ObjRandom(Options.Seed, index + 3) - 0.5) * 0.1;
+	double ny = 0.2 * sin(3.0 * x) * sin(2.0 * y) + (ObjRandom(Options.Seed, index + 4) - 0.5) * 0.1;
+	double nz = 1.0;
+	double length = sqrt(nx * nx + ny * ny + nz * nz);
+	Vertex.Position[0] = (float)x; Vertex.Position[1] = (float)y; Vertex.Position[2] = (float)z;
+	Vertex.Normal[0] = (float)(nx / length); Vertex.Normal[1] = (float)(ny / length); Vertex.Normal[2] = (float)(nz / length);
+}
+
+// Return true if triangle number Triangle refers to the shared vertex attribute statements, or false if it refers to its own copies of them.
+static bool ObjGeneratorShared(const ObjGeneratorOptions& Options, unsigned long long Triangle)
+{
+	return Options.SharedFraction >= 1.0 || ObjRandom(Options.Seed ^ 0x5A5A5A5Au, Triangle) < Options.SharedFraction;
+}
+
+// Append Value to Buffer: with Decimals decimal places, or with all the digits needed to read it back exactly if Decimals is negative.
+static void ObjGeneratorAppend(string& Buffer, float Value, int Decimals)
+{
+	char text[32];
+	std::to_chars_result result = Decimals < 0 ? to_chars(text, text + sizeof(text), Value) : to_chars(text, text + sizeof(text), Value, chars_format::fixed, Decimals);
+	Buffer.push_back(' ');
+	Buffer.append(text, result.ptr);
+}
+
+// Append the v, vt, or vn statement (Type 0, 1, or 2) of Vertex to Buffer.
+static void ObjGeneratorAppendStatement(string& Buffer, const ObjGeneratorOptions& Options, const ObjGeneratorVertex& Vertex, int Type)
+{
+	bool scan = Options.Shape == OBJ_SHAPE_SCAN;
+	if (Type == 0)
+	{
+		Buffer += "v";
+		for (int k = 0; k <= 2; k++)
+			ObjGeneratorAppend(Buffer, Vertex.Position[k], scan ? -1 : 6);
+	} else if (Type == 1)
+	{
+		Buffer += "vt";
+		for (int k = 0; k <= 1; k++)
+			ObjGeneratorAppend(Buffer, Vertex.Coordinate[k], scan ? -1 : 6);
+	} else
+	{
+		Buffer += "vn";
+		for (int k = 0; k <= 2; k++)
+			ObjGeneratorAppend(Buffer, Vertex.Normal[k], scan ? -1 : 4);
+	}
+	Buffer.push_back('\n');
+}
+
+// GenerateObj function: Definition
+//   This function writes a grid of Columns by Rows quads, as square as possible, of two triangles each, with at least Options.TrianglesTotal triangles:
+//   1. The v, vt, and vn statements of every vertex of the grid, shared by the triangles around it, if any triangle shares them.
+//   2. The v, vt, and vn statements of the three corners of every triangle that does not share them (see ObjGeneratorOptions::SharedFraction).
+//   3. The f statements, in row order. Every vertex has one statement of each type, so each face element triplet is v/v/v.
+//   It returns 0 on success, or 1 if the file cannot be written.
+int GenerateObj(const char* FileName, const ObjGeneratorOptions& Options)
+{
+	unsigned long long quadsTotal = (Options.TrianglesTotal + 1) / 2;
+	if (quadsTotal == 0)
+		quadsTotal = 1;
+	unsigned long long columns = (unsigned long long)ceil(sqrt((double)quadsTotal));
+	unsigned long long rows = (quadsTotal + columns - 1) / columns;
+	unsigned long long trianglesTotal = columns * rows * 2;
+	bool anyShared = Options.SharedFraction > 0.0;
+
+	ofstream file(FileName, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!file)
+		return 1;
+	string buffer;
+	buffer.reserve(ObjGeneratorBufferBytes + 256);
+	auto flush = [&](bool Always)
+	{
+		if (Always || buffer.size() >= ObjGeneratorBufferBytes)
+		{
+			file.write(buffer.data(), (std::streamsize)buffer.size());
+			buffer.clear();
+		}
+	};
+	buffer += "# objReaderBenchmark: ";
+	buffer += ObjShapeNames[Options.Shape];
+	buffer += ", " + std::to_string(trianglesTotal) + " triangles, shared fraction " + std::to_string(Options.SharedFraction) + ", seed " + std::to_string(Options.Seed) + "\n";
+
+	// 1. The vertex attribute statements shared by the triangles around each vertex, one type at a time.
+	ObjGeneratorVertex vertex;
+	if (anyShared)
+	{
+		for (int type = 0; type <= 2; type++)
+		{
+			for (unsigned long long j = 0; j <= rows; j++)
+			{
+				for (unsigned long long i = 0; i <= columns; i++)
+				{
+					ObjGeneratorGetVertex(Options, columns, rows, i, j, vertex);
+					ObjGeneratorAppendStatement(buffer, Options, vertex, type);
+					flush(false);
+				}
+			}
+		}
+	}
+
+	// The corners of triangle t, in counter-clockwise order: (i, j), (i + 1, j), (i + 1, j + 1) for the first triangle of a quad, and (i, j), (i + 1, j + 1), (i, j + 1) for the second.
+	auto corner = [&](unsigned long long t, int c, unsigned long long& i, unsigned long long& j)
+	{
+		static const int offsets[2][3][2] = { { { 0, 0 }, { 1, 0 }, { 1, 1 } }, { { 0, 0 }, { 1, 1 }, { 0, 1 } } };
+		unsigned long long quad = t / 2;
+		i = quad % columns + offsets[t % 2][c][0];
+		j = quad / columns + offsets[t % 2][c][1];
+	};
+
+	// 2. The copies of the vertex attribute statements of the triangles that do not share them, one type at a time.
+	if (Options.SharedFraction < 1.0)
+	{
+		for (int type = 0; type <= 2; type++)
+		{
+			for (unsigned long long t = 0; t < trianglesTotal; t++)
+			{
+				if (ObjGeneratorShared(Options, t))
+					continue;
+				for (int c = 0; c <= 2; c++)
+				{
+					unsigned long long i, j;
+					corner(t, c, i, j);
+					ObjGeneratorGetVertex(Options, columns, rows, i, j, vertex);
+					ObjGeneratorAppendStatement(buffer, Options, vertex, type);
+				}
+				flush(false);
+			}
+		}
+	}
+
+	// 3. The face element statements. The copies of step 2 are numbered after the shared statements, in triangle order.
+	unsigned long long copy = anyShared ? (columns + 1) * (rows + 1) + 1 : 1;
+	for (unsigned long long t = 0; t < trianglesTotal; t++)
+	{
+		bool shared = ObjGeneratorShared(Options, t);
+		buffer += "f";
+		for (int c = 0; c <= 2; c++)
+		{
+			unsigned long long index;
+			if (shared)
+			{
+				unsigned long long i, j;
+				corner(t, c, i, j);
+				index = j * (columns + 1) + i + 1;
+			} else
+				index = copy++;
+			char text[24];
+			char* textEnd = to_chars(text, text + sizeof(text), index).ptr;
+			for (int k = 0; k <= 2; k++)
+			{
+				buffer.push_back(k == 0 ? ' ' : '/');
+				buffer.append(text, textEnd);
+			}
+		}
+		buffer.push_back('\n');
+		flush(false);
+	}
+	flush(true);
+
+	file.close();
+	return file ? 0 : 1;
+}
+
+// BenchmarkObjReader function: Definition
+//   This function loads FileName Repetitions times, destroying the Mesh after each, and returns the phases of the fastest repetition, which is the least disturbed by other programs.
+//   ResidentBytes is the largest of all repetitions. Every repetition after the first reads the file from the file cache, so IoSeconds measures mapping, not reading from disk.
+int BenchmarkObjReader(const char* FileName, const LoadObjOptions& Options, int Repetitions, ObjBenchmarkResult& Result)
+{
+	Result = ObjBenchmarkResult();
+	Result.Repetitions = Repetitions < 1 ? 1 : Repetitions;
+	Result.Threads = Options.Threads;
+	for (int r = 0; r < Result.Repetitions; r++)
+	{
+		Mesh mesh;
+		LoadObjStatistics statistics;
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		if (LoadObj(FileName, Options, mesh, &statistics) == 1)
+			return 1;
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+		if (r == 0 || seconds < Result.TotalSeconds)
+		{
+			Result.TotalSeconds = seconds;
+			Result.IoSeconds = statistics.IoSeconds;
+			Result.TokenizeSeconds = statistics.TokenizeSeconds;
+			Result.MergeSeconds = statistics.MergeSeconds;
+			Result.FacesSeconds = statistics.FacesSeconds;
+		}
+		if (Result.ResidentBytes < statistics.ResidentBytes)
+			Result.ResidentBytes = statistics.ResidentBytes;
+		Result.FileBytes = statistics.FileBytes;
+		Result.PrimitivesTotal = mesh.PrimitivesTotal;
+		Result.VertexAttributeSetsTotal = mesh.VertexAttributeSetsTotal;
+	}
+
+	size_t residentBytes;
+	GetProcessMemoryUsage(residentBytes, Result.PeakResidentBytes);
+	if (Result.TotalSeconds > 0.0)
+	{
+		Result.MegabytesPerSecond = Result.FileBytes / 1048576.0 / Result.TotalSeconds;
+		Result.TrianglesPerSecond = Result.PrimitivesTotal / Result.TotalSeconds;
+	}
+
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
+
+// RunObjReaderBenchmarks function: Definition
+//   This function generates, benchmarks, and deletes one file in Directory for each shape, each number of triangles in ObjBenchmarkTriangles up to MaximumTriangles, and each fraction in ObjBenchmarkSharedFractions, smallest first.
+//   The peak resident set size of a process never decreases, so it is the peak of the largest file benchmarked so far; benchmarking the smallest files first makes it the peak of each file.
+//   ResultsFileName (if not nullptr) is written again after each file, so an interrupted suite keeps the results of the files benchmarked so far.
+//   It returns 0 on success, or 1 if a file cannot be written or loaded.
+int RunObjReaderBenchmarks(const char* Directory, unsigned long long MaximumTriangles, const LoadObjOptions& Options, int Repetitions, const char* ResultsFileName, vector<ObjBenchmarkResult>& Results)
+{
+	Results.clear();
+	for (unsigned long long trianglesTotal : ObjBenchmarkTriangles)
+	{
+		if (trianglesTotal > MaximumTriangles)
+			break;
+		for (int shape = 0; shape < OBJ_SHAPES_TOTAL; shape++)
+		{
+			for (double sharedFraction : ObjBenchmarkSharedFractions)
+			{
+				ObjGeneratorOptions generator;
+				generator.Shape = (ObjShape)shape;
+				generator.TrianglesTotal = trianglesTotal;
+				generator.SharedFraction = sharedFraction;
+				string fileName = string(Directory) + "/objReaderBenchmark." + ObjShapeNames[shape] + "." + std::to_string(trianglesTotal) + "." + std::to_string((int)(sharedFraction * 100)) + ".obj";
+
+				ObjBenchmarkResult result;
+				int failed = GenerateObj(fileName.c_str(), generator) || BenchmarkObjReader(fileName.c_str(), Options, Repetitions, result);
+				std::error_code error;
+				fs::remove(fileName, error);
+				if (failed)
+					return 1;
+				result.Shape = generator.Shape;
+				result.SharedFraction = sharedFraction;
+				Results.push_back(result);
+				if (ResultsFileName != nullptr && SaveObjBenchmarkCsv(ResultsFileName, Results) == 1)
+					return 1;
+			}
+		}
+	}
+
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
+
+// RunObjReaderFaceScaling function: Definition
+//   This function generates, benchmarks, and deletes one file of Shape in Directory for each number of triangles from ObjScalingFirstTriangles, doubling, up to MaximumTriangles, every triangle sharing its vertex attribute statements.
+//   Exponent is the slope of the least-squares line through the points (log triangles, log TotalSeconds) of the files of at least ObjScalingFitTriangles triangles (of every file, if fewer than two are that large):
+//   the time of the LoadObj function grows as the number of triangles to the power Exponent, so it is close to 1 if the time grows linearly, and close to 2 if it grows quadratically, as it did when each set of vertex attributes was compared with every unique set before it.
+//   The smaller files are excluded from the line because their time is dominated by the fixed cost of opening the file and starting the threads.
+//   It returns 0 on success, or 1 if a file cannot be written or loaded.
+int RunObjReaderFaceScaling(const char* Directory, ObjShape Shape, unsigned long long MaximumTriangles, const LoadObjOptions& Options, int Repetitions, const char* ResultsFileName, vector<ObjBenchmarkResult>& Results, double& Exponent)
+{
+	Results.clear();
+	Exponent = 0.0;
+	for (unsigned long long trianglesTotal = ObjScalingFirstTriangles; trianglesTotal <= MaximumTriangles; trianglesTotal *= 2)
+	{
+		ObjGeneratorOptions generator;
+		generator.Shape = Shape;
+		generator.TrianglesTotal = trianglesTotal;
+		generator.SharedFraction = 1.0;
+		string fileName = string(Directory) + "/objReaderScaling." + ObjShapeNames[Shape] + "." + std::to_string(trianglesTotal) + ".obj";
+
+		ObjBenchmarkResult result;
+		int failed = GenerateObj(fileName.c_str(), generator) || BenchmarkObjReader(fileName.c_str(), Options, Repetitions, result);
+		std::error_code error;
+		fs::remove(fileName, error);
+		if (failed)
+			return 1;
+		result.Shape = Shape;
+		result.SharedFraction = generator.SharedFraction;
+		Results.push_back(result);
+		if (ResultsFileName != nullptr && SaveObjBenchmarkCsv(ResultsFileName, Results) == 1)
+			return 1;
+	}
+
+	// Fit the line by least squares, on the large files only if there are enough of them.
+	int largeTotal = 0;
+	for (const ObjBenchmarkResult& result : Results)
+		if (result.PrimitivesTotal >= ObjScalingFitTriangles)
+			largeTotal++;
+	double n = 0.0, sumX = 0.0, sumY = 0.0, sumXX = 0.0, sumXY = 0.0;
+	for (const ObjBenchmarkResult& result : Results)
+	{
+		if ((largeTotal >= 2 && result.PrimitivesTotal < ObjScalingFitTriangles) || result.TotalSeconds <= 0.0)
+			continue;
+		double x = log((double)result.PrimitivesTotal);
+		double y = log(result.TotalSeconds);
+		n += 1.0;
+		sumX += x;
+		sumY += y;
+		sumXX += x * x;
+		sumXY += x * y;
+	}
+	double denominator = n * sumXX - sumX * sumX;
+	if (n >= 2.0 && denominator > 0.0)
+		Exponent = (n * sumXY - sumX * sumY) / denominator;
+
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
+
+// RunObjReaderThreadScaling function: Definition
+//   This function generates one file of Shape and TrianglesTotal triangles in Directory, benchmarks it with 1, 2, 4, and so on, up to MaximumThreads threads (and with MaximumThreads itself, if it is not a power of 2), then deletes it.
+//   A file is only split into as many chunks as it has Options.MinimumChunkBytes, so a file must be at least MaximumThreads times Options.MinimumChunkBytes for every thread to parse a chunk; the threads without one do nothing.
+//   The LoadObj function must load the same Mesh with any number of threads, so the Mesh of every number of threads is compared with the Mesh of 1 thread, byte for byte.
+//   It returns 0 on success, or 1 if the file cannot be written or loaded, or a number of threads loads a different Mesh than 1 thread.
+int RunObjReaderThreadScaling(const char* Directory, ObjShape Shape, unsigned long long TrianglesTotal, int MaximumThreads, const LoadObjOptions& Options, int Repetitions, const char* ResultsFileName, vector<ObjBenchmarkResult>& Results)
+{
+	Results.clear();
+	ObjGeneratorOptions generator;
+	generator.Shape = Shape;
+	generator.TrianglesTotal = TrianglesTotal;
+	string fileName = string(Directory) + "/objReaderThreads." + ObjShapeNames[Shape] + "." + std::to_string(TrianglesTotal) + ".obj";
+	if (GenerateObj(fileName.c_str(), generator) == 1)
+		return 1;
+
+	int failed = 0;
+	Mesh first;												// The Mesh loaded with 1 thread.
+	for (int threads = 1; threads <= MaximumThreads; threads = threads * 2 < MaximumThreads ? threads * 2 : MaximumThreads)
+	{
+		LoadObjOptions options = Options;
+		options.Threads = threads;
+		Mesh mesh;
+		ObjBenchmarkResult result;
+		failed = LoadObj(fileName.c_str(), options, threads == 1 ? first : mesh) || BenchmarkObjReader(fileName.c_str(), options, Repetitions, result);
+		if (failed)
+			break;
+		if (threads > 1)
+			failed = mesh.PrimitivesTotal != first.PrimitivesTotal || mesh.Indices != first.Indices || mesh.Vertices.size() != first.Vertices.size() ||
+				memcmp(mesh.Vertices.data(), first.Vertices.data(), first.Vertices.size() * sizeof(VERTEX)) != 0;
+		result.Shape = Shape;
+		result.SharedFraction = generator.SharedFraction;
+		Results.push_back(result);
+		if (!failed && ResultsFileName != nullptr && SaveObjBenchmarkCsv(ResultsFileName, Results) == 1)
+			failed = 1;
+		if (failed || threads == MaximumThreads)
+			break;
+	}
+	std::error_code error;
+	fs::remove(fileName, error);
+
+	// Return to the calling program with a return code indicating success or failure.
+	return failed;
+}
+
+// SaveObjBenchmarkCsv function: Definition
+//   This function writes a header line, then one line per result: the shape, the number of triangles and unique sets of vertex attributes, the shared fraction, the file size, the number of repetitions and threads,
+//   the time of each phase and the total time in seconds, megabytes and triangles per second, and the resident and peak resident set sizes in bytes.
+int SaveObjBenchmarkCsv(const char* FileName, const vector<ObjBenchmarkResult>& Results)
+{
+	ofstream file(FileName, std::ios::out | std::ios::trunc);
+	if (!file)
+		return 1;
+	file << "Shape,Triangles,Vertices,SharedFraction,FileBytes,Repetitions,Threads,IoSeconds,TokenizeSeconds,MergeSeconds,FacesSeconds,TotalSeconds,MegabytesPerSecond,TrianglesPerSecond,ResidentBytes,PeakResidentBytes\n";
+	for (const ObjBenchmarkResult& result : Results)
+	{
+		file << ObjShapeNames[result.Shape] << ',' << result.PrimitivesTotal << ',' << result.VertexAttributeSetsTotal << ',' << result.SharedFraction << ',' << result.FileBytes << ',' << result.Repetitions << ',' << result.Threads << ','
+			<< result.IoSeconds << ',' << result.TokenizeSeconds << ',' << result.MergeSeconds << ',' << result.FacesSeconds << ',' << result.TotalSeconds << ','
+			<< result.MegabytesPerSecond << ',' << result.TrianglesPerSecond << ',' << result.ResidentBytes << ',' << result.PeakResidentBytes << '\n';
+	}
+	file.close();
+	return file ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+// objReaderBenchmark Header File
+// Version 3.1
+//
+// Description
+// Wavefront .obj file benchmark Header File
+// This header file contains the declarations used to measure the performance of the LoadObj function apart from the objRenderer program, on Wavefront .obj files of any size.
+// The GenerateObj function writes a synthetic Wavefront .obj file (a grid, a sphere, or a noisy scan) of a given number of triangles, in the format the LoadObj function requires.
+// The BenchmarkObjReader function times the LoadObj function's phases on one file, and the RunObjReaderBenchmarks function generates and times a whole suite of files and writes the results to a .csv file, one line per file,
+// so the results of two versions of the LoadObj function can be compared line by line.
+// None of these functions use Direct3D, so they can be built and run on any platform the objReader function builds on, e.g., Linux.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Wavefront .obj file I/O Header File.
+// Declares the LoadObjOptions and LoadObjStatistics structures.
+#include "objReader.h"
+
+// Vector Container Class.
+#include <vector>											// Vector class, used to return the results of a suite.
+
+//***
+// Enumeration Declarations.
+//***
+
+// The shapes written by the GenerateObj function. Each is a grid of quads, two triangles per quad, mapped onto a surface.
+enum ObjShape {
+	OBJ_SHAPE_GRID,											// A flat square grid, whose vertex normal vectors are all the same.
+	OBJ_SHAPE_SPHERE,										// A sphere of latitude and longitude lines: the first and last rows of quads are degenerate at the poles, and the normal vectors vary.
+	OBJ_SHAPE_SCAN,											// A height field with random noise, like a 3D scan: every number has all of its digits, and the triangles are irregular.
+	OBJ_SHAPES_TOTAL
+};
+
+// End: Enumeration Declarations.
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the ObjGeneratorOptions 'named structure' data type.
+// The options used by the GenerateObj function to write a synthetic Wavefront .obj file.
+struct ObjGeneratorOptions {
+	ObjShape Shape = OBJ_SHAPE_GRID;
+	unsigned long long TrianglesTotal = 1000;				// The number of triangles (face element statements). The grid is as square as possible with at least this many triangles, so the file may have slightly more.
+	double SharedFraction = 1.0;							// The fraction, from 0 to 1, of triangles whose corners refer to the vertex attribute statements shared with their neighbors.
+															// Every other triangle refers to its own copies of those statements, with identical values, as a program writing one triangle at a time would,
+															// so 1 gives about 6 triangles per unique set of vertex attributes, and 0 gives 3 vertex attribute statements of each type per triangle, merged only when LoadObjOptions::DedupByAttributes is true.
+	unsigned int Seed = 1;									// The seed of the random numbers, so the same options always write the same file.
+};
+
+// Declare the ObjBenchmarkResult 'named structure' data type.
+// The performance of the LoadObj function on one Wavefront .obj file: the fastest of several repetitions.
+struct ObjBenchmarkResult {
+	ObjShape Shape = OBJ_SHAPE_GRID;						// The shape and options the file was generated with, if it was generated by the RunObjReaderBenchmarks function.
+	double SharedFraction = 0.0;
+	size_t FileBytes = 0;									// The size, in bytes, of the Wavefront .obj file.
+	int PrimitivesTotal = 0;								// The number of triangles loaded.
+	int VertexAttributeSetsTotal = 0;						// The number of unique sets of vertex attributes loaded.
+	int Repetitions = 0;									// The number of times the file was loaded.
+	int Threads = 0;										// The number of threads the file was loaded with (LoadObjOptions::Threads; 0 is one per processor).
+	double IoSeconds = 0.0;									// The time spent in each phase of the fastest repetition (see LoadObjStatistics).
+	double TokenizeSeconds = 0.0;
+	double MergeSeconds = 0.0;
+	double FacesSeconds = 0.0;
+	double TotalSeconds = 0.0;								// The time spent in the LoadObj function by the fastest repetition.
+	double MegabytesPerSecond = 0.0;						// FileBytes / 2^20 / TotalSeconds.
+	double TrianglesPerSecond = 0.0;						// PrimitivesTotal / TotalSeconds.
+	size_t ResidentBytes = 0;								// The resident set size (working set size on Windows), in bytes, when the LoadObj function used the most memory (see LoadObjStatistics).
+	size_t PeakResidentBytes = 0;							// The peak resident set size (peak working set size on Windows), in bytes, of the process since it started, after the file was loaded.
+};
+
+// End: Structure Declarations.
+
+//***
+// External Variable Global Declarations.
+//***
+
+// The shape names written to the .csv file of the RunObjReaderBenchmarks function.
+extern const char* const ObjShapeNames[OBJ_SHAPES_TOTAL];
+
+// End: External Variable Global Declarations.
+
+//***
+// Global Function Declarations.
+//***
+
+int GenerateObj(const char* FileName, const ObjGeneratorOptions& Options);												// The GenerateObj function writes a synthetic Wavefront .obj file. It returns 0 on success, or 1 if the file cannot be written.
+int BenchmarkObjReader(const char* FileName, const LoadObjOptions& Options, int Repetitions, ObjBenchmarkResult& Result);	// The BenchmarkObjReader function loads FileName Repetitions times with the LoadObj function and returns the fastest time in Result. It returns 0 on success, or 1 if the file cannot be loaded.
+int RunObjReaderBenchmarks(const char* Directory, unsigned long long MaximumTriangles, const LoadObjOptions& Options, int Repetitions,
+	const char* ResultsFileName, std::vector<ObjBenchmarkResult>& Results);																// The RunObjReaderBenchmarks function generates and benchmarks every shape, from 1K triangles up to MaximumTriangles, and writes the results to ResultsFileName. It returns 0 on success, or 1 if a file cannot be written or loaded.
+int RunObjReaderFaceScaling(const char* Directory, ObjShape Shape, unsigned long long MaximumTriangles, const LoadObjOptions& Options, int Repetitions,
+	const char* ResultsFileName, std::vector<ObjBenchmarkResult>& Results, double& Exponent);											// The RunObjReaderFaceScaling function benchmarks Shape from 1K triangles, doubling, up to MaximumTriangles, writes the results to ResultsFileName, and returns in Exponent how the time grows with the number of triangles (1 is linear). It returns 0 on success, or 1 if a file cannot be written or loaded.
+int RunObjReaderThreadScaling(const char* Directory, ObjShape Shape, unsigned long long TrianglesTotal, int MaximumThreads, const LoadObjOptions& Options, int Repetitions,
+	const char* ResultsFileName, std::vector<ObjBenchmarkResult>& Results);																// The RunObjReaderThreadScaling function benchmarks one file of Shape with 1 thread, doubling, up to MaximumThreads, and writes the results to ResultsFileName. It returns 0 on success, or 1 if the file cannot be written or loaded, or a number of threads loads a different Mesh than 1 thread.
+int SaveObjBenchmarkCsv(const char* FileName, const std::vector<ObjBenchmarkResult>& Results);							// The SaveObjBenchmarkCsv function writes a header line and one line per result to a .csv file. It returns 0 on success, or 1 if the file cannot be written.
+
+// End: Global Function Declarations.
+
+// End: Global Declarations.
@@ -39,6 +39,78 @@
 // Includes the DirectXMath Header File.
 #include "objReader.h"
 
+// Binary mesh cache (.objbin file) I/O Header File.
+// Declares the functions that save the final OurVertices and OurIndices to a binary mesh cache file, and load them back without parsing the Wavefront .obj file.
+#include "meshCache.h"
+
+// Vertex welding Header File.
+// Declares the function that merges the sets of vertex attributes of OurVertices that are nearly identical, i.e., within a tolerance rather than exactly equal.
+#include "vertexWelder.h"
+
+// Mesh optimization Header File.
+// Declares the functions that reorder OurIndices for the GPU's post-transform vertex cache, and OurVertices for the GPU's vertex fetch.
+#include "meshOptimizer.h"
+
+// Packed vertex format Header File.
+// Declares the PACKEDVERTEX structure, and the functions that pack OurVertices and OurIndices into it and into 16-bit indices.
+#include "vertexPacking.h"
+
+// Mesh simplification Header File.
+// Declares the MeshLod structure, and the functions that build levels of detail from OurIndices and select the level of detail drawn.
+#include "meshSimplifier.h"
+
+// Meshlet (cluster) Header File.
+// Declares the Meshlet structure, and the functions that partition OurIndices into meshlets and cull them before each instance of the object is drawn.
+#include "meshletBuilder.h"
+
+// Instance data Header File.
+// Declares the functions that cull the instances of the object and fill the instance buffer, and includes the Batch instance transform Header File (the InstanceTransformArrays and INSTANCEDATA structures).
+#include "instanceBuilder.h"
+
+// Job system Header File.
+// Declares the functions that run the CPU work of each frame as jobs, and the function that stops the worker threads that run them.
+#include "jobSystem.h"
+
+// Software rasterizer Header File.
+// Declares the functions that render each frame on the CPU as well, when SoftwareRasterizerEnabled is true, and includes the Image file I/O Header File (the Image structure, and the functions that read the texture image and write the rendered frame).
+#include "softwareRasterizer.h"
+
+// Texture cache (.dds file) I/O Header File.
+// Declares the functions that cook the texture image file into a block-compressed mipmap chain, and load it back.
+#include "textureCache.h"
+
+// Shader cache (.cso file) I/O Header File.
+// Declares the functions that compile the shaders, or load their bytecode from shader cache files.
+#include "shaderCache.h"
+
+// Upload ring allocator Header File.
+// Declares the functions that sub-allocate the dynamic buffer the constant buffers are written to each frame.
+#include "uploadRing.h"
+
+// Frame profiler Header File.
+// Declares the timers of each stage of a frame, and the functions that write their statistics.
+#include "frameProfiler.h"
+
+// Frame clock Header File.
+// Declares the schedule of frames and fixed timesteps of animation, and the frame rate limit.
+#include "frameClock.h"
+
+// Render queue Header File.
+// Declares the render queue the draws of each frame are recorded into, sorted, and executed from, with the binds of state already bound skipped.
+#include "renderQueue.h"
+
+// Mesh upload manager Header File.
+// Declares the queue of static vertex buffers and index buffers uploaded to GPU memory, at most MeshUploadFrameBudget bytes per frame.
+#include "meshUpload.h"
+
+// Mesh residency Header File.
+// Declares the policy applied to the CPU's copy of the object once it is uploaded (keep, drop, or keep compressed), and the functions that compress and decompress it.
+#include "meshResidency.h"
+
+// Memory accounting Header File.
+// Declares the categories of memory reported when F2 is pressed, and the functions that record and write them.
+#include "memoryAccounting.h"
+
 // Windows API Header File.
 #include <windows.h>										// The Windows API (Win32 API) header file enables you to create 32-bit and 64-bit applications. It includes declarations for both Unicode and ANSI versions of the API. For more information, see Unicode in the Windows API.
 
@@ -46,9 +118,30 @@
 int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow);
 LRESULT CALLBACK WindowProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam);
 int InitD3D(HWND hWnd);
-void InitPipeline(void);
+int CompilePipelineShaders(ShaderProgram& VertexShader, ShaderProgram& PixelShader);
+int InitPipeline(void);
+void ReloadShaders(void);
 int InitGraphics(void);
-void RenderFrame(void);
+void PlaceObjectInstances(void);
+void AnimateObjectInstances(const XMFLOAT4& Rotation, const XMFLOAT4& Rotation2);
+int CullObjectMeshlets(FXMMATRIX matWorld, CXMMATRIX matFinal, FXMVECTOR EyePosition, int Lod, std::vector<MeshletRun>& Runs, MeshletCullStatistics& Statistics);
+void CullInstanceMeshlets(FXMMATRIX matViewProjection, FXMVECTOR EyePosition);
+void RecordInstanceDraws(void);
+void EnqueueObjectVertices(const VERTEX* Vertices, const VertexPackingBounds& PackingBounds);
+void EnqueueObjectIndices(const DWORD* Indices, const DWORD* LodIndices, int LodIndicesTotal);
+void UploadMeshes(void);
+void ApplyMeshResidency(void);
+int RestoreObjectMesh(void);
+void ReuploadObjectMesh(void);
+UINT BufferBytes(ID3D11Buffer* Buffer);
+void UpdateMemoryAccounting(void);
+void SaveMemoryReport(void);
+void RetireFrames(void);
+void WriteConstantBuffer(UINT Slot, const void* Data, UINT Size, ID3D11Buffer* Buffer);
+void GpuProfileTimestamp(int Point);
+void SaveFrameProfile(void);
+void UpdateSimulation(float StepSeconds);
+void RenderFrame(float Alpha);
 void CleanD3D(void);
 
 // Note:
@@ -63,9 +156,10 @@ void CleanD3D(void);
 //   ID3D11Device::CreateInputLayout				Input-Assembler					InitPipeline()
 //   ID3D11DeviceContext::IASetInputLayout			Input-Assembler					InitPipeline()
 //   ID3D11DeviceContext::VSSetConstantBuffers		Vertex Shader					InitPipeline()
-//   ID3D11DeviceContext::IASetVertexBuffers		Input-Assembler					RenderFrame()
-//   ID3D11DeviceContext::IASetIndexBuffer			Input-Assembler					RenderFrame()
-//   ID3D11DeviceContext::IASetPrimitiveTopology	Input-Assembler					RenderFrame()
+//   ID3D11DeviceContext1::VSSetConstantBuffers1	Vertex Shader					WriteConstantBuffer()
+//   ID3D11DeviceContext::IASetVertexBuffers		Input-Assembler					RenderFrame() (the Direct3D backend of the render queue)
+//   ID3D11DeviceContext::IASetIndexBuffer			Input-Assembler					RenderFrame() (the Direct3D backend of the render queue)
+//   ID3D11DeviceContext::IASetPrimitiveTopology	Input-Assembler					RenderFrame() (the Direct3D backend of the render queue)
 
 //***
 // DirectX Global Declarations.
@@ -75,11 +169,12 @@ void CleanD3D(void);
 // The #pragma directives offer machine-specific and operating system-specific features while retaining overall compatibility with the C and C++ languages.
 // Direct3D Library files.
 #pragma comment (lib, "d3d11.lib")							// Direct3D DirectX 11 Library.
-#pragma comment(lib, "d3dcompiler.lib")						// Direct3D Compiler Library. Needed for D3DCompileFromFile, which compiles shaders.
+#pragma comment(lib, "d3dcompiler.lib")						// Direct3D Compiler Library. Needed for D3DCompile, which compiles shaders.
+#pragma comment(lib, "winmm.lib")							// Windows Multimedia Library. Needed for timeBeginPeriod, which makes the wait for the next frame accurate to a millisecond.
 
 // Direct3D Header Files.
-#include <d3d11.h>											// This header is used by Direct3D 11 Graphics.
-#include <d3dcompiler.h>									// Needed by D3DCompileFromFile, which compiles shaders.
+#include <d3d11_1.h>										// This header is used by Direct3D 11.1 Graphics. It includes d3d11.h, used by Direct3D 11 Graphics, and declares ID3D11DeviceContext1, which binds part of a constant buffer.
+#include <d3dcompiler.h>									// Needed by D3DCompile, which compiles shaders.
 #include <wictextureloader.h>								// DirectXTK library module WICTextureLoader is a Direct3D 2D texture loader using Windows Imaging Component to load, resize, and format convert a supported bitmap and then create a 2D texture from it.
 
 // Using Declarations and Directives.
@@ -94,10 +189,47 @@ using namespace DirectX;
 #define SCREEN_WIDTH  800									// Visual Studio recommends converting macros to expressions: constexpr auto SCREEN_WIDTH = 800;
 #define SCREEN_HEIGHT 600									// Visual Studio recommends converting macros to expressions: constexpr auto SCREEN_HEIGHT = 600;
 
+// Define the largest number of instances of one level of detail whose meshlets are culled one instance at a time. A level of detail with more instances is drawn with one DrawIndexedInstanced call, without culling meshlets.
+#define INSTANCE_MESHLET_CULLING_MAXIMUM 8
+
+// Define the smallest number of instances whose rotations are updated by more than one job.
+#define INSTANCE_ANIMATION_PARALLEL_MINIMUM 16384
+
+// Define the shader compile options. Debug builds insert debug information into the shaders; other builds optimize them as far as the compiler can.
+// The compile options are part of the key of each shader cache file (see shaderCache.h), so debug and release builds never load each other's shaders.
+#ifdef _DEBUG
+#define SHADER_COMPILE_FLAGS D3DCOMPILE_DEBUG
+#else
+#define SHADER_COMPILE_FLAGS D3DCOMPILE_OPTIMIZATION_LEVEL3
+#endif
+
+// Define the time, in milliseconds, between checks of the shader source file for changes when ShaderHotReloadEnabled is true.
+#define SHADER_HOT_RELOAD_INTERVAL 500
+
+// Define the size, in bytes, of the dynamic buffer the constant buffers are written to each frame when UploadRingEnabled is true, and the number of frames the CPU may be ahead of the GPU.
+#define CONSTANT_RING_SIZE 65536
+#define FRAME_FENCES_TOTAL 4
+
+// Define the number of frames whose GPU times may be measured at once when FrameProfilerGpuEnabled is true, i.e., how many frames later the GPU times of a frame are read.
+#define GPU_PROFILE_FRAMES_TOTAL 4
+
+// Define the speed, in radians per second, at which the instances of the object rotate (see the UpdateSimulation function).
+#define ANIMATION_RADIANS_PER_SECOND 0.5f
+
+// Define the identifiers of the shaders, textures, and meshes in the sort keys of the render queue (see the RenderSortKey function), which the Direct3D backend binds (see the RenderFrame function).
+#define RENDER_SHADER_OBJECT 0								// pVS, pPS, and pLayout.
+#define RENDER_TEXTURE_OBJECT 0								// pTextureView.
+#define RENDER_MESH_OBJECT 0								// pVBuffer and pInstanceBuffer, pIBuffer, and a triangle list.
+
+// Define the identifiers of the buffers uploaded by the mesh upload manager (see the UploadMeshes function).
+#define MESH_BUFFER_VERTEX 0								// pVBuffer.
+#define MESH_BUFFER_INDEX 1									// pIBuffer.
+
 // DirectX Global Interface Declarations.
 IDXGISwapChain* swapchain;									// The pointer to the swap chain interface.			The swap chain interface implements one or more surfaces (image-data objects) for storing rendered data before presenting it to an output. It is the series of buffer resources (front buffer, back buffers) which take turns being rendered on.
 ID3D11Device* dev;											// The pointer to the device interface.				A device is the virtual representation of the computer's display adapter. It is used to access video memory and create other Direct3D COM objects, such as graphics and special effects.
 ID3D11DeviceContext* devcon;								// The pointer to the device context interface.		A device context is responsible for managing the graphics pipeline. It control the rendering sequence and the process that translates 3D models into the final 2D image that appears on the screen.
+ID3D11DeviceContext1* devcon1;								// The pointer to the Direct3D 11.1 device context interface of the same device context, or NULL if the constant buffers are not written to the upload ring.
 
 ID3D11Texture2D* pDepthBuffer;								// The pointer to a 2D texture interface.			A 2D texture interface manages texel data, which is structured memory. In this case the 2D texture that serves as the depth-stencil surface.
 ID3D11DepthStencilView* depthbuffer;						// The pointer to the depth-stencil view interface.	A depth-stencil view interface accesses a texture resource (via the depth-stencil surface interface, pDepthBuffer) during depth-stencil testing. The stencil buffer typically shares the same memory space as the depth buffer (z-buffer). The depth-stencil view interface created by this program will only interpret the depth-stencil surface as a depth buffer (z-buffer) rather than a depth-stencil buffer.
@@ -110,18 +242,95 @@ ID3D11VertexShader* pVS;									// The pointer to the vertex shader interface.
 ID3D11PixelShader* pPS;										// The pointer to the pixel shader interface.		A pixel shader interface manages an executable program (a pixel shader) that controls the pixel shader stage of the graphics pipeline.
 ID3D11Buffer* pVBuffer;										// The pointer to a buffer interface.				A buffer interface accesses a buffer resource, which is unstructured memory. In this case the vertex buffer.
 ID3D11Buffer* pIBuffer;										// The pointer to a buffer interface.				A buffer interface accesses a buffer resource, which is unstructured memory. In this case the index buffer.
-ID3D11Buffer* pCBuffer;										// The pointer to a buffer interface.				A buffer interface accesses a buffer resource, which is unstructured memory. In this case the constant buffer.
+ID3D11Buffer* pCBuffer;										// The pointer to a buffer interface.				A buffer interface accesses a buffer resource, which is unstructured memory. In this case the per-frame constant buffer, used when the constant buffers are not written to the upload ring.
+ID3D11Buffer* pObjectCBuffer;								// The pointer to a buffer interface.				A buffer interface accesses a buffer resource, which is unstructured memory. In this case the per-object constant buffer, used when the constant buffers are not written to the upload ring.
+ID3D11Buffer* pConstantRing;								// The pointer to a buffer interface.				A buffer interface accesses a buffer resource, which is unstructured memory. In this case the upload ring: the dynamic buffer every constant buffer is sub-allocated from, or NULL if the constant buffers are not written to the upload ring.
+ID3D11Buffer* pUploadStaging[FRAME_FENCES_TOTAL];			// The pointers to buffer interfaces.				A buffer interface accesses a buffer resource, which is unstructured memory. In this case the staging buffers the pieces of large static buffers are copied through, used in turn, each created when first needed.
+ID3D11Buffer* pInstanceBuffer;								// The pointer to a buffer interface.				A buffer interface accesses a buffer resource, which is unstructured memory. In this case the instance buffer: a second vertex buffer holding one INSTANCEDATA structure per instance of the object.
 
 ID3D11ShaderResourceView* pTextureView;						// The pointer to a shader resource view interface.	A shader resource view interface specifies the subresource a shader can access during rendering. In this case the texture image.
 
-// Declare the C++ constant buffer structure used to assign values to the HLSL constant buffer structure.
-// This structure represents a constant buffer used in the graphics rendering pipeline.
-// It contains information that is passed to the vertex shader stage of the pipeline and can be used to transform geometric vertices and calculate lighting effects on them.
+// The bytecode of the vertex shader and pixel shader, from which pVS, pPS, and pLayout are created, and the version of the shader source file each was compiled from (see shaderCache.h).
+ShaderProgram VertexShaderProgram;
+ShaderProgram PixelShaderProgram;
+
+// The allocations of the upload ring (see uploadRing.h), and the fences that retire them: one D3D11_QUERY_EVENT query ended after each frame, reused every FRAME_FENCES_TOTAL frames.
+UploadRing ConstantRing;
+ID3D11Query* FrameFences[FRAME_FENCES_TOTAL];
+unsigned long long FramesEnded = 0;							// The number of frames ended, i.e., the number of the frame being rendered.
+unsigned long long FramesRetired = 0;						// The number of frames the GPU has finished. Frames FramesRetired to FramesEnded - 1 may still be read by the GPU.
+
+// The queries that measure the GPU times of a frame when FrameProfilerGpuEnabled is true (see the GpuProfileTimestamp function), one set per frame measured at once, reused every GPU_PROFILE_FRAMES_TOTAL frames.
+struct GpuProfileFrame {
+	ID3D11Query* Disjoint;									// A D3D11_QUERY_TIMESTAMP_DISJOINT query: the frequency of the timestamps, and whether they are valid.
+	ID3D11Query* Timestamps[3];								// D3D11_QUERY_TIMESTAMP queries: the start of the frame, the start of the draws, and the end of the frame.
+	unsigned long long Frame;								// The number of the frame measured (see the ProfilerFrame function).
+	bool Pending;											// True if the queries have been issued and not yet read.
+} GpuProfileFrames[GPU_PROFILE_FRAMES_TOTAL];
+unsigned long long GpuProfileFramesIssued = 0;				// The number of frames measured. The next frame uses GpuProfileFrames[GpuProfileFramesIssued % GPU_PROFILE_FRAMES_TOTAL].
+
+// The format of the vertex buffer and index buffer, chosen by the InitGraphics function.
+UINT VertexStride = sizeof(VERTEX);							// The size, in bytes, of one vertex in the vertex buffer: sizeof(PACKEDVERTEX) if VertexPackingEnabled is true, otherwise sizeof(VERTEX).
+DXGI_FORMAT IndexFormat = DXGI_FORMAT_R32_UINT;				// The format of one index in the index buffer: DXGI_FORMAT_R16_UINT if every index fits in 16 bits (VertexAttributeSetsTotal < 65536), otherwise DXGI_FORMAT_R32_UINT.
+
+// The bounding sphere of the object, in object space, computed by the InitGraphics function. Used to cull each instance of the object, and to find its distance from the camera when selecting its level of detail.
+XMFLOAT3 ObjectBoundsCenter;								// The center of the bounding sphere: the center of the object's axis-aligned bounding box.
+float ObjectBoundsRadius;									// The radius of the bounding sphere: the largest distance from the center to a geometric vertex.
+
+// The instances of the object whose meshlets are culled in the current frame, found by the CullInstanceMeshlets function. Element k of each array belongs to the k-th such instance, in instance buffer order.
+std::vector<int> MeshletCulledInstances;					// The location of the INSTANCEDATA structure of each instance in the instance buffer.
+std::vector<std::vector<MeshletRun>> MeshletCulledRuns;		// The ranges of the index buffer with which to draw each instance, i.e., its meshlets that were not culled, found by the CullObjectMeshlets function.
+std::vector<MeshletCullStatistics> MeshletCulledStatistics;	// The meshlets culled for each instance, added to MeshletCulling once every instance is culled.
+
+// The instances of the object, placed by the PlaceObjectInstances function and rotated each frame, and the instances drawn in the current frame, found by the BuildInstanceBatches function.
+InstanceTransformArrays ObjectInstances;					// The scale, rotation, and position of each of the ObjectInstancesTotal instances of the object.
+std::vector<int> InstanceOrder;								// The index in ObjectInstances of the instance whose INSTANCEDATA structure is at each location of the instance buffer.
+std::vector<InstanceBatch> InstanceBatches;					// The ranges of the instance buffer drawn by one DrawIndexedInstanced call each, one per level of detail.
+
+// The render queue the draws of the current frame are recorded into by the frame job (see the RecordInstanceDraws function), and executed from by the RenderFrame function.
+// FrameStateCache is the state bound by the render queue, kept from frame to frame, so the shaders, texture, and buffers, which do not change, are bound only by the first frame.
+RenderQueue FrameQueue;
+RenderStateCache FrameStateCache;
+RenderQueueStatistics FrameQueueStatistics;					// The draws and binds of the current frame.
+
+// The vertex buffer and index buffer waiting to be uploaded (see meshUpload.h), and whether both have been uploaded, i.e., whether the object can be drawn.
+MeshUploader MeshUploads;
+bool ObjectUploaded = false;
+
+// The compressed copies of OurVertices, OurIndices, and MeshLodIndices, kept when MeshResidencyPolicy is MESH_RESIDENCY_COMPRESSED (see the ApplyMeshResidency function), and decompressed to upload the object again (see the RestoreObjectMesh function).
+CompressedWords CompressedObjectVertices;
+CompressedWords CompressedObjectIndices;
+CompressedWords CompressedObjectLodIndices;
+
+// The size, in bytes, of the texture image, every level of its mipmap chain, for the memory report.
+size_t TextureBytes = 0;
+
+// The copies of the vertex buffer, index buffer, instance buffer, and texture image read by the software rasterizer, and its render target, when SoftwareRasterizerEnabled is true (see softwareRasterizer.h).
+// The GPU's buffers cannot be read by the CPU, so the InitGraphics function keeps a copy of the vertex attributes (unpacked, even if VertexPackingEnabled is true) and indices, and the frame job writes the INSTANCEDATA structures to SoftwareInstances before copying them to the instance buffer.
+std::vector<VERTEX> SoftwareVertices;
+std::vector<DWORD> SoftwareIndices;
+std::vector<INSTANCEDATA> SoftwareInstances;
+Image SoftwareTexture;
+SoftwareRenderTarget SoftwareTarget;
+bool SoftwareFrameSaved = false;							// True once a frame rendered by the software rasterizer has been written to SoftwareRasterizerFileName.
+
+// The schedule of frames and fixed timesteps (see frameClock.h), and the state of the animation, advanced one fixed timestep at a time by the UpdateSimulation function.
+// Each frame is rendered between the state before and after the last timestep, so the instances rotate smoothly even when the frame rate is not a multiple of the timestep rate.
+FrameClock FrameTimer;
+struct SIMULATIONSTATE {
+	float Angle;											// The angle of rotation of every instance of the object but the second, around the y-axis, in radians.
+	float Angle2;											// The angle of rotation of the second instance of the object.
+} SimulationPrevious, SimulationCurrent;					// The state before and after the last timestep.
+
+// Declare the C++ constant buffer structures used to assign values to the HLSL constant buffer structures.
+// These structures represent the constant buffers used in the graphics rendering pipeline, split by how often their contents change, so that data that changes once per frame is not sent again for every object, and the reverse.
+// They contain information that is passed to the vertex shader stage of the pipeline and can be used to transform geometric vertices and calculate lighting effects on them.
 //
-// The matFinal member is a 4x4 matrix that represents the combined world, view, and projection transformations that are applied to the geometric vertices of the geometry being rendered.
+// FRAMECONSTANTS, the per-frame constant buffer, is written once per frame, and is the same for every object drawn in the frame:
 //
-// The matRotate member is a 4x4 matrix that represents a rotation transformation that is applied to the geometric vertices of the geometry being rendered.
-// It is a component of the world transformation, and therefore of the matFinal matrix, but is also included separately in the constant buffer structure because the vertex normal vectors at the geometric vertices also need to be transformed by the same rotation matrix in order to correctly calculate lighting effects.
+// The matViewProjection member is a 4x4 matrix that represents the combined view and projection transformations that are applied to the geometric vertices of the geometry being rendered.
+// The world transformation of each instance, and the rotation applied to its vertex normal vectors in order to correctly calculate lighting effects, are not members of the constant buffer structures:
+// they are read by the vertex shader from the instance buffer (see the INSTANCEDATA structure), so that every instance is drawn with the same constant buffers.
 //
 // The LightVector member is a 4D vector that represents the direction of the light source in 3D space.
 // This vector can be represented by any nonzero vector and the light will shine in that direction.
@@ -132,13 +341,21 @@ ID3D11ShaderResourceView* pTextureView;						// The pointer to a shader resource
 // The AmbientColor member is a 4D vector that represents the color and brightness of the ambient light in the scene.
 // Ambient light is a type of light that illuminates all objects in a scene equally, regardless of their distance from the light source.
 // It is used to add a basic level of illumination to a scene and can be used to simulate global illumination effects.
-struct {
-	XMMATRIX matFinal;
-	XMMATRIX matRotate;										// Vertex normal vectors, like the geometric vertices comprising the object, also need to be transformed by the rotation matrix to correctly calculate lighting effects.
+//
+// OBJECTCONSTANTS, the per-object constant buffer, is written once for each object drawn in the frame, before the object's DrawIndexedInstanced calls:
+//
+// The GeometricVertexMinimum, GeometricVertexScale, and VertexTextureCoordinateBounds members are used by the vertex shader to unpack PACKEDVERTEX structures (see VertexPackingBounds) when VertexPackingEnabled is true, and are otherwise unused.
+struct FRAMECONSTANTS {
+	XMMATRIX matViewProjection;
 	XMFLOAT4 LightVector;									// Directional light's direction.
 	XMFLOAT4 LightColor;									// Directional light's color (whiter color == brighter color).
 	XMFLOAT4 AmbientColor;									// Ambient     light's color (whiter color == brighter color).
-} ConstantBuffer;
+} FrameConstants;
+struct OBJECTCONSTANTS {
+	XMFLOAT4 GeometricVertexMinimum;						// .xyz: The minimum of each geometric vertex coordinate.
+	XMFLOAT4 GeometricVertexScale;							// .xyz: The maximum minus the minimum of each geometric vertex coordinate.
+	XMFLOAT4 VertexTextureCoordinateBounds;					// .xy:  The minimum of each vertex texture coordinate. .zw: The maximum minus the minimum of each vertex texture coordinate.
+} ObjectConstants;
 
 // End: DirectX Global Declarations.
 
@@ -218,7 +435,21 @@ int WINAPI WinMain(HINSTANCE hInstance,						// The "handle to an instance" or "
 			   nCmdShow);									// Indicates if the main program window will be minimized, maximized, or shown normally.
 
 	// InitD3D function initializes and prepares Direct3D for use.
-	InitD3D(hWnd);
+	if (InitD3D(hWnd) == 1)									// InitD3D returns 1 if the shaders cannot be compiled, or the object cannot be loaded.
+	{
+		// Nothing can be drawn.
+		JobSystemShutdown();
+
+		// Terminate this program with a return code indicating an error.
+		return 1;
+	}
+
+	// Schedule the frames and the fixed timesteps of the animation.
+	// timeBeginPeriod function:
+	//   Sets the resolution of the system timer used by waits, such as MsgWaitForMultipleObjects, to 1 millisecond, instead of the default of about 15.6 milliseconds, so waiting for the next frame does not overshoot it. timeEndPeriod restores it.
+	CreateFrameClock(FrameTimer, SimulationStepsPerSecond, FrameRateLimit);
+	if (FrameRateLimit > 0)
+		timeBeginPeriod(1);
 
 	msg = { 0 };											// Set the entire structure holding window and thread messages to null.
 
@@ -270,16 +501,48 @@ int WINAPI WinMain(HINSTANCE hInstance,						// The "handle to an instance" or "
 		{
 			// No message is waiting in the thread message queue: Perform main processing.
 
+			// Wait until the next frame is due, if the frame rate is limited (FrameRateLimit), instead of rendering frames as fast as possible.
+			// MsgWaitForMultipleObjects function:
+			//   Waits, without using the CPU, until the timeout elapses or a message is posted to the thread message queue, so messages are still processed at once while waiting.
+			//   The timeout is in whole milliseconds, so the frame starts less than a millisecond early rather than late; the next frame is still scheduled a whole frame interval after this one was due.
+			long long wait = FrameClockWaitTime(FrameTimer, FrameClockNow());
+			if (wait >= 1000000)
+			{
+				MsgWaitForMultipleObjects(0, NULL, FALSE, (DWORD)(wait / 1000000), QS_ALLINPUT);
+				continue;									// Check the thread message queue again.
+			}
+
+			// Replace the shaders if their source file has changed.
+			if (ShaderHotReloadEnabled)
+				ReloadShaders();
+
+			// Advance the animation by the fixed timesteps that have passed since the previous frame.
+			int steps = FrameClockBeginFrame(FrameTimer, FrameClockNow());
+			for (int step = 0; step < steps; step++)
+				UpdateSimulation(FrameTimer.StepNanoseconds / 1e9f);
+
 			// Execute the graphics generating code.
-			RenderFrame();									// This function renders a single frame.
+			RenderFrame(FrameTimer.Alpha);					// This function renders a single frame, between the last two states of the animation.
 		}
 	}
 
 	// The infinite message loop has ended. This program's window has been closed manually: Terminate the program.
 
+	// Restore the resolution of the system timer.
+	if (FrameRateLimit > 0)
+		timeEndPeriod(1);
+
+	// Write the frame profiler's statistics, and the memory report.
+	if (FrameProfilerEnabled)
+		SaveFrameProfile();
+	SaveMemoryReport();
+
 	// Terminate Direct3D.
 	CleanD3D();
 
+	// Stop the worker threads of the job system, if they were started.
+	JobSystemShutdown();
+
 	// Terminate this program with a return code indicating success.
 	return msg.wParam;										// The exit value returned to the operating system must be the wParam parameter value of the WM_QUIT message (see PostQuitMessage).
 }
@@ -310,6 +573,21 @@ LRESULT CALLBACK WindowProc(HWND hWnd,						// The HWND handle for the window.
 			PostQuitMessage(0);							// PostQuitMessage(x), where x is the wParam parameter value of the WM_QUIT message (here wParam = 0).
 			return 0;									// The WindowProc function returns 0.
 		} break;										// Break out of the switch block.
+		case WM_KEYDOWN:
+		{
+			// WM_KEYDOWN message: (message = WM_KEYDOWN)
+			//   It is posted to the window with the keyboard focus when a key is pressed. wParam is the virtual-key code of the key.
+			// F2 writes the frame profiler's statistics so far, when FrameProfilerEnabled is true, and the memory report.
+			if (wParam == VK_F2)
+			{
+				if (FrameProfilerEnabled)
+					SaveFrameProfile();
+				SaveMemoryReport();
+			}
+			// F3 uploads the vertex buffer and index buffer again from the CPU's copy of the object, as after the device is lost.
+			if (wParam == VK_F3)
+				ReuploadObjectMesh();
+		} break;										// Break out of the switch block, so the DefWindowProc function also processes the message.
 	}
 
 	// Handle messages the switch block does not:
@@ -527,12 +805,18 @@ int InitD3D(HWND hWnd)										// The HWND handle for the window.
 	// End: 5. Set the viewport to the rasterizer stage of the graphics pipeline.
 
 	// Initialize the graphics pipeline.
-	InitPipeline();
+	if (InitPipeline() == 1)								// InitPipeline returns 1 if the shaders cannot be compiled.
+	{
+		// Cannot compile the shaders.
+
+		// Terminate this function with a return code indicating an error.
+		return 1;
+	}
 
 	// Load and initialize all graphics data.
-	if (InitGraphics() == 1)								// objReader returns 1 if it cannot open the Wavefront .obj file.
+	if (InitGraphics() == 1)								// InitGraphics returns 1 if it cannot open the Wavefront .obj file, or the object has no triangles.
 	{
-		// Cannot open the Wavefront .obj file.
+		// Cannot open the Wavefront .obj file, or the object has no triangles.
 
 		// Terminate this function with a return code indicating an error.
 		return 1;
@@ -542,6 +826,71 @@ int InitD3D(HWND hWnd)										// The HWND handle for the window.
 	return 0;
 }
 
+// D3DShaderCompiler function: Definition
+//   This function is the shader compiler passed to the CompileShader function (see the ShaderCompiler function type in shaderCache.h). It compiles the shader with D3DCompile.
+//   The HLSL code is compiled from the bytes of the source file the CompileShader function read and hashed, rather than from the file with D3DCompileFromFile, so the bytecode always matches the key it is cached with.
+static int D3DShaderCompiler(const char* Source, size_t SourceSize, const char* SourceFileName, const ShaderDefine* Defines, const char* EntryPoint, const char* Target, unsigned int Flags,
+	std::vector<unsigned char>& Bytecode, std::string& Errors)
+{
+	static_assert(sizeof(ShaderDefine) == sizeof(D3D_SHADER_MACRO), "A ShaderDefine structure must have the layout of a D3D_SHADER_MACRO structure.");
+
+	ID3DBlob* code = NULL;									// A pointer to the ID3DBlob interface used to access the compiled code.
+	ID3DBlob* errors = NULL;								// A pointer to the ID3DBlob interface used to access the compiler error messages.
+
+	// D3DCompile function:
+	//   Compile Microsoft High Level Shader Language (HLSL) code into bytecode for a given target.
+	HRESULT result = D3DCompile(Source,						// A pointer to the uncompiled shader code.
+		SourceSize,											// The size, in bytes, of the uncompiled shader code.
+		SourceFileName,										// The name of the source file, used in compiler error messages.
+		(const D3D_SHADER_MACRO*)Defines,					// An optional array of D3D_SHADER_MACRO structures that define shader macros.
+		NULL,												// An optional pointer to an ID3DInclude interface that the compiler uses to handle include files. shaders.hlsl includes no files.
+		EntryPoint,											// The name of the shader entry point function where shader execution begins.
+		Target,												// The shader target or set of shader features to compile against, e.g., vs_4_1, the vertex shader model of the Direct3D 10.1 feature level.
+		Flags,												// A combination of shader compile options (see SHADER_COMPILE_FLAGS).
+		0,													// A combination of effect compile options. Ignored when a shader, and not an effect, is compiled.
+		&code,												// &code is the address of a pointer, code, to the interface that you can use to access the compiled code.
+		&errors);											// &errors is the address of a pointer, errors, to the interface that you can use to access compiler error messages.
+
+	if (errors != NULL)
+	{
+		Errors.assign((const char*)errors->GetBufferPointer(), errors->GetBufferSize());
+		errors->Release();
+	}
+	if (FAILED(result) || code == NULL)
+	{
+		if (code != NULL)
+			code->Release();
+		return 1;
+	}
+	Bytecode.assign((const unsigned char*)code->GetBufferPointer(), (const unsigned char*)code->GetBufferPointer() + code->GetBufferSize());
+	code->Release();
+	return 0;
+}
+
+// CompilePipelineShaders function: Definition
+//   This function sets VertexShader and PixelShader to the bytecode of the VShader and PShader functions of shaders.hlsl, loaded from their shader cache files or compiled with the D3DShaderCompiler function.
+//   Both shaders are compiled even if the first fails, so the version of the source file that failed is recorded in both (see the CompileShader function). Compiler error messages are written to the debugger's output window.
+//   It returns 0 on success, or 1 if either shader cannot be compiled.
+int CompilePipelineShaders(ShaderProgram& VertexShader, ShaderProgram& PixelShader)
+{
+	// The shader macros defined when compiling the vertex shader. PACKED_VERTEX selects the VShader function that unpacks PACKEDVERTEX structures.
+	ShaderDefine packedVertexDefines[] = { { "PACKED_VERTEX", "1" }, { NULL, NULL } };
+
+	std::string vertexErrors;
+	std::string pixelErrors;
+	int vertexResult = CompileShader("shaders.hlsl", VertexPackingEnabled ? packedVertexDefines : NULL, "VShader", "vs_4_1", SHADER_COMPILE_FLAGS, D3D_COMPILER_VERSION, D3DShaderCompiler, VertexShader, vertexErrors);
+	int pixelResult = CompileShader("shaders.hlsl", NULL, "PShader", "ps_4_1", SHADER_COMPILE_FLAGS, D3D_COMPILER_VERSION, D3DShaderCompiler, PixelShader, pixelErrors);
+	if (vertexResult == 1 || pixelResult == 1)
+	{
+		OutputDebugStringA(vertexErrors.c_str());
+		OutputDebugStringA(pixelErrors.c_str());
+		return 1;
+	}
+
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
+
 // InitPipeline function: Definition
 //   This function initializes the graphics pipeline:
 //     1. Create the shader objects and set them to the associated shader stage of the graphics pipeline.
@@ -549,7 +898,8 @@ int InitD3D(HWND hWnd)										// The HWND handle for the window.
 //     2. Create the input-layout object and set it to the input-assembler stage of the graphics pipeline.
 //
 //     3. Create the constant buffer object and set it to the vertex shader stage of the graphics pipeline.
-void InitPipeline(void)
+//   It returns 0 on success, or 1 if the shaders cannot be compiled.
+int InitPipeline(void)
 {
 	//***
 	// 1. Create the shader objects and set them to the associated shader stage of the graphics pipeline.
@@ -568,36 +918,14 @@ void InitPipeline(void)
 	//      Optionally, this shader can output the color, brightness, contrast, and other characteristics of a single pixel.
 	//***
 
-	ID3DBlob* VS;											// VS (Vertex Shader) is a pointer to the ID3DBlob interface used to return Direct3D data of arbitrary length.
-	ID3DBlob* PS;											// PS (Pixel Shader)  is a pointer to the ID3DBlob interface used to return Direct3D data of arbitrary length.
-
-	// D3DCompileFromFile function:
-	//   Compile Microsoft High Level Shader Language (HLSL) code into bytecode for a given target.
-	//   Compile the vertex shader:
-	D3DCompileFromFile(L"shaders.hlsl",						// A pointer to a constant null-terminated string that contains the name of the file that contains the shader code.
-		NULL,												// An optional array of D3D_SHADER_MACRO structures that define shader macros.
-		NULL,												// An optional pointer to an ID3DInclude interface that the compiler uses to handle include files.
-		"VShader",											// A pointer to a constant null-terminated string that contains the name of the shader entry point function where shader execution begins. When you compile an effect this parameter is ignored; Microsoft recommends setting it to NULL because it is good programming practice to set a pointer parameter to NULL if the called function will not use it.
-		"vs_4_1",											// A pointer to a constant null-terminated string that specifies the shader target or set of shader features to compile against. The shader target can be a shader model. vs_4_1 is the vertex shader model (a shader target) of the Direct3D 10.1 feature level.
-		D3DCOMPILE_DEBUG,									// A combination of shader compile options that are combined by using a bitwise OR operation. The resulting value specifies how the compiler compiles the HLSL code (set it to zero (0) to indicate no options). The D3DCOMPILE_DEBUG option directs the compiler to insert debug file/line/type/symbol information into the output code.
-		0,													// A combination of effect compile options that are combined by using a bitwise OR operation. The resulting value specifies how the compiler compiles the effect. When you compile a shader and not an effect file, D3DCompileFromFile ignores this parameter (set it to zero (0) to indicate no options).
-		&VS,												// &VS is the address of a pointer, VS, to the interface that you can use to access the compiled code.
-		0);													// An optional pointer to a variable that receives a pointer to the ID3DBlob interface that you can use to access compiler error messages
-	//   Compile the pixel shader:
-	D3DCompileFromFile(L"shaders.hlsl",						// A pointer to a constant null-terminated string that contains the name of the file that contains the shader code.
-		NULL,												// An optional array of D3D_SHADER_MACRO structures that define shader macros.
-		NULL,												// An optional pointer to an ID3DInclude interface that the compiler uses to handle include files.
-		"PShader",											// A pointer to a constant null-terminated string that contains the name of the shader entry point function where shader execution begins. When you compile an effect this parameter is ignored; Microsoft recommends setting it to NULL because it is good programming practice to set a pointer parameter to NULL if the called function will not use it.
-		"ps_4_1",											// A pointer to a constant null-terminated string that specifies the shader target or set of shader features to compile against. The shader target can be a shader model. ps_4_1 is the pixel shader model (a shader target) of the Direct3D 10.1 feature level.
-		D3DCOMPILE_DEBUG,									// A combination of shader compile options that are combined by using a bitwise OR operation. The resulting value specifies how the compiler compiles the HLSL code (set it to zero (0) to indicate no options). The D3DCOMPILE_DEBUG option directs the compiler to insert debug file/line/type/symbol information into the output code.
-		0,													// A combination of effect compile options that are combined by using a bitwise OR operation. The resulting value specifies how the compiler compiles the effect. When you compile a shader and not an effect file, D3DCompileFromFile ignores this parameter (set it to zero (0) to indicate no options).
-		&PS,												// &PS is the address of a pointer, PS, to the interface that you can use to access the compiled code.
-		0);													// An optional pointer to a variable that receives a pointer to the ID3DBlob interface that you can use to access compiler error messages.
+	// Compile the vertex shader and the pixel shader, or load their bytecode from their shader cache files (see shaderCache.h).
+	if (CompilePipelineShaders(VertexShaderProgram, PixelShaderProgram) == 1)
+		return 1;
 
 	// ID3D11Device::CreateVertexShader member function:
 	//   Create the vertex shader object from a compiled shader.
-	dev->CreateVertexShader(VS->GetBufferPointer(),			// A pointer to the compiled vertex shader.
-		VS->GetBufferSize(),								// Size of the compiled vertex shader.
+	dev->CreateVertexShader(VertexShaderProgram.Bytecode.data(),	// A pointer to the compiled vertex shader.
+		VertexShaderProgram.Bytecode.size(),				// Size of the compiled vertex shader.
 		NULL,												// An optional pointer to a class linkage ID3D11ClassLinkage interface.
 		&pVS);												// &pVS is the address of a pointer, pVS, to the vertex shader ID3D11VertexShader interface.
 
@@ -609,8 +937,8 @@ void InitPipeline(void)
 
 	// ID3D11Device::CreatePixelShader member function:
 	//   Create the pixel shader object from a compiled shader.
-	dev->CreatePixelShader(PS->GetBufferPointer(),			// A pointer to the compiled pixel shader.
-		PS->GetBufferSize(),								// Size of the compiled pixel shader.
+	dev->CreatePixelShader(PixelShaderProgram.Bytecode.data(),	// A pointer to the compiled pixel shader.
+		PixelShaderProgram.Bytecode.size(),					// Size of the compiled pixel shader.
 		NULL,												// An optional pointer to a class linkage ID3D11ClassLinkage interface. 
 		&pPS);												// &pPS is the address of a pointer, pPS, to the pixel shader ID3D11PixelShader interface.
 
@@ -628,14 +956,15 @@ void InitPipeline(void)
 	//***
 
 	// Create the input element description structure used to define the input-layout object that describes the VERTEX structure used in this program.
-	D3D11_INPUT_ELEMENT_DESC ied[3];						// Defines the input-layout object containing an array of structures, each structure defines one element being read from an input slot.
+	D3D11_INPUT_ELEMENT_DESC ied[9];						// Defines the input-layout object containing an array of structures, each structure defines one element being read from an input slot.
 	ZeroMemory(&ied, sizeof(ied));							// ZeroMemory macro: Fills a block of memory with zeros. "sizeof(ied)" is used instead of "sizeof(D3D11_INPUT_ELEMENT_DESC)" because the former fills both elements of array "ied".
 
 	// Assign values to the input element description D3D11_INPUT_ELEMENT_DESC structure's members. Any subordinate members (variable.member.subordinatemember) are described in the comments.
+	// When VertexPackingEnabled is true, the input elements describe the PACKEDVERTEX structure instead (see vertexPacking.h).
 	// Define the position input element of the VERTEX structure OurVertices.
 	ied[0].SemanticName = "POSITION";						// Assigned a value specifying the HLSL semantic name associated with this element in a shader input signature.
 	ied[0].SemanticIndex = 0;								// Assigned a value specifying the semantic index for the element. A semantic index modifies a semantic with an integer index number. A semantic index is only needed in a case where there is more than one element with the same semantic name.
-	ied[0].Format = DXGI_FORMAT_R32G32B32_FLOAT;			// Assigned a value specifying the data type of the element.					  A value of the DXGI_FORMAT enumerated type,				 i.e., DXGI_FORMAT_R32G32B32_FLOAT: A three-component, 96-bit floating-point format that supports 32 bits for the red channel, 32 bits for the green channel and 32 bits for the blue channel.
+	ied[0].Format = VertexPackingEnabled ? DXGI_FORMAT_R16G16B16A16_UNORM : DXGI_FORMAT_R32G32B32_FLOAT;	// Assigned a value specifying the data type of the element.					  A value of the DXGI_FORMAT enumerated type,				 i.e., DXGI_FORMAT_R32G32B32_FLOAT: A three-component, 96-bit floating-point format that supports 32 bits for the red channel, 32 bits for the green channel and 32 bits for the blue channel. PACKEDVERTEX: A four-component, 64-bit unsigned-normalized-integer format.
 	ied[0].InputSlot = 0;									// Assigned a value specifying the integer value that identifies the input-assembler (see input slot).
 	ied[0].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;// Assigned a value specifying the optional offset (in bytes) from the start of the vertex. Use D3D11_APPEND_ALIGNED_ELEMENT for convenience to define the current element directly after the previous one, including any packing if necessary. Position has an offset of 0 in this program.
 	ied[0].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;	// Assigned a value specifying the input data slot class for a single input slot. A value of the D3D11_INPUT_CLASSIFICATION enumerated type, i.e., D3D11_INPUT_PER_VERTEX_DATA: Input data is per-vertex data.
@@ -644,7 +973,7 @@ void InitPipeline(void)
 	// Define the normal   input element of the VERTEX structure OurVertices.
 	ied[1].SemanticName = "NORMAL";							// Assigned a value specifying the HLSL semantic name associated with this element in a shader input signature.
 	ied[1].SemanticIndex = 0;								// Assigned a value specifying the semantic index for the element. A semantic index modifies a semantic with an integer index number. A semantic index is only needed in a case where there is more than one element with the same semantic name.
-	ied[1].Format = DXGI_FORMAT_R32G32B32_FLOAT;			// Assigned a value specifying the data type of the element.					  A value of the DXGI_FORMAT enumerated type,				 i.e., DXGI_FORMAT_R32G32B32_FLOAT: A three-component, 96-bit floating-point format that supports 32 bits for the red channel, 32 bits for the green channel and 32 bits for the blue channel.
+	ied[1].Format = VertexPackingEnabled ? DXGI_FORMAT_R16G16_SNORM : DXGI_FORMAT_R32G32B32_FLOAT;	// Assigned a value specifying the data type of the element.					  A value of the DXGI_FORMAT enumerated type,				 i.e., DXGI_FORMAT_R32G32B32_FLOAT: A three-component, 96-bit floating-point format that supports 32 bits for the red channel, 32 bits for the green channel and 32 bits for the blue channel. PACKEDVERTEX: A two-component, 32-bit signed-normalized-integer format (octahedral coordinates).
 	ied[1].InputSlot = 0;									// Assigned a value specifying the integer value that identifies the input-assembler (see input slot).
 	ied[1].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;// Assigned a value specifying the optional offset (in bytes) from the start of the vertex. Use D3D11_APPEND_ALIGNED_ELEMENT for convenience to define the current element directly after the previous one, including any packing if necessary. Normal has an offset of 12 in this program.
 	ied[1].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;	// Assigned a value specifying the input data slot class for a single input slot. A value of the D3D11_INPUT_CLASSIFICATION enumerated type, i.e., D3D11_INPUT_PER_VERTEX_DATA: Input data is per-vertex data.
@@ -653,18 +982,30 @@ void InitPipeline(void)
 	// Define the texture  input element of the VERTEX structure OurVertices.
 	ied[2].SemanticName = "TEXCOORD";						// Assigned a value specifying the HLSL semantic name associated with this element in a shader input signature.
 	ied[2].SemanticIndex = 0;								// Assigned a value specifying the semantic index for the element. A semantic index modifies a semantic with an integer index number. A semantic index is only needed in a case where there is more than one element with the same semantic name.
-	ied[2].Format = DXGI_FORMAT_R32G32_FLOAT;				// Assigned a value specifying the data type of the element.					  A value of the DXGI_FORMAT enumerated type,				 i.e., DXGI_FORMAT_R32G32_FLOAT:	A two-component, 64-bit floating-point format that supports 32 bits for the red channel and 32 bits for the green channel.
+	ied[2].Format = VertexPackingEnabled ? DXGI_FORMAT_R16G16_UNORM : DXGI_FORMAT_R32G32_FLOAT;	// Assigned a value specifying the data type of the element.					  A value of the DXGI_FORMAT enumerated type,				 i.e., DXGI_FORMAT_R32G32_FLOAT:	A two-component, 64-bit floating-point format that supports 32 bits for the red channel and 32 bits for the green channel. PACKEDVERTEX: A two-component, 32-bit unsigned-normalized-integer format.
 	ied[2].InputSlot = 0;									// Assigned a value specifying the integer value that identifies the input-assembler (see input slot).
 	ied[2].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;// Assigned a value specifying the optional offset (in bytes) from the start of the vertex. Use D3D11_APPEND_ALIGNED_ELEMENT for convenience to define the current element directly after the previous one, including any packing if necessary. Normal has an offset of 12 in this program.
 	ied[2].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;	// Assigned a value specifying the input data slot class for a single input slot. A value of the D3D11_INPUT_CLASSIFICATION enumerated type, i.e., D3D11_INPUT_PER_VERTEX_DATA: Input data is per-vertex data.
 	ied[2].InstanceDataStepRate = 0;						// Assigned a value specifying the number of instances to draw using the same per-instance data before advancing in the buffer by one element. This value must be 0 for an element that contains per-vertex data (the slot class is set to D3D11_INPUT_PER_VERTEX_DATA).
 
+	// Define the per-instance input elements of the INSTANCEDATA structure (see instanceBuilder.h), read from the instance buffer: three rows of the world matrix (INSTANCEWORLD0 to INSTANCEWORLD2), then three rows of the normal matrix (INSTANCENORMAL0 to INSTANCENORMAL2).
+	for (int i = 0; i < 6; i++)
+	{
+		ied[3 + i].SemanticName = i < 3 ? "INSTANCEWORLD" : "INSTANCENORMAL";	// Assigned a value specifying the HLSL semantic name associated with this element in a shader input signature.
+		ied[3 + i].SemanticIndex = i % 3;					// Assigned a value specifying the semantic index for the element, i.e., the row of the matrix.
+		ied[3 + i].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;	// Assigned a value specifying the data type of the element.					  A value of the DXGI_FORMAT enumerated type,				 i.e., DXGI_FORMAT_R32G32B32A32_FLOAT: A four-component, 128-bit floating-point format.
+		ied[3 + i].InputSlot = 1;							// Assigned a value specifying the integer value that identifies the input-assembler (see input slot). The instance buffer is bound to input slot 1.
+		ied[3 + i].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;	// Assigned a value specifying the optional offset (in bytes) from the start of the INSTANCEDATA structure. Offsets are counted separately for each input slot, so the first row has an offset of 0.
+		ied[3 + i].InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;	// Assigned a value specifying the input data slot class for a single input slot. A value of the D3D11_INPUT_CLASSIFICATION enumerated type, i.e., D3D11_INPUT_PER_INSTANCE_DATA: Input data is per-instance data.
+		ied[3 + i].InstanceDataStepRate = 1;				// Assigned a value specifying the number of instances to draw using the same per-instance data before advancing in the buffer by one element, i.e., one INSTANCEDATA structure per instance.
+	}
+
 	// ID3D11Device::CreateInputLayout member function:
 	//   Create the input-layout object to describe the input-buffer data for the input-assembler stage of the graphics pipeline.
-	dev->CreateInputLayout(ied,								// An array of the input-assembler stage input data types, in this case POSITION and NORMAL, used to define the input-layout object. Each input data type is described by an element description.
-		3,													// The number of input data types in the array, in this case 2 (POSITION and NORMAL), used to define the input-layout object.
-		VS->GetBufferPointer(),								// Pointer to the compiled shader.
-		VS->GetBufferSize(),								// Size of the compiled shader.
+	dev->CreateInputLayout(ied,								// An array of the input-assembler stage input data types, in this case POSITION, NORMAL, TEXCOORD, and the six rows of INSTANCEDATA, used to define the input-layout object. Each input data type is described by an element description.
+		9,													// The number of input data types in the array, in this case 9, used to define the input-layout object.
+		VertexShaderProgram.Bytecode.data(),				// Pointer to the compiled shader.
+		VertexShaderProgram.Bytecode.size(),				// Size of the compiled shader.
 		&pLayout);											// &pLayout is the address of a pointer, pLayout, to an input-layout ID3D11InputLayout interface.
 
 	// ID3D11DeviceContext::IASetInputLayout member function:
@@ -683,7 +1024,7 @@ void InitPipeline(void)
 	//      Any one constant (structure member) cannot be split between two 16-byte areas of memory. Therefore, if the first constant in the structure is less than 16 bytes then the second constant will be aligned on the next 16-byte boundary. When it occurs, this automatic alignment must be accounted for in the C++ constant buffer structure in C++, otherwise it will not match the HLSL constant buffer structure, even if their code looks identical.
 	//
 	//      These structures and their members are optionally named the same in C++ and HLSL.
-	//      The C++ constant buffer structure is copied to the constant buffer pointed to by pCBuffer using the ID3D11DeviceContext::UpdateSubresource member function.
+	//      The C++ constant buffer structures are copied to the constant buffers by the WriteConstantBuffer function: each to its own range of the upload ring (pConstantRing) if UploadRingEnabled is true and the device supports it, otherwise to pCBuffer and pObjectCBuffer.
 	//      Copying to the constant buffer always provides		  position information for the object rendered, as it does in this program.
 	//      Copying to the constant buffer may optionally provide scene    information for the object rendered, such as lighting information, timing information, among other details.
 	//      A constant buffer's information should be sent to the GPU only as needed, matching its frequency of update. For example, if position information and scene information are updated at different frequencies (at different times), then create two constant buffers, one for position information and one for scene information.
@@ -708,151 +1049,405 @@ void InitPipeline(void)
 	//        - A program can also copy data from another buffer (such as a render target or a stream-output target) into a constant buffer.
 	//***
 
-	// Create the buffer resource description structure used to define the constant buffer.
+	// Create the buffer resource description structure used to define the constant buffers.
 	D3D11_BUFFER_DESC bd;									// Describes the buffer resource.
 	ZeroMemory(&bd, sizeof(D3D11_BUFFER_DESC));				// ZeroMemory macro: Fills a block of memory with zeros.
 
 	// Assign values to the buffer resource description D3D11_BUFFER_DESC structure's members. Any subordinate members (variable.member.subordinatemember) are described in the comments.
-	bd.ByteWidth = sizeof(ConstantBuffer);					// Assigned a value specifying the size of the buffer in bytes. See the preceding comments for related information on the size of the constant buffer resource, including limitations.
-	bd.Usage = D3D11_USAGE_DEFAULT;							// Assigned a value that identifies how the buffer is expected to be read from and written to. Frequency of update is a key factor. A value of the D3D11_USAGE enumerated type,		i.e., D3D11_USAGE_DEFAULT:		  A resource that requires read and write access by the GPU. This is likely to be the most common usage choice.
+	bd.Usage = D3D11_USAGE_DYNAMIC;							// Assigned a value that identifies how the buffer is expected to be read from and written to. Frequency of update is a key factor. A value of the D3D11_USAGE enumerated type,		i.e., D3D11_USAGE_DYNAMIC:		  A resource that is accessible by both the GPU (read only) and the CPU (write only). The constant buffers are written by the CPU every frame.
 	bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;				// Assigned values in any combination by a bitwise OR operation specifying the flags for binding to graphics pipeline stages.		A value of the D3D11_BIND_FLAG enumerated type,	i.e., D3D11_BIND_CONSTANT_BUFFER: Bind a buffer as a constant buffer to a shader stage of the graphics pipeline; this flag may NOT be combined with any other bind flag.
+	bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;				// Assigned values in any combination by a bitwise OR operation specifying the types of CPU access allowed.							A value of the D3D11_CPU_ACCESS_FLAG enumerated type, i.e., D3D11_CPU_ACCESS_WRITE: The CPU can write to the buffer.
+
+	// Write the constant buffers to the upload ring if UploadRingEnabled is true and the device can bind part of a constant buffer (VSSetConstantBuffers1) and map a dynamic constant buffer with D3D11_MAP_WRITE_NO_OVERWRITE.
+	// ID3D11Device::CheckFeatureSupport member function:
+	//   Get information about the features that are supported by the current graphics driver, in this case the Direct3D 11.1 options.
+	D3D11_FEATURE_DATA_D3D11_OPTIONS options;				// Describes the Direct3D 11.1 features supported by the current graphics driver.
+	ZeroMemory(&options, sizeof(options));					// ZeroMemory macro: Fills a block of memory with zeros.
+	if (UploadRingEnabled &&
+		SUCCEEDED(dev->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))) &&
+		options.ConstantBufferOffsetting && options.MapNoOverwriteOnDynamicConstantBuffer &&
+		SUCCEEDED(devcon->QueryInterface(__uuidof(ID3D11DeviceContext1), (void**)&devcon1)))
+	{
+		// Create the upload ring, and the D3D11_QUERY_EVENT queries that tell the CPU when the GPU has finished a frame, i.e., when the frame's ranges of the upload ring may be written again.
+		bd.ByteWidth = CONSTANT_RING_SIZE;					// Assigned a value specifying the size of the buffer in bytes.
+		dev->CreateBuffer(&bd, NULL, &pConstantRing);
+		CreateUploadRing(ConstantRing, CONSTANT_RING_SIZE, UPLOAD_RING_CONSTANT_ALIGNMENT);
+
+		D3D11_QUERY_DESC qd;								// Describes the query.
+		ZeroMemory(&qd, sizeof(qd));						// ZeroMemory macro: Fills a block of memory with zeros.
+		qd.Query = D3D11_QUERY_EVENT;						// Assigned a value of the D3D11_QUERY enumerated type, i.e., D3D11_QUERY_EVENT: Determines whether or not the GPU is finished processing commands issued before the query was ended.
+		for (int i = 0; i < FRAME_FENCES_TOTAL; i++)
+			dev->CreateQuery(&qd, &FrameFences[i]);
+	}
+	else
+	{
+		// Create one dynamic buffer per constant buffer. Each is bound once, here, and rewritten with D3D11_MAP_WRITE_DISCARD when its contents change.
+		// ID3D11Device::CreateBuffer member function:
+		//   Create the buffer object (vertex buffer, index buffer, or shader constant buffer), in this case the constant buffer objects.
+		bd.ByteWidth = sizeof(FRAMECONSTANTS);				// Assigned a value specifying the size of the buffer in bytes. See the preceding comments for related information on the size of the constant buffer resource, including limitations.
+		dev->CreateBuffer(&bd,								// A pointer to a D3D11_BUFFER_DESC structure that describes the buffer, in this case a constant buffer as per bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER.
+			NULL,											// A pointer to a D3D11_SUBRESOURCE_DATA structure that describes the initialization data; use NULL to allocate space only (with the exception that it cannot be NULL if bd.Usage is D3D11_USAGE_IMMUTABLE).
+			&pCBuffer);										// &pCBuffer is the address of a pointer, pCBuffer, to the buffer interface for the buffer object created, in this case the per-frame constant buffer object.
+		bd.ByteWidth = sizeof(OBJECTCONSTANTS);
+		dev->CreateBuffer(&bd, NULL, &pObjectCBuffer);		// &pObjectCBuffer is the address of a pointer, pObjectCBuffer, to the buffer interface for the buffer object created, in this case the per-object constant buffer object.
+
+		// ID3D11DeviceContext::VSSetConstantBuffers member function:
+		//   Set the constant buffer objects to the vertex shader stage of the graphics pipeline: the per-frame constant buffer to register b0 and the per-object constant buffer to register b1 (see shaders.hlsl).
+		devcon->VSSetConstantBuffers(0,						// Index into the device's zero-based array to begin setting constant buffers to (ranges from 0 to D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT - 1).
+			1,												// Number of buffers to set (ranges from 0 to D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT - StartSlot).
+			&pCBuffer);										// &pCBuffer is the address of a pointer, pCBuffer, to the constant buffer interface.
+		devcon->VSSetConstantBuffers(1, 1, &pObjectCBuffer);
+	}
 
-	// ID3D11Device::CreateBuffer member function:
-	//   Create the buffer object (vertex buffer, index buffer, or shader constant buffer), in this case the constant buffer object.
-	dev->CreateBuffer(&bd,									// A pointer to a D3D11_BUFFER_DESC structure that describes the buffer, in this case a constant buffer as per bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER.
-		NULL,												// A pointer to a D3D11_SUBRESOURCE_DATA structure that describes the initialization data; use NULL to allocate space only (with the exception that it cannot be NULL if bd.Usage is D3D11_USAGE_IMMUTABLE).
-		&pCBuffer);											// &pCBuffer is the address of a pointer, pCBuffer, to the buffer interface for the buffer object created, in this case a constant buffer object.
+	// End: 3. Create the constant buffer object and set it to the vertex shader stage of the graphics pipeline.
 
-	// ID3D11DeviceContext::VSSetConstantBuffers member function:
-	//   Set the constant buffer object to the vertex shader stage of the graphics pipeline.
-	devcon->VSSetConstantBuffers(0,							// Index into the device's zero-based array to begin setting constant buffers to (ranges from 0 to D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT - 1).
-		1,													// Number of buffers to set (ranges from 0 to D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT - StartSlot).
-		&pCBuffer);											// &pCBuffer is the address of a pointer, pCBuffer, to the constant buffer interface.
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
 
-	// End: 3. Create the constant buffer object and set it to the vertex shader stage of the graphics pipeline.
+// ReloadShaders function: Definition
+//   This function is called before each frame when ShaderHotReloadEnabled is true. At most once every SHADER_HOT_RELOAD_INTERVAL milliseconds, it checks whether shaders.hlsl has changed and, if it has,
+//   compiles the shaders again and replaces the vertex shader and pixel shader objects with new ones.
+//   If either shader cannot be compiled, the current shaders are kept, and the shaders are compiled again only when the source file changes again.
+//   The input-layout object is not created again, so a change to the inputs of the VShader function takes effect only when the program is started again.
+void ReloadShaders(void)
+{
+	static ULONGLONG checkTime = 0;							// The time of the last check, in milliseconds since the system was started.
+	ULONGLONG time = GetTickCount64();
+	if (time - checkTime < SHADER_HOT_RELOAD_INTERVAL)
+		return;
+	checkTime = time;
+
+	if (!ShaderSourceChanged("shaders.hlsl", VertexShaderProgram) && !ShaderSourceChanged("shaders.hlsl", PixelShaderProgram))
+		return;
+
+	// Compile the shaders into copies of the current shader programs, so the current bytecode is kept if either fails.
+	ShaderProgram vertexShader = VertexShaderProgram;
+	ShaderProgram pixelShader = PixelShaderProgram;
+	int result = CompilePipelineShaders(vertexShader, pixelShader);
+	VertexShaderProgram.SourceSize = vertexShader.SourceSize;		// Record the version of the source file that was compiled, whether or not it compiled.
+	VertexShaderProgram.SourceWriteTime = vertexShader.SourceWriteTime;
+	PixelShaderProgram.SourceSize = pixelShader.SourceSize;
+	PixelShaderProgram.SourceWriteTime = pixelShader.SourceWriteTime;
+	if (result == 1)
+		return;
+
+	// Create the new shader objects, and replace the current shader objects with them.
+	ID3D11VertexShader* newVS;
+	ID3D11PixelShader* newPS;
+	if (FAILED(dev->CreateVertexShader(vertexShader.Bytecode.data(), vertexShader.Bytecode.size(), NULL, &newVS)))
+		return;
+	if (FAILED(dev->CreatePixelShader(pixelShader.Bytecode.data(), pixelShader.Bytecode.size(), NULL, &newPS)))
+	{
+		newVS->Release();
+		return;
+	}
+	pVS->Release();
+	pPS->Release();
+	pVS = newVS;
+	pPS = newPS;
+	InvalidateRenderStateCache(FrameStateCache);			// The render queue binds the new shaders with its next draw.
+	devcon->VSSetShader(pVS, 0, 0);
+	devcon->PSSetShader(pPS, 0, 0);
+	VertexShaderProgram = std::move(vertexShader);
+	PixelShaderProgram = std::move(pixelShader);
+	UpdateMemoryAccounting();
 }
 
 // InitGraphics function: Definition
 //   This function loads and initializes all graphics data.
-//     1. Call the objReader function, which reads and parses a single 3D object's descriptive information from a Wavefront .obj file and uses it to define the variables needed to render the 3D object, i.e., OurVertices and OurIndices.
+//     1. Load the binary mesh cache file of the Wavefront .obj file if it is up to date.
+//        Otherwise call the objReader function, which reads and parses a single 3D object's descriptive information from a Wavefront .obj file and uses it to define the variables needed to render the 3D object, i.e., OurVertices and OurIndices, optimize them, and save them to the binary mesh cache file.
 //
 //     2. Create the structures used to define the vertex buffer and index buffer.
 //
-//     3. Create the vertex buffer and assign values to it from the variable OurVertices.
+//     3. Write the contents of the vertex buffer from the variable OurVertices, and queue it for upload.
+//
+//     4. Write the contents of the index buffer from the variable OurIndices, followed by the variable MeshLodIndices, and queue it for upload.
 //
-//     4. Create the index buffer and assign values to it from the variable OurIndices.
+//     5. Place the instances of the object, and create the instance buffer.
 //
-//     5. Create the texture image from an image file.
+//     6. Create the texture image from an image file.
+//
+//   It returns 0 on success, or 1 if the Wavefront .obj file cannot be opened, a face element index is not valid, or the object has no triangles.
 int InitGraphics(void)
 {
 	//***
-	// 1. Call the objReader function, which reads and parses a single 3D object's descriptive information from a Wavefront .obj file and uses it to define the variables needed to render the 3D object, i.e., OurVertices and OurIndices.
+	// 1. Load the binary mesh cache file of the Wavefront .obj file if it is up to date.
+	//    Otherwise call the objReader function, which reads and parses a single 3D object's descriptive information from a Wavefront .obj file and uses it to define the variables needed to render the 3D object, i.e., OurVertices and OurIndices, and save them to the binary mesh cache file.
+	//    Either way, Vertices and Indices point to the vertex attributes and indices that are copied to the vertex buffer and index buffer, LodIndices points to the indices of the levels of detail copied after them, MeshLods describes each level of detail,
+	//    and Meshlets describes the meshlets of each level of detail.
+	//    When the binary mesh cache file is loaded, they point directly into the memory-mapped cache file, and OurVertices, OurIndices, and MeshLodIndices are not used.
 	//***
 
-	if (objReader() == 1)									// objReader returns 1 if it cannot open the Wavefront .obj file.
+	MeshCacheView meshCache;								// The memory-mapped binary mesh cache file, if it is loaded.
+	const VERTEX* Vertices;									// The vertex attributes copied to the vertex buffer.
+	const DWORD* Indices;									// The indices copied to the index buffer.
+	const DWORD* LodIndices;								// The indices of the levels of detail that follow level of detail 0, copied to the index buffer after Indices.
+	int LodIndicesTotal;									// The total number of indices in LodIndices.
+
+	if (MeshCacheEnabled && MeshCacheLoad(objReaderFileName, meshCache) == 0 && meshCache.PrimitivesTotal > 0)
 	{
-		// Cannot open the Wavefront .obj file.
+		// The binary mesh cache file is up to date: No parsing is necessary.
+		Vertices = meshCache.Vertices;
+		Indices = meshCache.Indices;
+		VertexAttributeSetsTotal = meshCache.VertexAttributeSetsTotal;
+		PrimitivesTotal = meshCache.PrimitivesTotal;
+		MeshLods.assign(meshCache.Lods, meshCache.Lods + meshCache.LodsTotal);
+		LodIndices = meshCache.LodIndices;
+		LodIndicesTotal = meshCache.LodIndicesTotal;
+		Meshlets.assign(meshCache.Meshlets, meshCache.Meshlets + meshCache.MeshletsTotal);
+	}
+	else
+	{
+		if (objReader() == 1)								// objReader returns 1 if it cannot open the Wavefront .obj file, or a face element index is not valid.
+		{
+			// Cannot open the Wavefront .obj file, or a face element index is not valid.
 
-		// Terminate this function with a return code indicating an error.
-		return 1;
+			// Terminate this function with a return code indicating an error.
+			return 1;
+		}
+
+		// A Wavefront .obj file without face element statements has no triangles to draw, and no vertex attributes to compute the bounding sphere of the object from (see 2.).
+		// A binary mesh cache file of such an object, e.g., saved by an earlier version of this program, is not loaded (see above), so the Wavefront .obj file is parsed, and rejected, here.
+		if (PrimitivesTotal == 0 || VertexAttributeSetsTotal == 0)
+		{
+			// The object has no triangles.
+			OutputDebugStringA("objRenderer: the Wavefront .obj file has no triangles.\n");
+			MeshCacheUnload(meshCache);
+
+			// Terminate this function with a return code indicating an error.
+			return 1;
+		}
+
+		// Weld the sets of vertex attributes of OurVertices that the objReader function kept apart only because of tiny floating-point differences, before the mesh is optimized.
+		// VertexWeldResult records how many sets of vertex attributes, triangles, and bytes welding saved.
+		if (VertexWelderEnabled)
+		{
+			WeldVertices(OurVertices, OurIndices, VertexWelderTolerances, VertexWeldResult);
+			VertexAttributeSetsTotal = VertexWeldResult.VerticesAfter;
+			PrimitivesTotal -= VertexWeldResult.PrimitivesRemoved;
+		}
+
+		// Reorder the triangles of OurIndices for the GPU's post-transform vertex cache, unless the Wavefront .obj file must be drawn in file order.
+		// VertexCacheBefore and VertexCacheAfter record how many vertices the vertex shader transforms per triangle before and after reordering.
+		if (MeshOptimizerVertexCacheEnabled)
+		{
+			AnalyzeVertexCache(OurIndices.data(), PrimitivesTotal, VertexAttributeSetsTotal, VERTEX_CACHE_ANALYZE_SIZE, VertexCacheBefore);
+			OptimizeVertexCache(OurIndices.data(), PrimitivesTotal, VertexAttributeSetsTotal);
+			AnalyzeVertexCache(OurIndices.data(), PrimitivesTotal, VertexAttributeSetsTotal, VERTEX_CACHE_ANALYZE_SIZE, VertexCacheAfter);
+		}
+
+		// Reorder OurVertices into the order OurIndices first references them, so the GPU reads the vertex buffer from memory more effectively.
+		// VertexFetchBefore and VertexFetchAfter record how many bytes of the vertex buffer are read before and after reordering.
+		if (MeshOptimizerVertexFetchEnabled)
+		{
+			AnalyzeVertexFetch(OurIndices.data(), PrimitivesTotal, VertexAttributeSetsTotal, sizeof(VERTEX), VertexFetchBefore);
+			OptimizeVertexFetch(OurVertices.data(), OurIndices.data(), PrimitivesTotal, VertexAttributeSetsTotal);
+			AnalyzeVertexFetch(OurIndices.data(), PrimitivesTotal, VertexAttributeSetsTotal, sizeof(VERTEX), VertexFetchAfter);
+		}
+
+		// Build the levels of detail of OurIndices, each with about half the triangles of the one before, and reorder the triangles of each for the GPU's post-transform vertex cache.
+		// Every level of detail is drawn with the same vertex buffer, so OurVertices is not changed.
+		if (MeshSimplifierLodEnabled)
+		{
+			BuildMeshLods(OurVertices.data(), VertexAttributeSetsTotal, OurIndices.data(), PrimitivesTotal, MeshLods, MeshLodIndices);
+			if (MeshOptimizerVertexCacheEnabled)
+				for (size_t l = 1; l < MeshLods.size(); l++)
+					OptimizeVertexCache(MeshLodIndices.data() + (MeshLods[l].FirstIndex - PrimitivesTotal * 3), MeshLods[l].PrimitivesTotal, VertexAttributeSetsTotal);
+		}
+		else
+		{
+			// Level of detail 0 only.
+			MeshLods.assign(1, MeshLod());
+			MeshLods[0].PrimitivesTotal = PrimitivesTotal;
+			MeshLodIndices.clear();
+		}
+
+		// Partition the triangles of each level of detail into meshlets, which the RenderFrame function culls before drawing each instance of the object.
+		// The triangles are not reordered, so each meshlet is a run of triangles in the order chosen for the post-transform vertex cache.
+		Meshlets.clear();
+		for (size_t l = 0; l < MeshLods.size(); l++)
+		{
+			const DWORD* lodIndices = l == 0 ? OurIndices.data() : MeshLodIndices.data() + (MeshLods[l].FirstIndex - PrimitivesTotal * 3);
+			MeshLods[l].FirstMeshlet = (int)Meshlets.size();
+			BuildMeshlets(OurVertices.data(), VertexAttributeSetsTotal, lodIndices, MeshLods[l].FirstIndex, MeshLods[l].PrimitivesTotal, Meshlets);
+			MeshLods[l].MeshletsTotal = (int)Meshlets.size() - MeshLods[l].FirstMeshlet;
+		}
+
+		Vertices = OurVertices.data();
+		Indices = OurIndices.data();
+		LodIndices = MeshLodIndices.data();
+		LodIndicesTotal = (int)MeshLodIndices.size();
+
+		// Save the binary mesh cache file for the next launch. If it cannot be saved, the Wavefront .obj file is simply parsed again next time.
+		if (MeshCacheEnabled)
+			MeshCacheSave(objReaderFileName, Vertices, VertexAttributeSetsTotal, Indices, PrimitivesTotal, MeshLods.data(), (int)MeshLods.size(), LodIndices, LodIndicesTotal, Meshlets.data(), (int)Meshlets.size());
 	}
 
-	// End: 1. Call the objReader function, which reads and parses a single 3D object's descriptive information from a Wavefront .obj file and uses it to define the variables needed to render the 3D object, i.e., OurVertices and OurIndices.
+	// End: 1. Load the binary mesh cache file of the Wavefront .obj file if it is up to date.
 
 	//***
 	// 2. Create the structures used to define the vertex buffer and index buffer.
 	//***
 
-	// Create the mapped subresource structure that provides access to subresource data. It is used to define the vertex buffer and index buffer.
-	// The ID3D11DeviceContext::Map member function uses this structure.
-	D3D11_MAPPED_SUBRESOURCE ms;							// Provides access to subresource data. ms.pData is used to copy data to both the vertex buffer and the index buffer.
-
 	// Create the buffer resource description structure used to define the vertex buffer and index buffer.
 	D3D11_BUFFER_DESC bd;									// Describes the buffer resource.
 	ZeroMemory(&bd, sizeof(D3D11_BUFFER_DESC));				// ZeroMemory macro: Fills a block of memory with zeros.
 
+	// Choose the format of the vertex buffer and index buffer.
+	// When VertexPackingEnabled is true, each vertex is packed into a 16 byte PACKEDVERTEX structure, and the vertex shader receives the range of each quantized coordinate in the constant buffer.
+	// When every index fits in 16 bits, each index is packed into 2 bytes instead of 4. This does not change the indices.
+	VertexPackingBounds packingBounds;						// The range of each quantized coordinate of the PACKEDVERTEX structures.
+	if (VertexPackingEnabled)
+	{
+		ComputeVertexPackingBounds(Vertices, VertexAttributeSetsTotal, packingBounds);
+		ObjectConstants.GeometricVertexMinimum = XMFLOAT4(packingBounds.GeometricVertexMinimum.x, packingBounds.GeometricVertexMinimum.y, packingBounds.GeometricVertexMinimum.z, 0.0f);
+		ObjectConstants.GeometricVertexScale = XMFLOAT4(packingBounds.GeometricVertexScale.x, packingBounds.GeometricVertexScale.y, packingBounds.GeometricVertexScale.z, 0.0f);
+		ObjectConstants.VertexTextureCoordinateBounds = XMFLOAT4(packingBounds.VertexTextureCoordinateMinimum.x, packingBounds.VertexTextureCoordinateMinimum.y, packingBounds.VertexTextureCoordinateScale.x, packingBounds.VertexTextureCoordinateScale.y);
+	}
+	VertexStride = VertexPackingEnabled ? sizeof(PACKEDVERTEX) : sizeof(VERTEX);
+	IndexFormat = VertexAttributeSetsTotal < 65536 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+
+	// Compute the bounding sphere of the object, used to select the level of detail of each instance of the object.
+	XMFLOAT3 boundsMinimum = Vertices[0].GeometricVertex, boundsMaximum = Vertices[0].GeometricVertex;
+	for (int i = 1; i < VertexAttributeSetsTotal; i++)
+	{
+		XMStoreFloat3(&boundsMinimum, XMVectorMin(XMLoadFloat3(&boundsMinimum), XMLoadFloat3(&Vertices[i].GeometricVertex)));
+		XMStoreFloat3(&boundsMaximum, XMVectorMax(XMLoadFloat3(&boundsMaximum), XMLoadFloat3(&Vertices[i].GeometricVertex)));
+	}
+	XMVECTOR boundsCenter = XMVectorScale(XMVectorAdd(XMLoadFloat3(&boundsMinimum), XMLoadFloat3(&boundsMaximum)), 0.5f);
+	XMVECTOR boundsRadius = XMVectorZero();
+	for (int i = 0; i < VertexAttributeSetsTotal; i++)
+		boundsRadius = XMVectorMax(boundsRadius, XMVector3LengthSq(XMVectorSubtract(XMLoadFloat3(&Vertices[i].GeometricVertex), boundsCenter)));
+	XMStoreFloat3(&ObjectBoundsCenter, boundsCenter);
+	ObjectBoundsRadius = XMVectorGetX(XMVectorSqrt(boundsRadius));
+
 	// End: 2. Create the structures used to define the vertex buffer and index buffer.
 
 	//***
-	// 3. Create the vertex buffer and assign values to it from the variable OurVertices.
+	// 3. Write the contents of the vertex buffer from the variable OurVertices, and queue it for upload.
+	//    The vertex buffer and index buffer never change, so they are created by the UploadMeshes function, as D3D11_USAGE_IMMUTABLE buffers that only the GPU can access,
+	//    during the first frames, at most MeshUploadFrameBudget bytes per frame (see meshUpload.h). The object is drawn once both are uploaded (see ObjectUploaded).
 	//***
 
-	// Assign values to the buffer resource description D3D11_BUFFER_DESC structure's members. Any subordinate members (variable.member.subordinatemember) are described in the comments.
-	bd.ByteWidth = sizeof(VERTEX) * VertexAttributeSetsTotal;	// Assigned a value specifying the size of the buffer in bytes. The vertex buffer resource's size is the size of the VERTEX structure * the total number of array elements in OurVertices (VertexAttributeSetsTotal).
-	bd.Usage = D3D11_USAGE_DYNAMIC;								// Assigned a value that identifies how the buffer is expected to be read from and written to. Frequency of update is a key factor.	A value of the D3D11_USAGE enumerated type,			  i.e., D3D11_USAGE_DYNAMIC:	  A resource that is accessible by both the GPU (read only) and the CPU (write only). A dynamic resource is a good choice for a resource that will be updated by the CPU at least once per frame. To update a dynamic resource, use a Map member function.
-	bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;					// Assigned values in any combination by a bitwise OR operation specifying the flags for binding to graphics pipeline stages.		A value of the D3D11_BIND_FLAG enumerated type,		  i.e., D3D11_BIND_VERTEX_BUFFER: Bind a buffer as a vertex buffer to the input-assembler stage of the graphics pipeline.
-	bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;					// Assigned values in any combination by a bitwise OR operation specifying the flags for binding to graphics pipeline stages.		A value of the D3D11_CPU_ACCESS_FLAG enumerated type, i.e., D3D11_CPU_ACCESS_WRITE:	  The resource is to be mappable so that the CPU can change its contents. Resources created with this flag cannot be set as outputs of the graphics pipeline and must be created with either dynamic or staging usage (see D3D11_USAGE).
+	// The mesh upload manager keeps the contents of each buffer until the buffer is uploaded.
+	CreateMeshUploader(MeshUploads, MeshUploadFrameBudget);
+	EnqueueObjectVertices(Vertices, packingBounds);
 
-	// ID3D11Device::CreateBuffer member function:
-	//   Create a buffer object (vertex buffer, index buffer, or shader constant buffer), in this case the vertex buffer object.
-	dev->CreateBuffer(&bd,									// A pointer to a buffer resource description structure that describes the buffer, in this case the vertex buffer, as per bd.BindFlags = D3D11_BIND_VERTEX_BUFFER.
-		NULL,												// A pointer to a D3D11_SUBRESOURCE_DATA structure that describes the initialization data; use NULL to allocate space only (with the exception that it cannot be NULL if bd.Usage is D3D11_USAGE_IMMUTABLE).
-		&pVBuffer);											// &pVBuffer is the address of a pointer, pVBuffer, to the buffer interface for the buffer object created, in this case the vertex buffer object.
-
-	// Assign the vertex attributes by copying them from OurVertices to the vertex buffer.
-	// ID3D11DeviceContext::Map member function:
-	//   Mapping a buffer allows us to access it.
-	//   Gets a pointer to the data contained in a subresource, and denies the GPU access to that subresource.
-	//   The third parameter is a set of flags that allows us to control the CPUs access to the buffer while it's mapped.
-	devcon->Map(pVBuffer,									// A pointer to the vertex buffer interface.
-		NULL,												// Index number of the subresource.
-		D3D11_MAP_WRITE_DISCARD,							// Flag that specifies the CPU's read and write permissions for a resource. A value of the D3D11_MAP enumerated type, i.e., D3D11_MAP_WRITE_DISCARD: Resource is mapped for writing; the previous contents of the resource will be undefined. The resource must have been created with write access and dynamic usage. "Previous contents of buffer are erased, and new buffer is opened for writing" DirectxTutorial.com.
-		NULL,												// Flag that specifies how the CPU should respond when an application calls the ID3D11DeviceContext::Map method on a resource that is being used by the GPU. A value of the D3D11_MAP_FLAG enumerated type. "D3D11_MAP_FLAG_DO_NOT_WAIT cannot be used with D3D11_MAP_WRITE_DISCARD or D3D11_MAP_WRITE_NOOVERWRITE" Microsoft.com. "It can be NULL or D3D11_MAP_FLAG_DO_NOT_WAIT. This flag forces the program to continue, even if the GPU is still working with the buffer" DirectxTutorial.com.
-		&ms);												// A pointer to the mapped subresource D3D11_MAPPED_SUBRESOURCE structure for the mapped subresource. The Map member function initializes this structure with necessary information.
-	memcpy(ms.pData, &OurVertices[0], bd.ByteWidth);		// Copy the vertex attributes from OurVertices to the vertex buffer.
-	// D3D11DeviceContext::Unmap member function:
-	//   Invalidate the pointer to a resource and re-enable the GPU's access to that resource. Disable the CPU's access to that resource.
-	devcon->Unmap(pVBuffer,									// A pointer to the vertex buffer interface.
-		NULL);												// A subresource to be unmapped.
+	// End: 3. Write the contents of the vertex buffer from the variable OurVertices, and queue it for upload.
+
+	//***
+	// 4. Write the contents of the index buffer from the variable OurIndices, and queue it for upload.
+	//***
+
+	EnqueueObjectIndices(Indices, LodIndices, LodIndicesTotal);
+
+	// Keep a copy of the vertex attributes and indices for the software rasterizer, which reads them as the GPU reads the vertex buffer and index buffer.
+	if (SoftwareRasterizerEnabled)
+	{
+		SoftwareVertices.assign(Vertices, Vertices + VertexAttributeSetsTotal);
+		SoftwareIndices.assign(Indices, Indices + (size_t)PrimitivesTotal * 3);
+		SoftwareIndices.insert(SoftwareIndices.end(), LodIndices, LodIndices + LodIndicesTotal);
+	}
 
-	// End: 3. Create the vertex buffer and assign values to it from the variable OurVertices.
+	// The vertex attributes and indices have been copied to the mesh upload manager. Unmap the binary mesh cache file, if it was loaded.
+	MeshCacheUnload(meshCache);
+
+	// End: 4. Write the contents of the index buffer from the variable OurIndices, and queue it for upload.
 
 	//***
-	// 4. Create the index buffer and assign values to it from the variable OurIndices.
+	// 5. Place the instances of the object, and create the instance buffer.
+	//    The instance buffer is written each frame by the RenderFrame function, with one INSTANCEDATA structure per instance that is not culled, so it is large enough for every instance.
 	//***
 
-	// Assign values to the buffer resource description D3D11_BUFFER_DESC structure's members. Any subordinate members (variable.member.subordinatemember) are described in the comments.
-	bd.ByteWidth = sizeof(DWORD) * (PrimitivesTotal * 3);	// Assigned a value specifying the size of the buffer in bytes. Three geometric vertex indices (each pointing to a vertex in the vertex buffer) describe each triangle primitive, and PrimitivesTotal is the total number of triangles comprising the object. Therefore PrimitivesTotal * 3.
-	bd.Usage = D3D11_USAGE_DYNAMIC;							// Assigned a value that identifies how the buffer is expected to be read from and written to. Frequency of update is a key factor.	A value of the D3D11_USAGE enumerated type,			  i.e., D3D11_USAGE_DYNAMIC:	 A resource that is accessible by both the GPU (read only) and the CPU (write only). A dynamic resource is a good choice for a resource that will be updated by the CPU at least once per frame. To update a dynamic resource, use a Map member function.
-	bd.BindFlags = D3D11_BIND_INDEX_BUFFER;					// Assigned values in any combination by a bitwise OR operation specifying the flags for binding to graphics pipeline stages.		A value of the D3D11_BIND_FLAG enumerated type,		  i.e., D3D11_BIND_INDEX_BUFFER: Bind a buffer as an index buffer to the input-assembler stage of the graphics pipeline.
-	bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;				// Assigned values in any combination by a bitwise OR operation specifying the flags for binding to graphics pipeline stages.		A value of the D3D11_CPU_ACCESS_FLAG enumerated type, i.e., D3D11_CPU_ACCESS_WRITE:	 The resource is to be mappable so that the CPU can change its contents. Resources created with this flag cannot be set as outputs of the graphics pipeline and must be created with either dynamic or staging usage (see D3D11_USAGE).
+	PlaceObjectInstances();
+
+	// Assign values to the buffer resource description D3D11_BUFFER_DESC structure's members.
+	bd.ByteWidth = sizeof(INSTANCEDATA) * (UINT)ObjectInstances.Scale.size();	// Assigned a value specifying the size of the buffer in bytes: one INSTANCEDATA structure per instance of the object.
+	bd.Usage = D3D11_USAGE_DYNAMIC;							// A resource that is accessible by both the GPU (read only) and the CPU (write only), updated by the CPU once per frame with the Map member function.
+	bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;				// Bind the buffer as a vertex buffer to the input-assembler stage of the graphics pipeline. Its input elements are per-instance data (see InitPipeline).
+	bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;				// The resource is to be mappable so that the CPU can change its contents.
 
 	// ID3D11Device::CreateBuffer member function:
-	//   Create a buffer object (vertex buffer, index buffer, or shader constant buffer), in this case the index buffer object.
-	dev->CreateBuffer(&bd,									// A pointer to a buffer resource description structure that describes the buffer, in this case an index buffer, as per bd.BindFlags = D3D11_BIND_INDEX_BUFFER.
-		NULL,												// A pointer to a D3D11_SUBRESOURCE_DATA structure that describes the initialization data; use NULL to allocate space only (with the exception that it cannot be NULL if bd.Usage is D3D11_USAGE_IMMUTABLE).
-		&pIBuffer);											// &pIBuffer is the address of a pointer, pIBuffer, to the buffer interface for the buffer object created, in this case an index buffer object.
-
-	// Assign the index information by copying it from OurIndices to the index buffer.
-	// ID3D11DeviceContext::Map member function:
-	//   Mapping a buffer allows us to access it.
-	//   Gets a pointer to the data contained in a subresource, and denies the GPU access to that subresource.
-	//   The third parameter is a set of flags that allows us to control the CPUs access to the buffer while it's mapped.
-	devcon->Map(pIBuffer,									// A pointer to the index buffer interface.
-		NULL,												// Index number of the subresource.
-		D3D11_MAP_WRITE_DISCARD,							// Flag that specifies the CPU's read and write permissions for a resource. A value of the D3D11_MAP enumerated type, i.e., D3D11_MAP_WRITE_DISCARD: Resource is mapped for writing; the previous contents of the resource will be undefined. The resource must have been created with write access and dynamic usage. "Previous contents of buffer are erased, and new buffer is opened for writing" DirectxTutorial.com.
-		NULL,												// Flag that specifies how the CPU should respond when an application calls the ID3D11DeviceContext::Map method on a resource that is being used by the GPU. A value of the D3D11_MAP_FLAG enumerated type. "D3D11_MAP_FLAG_DO_NOT_WAIT cannot be used with D3D11_MAP_WRITE_DISCARD or D3D11_MAP_WRITE_NOOVERWRITE" Microsoft.com. "It can be NULL or D3D11_MAP_FLAG_DO_NOT_WAIT. This flag forces the program to continue, even if the GPU is still working with the buffer" DirectxTutorial.com.
-		&ms);												// A pointer to the mapped subresource D3D11_MAPPED_SUBRESOURCE structure for the mapped subresource. The Map member function initializes this structure with necessary information.
-	memcpy(ms.pData, &OurIndices[0], bd.ByteWidth);			// Copy the index information from OurIndices to the index buffer.
-	// D3D11DeviceContext::Unmap member function:
-	//   Invalidate the pointer to a resource and re-enable the GPU's access to that resource. Disable the CPU's access to that resource.
-	devcon->Unmap(pIBuffer,									// A pointer to the index buffer interface.
-		NULL);												// A subresource to be unmapped.
+	//   Create a buffer object, in this case the instance buffer object.
+	dev->CreateBuffer(&bd,									// A pointer to a buffer resource description structure that describes the buffer.
+		NULL,												// NULL to allocate space only. The buffer is written by the RenderFrame function.
+		&pInstanceBuffer);									// &pInstanceBuffer is the address of a pointer, pInstanceBuffer, to the buffer interface for the buffer object created, in this case the instance buffer object.
 
-	// End: 4. Create the index buffer and assign values to it from the variable OurIndices.
+	// The software rasterizer reads the INSTANCEDATA structures from a copy of the instance buffer.
+	if (SoftwareRasterizerEnabled)
+		SoftwareInstances.resize(ObjectInstances.Scale.size());
+
+	// End: 5. Place the instances of the object, and create the instance buffer.
 
 	//***
-	// 5. Create the texture image from an image file.
+	// 6. Create the texture image from an image file.
+	//    When TextureCacheEnabled is true, the texture image is created from the texture cache file of the image file, i.e., its block-compressed mipmap chain (see textureCache.h), which is cooked first if it is missing or out of date.
+	//    Otherwise, or if the texture cache file cannot be cooked, the texture image is created from the image file itself, without a mipmap chain.
 	//***
 
-	// DirectX::CreateWICTextureFromFile function:
-	//   Loads a WIC-supported bitmap file from disk, creates a Direct3D 11 resource from it, and optionally a Direct3D 11 shader resource view.
-	CreateWICTextureFromFile(dev,							// A pointer to the device interface.
-		L"Wood.png",										// The filename of the texture image file.
-		NULL,												// NULL, as in most use cases for rendering you only need the shader resource view interface (the parameter below).
+	TextureCacheView textureCache;							// The memory-mapped texture cache file, if it is loaded.
+	if (TextureCacheEnabled && (TextureCacheLoad("Wood.png", textureCache) == 0 || (CookTexture("Wood.png", TextureCacheFormat) == 0 && TextureCacheLoad("Wood.png", textureCache) == 0)))
+	{
+		// Describe the texture image: every level of the mipmap chain, in the block-compressed format of the texture cache file, never changed once created.
+		D3D11_TEXTURE2D_DESC textureDesc;
+		ZeroMemory(&textureDesc, sizeof(textureDesc));
+		textureDesc.Width = textureCache.Width;				// The width of level 0, in texels.
+		textureDesc.Height = textureCache.Height;			// The height of level 0, in texels.
+		textureDesc.MipLevels = textureCache.MipLevels;		// The number of levels in the mipmap chain. The default sampler state filters between them (D3D11_FILTER_MIN_MAG_MIP_LINEAR).
+		textureDesc.ArraySize = 1;							// One texture.
+		textureDesc.Format = (DXGI_FORMAT)textureCache.Format;	// DXGI_FORMAT_BC1_UNORM or DXGI_FORMAT_BC7_UNORM.
+		textureDesc.SampleDesc.Count = 1;					// Textures sampled by a shader have one sample per texel.
+		textureDesc.Usage = D3D11_USAGE_IMMUTABLE;			// A resource that can only be read by the GPU, initialized when it is created.
+		textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;	// Bind the texture image to a shader stage.
+
+		// The initial data of each level: its blocks, in the memory-mapped texture cache file, and the size of one row of blocks.
+		D3D11_SUBRESOURCE_DATA mipData[TEXTURE_MIP_LEVELS_MAXIMUM];
+		for (int level = 0; level < textureCache.MipLevels; level++)
+		{
+			mipData[level].pSysMem = textureCache.MipData[level];
+			mipData[level].SysMemPitch = textureCache.MipRowPitch[level];
+			mipData[level].SysMemSlicePitch = textureCache.MipSize[level];
+		}
+
+		// ID3D11Device::CreateTexture2D member function:
+		//   Create an array of 2D textures, in this case one texture image with its mipmap chain, copying the initial data of every level to the GPU.
+		ID3D11Texture2D* pTexture;
+		dev->CreateTexture2D(&textureDesc, mipData, &pTexture);
+
+		// ID3D11Device::CreateShaderResourceView member function:
+		//   Create a shader resource view for accessing the texture image, in this case every level of its mipmap chain (NULL: a view of the entire resource).
+		dev->CreateShaderResourceView(pTexture, NULL, &pTextureView);
+		pTexture->Release();								// The shader resource view holds a reference to the texture image.
+
+		// The blocks have been copied to the texture image. Unmap the texture cache file.
+		for (int level = 0; level < textureCache.MipLevels; level++)
+			TextureBytes += textureCache.MipSize[level];
+		TextureCacheUnload(textureCache);
+	}
+	else
+	{
+		// DirectX::CreateWICTextureFromFile function:
+		//   Loads a WIC-supported bitmap file from disk, creates a Direct3D 11 resource from it, and optionally a Direct3D 11 shader resource view.
+		CreateWICTextureFromFile(dev,						// A pointer to the device interface.
+			L"Wood.png",									// The filename of the texture image file.
+			NULL,											// NULL, as in most use cases for rendering you only need the shader resource view interface (the parameter below).
 															// Otherwise, you would specify &pTexture:
 															// &pTexture	 is the address of a pointer, pTexture,		to the resource				interface for the resource	  created, in this case a texture image.
-		&pTextureView);										// &pTextureView is the address of a pointer, pTextureView, to the shader resource view interface for the subresource created, in this case a texture image.
+			&pTextureView);									// &pTextureView is the address of a pointer, pTextureView, to the shader resource view interface for the subresource created, in this case a texture image.
+
+		// The texture image has one level, of 4 bytes per texel: the WICTextureLoader module converts the image file to a 32-bit format.
+		if (pTextureView != NULL)
+		{
+			ID3D11Resource* pTexture;
+			pTextureView->GetResource(&pTexture);
+			D3D11_TEXTURE2D_DESC textureDesc;
+			((ID3D11Texture2D*)pTexture)->GetDesc(&textureDesc);
+			TextureBytes = (size_t)textureDesc.Width * textureDesc.Height * 4;
+			pTexture->Release();
+		}
+	}
 
 	// ID3D11DeviceContext::PSSetShaderResources member function:
 	//   Bind an array of shader resources to the pixel shader stage.
@@ -860,27 +1455,600 @@ int InitGraphics(void)
 		1,													// Number of shader resources to set.
 		&pTextureView);										// &pTextureView is the address of a pointer, pTextureView, to the array of (in this case an array of one) shader resource view interfaces for the subresources created, in this case a texture image.
 
-	// End: 5. Create the texture image from an image file.
+	// The software rasterizer reads the same texture image file into memory, and renders into a render target of the same size and number of samples per pixel as the back buffer.
+	if (SoftwareRasterizerEnabled)
+	{
+		LoadPngFile("Wood.png", SoftwareTexture);			// If the file cannot be read, SoftwareTexture is empty, and the software rasterizer samples (0, 0, 0, 0), as a shader does when no texture is bound.
+		CreateSoftwareRenderTarget(SoftwareTarget, SCREEN_WIDTH, SCREEN_HEIGHT, 4);
+	}
+
+	// End: 6. Create the texture image from an image file.
+
+	UpdateMemoryAccounting();
 
 	// Return to the calling program with a return code indicating success.
 	return 0;
 }
 
+// PlaceObjectInstances function: Definition
+//   This function places the ObjectInstancesTotal instances of the object in the world (ObjectInstances). Their rotations are updated each frame by the RenderFrame function.
+//   The first instance is at the origin, and the second instance is offset from it along the y-axis. Further instances are placed on a square grid in the x-z plane behind them (away from the camera),
+//   spaced so that the bounding spheres of neighboring instances do not overlap.
+void PlaceObjectInstances(void)
+{
+	int instancesTotal = ObjectInstancesTotal > 1 ? ObjectInstancesTotal : 1;
+	ResizeInstanceTransforms(ObjectInstances, instancesTotal);
+	if (instancesTotal > 1)
+		ObjectInstances.PositionY[1] = 3.0f;
+
+	int gridTotal = instancesTotal - 2;						// The number of instances placed on the grid.
+	if (gridTotal <= 0)
+		return;
+	int side = (int)ceilf(sqrtf((float)gridTotal));			// The number of instances along each side of the grid.
+	float spacing = 2.5f * ObjectBoundsRadius;
+	for (int k = 0; k < gridTotal; k++)
+	{
+		int row = k / side, column = k % side;
+		ObjectInstances.PositionX[2 + k] = (column - (side - 1) * 0.5f) * spacing;
+		ObjectInstances.PositionZ[2 + k] = -(row + 1) * spacing;
+	}
+}
+
+// AnimateObjectInstances function: Definition
+//   This function updates the rotation of each instance of the object (ObjectInstances): the second instance is given Rotation2, and every other instance Rotation.
+//   It is run by the frame job (see the RenderFrame function), and the instances are divided among the threads of the job system when there are enough of them.
+void AnimateObjectInstances(const XMFLOAT4& Rotation, const XMFLOAT4& Rotation2)
+{
+	JobParallelFor((int)ObjectInstances.Scale.size(), INSTANCE_ANIMATION_PARALLEL_MINIMUM, [&](int Begin, int End)
+	{
+		for (int i = Begin; i < End; i++)
+		{
+			const XMFLOAT4& rotation = i == 1 ? Rotation2 : Rotation;
+			ObjectInstances.RotationX[i] = rotation.x;
+			ObjectInstances.RotationY[i] = rotation.y;
+			ObjectInstances.RotationZ[i] = rotation.z;
+			ObjectInstances.RotationW[i] = rotation.w;
+		}
+	});
+}
+
+// CullObjectMeshlets function: Definition
+//   This function finds the ranges of the index buffer (Runs) with which to draw level of detail Lod of an instance of the object placed in the world by matWorld, and projected by matFinal (matWorld x matViewProjection), seen from EyePosition.
+//   When MeshletCullingEnabled is true, the meshlets of the level of detail that are outside the viewing frustum or face away from the camera are culled (see the CullMeshlets function), and the counts are added to Statistics.
+//   Otherwise the whole level of detail is drawn as one range. It returns the number of ranges.
+int CullObjectMeshlets(FXMMATRIX matWorld, CXMMATRIX matFinal, FXMVECTOR EyePosition, int Lod, std::vector<MeshletRun>& Runs, MeshletCullStatistics& Statistics)
+{
+	const MeshLod& lod = MeshLods[Lod];
+	if (!MeshletCullingEnabled || lod.MeshletsTotal == 0)
+	{
+		Runs.assign(1, { lod.FirstIndex, lod.PrimitivesTotal });
+		return 1;
+	}
+
+	// The bounds of the meshlets are in object space, so the position of the camera is converted to object space.
+	XMVECTOR eye = XMVector3TransformCoord(EyePosition, XMMatrixInverse(nullptr, matWorld));
+	return CullMeshlets(Meshlets.data() + lod.FirstMeshlet, lod.MeshletsTotal, matFinal, eye, Runs, Statistics);
+}
+
+// CullInstanceMeshlets function: Definition
+//   This function culls the meshlets of every instance in a level of detail with only a few instances (at most INSTANCE_MESHLET_CULLING_MAXIMUM, see InstanceBatches), and builds the ranges of the index buffer with which to draw each of them
+//   (MeshletCulledInstances, MeshletCulledRuns, and MeshletCulledStatistics). It is run by the frame job, after the BuildInstanceBatches function, and each instance is culled by its own job.
+void CullInstanceMeshlets(FXMMATRIX matViewProjection, FXMVECTOR EyePosition)
+{
+	std::vector<int> lods;									// The level of detail of each instance whose meshlets are culled.
+	MeshletCulledInstances.clear();
+	if (MeshletCullingEnabled)
+		for (const InstanceBatch& batch : InstanceBatches)
+			if (MeshLods[batch.Lod].MeshletsTotal > 0 && batch.InstancesTotal <= INSTANCE_MESHLET_CULLING_MAXIMUM)
+				for (int instance = batch.FirstInstance; instance < batch.FirstInstance + batch.InstancesTotal; instance++)
+				{
+					MeshletCulledInstances.push_back(instance);
+					lods.push_back(batch.Lod);
+				}
+
+	int culledTotal = (int)MeshletCulledInstances.size();
+	MeshletCulledRuns.resize(culledTotal);
+	MeshletCulledStatistics.assign(culledTotal, MeshletCullStatistics());
+	JobParallelFor(culledTotal, 1, [&](int Begin, int End)
+	{
+		for (int k = Begin; k < End; k++)
+		{
+			int instance = MeshletCulledInstances[k];
+			XMMATRIX matWorld = InstanceWorldMatrix(GetInstanceTransform(ObjectInstances, InstanceOrder[instance]));
+			CullObjectMeshlets(matWorld, matWorld * matViewProjection, EyePosition, lods[k], MeshletCulledRuns[k], MeshletCulledStatistics[k]);
+		}
+	});
+}
+
+// RecordInstanceDraws function: Definition
+//   This function records the draws of the current frame into FrameQueue, one command list per level of detail drawn (InstanceBatches), each recorded by its own job. It is run by the frame job, after the CullInstanceMeshlets function.
+//   Every instance with the same level of detail is drawn by one draw; when the meshlets of its instances were culled (see MeshletCulledInstances), each instance is drawn by one draw per range of consecutive meshlets that were not culled (see MeshletCulledRuns).
+//   The level of detail increases with the distance from the camera, so it is the depth of each draw's sort key.
+void RecordInstanceDraws(void)
+{
+	// Nothing is drawn until the vertex buffer and index buffer are uploaded.
+	if (!ObjectUploaded)
+	{
+		ResetRenderQueue(FrameQueue, 0);
+		return;
+	}
+
+	// Find the first instance in MeshletCulledInstances of each level of detail whose meshlets were culled, or -1.
+	int batchesTotal = (int)InstanceBatches.size();
+	std::vector<int> firstCulled(batchesTotal, -1);
+	size_t culled = 0;										// The next instance in MeshletCulledInstances.
+	for (int b = 0; b < batchesTotal; b++)
+	{
+		if (culled < MeshletCulledInstances.size() && MeshletCulledInstances[culled] == InstanceBatches[b].FirstInstance)
+		{
+			firstCulled[b] = (int)culled;
+			culled += InstanceBatches[b].InstancesTotal;
+		}
+	}
+
+	ResetRenderQueue(FrameQueue, batchesTotal);
+	JobParallelFor(batchesTotal, 1, [&](int Begin, int End)
+	{
+		for (int b = Begin; b < End; b++)
+		{
+			const InstanceBatch& batch = InstanceBatches[b];
+			const MeshLod& lod = MeshLods[batch.Lod];
+			RenderCommandList& list = FrameQueue.Lists[b];
+			unsigned long long key = RenderSortKey(RENDER_SHADER_OBJECT, RENDER_TEXTURE_OBJECT, RENDER_MESH_OBJECT, (unsigned int)batch.Lod);
+			if (firstCulled[b] < 0)
+			{
+				RecordRenderDraw(list, key, { (unsigned int)lod.PrimitivesTotal * 3, (unsigned int)batch.InstancesTotal, (unsigned int)lod.FirstIndex, 0, (unsigned int)batch.FirstInstance });
+				continue;
+			}
+			for (int i = 0; i < batch.InstancesTotal; i++)
+				for (const MeshletRun& run : MeshletCulledRuns[firstCulled[b] + i])
+					RecordRenderDraw(list, key, { (unsigned int)run.PrimitivesTotal * 3, 1, (unsigned int)run.FirstIndex, 0, (unsigned int)(batch.FirstInstance + i) });
+		}
+	});
+}
+
+// EnqueueObjectVertices function: Definition
+//   This function writes the contents of the vertex buffer from Vertices, OurVertices or the binary mesh cache file, packed with PackingBounds if VertexPackingEnabled is true, and queues it for upload.
+void EnqueueObjectVertices(const VERTEX* Vertices, const VertexPackingBounds& PackingBounds)
+{
+	std::vector<unsigned char> meshData((size_t)VertexStride * VertexAttributeSetsTotal);	// The size of the vertex buffer is the size of the VERTEX (or PACKEDVERTEX) structure * the total number of array elements in OurVertices (VertexAttributeSetsTotal).
+	if (VertexPackingEnabled)
+		PackVertices(Vertices, VertexAttributeSetsTotal, PackingBounds, (PACKEDVERTEX*)meshData.data());	// Pack the vertex attributes from OurVertices (or the binary mesh cache file).
+	else
+		memcpy(meshData.data(), Vertices, meshData.size());	// Copy the vertex attributes from OurVertices (or the binary mesh cache file).
+	MeshUploadEnqueue(MeshUploads, MESH_BUFFER_VERTEX, meshData);
+}
+
+// EnqueueObjectIndices function: Definition
+//   This function writes the contents of the index buffer from Indices, OurIndices or the binary mesh cache file, followed by LodIndices, and queues it for upload.
+//   Three geometric vertex indices (each pointing to a vertex in the vertex buffer) describe each triangle primitive, and PrimitivesTotal is the total number of triangles comprising the object. Therefore PrimitivesTotal * 3.
+//   The indices of the levels of detail that follow level of detail 0 (see MeshLods) are copied after them.
+void EnqueueObjectIndices(const DWORD* Indices, const DWORD* LodIndices, int LodIndicesTotal)
+{
+	std::vector<unsigned char> meshData((IndexFormat == DXGI_FORMAT_R16_UINT ? sizeof(unsigned short) : sizeof(DWORD)) * ((size_t)PrimitivesTotal * 3 + LodIndicesTotal));
+	if (IndexFormat == DXGI_FORMAT_R16_UINT)
+	{
+		PackIndices(Indices, (size_t)PrimitivesTotal * 3, (unsigned short*)meshData.data());	// Pack the index information from OurIndices (or the binary mesh cache file).
+		PackIndices(LodIndices, (size_t)LodIndicesTotal, (unsigned short*)meshData.data() + (size_t)PrimitivesTotal * 3);
+	}
+	else
+	{
+		memcpy(meshData.data(), Indices, (size_t)PrimitivesTotal * 3 * sizeof(DWORD));	// Copy the index information from OurIndices (or the binary mesh cache file).
+		if (LodIndicesTotal > 0)
+			memcpy((DWORD*)meshData.data() + (size_t)PrimitivesTotal * 3, LodIndices, (size_t)LodIndicesTotal * sizeof(DWORD));
+	}
+	MeshUploadEnqueue(MeshUploads, MESH_BUFFER_INDEX, meshData);
+}
+
+// UploadMeshes function: Definition
+//   This function makes the uploads of static buffers the mesh upload manager plans for the current frame, at most MeshUploadFrameBudget bytes (see meshUpload.h). It is called once per frame, before the frame job starts.
+//   A buffer uploaded whole is created as D3D11_USAGE_IMMUTABLE, with its contents as initial data. A larger buffer is created empty, as D3D11_USAGE_DEFAULT, and the pieces of it uploaded in a frame are written to a staging buffer with one map,
+//   then copied from the staging buffer by the GPU. The FRAME_FENCES_TOTAL staging buffers are used in turn, so the CPU rarely waits for the GPU to finish copying from a staging buffer before writing it again.
+//   ObjectUploaded becomes true once the vertex buffer and index buffer are both uploaded.
+void UploadMeshes(void)
+{
+	std::vector<MeshUploadCopy> copies;
+	MeshUploadFrame(MeshUploads, copies);
+	if (copies.empty())
+		return;
+
+	// Create the buffers, and write the pieces of the staged buffers to this frame's staging buffer.
+	ID3D11Buffer* staging = NULL;							// This frame's staging buffer, once it is mapped.
+	D3D11_MAPPED_SUBRESOURCE ms;							// Provides access to subresource data. ms.pData is used to write the staging buffer.
+	for (const MeshUploadCopy& copy : copies)
+	{
+		if (copy.Create)
+		{
+			D3D11_BUFFER_DESC bd;							// Describes the buffer resource.
+			ZeroMemory(&bd, sizeof(D3D11_BUFFER_DESC));
+			bd.ByteWidth = (UINT)copy.BufferSize;			// The size of the buffer in bytes.
+			bd.Usage = copy.Method == MESH_UPLOAD_IMMUTABLE ? D3D11_USAGE_IMMUTABLE : D3D11_USAGE_DEFAULT;	// D3D11_USAGE_IMMUTABLE: A resource that can only be read by the GPU, initialized when it is created. D3D11_USAGE_DEFAULT: A resource that is read and written by the GPU, e.g., copied to from a staging buffer.
+			bd.BindFlags = copy.Buffer == MESH_BUFFER_VERTEX ? D3D11_BIND_VERTEX_BUFFER : D3D11_BIND_INDEX_BUFFER;	// Bind the buffer as a vertex buffer, or an index buffer, to the input-assembler stage of the graphics pipeline.
+			bd.CPUAccessFlags = 0;							// The CPU cannot access the buffer.
+			D3D11_SUBRESOURCE_DATA initialData;				// The contents of an immutable buffer.
+			ZeroMemory(&initialData, sizeof(D3D11_SUBRESOURCE_DATA));
+			initialData.pSysMem = copy.Data;
+
+			// ID3D11Device::CreateBuffer member function:
+			//   Create a buffer object, in this case the vertex buffer object or the index buffer object.
+			dev->CreateBuffer(&bd,							// A pointer to a buffer resource description structure that describes the buffer.
+				copy.Method == MESH_UPLOAD_IMMUTABLE ? &initialData : NULL,	// A pointer to the initialization data, which cannot be NULL if bd.Usage is D3D11_USAGE_IMMUTABLE, or NULL to allocate space only.
+				copy.Buffer == MESH_BUFFER_VERTEX ? &pVBuffer : &pIBuffer);	// The address of the pointer to the buffer interface for the buffer object created.
+		}
+		if (copy.Method == MESH_UPLOAD_STAGED)
+		{
+			if (staging == NULL)
+			{
+				ID3D11Buffer*& frameStaging = pUploadStaging[MeshUploads.Frames % FRAME_FENCES_TOTAL];
+				if (frameStaging == NULL)
+				{
+					D3D11_BUFFER_DESC bd;
+					ZeroMemory(&bd, sizeof(D3D11_BUFFER_DESC));
+					bd.ByteWidth = (UINT)MeshUploads.FrameBudget;	// A staging buffer holds every piece uploaded in a frame.
+					bd.Usage = D3D11_USAGE_STAGING;			// A resource that supports data transfer (copy) from the CPU to the GPU.
+					bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;	// The resource is to be mappable so that the CPU can write its contents.
+					dev->CreateBuffer(&bd, NULL, &frameStaging);
+				}
+				staging = frameStaging;
+
+				// D3D11_MAP_WRITE: A staging buffer cannot be discarded, so this waits if the GPU is still copying from it, i.e., FRAME_FENCES_TOTAL frames later.
+				devcon->Map(staging, 0, D3D11_MAP_WRITE, 0, &ms);
+			}
+			memcpy((unsigned char*)ms.pData + copy.StagingOffset, copy.Data, copy.Size);
+		}
+	}
+
+	// Copy the pieces of the staged buffers from the staging buffer.
+	if (staging != NULL)
+	{
+		devcon->Unmap(staging, 0);
+		for (const MeshUploadCopy& copy : copies)
+		{
+			if (copy.Method != MESH_UPLOAD_STAGED)
+				continue;
+
+			// ID3D11DeviceContext::CopySubresourceRegion member function:
+			//   Copy a region from a source resource to a destination resource, in this case from the staging buffer to the vertex buffer or index buffer. For a buffer, the region is a range of bytes.
+			D3D11_BOX box = { (UINT)copy.StagingOffset, 0, 0, (UINT)(copy.StagingOffset + copy.Size), 1, 1 };
+			devcon->CopySubresourceRegion(copy.Buffer == MESH_BUFFER_VERTEX ? pVBuffer : pIBuffer,	// A pointer to the destination resource.
+				0,											// The destination subresource.
+				(UINT)copy.Offset,							// The location, in bytes, in the destination buffer of the range copied.
+				0,											// The y-coordinate and z-coordinate of the destination region, always 0 for a buffer.
+				0,
+				staging,									// A pointer to the source resource.
+				0,											// The source subresource.
+				&box);										// The range of the source buffer copied.
+		}
+	}
+
+	// Once the vertex buffer and index buffer are both uploaded, the CPU's copy of the object is kept, dropped, or compressed.
+	if (!ObjectUploaded && !MeshUploadPending(MeshUploads))
+	{
+		ObjectUploaded = true;
+		ApplyMeshResidency();
+	}
+	UpdateMemoryAccounting();
+}
+
+// ApplyMeshResidency function: Definition
+//   This function applies MeshResidencyPolicy to the CPU's copy of the vertex attributes and indices of the object (OurVertices, OurIndices, and MeshLodIndices) once they are uploaded to the vertex buffer and index buffer.
+//   There is no copy if the binary mesh cache file was loaded: the vertex attributes and indices were read from the memory-mapped file, which has already been unmapped.
+//   The levels of detail (MeshLods) and the meshlets (Meshlets) are kept whatever the policy, as the frame job reads them each frame.
+void ApplyMeshResidency(void)
+{
+	static_assert(sizeof(VERTEX) % sizeof(unsigned int) == 0, "The VERTEX structure must be made of 32-bit words.");
+	const int vertexWords = sizeof(VERTEX) / sizeof(unsigned int);
+	switch (MeshResidencyPolicy)
+	{
+		case MESH_RESIDENCY_KEEP:
+		{
+			// Free the capacity reserved while parsing but not used, e.g., by vertex attributes merged by the objReader function.
+			OurVertices.shrink_to_fit();
+			OurIndices.shrink_to_fit();
+			MeshLodIndices.shrink_to_fit();
+		} break;
+		case MESH_RESIDENCY_COMPRESSED:
+		{
+			CompressVertexWords((const unsigned int*)OurVertices.data(), OurVertices.size() * vertexWords, vertexWords, CompressedObjectVertices);
+			CompressIndexWords((const unsigned int*)OurIndices.data(), OurIndices.size(), CompressedObjectIndices);
+			CompressIndexWords((const unsigned int*)MeshLodIndices.data(), MeshLodIndices.size(), CompressedObjectLodIndices);
+			std::vector<VERTEX>().swap(OurVertices);
+			std::vector<DWORD>().swap(OurIndices);
+			std::vector<DWORD>().swap(MeshLodIndices);
+		} break;
+		case MESH_RESIDENCY_DROP:
+		{
+			std::vector<VERTEX>().swap(OurVertices);
+			std::vector<DWORD>().swap(OurIndices);
+			std::vector<DWORD>().swap(MeshLodIndices);
+		} break;
+	}
+}
+
+// RestoreObjectMesh function: Definition
+//   This function makes OurVertices, OurIndices, and MeshLodIndices hold the vertex attributes and indices of the object again, after the ApplyMeshResidency function has applied MeshResidencyPolicy to them:
+//   the copy kept (MESH_RESIDENCY_KEEP) is used as it is, and the compressed copy (MESH_RESIDENCY_COMPRESSED) is decompressed.
+//   Otherwise, i.e., the copy was dropped (MESH_RESIDENCY_DROP) or the binary mesh cache file was loaded instead of the Wavefront .obj file, the binary mesh cache file is loaded again, and copied.
+//   It returns 0 on success, or 1 if there is no copy and the binary mesh cache file cannot be loaded, or does not hold the object uploaded, in which case OurVertices, OurIndices, and MeshLodIndices are empty.
+int RestoreObjectMesh(void)
+{
+	if (!OurVertices.empty())
+		return 0;
+
+	const int vertexWords = sizeof(VERTEX) / sizeof(unsigned int);
+	if (CompressedObjectVertices.WordsTotal == (size_t)VertexAttributeSetsTotal * vertexWords && CompressedObjectVertices.WordsTotal > 0)
+	{
+		OurVertices.resize(VertexAttributeSetsTotal);
+		OurIndices.resize(CompressedObjectIndices.WordsTotal);
+		MeshLodIndices.resize(CompressedObjectLodIndices.WordsTotal);
+		if (DecompressWords(CompressedObjectVertices, (unsigned int*)OurVertices.data()) == 0 && DecompressWords(CompressedObjectIndices, (unsigned int*)OurIndices.data()) == 0 &&
+			DecompressWords(CompressedObjectLodIndices, (unsigned int*)MeshLodIndices.data()) == 0)
+			return 0;
+	}
+
+	MeshCacheView meshCache;
+	if (MeshCacheEnabled && MeshCacheLoad(objReaderFileName, meshCache) == 0 && meshCache.VertexAttributeSetsTotal == VertexAttributeSetsTotal && meshCache.PrimitivesTotal == PrimitivesTotal)
+	{
+		OurVertices.assign(meshCache.Vertices, meshCache.Vertices + meshCache.VertexAttributeSetsTotal);
+		OurIndices.assign(meshCache.Indices, meshCache.Indices + (size_t)meshCache.PrimitivesTotal * 3);
+		MeshLodIndices.assign(meshCache.LodIndices, meshCache.LodIndices + meshCache.LodIndicesTotal);
+		MeshCacheUnload(meshCache);
+		return 0;
+	}
+	MeshCacheUnload(meshCache);
+	std::vector<VERTEX>().swap(OurVertices);
+	std::vector<DWORD>().swap(OurIndices);
+	std::vector<DWORD>().swap(MeshLodIndices);
+	return 1;
+}
+
+// ReuploadObjectMesh function: Definition
+//   This function uploads the vertex buffer and index buffer of the object again from the CPU's copy of the object (see the RestoreObjectMesh function), as the program must once the Direct3D device is created again after it is lost.
+//   The object is not drawn until both buffers are uploaded, after which the ApplyMeshResidency function applies MeshResidencyPolicy to the copy again.
+//   Nothing is done while the buffers are still being uploaded, or if there is no copy of the object to upload them from. It is called between frames, when the frame job is not running.
+void ReuploadObjectMesh(void)
+{
+	if (!ObjectUploaded || RestoreObjectMesh() == 1)
+		return;
+
+	// The GPU keeps the buffers it is still drawing with until it has finished with them.
+	if (pVBuffer != NULL)
+	{
+		pVBuffer->Release();
+		pVBuffer = NULL;
+	}
+	if (pIBuffer != NULL)
+	{
+		pIBuffer->Release();
+		pIBuffer = NULL;
+	}
+
+	VertexPackingBounds packingBounds;						// The same range of each quantized coordinate as the InitGraphics function computed from the same vertex attributes.
+	if (VertexPackingEnabled)
+		ComputeVertexPackingBounds(OurVertices.data(), VertexAttributeSetsTotal, packingBounds);
+	EnqueueObjectVertices(OurVertices.data(), packingBounds);
+	EnqueueObjectIndices(OurIndices.data(), MeshLodIndices.data(), (int)MeshLodIndices.size());
+	ObjectUploaded = false;
+	InvalidateRenderStateCache(FrameStateCache);			// The render queue binds the new buffers with its next draw.
+	UpdateMemoryAccounting();
+}
+
+// BufferBytes function: Definition
+//   This function returns the size, in bytes, of Buffer, or 0 if Buffer is NULL, i.e., has not been created.
+UINT BufferBytes(ID3D11Buffer* Buffer)
+{
+	if (Buffer == NULL)
+		return 0;
+	D3D11_BUFFER_DESC bd;
+	Buffer->GetDesc(&bd);
+	return bd.ByteWidth;
+}
+
+// UpdateMemoryAccounting function: Definition
+//   This function records the bytes this program holds in each category of memory (see memoryAccounting.h). It is called once the graphics data is initialized, and in each frame that uploads a mesh.
+//   The CPU's copies of the mesh are the vertex attributes, indices, and meshlets of the object, the buffers the mesh upload manager holds until they are uploaded, the compressed copies, and the software rasterizer's copies.
+void UpdateMemoryAccounting(void)
+{
+	size_t cpuMesh = OurVertices.capacity() * sizeof(VERTEX) + (OurIndices.capacity() + MeshLodIndices.capacity()) * sizeof(DWORD) + Meshlets.capacity() * sizeof(Meshlet)
+		+ CompressedObjectVertices.Data.capacity() + CompressedObjectIndices.Data.capacity() + CompressedObjectLodIndices.Data.capacity()
+		+ SoftwareVertices.capacity() * sizeof(VERTEX) + SoftwareIndices.capacity() * sizeof(DWORD);
+	for (const MeshUploadRequest& request : MeshUploads.Pending)
+		cpuMesh += request.Data.capacity();
+	for (const MeshUploadRequest& request : MeshUploads.Completed)
+		cpuMesh += request.Data.capacity();
+	size_t staging = 0;
+	for (ID3D11Buffer* buffer : pUploadStaging)
+		staging += BufferBytes(buffer);
+
+	SetMemoryBytes(MEMORY_CPU_MESH, cpuMesh);
+	SetMemoryBytes(MEMORY_GPU_VERTEX, (size_t)BufferBytes(pVBuffer) + BufferBytes(pInstanceBuffer));
+	SetMemoryBytes(MEMORY_GPU_INDEX, BufferBytes(pIBuffer));
+	SetMemoryBytes(MEMORY_TEXTURE, TextureBytes);
+	SetMemoryBytes(MEMORY_SHADER, VertexShaderProgram.Bytecode.capacity() + PixelShaderProgram.Bytecode.capacity());
+	SetMemoryBytes(MEMORY_CONSTANT, (size_t)BufferBytes(pConstantRing) + BufferBytes(pCBuffer) + BufferBytes(pObjectCBuffer));
+	SetMemoryBytes(MEMORY_STAGING, staging);
+}
+
+// SaveMemoryReport function: Definition
+//   This function writes the bytes held in each category of memory, and by the process, to MemoryReportFileName.
+void SaveMemoryReport(void)
+{
+	UpdateMemoryAccounting();
+	MemoryReport report;
+	GetMemoryReport(report);
+	SaveMemoryReportCsv(MemoryReportFileName, report);
+}
+
+// RetireFrames function: Definition
+//   This function frees the ranges of the upload ring used by every frame the GPU has finished, in order, by checking the frame's fence (a D3D11_QUERY_EVENT query) without waiting for it.
+//   If every fence is in use, i.e., the CPU is FRAME_FENCES_TOTAL frames ahead of the GPU, it waits for the oldest frame to finish, so that its fence can be reused.
+void RetireFrames(void)
+{
+	if (pConstantRing == NULL)
+		return;
+
+	while (FramesRetired < FramesEnded)
+	{
+		// ID3D11DeviceContext::GetData member function:
+		//   Get data from the GPU asynchronously. For a D3D11_QUERY_EVENT query, the data is TRUE once the GPU has finished the commands issued before the query was ended. The member function returns S_FALSE until then.
+		bool wait = FramesEnded - FramesRetired >= FRAME_FENCES_TOTAL;
+		BOOL finished = FALSE;
+		HRESULT result = devcon->GetData(FrameFences[FramesRetired % FRAME_FENCES_TOTAL],	// A pointer to the query interface.
+			&finished,										// Address of memory that receives the data.
+			sizeof(finished),								// Size of the data to retrieve.
+			wait ? 0 : D3D11_ASYNC_GETDATA_DONOTFLUSH);		// D3D11_ASYNC_GETDATA_DONOTFLUSH: Do not flush the command buffer to the GPU to check the query, unless the CPU must wait for it.
+		if (result == S_OK && finished)
+		{
+			UploadRingRetire(ConstantRing, FramesRetired);
+			FramesRetired++;
+		}
+		else if (!wait || FAILED(result))
+			break;											// The GPU has not finished the frame, or the device was removed.
+	}
+}
+
+// WriteConstantBuffer function: Definition
+//   This function copies Size bytes of a C++ constant buffer structure, Data, to the HLSL constant buffer in register b<Slot> of the vertex shader stage of the graphics pipeline.
+//   When the upload ring is used, the structure is written to a new range of the upload ring, mapped with D3D11_MAP_WRITE_NO_OVERWRITE (or D3D11_MAP_WRITE_DISCARD when the upload ring is full), and that range is bound to the register,
+//   so writing a constant buffer never waits for, or copies, a constant buffer the GPU is still reading. Otherwise the structure is written to Buffer, the constant buffer already bound to the register, mapped with D3D11_MAP_WRITE_DISCARD.
+void WriteConstantBuffer(UINT Slot, const void* Data, UINT Size, ID3D11Buffer* Buffer)
+{
+	D3D11_MAPPED_SUBRESOURCE ms;							// Provides access to subresource data.
+	if (pConstantRing != NULL)
+	{
+		UploadRingAllocation allocation;
+		UploadRingAllocate(ConstantRing, Size, allocation);
+		devcon->Map(pConstantRing, 0, allocation.Discard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE, 0, &ms);
+		memcpy((char*)ms.pData + allocation.Offset, Data, Size);
+		devcon->Unmap(pConstantRing, 0);
+
+		// ID3D11DeviceContext1::VSSetConstantBuffers1 member function:
+		//   Set part of a constant buffer object to the vertex shader stage of the graphics pipeline. The part is measured in constants (16 bytes each), and must start at, and be, a multiple of 16 constants.
+		UINT firstConstant = allocation.Offset / 16;
+		UINT constantsTotal = allocation.Size / 16;
+		devcon1->VSSetConstantBuffers1(Slot,				// Index into the device's zero-based array to begin setting constant buffers to.
+			1,												// Number of buffers to set.
+			&pConstantRing,									// &pConstantRing is the address of a pointer, pConstantRing, to the constant buffer interface.
+			&firstConstant,									// The offset, in constants, of the part of the buffer bound.
+			&constantsTotal);								// The size, in constants, of the part of the buffer bound.
+	}
+	else
+	{
+		devcon->Map(Buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &ms);
+		memcpy(ms.pData, Data, Size);
+		devcon->Unmap(Buffer, 0);
+	}
+}
+
+// GpuProfileTimestamp function: Definition
+//   This function measures the GPU times of each frame when FrameProfilerEnabled and FrameProfilerGpuEnabled are true, with timestamp queries that the GPU writes when it reaches them in the command stream.
+//   It is called at three points of each frame: Point 0 at the start of the frame, Point 1 before the draws, and Point 2 at the end of the frame.
+//   At the start of each frame, the queries of earlier frames that the GPU has finished are read, without waiting, and their times are recorded as PROFILE_STAGE_GPU_FRAME and PROFILE_STAGE_GPU_DRAW samples.
+//   The queries of a frame that are still not finished when they are needed again, GPU_PROFILE_FRAMES_TOTAL frames later, are discarded.
+void GpuProfileTimestamp(int Point)
+{
+#if FRAME_PROFILER_ENABLED
+	if (!FrameProfilerEnabled || !FrameProfilerGpuEnabled)
+		return;
+
+	GpuProfileFrame& frame = GpuProfileFrames[GpuProfileFramesIssued % GPU_PROFILE_FRAMES_TOTAL];
+	if (Point == 0)
+	{
+		// Read the queries of the earlier frames the GPU has finished.
+		for (GpuProfileFrame& pending : GpuProfileFrames)
+		{
+			// ID3D11DeviceContext::GetData member function:
+			//   Get data from the GPU asynchronously. It returns S_FALSE until the GPU has reached the query.
+			D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjoint;	// The frequency of the timestamps, in ticks per second, and whether the frequency changed during the frame.
+			UINT64 timestamps[3];
+			if (!pending.Pending || devcon->GetData(pending.Disjoint, &disjoint, sizeof(disjoint), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+				continue;
+			bool valid = !disjoint.Disjoint;
+			for (int i = 0; i < 3; i++)
+				valid = valid && devcon->GetData(pending.Timestamps[i], &timestamps[i], sizeof(UINT64), D3D11_ASYNC_GETDATA_DONOTFLUSH) == S_OK;
+			if (valid)
+			{
+				ProfilerRecord(PROFILE_STAGE_GPU_FRAME, pending.Frame, (long long)((timestamps[2] - timestamps[0]) * 1e9 / disjoint.Frequency));
+				ProfilerRecord(PROFILE_STAGE_GPU_DRAW, pending.Frame, (long long)((timestamps[2] - timestamps[1]) * 1e9 / disjoint.Frequency));
+			}
+			pending.Pending = false;
+		}
+
+		// Create the queries of this frame's set the first time it is used.
+		if (frame.Disjoint == NULL)
+		{
+			D3D11_QUERY_DESC qd;							// Describes the query.
+			ZeroMemory(&qd, sizeof(qd));					// ZeroMemory macro: Fills a block of memory with zeros.
+			qd.Query = D3D11_QUERY_TIMESTAMP_DISJOINT;
+			dev->CreateQuery(&qd, &frame.Disjoint);
+			qd.Query = D3D11_QUERY_TIMESTAMP;
+			for (int i = 0; i < 3; i++)
+				dev->CreateQuery(&qd, &frame.Timestamps[i]);
+		}
+
+		// ID3D11DeviceContext::Begin member function:
+		//   Mark the beginning of a series of commands, in this case the frame measured by the timestamps.
+		frame.Pending = false;								// Discard the queries if they were not finished.
+		frame.Frame = ProfilerFrame();
+		devcon->Begin(frame.Disjoint);
+	}
+
+	// ID3D11DeviceContext::End member function:
+	//   For a D3D11_QUERY_TIMESTAMP query, write the GPU's timestamp when the GPU reaches this point of the command stream.
+	devcon->End(frame.Timestamps[Point]);
+
+	if (Point == 2)
+	{
+		devcon->End(frame.Disjoint);
+		frame.Pending = true;
+		GpuProfileFramesIssued++;
+	}
+#else
+	(void)Point;
+#endif
+}
+
+// SaveFrameProfile function: Definition
+//   This function writes the frame profiler's statistics to FrameProfilerFileName followed by ".csv", and followed by ".json".
+void SaveFrameProfile(void)
+{
+	SaveProfileCsv((std::string(FrameProfilerFileName) + ".csv").c_str());
+	SaveProfileJson((std::string(FrameProfilerFileName) + ".json").c_str());
+}
+
+// UpdateSimulation function: Definition
+//   This function advances the animation by one fixed timestep of StepSeconds seconds: the instances of the object rotate by ANIMATION_RADIANS_PER_SECOND, the second instance counterclockwise and every other instance clockwise.
+//   The animation advances by the same amount per second at any frame rate.
+void UpdateSimulation(float StepSeconds)
+{
+	SimulationPrevious = SimulationCurrent;
+	SimulationCurrent.Angle += ANIMATION_RADIANS_PER_SECOND * StepSeconds;
+	SimulationCurrent.Angle2 -= ANIMATION_RADIANS_PER_SECOND * StepSeconds;
+}
+
 // RenderFrame function: Definition
-//   This function renders a single frame.
-//     1. Define the final transformation matrix, matFinal, which contains all the information necessary to transform each vertex of the object being rendered.
+//   This function renders a single frame, with the animation Alpha (from 0 to 1) of the way from its state before the last timestep (SimulationPrevious) to its state after it (SimulationCurrent).
+//     1. Define the transformation matrices, which contain all the information necessary to transform each vertex of the object being rendered, and start the frame job, which fills the instance buffer.
 //
 //     2. Assign values that determine the attributes of light.
 //
 //     3. Clear the render target, in this case one back buffer texture interface, and the depth-stencil view interface, which effectively is the depth buffer (z-buffer).
 //
-//     4. Specify the vertex buffers, the index buffer, and the primitive type used when drawing.
+//     4. Define the Direct3D backend, which binds the vertex buffers, the index buffer, the primitive type, the shaders, and the texture used when drawing, and draws.
+//
+//     5. Wait for the frame job, and render the objects: sort the draws it recorded in the render queue, and execute them with the Direct3D backend.
 //
-//     5. Render the objects.
-void RenderFrame(void)
+//   The CPU work of the frame that does not use Direct3D, i.e., animating the instances of the object, culling them, selecting their levels of detail, transforming them into the instance buffer, and culling their meshlets,
+//   is one job (the frame job) run by the job system, which divides each of these stages into jobs of its own. It is run while this function performs steps 2 to 4, and waited for in step 5.
+//   Direct3D is used only by this function, on the main thread, as the immediate device context is not thread-safe.
+void RenderFrame(float Alpha)
 {
+	PROFILE_FRAME();
+	PROFILE_BEGIN(PROFILE_STAGE_FRAME);
+	GpuProfileTimestamp(0);
+
 	//***
-	// 1. Define the final transformation matrix, matFinal, which contains all the information necessary to transform each geometric vertex of the object being rendered.
+	// 1. Define the transformation matrices, which contain all the information necessary to transform each geometric vertex of the object being rendered, and start the frame job, which fills the instance buffer.
 	//    The final matrix, matFinal = matWorld x matView x matProjection
 	//
 	//   i.	Define the world matrix, matWorld.
@@ -925,22 +2093,24 @@ void RenderFrame(void)
 	//  iv.	Define the final transformation matrix, matFinal.
 	//		matFinal = matWorld x matView x matProjection
 	//		Each geometric vertex is multiplied by the final transformation matrix.
-	//		The final transformation matrix is one member of the C++ constant buffer structure that matches the HLSL constant buffer structure. The C++ constant buffer structure will be copied to the HLSL constant buffer structure (they are, but do not have to be, named the same).
+	//		Every instance of the object is drawn with the same matView x matProjection, matViewProjection, which is one member of the C++ constant buffer structure that matches the HLSL constant buffer structure. The C++ constant buffer structure will be copied to the HLSL constant buffer structure (they are, but do not have to be, named the same).
+	//		The world matrix of each instance is written to the instance buffer, and the vertex shader multiplies each geometric vertex by it before matViewProjection.
 	//		Using the HLSL constant buffer is efficient, as multiplication and other common operations can be performed on its members by the GPU's vertex shader.
 	//***
 
 	// Declare transformation matrices that are not members of the C++ constant buffer structure.
-	XMMATRIX matRotateY, matWorld, matView, matProjection;
-
-	// Define the world matrix, matWorld.
-	//   This matrix is updated each frame, causing the object to rotate.
-	// XMMatrixRotationY function:
-	//   Builds a matrix that rotates around the y-axis.
-	static float Angle = 0.0f;								// "Angle" must be declared static so that its value is preserved though multiple calls to the function that declares it. This supports incremental frame by frame changes to the rendered object.
-	Angle += 0.001f;										// This is the incremental frame by frame change to the rendered object.
-	matRotateY = XMMatrixRotationY(Angle);					// "Angle" is the angle of rotation around the y-axis, in radians. Angles are measured clockwise when looking along the rotation axis toward the origin.
-	ConstantBuffer.matRotate = matRotateY;					// The final rotation matrix is the product of all defined rotation matrices.				Here, only matRotateY is defined.
-	matWorld = ConstantBuffer.matRotate;					// The world transformation is a function of translation (movement), rotation, and scaling. Here, only rotation   is defined.
+	XMMATRIX matView, matProjection;
+
+	// Define the rotation of each instance of the object.
+	//   The rotations are updated each frame (by the AnimateObjectInstances function, run by the frame job), causing the instances to rotate. The second instance rotates counterclockwise, and every other instance rotates clockwise.
+	//   The angles are interpolated between the last two states of the animation, which is advanced in fixed timesteps by the UpdateSimulation function.
+	// XMQuaternionRotationRollPitchYaw function:
+	//   Builds a rotation quaternion from the angles of rotation around the x-axis (pitch), y-axis (yaw), and z-axis (roll).
+	float Angle = SimulationPrevious.Angle + (SimulationCurrent.Angle - SimulationPrevious.Angle) * Alpha;
+	float Angle2 = SimulationPrevious.Angle2 + (SimulationCurrent.Angle2 - SimulationPrevious.Angle2) * Alpha;
+	XMFLOAT4 Rotation, Rotation2;
+	XMStoreFloat4(&Rotation, XMQuaternionRotationRollPitchYaw(0.0f, Angle, 0.0f));		// "Angle" is the angle of rotation around the y-axis, in radians. Angles are measured clockwise when looking along the rotation axis toward the origin.
+	XMStoreFloat4(&Rotation2, XMQuaternionRotationRollPitchYaw(0.0f, Angle2, 0.0f));
 
 	// Define the view matrix, matView.
 	// XMMatrixLookAtLH function:
@@ -973,31 +2143,59 @@ void RenderFrame(void)
 		NearZ,												// Distance to the near clipping plane. Must be greater than zero.
 		FarZ);												// Distance to the far clipping plane. Must be greater than zero.
 
-	// Define the final transformation matrix, matFinal.
-	ConstantBuffer.matFinal = matWorld * matView * matProjection;
+	// Define the combined view and projection matrix, matViewProjection. The world matrix of each instance is applied by the vertex shader, from the instance buffer.
+	FrameConstants.matViewProjection = matView * matProjection;
 
-	// End: 1. Define the final transformation matrix, matFinal, which contains all the information necessary to transform each geometric vertex of the object being rendered.
+	// Start the frame job. It rotates the instances of the object, culls the instances outside the viewing frustum, selects the level of detail of the others from their distance to the camera,
+	// writes their INSTANCEDATA structures to the instance buffer, grouped by level of detail (InstanceBatches), and culls the meshlets of the instances drawn one at a time.
+	// The instance buffer remains mapped, and the data used by the frame job must not be changed, until the frame job is finished (see step 5).
+	float ProjectionScale = (SCREEN_HEIGHT / 2.0f) / tanf(FovAngleY / 2.0f);	// The number of pixels covered by one unit of world space at a distance of one unit.
+	D3D11_MAPPED_SUBRESOURCE ms;							// Provides access to subresource data. ms.pData is used to write the instance buffer.
+	devcon->Map(pInstanceBuffer,							// A pointer to the instance buffer interface.
+		NULL,												// Index number of the subresource.
+		D3D11_MAP_WRITE_DISCARD,							// The previous contents of the instance buffer are undefined, so the GPU may still be reading them while this frame's are written.
+		NULL,												// Flag that specifies how the CPU should respond when the resource is being used by the GPU.
+		&ms);												// A pointer to the mapped subresource D3D11_MAPPED_SUBRESOURCE structure for the mapped subresource.
+	// When SoftwareRasterizerEnabled is true, the INSTANCEDATA structures are written to SoftwareInstances and then copied to the instance buffer, which the CPU must not read.
+	XMMATRIX matViewProjection = FrameConstants.matViewProjection;
+	UploadMeshes();											// Upload this frame's part of the vertex buffer and index buffer, if they are not yet uploaded, before the frame job decides whether to draw the object.
+	Job* frameJob = JobCreate([&]
+	{
+		PROFILE_BEGIN(PROFILE_STAGE_TRANSFORM);
+		AnimateObjectInstances(Rotation, Rotation2);
+		INSTANCEDATA* instances = SoftwareRasterizerEnabled ? SoftwareInstances.data() : (INSTANCEDATA*)ms.pData;
+		InstancesDrawn = BuildInstanceBatches(ObjectInstances, matViewProjection, EyePosition, ProjectionScale,
+			ObjectBoundsCenter, ObjectBoundsRadius, MeshLods.data(), (int)MeshLods.size(), instances, InstanceOrder, InstanceBatches);
+		if (SoftwareRasterizerEnabled)
+			memcpy(ms.pData, instances, sizeof(INSTANCEDATA) * InstancesDrawn);
+		CullInstanceMeshlets(matViewProjection, EyePosition);
+		RecordInstanceDraws();
+		PROFILE_END(PROFILE_STAGE_TRANSFORM);
+	}, nullptr);
+	JobRun(frameJob);
+
+	// End: 1. Define the transformation matrices, which contain all the information necessary to transform each geometric vertex of the object being rendered, and fill the instance buffer.
 
 	//***
 	// 2. Assign values that determine the attributes of light.
 	//***
 
-	ConstantBuffer.LightVector = XMFLOAT4(1.0f, 1.0f, 1.0f, 0.0f);
-	ConstantBuffer.LightColor = XMFLOAT4(0.5f, 0.5f, 0.5f, 1.0f);
-	ConstantBuffer.AmbientColor = XMFLOAT4(0.2f, 0.2f, 0.2f, 1.0f);
+	FrameConstants.LightVector = XMFLOAT4(1.0f, 1.0f, 1.0f, 0.0f);
+	FrameConstants.LightColor = XMFLOAT4(0.5f, 0.5f, 0.5f, 1.0f);
+	FrameConstants.AmbientColor = XMFLOAT4(0.2f, 0.2f, 0.2f, 1.0f);
 
 	// Sample alternative values and their effect.
-	//ConstantBuffer.LightVector = XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f); // Dark
-	//ConstantBuffer.LightVector = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f); // Medium
-	//ConstantBuffer.LightVector = XMFLOAT4(2.0f, 2.0f, 2.0f, 2.0f); // Medium
+	//FrameConstants.LightVector = XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f); // Dark
+	//FrameConstants.LightVector = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f); // Medium
+	//FrameConstants.LightVector = XMFLOAT4(2.0f, 2.0f, 2.0f, 2.0f); // Medium
 	//
-	//ConstantBuffer.LightColor = XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f); // Dark
-	//ConstantBuffer.LightColor = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f); // Medium
-	//ConstantBuffer.LightColor = XMFLOAT4(2.0f, 2.0f, 2.0f, 2.0f); // Light
+	//FrameConstants.LightColor = XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f); // Dark
+	//FrameConstants.LightColor = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f); // Medium
+	//FrameConstants.LightColor = XMFLOAT4(2.0f, 2.0f, 2.0f, 2.0f); // Light
 	//
-	//ConstantBuffer.AmbientColor = XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f); // Dark
-	//ConstantBuffer.AmbientColor = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f); // Medium
-	//ConstantBuffer.AmbientColor = XMFLOAT4(2.0f, 2.0f, 2.0f, 2.0f); // Light
+	//FrameConstants.AmbientColor = XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f); // Dark
+	//FrameConstants.AmbientColor = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f); // Medium
+	//FrameConstants.AmbientColor = XMFLOAT4(2.0f, 2.0f, 2.0f, 2.0f); // Light
 
 	// End: 2. Assign values that determine the attributes of light.
 
@@ -1011,6 +2209,7 @@ void RenderFrame(void)
 	//***
 
 	// Clear the render target, in this case one back buffer texture interface, to a color that fills the window into which the object is rendered.
+	PROFILE_BEGIN(PROFILE_STAGE_CLEAR);
 	float color[4] = { 0.0f, 0.2f, 0.4f, 1.0f };			// A 4-component array that represents the color using RGBA color values. RGBA color values are an extension of RGB color values, with an A (alpha channel) value added that specifies the opacity of a color. The alpha channel value is a number between 0.0 (fully transparent) and 1.0 (fully opaque). RGBA color values are specified as (red, green, blue, alpha).
 	// ID3D11DeviceContext::ClearRenderTargetView member function:
 	//   Set all the elements in a render target to one value.
@@ -1024,111 +2223,169 @@ void RenderFrame(void)
 		D3D11_CLEAR_DEPTH,									// Flag that identifies the type of data to clear. A value of the D3D11_CLEAR_FLAG enumerated type, i.e., D3D11_CLEAR_DEPTH: Clear the depth buffer (z-buffer), using fast clear if possible, then place the resource in a compressed state.
 		1.0f,												// Clear the depth buffer (z-buffer) with this value. This value will be clamped between 0 and 1.
 		0);													// Clear the stencil buffer with this value.
+	PROFILE_END(PROFILE_STAGE_CLEAR);
 
 	// End: 3. Clear the render target, in this case one back buffer texture interface, and the depth-stencil view interface, which effectively is the depth buffer (z-buffer).
 
 	//***
-	// 4. Specify the vertex buffers, the index buffer, and the primitive type used when drawing.
+	// 4. Define the Direct3D backend, which binds the vertex buffers, the index buffer, the primitive type, the shaders, and the texture used when drawing, and draws.
 	//    Specify the vertex buffers to draw.
-	//      This program uses only one vertex buffer.
+	//      This program uses two vertex buffers: the vertex buffer, and the instance buffer.
 	//    Specify the index buffer to use when drawing.
 	//    Specify the primitive type we are using, i.e., the triangle primitive.
 	//      Point, line, triangle and many other primitive types can be specified.
 	//***
 
-	// Specify the vertex buffers to draw.
-	//   This program uses only one vertex buffer.
-	UINT stride = sizeof(VERTEX);							// A "stride" is the size (in bytes) of the elements that are to be used from a vertex buffer.								  Define an array of strides when multiple vertex buffers are used.
-	UINT offset = 0;										// An "offset" is the number of bytes between the first element of the vertex buffer and the first element that will be used. Define an array of offsets when multiple vertex buffers are used.
-	// ID3D11DeviceContext::IASetVertexBuffers member function:
-	//   Set the array of (in this case an array of one) vertex buffers to the input-assembler stage of the graphics pipeline.
-	devcon->IASetVertexBuffers(0,							// The first input slot for binding. The first vertex buffer is explicitly bound to the start slot; this causes each additional vertex buffer in the array to be implicitly bound to each subsequent input slot.
-		1,													// The number of vertex buffers in the array.
-		&pVBuffer,											// &pVBuffer is the address of a pointer, pVBuffer, to an array of (in this case an array of one) vertex buffer interfaces.
-		&stride,											// &stride is the address of stride, and therefore a pointer to the array of (in this case an array of one) stride values (one stride value for each buffer in the vertex buffer array).
-		&offset);											// &offset is the address of offset, and therefore a pointer to the array of (in this case an array of one) offset values (one offset value for each buffer in the vertex buffer array).
+	// The render queue is executed by the Direct3D backend: functions that bind the shaders, the texture, and the buffers identified in each draw's sort key, and draw.
+	// Each state is bound only when it differs from the state bound by the previous draw, or by the previous frame (see FrameStateCache), so in this program each is bound only by the first frame.
+	// When SoftwareRasterizerEnabled is true, the parameters of each DrawIndexedInstanced call are also recorded in softwareDraws.
+	std::vector<SoftwareDraw> softwareDraws;
+	RenderBackend backend;
+	backend.SetShader = [](int Shader)
+	{
+		// RENDER_SHADER_OBJECT: the vertex shader, the pixel shader, and the input layout created by the InitPipeline function.
+		devcon->VSSetShader(pVS, 0, 0);
+		devcon->PSSetShader(pPS, 0, 0);
+		devcon->IASetInputLayout(pLayout);
+	};
+	backend.SetTexture = [](int Texture)
+	{
+		// RENDER_TEXTURE_OBJECT: the texture image created by the InitGraphics function.
+		devcon->PSSetShaderResources(0, 1, &pTextureView);
+	};
+	backend.SetMesh = [](int Mesh)
+	{
+		// RENDER_MESH_OBJECT: Specify the vertex buffers to draw.
+		//   This program uses two vertex buffers: the vertex buffer in input slot 0, and the instance buffer in input slot 1.
+		ID3D11Buffer* buffers[2] = { pVBuffer, pInstanceBuffer };
+		UINT strides[2] = { VertexStride, sizeof(INSTANCEDATA) };	// A "stride" is the size (in bytes) of the elements that are to be used from a vertex buffer.
+		UINT offsets[2] = { 0, 0 };								// An "offset" is the number of bytes between the first element of the vertex buffer and the first element that will be used.
+		// ID3D11DeviceContext::IASetVertexBuffers member function:
+		//   Set the array of (in this case an array of two) vertex buffers to the input-assembler stage of the graphics pipeline.
+		devcon->IASetVertexBuffers(0,							// The first input slot for binding. The first vertex buffer is explicitly bound to the start slot; this causes each additional vertex buffer in the array to be implicitly bound to each subsequent input slot.
+			2,													// The number of vertex buffers in the array.
+			buffers,											// A pointer to an array of vertex buffer interfaces.
+			strides,											// A pointer to the array of stride values (one stride value for each buffer in the vertex buffer array).
+			offsets);											// A pointer to the array of offset values (one offset value for each buffer in the vertex buffer array).
 	
-	// Specify the index buffer to use when drawing.
-	// ID3D11DeviceContext::IASetIndexBuffer member function:
-	//   Set the index buffer to the input-assembler stage of the graphics pipeline.
-	devcon->IASetIndexBuffer(pIBuffer,						// A pointer to the index buffer interface.
-		DXGI_FORMAT_R32_UINT,								// A value of the DXGI_FORMAT enumerated type, i.e., DXGI_FORMAT_R32_UINT: A single-component, 32-bit unsigned-integer format that supports 32 bits for the red channel.
-		0);													// The offset (in bytes) from the start of the index buffer to the first index to use.
-
-	// Specify the primitive type we are using, i.e., the triangle primitive.
-	// ID3D11DeviceContext::IASetPrimitiveTopology member function:
-	//   Set information about the primitive type, and data order that describes input data for the input-assembler stage of the graphics pipeline.
-	devcon->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST); // A value of the  D3D11_PRIMITIVE_TOPOLOGY enumerated type, i.e., D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST: Interpret the vertex data as a list of triangles.
+		// Specify the index buffer to use when drawing.
+		// ID3D11DeviceContext::IASetIndexBuffer member function:
+		//   Set the index buffer to the input-assembler stage of the graphics pipeline.
+		devcon->IASetIndexBuffer(pIBuffer,						// A pointer to the index buffer interface.
+			IndexFormat,										// A value of the DXGI_FORMAT enumerated type, i.e., DXGI_FORMAT_R16_UINT (a single-component, 16-bit unsigned-integer format) when every index fits in 16 bits, otherwise DXGI_FORMAT_R32_UINT: A single-component, 32-bit unsigned-integer format that supports 32 bits for the red channel.
+			0);													// The offset (in bytes) from the start of the index buffer to the first index to use.
+
+		// Specify the primitive type we are using, i.e., the triangle primitive.
+		// ID3D11DeviceContext::IASetPrimitiveTopology member function:
+		//   Set information about the primitive type, and data order that describes input data for the input-assembler stage of the graphics pipeline.
+		devcon->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST); // A value of the  D3D11_PRIMITIVE_TOPOLOGY enumerated type, i.e., D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST: Interpret the vertex data as a list of triangles.
+	};
+	backend.Draw = [&softwareDraws](const RenderDraw& Draw)
+	{
+		// ID3D11DeviceContext::DrawIndexedInstanced member function:
+		//   Draw indexed, instanced primitives.
+		devcon->DrawIndexedInstanced(Draw.IndexCount,		// Number of indices to draw per instance. Three geometric vertex indices (each pointing to a vertex in the vertex buffer) describe each triangle primitive.
+			Draw.InstanceCount,								// Number of instances to draw.
+			Draw.FirstIndex,								// The location of the first index read by the GPU from the index buffer.
+			Draw.BaseVertex,								// A value added to each index before reading a vertex from the vertex buffer.
+			Draw.FirstInstance);							// The location of the first INSTANCEDATA structure drawn in the instance buffer.
+		if (SoftwareRasterizerEnabled)
+			softwareDraws.push_back({ (int)Draw.IndexCount, (int)Draw.FirstIndex, (int)Draw.InstanceCount, (int)Draw.FirstInstance });
+	};
 
-	// End: 4. Specify the vertex buffers, the index buffer, and the primitive type used when drawing..
+	// End: 4. Define the Direct3D backend, which binds the vertex buffers, the index buffer, the primitive type, the shaders, and the texture used when drawing, and draws.
 
 	//***
-	// 5. Render the objects.
-	//   i.	Copy the C++ constant buffer structure to the HLSL constant buffer structure used by the GPU's vertex shader.
+	// 5. Wait for the frame job, and render the objects.
+	//   i.	Copy the C++ constant buffer structures to the HLSL constant buffer structures used by the GPU's vertex shader.
 	//  ii. Draw the object's primitives to the back buffer.
 	// iii. Switch the back buffer and the front buffer to present the rendered image to the user.
 	//
-	//    Each UpdateSubresource() and DrawIndexed() pair draws one instance of the object.
-	//    A second instance of the same object is also drawn to the scene, offset from the first object.
+	//    The per-frame constant buffer is copied once per frame, and the per-object constant buffer once per object. Both are the same for every instance of the object. The world matrix of each instance is read from the instance buffer.
+	//    Every instance with the same level of detail (see InstanceBatches) is drawn by one DrawIndexedInstanced() call.
+	//    When a level of detail has only a few instances (at most INSTANCE_MESHLET_CULLING_MAXIMUM), their meshlets are culled instead, one instance at a time,
+	//    and one DrawIndexedInstanced() call draws one instance per range of consecutive meshlets that were not culled (see MeshletCulledRuns).
+	//    The draws are recorded in the render queue by the frame job, and sorted by their state, so each state is bound only when it changes (see FrameStateCache).
 	//***
 
-	// Draw the first instance of the object to the scene.
-	//
-	// Prepare to draw the first instance of the object using the updated constant buffer.
-	// ID3D11DeviceContext::UpdateSubresource member function:
-	//   The CPU copies data from memory		   to a subresource created in non-mappable memory.
-	//   Specifically:
-	//   The CPU copies the C++ constant buffer	   to the HLSL constant buffer used by the GPU's vertex shader.
-	devcon->UpdateSubresource(pCBuffer,						// A pointer to the destination resource, in this case the constant buffer interface.
-		0,													// A zero-based index that identifies the destination subresource.
-		0,													// A pointer to a box that defines the portion of the destination subresource to copy the resource data into. For a constant buffer, set this parameter to NULL, as it is not possible to use this member function to partially update a constant buffer.
-		&ConstantBuffer,									// &ConstantBuffer is the address of ConstantBuffer, and therefore a pointer to the source data in memory, in this case the C++ constant buffer structure.
-		0,													// The size of one row of the source data.
-		0);													// The size of one depth slice of source data.
-	//
-	// Draw the first instance of the object using the updated constant buffer.
-	// ID3D11DeviceContext::DrawIndexed member function:
-	//   Draw indexed, non-instanced primitives.
-	devcon->DrawIndexed(PrimitivesTotal * 3,				// Number of indices to draw. Three geometric vertex indices (each pointing to a vertex in the vertex buffer) describe each triangle primitive, and PrimitivesTotal is the total number of triangles comprising the object. Therefore PrimitivesTotal * 3.
-		0,													// The location of the first index read by the GPU from the index buffer.
-		0);													// A value added to each index before reading a vertex from the vertex buffer.
-	
-	// Draw a second instance of the same object to the scene, using different world coordinates that offset it from the first instance of the object.
-	//
-	// *** This code that draws a second instance of the same object is written in a somewhat self-contained "one-off" style, compared to other code in this program, and for this reason can be improved.
-	// *** For example, matTranslateY and Angle2 are declared and defined here, rather than at the start of this function like most other variables.
-	//
-	// Update the final transformation matrix, matFinal, using different world coordinates that offset the second instance of the object from the first instance of the object.
-	// XMMatrixTranslation function:
-	//   Builds a translation matrix from the specified offsets.
-	// Translate the second instance of the object in a positive direction along the y-axis.
-	XMMATRIX matTranslateY = XMMatrixTranslation(0.0f, 3.0f, 0.0f);
-	// Rotate the second instance of the object counterclockwise.
-	static float Angle2 = 0.0f; Angle2 -= 0.001f;			// Angle2 must be declared static so that its value is preserved though multiple calls of the function that contains it. This supports incremental frame by frame changes to the rendered object.
-	matRotateY = XMMatrixRotationY(Angle2);					// Angle of rotation around the y-axis, in radians. Angles are measured clockwise when looking along the rotation axis toward the origin.
-	ConstantBuffer.matRotate = matRotateY;					// The final rotation matrix is the product of all defined rotation matrices.				Here, only matRotateY is defined.
-	matWorld = matTranslateY * ConstantBuffer.matRotate;	// The world transformation is a function of translation (movement), rotation, and scaling. Here, only translation and rotation are used.
-	// Update the final transformation matrix, matFinal, by multiplying the new world matrix by the original view and projection matrices.
-	ConstantBuffer.matFinal = matWorld * matView * matProjection;
-	//
-	// Prepare to draw the second instance of the object using the updated constant buffer.
-	devcon->UpdateSubresource(pCBuffer,						// A pointer to the destination resource, in this case the constant buffer interface.
-		0,													// A zero-based index that identifies the destination subresource.
-		0,													// A pointer to a box that defines the portion of the destination subresource to copy the resource data into. For a constant buffer, set this parameter to NULL, as it is not possible to use this member function to partially update a constant buffer.
-		&ConstantBuffer,									// &ConstantBuffer is the address of ConstantBuffer, and therefore a pointer to the source data in memory, in this case the C++ constant buffer structure.
-		0,													// The size of one row of the source data.
-		0);													// The size of one depth slice of source data.
-	//
-	// Draw the second instance of the object using the updated constant buffer.
-	devcon->DrawIndexed(PrimitivesTotal * 3,				// Number of indices to draw. Three geometric vertex indices (each pointing to a vertex in the vertex buffer) describe each triangle primitive, and PrimitivesTotal is the total number of triangles comprising the object. Therefore PrimitivesTotal * 3.
-		0,													// The location of the first index read by the GPU from the index buffer.
-		0);													// A value added to each index before reading a vertex from the vertex buffer.
+	// Wait for the frame job, running its jobs on this thread too, then unmap the instance buffer it filled.
+	PROFILE_BEGIN(PROFILE_STAGE_WAIT);
+	JobWait(frameJob);
+	PROFILE_END(PROFILE_STAGE_WAIT);
+	devcon->Unmap(pInstanceBuffer,							// A pointer to the instance buffer interface.
+		NULL);												// A subresource to be unmapped.
+
+	// MeshletCulling counts the meshlets culled in this frame.
+	MeshletCulling = MeshletCullStatistics();
+	for (const MeshletCullStatistics& statistics : MeshletCulledStatistics)
+	{
+		MeshletCulling.MeshletsTested += statistics.MeshletsTested;
+		MeshletCulling.MeshletsOutsideFrustum += statistics.MeshletsOutsideFrustum;
+		MeshletCulling.MeshletsFacingAway += statistics.MeshletsFacingAway;
+		MeshletCulling.PrimitivesTested += statistics.PrimitivesTested;
+		MeshletCulling.PrimitivesDrawn += statistics.PrimitivesDrawn;
+		MeshletCulling.Runs += statistics.Runs;
+	}
+
+	// Free the ranges of the upload ring used by the frames the GPU has finished, then write the per-frame constant buffer, and the per-object constant buffer of the object, before drawing the instances of the object.
+	PROFILE_BEGIN(PROFILE_STAGE_CONSTANTS);
+	RetireFrames();
+	WriteConstantBuffer(0, &FrameConstants, sizeof(FrameConstants), pCBuffer);
+	WriteConstantBuffer(1, &ObjectConstants, sizeof(ObjectConstants), pObjectCBuffer);
+	PROFILE_END(PROFILE_STAGE_CONSTANTS);
+
+	// Sort the draws recorded by the frame job (see the RecordInstanceDraws function) by their sort keys, then draw them in order with the Direct3D backend.
+	PROFILE_BEGIN(PROFILE_STAGE_SORT);
+	SortRenderQueue(FrameQueue);
+	PROFILE_END(PROFILE_STAGE_SORT);
+	PROFILE_BEGIN(PROFILE_STAGE_DRAW);
+	GpuProfileTimestamp(1);
+	ExecuteRenderQueue(FrameQueue, FrameStateCache, backend, FrameQueueStatistics);
+	PROFILE_END(PROFILE_STAGE_DRAW);
+
+	// Render the same frame with the software rasterizer: the same draws, from the copies of the vertex buffer, index buffer, and instance buffer, with the same constant buffer.
+	// The first frame it renders is written to SoftwareRasterizerFileName, so it can be compared with the frame presented by Direct3D.
+	if (SoftwareRasterizerEnabled)
+	{
+		PROFILE_BEGIN(PROFILE_STAGE_SOFTWARE);
+		SoftwareShaderConstants constants;
+		XMStoreFloat4x4(&constants.matViewProjection, FrameConstants.matViewProjection);
+		constants.LightVector = FrameConstants.LightVector;
+		constants.LightColor = FrameConstants.LightColor;
+		constants.AmbientColor = FrameConstants.AmbientColor;
+		ClearSoftwareRenderTarget(SoftwareTarget, color, 1.0f);
+		DrawSoftware(SoftwareTarget, SoftwareVertices.data(), SoftwareIndices.data(), SoftwareInstances.data(), softwareDraws.data(), (int)softwareDraws.size(), constants, SoftwareTexture);
+		if (!SoftwareFrameSaved)
+		{
+			Image frame;
+			ResolveSoftwareRenderTarget(SoftwareTarget, frame);
+			SaveBmpFile(SoftwareRasterizerFileName, frame);
+			SoftwareFrameSaved = true;
+		}
+		PROFILE_END(PROFILE_STAGE_SOFTWARE);
+	}
+
+	// End the GPU timing of the frame.
+	GpuProfileTimestamp(2);
+
+	// End the frame's fence, so that its ranges of the upload ring are freed once the GPU has finished the frame (see the RetireFrames function).
+	// ID3D11DeviceContext::End member function:
+	//   Mark the end of a series of commands, in this case every command of the frame.
+	if (pConstantRing != NULL)
+	{
+		devcon->End(FrameFences[FramesEnded % FRAME_FENCES_TOTAL]);
+		UploadRingEndFrame(ConstantRing, FramesEnded);
+		FramesEnded++;
+	}
 
 	// Switch the back buffer and the front buffer.
 	// IDXGISwapChain::Present member function:
 	//   Present the rendered image to the user.
-	swapchain->Present(0,									// An integer that specifies how to synchronize presentation of a frame with the vertical blank. '0' indicates the presentation occurs immediately,i.e., there is no synchronization.
+	PROFILE_BEGIN(PROFILE_STAGE_PRESENT);
+	swapchain->Present(PresentSyncInterval,				// An integer that specifies how to synchronize presentation of a frame with the vertical blank. '0' indicates the presentation occurs immediately,i.e., there is no synchronization. '1' waits for the next vertical blank.
 		0);													// An integer value that contains swap-chain presentation options. These options are defined by the DXGI_PRESENT constants.
+	PROFILE_END(PROFILE_STAGE_PRESENT);
+	PROFILE_END(PROFILE_STAGE_FRAME);
 	
 	// End: 5. Render the object.
 }
@@ -1167,9 +2424,34 @@ void CleanD3D(void)
 	pVS->Release();
 	pPS->Release();
 	depthbuffer->Release();
-	pVBuffer->Release();
-	pCBuffer->Release();
-	pIBuffer->Release();
+	if (pVBuffer != NULL)
+		pVBuffer->Release();								// The vertex buffer and index buffer are not created if the program ends before the mesh upload manager uploads them.
+	if (pConstantRing != NULL)
+	{
+		pConstantRing->Release();
+		for (int i = 0; i < FRAME_FENCES_TOTAL; i++)
+			FrameFences[i]->Release();
+		devcon1->Release();
+	}
+	else
+	{
+		pCBuffer->Release();
+		pObjectCBuffer->Release();
+	}
+	if (pIBuffer != NULL)
+		pIBuffer->Release();
+	for (ID3D11Buffer* staging : pUploadStaging)
+		if (staging != NULL)
+			staging->Release();
+	pInstanceBuffer->Release();
+	for (GpuProfileFrame& frame : GpuProfileFrames)
+	{
+		if (frame.Disjoint == NULL)
+			continue;
+		frame.Disjoint->Release();
+		for (int i = 0; i < 3; i++)
+			frame.Timestamps[i]->Release();
+	}
 	swapchain->Release();
 	backbuffer->Release();
 	dev->Release();
@@ -0,0 +1,68 @@
+// processMemory
+// Version 3.1
+//
+// Description
+// This function queries how much physical memory the calling process is using.
+// The resident set (working set on Windows) is the part of the process's virtual memory that is currently held in physical memory. Its peak is the largest it has been since the process started.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Process memory usage Header File.
+#include "processMemory.h"
+
+// Operating System Header Files.
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>											// GetProcessMemoryInfo.
+#pragma comment(lib, "psapi.lib")							// Process Status API Library. Needed for GetProcessMemoryInfo.
+#else
+#include <cstdio>											// fopen, fscanf, fclose.
+#include <sys/resource.h>									// getrusage.
+#include <unistd.h>											// sysconf.
+#endif
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// GetProcessMemoryUsage function: Definition
+int GetProcessMemoryUsage(size_t& ResidentBytes, size_t& PeakResidentBytes)
+{
+	ResidentBytes = 0;
+	PeakResidentBytes = 0;
+
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return 1;
+	ResidentBytes = counters.WorkingSetSize;
+	PeakResidentBytes = counters.PeakWorkingSetSize;
+#else
+	// The second field of /proc/self/statm is the resident set size, in pages.
+	FILE* statm = fopen("/proc/self/statm", "r");
+	if (statm == nullptr)
+		return 1;
+	unsigned long sizePages = 0, residentPages = 0;
+	int fields = fscanf(statm, "%lu %lu", &sizePages, &residentPages);
+	fclose(statm);
+	if (fields != 2)
+		return 1;
+	ResidentBytes = (size_t)residentPages * (size_t)sysconf(_SC_PAGESIZE);
+
+	// getrusage returns the peak resident set size in kilobytes.
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 1;
+	PeakResidentBytes = (size_t)usage.ru_maxrss * 1024;
+#endif
+
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
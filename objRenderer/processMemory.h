@@ -0,0 +1,33 @@
+// processMemory Header File
+// Version 3.1
+//
+// Description
+// Process memory usage Header File
+// This header file contains the declarations used to query how much physical memory (resident set, or working set on Windows) the calling process is using.
+// Include it in all source files that report memory usage, e.g., the objReader function source file.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Standard Definitions.
+#include <cstddef>											// Required for the size_t data type.
+
+//***
+// Global Function Declarations.
+//***
+
+int GetProcessMemoryUsage(size_t& ResidentBytes, size_t& PeakResidentBytes);	// The GetProcessMemoryUsage function returns the calling process's current and peak resident set size (working set size on Windows), in bytes. It returns 0 on success, or 1 if they cannot be determined.
+
+// End: Global Function Declarations.
+
+// End: Global Declarations.
@@ -0,0 +1,161 @@
+// renderQueue
+// Version 3.1
+//
+// Description
+// These functions record draws into command lists, merge and sort them by their 64-bit sort keys with a least significant digit radix sort, and execute them with a backend, skipping the binds of state that is already bound.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Render queue Header File.
+// Includes the Vector Container Class and the Function Class.
+#include "renderQueue.h"
+
+// The number of bits sorted by each pass of the radix sort, and the number of buckets of each pass.
+static const int RenderRadixBits = 8;
+static const int RenderRadixBuckets = 1 << RenderRadixBits;
+static const int RenderRadixPasses = 64 / RenderRadixBits;
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// RenderSortKey function: Definition
+//   Bits 63 to 56 are the shader, 55 to 44 the texture, 43 to 32 the mesh, and 31 to 0 the depth, so the draws are sorted by shader, then texture, then mesh, then front to back.
+unsigned long long RenderSortKey(int Shader, int Texture, int Mesh, unsigned int Depth)
+{
+	const int depthShift = 0;
+	const int meshShift = depthShift + RENDER_KEY_DEPTH_BITS;
+	const int textureShift = meshShift + RENDER_KEY_MESH_BITS;
+	const int shaderShift = textureShift + RENDER_KEY_TEXTURE_BITS;
+	return ((unsigned long long)(Shader & ((1 << RENDER_KEY_SHADER_BITS) - 1)) << shaderShift) |
+		((unsigned long long)(Texture & ((1 << RENDER_KEY_TEXTURE_BITS) - 1)) << textureShift) |
+		((unsigned long long)(Mesh & ((1 << RENDER_KEY_MESH_BITS) - 1)) << meshShift) |
+		((unsigned long long)Depth << depthShift);
+}
+
+// ResetRenderQueue function: Definition
+//   The memory of the command lists is kept, so a queue recorded every frame stops allocating memory after the first few frames. A queue may therefore have more than ListsTotal lists, all empty.
+void ResetRenderQueue(RenderQueue& Queue, int ListsTotal)
+{
+	if ((int)Queue.Lists.size() < ListsTotal)
+		Queue.Lists.resize(ListsTotal);
+	for (RenderCommandList& list : Queue.Lists)
+		list.Commands.clear();
+	Queue.Commands.clear();
+	Queue.Sorted.clear();
+}
+
+// RecordRenderDraw function: Definition
+void RecordRenderDraw(RenderCommandList& List, unsigned long long Key, const RenderDraw& Draw)
+{
+	List.Commands.push_back({ Key, Draw });
+}
+
+// SortRenderQueue function: Definition
+//   This function appends the commands of every list to Queue.Commands, in list order, and sorts their keys into Queue.Sorted with a radix sort of eight passes of 8 bits each, least significant first.
+//   Each pass is stable, so commands with equal keys keep their merged order. The histograms of all passes are counted in one read of the keys,
+//   and a pass whose bits are the same in every key, e.g., the shader bits when there is one shader, is skipped, so sorting a frame's few hundred draws usually takes two or three passes.
+void SortRenderQueue(RenderQueue& Queue)
+{
+	Queue.Commands.clear();
+	for (RenderCommandList& list : Queue.Lists)
+		Queue.Commands.insert(Queue.Commands.end(), list.Commands.begin(), list.Commands.end());
+
+	size_t commandsTotal = Queue.Commands.size();
+	Queue.Sorted.resize(commandsTotal);
+	Queue.Scratch.resize(commandsTotal);
+	static thread_local unsigned int histograms[RenderRadixPasses][RenderRadixBuckets];
+	for (int pass = 0; pass < RenderRadixPasses; pass++)
+		for (int bucket = 0; bucket < RenderRadixBuckets; bucket++)
+			histograms[pass][bucket] = 0;
+	for (size_t c = 0; c < commandsTotal; c++)
+	{
+		unsigned long long key = Queue.Commands[c].Key;
+		Queue.Sorted[c] = { key, (unsigned int)c };
+		for (int pass = 0; pass < RenderRadixPasses; pass++)
+			histograms[pass][(key >> (pass * RenderRadixBits)) & (RenderRadixBuckets - 1)]++;
+	}
+
+	for (int pass = 0; pass < RenderRadixPasses; pass++)
+	{
+		unsigned int* histogram = histograms[pass];
+		int shift = pass * RenderRadixBits;
+		if (commandsTotal == 0 || histogram[(Queue.Sorted[0].Key >> shift) & (RenderRadixBuckets - 1)] == commandsTotal)
+			continue;										// Every key has the same bits in this pass.
+
+		// Turn the histogram into the location of the first entry of each bucket, then move each entry to its bucket, in order.
+		unsigned int location = 0;
+		for (int bucket = 0; bucket < RenderRadixBuckets; bucket++)
+		{
+			unsigned int count = histogram[bucket];
+			histogram[bucket] = location;
+			location += count;
+		}
+		for (const RenderSortEntry& entry : Queue.Sorted)
+			Queue.Scratch[histogram[(entry.Key >> shift) & (RenderRadixBuckets - 1)]++] = entry;
+		Queue.Sorted.swap(Queue.Scratch);
+	}
+}
+
+// ExecuteRenderQueue function: Definition
+//   The shader, texture, and mesh of each command are read from its sort key. Each is bound only if it differs from the state in Cache, which is updated as it is bound.
+void ExecuteRenderQueue(const RenderQueue& Queue, RenderStateCache& Cache, const RenderBackend& Backend, RenderQueueStatistics& Statistics)
+{
+	Statistics = RenderQueueStatistics();
+
+	for (const RenderSortEntry& entry : Queue.Sorted)
+	{
+		int mesh = (int)((entry.Key >> RENDER_KEY_DEPTH_BITS) & ((1 << RENDER_KEY_MESH_BITS) - 1));
+		int texture = (int)((entry.Key >> (RENDER_KEY_DEPTH_BITS + RENDER_KEY_MESH_BITS)) & ((1 << RENDER_KEY_TEXTURE_BITS) - 1));
+		int shader = (int)((entry.Key >> (RENDER_KEY_DEPTH_BITS + RENDER_KEY_MESH_BITS + RENDER_KEY_TEXTURE_BITS)) & ((1 << RENDER_KEY_SHADER_BITS) - 1));
+
+		if (shader != Cache.Shader)
+		{
+			Backend.SetShader(shader);
+			Cache.Shader = shader;
+			Statistics.ShaderBinds++;
+		} else
+			Statistics.BindsSkipped++;
+		if (texture != Cache.Texture)
+		{
+			Backend.SetTexture(texture);
+			Cache.Texture = texture;
+			Statistics.TextureBinds++;
+		} else
+			Statistics.BindsSkipped++;
+		if (mesh != Cache.Mesh)
+		{
+			Backend.SetMesh(mesh);
+			Cache.Mesh = mesh;
+			Statistics.MeshBinds++;
+		} else
+			Statistics.BindsSkipped++;
+
+		Backend.Draw(Queue.Commands[entry.Command].Draw);
+		Statistics.Draws++;
+	}
+}
+
+// InvalidateRenderStateCache function: Definition
+void InvalidateRenderStateCache(RenderStateCache& Cache)
+{
+	Cache = RenderStateCache();
+}
+
+// CreateRecordingBackend function: Definition
+void CreateRecordingBackend(RenderRecording& Recording, RenderBackend& Backend)
+{
+	Recording = RenderRecording();
+	RenderRecording* recording = &Recording;
+	Backend.SetShader = [recording](int Shader) { recording->Calls.push_back({ RENDER_CALL_SET_SHADER, Shader, RenderDraw() }); recording->ShaderBinds++; };
+	Backend.SetTexture = [recording](int Texture) { recording->Calls.push_back({ RENDER_CALL_SET_TEXTURE, Texture, RenderDraw() }); recording->TextureBinds++; };
+	Backend.SetMesh = [recording](int Mesh) { recording->Calls.push_back({ RENDER_CALL_SET_MESH, Mesh, RenderDraw() }); recording->MeshBinds++; };
+	Backend.Draw = [recording](const RenderDraw& Draw) { recording->Calls.push_back({ RENDER_CALL_DRAW, 0, Draw }); recording->Draws++; };
+}
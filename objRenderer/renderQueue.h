@@ -0,0 +1,158 @@
+// renderQueue Header File
+// Version 3.1
+//
+// Description
+// Render queue Header File
+// This header file contains the declarations used to record draws into a render queue, sort them, and execute them with as few state changes as possible.
+// Each draw is recorded with a 64-bit sort key made of the state it is drawn with (shader, texture, and mesh) and its depth, so sorting the keys groups the draws that share state, most expensive state first, and orders each group front to back.
+// Draws are recorded into command lists, one per job, so any number of jobs may record at the same time without a lock; the lists are merged and sorted with a radix sort before the queue is executed.
+// The queue is executed by a backend: a set of functions that bind a shader, a texture, or a mesh, and draw. A state already bound is not bound again (see RenderStateCache).
+// None of these functions use Direct3D: the objRenderer program executes the queue with a backend that calls Direct3D, and the recording backend (CreateRecordingBackend function) records every call instead, so the draws and state changes can be counted and compared, e.g., on Linux.
+// Include it in all source files that record or execute draws, e.g., the objRenderer program.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Vector Container Class.
+#include <vector>											// Vector class, used to hold the commands.
+
+// Function Class.
+#include <functional>										// Function class, used to pass the functions of a backend.
+
+// Defines.
+// The number of bits of each field of a sort key, from the most significant: shader, texture, mesh, and depth. A field's value must be less than 2 to the power of its number of bits.
+#define RENDER_KEY_SHADER_BITS 8
+#define RENDER_KEY_TEXTURE_BITS 12
+#define RENDER_KEY_MESH_BITS 12
+#define RENDER_KEY_DEPTH_BITS 32
+
+//***
+// Enumeration Declarations.
+//***
+
+// The calls of a backend, as recorded by the recording backend.
+enum RenderCall {
+	RENDER_CALL_SET_SHADER,
+	RENDER_CALL_SET_TEXTURE,
+	RENDER_CALL_SET_MESH,
+	RENDER_CALL_DRAW
+};
+
+// End: Enumeration Declarations.
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the RenderDraw 'named structure' data type.
+// The parameters of one indexed, instanced draw, the same as those of the DrawIndexedInstanced member function.
+struct RenderDraw {
+	unsigned int IndexCount;								// The number of indices to draw per instance.
+	unsigned int InstanceCount;								// The number of instances to draw.
+	unsigned int FirstIndex;								// The location of the first index in the index buffer.
+	int BaseVertex;											// A value added to each index before reading a vertex from the vertex buffer.
+	unsigned int FirstInstance;								// The location of the first instance in the instance buffer.
+};
+
+// Declare the RenderCommand 'named structure' data type.
+// One draw recorded in a command list, and the sort key it was recorded with (see the RenderSortKey function).
+struct RenderCommand {
+	unsigned long long Key;
+	RenderDraw Draw;
+};
+
+// Declare the RenderCommandList 'named structure' data type.
+// The commands recorded by one job. A command list must not be recorded by two jobs at the same time.
+struct RenderCommandList {
+	std::vector<RenderCommand> Commands;
+};
+
+// Declare the RenderSortEntry 'named structure' data type.
+// The sort key of a command, and the location of the command in the merged command lists (RenderQueue::Commands).
+struct RenderSortEntry {
+	unsigned long long Key;
+	unsigned int Command;
+};
+
+// Declare the RenderQueue 'named structure' data type.
+// A RenderQueue holds the command lists of one frame, and the arrays used to sort them, which keep their memory from frame to frame.
+struct RenderQueue {
+	std::vector<RenderCommandList> Lists;					// The command lists, merged in this order, so commands with equal sort keys are executed in the order of their lists, and the order they were recorded in.
+	std::vector<RenderCommand> Commands;					// The commands of every list, merged by the SortRenderQueue function.
+	std::vector<RenderSortEntry> Sorted;					// The sort keys of the commands, in the order the commands are executed.
+	std::vector<RenderSortEntry> Scratch;					// The sort keys of the commands, used by each pass of the radix sort.
+};
+
+// Declare the RenderStateCache 'named structure' data type.
+// The state last bound by a backend, or -1 if it is not known, e.g., before the first command is executed, or after something other than the render queue has changed it.
+// It is kept from frame to frame, so a state that does not change is bound only once.
+struct RenderStateCache {
+	int Shader = -1;
+	int Texture = -1;
+	int Mesh = -1;
+};
+
+// Declare the RenderBackend 'named structure' data type.
+// The functions that execute the commands of a render queue. SetShader, SetTexture, and SetMesh bind the state identified by their parameter; Draw draws with the state bound.
+struct RenderBackend {
+	std::function<void(int Shader)> SetShader;
+	std::function<void(int Texture)> SetTexture;
+	std::function<void(int Mesh)> SetMesh;
+	std::function<void(const RenderDraw& Draw)> Draw;
+};
+
+// Declare the RenderQueueStatistics 'named structure' data type.
+// The calls made by the ExecuteRenderQueue function.
+struct RenderQueueStatistics {
+	unsigned int Draws = 0;									// The number of commands, i.e., Draw calls.
+	unsigned int ShaderBinds = 0;							// The number of SetShader calls.
+	unsigned int TextureBinds = 0;							// The number of SetTexture calls.
+	unsigned int MeshBinds = 0;								// The number of SetMesh calls.
+	unsigned int BindsSkipped = 0;							// The number of binds not made because the state was already bound.
+};
+
+// Declare the RenderRecordedCall 'named structure' data type.
+// One call of the recording backend: the state bound (Value), or the draw (Draw).
+struct RenderRecordedCall {
+	RenderCall Call;
+	int Value;
+	RenderDraw Draw;
+};
+
+// Declare the RenderRecording 'named structure' data type.
+// The calls recorded by the recording backend, in the order they were made, and the number of calls of each type.
+struct RenderRecording {
+	std::vector<RenderRecordedCall> Calls;
+	unsigned int Draws = 0;
+	unsigned int ShaderBinds = 0;
+	unsigned int TextureBinds = 0;
+	unsigned int MeshBinds = 0;
+};
+
+// End: Structure Declarations.
+
+//***
+// Global Function Declarations.
+//***
+
+unsigned long long RenderSortKey(int Shader, int Texture, int Mesh, unsigned int Depth);		// The RenderSortKey function returns the sort key of a draw with Shader, Texture, and Mesh, at Depth (any value that increases with the distance from the camera).
+void ResetRenderQueue(RenderQueue& Queue, int ListsTotal);										// The ResetRenderQueue function empties Queue and gives it ListsTotal empty command lists. It must be called before any list is recorded.
+void RecordRenderDraw(RenderCommandList& List, unsigned long long Key, const RenderDraw& Draw);	// The RecordRenderDraw function records a draw with sort key Key in List.
+void SortRenderQueue(RenderQueue& Queue);														// The SortRenderQueue function merges the command lists of Queue and sorts the commands by their sort keys.
+void ExecuteRenderQueue(const RenderQueue& Queue, RenderStateCache& Cache, const RenderBackend& Backend, RenderQueueStatistics& Statistics);	// The ExecuteRenderQueue function executes the commands of Queue, sorted by the SortRenderQueue function, in order with Backend, binding only the state that is not already bound (Cache).
+void InvalidateRenderStateCache(RenderStateCache& Cache);										// The InvalidateRenderStateCache function forgets the state bound, so the next command binds every state. Call it when something other than the render queue binds a state.
+void CreateRecordingBackend(RenderRecording& Recording, RenderBackend& Backend);				// The CreateRecordingBackend function sets Backend to functions that record each call in Recording, which must outlive Backend.
+
+// End: Global Function Declarations.
+
+// End: Global Declarations.
@@ -0,0 +1,270 @@
+// shaderCache
+// Version 3.1
+//
+// Description
+// These functions compile a shader function with a shader compiler passed by the calling program, save its bytecode to a shader cache file (.cso file), and load it back the next time the same shader is compiled.
+// The shader is identified by a 64-bit key hashed from the contents of its source file, its entry point, target, shader macros, compile options, and the compiler version, so a cache file is never used for a shader it was not compiled from.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Shader cache (.cso file) I/O Header File.
+// Includes the String Class, the Vector Container Class, and the Function Class.
+#include "shaderCache.h"
+
+// Read-only memory-mapped file I/O Header File.
+#include "mappedFile.h"
+
+// File Stream Functions.
+#include <fstream>											// File stream class member functions write, close, etc.
+
+// File System Functions.
+#include <filesystem>										// File system functions file_size, last_write_time, rename, remove.
+
+// Memory Functions.
+#include <cstring>											// Memory functions memcpy, memcmp, memset, strlen.
+
+// Using Declarations and Directives.
+using std::string;
+using std::vector;
+using std::ofstream;
+using std::ios;
+using std::error_code;
+using std::memcmp;
+using std::memcpy;
+using std::memset;
+using std::strlen;
+namespace fs = std::filesystem;
+
+//***
+// External Variable Global Definitions.
+//***
+
+bool ShaderCacheEnabled = true;
+bool ShaderHotReloadEnabled = false;
+
+// End: External Variable Global Definitions.
+
+// The first eight bytes of every shader cache file.
+static const char ShaderCacheMagic[8] = { 'O', 'B', 'J', 'S', 'H', 'D', 'R', '\0' };
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// ShaderCacheFileName function: Definition
+//   This function returns the name of the shader cache file of a shader function, i.e., the source file name followed by the entry point, the target, and ".cso" (shaders.hlsl, VShader, vs_4_1 -> shaders.hlsl.VShader.vs_4_1.cso).
+//   Each shader function has one cache file; compiling it with different shader macros or compile options replaces the cache file.
+static string ShaderCacheFileName(const char* SourceFileName, const char* EntryPoint, const char* Target)
+{
+	return string(SourceFileName) + "." + EntryPoint + "." + Target + ".cso";
+}
+
+// ShaderHash function: Definition
+//   This function continues the 64-bit FNV-1a hash Hash with Size bytes of Data, and returns it.
+static unsigned long long ShaderHash(unsigned long long Hash, const void* Data, size_t Size)
+{
+	const unsigned char* bytes = (const unsigned char*)Data;
+	for (size_t i = 0; i < Size; i++)
+		Hash = (Hash ^ bytes[i]) * 1099511628211ull;
+	return Hash;
+}
+
+// ShaderHashString function: Definition
+//   This function continues the 64-bit FNV-1a hash Hash with the null-terminated string String, including its null character so that consecutive strings cannot run together (e.g., "AB", "C" and "A", "BC"), and returns it.
+static unsigned long long ShaderHashString(unsigned long long Hash, const char* String)
+{
+	return ShaderHash(Hash, String, strlen(String) + 1);
+}
+
+// ShaderSourceStamp function: Definition
+//   This function returns the size and last write time of the shader source file, which identify the version of the source file a shader was compiled from.
+//   It returns 0 on success, or 1 if the source file does not exist.
+static int ShaderSourceStamp(const char* SourceFileName, unsigned long long& SourceSize, long long& SourceWriteTime)
+{
+	error_code error;
+	SourceSize = (unsigned long long)fs::file_size(SourceFileName, error);
+	if (error)
+		return 1;
+	SourceWriteTime = (long long)fs::last_write_time(SourceFileName, error).time_since_epoch().count();
+	if (error)
+		return 1;
+	return 0;
+}
+
+// ShaderCacheKey function: Definition
+//   This function returns the key of a shader: the 64-bit FNV-1a hash of SHADER_CACHE_VERSION, CompilerVersion, Flags, the SourceSize bytes of Source, EntryPoint, Target, and the name and definition of each shader macro of Defines, in order.
+//   Shader macros defined in a different order give a different key, and so are compiled again, even though the bytecode is the same.
+unsigned long long ShaderCacheKey(const char* Source, size_t SourceSize, const ShaderDefine* Defines, const char* EntryPoint, const char* Target, unsigned int Flags, unsigned int CompilerVersion)
+{
+	unsigned int version = SHADER_CACHE_VERSION;
+	unsigned long long sourceSize = SourceSize;
+	unsigned long long hash = 14695981039346656037ull;
+	hash = ShaderHash(hash, &version, sizeof(version));
+	hash = ShaderHash(hash, &CompilerVersion, sizeof(CompilerVersion));
+	hash = ShaderHash(hash, &Flags, sizeof(Flags));
+	hash = ShaderHash(hash, &sourceSize, sizeof(sourceSize));
+	hash = ShaderHash(hash, Source, SourceSize);
+	hash = ShaderHashString(hash, EntryPoint);
+	hash = ShaderHashString(hash, Target);
+	unsigned int definesTotal = 0;
+	for (; Defines != NULL && Defines[definesTotal].Name != NULL; definesTotal++)
+	{
+		hash = ShaderHashString(hash, Defines[definesTotal].Name);
+		hash = ShaderHashString(hash, Defines[definesTotal].Definition != NULL ? Defines[definesTotal].Definition : "");
+	}
+	hash = ShaderHash(hash, &definesTotal, sizeof(definesTotal));
+	return hash;
+}
+
+// ShaderCacheLoad function: Definition
+//   This function reads the shader cache file of EntryPoint and Target and checks that it is valid:
+//   - The header's magic, version, and key match this program and Key.
+//   - The file's size matches the header's BytecodeSize, and the bytecode's hash matches the header's BytecodeHash.
+//   It returns 0 if the cache file is valid, in which case Bytecode is set to the shader bytecode, or 1 otherwise, in which case Bytecode is empty.
+int ShaderCacheLoad(const char* SourceFileName, const char* EntryPoint, const char* Target, unsigned long long Key, vector<unsigned char>& Bytecode)
+{
+	Bytecode.clear();
+
+	MappedFile cache;
+	if (MapFile(ShaderCacheFileName(SourceFileName, EntryPoint, Target).c_str(), cache) == 1)
+		return 1;											// There is no shader cache file.
+
+	// Check the header.
+	ShaderCacheHeader header;
+	if (cache.Size < sizeof(ShaderCacheHeader))
+	{
+		UnmapFile(cache);
+		return 1;
+	}
+	memcpy(&header, cache.Data, sizeof(ShaderCacheHeader));
+	const char* bytecode = cache.Data + sizeof(ShaderCacheHeader);
+	if (memcmp(header.Magic, ShaderCacheMagic, sizeof(ShaderCacheMagic)) != 0 ||
+		header.Version != SHADER_CACHE_VERSION ||
+		header.Key != Key ||
+		header.BytecodeSize == 0 ||
+		cache.Size != sizeof(ShaderCacheHeader) + (size_t)header.BytecodeSize ||
+		header.BytecodeHash != ShaderHash(14695981039346656037ull, bytecode, header.BytecodeSize))
+	{
+		// The shader cache file is out of date or damaged.
+		UnmapFile(cache);
+		return 1;
+	}
+
+	// The shader bytecode follows the header. It is copied, because the shader objects created from it outlive the mapped cache file.
+	Bytecode.assign((const unsigned char*)bytecode, (const unsigned char*)bytecode + header.BytecodeSize);
+	UnmapFile(cache);
+
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
+
+// ShaderCacheSave function: Definition
+//   This function saves the shader cache file of EntryPoint and Target, holding Bytecode compiled from the shader identified by Key.
+//   The file is first written under a temporary name and then renamed, so a program loading the cache file at the same time never sees a partially written file.
+//   It returns 0 on success, or 1 if the file cannot be written.
+int ShaderCacheSave(const char* SourceFileName, const char* EntryPoint, const char* Target, unsigned long long Key, const vector<unsigned char>& Bytecode)
+{
+	ShaderCacheHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.Magic, ShaderCacheMagic, sizeof(ShaderCacheMagic));
+	header.Version = SHADER_CACHE_VERSION;
+	header.BytecodeSize = (unsigned int)Bytecode.size();
+	header.Key = Key;
+	header.BytecodeHash = ShaderHash(14695981039346656037ull, Bytecode.data(), Bytecode.size());
+
+	string cacheFileName = ShaderCacheFileName(SourceFileName, EntryPoint, Target);
+	string temporaryFileName = cacheFileName + ".tmp";
+
+	ofstream cache(temporaryFileName, ios::out | ios::binary | ios::trunc);
+	if (!cache)
+		return 1;
+	cache.write((const char*)&header, sizeof(header));
+	cache.write((const char*)Bytecode.data(), (std::streamsize)Bytecode.size());
+	cache.close();
+
+	error_code error;
+	if (!cache)
+	{
+		fs::remove(temporaryFileName, error);
+		return 1;
+	}
+	fs::rename(temporaryFileName, cacheFileName, error);
+	if (error)
+	{
+		fs::remove(temporaryFileName, error);
+		return 1;
+	}
+
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
+
+// CompileShader function: Definition
+//   This function sets Program to the bytecode of the function EntryPoint of SourceFileName, compiled for Target with the shader macros Defines (or NULL) and the compile options Flags:
+//   1. Read the source file and find the shader's key.
+//   2. If ShaderCacheEnabled is true and the shader cache file was saved with the same key, load the bytecode from it.
+//   3. Otherwise, compile the source file with Compiler and, if ShaderCacheEnabled is true, save the bytecode to the shader cache file.
+//   The source file is compiled from the same bytes that were hashed, so a source file that changes while it is being compiled cannot be cached under the wrong key.
+//   It returns 0 on success, or 1 if the source file cannot be read or the shader cannot be compiled, in which case Errors is set to the reason and Program's bytecode is unchanged.
+//   If the shader cannot be compiled, Program's SourceSize and SourceWriteTime are still set to the version of the source file that failed, so the ShaderSourceChanged function reports only the next change to it.
+int CompileShader(const char* SourceFileName, const ShaderDefine* Defines, const char* EntryPoint, const char* Target, unsigned int Flags, unsigned int CompilerVersion,
+	const ShaderCompiler& Compiler, ShaderProgram& Program, string& Errors)
+{
+	Errors.clear();
+
+	// 1. Read the source file and find the shader's key.
+	ShaderProgram program;
+	MappedFile source;
+	if (ShaderSourceStamp(SourceFileName, program.SourceSize, program.SourceWriteTime) == 1 || MapFile(SourceFileName, source) == 1)
+	{
+		Errors = string("Cannot read the shader source file ") + SourceFileName + ".";
+		return 1;
+	}
+	program.Key = ShaderCacheKey(source.Data, source.Size, Defines, EntryPoint, Target, Flags, CompilerVersion);
+
+	// 2. Load the bytecode from the shader cache file.
+	if (ShaderCacheEnabled && ShaderCacheLoad(SourceFileName, EntryPoint, Target, program.Key, program.Bytecode) == 0)
+	{
+		UnmapFile(source);
+		program.CacheHit = true;
+		Program = std::move(program);
+		return 0;
+	}
+
+	// 3. Compile the source file, and save the bytecode to the shader cache file.
+	int result = Compiler(source.Data != nullptr ? source.Data : "", source.Size, SourceFileName, Defines, EntryPoint, Target, Flags, program.Bytecode, Errors);
+	UnmapFile(source);
+	if (result != 0 || program.Bytecode.empty())
+	{
+		if (Errors.empty())
+			Errors = string("Cannot compile ") + EntryPoint + " (" + Target + ") in " + SourceFileName + ".";
+		Program.SourceSize = program.SourceSize;
+		Program.SourceWriteTime = program.SourceWriteTime;
+		return 1;
+	}
+	if (ShaderCacheEnabled)
+		ShaderCacheSave(SourceFileName, EntryPoint, Target, program.Key, program.Bytecode);	// A cache file that cannot be written only means the shader is compiled again the next time.
+	Program = std::move(program);
+
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
+
+// ShaderSourceChanged function: Definition
+//   This function returns true if the size or last write time of SourceFileName differs from when Program was compiled, i.e., the shader may need to be compiled again.
+//   It does not read the source file, so it is cheap enough to call while the program runs. A source file that cannot be found is treated as unchanged, e.g., while an editor is saving it.
+bool ShaderSourceChanged(const char* SourceFileName, const ShaderProgram& Program)
+{
+	unsigned long long sourceSize;
+	long long sourceWriteTime;
+	if (ShaderSourceStamp(SourceFileName, sourceSize, sourceWriteTime) == 1)
+		return false;
+	return sourceSize != Program.SourceSize || sourceWriteTime != Program.SourceWriteTime;
+}
@@ -0,0 +1,111 @@
+// shaderCache Header File
+// Version 3.1
+//
+// Description
+// Shader cache (.cso file) I/O Header File
+// This header file contains the declarations used to compile a shader function once and save its bytecode to a shader cache file, so the objRenderer program neither runs the HLSL compiler when it starts nor ships shaders compiled without optimization.
+// A shader cache file is valid only for the exact shader it was compiled from: the contents of the source file, the entry point, the target, the shader macros, the compile options, and the compiler version are hashed into a 64-bit key stored in the file.
+// The shader compiler itself is a function passed by the calling program, e.g., one that calls D3DCompile, so none of these functions use Direct3D. Include it in all source files that compile shaders, e.g., the objRenderer program.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Standard Definitions.
+#include <cstddef>											// Required for the size_t data type.
+
+// Standard Encapsulated Data and Functions for Manipulating String Data.
+#include <string>											// String class, used to return compiler error messages.
+
+// Vector Container Class.
+#include <vector>											// Vector class, used to hold shader bytecode.
+
+// Function Class.
+#include <functional>										// Function class, used to pass the shader compiler.
+
+// Defines.
+// The version of the shader cache file format. Increment it whenever the file format or the key changes, so that existing cache files are compiled again.
+#define SHADER_CACHE_VERSION 1
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the ShaderDefine 'named structure' data type.
+// One shader macro: Name is defined as Definition. An array of shader macros ends with a ShaderDefine whose Name is NULL.
+// It has the same members, in the same order, as the D3D_SHADER_MACRO structure, so an array of shader macros can be passed to the HLSL compiler unchanged.
+struct ShaderDefine {
+	const char* Name;										// The macro name.
+	const char* Definition;									// The macro definition.
+};
+
+// Declare the ShaderCacheHeader 'named structure' data type.
+// A shader cache file is named after its source file, entry point, and target (e.g., shaders.hlsl.VShader.vs_4_1.cso), and is comprised of a ShaderCacheHeader followed by the shader bytecode.
+struct ShaderCacheHeader {
+	char Magic[8];											// "OBJSHDR\0".
+	unsigned int Version;									// SHADER_CACHE_VERSION.
+	unsigned int BytecodeSize;								// The size, in bytes, of the shader bytecode.
+	unsigned long long Key;									// The key of the shader the bytecode was compiled from (see the ShaderCacheKey function).
+	unsigned long long BytecodeHash;						// The 64-bit FNV-1a hash of the shader bytecode, used to detect a damaged cache file.
+};
+
+// Declare the ShaderProgram 'named structure' data type.
+// A ShaderProgram holds the bytecode of one shader function returned by the CompileShader function, and the version of the source file it was compiled from.
+struct ShaderProgram {
+	std::vector<unsigned char> Bytecode;					// The shader bytecode, passed to CreateVertexShader, CreatePixelShader, or CreateInputLayout.
+	unsigned long long Key = 0;								// The key of the shader (see the ShaderCacheKey function).
+	bool CacheHit = false;									// True if Bytecode was loaded from the shader cache file, false if it was compiled.
+	unsigned long long SourceSize = 0;						// The size of the source file when it was read.
+	long long SourceWriteTime = 0;							// The last write time of the source file when it was read.
+};
+
+// End: Structure Declarations.
+
+//***
+// Type Declarations.
+//***
+
+// The ShaderCompiler function type compiles SourceSize bytes of HLSL code Source, read from SourceFileName, with the shader macros Defines (or NULL), into the bytecode of the function EntryPoint for Target, using the compile options Flags.
+// It returns 0 on success, in which case Bytecode is set to the shader bytecode, or 1 if the code cannot be compiled, in which case Errors is set to the compiler error messages.
+typedef std::function<int(const char* Source, size_t SourceSize, const char* SourceFileName, const ShaderDefine* Defines, const char* EntryPoint, const char* Target, unsigned int Flags,
+	std::vector<unsigned char>& Bytecode, std::string& Errors)> ShaderCompiler;
+
+// End: Type Declarations.
+
+//***
+// External Variable Global Declarations.
+//***
+
+// ShaderCacheEnabled selects whether compiled shaders are loaded from, and saved to, shader cache files. It is true by default.
+// When it is false, every shader is compiled each time the objRenderer program starts, and no shader cache files are written.
+extern bool ShaderCacheEnabled;
+//
+// ShaderHotReloadEnabled selects whether the objRenderer program checks its shader source file while it runs, and compiles and replaces its shaders when the file changes. It is false by default.
+// A shader that fails to compile is not replaced, so the program keeps drawing with the last shaders that compiled.
+extern bool ShaderHotReloadEnabled;
+
+// End: External Variable Global Declarations.
+
+//***
+// Global Function Declarations.
+//***
+
+unsigned long long ShaderCacheKey(const char* Source, size_t SourceSize, const ShaderDefine* Defines, const char* EntryPoint, const char* Target, unsigned int Flags, unsigned int CompilerVersion);	// The ShaderCacheKey function returns the 64-bit FNV-1a hash of everything the bytecode of a shader depends on.
+int ShaderCacheLoad(const char* SourceFileName, const char* EntryPoint, const char* Target, unsigned long long Key, std::vector<unsigned char>& Bytecode);						// The ShaderCacheLoad function reads the shader cache file of EntryPoint and Target. It returns 0 if the cache file is valid and was saved with Key, or 1 if it is missing, out of date, or damaged.
+int ShaderCacheSave(const char* SourceFileName, const char* EntryPoint, const char* Target, unsigned long long Key, const std::vector<unsigned char>& Bytecode);					// The ShaderCacheSave function saves the shader cache file of EntryPoint and Target. It returns 0 on success, or 1 if the file cannot be written.
+int CompileShader(const char* SourceFileName, const ShaderDefine* Defines, const char* EntryPoint, const char* Target, unsigned int Flags, unsigned int CompilerVersion,
+	const ShaderCompiler& Compiler, ShaderProgram& Program, std::string& Errors);																									// The CompileShader function sets Program to the bytecode of a shader, from its shader cache file or else compiled by Compiler. It returns 0 on success, or 1 if the source file cannot be read or the shader cannot be compiled.
+bool ShaderSourceChanged(const char* SourceFileName, const ShaderProgram& Program);																									// The ShaderSourceChanged function returns true if the size or last write time of SourceFileName differs from when Program was compiled.
+
+// End: Global Function Declarations.
+
+// End: Global Declarations.
@@ -3,7 +3,7 @@
 //
 // Description
 // Shader functions are small, low-level, programs that are compiled by the CPU and then run by the GPU at specific stages in the graphics pipeline. They automatically receive data from shader functions in previous stages, and return data to shader functions in successive stages, of the graphics pipeline.
-// Shader functions execute when the ID3D11DeviceContext::DrawIndexed member function, or a similar member function, is called from a DirectX application.
+// Shader functions execute when the ID3D11DeviceContext::DrawIndexedInstanced member function, or a similar member function, is called from a DirectX application.
 //
 // A semantic is an all caps string attached to a shader function's input or output that conveys information about the intended use of a parameter on the GPU. Semantics are required on all variables passed between shader stages.
 //   A semantic specified after a shader function's parameter list is used to convey information about the intended use of the shader function's return value, e.g., 
@@ -41,18 +41,41 @@
 // For example, a HLSL float4 variable, such as "position3D" in "float4 position3D : POSITION;" is assigned values from the vertex buffer, that were originally copied to the vertex buffer (using C++), from the smaller C++ variable OurVertices.
 // OurVertices only specifies three floats for geometric vertex position, and they are assigned to the first three floats of "position3D", leaving the last float of "position3D" undefined.
 
-// Declare the constant buffer.
-// Note this is defined using the type cbuffer, not the type struct.
-// See the C++ constant buffer structure declaration for an explanation of these constant buffer members.
-cbuffer ConstantBuffer
+// Declare the constant buffers.
+// Note these are defined using the type cbuffer, not the type struct.
+// See the C++ constant buffer structure declarations (FRAMECONSTANTS and OBJECTCONSTANTS) for an explanation of these constant buffer members.
+// The members are split by how often they change: FrameConstants is written once per frame, and ObjectConstants once per object drawn. Each is bound to its own register.
+cbuffer FrameConstants : register(b0)
 {
-	float4x4 matFinal;
-	float4x4 matRotate;
+	float4x4 matViewProjection;
 	float4 LightVector;
 	float4 LightColor;
 	float4 AmbientColor;
 }
 
+cbuffer ObjectConstants : register(b1)
+{
+	float4 GeometricVertexMinimum;
+	float4 GeometricVertexScale;
+	float4 VertexTextureCoordinateBounds;
+}
+
+// Declare the struct of per-instance input values read by the vertex shader function from the instance buffer, i.e., the HLSL counterpart of the C++ INSTANCEDATA structure (see instanceBuilder.h).
+// Each row is one column of a matrix, so a transformed coordinate is the dot product of the row with the untransformed coordinates.
+//
+// Semantics:
+// INSTANCEWORLD:  The first three columns of the instance's world matrix.                                     -> Vertex shader
+// INSTANCENORMAL: The first three columns of the instance's normal matrix (its rotation).                      -> Vertex shader
+struct INSTANCE
+{
+	float4 world0 : INSTANCEWORLD0;
+	float4 world1 : INSTANCEWORLD1;
+	float4 world2 : INSTANCEWORLD2;
+	float4 normal0 : INSTANCENORMAL0;
+	float4 normal1 : INSTANCENORMAL1;
+	float4 normal2 : INSTANCENORMAL2;
+};
+
 // Declare the struct of return values output by the vertex shader function. It is sometimes also used as the input struct for the pixel shader function.
 //
 // For a shader function to return multiple variables, it returns a struct containing multiple members, just as in a C++ program. Each structure member must specify its associated semantic.
@@ -76,8 +99,8 @@ SamplerState ss;											// A SamplerState sampler type.
 
 // Declarations: End
 
-// VShader function: Definition
-// This function is the vertex shader function.
+// VShaderVertex function: Definition
+// This function is the body of the vertex shader function, VShader (below), which is compiled in one of two forms: one receiving VERTEX structures, and one receiving PACKEDVERTEX structures (when the shader macro PACKED_VERTEX is defined).
 // A vertex shader function executes once for each vertex, e.g., for a single triangle, it is called by the graphics driver three times, once per vertex.
 // A vertex shader function always operates on a single input vertex and produces a single output vertex.
 // A vertex shader function may return multiple variables. In such case it returns a struct, e.g., structure VOut with its member variables, and consequently it specifies the associated semantics in that struct's definition.
@@ -93,16 +116,19 @@ SamplerState ss;											// A SamplerState sampler type.
 // POSITION:    Vertex position in 3D space.                                                                    -> Vertex shader
 // NORMAL:      Normal vector.                                                                                  -> Vertex shader
 // TEXCOORD:	Texture Coordinates.																			-> Vertex shader | Vertex shader -> Pixel shader
-VOut VShader(float4 position3D : POSITION, float4 normal : NORMAL, float2 texcoord : TEXCOORD)
+// The instance being drawn is placed in the world by its own world matrix and normal matrix, read from the instance buffer (see the INSTANCE struct), so one draw call draws every instance of a level of detail.
+VOut VShaderVertex(float4 position3D, float4 normal, float2 texcoord, INSTANCE instance)
 {
 	VOut output;
 
 	// Calculate the geometric vertex's 2D position (screen position) from its 3D position.
-	output.position2D = mul(matFinal, position3D);						// output.position2D with semantic SV_POSITION = f(constant buffer's matFinal, VShader parameter position3D with semantic POSITION)
+	float4 worldPosition = float4(dot(instance.world0, position3D), dot(instance.world1, position3D), dot(instance.world2, position3D), 1.0f);	// Transform the geometric vertex from object space to world space with the instance's world matrix.
+	output.position2D = mul(matViewProjection, worldPosition);			// output.position2D with semantic SV_POSITION = f(constant buffer's matViewProjection, VShader parameter position3D with semantic POSITION, instance's world matrix)
 
 	// Calculate changes in color based on the level of light.
 	// normalVector is necessary because VShader parameter "normal" cannot be modified.
-	float4 normalVector = normalize(mul(matRotate, normal));			// Rotate the vertex normal vector to match the rotation of the object.																   The "normalize" intrinsic scales the calculated value of a vector to make its length equal to 1.0.
+	float3 rotatedNormal = float3(dot(instance.normal0.xyz, normal.xyz), dot(instance.normal1.xyz, normal.xyz), dot(instance.normal2.xyz, normal.xyz));
+	float4 normalVector = normalize(float4(rotatedNormal, normal.w));	// Rotate the vertex normal vector to match the rotation of the instance, keeping its fourth component as before.										   The "normalize" intrinsic scales the calculated value of a vector to make its length equal to 1.0.
 	float diffusebrightness = saturate(dot(normalVector, LightVector)); // Calculate the amount of light at the vertex (diffuse brightness) as the dot product of the vertex normal vector and the light vector. The "saturate" intrinsic clamps the calculated values between 0 and 1.
 	output.color = AmbientColor + (LightColor * diffusebrightness);		// output.color with semantic COLOR = f(constant buffer's ambient light's color, constant buffer's light's color, calculated diffuse brightness)
 	output.texcoord = texcoord;											// Set the texture coordinates, unmodified.
@@ -110,6 +136,42 @@ VOut VShader(float4 position3D : POSITION, float4 normal : NORMAL, float2 texcoo
 	return output;
 }
 
+#ifdef PACKED_VERTEX
+// OctahedralDecode function: Definition
+// This function unpacks the direction of a vertex normal vector from its two octahedral coordinates, each between -1 and 1 (see the PackVertices function in vertexPacking.cpp, which packs it, and the UnpackVertices function, which unpacks it with the same arithmetic on the CPU).
+// A point of the square inside the diamond |x| + |y| <= 1 is on the upper half of the octahedron, with z = 1 - |x| - |y|. A point outside the diamond (z < 0) was folded outward from the lower half of the octahedron, and is folded back inward.
+float3 OctahedralDecode(float2 octahedral)
+{
+	float3 normal = float3(octahedral.x, octahedral.y, 1.0f - abs(octahedral.x) - abs(octahedral.y));
+	float t = saturate(-normal.z);
+	normal.x += normal.x >= 0.0f ? -t : t;
+	normal.y += normal.y >= 0.0f ? -t : t;
+	return normalize(normal);
+}
+
+// VShader function: Definition (PACKED_VERTEX)
+// This vertex shader function receives PACKEDVERTEX structures (see vertexPacking.h), unpacks them, and then calls the VShaderVertex function exactly as the VShader function below does for VERTEX structures.
+// The input-assembler stage of the graphics pipeline converts each 16-bit integer to a floating-point value: UNORM integers to 0.0 to 1.0, and SNORM integers to -1.0 to 1.0.
+//   POSITION: Each coordinate is rescaled from 0.0 to 1.0 to the range of that coordinate in the mesh, given by the constant buffer.
+//   NORMAL:   The two octahedral coordinates are unpacked to a unit vector.
+//   TEXCOORD: Each coordinate is rescaled from 0.0 to 1.0 to the range of that coordinate in the mesh, given by the constant buffer.
+// The fourth component of the position and of the vertex normal vector is 1.0, as it is when the input-assembler stage expands a three-component VERTEX element.
+VOut VShader(float4 packedPosition : POSITION, float2 packedNormal : NORMAL, float2 packedTexcoord : TEXCOORD, INSTANCE instance)
+{
+	float4 position3D = float4(packedPosition.xyz * GeometricVertexScale.xyz + GeometricVertexMinimum.xyz, 1.0f);
+	float4 normal = float4(OctahedralDecode(packedNormal), 1.0f);
+	float2 texcoord = packedTexcoord * VertexTextureCoordinateBounds.zw + VertexTextureCoordinateBounds.xy;
+	return VShaderVertex(position3D, normal, texcoord, instance);
+}
+#else
+// VShader function: Definition
+// This vertex shader function receives VERTEX structures, and passes them to the VShaderVertex function unchanged.
+VOut VShader(float4 position3D : POSITION, float4 normal : NORMAL, float2 texcoord : TEXCOORD, INSTANCE instance)
+{
+	return VShaderVertex(position3D, normal, texcoord, instance);
+}
+#endif
+
 // PShader function: Definition
 // This function is the pixel shader function.
 // A pixel shader function is also known as a fragment shader function. The term pixel shader is commonly used in the context of DirectX, while the term fragment shader is more commonly used in the context of OpenGL.
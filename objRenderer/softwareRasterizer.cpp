@@ -0,0 +1,647 @@
+// softwareRasterizer
+// Version 3.1
+//
+// Description
+// These functions render the object on the CPU, reproducing the graphics pipeline that the objRenderer program sets up with Direct3D: the VShader function (Lambert lighting), the default rasterizer state
+// (clockwise triangles are front faces, back faces are culled, and triangles are clipped to the viewing frustum), the default depth-stencil state (a sample is written if its depth is less than the depth buffer's),
+// the PShader function (the interpolated color times the texture image, sampled with the default sampler state: bilinear filtering, clamped texture coordinates), and the resolve of a multisampled render target.
+//
+// Each frame is drawn in two passes, each divided among the threads of the job system (see jobSystem.h):
+//   1. Triangle setup. The triangles of every draw and instance are divided into consecutive ranges, one per job. Each job transforms and lights their vertices (keeping recently transformed vertices in a small cache,
+//      as the post-transform vertex cache of a GPU does, which the mesh optimizer's triangle order suits), clips each triangle, and adds it to the bin of each tile of the render target its bounding box overlaps.
+//   2. Rasterization. Each tile is rasterized by one job, with the triangles in its bins, in drawing order (the bins of the first triangle setup job first). No two jobs write the same sample, so no locks are needed,
+//      and the samples of a tile stay in the job's cache while its triangles are drawn.
+// Each triangle is rasterized one 2x2 pixel quad at a time. Four edge functions, depths, or attributes, i.e., the four pixels of the quad (1 sample per pixel), or the four samples of one pixel (4 samples per pixel),
+// are found at once in the lanes of one SSE register. The vertices are snapped to 1/256 of a pixel, as Direct3D does, and each edge function is always evaluated from the same end of the edge,
+// so the two triangles sharing an edge find the same value at every sample, with opposite signs, and the top-left fill rule gives each sample on the edge to exactly one of them.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Software rasterizer Header File.
+#include "softwareRasterizer.h"
+
+// Job system Header File.
+#include "jobSystem.h"
+
+// Algorithm Functions.
+#include <algorithm>										// Algorithm functions min, max, upper_bound.
+
+// Mathematical Functions.
+#include <cmath>											// Mathematical functions floorf, sqrtf.
+
+// Memory Functions.
+#include <cstring>											// Memory functions memcpy.
+
+// Time Functions.
+#include <chrono>											// Steady clock, used to time frames.
+
+// SIMD Intrinsic Functions.
+// SSE2 is part of every x64 processor, and is assumed for x86 processors (DirectXMath assumes it too).
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define SOFTWARE_RASTERIZER_SSE
+#include <emmintrin.h>										// SSE2 intrinsic functions, e.g., _mm_mul_ps, _mm_cmpgt_ps.
+#endif
+
+// Using Declarations and Directives.
+using std::vector;
+using std::min;
+using std::max;
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the SoftwareClipVertex 'named structure' data type.
+// One vertex output by the vertex shader: its clip-space position (SV_POSITION), and its color (COLOR) and texture coordinates (TEXCOORD).
+struct SoftwareClipVertex {
+	float Position[4];										// x, y, z, w.
+	float Attributes[6];									// Red, green, blue, alpha, u, v.
+};
+
+// Declare the SoftwareCachedVertex 'named structure' data type.
+// One entry of the post-transform vertex cache of a triangle setup job: the vertex shader's output for vertex Vertex of instance Instance, or Vertex = -1 if the entry is empty.
+struct SoftwareCachedVertex {
+	int Instance;
+	int Vertex;
+	SoftwareClipVertex Output;
+};
+
+// Declare the SoftwareEdge 'named structure' data type.
+// One edge function of a triangle, E(x, y) = Sign * (DeltaX * (y - OriginY) - DeltaY * (x - OriginX)), which is positive inside the triangle and is twice the area of the triangle at the opposite vertex.
+// The origin is the end of the edge that comes first in (x, y) order, whichever way the triangle goes along the edge, and Sign is -1 if the triangle goes along the edge toward its origin.
+struct SoftwareEdge {
+	float OriginX, OriginY;
+	float DeltaX, DeltaY;
+	float Sign;
+	bool TopLeft;											// True if the edge is a top edge or a left edge, whose samples belong to the triangle (E = 0 is inside).
+};
+
+// End: Structure Declarations.
+
+//***
+// External Variable Global Definitions.
+//***
+
+bool SoftwareRasterizerEnabled = false;
+const char* SoftwareRasterizerFileName = "objRenderer.bmp";
+bool SoftwareRasterizerSimdEnabled = true;
+
+// End: External Variable Global Definitions.
+
+// Constants of the software rasterizer.
+static const int SoftwareVertexCacheSize = 256;				// The number of entries of the post-transform vertex cache of each triangle setup job. A vertex is stored in entry Vertex % SoftwareVertexCacheSize.
+static const int SoftwareSetupJobsPerThread = 2;			// The number of triangle setup jobs per thread.
+static const float SoftwareGuardBand = 8.0f;				// Triangles are clipped to -SoftwareGuardBand <= x / w, y / w <= SoftwareGuardBand, which keeps their positions small enough to be snapped exactly, and are otherwise only clipped to the render target when rasterized.
+static const float SoftwareSubpixels = 256.0f;				// The positions of the vertices are snapped to 1 / SoftwareSubpixels of a pixel.
+
+// The positions of the 4 samples of a pixel, relative to its center, in pixels: the standard 4-sample pattern of Direct3D.
+static const float SoftwareSampleOffsetX[4] = { -2.0f / 16.0f, 6.0f / 16.0f, -6.0f / 16.0f, 2.0f / 16.0f };
+static const float SoftwareSampleOffsetY[4] = { -6.0f / 16.0f, -2.0f / 16.0f, 2.0f / 16.0f, 6.0f / 16.0f };
+
+// The positions of the 4 pixels of a quad, relative to its top-left pixel: lane 0 is the top-left pixel, lane 1 the top-right, lane 2 the bottom-left, and lane 3 the bottom-right.
+static const float SoftwareQuadX[4] = { 0.0f, 1.0f, 0.0f, 1.0f };
+static const float SoftwareQuadY[4] = { 0.0f, 0.0f, 1.0f, 1.0f };
+
+// End: Global Declarations.
+
+//***
+// SIMD Lanes.
+// The rasterizer is written once, as a function template, for a type holding four floats (four lanes), and is compiled for SSE registers (SoftwareLanesSse) and for arrays of four floats (SoftwareLanesScalar).
+// Comparisons return a 4-bit mask, bit k for lane k.
+//***
+
+// Declare the SoftwareLanesScalar 'named structure' data type.
+struct SoftwareLanesScalar {
+	struct Type { float v[4]; };
+	static Type Set(float a, float b, float c, float d) { return { { a, b, c, d } }; }
+	static Type Splat(float a) { return { { a, a, a, a } }; }
+	static Type Load(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+	static void Store(float* p, Type a) { for (int k = 0; k < 4; k++) p[k] = a.v[k]; }
+	static Type Add(Type a, Type b) { for (int k = 0; k < 4; k++) a.v[k] += b.v[k]; return a; }
+	static Type Sub(Type a, Type b) { for (int k = 0; k < 4; k++) a.v[k] -= b.v[k]; return a; }
+	static Type Mul(Type a, Type b) { for (int k = 0; k < 4; k++) a.v[k] *= b.v[k]; return a; }
+	static Type Reciprocal(Type a) { for (int k = 0; k < 4; k++) a.v[k] = 1.0f / a.v[k]; return a; }
+	static int Greater(Type a, Type b) { int m = 0; for (int k = 0; k < 4; k++) m |= (a.v[k] > b.v[k]) << k; return m; }
+	static int GreaterEqual(Type a, Type b) { int m = 0; for (int k = 0; k < 4; k++) m |= (a.v[k] >= b.v[k]) << k; return m; }
+	static int Less(Type a, Type b) { int m = 0; for (int k = 0; k < 4; k++) m |= (a.v[k] < b.v[k]) << k; return m; }
+};
+
+#ifdef SOFTWARE_RASTERIZER_SSE
+// Declare the SoftwareLanesSse 'named structure' data type.
+struct SoftwareLanesSse {
+	typedef __m128 Type;
+	static Type Set(float a, float b, float c, float d) { return _mm_setr_ps(a, b, c, d); }
+	static Type Splat(float a) { return _mm_set1_ps(a); }
+	static Type Load(const float* p) { return _mm_loadu_ps(p); }
+	static void Store(float* p, Type a) { _mm_storeu_ps(p, a); }
+	static Type Add(Type a, Type b) { return _mm_add_ps(a, b); }
+	static Type Sub(Type a, Type b) { return _mm_sub_ps(a, b); }
+	static Type Mul(Type a, Type b) { return _mm_mul_ps(a, b); }
+	static Type Reciprocal(Type a) { return _mm_div_ps(_mm_set1_ps(1.0f), a); }	// A division, not _mm_rcp_ps, so the result is the same as SoftwareLanesScalar's.
+	static int Greater(Type a, Type b) { return _mm_movemask_ps(_mm_cmpgt_ps(a, b)); }
+	static int GreaterEqual(Type a, Type b) { return _mm_movemask_ps(_mm_cmpge_ps(a, b)); }
+	static int Less(Type a, Type b) { return _mm_movemask_ps(_mm_cmplt_ps(a, b)); }
+};
+#endif
+
+// End: SIMD Lanes.
+
+//***
+// Function Definitions.
+//***
+
+// SoftwarePackColor function: Definition
+//   This function converts a color (red, green, blue, alpha) to DXGI_FORMAT_R8G8B8A8_UNORM: each component is clamped between 0 and 1, scaled to 255, and rounded to the nearest integer.
+static inline unsigned int SoftwarePackColor(const float Color[4])
+{
+	unsigned int packed = 0;
+	for (int c = 0; c < 4; c++)
+	{
+		float component = Color[c] < 0.0f ? 0.0f : Color[c] > 1.0f ? 1.0f : Color[c];
+		packed |= (unsigned int)(component * 255.0f + 0.5f) << (c * 8);
+	}
+	return packed;
+}
+
+// SoftwareVertexShader function: Definition
+//   This function does what the VShaderVertex function does for one VERTEX structure of one instance: it transforms the geometric vertex by the instance's world matrix and then matViewProjection,
+//   and lights the vertex with the rotated vertex normal vector. The input-assembler stage expands the three-component position and vertex normal vector with a fourth component of 1.0.
+static void SoftwareVertexShader(const VERTEX& Vertex, const INSTANCEDATA& Instance, const SoftwareShaderConstants& Constants, SoftwareClipVertex& Output)
+{
+	const XMFLOAT3& p = Vertex.GeometricVertex;
+	float world[4];
+	for (int r = 0; r < 3; r++)
+		world[r] = Instance.World[r].x * p.x + Instance.World[r].y * p.y + Instance.World[r].z * p.z + Instance.World[r].w;
+	world[3] = 1.0f;
+	for (int c = 0; c < 4; c++)
+		Output.Position[c] = world[0] * Constants.matViewProjection.m[0][c] + world[1] * Constants.matViewProjection.m[1][c] + world[2] * Constants.matViewProjection.m[2][c] + world[3] * Constants.matViewProjection.m[3][c];
+
+	const XMFLOAT3& n = Vertex.VertexNormalVector;
+	float normal[4];
+	for (int r = 0; r < 3; r++)
+		normal[r] = Instance.Normal[r].x * n.x + Instance.Normal[r].y * n.y + Instance.Normal[r].z * n.z;
+	normal[3] = 1.0f;
+	float length = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2] + normal[3] * normal[3]);
+	float brightness = (normal[0] * Constants.LightVector.x + normal[1] * Constants.LightVector.y + normal[2] * Constants.LightVector.z + normal[3] * Constants.LightVector.w) / length;
+	brightness = brightness < 0.0f ? 0.0f : brightness > 1.0f ? 1.0f : brightness;
+
+	Output.Attributes[0] = Constants.AmbientColor.x + Constants.LightColor.x * brightness;
+	Output.Attributes[1] = Constants.AmbientColor.y + Constants.LightColor.y * brightness;
+	Output.Attributes[2] = Constants.AmbientColor.z + Constants.LightColor.z * brightness;
+	Output.Attributes[3] = Constants.AmbientColor.w + Constants.LightColor.w * brightness;
+	Output.Attributes[4] = Vertex.VertexTextureCoordinate.x;
+	Output.Attributes[5] = Vertex.VertexTextureCoordinate.y;
+}
+
+// SoftwareClipDistance function: Definition
+//   This function returns the signed distance of a clip-space position from clipping plane Plane (0 to 5), which is not negative inside the plane:
+//   0 <= z (the near plane), z <= w (the far plane), and the guard band planes -SoftwareGuardBand * w <= x, y <= SoftwareGuardBand * w.
+static inline float SoftwareClipDistance(const float Position[4], int Plane)
+{
+	switch (Plane)
+	{
+	case 0: return Position[2];
+	case 1: return Position[3] - Position[2];
+	case 2: return SoftwareGuardBand * Position[3] + Position[0];
+	case 3: return SoftwareGuardBand * Position[3] - Position[0];
+	case 4: return SoftwareGuardBand * Position[3] + Position[1];
+	default: return SoftwareGuardBand * Position[3] - Position[1];
+	}
+}
+
+// SoftwareClipPolygon function: Definition
+//   This function clips the convex polygon of VerticesTotal vertices in Polygon to every clipping plane (see the SoftwareClipDistance function), one plane at a time, and returns the number of vertices left (0 if the polygon is outside).
+//   Polygon and Scratch must have room for 9 vertices: each plane adds at most one vertex to a triangle.
+static int SoftwareClipPolygon(SoftwareClipVertex* Polygon, int VerticesTotal, SoftwareClipVertex* Scratch)
+{
+	for (int plane = 0; plane < 6 && VerticesTotal >= 3; plane++)
+	{
+		float distance[9];
+		bool outside = false;
+		for (int i = 0; i < VerticesTotal; i++)
+		{
+			distance[i] = SoftwareClipDistance(Polygon[i].Position, plane);
+			outside |= distance[i] < 0.0f;
+		}
+		if (!outside)
+			continue;
+
+		int clippedTotal = 0;
+		for (int i = 0; i < VerticesTotal; i++)
+		{
+			int j = (i + 1) % VerticesTotal;
+			if (distance[i] >= 0.0f)
+				Scratch[clippedTotal++] = Polygon[i];
+			if ((distance[i] >= 0.0f) != (distance[j] >= 0.0f))
+			{
+				// The edge from vertex i to vertex j crosses the plane. Add the vertex where it crosses.
+				float t = distance[i] / (distance[i] - distance[j]);
+				SoftwareClipVertex& crossing = Scratch[clippedTotal++];
+				for (int c = 0; c < 4; c++)
+					crossing.Position[c] = Polygon[i].Position[c] + (Polygon[j].Position[c] - Polygon[i].Position[c]) * t;
+				for (int a = 0; a < 6; a++)
+					crossing.Attributes[a] = Polygon[i].Attributes[a] + (Polygon[j].Attributes[a] - Polygon[i].Attributes[a]) * t;
+			}
+		}
+		for (int i = 0; i < clippedTotal; i++)
+			Polygon[i] = Scratch[i];
+		VerticesTotal = clippedTotal;
+	}
+	return VerticesTotal >= 3 ? VerticesTotal : 0;
+}
+
+// SoftwareSetupPolygon function: Definition
+//   This function projects the clipped polygon of VerticesTotal vertices to the render target, divides it into a fan of triangles, culls the triangles that face away (counterclockwise on the render target) or cover no area,
+//   and appends the others to Triangles, adding each to the bin (Bins) of each tile its bounding box overlaps.
+static void SoftwareSetupPolygon(const SoftwareRenderTarget& Target, const SoftwareClipVertex* Polygon, int VerticesTotal, vector<SoftwareBinnedTriangle>& Triangles, vector<vector<int>>& Bins)
+{
+	// Project each vertex to the viewport (0, 0) to (Width, Height), with y down, and snap it to 1/256 of a pixel.
+	float x[9], y[9], z[9], inverseW[9];
+	for (int i = 0; i < VerticesTotal; i++)
+	{
+		inverseW[i] = 1.0f / Polygon[i].Position[3];
+		float screenX = (Polygon[i].Position[0] * inverseW[i] * 0.5f + 0.5f) * Target.Width;
+		float screenY = (0.5f - Polygon[i].Position[1] * inverseW[i] * 0.5f) * Target.Height;
+		x[i] = floorf(screenX * SoftwareSubpixels + 0.5f) / SoftwareSubpixels;
+		y[i] = floorf(screenY * SoftwareSubpixels + 0.5f) / SoftwareSubpixels;
+		z[i] = Polygon[i].Position[2] * inverseW[i];
+	}
+
+	for (int k = 1; k + 1 < VerticesTotal; k++)
+	{
+		const int vertices[3] = { 0, k, k + 1 };
+		float area = (x[k] - x[0]) * (y[k + 1] - y[0]) - (y[k] - y[0]) * (x[k + 1] - x[0]);	// Twice the area, positive if the triangle is clockwise on the render target, i.e., a front face.
+		if (!(area > 0.0f))
+			continue;
+
+		SoftwareBinnedTriangle triangle;
+		float minimumX = x[0], maximumX = x[0], minimumY = y[0], maximumY = y[0];
+		for (int v = 0; v < 3; v++)
+		{
+			int i = vertices[v];
+			triangle.X[v] = x[i];
+			triangle.Y[v] = y[i];
+			triangle.Z[v] = z[i];
+			triangle.InverseW[v] = inverseW[i];
+			for (int a = 0; a < 6; a++)
+				triangle.Attributes[v][a] = Polygon[i].Attributes[a] * inverseW[i];
+			minimumX = min(minimumX, x[i]);
+			maximumX = max(maximumX, x[i]);
+			minimumY = min(minimumY, y[i]);
+			maximumY = max(maximumY, y[i]);
+		}
+		triangle.InverseArea = 1.0f / area;
+		triangle.MinimumX = max(0, (int)floorf(minimumX));
+		triangle.MinimumY = max(0, (int)floorf(minimumY));
+		triangle.MaximumX = min(Target.Width - 1, (int)floorf(maximumX));
+		triangle.MaximumY = min(Target.Height - 1, (int)floorf(maximumY));
+		if (triangle.MinimumX > triangle.MaximumX || triangle.MinimumY > triangle.MaximumY)
+			continue;										// The triangle is outside the render target.
+
+		int index = (int)Triangles.size();
+		Triangles.push_back(triangle);
+		for (int tileY = triangle.MinimumY / SOFTWARE_TILE_SIZE; tileY <= triangle.MaximumY / SOFTWARE_TILE_SIZE; tileY++)
+			for (int tileX = triangle.MinimumX / SOFTWARE_TILE_SIZE; tileX <= triangle.MaximumX / SOFTWARE_TILE_SIZE; tileX++)
+				Bins[tileY * Target.TilesX + tileX].push_back(index);
+	}
+}
+
+// SoftwareSetupEdge function: Definition
+//   This function sets up the edge function of the edge of a triangle from vertex (AX, AY) to vertex (BX, BY) (see the SoftwareEdge structure).
+//   A top edge is horizontal, with the triangle below it, and a left edge goes up the render target, with the triangle to its right, as the triangle is clockwise.
+static inline void SoftwareSetupEdge(float AX, float AY, float BX, float BY, SoftwareEdge& Edge)
+{
+	Edge.TopLeft = BY < AY || (BY == AY && BX > AX);
+	if (AX < BX || (AX == BX && AY < BY))
+	{
+		Edge.OriginX = AX, Edge.OriginY = AY, Edge.DeltaX = BX - AX, Edge.DeltaY = BY - AY, Edge.Sign = 1.0f;
+	}
+	else
+	{
+		Edge.OriginX = BX, Edge.OriginY = BY, Edge.DeltaX = AX - BX, Edge.DeltaY = AY - BY, Edge.Sign = -1.0f;
+	}
+}
+
+// SoftwareEvaluateEdge function: Definition
+//   This function returns the edge function of Edge at the four positions (X, Y), and sets Inside to the mask of the positions inside the edge.
+template <class L>
+static inline typename L::Type SoftwareEvaluateEdge(const SoftwareEdge& Edge, typename L::Type X, typename L::Type Y, int& Inside)
+{
+	typename L::Type value = L::Mul(L::Splat(Edge.Sign), L::Sub(L::Mul(L::Splat(Edge.DeltaX), L::Sub(Y, L::Splat(Edge.OriginY))), L::Mul(L::Splat(Edge.DeltaY), L::Sub(X, L::Splat(Edge.OriginX)))));
+	Inside = Edge.TopLeft ? L::GreaterEqual(value, L::Splat(0.0f)) : L::Greater(value, L::Splat(0.0f));
+	return value;
+}
+
+// SoftwareSampleTexture function: Definition
+//   This function does what Texture.Sample does with the default sampler state: it filters the four texels nearest the texture coordinates (U, V) bilinearly, with texture coordinates clamped to the edges of the texture image.
+//   It returns (0, 0, 0, 0) if there is no texture image, as a shader does when no texture is bound.
+static inline void SoftwareSampleTexture(const Image& Texture, float U, float V, float Result[4])
+{
+	if (Texture.Width == 0)
+	{
+		Result[0] = Result[1] = Result[2] = Result[3] = 0.0f;
+		return;
+	}
+
+	float x = U * Texture.Width - 0.5f, y = V * Texture.Height - 0.5f;
+	x = x < -1.0f ? -1.0f : x > (float)Texture.Width ? (float)Texture.Width : x;		// Clamp far outside coordinates before converting them to integers. The texels are clamped below.
+	y = y < -1.0f ? -1.0f : y > (float)Texture.Height ? (float)Texture.Height : y;
+	float floorX = floorf(x), floorY = floorf(y);
+	float fractionX = x - floorX, fractionY = y - floorY;
+	int x0 = max(0, min(Texture.Width - 1, (int)floorX)), x1 = max(0, min(Texture.Width - 1, (int)floorX + 1));
+	int y0 = max(0, min(Texture.Height - 1, (int)floorY)), y1 = max(0, min(Texture.Height - 1, (int)floorY + 1));
+	const unsigned char* t00 = &Texture.Pixels[((size_t)y0 * Texture.Width + x0) * 4];
+	const unsigned char* t10 = &Texture.Pixels[((size_t)y0 * Texture.Width + x1) * 4];
+	const unsigned char* t01 = &Texture.Pixels[((size_t)y1 * Texture.Width + x0) * 4];
+	const unsigned char* t11 = &Texture.Pixels[((size_t)y1 * Texture.Width + x1) * 4];
+	for (int c = 0; c < 4; c++)
+	{
+		float top = t00[c] + (t10[c] - t00[c]) * fractionX;
+		float bottom = t01[c] + (t11[c] - t01[c]) * fractionX;
+		Result[c] = (top + (bottom - top) * fractionY) * (1.0f / 255.0f);
+	}
+}
+
+// SoftwareRasterizeTriangle function: Definition
+//   This function rasterizes the part of a triangle inside the tile (TileMinimumX, TileMinimumY) to (TileMaximumX, TileMaximumY) (exclusive), one 2x2 pixel quad at a time.
+//   For each quad, it tests the coverage and depth of every sample, then interpolates the attributes of the quad's pixels at their centers (as the pixel shader inputs are interpolated without the centroid modifier),
+//   shades the pixels with a covered sample that passed the depth test as the PShader function does, and writes their color and depth to those samples.
+template <class L>
+static void SoftwareRasterizeTriangle(SoftwareRenderTarget& Target, const SoftwareBinnedTriangle& Triangle, int TileMinimumX, int TileMinimumY, int TileMaximumX, int TileMaximumY, const Image& Texture)
+{
+	typedef typename L::Type Lanes;
+
+	SoftwareEdge edges[3];									// Edge e is opposite vertex e, so its edge function is twice the area of the triangle at vertex e.
+	SoftwareSetupEdge(Triangle.X[1], Triangle.Y[1], Triangle.X[2], Triangle.Y[2], edges[0]);
+	SoftwareSetupEdge(Triangle.X[2], Triangle.Y[2], Triangle.X[0], Triangle.Y[0], edges[1]);
+	SoftwareSetupEdge(Triangle.X[0], Triangle.Y[0], Triangle.X[1], Triangle.Y[1], edges[2]);
+
+	int minimumX = max(TileMinimumX, Triangle.MinimumX) & ~1, maximumX = min(TileMaximumX - 1, Triangle.MaximumX);
+	int minimumY = max(TileMinimumY, Triangle.MinimumY) & ~1, maximumY = min(TileMaximumY - 1, Triangle.MaximumY);
+	int samples = Target.SampleCount;
+	Lanes inverseArea = L::Splat(Triangle.InverseArea);
+	Lanes quadX = L::Load(SoftwareQuadX), quadY = L::Load(SoftwareQuadY);
+	Lanes sampleX = L::Load(SoftwareSampleOffsetX), sampleY = L::Load(SoftwareSampleOffsetY);
+
+	for (int y = minimumY; y <= maximumY; y += 2)
+		for (int x = minimumX; x <= maximumX; x += 2)
+		{
+			// The lanes of the quad's pixels that are inside the tile (and the render target).
+			int inTile = (x + 1 < TileMaximumX ? 0xF : 0x5) & (y + 1 < TileMaximumY ? 0xF : 0x3);
+
+			// The edge functions at the centers of the quad's pixels.
+			Lanes centerX = L::Add(L::Splat(x + 0.5f), quadX), centerY = L::Add(L::Splat(y + 0.5f), quadY);
+			int inside0, inside1, inside2;
+			Lanes e0 = SoftwareEvaluateEdge<L>(edges[0], centerX, centerY, inside0);
+			Lanes e1 = SoftwareEvaluateEdge<L>(edges[1], centerX, centerY, inside1);
+			Lanes e2 = SoftwareEvaluateEdge<L>(edges[2], centerX, centerY, inside2);
+
+			// Test the coverage and depth of each sample. passed[k] is the mask of the samples of pixel k that are covered and pass the depth test, and depth[k] their depths.
+			int passed[4] = { 0, 0, 0, 0 };
+			float depth[4][4];
+			size_t pixelIndex[4];
+			for (int k = 0; k < 4; k++)
+				pixelIndex[k] = (size_t)min(y + (k >> 1), Target.Height - 1) * Target.Width + min(x + (k & 1), Target.Width - 1);
+			if (samples == 1)
+			{
+				int covered = inside0 & inside1 & inside2 & inTile;
+				if (covered == 0)
+					continue;
+				Lanes z = L::Mul(L::Add(L::Add(L::Mul(e0, L::Splat(Triangle.Z[0])), L::Mul(e1, L::Splat(Triangle.Z[1]))), L::Mul(e2, L::Splat(Triangle.Z[2]))), inverseArea);
+				Lanes stored = L::Set(Target.Depth[pixelIndex[0]], Target.Depth[pixelIndex[1]], Target.Depth[pixelIndex[2]], Target.Depth[pixelIndex[3]]);
+				int passing = covered & L::Less(z, stored);
+				float zLanes[4];
+				L::Store(zLanes, z);
+				for (int k = 0; k < 4; k++)
+				{
+					passed[k] = (passing >> k) & 1;
+					depth[k][0] = zLanes[k];
+				}
+			}
+			else
+			{
+				int any = 0;
+				for (int k = 0; k < 4; k++)
+				{
+					if (!((inTile >> k) & 1))
+						continue;
+					Lanes positionX = L::Add(L::Splat(x + (k & 1) + 0.5f), sampleX), positionY = L::Add(L::Splat(y + (k >> 1) + 0.5f), sampleY);
+					int sampleInside0, sampleInside1, sampleInside2;
+					Lanes s0 = SoftwareEvaluateEdge<L>(edges[0], positionX, positionY, sampleInside0);
+					Lanes s1 = SoftwareEvaluateEdge<L>(edges[1], positionX, positionY, sampleInside1);
+					Lanes s2 = SoftwareEvaluateEdge<L>(edges[2], positionX, positionY, sampleInside2);
+					int covered = sampleInside0 & sampleInside1 & sampleInside2;
+					if (covered == 0)
+						continue;
+					Lanes z = L::Mul(L::Add(L::Add(L::Mul(s0, L::Splat(Triangle.Z[0])), L::Mul(s1, L::Splat(Triangle.Z[1]))), L::Mul(s2, L::Splat(Triangle.Z[2]))), inverseArea);
+					passed[k] = covered & L::Less(z, L::Load(&Target.Depth[pixelIndex[k] * 4]));
+					L::Store(depth[k], z);
+					any |= passed[k];
+				}
+				if (any == 0)
+					continue;
+			}
+
+			// Interpolate the attributes at the centers of the quad's pixels, with perspective correction: each attribute divided by w, and 1 / w, are interpolated linearly on the render target.
+			Lanes b0 = L::Mul(e0, inverseArea), b1 = L::Mul(e1, inverseArea), b2 = L::Mul(e2, inverseArea);
+			Lanes w = L::Reciprocal(L::Add(L::Add(L::Mul(b0, L::Splat(Triangle.InverseW[0])), L::Mul(b1, L::Splat(Triangle.InverseW[1]))), L::Mul(b2, L::Splat(Triangle.InverseW[2]))));
+			float attributes[6][4];
+			for (int a = 0; a < 6; a++)
+			{
+				Lanes value = L::Add(L::Add(L::Mul(b0, L::Splat(Triangle.Attributes[0][a])), L::Mul(b1, L::Splat(Triangle.Attributes[1][a]))), L::Mul(b2, L::Splat(Triangle.Attributes[2][a])));
+				L::Store(attributes[a], L::Mul(value, w));
+			}
+
+			// Shade each pixel with a sample to write: color * Texture.Sample(ss, texcoord).
+			for (int k = 0; k < 4; k++)
+			{
+				if (passed[k] == 0)
+					continue;
+				float texel[4], color[4];
+				SoftwareSampleTexture(Texture, attributes[4][k], attributes[5][k], texel);
+				for (int c = 0; c < 4; c++)
+					color[c] = attributes[c][k] * texel[c];
+				unsigned int packed = SoftwarePackColor(color);
+				size_t first = pixelIndex[k] * samples;
+				for (int s = 0; s < samples; s++)
+					if ((passed[k] >> s) & 1)
+					{
+						Target.Color[first + s] = packed;
+						Target.Depth[first + s] = depth[k][s];
+					}
+			}
+		}
+}
+
+// SoftwareRasterizeTile function: Definition
+//   This function rasterizes every triangle binned to tile Tile, in drawing order, with the SSE or scalar rasterizer.
+static void SoftwareRasterizeTile(SoftwareRenderTarget& Target, int Tile, const Image& Texture)
+{
+	int tileMinimumX = (Tile % Target.TilesX) * SOFTWARE_TILE_SIZE, tileMinimumY = (Tile / Target.TilesX) * SOFTWARE_TILE_SIZE;
+	int tileMaximumX = min(tileMinimumX + SOFTWARE_TILE_SIZE, Target.Width), tileMaximumY = min(tileMinimumY + SOFTWARE_TILE_SIZE, Target.Height);
+	for (size_t job = 0; job < Target.Bins.size(); job++)
+		for (int triangle : Target.Bins[job][Tile])
+		{
+#ifdef SOFTWARE_RASTERIZER_SSE
+			if (SoftwareRasterizerSimdEnabled)
+			{
+				SoftwareRasterizeTriangle<SoftwareLanesSse>(Target, Target.Triangles[job][triangle], tileMinimumX, tileMinimumY, tileMaximumX, tileMaximumY, Texture);
+				continue;
+			}
+#endif
+			SoftwareRasterizeTriangle<SoftwareLanesScalar>(Target, Target.Triangles[job][triangle], tileMinimumX, tileMinimumY, tileMaximumX, tileMaximumY, Texture);
+		}
+}
+
+// CreateSoftwareRenderTarget function: Definition
+//   This function sets the size of Target and its number of samples per pixel (1, or 4; any other number is treated as 1), and allocates its samples. Their contents are undefined until Target is cleared.
+void CreateSoftwareRenderTarget(SoftwareRenderTarget& Target, int Width, int Height, int SampleCount)
+{
+	Target.Width = Width;
+	Target.Height = Height;
+	Target.SampleCount = SampleCount == 4 ? 4 : 1;
+	Target.Color.resize((size_t)Width * Height * Target.SampleCount);
+	Target.Depth.resize((size_t)Width * Height * Target.SampleCount);
+	Target.TilesX = (Width + SOFTWARE_TILE_SIZE - 1) / SOFTWARE_TILE_SIZE;
+	Target.TilesY = (Height + SOFTWARE_TILE_SIZE - 1) / SOFTWARE_TILE_SIZE;
+	Target.Triangles.clear();
+	Target.Bins.clear();
+}
+
+// ClearSoftwareRenderTarget function: Definition
+//   This function sets every sample of Target to Color and Depth. The rows are divided among the threads of the job system.
+void ClearSoftwareRenderTarget(SoftwareRenderTarget& Target, const float Color[4], float Depth)
+{
+	unsigned int packed = SoftwarePackColor(Color);
+	size_t rowSamples = (size_t)Target.Width * Target.SampleCount;
+	JobParallelFor(Target.Height, 16, [&](int Begin, int End)
+		{
+			std::fill(Target.Color.begin() + Begin * rowSamples, Target.Color.begin() + End * rowSamples, packed);
+			std::fill(Target.Depth.begin() + Begin * rowSamples, Target.Depth.begin() + End * rowSamples, Depth);
+		});
+}
+
+// DrawSoftware function: Definition
+//   This function draws Draws, in order, into Target: the triangles of each draw (IndicesTotal / 3 triangles of Indices from FirstIndex), once for each of its instances (Instances[FirstInstance] onward).
+//   The triangles of every draw and instance are set up in consecutive ranges, one range per triangle setup job, then each tile is rasterized by one job (see the description of these functions).
+void DrawSoftware(SoftwareRenderTarget& Target, const VERTEX* Vertices, const DWORD* Indices, const INSTANCEDATA* Instances, const SoftwareDraw* Draws, int DrawsTotal,
+	const SoftwareShaderConstants& Constants, const Image& Texture)
+{
+	// Number the triangles of every draw and instance, in drawing order: firstTriangle[d] is the number of the first triangle of draw d, whose instances are drawn one after another.
+	vector<long long> firstTriangle(DrawsTotal + 1, 0);
+	for (int d = 0; d < DrawsTotal; d++)
+		firstTriangle[d + 1] = firstTriangle[d] + (long long)(Draws[d].IndicesTotal / 3) * Draws[d].InstancesTotal;
+	long long trianglesTotal = firstTriangle[DrawsTotal];
+	if (trianglesTotal == 0)
+		return;
+
+	// 1. Triangle setup.
+	int tilesTotal = Target.TilesX * Target.TilesY;
+	int jobsTotal = (int)min<long long>(trianglesTotal, (long long)JobSystemThreadsTotal() * SoftwareSetupJobsPerThread);
+	Target.Triangles.resize(jobsTotal);
+	Target.Bins.resize(jobsTotal);
+	JobParallelFor(jobsTotal, 1, [&](int Begin, int End)
+		{
+			vector<SoftwareCachedVertex> cache(SoftwareVertexCacheSize);
+			for (int job = Begin; job < End; job++)
+			{
+				vector<SoftwareBinnedTriangle>& triangles = Target.Triangles[job];
+				vector<vector<int>>& bins = Target.Bins[job];
+				triangles.clear();
+				bins.resize(tilesTotal);
+				for (vector<int>& bin : bins)
+					bin.clear();
+				for (SoftwareCachedVertex& entry : cache)
+					entry.Vertex = -1;
+
+				long long first = trianglesTotal * job / jobsTotal, last = trianglesTotal * (job + 1) / jobsTotal;
+				int d = (int)(std::upper_bound(firstTriangle.begin(), firstTriangle.end(), first) - firstTriangle.begin()) - 1;
+				for (long long t = first; t < last; t++)
+				{
+					while (t >= firstTriangle[d + 1])
+						d++;
+					const SoftwareDraw& draw = Draws[d];
+					long long drawTriangle = t - firstTriangle[d];
+					int instance = draw.FirstInstance + (int)(drawTriangle / (draw.IndicesTotal / 3));
+					const DWORD* indices = Indices + draw.FirstIndex + (drawTriangle % (draw.IndicesTotal / 3)) * 3;
+
+					// Run the vertex shader for each vertex of the triangle that is not in the cache.
+					SoftwareClipVertex polygon[9], scratch[9];
+					for (int v = 0; v < 3; v++)
+					{
+						SoftwareCachedVertex& entry = cache[indices[v] % SoftwareVertexCacheSize];
+						if (entry.Vertex != (int)indices[v] || entry.Instance != instance)
+						{
+							entry.Vertex = (int)indices[v];
+							entry.Instance = instance;
+							SoftwareVertexShader(Vertices[indices[v]], Instances[instance], Constants, entry.Output);
+						}
+						polygon[v] = entry.Output;
+					}
+
+					int verticesTotal = SoftwareClipPolygon(polygon, 3, scratch);
+					if (verticesTotal > 0)
+						SoftwareSetupPolygon(Target, polygon, verticesTotal, triangles, bins);
+				}
+			}
+		});
+
+	// 2. Rasterization.
+	JobParallelFor(tilesTotal, 1, [&](int Begin, int End)
+		{
+			for (int tile = Begin; tile < End; tile++)
+				SoftwareRasterizeTile(Target, tile, Texture);
+		});
+}
+
+// ResolveSoftwareRenderTarget function: Definition
+//   This function averages the samples of each pixel of Target, one component at a time, rounding to the nearest integer, into Result. The rows are divided among the threads of the job system.
+void ResolveSoftwareRenderTarget(const SoftwareRenderTarget& Target, Image& Result)
+{
+	Result.Width = Target.Width;
+	Result.Height = Target.Height;
+	Result.Pixels.resize((size_t)Target.Width * Target.Height * 4);
+	unsigned char* pixels = Result.Pixels.data();			// Four 8-bit components per pixel, in the same order as the samples of Target.
+	const unsigned int* color = Target.Color.data();
+	JobParallelFor(Target.Height, 16, [&](int Begin, int End)
+		{
+			size_t first = (size_t)Begin * Target.Width, last = (size_t)End * Target.Width;
+			if (Target.SampleCount == 1)
+			{
+				memcpy(pixels + first * 4, color + first, (last - first) * 4);
+				return;
+			}
+
+			// Sum the red and blue components, and the green and alpha components, of the 4 samples two at a time, each in 16 bits of a 32-bit integer (4 x 255 fits in 10 bits).
+			for (size_t p = first; p < last; p++)
+			{
+				const unsigned int* s = color + p * 4;
+				unsigned int redBlue = (s[0] & 0x00FF00FF) + (s[1] & 0x00FF00FF) + (s[2] & 0x00FF00FF) + (s[3] & 0x00FF00FF) + 0x00020002;
+				unsigned int greenAlpha = ((s[0] >> 8) & 0x00FF00FF) + ((s[1] >> 8) & 0x00FF00FF) + ((s[2] >> 8) & 0x00FF00FF) + ((s[3] >> 8) & 0x00FF00FF) + 0x00020002;
+				unsigned int average = ((redBlue >> 2) & 0x00FF00FF) | (((greenAlpha >> 2) & 0x00FF00FF) << 8);
+				memcpy(pixels + p * 4, &average, 4);
+			}
+		});
+}
+
+// BenchmarkSoftwareRasterizer function: Definition
+//   This function renders Frames frames, each cleared to the color and depth the RenderFrame function clears to, drawn, and resolved into Result, and returns the number of frames rendered per second.
+double BenchmarkSoftwareRasterizer(SoftwareRenderTarget& Target, const VERTEX* Vertices, const DWORD* Indices, const INSTANCEDATA* Instances, const SoftwareDraw* Draws, int DrawsTotal,
+	const SoftwareShaderConstants& Constants, const Image& Texture, int Frames, Image& Result)
+{
+	const float color[4] = { 0.0f, 0.2f, 0.4f, 1.0f };
+	auto start = std::chrono::steady_clock::now();
+	for (int frame = 0; frame < Frames; frame++)
+	{
+		ClearSoftwareRenderTarget(Target, color, 1.0f);
+		DrawSoftware(Target, Vertices, Indices, Instances, Draws, DrawsTotal, Constants, Texture);
+		ResolveSoftwareRenderTarget(Target, Result);
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return seconds > 0.0 ? Frames / seconds : 0.0;
+}
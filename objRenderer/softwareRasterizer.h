@@ -0,0 +1,115 @@
+// softwareRasterizer Header File
+// Version 3.1
+//
+// Description
+// Software rasterizer Header File
+// This header file contains the declarations used to render the object on the CPU, without Direct3D: the same VERTEX structures, indices, INSTANCEDATA structures, and constant buffer contents that the objRenderer program draws
+// with DrawIndexedInstanced calls are transformed and lit as the VShader function does, rasterized into a render target with a 32-bit floating-point depth buffer and optionally 4 samples per pixel, and textured as the PShader function does (see shaders.hlsl).
+// The frames it renders can be written to an image file (see imageFile.h), so frames can be rendered, timed, and compared on computers without a Direct3D device.
+// None of these functions use Direct3D. Include it in all source files that render with the software rasterizer, e.g., the objRenderer program.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Batch instance transform Header File.
+// Declares the INSTANCEDATA structure, and includes the Wavefront .obj file I/O Header File (the VERTEX structure, the DWORD data type, the DirectXMath Header File, and the Vector Container Class).
+#include "batchTransform.h"
+
+// Image file I/O Header File.
+// Declares the Image structure, used for the texture image and the rendered frame.
+#include "imageFile.h"
+
+// Defines.
+// The width and height, in pixels, of the tiles of the render target. Each tile is rasterized by one job, with the triangles that overlap it.
+#define SOFTWARE_TILE_SIZE 64
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the SoftwareShaderConstants 'named structure' data type.
+// The members of the C++ constant buffer structure (see objRenderer.cpp) that the VShader function reads, i.e., the HLSL constant buffer of a frame drawn with VERTEX structures.
+struct SoftwareShaderConstants {
+	XMFLOAT4X4 matViewProjection;							// The combined view and projection matrix, as stored in the C++ constant buffer structure.
+	XMFLOAT4 LightVector;									// Directional light's direction.
+	XMFLOAT4 LightColor;									// Directional light's color.
+	XMFLOAT4 AmbientColor;									// Ambient     light's color.
+};
+
+// Declare the SoftwareDraw 'named structure' data type.
+// The parameters of one DrawIndexedInstanced call: IndicesTotal indices from FirstIndex, drawn once for each of InstancesTotal INSTANCEDATA structures from FirstInstance.
+struct SoftwareDraw {
+	int IndicesTotal;										// Number of indices to draw per instance.
+	int FirstIndex;											// The location of the first index.
+	int InstancesTotal;										// Number of instances to draw.
+	int FirstInstance;										// The location of the first INSTANCEDATA structure.
+};
+
+// Declare the SoftwareBinnedTriangle 'named structure' data type.
+// One triangle after clipping and triangle setup, ready to be rasterized into the tiles it overlaps. Its vertices are in front-facing (clockwise) order.
+struct SoftwareBinnedTriangle {
+	float X[3], Y[3];										// The position of each vertex in the render target, in pixels, snapped to 1/256 of a pixel.
+	float Z[3];												// The depth of each vertex (z / w).
+	float InverseW[3];										// 1 / w of each vertex, used to interpolate the attributes with perspective correction.
+	float Attributes[3][6];									// The color (red, green, blue, alpha) and texture coordinates (u, v) of each vertex, divided by w.
+	float InverseArea;										// 1 / twice the area of the triangle, in pixels.
+	int MinimumX, MinimumY, MaximumX, MaximumY;				// The pixels covered by the bounding box of the triangle, within the render target.
+};
+
+// Declare the SoftwareRenderTarget 'named structure' data type.
+// A render target and depth buffer of Width x Height pixels, each with SampleCount samples (1, or 4 as the swap chain is created with). The samples of pixel (x, y) are at (y * Width + x) * SampleCount.
+// The remaining members hold the triangles of the frame being drawn, binned by tile, and are kept between frames so they are not allocated again.
+struct SoftwareRenderTarget {
+	int Width = 0;
+	int Height = 0;
+	int SampleCount = 1;
+	std::vector<unsigned int> Color;						// The color of each sample, as four 8-bit components: red (least significant byte), green, blue, and alpha, i.e., DXGI_FORMAT_R8G8B8A8_UNORM.
+	std::vector<float> Depth;								// The depth of each sample, i.e., DXGI_FORMAT_D32_FLOAT.
+
+	int TilesX = 0, TilesY = 0;								// The number of tiles across and down the render target.
+	std::vector<std::vector<SoftwareBinnedTriangle>> Triangles;	// The triangles set up by each triangle setup job.
+	std::vector<std::vector<std::vector<int>>> Bins;		// Bins[j][t] lists the triangles of Triangles[j] that overlap tile t, in drawing order.
+};
+
+// End: Structure Declarations.
+
+//***
+// External Variable Global Declarations.
+//***
+
+// SoftwareRasterizerEnabled selects whether the objRenderer program also renders each frame with the software rasterizer. It is false by default.
+// When it is true, the first frame is written to SoftwareRasterizerFileName (a .bmp file, "objRenderer.bmp" by default), so it can be compared with the frame drawn by Direct3D.
+extern bool SoftwareRasterizerEnabled;
+extern const char* SoftwareRasterizerFileName;
+//
+// SoftwareRasterizerSimdEnabled selects whether the edge functions, depths, and attributes of four samples or pixels are found at a time with SSE instructions. It is true by default.
+// When it is false, or the processor is not an x86 or x64 processor, they are found one at a time. The rendered frames are the same either way.
+extern bool SoftwareRasterizerSimdEnabled;
+
+// End: External Variable Global Declarations.
+
+//***
+// Global Function Declarations.
+//***
+
+void CreateSoftwareRenderTarget(SoftwareRenderTarget& Target, int Width, int Height, int SampleCount);																// The CreateSoftwareRenderTarget function sets the size of Target, and the number of samples per pixel (1 or 4).
+void ClearSoftwareRenderTarget(SoftwareRenderTarget& Target, const float Color[4], float Depth);																		// The ClearSoftwareRenderTarget function sets every sample of Target to Color (red, green, blue, alpha) and Depth, as ClearRenderTargetView and ClearDepthStencilView do.
+void DrawSoftware(SoftwareRenderTarget& Target, const VERTEX* Vertices, const DWORD* Indices, const INSTANCEDATA* Instances, const SoftwareDraw* Draws, int DrawsTotal,
+	const SoftwareShaderConstants& Constants, const Image& Texture);																								// The DrawSoftware function draws Draws, in order, into Target, as the VShader and PShader functions would with the same buffers, constants, and texture image.
+void ResolveSoftwareRenderTarget(const SoftwareRenderTarget& Target, Image& Result);																					// The ResolveSoftwareRenderTarget function averages the samples of each pixel of Target into Result, as a multisampled swap chain is resolved when it is presented.
+double BenchmarkSoftwareRasterizer(SoftwareRenderTarget& Target, const VERTEX* Vertices, const DWORD* Indices, const INSTANCEDATA* Instances, const SoftwareDraw* Draws, int DrawsTotal,
+	const SoftwareShaderConstants& Constants, const Image& Texture, int Frames, Image& Result);																		// The BenchmarkSoftwareRasterizer function clears, draws, and resolves Frames frames into Target and Result, and returns the number of frames per second.
+
+// End: Global Function Declarations.
+
+// End: Global Declarations.
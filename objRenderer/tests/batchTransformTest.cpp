@@ -0,0 +1,151 @@
+// batchTransformTest
+// Version 3.1
+//
+// Description
+// Tests that the TransformInstances function fills the same INSTANCEDATA structures, to within rounding, with its SIMD path (SSE, and AVX2 when the test is compiled for it) and without it,
+// as the world matrix built with DirectXMath matrix functions (InstanceWorldMatrix): scaling, then XMMatrixRotationQuaternion, then translation.
+// Numbers of instances that are not a multiple of 8 or 4 are used, so the instances left over after the last group of eight or four are also tested, as are instances given in any order (the Instances array).
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Test check Header File.
+#include "testCheck.h"
+
+// Batch instance transform Header File.
+#include "batchTransform.h"
+
+// Job system Header File.
+#include "jobSystem.h"
+
+// Mathematical Functions.
+#include <cmath>											// Mathematical functions sqrt, fabs.
+
+// Random Number Generation.
+#include <random>											// Mersenne twister engine, uniform distribution.
+
+// Algorithm Functions.
+#include <algorithm>										// Algorithm function shuffle.
+
+// Using Declarations and Directives.
+using std::vector;
+using std::sqrt;
+using std::fabs;
+
+// The largest difference allowed between a transformed element and the DirectXMath element, relative to the largest scale and position of the instances (see TestTransforms).
+// The SIMD path computes the rotation matrix with the same operations as XMMatrixRotationQuaternion, but in a different order, so the results differ by a few units in the last place.
+static const float TestTolerance = 1.0e-6f;
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// Fill Transforms with InstancesTotal random instances: unit rotation quaternions, positions from -100 to 100, and scales from 0.1 to 10.
+static void TestTransforms(InstanceTransformArrays& Transforms, int InstancesTotal, unsigned int Seed)
+{
+	std::mt19937 random(Seed);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	ResizeInstanceTransforms(Transforms, InstancesTotal);
+	for (int i = 0; i < InstancesTotal; i++)
+	{
+		InstanceTransform transform;
+		float x = unit(random), y = unit(random), z = unit(random), w = unit(random);
+		float length = sqrt(x * x + y * y + z * z + w * w);
+		if (length < 1.0e-3f)
+			x = 1.0f, length = sqrt(x * x + y * y + z * z + w * w);
+		transform.Rotation = XMFLOAT4(x / length, y / length, z / length, w / length);
+		transform.Position = XMFLOAT3(unit(random) * 100.0f, unit(random) * 100.0f, unit(random) * 100.0f);
+		transform.Scale = 0.1f + (unit(random) + 1.0f) * 4.95f;
+		SetInstanceTransform(Transforms, i, transform);
+	}
+}
+
+// Return the largest difference between Result and the INSTANCEDATA structure built from the DirectXMath world matrix of Transform.
+// Each row of INSTANCEDATA.World is a column of the world matrix, and each row of INSTANCEDATA.Normal is a column of the rotation matrix alone, with a fourth component of 0.
+static float TestDifference(const InstanceTransform& Transform, const INSTANCEDATA& Result)
+{
+	XMFLOAT4X4 world, rotation;
+	XMStoreFloat4x4(&world, InstanceWorldMatrix(Transform));
+	InstanceTransform rotationOnly;
+	rotationOnly.Rotation = Transform.Rotation;
+	XMStoreFloat4x4(&rotation, InstanceWorldMatrix(rotationOnly));
+
+	float difference = 0.0f;
+	for (int row = 0; row < 3; row++)
+	{
+		const float world4[4] = { Result.World[row].x, Result.World[row].y, Result.World[row].z, Result.World[row].w };
+		const float normal4[4] = { Result.Normal[row].x, Result.Normal[row].y, Result.Normal[row].z, Result.Normal[row].w };
+		for (int column = 0; column < 4; column++)
+		{
+			difference = std::max(difference, fabs(world4[column] - world.m[column][row]));
+			difference = std::max(difference, fabs(normal4[column] - (column < 3 ? rotation.m[column][row] : 0.0f)));
+		}
+	}
+	return difference;
+}
+
+// Transform every instance of Transforms, or the instances of Instances if not nullptr, with the SIMD path enabled or not, and check every result against DirectXMath.
+static void TestPath(const InstanceTransformArrays& Transforms, const vector<int>* Instances, int InstancesTotal, bool SimdEnabled)
+{
+	BatchTransformSimdEnabled = SimdEnabled;
+	vector<INSTANCEDATA> result(InstancesTotal);
+	TransformInstances(Transforms, Instances != nullptr ? Instances->data() : nullptr, InstancesTotal, result.data());
+
+	float largest = 0.0f;
+	for (int i = 0; i < InstancesTotal; i++)
+		largest = std::max(largest, TestDifference(GetInstanceTransform(Transforms, Instances != nullptr ? (*Instances)[i] : i), result[i]));
+	printf("%s path, %d instances%s: largest difference %g\n", SimdEnabled ? "SIMD" : "DirectXMath", InstancesTotal, Instances != nullptr ? " (shuffled)" : "", largest);
+	CHECK(largest <= TestTolerance * 100.0f);				// The largest position is 100.
+}
+
+// main function: Definition
+int main()
+{
+#ifdef __AVX2__
+	printf("Compiled for AVX2: eight instances at a time.\n");
+#else
+	printf("Compiled without AVX2: four instances at a time with SSE, where available.\n");
+#endif
+
+	// Fewer instances than BatchTransformParallelMinimum are transformed by the calling thread; more are divided among the job system's threads.
+	for (int instancesTotal : { 1, 7, 13, 4099, 20011 })
+	{
+		InstanceTransformArrays transforms;
+		TestTransforms(transforms, instancesTotal, 1u + (unsigned int)instancesTotal);
+		TestPath(transforms, nullptr, instancesTotal, true);
+		TestPath(transforms, nullptr, instancesTotal, false);
+
+		// A subset of the instances, in random order, as the objRenderer program writes the instances that are not culled, grouped by level of detail.
+		vector<int> instances(instancesTotal);
+		for (int i = 0; i < instancesTotal; i++)
+			instances[i] = i;
+		std::shuffle(instances.begin(), instances.end(), std::mt19937(7));
+		instances.resize(instancesTotal / 2 + 1);
+		TestPath(transforms, &instances, (int)instances.size(), true);
+	}
+
+	// The default instance is the identity.
+	InstanceTransformArrays identity;
+	ResizeInstanceTransforms(identity, 9);
+	vector<INSTANCEDATA> result(9);
+	BatchTransformSimdEnabled = true;
+	TransformInstances(identity, nullptr, 9, result.data());
+	bool isIdentity = true;
+	for (const INSTANCEDATA& data : result)
+	{
+		isIdentity = isIdentity && data.World[0].x == 1.0f && data.World[1].y == 1.0f && data.World[2].z == 1.0f && data.World[0].w == 0.0f && data.World[1].w == 0.0f && data.World[2].w == 0.0f;
+		isIdentity = isIdentity && data.World[0].y == 0.0f && data.World[0].z == 0.0f && data.World[1].x == 0.0f && data.World[1].z == 0.0f && data.World[2].x == 0.0f && data.World[2].y == 0.0f;
+	}
+	CHECK(isIdentity);
+
+	JobSystemShutdown();
+	return TestResult();
+}
+
+// End: Function Definitions.
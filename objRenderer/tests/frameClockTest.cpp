@@ -0,0 +1,169 @@
+// frameClockTest
+// Version 3.1
+//
+// Description
+// Tests the frame clock with a mock clock, i.e., times chosen by the test and passed as the Now parameter instead of read from the FrameClockNow function, so the results do not depend on how fast the test runs:
+// the time between frames accumulates into fixed timesteps, so the same number of timesteps is simulated whatever the frame rate, with less than one timestep left over (Alpha);
+// a gap between frames longer than FRAME_CLOCK_MAXIMUM_ELAPSED (250 ms) is clamped to it, and the rest dropped; a clock that goes backwards simulates nothing;
+// and a capped frame rate schedules each frame one frame interval after the previous one, restarting the schedule instead of catching up when a frame is late.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Test check Header File.
+#include "testCheck.h"
+
+// Frame clock Header File.
+#include "frameClock.h"
+
+// The number of nanoseconds in a millisecond and in a second.
+static const long long TestMillisecond = 1000000LL;
+static const long long TestSecond = 1000000000LL;
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// Start frames every FrameNanoseconds for Seconds seconds with a mock clock, and check that every timestep of the time elapsed is simulated, whatever the frame rate, with less than one timestep left over each frame.
+static void TestAccumulation(int StepsPerSecond, long long FrameNanoseconds, long long Seconds)
+{
+	FrameClock clock;
+	CreateFrameClock(clock, StepsPerSecond, 0);
+	long long now = 5 * TestSecond;						// The mock clock need not start at 0.
+	CHECK(FrameClockBeginFrame(clock, now) == 0);			// The first frame simulates nothing.
+	CHECK(clock.Alpha == 0.0f);
+
+	long long start = now;
+	unsigned long long steps = 0;
+	bool leftOver = true;
+	while (now - start < Seconds * TestSecond)
+	{
+		now += FrameNanoseconds;
+		steps += (unsigned long long)FrameClockBeginFrame(clock, now);
+		leftOver = leftOver && clock.Accumulator >= 0 && clock.Accumulator < clock.StepNanoseconds && clock.Alpha >= 0.0f && clock.Alpha < 1.0f &&
+			clock.Alpha == (float)((double)clock.Accumulator / (double)clock.StepNanoseconds);
+	}
+	CHECK(leftOver);
+	CHECK(steps == clock.Steps);
+	if (!CHECK(clock.Steps == (unsigned long long)((now - start) / clock.StepNanoseconds)) || !CHECK(clock.Accumulator == (now - start) % clock.StepNanoseconds))
+		printf("%d steps per second, a frame every %lld ns: %llu steps in %lld ns.\n", StepsPerSecond, FrameNanoseconds, clock.Steps, now - start);
+	CHECK(clock.DroppedNanoseconds == 0);
+}
+
+// A gap between two frames longer than FRAME_CLOCK_MAXIMUM_ELAPSED simulates only FRAME_CLOCK_MAXIMUM_ELAPSED, and drops the rest. A gap of exactly FRAME_CLOCK_MAXIMUM_ELAPSED drops nothing.
+static void TestClamp()
+{
+	FrameClock clock;
+	CreateFrameClock(clock, 120, 60);
+	long long step = clock.StepNanoseconds;					// 8333333 ns.
+	FrameClockBeginFrame(clock, 0);
+
+	int steps = FrameClockBeginFrame(clock, FRAME_CLOCK_MAXIMUM_ELAPSED);
+	CHECK(steps == (int)(FRAME_CLOCK_MAXIMUM_ELAPSED / step));
+	CHECK(clock.DroppedNanoseconds == 0);
+	long long accumulator = clock.Accumulator;
+
+	// A frame five seconds later, e.g., after the window was dragged.
+	long long now = FRAME_CLOCK_MAXIMUM_ELAPSED + 5 * TestSecond;
+	steps = FrameClockBeginFrame(clock, now);
+	CHECK(steps == (int)((accumulator + FRAME_CLOCK_MAXIMUM_ELAPSED) / step));
+	CHECK(steps <= 31);										// Never hundreds of timesteps in one frame.
+	CHECK(clock.DroppedNanoseconds == 5 * TestSecond - FRAME_CLOCK_MAXIMUM_ELAPSED);
+	CHECK(clock.Accumulator == (accumulator + FRAME_CLOCK_MAXIMUM_ELAPSED) % step);
+
+	// One nanosecond more than FRAME_CLOCK_MAXIMUM_ELAPSED drops one nanosecond.
+	long long dropped = clock.DroppedNanoseconds;
+	now += FRAME_CLOCK_MAXIMUM_ELAPSED + 1;
+	FrameClockBeginFrame(clock, now);
+	CHECK(clock.DroppedNanoseconds == dropped + 1);
+
+	// A clock that goes backwards simulates nothing, and leaves the time not yet simulated unchanged; the next frame measures from the earlier time.
+	accumulator = clock.Accumulator;
+	CHECK(FrameClockBeginFrame(clock, now - 10 * TestMillisecond) == 0);
+	CHECK(clock.Accumulator == accumulator && clock.DroppedNanoseconds == dropped + 1);
+	steps = FrameClockBeginFrame(clock, now - 10 * TestMillisecond + step);
+	CHECK(steps == 1 && clock.Accumulator == accumulator);
+}
+
+// With the frame rate capped at 60 frames per second, the next frame may start one frame interval after the previous one was scheduled, even if the previous one started a little late,
+// and a frame more than a whole interval late restarts the schedule from when it started.
+static void TestFrameRateLimit()
+{
+	FrameClock clock;
+	CreateFrameClock(clock, 120, 60);
+	long long interval = clock.FrameNanoseconds;			// 16666666 ns.
+	CHECK(FrameClockWaitTime(clock, 0) == 0);				// The first frame may always start at once.
+	FrameClockBeginFrame(clock, 0);
+	CHECK(FrameClockWaitTime(clock, 0) == interval);
+	CHECK(FrameClockWaitTime(clock, 10 * TestMillisecond) == interval - 10 * TestMillisecond);
+	CHECK(FrameClockWaitTime(clock, interval) == 0);
+
+	// The second frame starts 2 ms late; the third is still scheduled two intervals after the first.
+	FrameClockBeginFrame(clock, interval + 2 * TestMillisecond);
+	CHECK(FrameClockWaitTime(clock, interval + 2 * TestMillisecond) == interval - 2 * TestMillisecond);
+
+	// The third frame starts 40 ms late, more than a whole interval: the fourth is scheduled one interval after the third started, not at once.
+	long long late = 2 * interval + 40 * TestMillisecond;
+	FrameClockBeginFrame(clock, late);
+	CHECK(FrameClockWaitTime(clock, late) == interval);
+
+	// Without a frame rate limit, a frame may always start at once.
+	CreateFrameClock(clock, 120, 0);
+	FrameClockBeginFrame(clock, 0);
+	CHECK(FrameClockWaitTime(clock, 0) == 0);
+}
+
+// A render loop with the mock clock, rendering each frame in RenderNanoseconds and waiting (in whole milliseconds, as the objRenderer program sleeps) for the frame rate limit:
+// the simulation advances at StepsPerSecond timesteps per second, whatever the frame rate, and no faster than FramesPerSecond frames are started.
+static void TestRenderLoop(int FramesPerSecond, long long RenderNanoseconds)
+{
+	FrameClock clock;
+	CreateFrameClock(clock, 120, FramesPerSecond);
+	long long now = 0;
+	while (now < 10 * TestSecond)
+	{
+		long long wait = FrameClockWaitTime(clock, now);
+		if (wait > 0)
+		{
+			now += wait >= TestMillisecond ? wait / TestMillisecond * TestMillisecond : wait;
+			continue;
+		}
+		FrameClockBeginFrame(clock, now);
+		now += RenderNanoseconds;
+	}
+	double framesPerSecond = (clock.Frames - 1) / 10.0;		// The frames after the first, which starts at 0.
+	printf("Frame rate limit %d, %lld ms per frame: %.1f frames per second, %llu timesteps.\n", FramesPerSecond, RenderNanoseconds / TestMillisecond, framesPerSecond, clock.Steps);
+	CHECK(clock.Steps + 1 >= 1195 && clock.Steps <= 1200);	// 120 timesteps per second for 10 seconds, less the time after the last frame started.
+	if (FramesPerSecond > 0)
+		CHECK(framesPerSecond <= FramesPerSecond);
+	double expected = (double)TestSecond / RenderNanoseconds;
+	if (FramesPerSecond > 0 && expected > FramesPerSecond)
+		expected = FramesPerSecond;
+	CHECK(framesPerSecond > expected * 0.9);
+}
+
+// main function: Definition
+int main()
+{
+	const int stepsPerSecond[] = { 60, 120, 1000 };
+	const long long frameNanoseconds[] = { TestMillisecond, 3 * TestMillisecond, 8333333LL, 16666667LL, 33 * TestMillisecond, FRAME_CLOCK_MAXIMUM_ELAPSED - 1 };
+	for (int steps : stepsPerSecond)
+		for (long long frame : frameNanoseconds)
+			TestAccumulation(steps, frame, 10);
+	TestClamp();
+	TestFrameRateLimit();
+	const int framesPerSecond[] = { 0, 60, 144 };
+	const long long renderNanoseconds[] = { TestMillisecond, 3 * TestMillisecond, 20 * TestMillisecond };
+	for (int frames : framesPerSecond)
+		for (long long render : renderNanoseconds)
+			TestRenderLoop(frames, render);
+	return TestResult();
+}
+
+// End: Function Definitions.
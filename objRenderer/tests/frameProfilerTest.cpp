@@ -0,0 +1,265 @@
+// frameProfilerTest
+// Version 3.1
+//
+// Description
+// Tests the frame profiler without a device: known times are recorded for each stage, and the GetProfileStatistics function must report their number, mean, nearest-rank 50th, 95th, and 99th percentiles, and maximum,
+// for the most recent FRAME_PROFILER_SAMPLES samples only, without mixing the stages, while several threads record at once. The .csv and .json files hold the same statistics.
+// It also measures what timing every stage of a frame costs with the PROFILE_FRAME, PROFILE_BEGIN, and PROFILE_END macros, and checks that it is under 1% of a frame of 1 millisecond (1000 frames per second).
+// CMakeLists.txt also builds it with FRAME_PROFILER_ENABLED defined as 0 (frameProfilerCompiledOutTest), in which the macros must record nothing, even with FrameProfilerEnabled true.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Test check Header File.
+#include "testCheck.h"
+
+// Frame profiler Header File.
+#include "frameProfiler.h"
+
+// Standard Encapsulated Data and Functions for Manipulating String Data.
+#include <string>											// String class, used to read the .csv and .json files.
+
+// File Stream Functions.
+#include <fstream>											// File stream class, used to read the .csv and .json files.
+#include <sstream>											// String stream class, used to read a whole file.
+
+// Vector Container Class.
+#include <vector>											// Vector class, used to hold the times recorded and the threads.
+
+// Random Number Generation.
+#include <random>											// Mersenne twister engine, shuffle.
+
+// Algorithms.
+#include <algorithm>										// Algorithm shuffle.
+
+// Thread Functions.
+#include <thread>											// Thread class, used to record from several threads at once, and function sleep_for.
+
+// Steady Clock.
+#include <chrono>											// Duration class milliseconds, used to time a stage.
+
+// File System Functions.
+#include <filesystem>										// File system function remove.
+
+// Using Declarations and Directives.
+using std::vector;
+using std::string;
+namespace fs = std::filesystem;
+
+// The files the statistics are written to, in the current directory, named after the test, so both builds of it can run at the same time.
+#if FRAME_PROFILER_ENABLED
+static const char* const TestCsvFileName = "frameProfilerTest.csv";
+static const char* const TestJsonFileName = "frameProfilerTest.json";
+#else
+static const char* const TestCsvFileName = "frameProfilerCompiledOutTest.csv";
+static const char* const TestJsonFileName = "frameProfilerCompiledOutTest.json";
+#endif
+
+// The frame time the cost of timing every stage of a frame is compared with, in nanoseconds, and the fraction of it that cost must stay under.
+static const double TestFrameNanoseconds = 1.0e6;
+static const double TestOverheadFraction = 0.01;
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// Return true if Statistics holds Samples samples with these statistics, in milliseconds, and print them if not.
+static bool SameStatistics(const ProfileStatistics& Statistics, unsigned int Samples, double Mean, double P50, double P95, double P99, double Maximum)
+{
+	bool same = Statistics.Samples == Samples && Statistics.Mean == Mean && Statistics.P50 == P50 && Statistics.P95 == P95 && Statistics.P99 == P99 && Statistics.Maximum == Maximum;
+	if (!same)
+		printf("Samples %u, mean %g, 50th %g, 95th %g, 99th %g, maximum %g; expected %u, %g, %g, %g, %g, %g\n", Statistics.Samples, Statistics.Mean, Statistics.P50, Statistics.P95, Statistics.P99, Statistics.Maximum,
+			Samples, Mean, P50, P95, P99, Maximum);
+	return same;
+}
+
+// Return the contents of the file FileName.
+static string ReadFile(const char* FileName)
+{
+	std::ifstream file(FileName);
+	std::stringstream text;
+	text << file.rdbuf();
+	return text.str();
+}
+
+// Known times, recorded in random order and interleaved with another stage's, are reported as their nearest-rank percentiles, and written to the .csv and .json files.
+static void TestPercentiles()
+{
+	ProfilerReset();
+
+	// The Draw stage takes 1 to 100 milliseconds, once each, in random order; the Clear stage takes 2 milliseconds 34 times, between them.
+	vector<long long> times;
+	for (long long t = 1; t <= 100; t++)
+		times.push_back(t * 1000000);
+	std::mt19937 random(19);
+	std::shuffle(times.begin(), times.end(), random);
+	for (size_t i = 0; i < times.size(); i++)
+	{
+		ProfilerRecord(PROFILE_STAGE_DRAW, i, times[i]);
+		if (i % 3 == 0)
+			ProfilerRecord(PROFILE_STAGE_CLEAR, i, 2000000);
+	}
+
+	ProfileStatistics statistics;
+	GetProfileStatistics(PROFILE_STAGE_DRAW, statistics);
+	CHECK(SameStatistics(statistics, 100, 50.5, 50.0, 95.0, 99.0, 100.0));	// The 50th percentile of 100 samples is the 50th smallest, the 95th the 95th smallest, and so on.
+	GetProfileStatistics(PROFILE_STAGE_CLEAR, statistics);
+	CHECK(SameStatistics(statistics, 34, 2.0, 2.0, 2.0, 2.0, 2.0));
+	GetProfileStatistics(PROFILE_STAGE_PRESENT, statistics);
+	CHECK(SameStatistics(statistics, 0, 0.0, 0.0, 0.0, 0.0, 0.0));			// A stage without samples reports nothing.
+
+	// The files hold one line, or member, per stage with samples.
+	CHECK(SaveProfileCsv(TestCsvFileName) == 0);
+	string csv = ReadFile(TestCsvFileName);
+	CHECK(csv == "Stage,Samples,MeanMs,P50Ms,P95Ms,P99Ms,MaximumMs\nClear,34,2,2,2,2,2\nDraw,100,50.5,50,95,99,100\n");
+	CHECK(SaveProfileJson(TestJsonFileName) == 0);
+	string json = ReadFile(TestJsonFileName);
+	CHECK(json.find("\"Draw\": { \"samples\": 100, \"meanMs\": 50.5, \"p50Ms\": 50, \"p95Ms\": 95, \"p99Ms\": 99, \"maximumMs\": 100 }") != string::npos &&
+		  json.find("\"Clear\": { \"samples\": 34,") != string::npos && json.find("Present") == string::npos);
+	std::error_code error;
+	fs::remove(TestCsvFileName, error);
+	fs::remove(TestJsonFileName, error);
+
+	// A few samples: each percentile is one of them, rounded up to the next rank.
+	ProfilerReset();
+	GetProfileStatistics(PROFILE_STAGE_DRAW, statistics);
+	CHECK(statistics.Samples == 0);											// Every sample is discarded.
+	ProfilerRecord(PROFILE_STAGE_DRAW, 0, 3000000);
+	GetProfileStatistics(PROFILE_STAGE_DRAW, statistics);
+	CHECK(SameStatistics(statistics, 1, 3.0, 3.0, 3.0, 3.0, 3.0));
+	ProfilerRecord(PROFILE_STAGE_DRAW, 0, 1000000);
+	ProfilerRecord(PROFILE_STAGE_DRAW, 0, 2000000);
+	GetProfileStatistics(PROFILE_STAGE_DRAW, statistics);
+	CHECK(SameStatistics(statistics, 3, 2.0, 2.0, 3.0, 3.0, 3.0));			// The 50th percentile of 3 samples is the 2nd smallest.
+	ProfilerReset();
+}
+
+// Once the ring buffer is full, each sample overwrites the oldest, and only the most recent FRAME_PROFILER_SAMPLES samples are reported.
+static void TestRingBuffer()
+{
+	ProfilerReset();
+	for (int i = 0; i < 1000; i++)
+		ProfilerRecord(PROFILE_STAGE_PRESENT, 0, 500000000);				// Outliers, all overwritten.
+	for (int i = 0; i < FRAME_PROFILER_SAMPLES - 10; i++)
+		ProfilerRecord(PROFILE_STAGE_PRESENT, 1, 1000000);
+	for (int i = 0; i < 10; i++)
+		ProfilerRecord(PROFILE_STAGE_WAIT, 1, 4000000);
+	ProfileStatistics statistics;
+	GetProfileStatistics(PROFILE_STAGE_PRESENT, statistics);
+	CHECK(SameStatistics(statistics, FRAME_PROFILER_SAMPLES - 10, 1.0, 1.0, 1.0, 1.0, 1.0));
+	GetProfileStatistics(PROFILE_STAGE_WAIT, statistics);
+	CHECK(SameStatistics(statistics, 10, 4.0, 4.0, 4.0, 4.0, 4.0));
+	ProfilerReset();
+}
+
+// Several threads record at once, each its own stage and times, while the statistics are read: once they finish, every sample is reported for its own stage.
+static void TestThreads()
+{
+	ProfilerReset();
+	const int threadsTotal = 4;
+	const int samplesPerThread = 5000;
+	vector<std::thread> threads;
+	for (int t = 0; t < threadsTotal; t++)
+		threads.emplace_back([t]()
+		{
+			for (int i = 0; i < samplesPerThread; i++)
+				ProfilerRecord(PROFILE_STAGE_TRANSFORM + t, i, (long long)(t + 1) * 1000000);
+		});
+	bool consistent = true;
+	for (int r = 0; r < 20; r++)
+	{
+		ProfileStatistics statistics;
+		GetProfileStatistics(PROFILE_STAGE_TRANSFORM, statistics);
+		consistent = consistent && (statistics.Samples == 0 || (statistics.Maximum == 1.0 && statistics.P50 == 1.0));	// A sample read while it is written is skipped, never reported with another stage's time.
+	}
+	for (std::thread& thread : threads)
+		thread.join();
+	CHECK(consistent);
+	bool all = true;
+	for (int t = 0; t < threadsTotal; t++)
+	{
+		ProfileStatistics statistics;
+		GetProfileStatistics(PROFILE_STAGE_TRANSFORM + t, statistics);
+		double milliseconds = (double)(t + 1);
+		all = all && SameStatistics(statistics, samplesPerThread, milliseconds, milliseconds, milliseconds, milliseconds, milliseconds);
+	}
+	CHECK(all);
+	ProfilerReset();
+}
+
+// The PROFILE_FRAME, PROFILE_BEGIN, and PROFILE_END macros time a stage only when FrameProfilerEnabled is true, and never when FRAME_PROFILER_ENABLED is 0.
+static void TestMacros()
+{
+	ProfilerReset();
+	unsigned long long frame = ProfilerFrame();
+	FrameProfilerEnabled = false;
+	PROFILE_FRAME();
+	PROFILE_BEGIN(PROFILE_STAGE_SORT);
+	PROFILE_END(PROFILE_STAGE_SORT);
+	ProfileStatistics statistics;
+	GetProfileStatistics(PROFILE_STAGE_SORT, statistics);
+	CHECK(statistics.Samples == 0 && ProfilerFrame() == frame);
+
+	FrameProfilerEnabled = true;
+	PROFILE_FRAME();
+	PROFILE_BEGIN(PROFILE_STAGE_SORT);
+	std::this_thread::sleep_for(std::chrono::milliseconds(2));
+	PROFILE_END(PROFILE_STAGE_SORT);
+	GetProfileStatistics(PROFILE_STAGE_SORT, statistics);
+#if FRAME_PROFILER_ENABLED
+	CHECK(statistics.Samples == 1 && statistics.Maximum >= 2.0 && ProfilerFrame() == frame + 1);
+#else
+	CHECK(statistics.Samples == 0 && ProfilerFrame() == frame);
+#endif
+	FrameProfilerEnabled = false;
+	ProfilerReset();
+}
+
+// Measure the cost of timing every stage of a frame with the macros, as the fastest of several repetitions of many frames, and check that it is under 1% of a frame of 1 millisecond.
+static void TestOverhead()
+{
+	ProfilerReset();
+	FrameProfilerEnabled = true;
+	const int framesTotal = 20000;
+	double fastest = 0.0;
+	for (int r = 0; r < 10; r++)
+	{
+		long long start = ProfilerTime();
+		for (int f = 0; f < framesTotal; f++)
+		{
+			PROFILE_FRAME();
+			for (int stage = 0; stage < PROFILE_STAGES_TOTAL; stage++)
+			{
+				PROFILE_BEGIN(stage);
+				PROFILE_END(stage);
+			}
+		}
+		double perFrame = (double)(ProfilerTime() - start) / framesTotal;
+		if (r == 0 || perFrame < fastest)
+			fastest = perFrame;
+	}
+	FrameProfilerEnabled = false;
+	ProfilerReset();
+	printf("Timing all %d stages of a frame costs %.0f ns (%.0f ns per stage), %.3f%% of a frame of %.0f ms, with FRAME_PROFILER_ENABLED %d\n", (int)PROFILE_STAGES_TOTAL, fastest, fastest / PROFILE_STAGES_TOTAL,
+		100.0 * fastest / TestFrameNanoseconds, TestFrameNanoseconds / 1.0e6, FRAME_PROFILER_ENABLED);
+	CHECK(fastest < TestOverheadFraction * TestFrameNanoseconds);
+}
+
+// main function: Definition
+int main()
+{
+	TestPercentiles();
+	TestRingBuffer();
+	TestThreads();
+	TestMacros();
+	TestOverhead();
+	return TestResult();
+}
+
+// End: Function Definitions.
@@ -0,0 +1,251 @@
+// instanceBuilderTest
+// Version 3.1
+//
+// Description
+// Tests that the BuildInstanceBatches function draws exactly the instances whose bounding sphere is not outside the viewing frustum, each at the level of detail the SelectMeshLod function selects from its distance to the camera,
+// in batches of consecutive INSTANCEDATA structures, one per level of detail drawn, in order of level of detail; that within each batch the instances keep the order they have in the InstanceTransformArrays (a stable grouping);
+// and that the INSTANCEDATA structure written for each instance is the one built from its own InstanceTransform with DirectXMath matrix functions.
+// Random instances are batched with 1 and with 4 job system threads, which cull them in parallel, and give the same batches. The expected results are computed one instance at a time, with double precision;
+// instances so close to a plane of the frustum, or to the distance at which the level of detail changes, that rounding could decide either way, are not checked.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Test check Header File.
+#include "testCheck.h"
+
+// Instance data Header File.
+#include "instanceBuilder.h"
+
+// Meshlet (cluster) Header File.
+// Declares the ExtractFrustumPlanes function.
+#include "meshletBuilder.h"
+
+// Job system Header File.
+#include "jobSystem.h"
+
+// Vector Container Class.
+#include <vector>											// Vector class, used to hold the instances and their expected results.
+
+// Random Number Generation.
+#include <random>											// Mersenne twister engine, uniform distribution.
+
+// Mathematical Functions.
+#include <cmath>											// Mathematical functions sqrt, fabs.
+
+// Algorithm Functions.
+#include <algorithm>										// Algorithm function max.
+
+// Using Declarations and Directives.
+using std::vector;
+
+// The bounding sphere of the object, in object space, off its origin so that the rotation and scale of each instance move it.
+static const XMFLOAT3 TestBoundsCenter(0.5f, -0.25f, 1.0f);
+static const float TestBoundsRadius = 2.0f;
+
+// The number of pixels covered by one unit at a distance of one unit, for a field of view of 90 degrees and a screen 600 pixels high, as the objRenderer program computes it.
+static const float TestProjectionScale = 300.0f;
+
+// The relative distance within which the expected result of an instance is not checked.
+static const double TestMargin = 1.0e-4;
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// Fill Transforms with InstancesTotal random instances, scattered around and behind a camera at the origin looking toward +z, so that many are culled by each plane of the frustum, except the first two.
+static void TestTransforms(InstanceTransformArrays& Transforms, int InstancesTotal, unsigned int Seed)
+{
+	std::mt19937 random(Seed);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	ResizeInstanceTransforms(Transforms, InstancesTotal);
+	for (int i = 0; i < InstancesTotal; i++)
+	{
+		InstanceTransform transform;
+		float x = unit(random), y = unit(random), z = unit(random), w = unit(random);
+		float length = std::sqrt(x * x + y * y + z * z + w * w);
+		if (length < 1.0e-3f)
+			x = 1.0f, length = std::sqrt(x * x + y * y + z * z + w * w);
+		transform.Rotation = XMFLOAT4(x / length, y / length, z / length, w / length);
+		transform.Position = XMFLOAT3(unit(random) * 300.0f, unit(random) * 100.0f, unit(random) * 200.0f + 150.0f);
+		transform.Scale = 0.25f + (unit(random) + 1.0f) * 2.0f;
+		if (i < 2)
+			transform.Position = XMFLOAT3(0.0f, 3.0f * i, 20.0f);	// The first two instances are in front of the camera, one above the other, as the objRenderer program places them.
+		SetInstanceTransform(Transforms, i, transform);
+	}
+}
+
+// Declare the TestExpected 'named structure' data type.
+// The expected result of one instance: its level of detail, or -1 if it is culled, and whether rounding could change it.
+struct TestExpected {
+	int Lod;
+	bool Uncertain;
+};
+
+// Return the expected result of Transform, computed with double precision from its world matrix, the planes of the frustum of matViewProjection, and the distance from EyePosition.
+static TestExpected Expect(const InstanceTransform& Transform, const XMVECTOR Planes[6], const XMFLOAT3& EyePosition, const MeshLod* Lods, int LodsTotal)
+{
+	XMFLOAT3 center;
+	XMStoreFloat3(&center, XMVector3TransformCoord(XMLoadFloat3(&TestBoundsCenter), InstanceWorldMatrix(Transform)));
+	double radius = (double)TestBoundsRadius * Transform.Scale;
+	double extent = std::sqrt((double)center.x * center.x + (double)center.y * center.y + (double)center.z * center.z) + radius;	// The scale of the distances compared.
+
+	TestExpected expected = { 0, false };
+	for (int p = 0; p < 6; p++)
+	{
+		XMFLOAT4 plane;
+		XMStoreFloat4(&plane, Planes[p]);
+		double distance = (double)plane.x * center.x + (double)plane.y * center.y + (double)plane.z * center.z + plane.w + radius;
+		if (std::fabs(distance) <= TestMargin * extent)
+			expected.Uncertain = true;
+		if (distance < 0.0)
+			expected.Lod = -1;
+	}
+	if (expected.Lod < 0)
+		return expected;
+
+	double dx = (double)center.x - EyePosition.x, dy = (double)center.y - EyePosition.y, dz = (double)center.z - EyePosition.z;
+	double distance = (std::sqrt(dx * dx + dy * dy + dz * dz) - radius) / Transform.Scale;
+	expected.Lod = SelectMeshLod(Lods, LodsTotal, (float)distance, TestProjectionScale, MeshLodPixelError);
+	if (SelectMeshLod(Lods, LodsTotal, (float)(distance * (1.0 - TestMargin)), TestProjectionScale, MeshLodPixelError) != expected.Lod ||
+		SelectMeshLod(Lods, LodsTotal, (float)(distance * (1.0 + TestMargin)), TestProjectionScale, MeshLodPixelError) != expected.Lod ||
+		std::fabs(distance) <= TestMargin * extent)
+		expected.Uncertain = true;
+	return expected;
+}
+
+// Return the largest difference between Result and the INSTANCEDATA structure built from the DirectXMath world matrix of Transform (see batchTransformTest).
+static float Difference(const InstanceTransform& Transform, const INSTANCEDATA& Result)
+{
+	XMFLOAT4X4 world, rotation;
+	XMStoreFloat4x4(&world, InstanceWorldMatrix(Transform));
+	InstanceTransform rotationOnly;
+	rotationOnly.Rotation = Transform.Rotation;
+	XMStoreFloat4x4(&rotation, InstanceWorldMatrix(rotationOnly));
+
+	float difference = 0.0f;
+	for (int row = 0; row < 3; row++)
+	{
+		const float world4[4] = { Result.World[row].x, Result.World[row].y, Result.World[row].z, Result.World[row].w };
+		const float normal4[4] = { Result.Normal[row].x, Result.Normal[row].y, Result.Normal[row].z, Result.Normal[row].w };
+		for (int column = 0; column < 4; column++)
+		{
+			difference = std::max(difference, std::fabs(world4[column] - world.m[column][row]));
+			difference = std::max(difference, std::fabs(normal4[column] - (column < 3 ? rotation.m[column][row] : 0.0f)));
+		}
+	}
+	return difference;
+}
+
+// Batch the instances of Transforms with Threads job system threads, check the batches, order, and INSTANCEDATA structures against the expected results, and return the order.
+static vector<int> CheckBatches(const InstanceTransformArrays& Transforms, int Threads, const MeshLod* Lods, int LodsTotal, vector<InstanceBatch>& Batches)
+{
+	JobSystemShutdown();									// JobSystemThreads is read when the job system is started.
+	JobSystemThreads = Threads;
+
+	XMFLOAT3 eye(0.0f, 0.0f, 0.0f);
+	XMMATRIX matViewProjection = XMMatrixMultiply(XMMatrixLookAtLH(XMLoadFloat3(&eye), XMVectorSet(0.0f, 0.0f, 1.0f, 1.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)),
+		XMMatrixPerspectiveFovLH(XM_PIDIV2, 4.0f / 3.0f, 1.0f, 250.0f));
+	int instancesTotal = (int)Transforms.Scale.size();
+	vector<INSTANCEDATA> result(instancesTotal + 1);
+	vector<int> order;
+	int drawn = BuildInstanceBatches(Transforms, matViewProjection, XMLoadFloat3(&eye), TestProjectionScale, TestBoundsCenter, TestBoundsRadius, Lods, LodsTotal, result.data(), order, Batches);
+
+	// The batches: one per level of detail drawn, in order, each following the one before it, covering every instance drawn.
+	bool batched = drawn >= 0 && drawn <= instancesTotal && (int)order.size() == drawn;
+	int next = 0, previousLod = -1;
+	for (const InstanceBatch& batch : Batches)
+	{
+		batched = batched && batch.Lod > previousLod && batch.Lod < LodsTotal && batch.FirstInstance == next && batch.InstancesTotal > 0;
+		previousLod = batch.Lod;
+		next += batch.InstancesTotal;
+	}
+	batched = batched && next == drawn;
+
+	// Each instance drawn once, in its own level of detail's batch, in the order of the instances, with its own INSTANCEDATA structure.
+	XMVECTOR planes[6];
+	ExtractFrustumPlanes(matViewProjection, planes);
+	vector<int> drawnAt(instancesTotal, -1);
+	bool ordered = true;
+	float difference = 0.0f;
+	for (const InstanceBatch& batch : Batches)
+		for (int s = batch.FirstInstance; batched && s < batch.FirstInstance + batch.InstancesTotal; s++)
+		{
+			int i = order[s];
+			if (i < 0 || i >= instancesTotal || drawnAt[i] >= 0)
+			{
+				batched = false;
+				break;
+			}
+			drawnAt[i] = batch.Lod;
+			ordered = ordered && (s == batch.FirstInstance || order[s - 1] < i);
+			difference = std::max(difference, Difference(GetInstanceTransform(Transforms, i), result[s]));
+		}
+
+	int culled = 0, uncertain = 0, wrong = 0;
+	int lodDrawn[MESH_LOD_LEVELS_MAXIMUM] = {};
+	for (int i = 0; i < instancesTotal; i++)
+	{
+		TestExpected expected = Expect(GetInstanceTransform(Transforms, i), planes, eye, Lods, LodsTotal);
+		culled += expected.Lod < 0;
+		if (expected.Lod >= 0)
+			lodDrawn[expected.Lod]++;
+		if (expected.Uncertain)
+			uncertain++;
+		else if (drawnAt[i] != expected.Lod)
+			wrong++;
+	}
+	printf("%d instances, %d threads: %d drawn in %zu batches (%d, %d, %d, %d at each level of detail), %d culled, %d not checked, largest difference %g\n", instancesTotal, Threads, drawn, Batches.size(),
+		lodDrawn[0], lodDrawn[1], lodDrawn[2], lodDrawn[3], culled, uncertain, difference);
+	CHECK(batched);
+	CHECK(ordered);
+	CHECK(wrong == 0);
+	CHECK(uncertain <= instancesTotal / 100);
+	CHECK(difference <= 1.0e-6f * 400.0f);					// The largest position is about 350.
+	return order;
+}
+
+// main function: Definition
+int main()
+{
+	// Four levels of detail, each with a larger geometric error: seen from within 100 units, an instance of scale 1 is drawn with level of detail 0, from within 150 units with 1, from within 200 units with 2, and further away with 3.
+	MeshLod lods[4];
+	lods[1].Error = 100.0f / TestProjectionScale;
+	lods[2].Error = 150.0f / TestProjectionScale;
+	lods[3].Error = 200.0f / TestProjectionScale;
+
+	// Fewer instances than InstanceCullParallelMinimum are culled by the calling thread; more are divided among the job system's threads. Each number of threads gives the same batches.
+	const int instancesTotals[] = { 0, 1, 2, 1000, 50000 };
+	for (int instancesTotal : instancesTotals)
+	{
+		InstanceTransformArrays transforms;
+		TestTransforms(transforms, instancesTotal, 3u + (unsigned int)instancesTotal);
+		vector<InstanceBatch> batches1, batches4;
+		vector<int> order1 = CheckBatches(transforms, 1, lods, 4, batches1);
+		vector<int> order4 = CheckBatches(transforms, 4, lods, 4, batches4);
+		bool same = order1 == order4 && batches1.size() == batches4.size();
+		for (size_t b = 0; same && b < batches1.size(); b++)
+			same = batches1[b].Lod == batches4[b].Lod && batches1[b].FirstInstance == batches4[b].FirstInstance && batches1[b].InstancesTotal == batches4[b].InstancesTotal;
+		CHECK(same);
+		if (instancesTotal >= 1000)
+			CHECK(batches1.size() == 4);					// Every level of detail is drawn.
+	}
+
+	// A single level of detail is one batch of every instance drawn, in the order of the instances.
+	InstanceTransformArrays transforms;
+	TestTransforms(transforms, 5000, 17u);
+	vector<InstanceBatch> batches;
+	vector<int> order = CheckBatches(transforms, 2, lods, 1, batches);
+	CHECK(batches.size() == 1 && batches[0].Lod == 0 && batches[0].InstancesTotal == (int)order.size());
+
+	JobSystemShutdown();
+	return TestResult();
+}
+
+// End: Function Definitions.
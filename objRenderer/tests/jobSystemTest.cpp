@@ -0,0 +1,180 @@
+// jobSystemTest
+// Version 3.1
+//
+// Description
+// Stress tests the job system with 1, 2, 4, and 16 threads (more threads than processors, so threads are preempted while they hold queues, and steal from each other):
+// every job started runs exactly once; a JobWait function call, by the main thread or by a job waiting for the jobs it started, returns only when every child and grandchild is finished;
+// and JobParallelFor function calls, many at once from different jobs, each call Function for every element of their range exactly once, in ranges of at least Minimum elements.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Test check Header File.
+#include "testCheck.h"
+
+// Job system Header File.
+#include "jobSystem.h"
+
+// Vector Container Class.
+#include <vector>											// Vector class, used to count the runs of each job and element.
+
+// Memory Management.
+#include <memory>											// Unique pointer class, used to hold the arrays of atomic counters.
+
+// Using Declarations and Directives.
+using std::vector;
+using std::atomic;
+using std::unique_ptr;
+
+// The number of times each test is repeated with each number of threads, so that the threads interleave differently each time.
+static const int TestRepetitions = 20;
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// Every job of many, started by the main thread as children of one job, and by those jobs as children of their own parent, runs exactly once, and JobWait returns only when they have all run.
+static void TestJobsRunOnce()
+{
+	const int parentsTotal = 200, childrenTotal = 50;
+	unique_ptr<atomic<int>[]> runs(new atomic<int>[parentsTotal * (childrenTotal + 1)]);
+	for (int i = 0; i < parentsTotal * (childrenTotal + 1); i++)
+		runs[i] = 0;
+
+	Job* root = JobCreate(nullptr, nullptr);
+	for (int p = 0; p < parentsTotal; p++)
+	{
+		Job* parent = JobCreate(nullptr, root);
+		// The function of the parent is set before it is run; it starts its children as children of itself, which it may do as it is not finished until its function returns.
+		parent->Function = [&runs, parent, p, childrenTotal] {
+			runs[p * (childrenTotal + 1)]++;
+			for (int c = 1; c <= childrenTotal; c++)
+				JobRun(JobCreate([&runs, p, c, childrenTotal] { runs[p * (childrenTotal + 1) + c]++; }, parent));
+		};
+		JobRun(parent);
+	}
+	JobRun(root);
+	JobWait(root);
+
+	bool once = true;
+	for (int i = 0; i < parentsTotal * (childrenTotal + 1); i++)
+		once = once && runs[i] == 1;
+	CHECK(once);
+}
+
+// Each job of a tree waits for the subtree it starts, with its own job without a parent, before it returns: the count of the leaves below it must be complete when its JobWait call returns.
+static int TestTreeJob(int Depth, atomic<int>& Leaves, atomic<int>& Failures)
+{
+	if (Depth == 0)
+	{
+		Leaves++;
+		return 1;
+	}
+
+	const int branches = 4;
+	atomic<int> below(0);
+	Job* subtree = JobCreate(nullptr, nullptr);
+	for (int b = 0; b < branches; b++)
+		JobRun(JobCreate([Depth, &Leaves, &Failures, &below] { below += TestTreeJob(Depth - 1, Leaves, Failures); }, subtree));
+	JobRun(subtree);
+	JobWait(subtree);
+
+	int expected = 1;
+	for (int d = 0; d < Depth; d++)
+		expected *= branches;
+	if (below != expected)
+		Failures++;
+	return below;
+}
+
+// A tree of jobs, four branches at each of five levels: every one of the 1024 leaves runs, and every waiting job sees all of its leaves finished.
+static void TestNestedWaits()
+{
+	atomic<int> leaves(0), failures(0);
+	Job* root = JobCreate([&leaves, &failures] { TestTreeJob(5, leaves, failures); }, nullptr);
+	JobRun(root);
+	JobWait(root);
+	CHECK(leaves == 1024);
+	CHECK(failures == 0);
+}
+
+// Many JobParallelFor calls at once, each from a different job, of ranges that are empty, smaller than Minimum, or not a multiple of the number of ranges, each element must be handled exactly once, in a range of at least Minimum elements
+// (or the whole range, if it is smaller).
+static void TestParallelFor()
+{
+	struct Case { int Count, Minimum; };
+	const Case cases[] = { { 0, 1 }, { 1, 1 }, { 7, 8 }, { 64, 1 }, { 1000, 0 }, { 4099, 16 }, { 100003, 256 }, { 250000, 4096 } };
+	const int casesTotal = (int)(sizeof(cases) / sizeof(cases[0]));
+
+	vector<unique_ptr<atomic<int>[]>> hits(casesTotal);
+	for (int c = 0; c < casesTotal; c++)
+	{
+		hits[c].reset(new atomic<int>[cases[c].Count > 0 ? cases[c].Count : 1]);
+		for (int i = 0; i < cases[c].Count; i++)
+			hits[c][i] = 0;
+	}
+
+	atomic<int> shortRanges(0), outOfRange(0);
+	Job* root = JobCreate(nullptr, nullptr);
+	for (int c = 0; c < casesTotal; c++)
+	{
+		const Case test = cases[c];
+		atomic<int>* hit = hits[c].get();
+		JobRun(JobCreate([test, hit, &shortRanges, &outOfRange] {
+			JobParallelFor(test.Count, test.Minimum, [test, hit, &shortRanges, &outOfRange](int Begin, int End) {
+				if (Begin < 0 || End > test.Count || Begin >= End)
+				{
+					outOfRange++;
+					return;
+				}
+				if (End - Begin < test.Minimum && End - Begin < test.Count)
+					shortRanges++;
+				for (int i = Begin; i < End; i++)
+					hit[i]++;
+			});
+		}, root));
+	}
+	JobRun(root);
+	JobWait(root);
+
+	CHECK(outOfRange == 0);
+	CHECK(shortRanges == 0);
+	for (int c = 0; c < casesTotal; c++)
+	{
+		bool once = true;
+		for (int i = 0; i < cases[c].Count; i++)
+			once = once && hits[c][i] == 1;
+		if (!CHECK(once))
+			printf("JobParallelFor(%d, %d) did not handle every element exactly once.\n", cases[c].Count, cases[c].Minimum);
+	}
+}
+
+// main function: Definition
+int main()
+{
+	for (int threadsTotal : { 1, 2, 4, 16 })
+	{
+		JobSystemShutdown();								// JobSystemThreads is read when the job system is started.
+		JobSystemThreads = threadsTotal;
+		int failuresBefore = TestFailuresTotal;
+		for (int r = 0; r < TestRepetitions; r++)
+		{
+			TestJobsRunOnce();
+			TestNestedWaits();
+			TestParallelFor();
+		}
+		CHECK(JobSystemThreadsTotal() == threadsTotal);
+		printf("%d threads: %s\n", threadsTotal, TestFailuresTotal == failuresBefore ? "passed" : "failed");
+	}
+
+	JobSystemShutdown();
+	return TestResult();
+}
+
+// End: Function Definitions.
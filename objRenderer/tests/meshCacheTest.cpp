@@ -0,0 +1,147 @@
+// meshCacheTest
+// Version 3.1
+//
+// Description
+// Tests that the MeshCacheLoad function accepts a valid binary mesh cache file, and rejects one whose indices, of level of detail 0 or of the other levels of detail, refer past its vertices,
+// so that the objRenderer program parses the Wavefront .obj file instead of drawing from a damaged cache file.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Test check Header File.
+#include "testCheck.h"
+
+// Binary mesh cache (.objbin file) I/O Header File.
+#include "meshCache.h"
+
+// File Stream Functions.
+#include <fstream>											// File stream class member functions write, seekp, close, etc.
+
+// Vector Container Class.
+#include <vector>											// Vector class, used to hold the mesh saved.
+
+// File System Functions.
+#include <filesystem>										// File system function remove.
+
+// Using Declarations and Directives.
+using std::vector;
+using std::ofstream;
+using std::fstream;
+using std::ios;
+namespace fs = std::filesystem;
+
+// The source Wavefront .obj file, and its binary mesh cache file, in the current directory. Only the size and last write time of the source file are read.
+static const char* const TestSourceFileName = "meshCacheTest.obj";
+static const char* const TestCacheFileName = "meshCacheTest.objbin";
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// Declare the TestMesh 'named structure' data type.
+// A mesh of two triangles sharing an edge, with a second level of detail of one triangle, saved as a binary mesh cache file.
+struct TestMesh {
+	vector<VERTEX> Vertices;
+	vector<DWORD> Indices = { 0, 1, 2, 2, 1, 3 };
+	vector<MeshLod> Lods;
+	vector<DWORD> LodIndices = { 0, 1, 3 };
+
+	TestMesh()
+	{
+		Vertices.resize(4);
+		for (int v = 0; v < 4; v++)
+		{
+			Vertices[v].GeometricVertex = XMFLOAT3((float)(v & 1), (float)(v >> 1), 0.0f);
+			Vertices[v].VertexNormalVector = XMFLOAT3(0.0f, 0.0f, -1.0f);
+			Vertices[v].VertexTextureCoordinate = XMFLOAT2((float)(v & 1), (float)(v >> 1));
+		}
+		Lods.resize(2);
+		Lods[0].FirstIndex = 0;
+		Lods[0].PrimitivesTotal = 2;
+		Lods[1].FirstIndex = 6;								// The indices of the other levels of detail follow those of level of detail 0 in the index buffer.
+		Lods[1].PrimitivesTotal = 1;
+		Lods[1].Error = 0.5f;
+	}
+
+	int Save() const
+	{
+		return MeshCacheSave(TestSourceFileName, Vertices.data(), (int)Vertices.size(), Indices.data(), (int)Indices.size() / 3, Lods.data(), (int)Lods.size(), LodIndices.data(), (int)LodIndices.size(), nullptr, 0);
+	}
+};
+
+// Save Mesh, then return the return code of the MeshCacheLoad function. A view loaded successfully is checked against Mesh, and unloaded.
+static int SaveAndLoad(const TestMesh& Mesh)
+{
+	if (!CHECK(Mesh.Save() == 0))
+		return -1;
+	MeshCacheView view;
+	int result = MeshCacheLoad(TestSourceFileName, view);
+	if (result == 0)
+	{
+		CHECK(view.VertexAttributeSetsTotal == (int)Mesh.Vertices.size());
+		CHECK(view.PrimitivesTotal == (int)Mesh.Indices.size() / 3);
+		CHECK(view.LodsTotal == (int)Mesh.Lods.size());
+		CHECK(view.LodIndicesTotal == (int)Mesh.LodIndices.size());
+		CHECK(vector<DWORD>(view.Indices, view.Indices + view.PrimitivesTotal * 3) == Mesh.Indices);
+		CHECK(vector<DWORD>(view.LodIndices, view.LodIndices + view.LodIndicesTotal) == Mesh.LodIndices);
+	}
+	else
+		CHECK(view.Vertices == nullptr && view.Indices == nullptr && view.VertexAttributeSetsTotal == 0);	// A rejected cache file leaves the view empty.
+	MeshCacheUnload(view);
+	return result;
+}
+
+// main function: Definition
+int main()
+{
+	ofstream source(TestSourceFileName, ios::out | ios::trunc);
+	source << "# The source of meshCacheTest.objbin\n";
+	source.close();
+	CHECK((bool)source);
+
+	// A valid cache file is loaded.
+	TestMesh valid;
+	CHECK(SaveAndLoad(valid) == 0);
+
+	// An index of level of detail 0 equal to, or far past, the number of vertices is rejected.
+	TestMesh mesh = valid;
+	mesh.Indices[4] = 4;
+	CHECK(SaveAndLoad(mesh) == 1);
+	mesh.Indices[4] = 0xFFFFFFFF;
+	CHECK(SaveAndLoad(mesh) == 1);
+
+	// An index of another level of detail past the number of vertices is rejected.
+	mesh = valid;
+	mesh.LodIndices[2] = 4;
+	CHECK(SaveAndLoad(mesh) == 1);
+
+	// The largest valid index is accepted.
+	mesh = valid;
+	mesh.LodIndices[0] = 3;
+	CHECK(SaveAndLoad(mesh) == 0);
+
+	// A valid cache file damaged afterwards, e.g., by a disk error, is rejected: overwrite its last index of level of detail 0.
+	CHECK(valid.Save() == 0);
+	fstream cache(TestCacheFileName, ios::in | ios::out | ios::binary);
+	DWORD damaged = 1000;
+	cache.seekp((std::streamoff)(sizeof(MeshCacheHeader) + valid.Vertices.size() * sizeof(VERTEX) + 5 * sizeof(DWORD)));
+	cache.write((const char*)&damaged, sizeof(damaged));
+	cache.close();
+	CHECK((bool)cache);
+	MeshCacheView view;
+	CHECK(MeshCacheLoad(TestSourceFileName, view) == 1);
+	MeshCacheUnload(view);
+
+	std::error_code error;
+	fs::remove(TestSourceFileName, error);
+	fs::remove(TestCacheFileName, error);
+	return TestResult();
+}
+
+// End: Function Definitions.
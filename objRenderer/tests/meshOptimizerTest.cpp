@@ -0,0 +1,323 @@
+// meshOptimizerTest
+// Version 3.1
+//
+// Description
+// Tests the vertex cache functions of the mesh optimizer: the AnalyzeVertexCache function counts the vertices transformed through a first-in, first-out cache as computed by hand, and the OptimizeVertexCache function reorders the triangles of a regular grid,
+// drawn in random order, so that fewer vertices are transformed than in random order, or in row order. The triangles drawn are the same triangles, each with its indices in the same order, so its winding order is unchanged.
+// The AnalyzeVertexFetch function counts the cache lines read as computed by hand, and the OptimizeVertexFetch function reorders the vertices into the order the indices first reference them, followed by the vertices not referenced, in their original order.
+// Every index refers to the same vertex attributes as before, and no more bytes are fetched than before.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Test check Header File.
+#include "testCheck.h"
+
+// Mesh optimization Header File.
+#include "meshOptimizer.h"
+
+// Random Number Generation.
+#include <random>											// Mersenne twister engine, shuffle.
+
+// Memory Functions.
+#include <cstring>											// Memory function memcmp.
+
+// Algorithms.
+#include <algorithm>										// Algorithms shuffle, sort.
+
+// Array Container Class.
+#include <array>											// Array class, used to hold one triangle's indices.
+
+// Using Declarations and Directives.
+using std::vector;
+using std::array;
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// Return the indices of a regular grid of Side by Side vertices, two triangles per square, in row order, each triangle clockwise seen from +z.
+static vector<DWORD> GridIndices(int Side)
+{
+	vector<DWORD> indices;
+	for (int y = 0; y + 1 < Side; y++)
+		for (int x = 0; x + 1 < Side; x++)
+		{
+			DWORD v = (DWORD)(y * Side + x);
+			const DWORD square[6] = { v, v + Side, v + 1, v + 1, v + Side, v + Side + 1 };
+			indices.insert(indices.end(), square, square + 6);
+		}
+	return indices;
+}
+
+// Return the triangles of Indices, sorted, each with its indices in the order drawn.
+static vector<array<DWORD, 3>> SortedTriangles(const vector<DWORD>& Indices)
+{
+	vector<array<DWORD, 3>> triangles;
+	for (size_t i = 0; i + 2 < Indices.size(); i += 3)
+		triangles.push_back({ Indices[i], Indices[i + 1], Indices[i + 2] });
+	std::sort(triangles.begin(), triangles.end());
+	return triangles;
+}
+
+// Shuffle the triangles of Indices, keeping the indices of each triangle in order.
+static void ShuffleTriangles(vector<DWORD>& Indices, unsigned int Seed)
+{
+	vector<array<DWORD, 3>> triangles;
+	for (size_t i = 0; i + 2 < Indices.size(); i += 3)
+		triangles.push_back({ Indices[i], Indices[i + 1], Indices[i + 2] });
+	std::mt19937 random(Seed);
+	std::shuffle(triangles.begin(), triangles.end(), random);
+	for (size_t t = 0; t < triangles.size(); t++)
+		for (int k = 0; k <= 2; k++)
+			Indices[t * 3 + k] = triangles[t][k];
+}
+
+// The AnalyzeVertexCache function returns the values computed by hand for small index arrays.
+static void TestAnalyzeVertexCache()
+{
+	VertexCacheStatistics statistics;
+
+	// One triangle: each vertex is transformed once.
+	const DWORD one[] = { 0, 1, 2 };
+	AnalyzeVertexCache(one, 1, 3, VERTEX_CACHE_ANALYZE_SIZE, statistics);
+	CHECK(statistics.VerticesTransformed == 3 && statistics.ACMR == 3.0 && statistics.ATVR == 1.0);
+
+	// Two triangles sharing an edge: the shared vertices are transformed once.
+	const DWORD quad[] = { 0, 1, 2, 2, 1, 3 };
+	AnalyzeVertexCache(quad, 2, 4, VERTEX_CACHE_ANALYZE_SIZE, statistics);
+	CHECK(statistics.VerticesTransformed == 4 && statistics.ACMR == 2.0 && statistics.ATVR == 1.0);
+
+	// A triangle drawn again after three other vertices: in a cache of 3 vertices all three are transformed again, and in a cache of 6 none is.
+	const DWORD again[] = { 0, 1, 2, 3, 4, 5, 0, 1, 2 };
+	AnalyzeVertexCache(again, 3, 6, 3, statistics);
+	CHECK(statistics.VerticesTransformed == 9 && statistics.ACMR == 3.0 && statistics.ATVR == 1.5);
+	AnalyzeVertexCache(again, 3, 6, 6, statistics);
+	CHECK(statistics.VerticesTransformed == 6 && statistics.ACMR == 2.0 && statistics.ATVR == 1.0);
+
+	// The cache is first-in, first-out: vertex 0, found in the cache of 3 vertices by the second triangle, is not moved to the front, so vertex 3 pushes it out, and the third triangle transforms it again, which pushes out vertex 1.
+	// A least recently used cache would keep vertex 0 and push out vertex 2 instead, and transform 5 vertices rather than 6.
+	const DWORD fifo[] = { 0, 1, 2, 0, 3, 1, 0, 1, 3 };
+	AnalyzeVertexCache(fifo, 3, 4, 3, statistics);
+	CHECK(statistics.VerticesTransformed == 6 && statistics.ACMR == 2.0 && statistics.ATVR == 1.5);
+
+	// A vertex not referenced does not count as referenced, and nothing is drawn without triangles.
+	AnalyzeVertexCache(one, 1, 10, VERTEX_CACHE_ANALYZE_SIZE, statistics);
+	CHECK(statistics.VerticesTransformed == 3 && statistics.ATVR == 1.0);
+	AnalyzeVertexCache(one, 0, 3, VERTEX_CACHE_ANALYZE_SIZE, statistics);
+	CHECK(statistics.VerticesTransformed == 0 && statistics.ACMR == 0.0 && statistics.ATVR == 0.0);
+}
+
+// The OptimizeVertexCache function reorders the triangles of a regular grid, drawn in random order, so that fewer vertices are transformed than in random or row order, and draws the same triangles with the same winding order.
+static void TestOptimizeVertexCache()
+{
+	const int side = 100;
+	const int verticesTotal = side * side;
+	vector<DWORD> rows = GridIndices(side);
+	int primitivesTotal = (int)rows.size() / 3;
+	vector<DWORD> shuffled = rows;
+	ShuffleTriangles(shuffled, 7);
+	vector<DWORD> optimized = shuffled;
+	OptimizeVertexCache(optimized.data(), primitivesTotal, verticesTotal);
+
+	VertexCacheStatistics rowOrder, randomOrder, optimizedOrder;
+	AnalyzeVertexCache(rows.data(), primitivesTotal, verticesTotal, VERTEX_CACHE_ANALYZE_SIZE, rowOrder);
+	AnalyzeVertexCache(shuffled.data(), primitivesTotal, verticesTotal, VERTEX_CACHE_ANALYZE_SIZE, randomOrder);
+	AnalyzeVertexCache(optimized.data(), primitivesTotal, verticesTotal, VERTEX_CACHE_ANALYZE_SIZE, optimizedOrder);
+	printf("Grid of %d triangles: ACMR %.3f in random order, %.3f in row order, %.3f optimized\n", primitivesTotal, randomOrder.ACMR, rowOrder.ACMR, optimizedOrder.ACMR);
+	CHECK(optimizedOrder.ACMR < randomOrder.ACMR);
+	CHECK(optimizedOrder.ACMR < rowOrder.ACMR);
+	CHECK(optimizedOrder.ACMR < 0.75);								// A grid transforms each vertex about once, i.e., about 0.5 vertices per triangle, with a perfect cache.
+	CHECK(SortedTriangles(optimized) == SortedTriangles(rows));		// Every triangle once, each with its indices in the same order.
+
+	// Optimizing the optimized order again does not make it worse, beyond a few percent.
+	vector<DWORD> twice = optimized;
+	OptimizeVertexCache(twice.data(), primitivesTotal, verticesTotal);
+	VertexCacheStatistics twiceOrder;
+	AnalyzeVertexCache(twice.data(), primitivesTotal, verticesTotal, VERTEX_CACHE_ANALYZE_SIZE, twiceOrder);
+	CHECK(twiceOrder.ACMR <= optimizedOrder.ACMR * 1.05);
+
+	// Triangles without a shared vertex leave the cache without a triangle to draw next, so the next triangle in the original order is drawn. All are drawn, in their original order.
+	vector<DWORD> apart;
+	for (DWORD v = 0; v < 300; v++)
+		apart.push_back(v);
+	vector<DWORD> apartOptimized = apart;
+	OptimizeVertexCache(apartOptimized.data(), 100, 300);
+	CHECK(apartOptimized == apart);
+
+	// Two grids, their triangles shuffled together, and vertices referenced by no triangle (400 to 499, and 900 to 999): every triangle of both is drawn once.
+	vector<DWORD> two = GridIndices(20);
+	for (DWORD index : GridIndices(20))
+		two.push_back(index + 500);
+	ShuffleTriangles(two, 11);
+	vector<DWORD> twoOptimized = two;
+	OptimizeVertexCache(twoOptimized.data(), (int)two.size() / 3, 1000);
+	CHECK(SortedTriangles(twoOptimized) == SortedTriangles(two));
+}
+
+// Return the vertices of a regular grid of Side by Side vertices, each with different vertex attributes, in the order of the grid, or in random order if Seed is not 0, with the indices of GridIndices changed to match in Indices.
+static vector<VERTEX> GridVertices(int Side, unsigned int Seed, vector<DWORD>& Indices)
+{
+	int total = Side * Side;
+	vector<DWORD> position(total);
+	for (int v = 0; v < total; v++)
+		position[v] = (DWORD)v;
+	if (Seed != 0)
+	{
+		std::mt19937 random(Seed);
+		std::shuffle(position.begin(), position.end(), random);
+	}
+	vector<VERTEX> vertices(total);
+	for (int v = 0; v < total; v++)
+	{
+		VERTEX& vertex = vertices[position[v]];
+		vertex.GeometricVertex = XMFLOAT3((float)(v % Side), (float)(v / Side), 0.0f);
+		vertex.VertexNormalVector = XMFLOAT3(0.0f, 0.0f, -1.0f);
+		vertex.VertexTextureCoordinate = XMFLOAT2((float)(v % Side) / Side, (float)(v / Side) / Side);
+	}
+	Indices = GridIndices(Side);
+	for (DWORD& index : Indices)
+		index = position[index];
+	return vertices;
+}
+
+// Return true if each index of NewIndices refers, in NewVertices, to the same vertex attributes, bit for bit, as the index of OldIndices in the same place refers to in OldVertices.
+static bool SameAttributes(const vector<VERTEX>& OldVertices, const vector<DWORD>& OldIndices, const vector<VERTEX>& NewVertices, const vector<DWORD>& NewIndices)
+{
+	bool same = OldIndices.size() == NewIndices.size() && OldVertices.size() == NewVertices.size();
+	for (size_t i = 0; same && i < OldIndices.size(); i++)
+		same = NewIndices[i] < NewVertices.size() && std::memcmp(&NewVertices[NewIndices[i]], &OldVertices[OldIndices[i]], sizeof(VERTEX)) == 0;
+	return same;
+}
+
+// Return true if Indices first references each vertex in order, i.e., the first index is 0, and each index is at most one more than the largest before it.
+static bool FirstUseOrder(const vector<DWORD>& Indices)
+{
+	DWORD next = 0;
+	for (DWORD index : Indices)
+	{
+		if (index > next)
+			return false;
+		if (index == next)
+			next++;
+	}
+	return true;
+}
+
+// The AnalyzeVertexFetch function returns the values computed by hand for small index arrays.
+static void TestAnalyzeVertexFetch()
+{
+	VertexFetchStatistics statistics;
+
+	// Vertices of 32 bytes: vertices 0 and 1 share cache line 0, and vertex 2 is in cache line 1, so 2 cache lines are read for 96 bytes of vertices.
+	const DWORD one[] = { 0, 1, 2 };
+	AnalyzeVertexFetch(one, 1, 3, 32, statistics);
+	CHECK(statistics.BytesFetched == 128 && statistics.Overfetch == 128.0 / 96.0);
+
+	// Vertices of 48 bytes: vertex 1 overlaps cache lines 0 and 1, and vertex 2 cache lines 1 and 2, so 3 cache lines are read, each once.
+	AnalyzeVertexFetch(one, 1, 3, 48, statistics);
+	CHECK(statistics.BytesFetched == 192 && statistics.Overfetch == 192.0 / 144.0);
+
+	// Vertices far apart: each vertex of 32 bytes is in a cache line of its own, read when the vertex is first transformed. A vertex found in the post-transform vertex cache is not fetched again.
+	const DWORD apart[] = { 0, 100, 200, 200, 100, 300 };
+	AnalyzeVertexFetch(apart, 2, 301, 32, statistics);
+	CHECK(statistics.BytesFetched == 4 * 64 && statistics.Overfetch == 256.0 / 128.0);
+
+	// Vertices of 64 bytes, each in a cache line of its own: 69 vertices, in 23 triangles, push vertices 0 and 1 out of the post-transform vertex cache, and their cache lines out of the memory cache of 64 cache lines, so both are read again.
+	// Vertices 10 and 11 are also pushed out of the post-transform vertex cache, and fetched again, but their cache lines, 61 and 60 cache lines back, are still in the memory cache, and are not read again. 73 cache lines are read in all.
+	vector<DWORD> lines;
+	for (DWORD v = 0; v < 69; v++)
+		lines.push_back(v);
+	lines.insert(lines.end(), { 0, 1, 200, 10, 11, 202 });
+	AnalyzeVertexFetch(lines.data(), (int)lines.size() / 3, 203, 64, statistics);
+	CHECK(statistics.BytesFetched == 73 * 64);
+
+	// Vertices of 40 cache lines each: a triangle drawn twice reads 120 cache lines, more than the memory cache holds, only once, because its vertices are still in the post-transform vertex cache and are not fetched again.
+	const DWORD twice[] = { 0, 1, 2, 0, 1, 2 };
+	AnalyzeVertexFetch(twice, 2, 3, 40 * 64, statistics);
+	CHECK(statistics.BytesFetched == 120 * 64 && statistics.Overfetch == 1.0);
+
+	AnalyzeVertexFetch(one, 0, 3, 32, statistics);
+	CHECK(statistics.BytesFetched == 0 && statistics.Overfetch == 0.0);
+}
+
+// The OptimizeVertexFetch function reorders the vertices into the order the indices first reference them, followed by the vertices not referenced, and each index refers to the same vertex attributes as before.
+static void TestOptimizeVertexFetch()
+{
+	// Ten vertices, four of them referenced.
+	vector<VERTEX> vertices(10);
+	for (int v = 0; v < 10; v++)
+	{
+		vertices[v].GeometricVertex = XMFLOAT3((float)v, 0.0f, 0.0f);
+		vertices[v].VertexNormalVector = XMFLOAT3(0.0f, (float)v, 1.0f);
+		vertices[v].VertexTextureCoordinate = XMFLOAT2(0.0f, (float)v * 0.1f);
+	}
+	vector<DWORD> indices = { 7, 3, 5, 3, 9, 7 };
+	vector<VERTEX> oldVertices = vertices;
+	vector<DWORD> oldIndices = indices;
+	OptimizeVertexFetch(vertices.data(), indices.data(), 2, 10);
+	CHECK(indices == vector<DWORD>({ 0, 1, 2, 1, 3, 0 }));
+	const int order[] = { 7, 3, 5, 9, 0, 1, 2, 4, 6, 8 };	// The referenced vertices in the order first referenced, then the others in their original order.
+	bool moved = true;
+	for (int v = 0; v < 10; v++)
+		moved = moved && vertices[v].GeometricVertex.x == (float)order[v];
+	CHECK(moved);
+	CHECK(SameAttributes(oldVertices, oldIndices, vertices, indices));
+
+	// Without triangles, nothing is changed.
+	vector<VERTEX> unchanged = vertices;
+	OptimizeVertexFetch(unchanged.data(), indices.data(), 0, 10);
+	CHECK(std::memcmp(unchanged.data(), vertices.data(), 10 * sizeof(VERTEX)) == 0);
+
+	// A grid with its vertices in random order, and its triangles reordered for the post-transform vertex cache, as the objRenderer program reorders them: the vertices are in first-use order, and at least a third fewer bytes are fetched.
+	const int side = 100;
+	vector<DWORD> gridIndices;
+	vector<VERTEX> gridVertices = GridVertices(side, 5, gridIndices);
+	int primitivesTotal = (int)gridIndices.size() / 3;
+	OptimizeVertexCache(gridIndices.data(), primitivesTotal, side * side);
+	vector<VERTEX> oldGridVertices = gridVertices;
+	vector<DWORD> oldGridIndices = gridIndices;
+	VertexFetchStatistics before, after;
+	AnalyzeVertexFetch(gridIndices.data(), primitivesTotal, side * side, sizeof(VERTEX), before);
+	OptimizeVertexFetch(gridVertices.data(), gridIndices.data(), primitivesTotal, side * side);
+	AnalyzeVertexFetch(gridIndices.data(), primitivesTotal, side * side, sizeof(VERTEX), after);
+	printf("Grid of %d vertices: overfetch %.3f in random order, %.3f optimized\n", side * side, before.Overfetch, after.Overfetch);
+	CHECK(FirstUseOrder(gridIndices));
+	CHECK(SameAttributes(oldGridVertices, oldGridIndices, gridVertices, gridIndices));
+	CHECK(after.BytesFetched * 3 < before.BytesFetched * 2);
+
+	// Vertices already in first-use order are not changed, and fetch no more bytes.
+	vector<VERTEX> again = gridVertices;
+	vector<DWORD> againIndices = gridIndices;
+	OptimizeVertexFetch(again.data(), againIndices.data(), primitivesTotal, side * side);
+	VertexFetchStatistics againStatistics;
+	AnalyzeVertexFetch(againIndices.data(), primitivesTotal, side * side, sizeof(VERTEX), againStatistics);
+	CHECK(againIndices == gridIndices && std::memcmp(again.data(), gridVertices.data(), gridVertices.size() * sizeof(VERTEX)) == 0 && againStatistics.BytesFetched == after.BytesFetched);
+
+	// The same grid, with its triangles in random order: the fetch metric is no worse after reordering the vertices.
+	vector<DWORD> shuffledIndices;
+	vector<VERTEX> shuffledVertices = GridVertices(side, 13, shuffledIndices);
+	ShuffleTriangles(shuffledIndices, 17);
+	AnalyzeVertexFetch(shuffledIndices.data(), primitivesTotal, side * side, sizeof(VERTEX), before);
+	OptimizeVertexFetch(shuffledVertices.data(), shuffledIndices.data(), primitivesTotal, side * side);
+	AnalyzeVertexFetch(shuffledIndices.data(), primitivesTotal, side * side, sizeof(VERTEX), after);
+	CHECK(after.BytesFetched <= before.BytesFetched);
+}
+
+// main function: Definition
+int main()
+{
+	TestAnalyzeVertexCache();
+	TestOptimizeVertexCache();
+	TestAnalyzeVertexFetch();
+	TestOptimizeVertexFetch();
+	return TestResult();
+}
+
+// End: Function Definitions.
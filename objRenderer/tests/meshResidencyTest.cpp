@@ -0,0 +1,241 @@
+// meshResidencyTest
+// Version 3.1
+//
+// Description
+// Tests that vertex attributes and indices compressed by the CompressVertexWords and CompressIndexWords functions are decompressed by the DecompressWords function to exactly the words compressed:
+// the vertex attributes and indices of a grid loaded from a Wavefront .obj file, which compress to well under their size, words of random bits, which do not compress, indices that jump by the largest differences of either sign,
+// and empty arrays. Compressed words that are cut short, followed by extra bytes, or hold a variable-length integer longer than 32 bits are rejected.
+// It also tests that the LoadObj function frees every variable it used while parsing (the parse temporaries: the intermediate arrays, the hash tables and their arena, and the chunks of each thread) before it returns,
+// so the only memory it leaves allocated is the Mesh it returns, which the objRenderer program's MeshResidencyPolicy then keeps, drops, or compresses. The memory allocated is counted by replacing the global operator new and delete.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Test check Header File.
+#include "testCheck.h"
+
+// Mesh residency Header File.
+#include "meshResidency.h"
+
+// Wavefront .obj file I/O Header File.
+#include "objReader.h"
+
+// Standard Encapsulated Data and Functions for Manipulating String Data.
+#include <string>											// String class, used to build the Wavefront .obj file.
+
+// File Stream Functions.
+#include <fstream>											// File stream class member functions write, close, etc.
+
+// File System Functions.
+#include <filesystem>										// File system function remove.
+
+// Dynamic Memory.
+#include <new>												// Operator new and delete, bad_alloc, align_val_t.
+
+// Standard Library Functions.
+#include <cstdlib>											// aligned_alloc, free.
+
+// Atomic Operations.
+#include <atomic>											// Atomic class, used to count the bytes allocated by every thread.
+
+// Random Number Generation.
+#include <random>											// Mersenne twister engine.
+
+// Algorithms.
+#include <algorithm>										// Algorithm equal.
+
+// Using Declarations and Directives.
+using std::vector;
+using std::string;
+namespace fs = std::filesystem;
+
+// The Wavefront .obj file the test writes and loads, in the current directory.
+static const char* const TestFileName = "meshResidencyTest.obj";
+
+// The number of bytes allocated with the global operator new and not yet deleted.
+static std::atomic<long long> TestLiveBytes(0);
+
+// The size of the header before each allocation, which holds its size: a multiple of every alignment the test allocates with.
+static const size_t TestHeaderBytes = 64;
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// TestAllocate function: Definition
+//   This function allocates Size bytes, aligned to TestHeaderBytes, after a header holding Size, and counts them.
+static void* TestAllocate(size_t Size)
+{
+	void* block = aligned_alloc(TestHeaderBytes, (TestHeaderBytes + Size + TestHeaderBytes - 1) / TestHeaderBytes * TestHeaderBytes);
+	if (block == nullptr)
+		throw std::bad_alloc();
+	*(size_t*)block = Size;
+	TestLiveBytes += (long long)Size;
+	return (unsigned char*)block + TestHeaderBytes;
+}
+
+// TestFree function: Definition
+static void TestFree(void* Pointer)
+{
+	if (Pointer == nullptr)
+		return;
+	void* block = (unsigned char*)Pointer - TestHeaderBytes;
+	TestLiveBytes -= (long long)*(size_t*)block;
+	free(block);
+}
+
+// The global operator new and delete, replaced to count the bytes allocated. Alignments up to TestHeaderBytes are met by every allocation.
+void* operator new(size_t Size) { return TestAllocate(Size); }
+void* operator new[](size_t Size) { return TestAllocate(Size); }
+void* operator new(size_t Size, std::align_val_t) { return TestAllocate(Size); }
+void* operator new[](size_t Size, std::align_val_t) { return TestAllocate(Size); }
+void operator delete(void* Pointer) noexcept { TestFree(Pointer); }
+void operator delete[](void* Pointer) noexcept { TestFree(Pointer); }
+void operator delete(void* Pointer, size_t) noexcept { TestFree(Pointer); }
+void operator delete[](void* Pointer, size_t) noexcept { TestFree(Pointer); }
+void operator delete(void* Pointer, std::align_val_t) noexcept { TestFree(Pointer); }
+void operator delete[](void* Pointer, std::align_val_t) noexcept { TestFree(Pointer); }
+void operator delete(void* Pointer, size_t, std::align_val_t) noexcept { TestFree(Pointer); }
+void operator delete[](void* Pointer, size_t, std::align_val_t) noexcept { TestFree(Pointer); }
+
+// Write a Wavefront .obj file of a flat Size x Size grid of squares, each of two triangles, with a texture coordinate per vertex and one normal vector.
+static bool WriteGrid(int Size)
+{
+	string text;
+	for (int y = 0; y <= Size; y++)
+		for (int x = 0; x <= Size; x++)
+			text += "v " + std::to_string(x * 0.25) + " " + std::to_string(y * 0.25) + " 0\nvt " + std::to_string((double)x / Size) + " " + std::to_string((double)y / Size) + "\n";
+	text += "vn 0 0 1\n";
+	for (int y = 0; y < Size; y++)
+		for (int x = 0; x < Size; x++)
+		{
+			int a = y * (Size + 1) + x + 1, b = a + 1, c = a + Size + 1, d = c + 1;
+			text += "f " + std::to_string(a) + "/" + std::to_string(a) + "/1 " + std::to_string(b) + "/" + std::to_string(b) + "/1 " + std::to_string(d) + "/" + std::to_string(d) + "/1\n";
+			text += "f " + std::to_string(a) + "/" + std::to_string(a) + "/1 " + std::to_string(d) + "/" + std::to_string(d) + "/1 " + std::to_string(c) + "/" + std::to_string(c) + "/1\n";
+		}
+	std::ofstream file(TestFileName, std::ios::out | std::ios::binary | std::ios::trunc);
+	file << text;
+	file.close();
+	return (bool)file;
+}
+
+// Compress WordsTotal words, as vertex attributes of Stride words per vertex, or as indices if Stride is 0, decompress them, and check that they are the same. Return the size of the compressed words, in bytes.
+static size_t RoundTrip(const unsigned int* Words, size_t WordsTotal, int Stride, const char* Description)
+{
+	CompressedWords compressed;
+	if (Stride == 0)
+		CompressIndexWords(Words, WordsTotal, compressed);
+	else
+		CompressVertexWords(Words, WordsTotal, Stride, compressed);
+	vector<unsigned int> decompressed(WordsTotal + 1, 0xDEADBEEF);	// One word more, which must not be written.
+	bool same = CHECK(compressed.WordsTotal == WordsTotal && compressed.Stride == Stride) && CHECK(DecompressWords(compressed, decompressed.data()) == 0) &&
+		CHECK(std::equal(Words, Words + WordsTotal, decompressed.begin()) && decompressed[WordsTotal] == 0xDEADBEEF);
+	printf("%s: %zu words, %zu bytes compressed to %zu (%.0f%%)%s\n", Description, WordsTotal, WordsTotal * 4, compressed.Data.size(),
+		WordsTotal > 0 ? 100.0 * compressed.Data.size() / (WordsTotal * 4.0) : 0.0, same ? "" : ", not the same");
+	return compressed.Data.size();
+}
+
+// The vertex attributes and indices of a grid, random words, extreme indices, and empty arrays, round trip exactly.
+static void TestRoundTrips(const Mesh& Grid)
+{
+	const int vertexWords = sizeof(VERTEX) / sizeof(unsigned int);
+	size_t verticesBytes = Grid.Vertices.size() * sizeof(VERTEX), indicesBytes = Grid.Indices.size() * sizeof(DWORD);
+	CHECK(RoundTrip((const unsigned int*)Grid.Vertices.data(), Grid.Vertices.size() * vertexWords, vertexWords, "Grid vertex attributes") < verticesBytes * 6 / 10);
+	CHECK(RoundTrip((const unsigned int*)Grid.Indices.data(), Grid.Indices.size(), 0, "Grid indices") < indicesBytes / 2);
+
+	// Random words take up to 5 bytes each, and cannot be compressed.
+	std::mt19937 random(24);
+	vector<unsigned int> words(9000);
+	for (unsigned int& word : words)
+		word = (unsigned int)random();
+	CHECK(RoundTrip(words.data(), words.size(), vertexWords, "Random vertex attributes") <= words.size() * 5);
+	CHECK(RoundTrip(words.data(), words.size(), 1, "Random words, stride 1") <= words.size() * 5);
+	CHECK(RoundTrip(words.data(), words.size(), 0, "Random indices") <= words.size() * 5);
+
+	// The largest differences between indices, of either sign, wrap modulo 2 to the power of 32.
+	const unsigned int extremes[] = { 0, 0xFFFFFFFF, 0, 0x80000000, 0x7FFFFFFF, 1, 0xFFFFFFFE, 0x80000001, 0, 0 };
+	RoundTrip(extremes, sizeof(extremes) / sizeof(extremes[0]), 0, "Extreme indices");
+	RoundTrip(extremes, sizeof(extremes) / sizeof(extremes[0]), 3, "Extreme vertex attributes, stride 3");	// Fewer words than two vertices, and not a whole number of vertices.
+
+	CHECK(RoundTrip(nullptr, 0, vertexWords, "No vertex attributes") == 0);
+	CHECK(RoundTrip(nullptr, 0, 0, "No indices") == 0);
+}
+
+// Compressed words that are damaged are rejected.
+static void TestDamaged()
+{
+	const unsigned int indices[] = { 5, 3000000000u, 7, 7, 100000 };
+	CompressedWords compressed;
+	CompressIndexWords(indices, 5, compressed);
+	unsigned int words[5];
+
+	CompressedWords damaged = compressed;
+	damaged.Data.pop_back();
+	CHECK(DecompressWords(damaged, words) == 1);			// Cut short.
+	damaged = compressed;
+	damaged.Data.push_back(0);
+	CHECK(DecompressWords(damaged, words) == 1);			// Followed by an extra byte.
+	damaged = compressed;
+	damaged.WordsTotal = 1;
+	damaged.Data.assign({ 0x80, 0x80, 0x80, 0x80, 0x80, 0x01 });
+	CHECK(DecompressWords(damaged, words) == 1);			// A variable-length integer of 6 bytes.
+	CHECK(DecompressWords(compressed, words) == 0 && std::equal(words, words + 5, indices));
+}
+
+// The memory the LoadObj function leaves allocated is exactly the capacity of the vertex attributes and indices it returns, whichever parser, and however many threads, parse the file.
+static void TestParseTemporaries()
+{
+	LoadObjOptions mapped;
+	mapped.Threads = 1;
+	LoadObjOptions stream;
+	stream.MemoryMapped = false;
+	LoadObjOptions chunked;
+	chunked.Threads = 4;
+	chunked.MinimumChunkBytes = 4096;
+	const LoadObjOptions* options[] = { &mapped, &stream, &chunked };
+	const char* names[] = { "memory-mapped", "stream", "memory-mapped, 4 threads" };
+	for (int o = 0; o < 3; o++)
+	{
+		// The first load may allocate memory the C++ library keeps, e.g., for the locale of the stream parser, so only the second is counted.
+		for (int load = 0; load < 2; load++)
+		{
+			long long before = TestLiveBytes;
+			Mesh mesh;
+			LoadObjStatistics statistics;
+			if (!CHECK(LoadObj(TestFileName, *options[o], mesh, &statistics) == 0))
+				return;
+			long long left = TestLiveBytes - before;
+			long long meshBytes = (long long)(mesh.Vertices.capacity() * sizeof(VERTEX) + mesh.Indices.capacity() * sizeof(DWORD));
+			if (load == 0)
+				continue;
+			printf("LoadObj, %s parser: %lld bytes left allocated, %lld of them the mesh; %zu bytes of intermediate arrays and %zu of hash tables freed\n", names[o], left, meshBytes,
+				statistics.IntermediateBytes, statistics.ArenaBytes);
+			CHECK(left == meshBytes);
+			CHECK(statistics.IntermediateBytes > 0 && statistics.ArenaBytes > 0);
+		}
+	}
+}
+
+// main function: Definition
+int main()
+{
+	Mesh grid;
+	LoadObjOptions options;
+	if (!CHECK(WriteGrid(100)) || !CHECK(LoadObj(TestFileName, options, grid) == 0) || !CHECK(grid.PrimitivesTotal == 20000))
+		return TestResult();
+	TestRoundTrips(grid);
+	TestDamaged();
+	TestParseTemporaries();
+
+	std::error_code error;
+	fs::remove(TestFileName, error);
+	return TestResult();
+}
+
+// End: Function Definitions.
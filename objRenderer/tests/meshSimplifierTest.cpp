@@ -0,0 +1,98 @@
+// meshSimplifierTest
+// Version 3.1
+//
+// Description
+// Tests that the SimplifyMesh function, which divides its work among the job system's threads with the JobParallelFor function, simplifies a mesh to the same triangles with one thread and with several,
+// and that the triangles it returns are valid: at most the target number, each referring to the mesh's vertices, and none collapsed to a line.
+// The mesh is a noisy scan generated by the GenerateObj function, large enough that the work is divided into several ranges.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Test check Header File.
+#include "testCheck.h"
+
+// Mesh simplification Header File.
+#include "meshSimplifier.h"
+
+// Job system Header File.
+#include "jobSystem.h"
+
+// Wavefront .obj file benchmark Header File.
+// Declares the GenerateObj function.
+#include "objReaderBenchmark.h"
+
+// File System Functions.
+#include <filesystem>										// File system function remove.
+
+// Using Declarations and Directives.
+using std::vector;
+namespace fs = std::filesystem;
+
+// The Wavefront .obj file generated, in the current directory.
+static const char* const TestFileName = "meshSimplifierTest.obj";
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// Simplify Source to at most TargetPrimitivesTotal triangles with ThreadsTotal job system threads, and return the triangles in Result and their geometric error in Error.
+static int SimplifyWithThreads(const Mesh& Source, int TargetPrimitivesTotal, int ThreadsTotal, vector<DWORD>& Result, float& Error)
+{
+	JobSystemShutdown();									// JobSystemThreads is read when the job system is started.
+	JobSystemThreads = ThreadsTotal;
+	int primitivesTotal = SimplifyMesh(Source.Vertices.data(), Source.VertexAttributeSetsTotal, Source.Indices.data(), Source.PrimitivesTotal, TargetPrimitivesTotal, Result, Error);
+	CHECK(JobSystemThreadsTotal() == ThreadsTotal);
+	return primitivesTotal;
+}
+
+// main function: Definition
+int main()
+{
+	ObjGeneratorOptions generator;
+	generator.Shape = OBJ_SHAPE_SCAN;
+	generator.TrianglesTotal = 80000;						// About 40000 positions, so each pass is divided into ranges of at least MeshSimplifierParallelMinimum (16384) positions.
+	Mesh source;
+	LoadObjOptions options;
+	if (!CHECK(GenerateObj(TestFileName, generator) == 0) || !CHECK(LoadObj(TestFileName, options, source) == 0))
+		return TestResult();
+	std::error_code error;
+	fs::remove(TestFileName, error);
+
+	int target = source.PrimitivesTotal / 4;
+	vector<DWORD> oneThread, eightThreads;
+	float oneThreadError = 0.0f, eightThreadsError = 0.0f;
+	int oneThreadTotal = SimplifyWithThreads(source, target, 1, oneThread, oneThreadError);
+	int eightThreadsTotal = SimplifyWithThreads(source, target, 8, eightThreads, eightThreadsError);
+
+	// The same triangles, in the same order, with the same geometric error.
+	CHECK(oneThreadTotal == eightThreadsTotal);
+	CHECK(oneThread == eightThreads);
+	CHECK(oneThreadError == eightThreadsError);
+
+	// At most the target number of triangles, but not simplified to nothing.
+	CHECK(eightThreadsTotal <= target);
+	CHECK(eightThreadsTotal > target / 2);
+	CHECK(eightThreads.size() == (size_t)eightThreadsTotal * 3);
+	CHECK(eightThreadsError > 0.0f);
+
+	// Every triangle refers to three different vertices of the mesh.
+	bool valid = true;
+	for (size_t t = 0; t + 2 < eightThreads.size(); t += 3)
+	{
+		DWORD a = eightThreads[t], b = eightThreads[t + 1], c = eightThreads[t + 2];
+		valid = valid && a < (DWORD)source.VertexAttributeSetsTotal && b < (DWORD)source.VertexAttributeSetsTotal && c < (DWORD)source.VertexAttributeSetsTotal && a != b && b != c && c != a;
+	}
+	CHECK(valid);
+
+	JobSystemShutdown();
+	return TestResult();
+}
+
+// End: Function Definitions.
@@ -0,0 +1,251 @@
+// meshUploadTest
+// Version 3.1
+//
+// Description
+// Tests the mesh upload manager without a device: the uploads each call of the MeshUploadFrame function plans are made to buffers in memory, which must end up holding exactly the data queued.
+// An immutable buffer that does not fit in what is left of the frame budget waits for the next frame, and so does every buffer queued after it, even one that would fit.
+// A buffer larger than the frame budget is staged in pieces, copied to consecutive offsets of the buffer, and written to consecutive offsets of the staging buffer within a frame.
+// A frame budget of 0 uploads every buffer, however large, as an immutable buffer in one frame. No frame uploads more than the frame budget, and the Frames, Copies, BytesUploaded, and LargestFrameBytes statistics count the uploads planned.
+// The data of each upload remains valid until the next call of the MeshUploadFrame function, even once the buffer is completely uploaded.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Test check Header File.
+#include "testCheck.h"
+
+// Mesh upload manager Header File.
+#include "meshUpload.h"
+
+// Standard Encapsulated Data and Functions for Manipulating String Data.
+#include <string>											// String class, used to describe each frame's uploads.
+
+// Map Container Class.
+#include <map>												// Map class, used to hold the buffers uploaded to, by identifier.
+
+// Algorithms.
+#include <algorithm>										// Algorithm equal.
+
+// Using Declarations and Directives.
+using std::vector;
+using std::map;
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// Declare the TestUploads 'named structure' data type.
+// The buffers queued by the test, and the buffers in memory the uploads planned are made to, in place of GPU memory.
+struct TestUploads {
+	MeshUploader Uploader;
+	map<int, vector<unsigned char>> Queued;					// The data of each buffer queued.
+	map<int, vector<unsigned char>> Buffers;				// The buffers created, with the data copied to them.
+	map<int, MeshUploadMethod> Methods;						// The method each buffer was created with.
+	map<int, bool> Completed;								// True once the last upload of a buffer is planned.
+	bool Valid = true;										// False if any upload planned breaks the rules of the MeshUploadCopy structure.
+
+	TestUploads(size_t FrameBudget) { CreateMeshUploader(Uploader, FrameBudget); }
+
+	// Queue buffer Buffer, of Size bytes of data that differ from every other buffer's.
+	void Enqueue(int Buffer, size_t Size)
+	{
+		vector<unsigned char> data(Size);
+		for (size_t b = 0; b < Size; b++)
+			data[b] = (unsigned char)(b * 7 + Buffer * 31 + (b >> 8));
+		Queued[Buffer] = data;
+		MeshUploadEnqueue(Uploader, Buffer, data);
+		Valid = Valid && data.empty();
+	}
+
+	// Plan one frame's uploads and make them. Return the uploads planned.
+	vector<MeshUploadCopy> Frame()
+	{
+		vector<MeshUploadCopy> copies;
+		MeshUploadFrame(Uploader, copies);
+		size_t frameBytes = 0, staged = 0;
+		for (const MeshUploadCopy& copy : copies)
+		{
+			const vector<unsigned char>& queued = Queued[copy.Buffer];
+			Valid = Valid && !Completed[copy.Buffer] && copy.BufferSize == queued.size() && copy.Offset + copy.Size <= queued.size() && copy.Size > 0;
+			if (copy.Create)
+			{
+				Valid = Valid && Buffers.count(copy.Buffer) == 0 && copy.Offset == 0;
+				Buffers[copy.Buffer].assign(copy.BufferSize, 0);
+				Methods[copy.Buffer] = copy.Method;
+			}
+			else
+				Valid = Valid && Buffers.count(copy.Buffer) == 1 && Methods[copy.Buffer] == copy.Method && copy.Method == MESH_UPLOAD_STAGED;
+			if (copy.Method == MESH_UPLOAD_IMMUTABLE)
+				Valid = Valid && copy.Create && copy.Complete && copy.Offset == 0 && copy.Size == copy.BufferSize;
+			else
+			{
+				Valid = Valid && copy.StagingOffset == staged;	// Each piece follows the previous one in the staging buffer.
+				staged += copy.Size;
+			}
+
+			// The data of the upload, checked and copied after the MeshUploadFrame function has returned, as the objRenderer program copies it.
+			if (!Buffers[copy.Buffer].empty() && copy.Offset + copy.Size <= Buffers[copy.Buffer].size())
+			{
+				vector<unsigned char>& buffer = Buffers[copy.Buffer];
+				Valid = Valid && std::equal(copy.Data, copy.Data + copy.Size, queued.begin() + copy.Offset);
+				std::copy(copy.Data, copy.Data + copy.Size, buffer.begin() + copy.Offset);
+			}
+			Completed[copy.Buffer] = copy.Complete;
+			if (copy.Complete)
+				Valid = Valid && Buffers[copy.Buffer] == queued;
+			frameBytes += copy.Size;
+		}
+		if (Uploader.FrameBudget != 0)
+			Valid = Valid && frameBytes <= Uploader.FrameBudget && staged <= Uploader.FrameBudget;
+		return copies;
+	}
+
+	// Check that every buffer queued was uploaded exactly, and that every upload planned was valid.
+	bool Done() const
+	{
+		bool done = Valid && !MeshUploadPending(Uploader) && Buffers.size() == Queued.size();
+		for (const auto& queued : Queued)
+			done = done && Buffers.count(queued.first) == 1 && Buffers.at(queued.first) == queued.second && Completed.at(queued.first);
+		return done;
+	}
+};
+
+// Return a string of the buffers, and the offsets and sizes of the pieces of staged buffers, uploaded by Copies, e.g., "1 2 3[0+100]".
+static std::string Describe(const vector<MeshUploadCopy>& Copies)
+{
+	std::string text;
+	for (const MeshUploadCopy& copy : Copies)
+	{
+		if (!text.empty())
+			text += " ";
+		text += std::to_string(copy.Buffer);
+		if (copy.Method == MESH_UPLOAD_STAGED)
+			text += "[" + std::to_string(copy.Offset) + "+" + std::to_string(copy.Size) + "]";
+	}
+	return text;
+}
+
+// Plan a frame's uploads, and check that they are Expected. Print them if not.
+static void CheckFrame(TestUploads& Uploads, const char* Expected)
+{
+	std::string uploaded = Describe(Uploads.Frame());
+	if (!CHECK(uploaded == Expected))
+		printf("Frame %llu: uploaded \"%s\", expected \"%s\"\n", Uploads.Uploader.Frames, uploaded.c_str(), Expected);
+}
+
+// An immutable buffer that does not fit in what is left of the budget waits for the next frame, and so does every buffer queued after it.
+static void TestDeferred()
+{
+	TestUploads uploads(1000);
+	uploads.Enqueue(1, 600);
+	uploads.Enqueue(2, 500);								// Does not fit after buffer 1.
+	uploads.Enqueue(3, 100);								// Would fit after buffer 1, but must not be uploaded before buffer 2.
+	uploads.Enqueue(4, 1000);								// Exactly the budget.
+	uploads.Enqueue(5, 400);
+	CheckFrame(uploads, "1");
+	CHECK(uploads.Uploader.Pending.size() == 4 && uploads.Uploader.Pending.front().Buffer == 2);
+	CheckFrame(uploads, "2 3");
+	CheckFrame(uploads, "4");
+	CheckFrame(uploads, "5");
+	CHECK(uploads.Done());
+
+	// A frame with nothing to upload plans nothing, and is not counted.
+	CheckFrame(uploads, "");
+	const MeshUploader& uploader = uploads.Uploader;
+	CHECK(uploader.Frames == 4 && uploader.Copies == 5 && uploader.BytesUploaded == 2600 && uploader.LargestFrameBytes == 1000);
+	CHECK(uploader.BuffersImmutable == 5 && uploader.BuffersStaged == 0);
+}
+
+// A buffer larger than the budget is staged in pieces of at most the budget, the pieces of a frame following each other in the staging buffer, and the budget it leaves is used by the buffers after it.
+static void TestStaged()
+{
+	TestUploads uploads(1000);
+	uploads.Enqueue(1, 2500);
+	uploads.Enqueue(2, 300);
+	uploads.Enqueue(3, 1200);
+	uploads.Enqueue(4, 200);
+	uploads.Enqueue(5, 900);
+	CHECK(uploads.Uploader.Pending[0].Method == MESH_UPLOAD_STAGED && uploads.Uploader.Pending[1].Method == MESH_UPLOAD_IMMUTABLE && uploads.Uploader.Pending[2].Method == MESH_UPLOAD_STAGED);
+	CheckFrame(uploads, "1[0+1000]");
+	CheckFrame(uploads, "1[1000+1000]");
+	CheckFrame(uploads, "1[2000+500] 2 3[0+200]");			// Two pieces, at staging offsets 0 and 500, around an immutable buffer.
+	CheckFrame(uploads, "3[200+1000]");
+	CheckFrame(uploads, "4");								// Buffer 5 does not fit after buffer 4.
+	CheckFrame(uploads, "5");
+	CHECK(uploads.Done());
+	const MeshUploader& uploader = uploads.Uploader;
+	CHECK(uploader.Frames == 6 && uploader.Copies == 8 && uploader.BytesUploaded == 5100 && uploader.LargestFrameBytes == 1000);
+	CHECK(uploader.BuffersImmutable == 3 && uploader.BuffersStaged == 2);
+
+	// Two staged buffers share the staging buffer in the frame that completes the first and starts the second.
+	TestUploads again(1000);
+	again.Enqueue(1, 1500);
+	again.Enqueue(2, 1100);
+	again.Frame();
+	vector<MeshUploadCopy> copies = again.Frame();
+	CHECK(copies.size() == 2 && copies[0].StagingOffset == 0 && copies[0].Size == 500 && copies[0].Complete && copies[1].StagingOffset == 500 && copies[1].Size == 500 && copies[1].Create && !copies[1].Complete);
+	copies = again.Frame();
+	CHECK(copies.size() == 1 && copies[0].StagingOffset == 0 && copies[0].Offset == 500 && copies[0].Size == 600 && copies[0].Complete);
+	CHECK(again.Done());
+}
+
+// A budget of 0 uploads every buffer queued, however large, as an immutable buffer in the next frame.
+static void TestUnlimited()
+{
+	TestUploads uploads(0);
+	uploads.Enqueue(1, 5000000);
+	uploads.Enqueue(2, 12);
+	uploads.Enqueue(3, 3000000);
+	CheckFrame(uploads, "1 2 3");
+	CHECK(uploads.Done());
+	const MeshUploader& uploader = uploads.Uploader;
+	CHECK(uploader.Frames == 1 && uploader.Copies == 3 && uploader.BytesUploaded == 8000012 && uploader.LargestFrameBytes == 8000012 && uploader.BuffersImmutable == 3);
+}
+
+// The data of every upload of a frame, including the buffers it completes, remains valid until the next call of the MeshUploadFrame function: it is held by the Completed or Pending buffers, not freed.
+static void TestDataValid()
+{
+	TestUploads uploads(100000);
+	for (int b = 1; b <= 200; b++)
+		uploads.Enqueue(b, 100 + b * 3);					// Many buffers completed in one frame, so the Completed vector grows while the frame is planned.
+	uploads.Enqueue(201, 250000);
+	for (int frame = 0; frame < 4; frame++)
+	{
+		vector<MeshUploadCopy> copies = uploads.Frame();	// Checks the data of each upload after the frame is planned.
+		const MeshUploader& uploader = uploads.Uploader;
+		bool held = true;
+		for (const MeshUploadCopy& copy : copies)
+		{
+			bool found = false;
+			for (const MeshUploadRequest& request : uploader.Completed)
+				found = found || (request.Buffer == copy.Buffer && copy.Data == request.Data.data() + copy.Offset);
+			for (const MeshUploadRequest& request : uploader.Pending)
+				found = found || (request.Buffer == copy.Buffer && copy.Data == request.Data.data() + copy.Offset);
+			held = held && found;
+		}
+		CHECK(held);
+		if (frame == 0)
+			CHECK(uploader.Completed.size() == 200 && copies.size() == 201);
+	}
+	CHECK(uploads.Done());
+	CHECK(uploads.Uploader.Completed.size() == 1);
+	CHECK(uploads.Frame().empty() && uploads.Uploader.Completed.empty());	// The next frame plans nothing, and frees the buffer completed by the last.
+}
+
+// main function: Definition
+int main()
+{
+	TestDeferred();
+	TestStaged();
+	TestUnlimited();
+	TestDataValid();
+	return TestResult();
+}
+
+// End: Function Definitions.
@@ -0,0 +1,301 @@
+// meshletBuilderTest
+// Version 3.1
+//
+// Description
+// Tests that the BuildMeshlets function partitions the triangles of a grid, and of random triangles, into meshlets of consecutive triangles that cover each triangle exactly once,
+// each with at most MESHLET_VERTICES_MAXIMUM distinct vertices and MESHLET_PRIMITIVES_MAXIMUM triangles, each as long as those limits allow, and each with bounds that contain every vertex of its triangles.
+// It also tests that the CullMeshlets function culls the meshlets whose bounding sphere is outside the viewing frustum, and keeps those it crosses, and that it culls a flat patch seen from behind and keeps it seen from the front.
+// A meshlet whose triangles face in directions further apart than MESHLET_CONE_MINIMUM_SPREAD allows is never culled as facing away, from wherever it is seen; one just within it is culled from behind.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Test check Header File.
+#include "testCheck.h"
+
+// Meshlet (cluster) Header File.
+#include "meshletBuilder.h"
+
+// Vector Container Class.
+#include <vector>											// Vector class, used to hold the meshes and meshlets built.
+
+// Random Number Generation.
+#include <random>											// Mersenne twister engine.
+
+// Mathematical Functions.
+#include <cmath>											// Mathematical functions sqrt, sin, cos.
+
+// Using Declarations and Directives.
+using std::vector;
+
+// The location in the index buffer of the triangles partitioned, as if they followed another mesh's.
+static const int TestFirstIndex = 300;
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// Declare the TestMesh 'named structure' data type.
+// The vertices and indices of the triangles partitioned into meshlets.
+struct TestMesh {
+	vector<VERTEX> Vertices;
+	vector<DWORD> Indices;
+
+	int AddVertex(float X, float Y, float Z)
+	{
+		VERTEX vertex = {};
+		vertex.GeometricVertex = XMFLOAT3(X, Y, Z);
+		Vertices.push_back(vertex);
+		return (int)Vertices.size() - 1;
+	}
+
+	void AddTriangle(int A, int B, int C)
+	{
+		Indices.push_back((DWORD)A);
+		Indices.push_back((DWORD)B);
+		Indices.push_back((DWORD)C);
+	}
+
+	int PrimitivesTotal() const { return (int)Indices.size() / 3; }
+};
+
+// Add to Mesh a flat Size x Size patch of squares of side 1, each of two triangles, centered on (X, Y, Z) in a plane of constant z, its triangles facing +z (away from a camera at a smaller z) or, if Front, -z.
+static void AddPatch(TestMesh& Mesh, int Size, float X, float Y, float Z, bool Front)
+{
+	int first = (int)Mesh.Vertices.size();
+	for (int y = 0; y <= Size; y++)
+		for (int x = 0; x <= Size; x++)
+			Mesh.AddVertex(X + x - Size / 2.0f, Y + y - Size / 2.0f, Z);
+	for (int y = 0; y < Size; y++)
+		for (int x = 0; x < Size; x++)
+		{
+			int a = first + y * (Size + 1) + x, b = a + 1, c = a + Size + 1, d = c + 1;
+			if (Front)
+			{
+				Mesh.AddTriangle(a, c, b);
+				Mesh.AddTriangle(b, c, d);
+			}
+			else
+			{
+				Mesh.AddTriangle(a, b, c);
+				Mesh.AddTriangle(b, d, c);
+			}
+		}
+}
+
+// Return the number of distinct vertices of the PrimitivesTotal triangles of Indices.
+static int DistinctVertices(const DWORD* Indices, int PrimitivesTotal, vector<int>& Seen, int& Stamp)
+{
+	Stamp++;
+	int distinct = 0;
+	for (int i = 0; i < PrimitivesTotal * 3; i++)
+		if (Seen[Indices[i]] != Stamp)
+		{
+			Seen[Indices[i]] = Stamp;
+			distinct++;
+		}
+	return distinct;
+}
+
+// Partition the triangles of Mesh into meshlets, and check that they cover each triangle once, in order, within the limits, as long as the limits allow, with bounds that contain their vertices.
+static void CheckPartition(const TestMesh& Mesh, const char* Description)
+{
+	vector<Meshlet> meshlets;
+	BuildMeshlets(Mesh.Vertices.data(), (int)Mesh.Vertices.size(), Mesh.Indices.data(), TestFirstIndex, Mesh.PrimitivesTotal(), meshlets);
+
+	vector<int> seen(Mesh.Vertices.size(), -1);
+	int stamp = 0;
+	int nextIndex = TestFirstIndex;
+	bool covered = true, limited = true, longest = true, counted = true, bounded = true;
+	for (size_t m = 0; m < meshlets.size(); m++)
+	{
+		const Meshlet& meshlet = meshlets[m];
+		covered = covered && meshlet.FirstIndex == nextIndex && meshlet.PrimitivesTotal > 0;
+		nextIndex = meshlet.FirstIndex + meshlet.PrimitivesTotal * 3;
+		const DWORD* indices = Mesh.Indices.data() + (meshlet.FirstIndex - TestFirstIndex);
+		int distinct = DistinctVertices(indices, meshlet.PrimitivesTotal, seen, stamp);
+		counted = counted && meshlet.VerticesTotal == distinct;
+		limited = limited && distinct <= MESHLET_VERTICES_MAXIMUM && meshlet.PrimitivesTotal <= MESHLET_PRIMITIVES_MAXIMUM;
+
+		// The meshlet ends only where the next triangle would not fit.
+		if (m + 1 < meshlets.size() && meshlet.PrimitivesTotal < MESHLET_PRIMITIVES_MAXIMUM)
+			longest = longest && DistinctVertices(indices, meshlet.PrimitivesTotal + 1, seen, stamp) > MESHLET_VERTICES_MAXIMUM;
+
+		for (int i = 0; i < meshlet.PrimitivesTotal * 3; i++)
+		{
+			const XMFLOAT3& p = Mesh.Vertices[indices[i]].GeometricVertex;
+			float dx = p.x - meshlet.Center.x, dy = p.y - meshlet.Center.y, dz = p.z - meshlet.Center.z;
+			bounded = bounded && std::sqrt(dx * dx + dy * dy + dz * dz) <= meshlet.Radius * 1.0001f + 1.0e-5f &&
+				p.x >= meshlet.BoundsMinimum.x && p.y >= meshlet.BoundsMinimum.y && p.z >= meshlet.BoundsMinimum.z && p.x <= meshlet.BoundsMaximum.x && p.y <= meshlet.BoundsMaximum.y && p.z <= meshlet.BoundsMaximum.z;
+		}
+	}
+	printf("%s: %d triangles, %d vertices, %zu meshlets\n", Description, Mesh.PrimitivesTotal(), (int)Mesh.Vertices.size(), meshlets.size());
+	CHECK(covered && nextIndex == TestFirstIndex + (int)Mesh.Indices.size());
+	CHECK(limited);
+	CHECK(counted);
+	CHECK(longest);
+	CHECK(bounded);
+}
+
+// Add to Mesh PrimitivesTotal random triangles of VerticesTotal random vertices, every seventh of them repeating a vertex.
+static void AddRandom(TestMesh& Mesh, int VerticesTotal, int PrimitivesTotal, std::mt19937& Engine)
+{
+	int first = (int)Mesh.Vertices.size();
+	for (int v = 0; v < VerticesTotal; v++)
+		Mesh.AddVertex((float)(Engine() % 100), (float)(Engine() % 100), (float)(Engine() % 100));
+	for (int t = 0; t < PrimitivesTotal; t++)
+	{
+		int a = first + (int)(Engine() % VerticesTotal), b = first + (int)(Engine() % VerticesTotal), c = t % 7 == 0 ? a : first + (int)(Engine() % VerticesTotal);
+		Mesh.AddTriangle(a, b, c);
+	}
+}
+
+// A grid and random triangles of many vertices, limited by the number of vertices of a meshlet, and random triangles of fewer vertices than a meshlet may have, limited by the number of triangles.
+static void TestPartition()
+{
+	TestMesh grid, scattered, dense;
+	AddPatch(grid, 80, 0.0f, 0.0f, 0.0f, true);
+	CheckPartition(grid, "A grid of 80 x 80 squares");
+	std::mt19937 engine(11);
+	AddRandom(scattered, 500, 5000, engine);
+	CheckPartition(scattered, "Random triangles of 500 vertices");
+	AddRandom(dense, 40, 5000, engine);
+	CheckPartition(dense, "Random triangles of 40 vertices");
+
+	// A single triangle is one meshlet; no triangles are none.
+	TestMesh one;
+	AddPatch(one, 1, 0.0f, 0.0f, 0.0f, true);
+	vector<Meshlet> meshlets;
+	BuildMeshlets(one.Vertices.data(), (int)one.Vertices.size(), one.Indices.data(), 0, 1, meshlets);
+	CHECK(meshlets.size() == 1 && meshlets[0].PrimitivesTotal == 1 && meshlets[0].VerticesTotal == 3);
+	BuildMeshlets(one.Vertices.data(), (int)one.Vertices.size(), one.Indices.data(), 0, 0, meshlets);
+	CHECK(meshlets.size() == 1);
+}
+
+// Return the combined view and projection matrix of a camera at Eye looking at Focus, with a field of view of 90 degrees, from 1 to 1000 units away.
+static XMMATRIX TestCamera(FXMVECTOR Eye, FXMVECTOR Focus)
+{
+	return XMMatrixMultiply(XMMatrixLookAtLH(Eye, Focus, XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)), XMMatrixPerspectiveFovLH(XM_PIDIV2, 1.0f, 1.0f, 1000.0f));
+}
+
+// Build one meshlet of each patch of Patches (x, y, z of its center), facing a camera at (0, 0, -10) looking toward +z, cull them, and return the statistics and runs.
+static MeshletCullStatistics CullPatches(const XMFLOAT3* Patches, int PatchesTotal, vector<MeshletRun>& Runs)
+{
+	TestMesh mesh;
+	vector<Meshlet> meshlets;
+	for (int p = 0; p < PatchesTotal; p++)
+	{
+		size_t firstIndex = mesh.Indices.size();
+		AddPatch(mesh, 4, Patches[p].x, Patches[p].y, Patches[p].z, true);
+		BuildMeshlets(mesh.Vertices.data(), (int)mesh.Vertices.size(), mesh.Indices.data() + firstIndex, (int)firstIndex, mesh.PrimitivesTotal() - (int)firstIndex / 3, meshlets);
+	}
+	XMVECTOR eye = XMVectorSet(0.0f, 0.0f, -10.0f, 1.0f);
+	MeshletCullStatistics statistics;
+	CullMeshlets(meshlets.data(), (int)meshlets.size(), TestCamera(eye, XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f)), eye, Runs, statistics);
+	return statistics;
+}
+
+// Meshlets outside the viewing frustum are culled, and meshlets crossing it are kept. At z = 0 the frustum is 10 units either side of the axis, and each patch has a radius of 2.83.
+static void TestFrustum()
+{
+	const XMFLOAT3 patches[] = {
+		XMFLOAT3(0.0f, 0.0f, 0.0f),							// In front of the camera.
+		XMFLOAT3(-5.0f, 3.0f, 20.0f),						// In front of the camera, further away.
+		XMFLOAT3(11.5f, 0.0f, 0.0f),						// Its center is outside the right plane, by 1.06, less than its radius.
+		XMFLOAT3(15.0f, 0.0f, 0.0f),						// Outside the right plane, by 3.54.
+		XMFLOAT3(0.0f, -15.0f, 0.0f),						// Below the bottom plane.
+		XMFLOAT3(0.0f, 0.0f, -30.0f),						// Behind the camera.
+		XMFLOAT3(0.0f, 0.0f, 1500.0f),						// Beyond the far plane.
+		XMFLOAT3(0.0f, 0.0f, 5.0f),							// In front of the camera, after three culled meshlets.
+	};
+	vector<MeshletRun> runs;
+	MeshletCullStatistics statistics = CullPatches(patches, 8, runs);
+	CHECK(statistics.MeshletsTested == 8 && statistics.MeshletsOutsideFrustum == 4 && statistics.MeshletsFacingAway == 0);
+	CHECK(statistics.PrimitivesTested == 8 * 32 && statistics.PrimitivesDrawn == 4 * 32);
+	CHECK(runs.size() == 2 && statistics.Runs == 2);		// The first three patches are drawn together, and the last.
+	CHECK(runs.size() == 2 && runs[0].FirstIndex == 0 && runs[0].PrimitivesTotal == 3 * 32 && runs[1].FirstIndex == 7 * 32 * 3 && runs[1].PrimitivesTotal == 32);
+}
+
+// Return the statistics of culling one meshlet of Mesh, seen from Eye looking at the origin.
+static MeshletCullStatistics CullFrom(const TestMesh& Mesh, float EyeX, float EyeY, float EyeZ)
+{
+	vector<Meshlet> meshlets;
+	BuildMeshlets(Mesh.Vertices.data(), (int)Mesh.Vertices.size(), Mesh.Indices.data(), 0, Mesh.PrimitivesTotal(), meshlets);
+	XMVECTOR eye = XMVectorSet(EyeX, EyeY, EyeZ, 1.0f);
+	vector<MeshletRun> runs;
+	MeshletCullStatistics statistics;
+	CHECK(meshlets.size() == 1);
+	CullMeshlets(meshlets.data(), (int)meshlets.size(), TestCamera(eye, XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f)), eye, runs, statistics);
+	CHECK(statistics.MeshletsOutsideFrustum == 0);
+	return statistics;
+}
+
+// Add to Mesh a roof of two triangles, with sides Scale long, meeting along the y axis, facing +z on average, each tilted so that the cosine of the angle between its normal and +z is Spread.
+// The sides of a roof slope down, away from +z, so the triangles face away from each other; the sides of a valley slope up, so they face each other.
+static void AddRoof(TestMesh& Mesh, float Spread, float Scale, bool Valley)
+{
+	float c = Spread * Scale, s = std::sqrt(1.0f - Spread * Spread) * (Valley ? Scale : -Scale);
+	int ridge0 = Mesh.AddVertex(0.0f, 0.0f, 0.0f), ridge1 = Mesh.AddVertex(0.0f, Scale, 0.0f);
+	int right = Mesh.AddVertex(c, 0.0f, s), left = Mesh.AddVertex(-c, 0.0f, s);
+	Mesh.AddTriangle(ridge0, right, ridge1);				// Normal (s, 0, c) of a roof, (-s, 0, c) of a valley.
+	Mesh.AddTriangle(ridge0, ridge1, left);					// Normal (-s, 0, c) of a roof, (s, 0, c) of a valley.
+}
+
+// A flat patch is culled as facing away when seen from behind, also from an angle, and kept when seen from the front, or edge on.
+// A valley is culled from behind, and kept from inside it. A roof whose triangles face in directions just within MESHLET_CONE_MINIMUM_SPREAD is culled from behind; one just beyond it is never culled.
+static void TestNormalCone()
+{
+	TestMesh patch;
+	AddPatch(patch, 4, 0.0f, 0.0f, 0.0f, false);			// Facing +z.
+	CHECK(CullFrom(patch, 0.0f, 0.0f, -10.0f).MeshletsFacingAway == 1);
+	CHECK(CullFrom(patch, 6.0f, 3.0f, -10.0f).MeshletsFacingAway == 1);
+	CHECK(CullFrom(patch, 0.0f, 0.0f, 10.0f).MeshletsFacingAway == 0);
+	CHECK(CullFrom(patch, -6.0f, 3.0f, 10.0f).MeshletsFacingAway == 0);
+	CHECK(CullFrom(patch, 0.0f, 10.0f, 0.001f).MeshletsFacingAway == 0);	// Almost edge on, from the front.
+
+	vector<Meshlet> meshlets;
+	BuildMeshlets(patch.Vertices.data(), (int)patch.Vertices.size(), patch.Indices.data(), 0, patch.PrimitivesTotal(), meshlets);
+	CHECK(meshlets.size() == 1 && meshlets[0].ConeAxis.z > 0.9999f && meshlets[0].ConeCutoff < 1.0e-3f);
+
+	// A camera inside a valley, below the center of its bounding sphere, sees the front of both its triangles: the apex of the normal cone is at the bottom of the valley, behind both triangles, not at the center.
+	TestMesh valley;
+	AddRoof(valley, 0.5f, 10.0f, true);
+	CHECK(CullFrom(valley, 0.0f, 5.0f, 2.0f).MeshletsFacingAway == 0);
+	CHECK(CullFrom(valley, 0.0f, 5.0f, -2.0f).MeshletsFacingAway == 1);
+
+	TestMesh within, beyond;
+	AddRoof(within, MESHLET_CONE_MINIMUM_SPREAD + 0.01f, 1.0f, false);
+	AddRoof(beyond, MESHLET_CONE_MINIMUM_SPREAD - 0.01f, 1.0f, false);
+	CHECK(CullFrom(within, 0.0f, 0.0f, -100.0f).MeshletsFacingAway == 1);
+	CHECK(CullFrom(within, 0.0f, 0.0f, 100.0f).MeshletsFacingAway == 0);
+	BuildMeshlets(beyond.Vertices.data(), (int)beyond.Vertices.size(), beyond.Indices.data(), 0, beyond.PrimitivesTotal(), meshlets);
+	CHECK(meshlets.back().ConeCutoff == 1.0f);
+
+	// Seen from every direction, from far away, so both triangles face away when seen from behind.
+	int facingAway = 0;
+	for (int d = 0; d < 64; d++)
+	{
+		float angle = d * (2.0f * XM_PI / 64.0f), elevation = (d % 8) * 0.2f - 0.7f;
+		MeshletCullStatistics statistics = CullFrom(beyond, 100.0f * std::cos(angle) * std::cos(elevation), 100.0f * std::sin(elevation), 100.0f * std::sin(angle) * std::cos(elevation));
+		facingAway += statistics.MeshletsFacingAway;
+	}
+	CHECK(facingAway == 0);
+	CHECK(CullFrom(beyond, 0.0f, 0.0f, -100.0f).MeshletsFacingAway == 0);
+}
+
+// main function: Definition
+int main()
+{
+	TestPartition();
+	TestFrustum();
+	TestNormalCone();
+	return TestResult();
+}
+
+// End: Function Definitions.
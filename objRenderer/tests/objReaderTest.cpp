@@ -0,0 +1,242 @@
+// objReaderTest
+// Version 3.1
+//
+// Description
+// Tests the face element index validation of the LoadObj function: every face element index must refer to a vertex attribute statement before its face element statement, either absolutely or relatively (negative indices).
+// A set of vertex attributes containing a NaN is never merged.
+// Each Wavefront .obj file is loaded by the stream parser, by the memory-mapped parser with one thread, and by the memory-mapped parser split into small chunks parsed by several threads, with a minimum chunk size of 16 bytes and of 0, which must all agree.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Test check Header File.
+#include "testCheck.h"
+
+// Wavefront .obj file I/O Header File.
+#include "objReader.h"
+
+// Standard Encapsulated Data and Functions for Manipulating String Data.
+#include <string>											// String class, used to build the Wavefront .obj files.
+
+// File Stream Functions.
+#include <fstream>											// File stream class member functions write, close, etc.
+
+// Standard Vector Class.
+#include <vector>											// Vector class, used to compare the Mesh's Indices.
+
+// Memory Functions.
+#include <cstring>											// Memory function memcmp.
+
+// File System Functions.
+#include <filesystem>										// File system function remove.
+
+// Using Declarations and Directives.
+using std::string;
+using std::ofstream;
+using std::memcmp;
+namespace fs = std::filesystem;
+
+// The Wavefront .obj file each test writes and loads, in the current directory.
+static const char* const TestFileName = "objReaderTest.obj";
+
+// The vertex attribute statements of one triangle, which the face element statements below refer to.
+static const char* const TestTriangleAttributes =
+	"v 0 0 0\nv 1 0 0\nv 0 1 0\n"
+	"vt 0 0\nvt 1 0\nvt 0 1\n"
+	"vn 0 0 1\n";
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// Write Text to TestFileName.
+static bool WriteObj(const string& Text)
+{
+	ofstream file(TestFileName, std::ios::out | std::ios::binary | std::ios::trunc);
+	file << Text;
+	file.close();
+	return (bool)file;
+}
+
+// Return true if a and b hold the same vertex attributes and indices.
+static bool SameMesh(const Mesh& a, const Mesh& b)
+{
+	return a.PrimitivesTotal == b.PrimitivesTotal && a.VertexAttributeSetsTotal == b.VertexAttributeSetsTotal && a.Indices == b.Indices && a.Vertices.size() == b.Vertices.size() &&
+		   (a.Vertices.empty() || memcmp(a.Vertices.data(), b.Vertices.data(), a.Vertices.size() * sizeof(VERTEX)) == 0);
+}
+
+// Load Text with every parser, check that each returns Expected, and that they agree. The Mesh of the memory-mapped parser with one thread is returned in Result.
+static void LoadWithEveryParser(const string& Text, int Expected, Mesh& Result)
+{
+	CHECK(WriteObj(Text));
+
+	LoadObjOptions mapped;
+	mapped.Threads = 1;
+	LoadObjOptions stream;
+	stream.MemoryMapped = false;
+	LoadObjOptions chunked;
+	chunked.Threads = 4;
+	chunked.MinimumChunkBytes = 16;
+	LoadObjOptions unlimited;								// A minimum chunk size of 0 is treated as 1, so the file is split into one chunk per thread, however small.
+	unlimited.Threads = 4;
+	unlimited.MinimumChunkBytes = 0;
+
+	Mesh streamMesh, chunkedMesh, unlimitedMesh;
+	CHECK(LoadObj(TestFileName, mapped, Result) == Expected);
+	CHECK(LoadObj(TestFileName, stream, streamMesh) == Expected);
+	CHECK(LoadObj(TestFileName, chunked, chunkedMesh) == Expected);
+	CHECK(LoadObj(TestFileName, unlimited, unlimitedMesh) == Expected);
+	CHECK(SameMesh(Result, streamMesh));
+	CHECK(SameMesh(Result, chunkedMesh));
+	CHECK(SameMesh(Result, unlimitedMesh));
+	if (Expected == 1)
+		CHECK(Result.Vertices.empty() && Result.Indices.empty() && Result.PrimitivesTotal == 0);
+}
+
+// A face element statement whose indices are all valid is loaded.
+static void TestValidIndices()
+{
+	Mesh mesh;
+	LoadWithEveryParser(string(TestTriangleAttributes) + "f 1/1/1 2/2/1 3/3/1\n", 0, mesh);
+	CHECK(mesh.PrimitivesTotal == 1);
+	CHECK(mesh.VertexAttributeSetsTotal == 3);
+	if (CHECK(mesh.Indices.size() == 3))
+		CHECK(mesh.Indices[0] == 0 && mesh.Indices[1] == 2 && mesh.Indices[2] == 1);	// Converted to the clockwise drawing order.
+}
+
+// A missing, 0, out of range, or too large face element index is rejected, rather than read outside v, vt, or vn.
+static void TestInvalidIndices()
+{
+	const char* const faces[] = {
+		"f 1//1 2//1 3//1\n",								// Missing vertex texture coordinate indices.
+		"f 1/1/ 2/2/ 3/3/\n",								// Missing vertex normal vector indices.
+		"f 1/1 2/2 3/3\n",									// Truncated triplets.
+		"f 1/1/1 2/2/1\n",									// Only two triplets.
+		"f 0/1/1 2/2/1 3/3/1\n",							// A 0 geometric vertex index.
+		"f 1/1/1 2/2/1 4/3/1\n",							// A geometric vertex index past the last v statement.
+		"f 1/1/1 2/4/1 3/3/1\n",							// A vertex texture coordinate index past the last vt statement.
+		"f 1/1/1 2/2/2 3/3/1\n",							// A vertex normal vector index past the last vn statement.
+		"f 1/1/1 2/2/1 99999999999/3/1\n",					// An index too large for an int, which must not wrap around to a valid index.
+		"f 1/1/1 2/2/1 4294967297/3/1\n",					// 2^32 + 1, which wraps around to 1 in 32 bits.
+		"f -4/1/1 2/2/1 3/3/1\n",							// A relative index before the first v statement.
+		"f 1/1/1 2/2/-2 3/3/1\n",							// A relative index before the first vn statement.
+	};
+	for (const char* face : faces)
+	{
+		Mesh mesh;
+		LoadWithEveryParser(string(TestTriangleAttributes) + face, 1, mesh);
+	}
+}
+
+// A face element statement without face element triplets, at the end of the file or before a valid one, is rejected by every parser, rather than parsed from a position the stream parser does not have.
+static void TestBareFace()
+{
+	const char* const faces[] = {
+		"f\n",												// The stream parser's string stream reaches its end reading the statement type.
+		"f",												// The same, as the last line, without a line feed.
+		"f   \n",											// Only blanks after the statement type.
+		"f\nf 1/1/1 2/2/1 3/3/1\n",							// Before a valid face element statement.
+	};
+	for (const char* face : faces)
+	{
+		Mesh mesh;
+		LoadWithEveryParser(string(TestTriangleAttributes) + face, 1, mesh);
+	}
+}
+
+// A face element statement referring to a vertex attribute statement after it is rejected by every parser, even though the memory-mapped parser reads all vertex attribute statements first.
+static void TestForwardReference()
+{
+	Mesh mesh;
+	LoadWithEveryParser("v 0 0 0\nv 1 0 0\nvt 0 0\nvn 0 0 1\nf 1/1/1 2/1/1 3/1/1\nv 0 1 0\n", 1, mesh);
+}
+
+// Relative face element indices refer back from the face element statement, and load the same Mesh as the equivalent absolute ones.
+static void TestRelativeIndices()
+{
+	Mesh absolute, relative;
+	LoadWithEveryParser(string(TestTriangleAttributes) + "f 1/1/1 2/2/1 3/3/1\n", 0, absolute);
+	LoadWithEveryParser(string(TestTriangleAttributes) + "f -3/-3/-1 -2/-2/-1 -1/-1/-1\n", 0, relative);
+	CHECK(SameMesh(absolute, relative));
+
+	// Many triangles, each with its own vertex attribute statements followed by a face element statement that refers to them relatively,
+	// so the chunks of the memory-mapped parser split the file between the statements and a relative index can refer into an earlier chunk.
+	string absoluteText, relativeText;
+	for (int t = 0; t < 200; t++)
+	{
+		string attributes = "v " + std::to_string(t) + " 0 0\nv " + std::to_string(t) + " 1 0\nv " + std::to_string(t) + " 0 1\nvt 0 0\nvt 1 0\nvt 0 1\nvn 0 0 1\n";
+		int v = t * 3 + 1;
+		absoluteText += attributes + "f " + std::to_string(v) + "/" + std::to_string(v) + "/" + std::to_string(t + 1) + " " + std::to_string(v + 1) + "/" + std::to_string(v + 1) + "/" + std::to_string(t + 1) +
+						" " + std::to_string(v + 2) + "/" + std::to_string(v + 2) + "/" + std::to_string(t + 1) + "\n";
+		// Every other triangle also refers to the previous triangle's first geometric vertex, more than one statement back.
+		relativeText += attributes + (t % 2 == 1 ? "f -6/-3/-1 -2/-2/-1 -1/-1/-1\n" : "f -3/-3/-1 -2/-2/-1 -1/-1/-1\n");
+		if (t % 2 == 1)
+		{
+			absoluteText.erase(absoluteText.rfind("f "));
+			absoluteText += "f " + std::to_string(v - 3) + "/" + std::to_string(v) + "/" + std::to_string(t + 1) + " " + std::to_string(v + 1) + "/" + std::to_string(v + 1) + "/" + std::to_string(t + 1) +
+							" " + std::to_string(v + 2) + "/" + std::to_string(v + 2) + "/" + std::to_string(t + 1) + "\n";
+		}
+	}
+	LoadWithEveryParser(absoluteText, 0, absolute);
+	LoadWithEveryParser(relativeText, 0, relative);
+	CHECK(absolute.PrimitivesTotal == 200);
+	CHECK(SameMesh(absolute, relative));
+}
+
+// A Wavefront .obj file without face element statements, even an empty one, is loaded as an object without vertex attributes or triangles, which the objRenderer program's InitGraphics function rejects.
+static void TestNoFaces()
+{
+	const char* const texts[] = { "", "# No statements\n", TestTriangleAttributes };
+	for (const char* text : texts)
+	{
+		Mesh mesh;
+		LoadWithEveryParser(text, 0, mesh);
+		CHECK(mesh.PrimitivesTotal == 0 && mesh.VertexAttributeSetsTotal == 0 && mesh.Vertices.empty() && mesh.Indices.empty());
+	}
+}
+
+// A set of vertex attributes containing a NaN is not equal to any set of vertex attributes, not even itself, so it is never merged: each occurrence of its face element triplet is stored as a new set of vertex attributes,
+// while the other face element triplets are merged as usual.
+// Only the memory-mapped parser is tested, with one thread and with several, as the stream parser's operator>> does not read "nan".
+static void TestNaN()
+{
+	CHECK(WriteObj("v nan 0 0\nv 1 0 0\nv 0 1 0\nvt 0 0\nvn 0 0 1\nf 1/1/1 2/1/1 3/1/1\nf 1/1/1 3/1/1 2/1/1\n"));
+
+	LoadObjOptions mapped;
+	mapped.Threads = 1;
+	LoadObjOptions chunked;
+	chunked.Threads = 4;
+	chunked.MinimumChunkBytes = 16;
+
+	Mesh mesh, chunkedMesh;
+	CHECK(LoadObj(TestFileName, mapped, mesh) == 0);
+	CHECK(LoadObj(TestFileName, chunked, chunkedMesh) == 0);
+	CHECK(mesh.PrimitivesTotal == 2 && mesh.VertexAttributeSetsTotal == 4 && mesh.Vertices.size() == 4);
+	CHECK(mesh.Indices == std::vector<DWORD>({ 0, 2, 1, 3, 1, 2 }));		// Clockwise, as the objRenderer program draws them; the second NaN occurrence is 3.
+	CHECK(mesh.Vertices.size() == 4 && mesh.Vertices[0].GeometricVertex.x != mesh.Vertices[0].GeometricVertex.x && mesh.Vertices[3].GeometricVertex.x != mesh.Vertices[3].GeometricVertex.x);
+	CHECK(SameMesh(mesh, chunkedMesh));
+}
+
+// main function: Definition
+int main()
+{
+	TestValidIndices();
+	TestInvalidIndices();
+	TestBareFace();
+	TestForwardReference();
+	TestRelativeIndices();
+	TestNoFaces();
+	TestNaN();
+
+	std::error_code error;
+	fs::remove(TestFileName, error);
+	return TestResult();
+}
+
+// End: Function Definitions.
@@ -0,0 +1,232 @@
+// renderQueueTest
+// Version 3.1
+//
+// Description
+// Tests the render queue with the recording backend: a scene of 2 shaders, 3 textures per shader, and 4 meshes per texture, 5 draws of each at different depths, recorded in a shuffled order into 4 command lists,
+// is sorted by state and then front to back, and executed with one bind of each shader, of each texture per shader, and of each mesh per texture (32 binds for 120 draws), the state cache skipping the other 328;
+// the state bound when each draw is made is the state it was recorded with. Executed in the shuffled order, the same draws bind far more often.
+// It also tests that the radix sort orders random keys as a stable sort does, that an unchanged state is not bound again in the next frame until the state cache is invalidated, and that an empty queue executes nothing.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Test check Header File.
+#include "testCheck.h"
+
+// Render queue Header File.
+#include "renderQueue.h"
+
+// Algorithms.
+#include <algorithm>										// Algorithms shuffle, stable_sort.
+
+// Random Number Generation.
+#include <random>											// Mersenne twister engine.
+
+// Using Declarations and Directives.
+using std::vector;
+
+// The scene: the number of shaders, of textures drawn with each shader, of meshes drawn with each texture, and of draws of each mesh.
+static const int TestShaders = 2;
+static const int TestTexturesPerShader = 3;
+static const int TestMeshesPerTexture = 4;
+static const int TestDrawsPerMesh = 5;
+static const int TestLists = 4;
+
+// Declare the TestDraw 'named structure' data type.
+// A draw of the scene, identified by its FirstInstance, and the state and depth it is recorded with.
+struct TestDraw {
+	int Shader;
+	int Texture;
+	int Mesh;
+	unsigned int Depth;
+};
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// Return the draws of the scene, in a shuffled order. Each texture and mesh has its own identifier, and the depths of the draws of a mesh are far apart, so a draw sorted out of depth order is noticed.
+static vector<TestDraw> TestScene(std::mt19937& Random)
+{
+	vector<TestDraw> draws;
+	for (int shader = 0; shader < TestShaders; shader++)
+		for (int texture = 0; texture < TestTexturesPerShader; texture++)
+			for (int mesh = 0; mesh < TestMeshesPerTexture; mesh++)
+				for (int draw = 0; draw < TestDrawsPerMesh; draw++)
+				{
+					int textureId = shader * TestTexturesPerShader + texture;
+					draws.push_back({ 7 - shader, 100 + textureId, 1000 + textureId * TestMeshesPerTexture + mesh, (unsigned int)(Random() % 0xFFFFFFFFu) });
+				}
+	std::shuffle(draws.begin(), draws.end(), Random);
+	return draws;
+}
+
+// Record Draws into the command lists of Queue in turn. The FirstInstance of each draw is its location in Draws.
+static void RecordScene(RenderQueue& Queue, const vector<TestDraw>& Draws)
+{
+	ResetRenderQueue(Queue, TestLists);
+	for (size_t d = 0; d < Draws.size(); d++)
+	{
+		RenderDraw draw = { 36, 1, 0, 0, (unsigned int)d };
+		RecordRenderDraw(Queue.Lists[d % TestLists], RenderSortKey(Draws[d].Shader, Draws[d].Texture, Draws[d].Mesh, Draws[d].Depth), draw);
+	}
+}
+
+// Replay Recording, and check that each draw is made with the state it was recorded with bound, and that every bind changes the state.
+// Return the number of draws made exactly once, and set OutOfOrder to the number of draws whose sort key is less than the previous draw's.
+static int CheckRecording(const RenderRecording& Recording, const vector<TestDraw>& Draws, int& OutOfOrder)
+{
+	vector<int> made(Draws.size(), 0);
+	int shader = -1, texture = -1, mesh = -1;
+	bool boundState = true, changedState = true;
+	const TestDraw* previous = nullptr;
+	OutOfOrder = 0;
+	for (const RenderRecordedCall& call : Recording.Calls)
+	{
+		switch (call.Call)
+		{
+		case RENDER_CALL_SET_SHADER:
+			changedState = changedState && call.Value != shader;
+			shader = call.Value;
+			break;
+		case RENDER_CALL_SET_TEXTURE:
+			changedState = changedState && call.Value != texture;
+			texture = call.Value;
+			break;
+		case RENDER_CALL_SET_MESH:
+			changedState = changedState && call.Value != mesh;
+			mesh = call.Value;
+			break;
+		case RENDER_CALL_DRAW:
+		{
+			if (!CHECK(call.Draw.FirstInstance < Draws.size()))
+				return 0;
+			const TestDraw& draw = Draws[call.Draw.FirstInstance];
+			made[call.Draw.FirstInstance]++;
+			boundState = boundState && draw.Shader == shader && draw.Texture == texture && draw.Mesh == mesh;
+			if (previous != nullptr && RenderSortKey(draw.Shader, draw.Texture, draw.Mesh, draw.Depth) < RenderSortKey(previous->Shader, previous->Texture, previous->Mesh, previous->Depth))
+				OutOfOrder++;
+			previous = &draw;
+			break;
+		}
+		}
+	}
+	CHECK(boundState);
+	CHECK(changedState);
+	return (int)std::count(made.begin(), made.end(), 1);
+}
+
+// The scene, recorded shuffled, sorted, and executed with an empty state cache, binds each state once.
+static void TestSortedScene()
+{
+	std::mt19937 random(2024);
+	vector<TestDraw> draws = TestScene(random);
+	RenderQueue queue;
+	RecordScene(queue, draws);
+	SortRenderQueue(queue);
+
+	RenderRecording recording;
+	RenderBackend backend;
+	CreateRecordingBackend(recording, backend);
+	RenderStateCache cache;
+	RenderQueueStatistics statistics;
+	ExecuteRenderQueue(queue, cache, backend, statistics);
+
+	const unsigned int drawsTotal = TestShaders * TestTexturesPerShader * TestMeshesPerTexture * TestDrawsPerMesh;
+	const unsigned int texturesTotal = TestShaders * TestTexturesPerShader;
+	const unsigned int meshesTotal = texturesTotal * TestMeshesPerTexture;
+	printf("Sorted: %u draws, %u shader binds, %u texture binds, %u mesh binds, %u binds skipped\n", statistics.Draws, statistics.ShaderBinds, statistics.TextureBinds, statistics.MeshBinds, statistics.BindsSkipped);
+	CHECK(statistics.Draws == drawsTotal && recording.Draws == drawsTotal);
+	CHECK(statistics.ShaderBinds == TestShaders && recording.ShaderBinds == TestShaders);
+	CHECK(statistics.TextureBinds == texturesTotal && recording.TextureBinds == texturesTotal);
+	CHECK(statistics.MeshBinds == meshesTotal && recording.MeshBinds == meshesTotal);
+	CHECK(statistics.BindsSkipped == 3 * drawsTotal - TestShaders - texturesTotal - meshesTotal);
+	int outOfOrder;
+	CHECK(CheckRecording(recording, draws, outOfOrder) == (int)drawsTotal);
+	CHECK(outOfOrder == 0);
+
+	// The same draws executed in the order they were recorded bind a state for almost every draw.
+	RenderStateCache unsortedCache;
+	RenderQueueStatistics unsorted;
+	for (size_t c = 0; c < queue.Commands.size(); c++)
+		queue.Sorted[c] = { queue.Commands[c].Key, (unsigned int)c };
+	CreateRecordingBackend(recording, backend);
+	ExecuteRenderQueue(queue, unsortedCache, backend, unsorted);
+	printf("Unsorted: %u draws, %u shader binds, %u texture binds, %u mesh binds, %u binds skipped\n", unsorted.Draws, unsorted.ShaderBinds, unsorted.TextureBinds, unsorted.MeshBinds, unsorted.BindsSkipped);
+	CHECK(CheckRecording(recording, draws, outOfOrder) == (int)drawsTotal);
+	CHECK(outOfOrder > 0);
+	CHECK(unsorted.MeshBinds > drawsTotal * 9 / 10 && unsorted.ShaderBinds > 10 * TestShaders);
+
+	// A frame that draws one mesh three times binds its state once, and the next frame binds nothing, until the state cache is invalidated.
+	ResetRenderQueue(queue, TestLists);
+	RenderDraw draw = { 36, 1, 0, 0, 0 };
+	for (int d = 0; d < 3; d++)
+		RecordRenderDraw(queue.Lists[d], RenderSortKey(draws[0].Shader, draws[0].Texture, draws[0].Mesh, draws[0].Depth), draw);
+	SortRenderQueue(queue);
+	for (int frame = 0; frame < 3; frame++)
+	{
+		if (frame != 1)
+			InvalidateRenderStateCache(cache);
+		ExecuteRenderQueue(queue, cache, backend, statistics);
+		unsigned int binds = statistics.ShaderBinds + statistics.TextureBinds + statistics.MeshBinds;
+		bool expected = frame == 1 ? binds == 0 && statistics.BindsSkipped == 9 : binds == 3 && statistics.BindsSkipped == 6;
+		if (!CHECK(statistics.Draws == 3 && expected))
+			printf("Frame %d: %u binds, %u binds skipped\n", frame, binds, statistics.BindsSkipped);
+	}
+
+	// An empty queue executes nothing.
+	ResetRenderQueue(queue, TestLists);
+	SortRenderQueue(queue);
+	CreateRecordingBackend(recording, backend);
+	ExecuteRenderQueue(queue, cache, backend, statistics);
+	CHECK(queue.Sorted.empty() && recording.Calls.empty() && statistics.Draws == 0 && statistics.BindsSkipped == 0);
+}
+
+// Random keys, many of them equal, and some differing only in the high bits of one field, sort into the same order as a stable sort of the merged command lists.
+static void TestRadixSort()
+{
+	std::mt19937 random(77);
+	RenderQueue queue;
+	bool same = true;
+	for (int round = 0; round < 50; round++)
+	{
+		int lists = 1 + (int)(random() % 8);
+		ResetRenderQueue(queue, lists);
+		int commandsTotal = (int)(random() % 2000);
+		for (int c = 0; c < commandsTotal; c++)
+		{
+			unsigned int field = (unsigned int)random();
+			unsigned long long key = round % 3 == 0 ? RenderSortKey(field % 3, (field >> 8) % 4 << 10, (field >> 16) % 2 << 11, (unsigned int)random() & 0x80000003u) :
+				round % 3 == 1 ? RenderSortKey(0, 1, (int)(field % 5), 0) : ((unsigned long long)random() << 32 | random());
+			RenderDraw draw = { 3, 1, 0, 0, (unsigned int)c };
+			RecordRenderDraw(queue.Lists[random() % lists], key, draw);
+		}
+		SortRenderQueue(queue);
+
+		vector<RenderCommand> merged;
+		for (int l = 0; l < lists; l++)
+			merged.insert(merged.end(), queue.Lists[l].Commands.begin(), queue.Lists[l].Commands.end());
+		std::stable_sort(merged.begin(), merged.end(), [](const RenderCommand& a, const RenderCommand& b) { return a.Key < b.Key; });
+		same = same && queue.Sorted.size() == merged.size();
+		for (size_t s = 0; same && s < merged.size(); s++)
+			same = queue.Sorted[s].Key == merged[s].Key && queue.Commands[queue.Sorted[s].Command].Key == merged[s].Key &&
+				queue.Commands[queue.Sorted[s].Command].Draw.FirstInstance == merged[s].Draw.FirstInstance;
+	}
+	CHECK(same);
+}
+
+// main function: Definition
+int main()
+{
+	TestSortedScene();
+	TestRadixSort();
+	return TestResult();
+}
+
+// End: Function Definitions.
@@ -0,0 +1,179 @@
+// shaderCacheTest
+// Version 3.1
+//
+// Description
+// Tests that the CompileShader function loads a shader from its shader cache file only while everything its bytecode depends on is unchanged, and compiles it again when any of it changes:
+// the contents of the source file, a shader macro's name or definition, a shader macro added, the compile options (flags), or the compiler version.
+// The shader compiler is a stub (TestCompiler), which counts its calls and returns bytecode made from its arguments, so the test runs without the HLSL compiler.
+// It also tests that a damaged cache file is compiled again, that a shader that fails to compile leaves the last bytecode in place, and that no cache file is used when ShaderCacheEnabled is false.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Test check Header File.
+#include "testCheck.h"
+
+// Shader cache Header File.
+#include "shaderCache.h"
+
+// File Stream Functions.
+#include <fstream>											// File stream class member functions write, seekp, put, close, etc.
+
+// String Functions.
+#include <cstring>											// strlen.
+
+// File System Functions.
+#include <filesystem>										// File system function remove.
+
+// Using Declarations and Directives.
+using std::vector;
+using std::string;
+using std::ofstream;
+using std::fstream;
+using std::ios;
+namespace fs = std::filesystem;
+
+// The shader source file, and the shader cache file of its VShader function for vs_4_1, in the current directory.
+static const char* const TestSourceFileName = "shaderCacheTest.hlsl";
+static const char* const TestCacheFileName = "shaderCacheTest.hlsl.VShader.vs_4_1.cso";
+
+// The number of times TestCompiler has been called.
+static int TestCompilesTotal = 0;
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// TestCompiler function: Definition
+//   This function is a ShaderCompiler that counts its calls, and returns bytecode made of the source, the flags, and the shader macros, so that bytecode compiled from different shaders differs.
+//   Source containing "error" fails to compile.
+static int TestCompiler(const char* Source, size_t SourceSize, const char* SourceFileName, const ShaderDefine* Defines, const char* EntryPoint, const char* Target, unsigned int Flags,
+	vector<unsigned char>& Bytecode, string& Errors)
+{
+	TestCompilesTotal++;
+	string source(Source, SourceSize);
+	if (source.find("error") != string::npos)
+	{
+		Errors = string(SourceFileName) + ": error X3000: syntax error";
+		return 1;
+	}
+	Bytecode.assign(source.begin(), source.end());
+	Bytecode.push_back((unsigned char)Flags);
+	for (; Defines != NULL && Defines->Name != NULL; Defines++)
+	{
+		Bytecode.insert(Bytecode.end(), Defines->Name, Defines->Name + strlen(Defines->Name));
+		Bytecode.insert(Bytecode.end(), Defines->Definition, Defines->Definition + strlen(Defines->Definition));
+	}
+	Bytecode.insert(Bytecode.end(), EntryPoint, EntryPoint + strlen(EntryPoint));
+	Bytecode.insert(Bytecode.end(), Target, Target + strlen(Target));
+	return 0;
+}
+
+// Write Text to the shader source file.
+static void WriteSource(const char* Text)
+{
+	ofstream file(TestSourceFileName, ios::out | ios::binary | ios::trunc);
+	file << Text;
+	file.close();
+	CHECK((bool)file);
+}
+
+// Compile the VShader function of the shader source file for vs_4_1, and check that it was loaded from its cache file (ExpectedCacheHit true) or compiled (false), and that its bytecode is what TestCompiler returns.
+static void CompileAndCheck(const ShaderDefine* Defines, unsigned int Flags, unsigned int CompilerVersion, bool ExpectedCacheHit, const char* Description)
+{
+	int compilesBefore = TestCompilesTotal;
+	ShaderProgram program;
+	string errors;
+	bool compiled = CHECK(CompileShader(TestSourceFileName, Defines, "VShader", "vs_4_1", Flags, CompilerVersion, TestCompiler, program, errors) == 0);
+	bool expected = program.CacheHit == ExpectedCacheHit && TestCompilesTotal == compilesBefore + (ExpectedCacheHit ? 0 : 1);
+	if (!CHECK(compiled && expected))
+		printf("%s: expected the shader to be %s.\n", Description, ExpectedCacheHit ? "loaded from its cache file" : "compiled");
+
+	// The bytecode loaded from the cache file is the bytecode compiled from the same shader.
+	std::ifstream source(TestSourceFileName, ios::in | ios::binary);
+	string text((std::istreambuf_iterator<char>(source)), std::istreambuf_iterator<char>());
+	vector<unsigned char> bytecode;
+	TestCompiler(text.data(), text.size(), TestSourceFileName, Defines, "VShader", "vs_4_1", Flags, bytecode, errors);
+	TestCompilesTotal--;
+	CHECK(program.Bytecode == bytecode);
+}
+
+// main function: Definition
+int main()
+{
+	std::error_code error;
+	fs::remove(TestCacheFileName, error);
+	WriteSource("float4 VShader(float4 position : POSITION) : SV_POSITION { return position; }");
+
+	const ShaderDefine noDefines[] = { { NULL, NULL } };
+	const ShaderDefine packed[] = { { "PACKED_VERTEX", "1" }, { NULL, NULL } };
+	const ShaderDefine unpacked[] = { { "PACKED_VERTEX", "0" }, { NULL, NULL } };
+	const ShaderDefine renamed[] = { { "PACKED_VERTICES", "1" }, { NULL, NULL } };
+	const ShaderDefine added[] = { { "PACKED_VERTEX", "1" }, { "INSTANCED", "1" }, { NULL, NULL } };
+
+	// The first compilation saves the cache file, from which the same shader is then loaded. No shader macros and an empty array of them are the same shader.
+	CompileAndCheck(NULL, 1, 47, false, "First compilation");
+	CompileAndCheck(NULL, 1, 47, true, "Unchanged shader");
+	CompileAndCheck(noDefines, 1, 47, true, "Empty array of shader macros");
+
+	// Each change to the shader is compiled, and then loaded from the cache file saved.
+	CompileAndCheck(NULL, 2, 47, false, "Flags changed");
+	CompileAndCheck(NULL, 2, 47, true, "Flags changed, again");
+	CompileAndCheck(packed, 2, 47, false, "Shader macro added");
+	CompileAndCheck(packed, 2, 47, true, "Shader macro added, again");
+	CompileAndCheck(unpacked, 2, 47, false, "Shader macro definition changed");
+	CompileAndCheck(renamed, 2, 47, false, "Shader macro name changed");
+	CompileAndCheck(added, 2, 47, false, "Second shader macro added");
+	CompileAndCheck(added, 2, 48, false, "Compiler version changed");
+	CompileAndCheck(added, 2, 48, true, "Compiler version changed, again");
+
+	// A change to the contents of the source file is compiled, even if its size and last write time are unchanged.
+	WriteSource("float4 VShader(float4 position : POSITION) : SV_POSITION { return position * 2; }");
+	CompileAndCheck(added, 2, 48, false, "Source changed");
+	WriteSource("float4 VShader(float4 position : POSITION) : SV_POSITION { return position * 3; }");
+	CompileAndCheck(added, 2, 48, false, "Source changed, same size");
+	CompileAndCheck(added, 2, 48, true, "Source changed, again");
+
+	// The key separates its parts, so moving characters from one part to the next changes it.
+	CHECK(ShaderCacheKey("ab", 2, NULL, "VShader", "vs_4_1", 0, 0) != ShaderCacheKey("a", 1, NULL, "bVShader", "vs_4_1", 0, 0));
+	const ShaderDefine splitName[] = { { "AB", "C" }, { NULL, NULL } };
+	const ShaderDefine splitDefinition[] = { { "A", "BC" }, { NULL, NULL } };
+	CHECK(ShaderCacheKey("a", 1, splitName, "VShader", "vs_4_1", 0, 0) != ShaderCacheKey("a", 1, splitDefinition, "VShader", "vs_4_1", 0, 0));
+
+	// A damaged cache file (its bytecode overwritten) is compiled again.
+	fstream cache(TestCacheFileName, ios::in | ios::out | ios::binary);
+	cache.seekp((std::streamoff)sizeof(ShaderCacheHeader) + 4);
+	cache.put('X');
+	cache.close();
+	CHECK((bool)cache);
+	CompileAndCheck(added, 2, 48, false, "Damaged cache file");
+
+	// A shader that fails to compile returns the compiler error messages, and leaves the program's last bytecode in place.
+	ShaderProgram program;
+	string errors;
+	CHECK(CompileShader(TestSourceFileName, added, "VShader", "vs_4_1", 2, 48, TestCompiler, program, errors) == 0);
+	vector<unsigned char> lastBytecode = program.Bytecode;
+	WriteSource("float4 VShader() { error }");
+	CHECK(CompileShader(TestSourceFileName, added, "VShader", "vs_4_1", 2, 48, TestCompiler, program, errors) == 1);
+	CHECK(errors.find("syntax error") != string::npos);
+	CHECK(program.Bytecode == lastBytecode);
+
+	// When ShaderCacheEnabled is false, every shader is compiled.
+	WriteSource("float4 VShader(float4 position : POSITION) : SV_POSITION { return position; }");
+	CompileAndCheck(NULL, 1, 47, false, "Shader changed back");
+	ShaderCacheEnabled = false;
+	CompileAndCheck(NULL, 1, 47, false, "Shader cache disabled");
+	ShaderCacheEnabled = true;
+
+	fs::remove(TestSourceFileName, error);
+	fs::remove(TestCacheFileName, error);
+	return TestResult();
+}
+
+// End: Function Definitions.
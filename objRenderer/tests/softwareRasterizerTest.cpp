@@ -0,0 +1,140 @@
+// softwareRasterizerTest
+// Version 3.1
+//
+// Description
+// Tests that the software rasterizer renders the scene the objRenderer program draws, Text.obj textured with Wood.png, two instances turned the opposite ways and seen from the objRenderer program's camera,
+// at 320x240 pixels with 4 samples per pixel, as the reference image tests/softwareRasterizerTest.png, to within rounding: at most TestComponentTolerance in any component, and in at most TestPixelsTolerance pixels.
+// It also tests that the frames rendered with and without SSE instructions, with 1 and 4 samples per pixel, are the same.
+// The frame rendered is written to softwareRasterizerTest.bmp in the current directory. After a deliberate change to the rendered image, convert it to a 24-bit .png file to replace the reference image.
+//
+// Usage
+// softwareRasterizerTest SourceDirectory
+//   SourceDirectory  The objRenderer directory, holding Text.obj, Wood.png, and tests/softwareRasterizerTest.png.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Test check Header File.
+#include "testCheck.h"
+
+// Software rasterizer Header File.
+// Includes the Batch instance transform Header File (the InstanceTransformArrays structure and the TransformInstances function) and the Image file I/O Header File.
+#include "softwareRasterizer.h"
+
+// Job system Header File.
+#include "jobSystem.h"
+
+// Standard Encapsulated Data and Functions for Manipulating String Data.
+#include <string>											// String class, used to build the file names.
+
+// Standard Library Functions.
+#include <cstdlib>											// abs.
+
+// Using Declarations and Directives.
+using std::vector;
+using std::string;
+
+// The size of the frame rendered, in pixels.
+static const int TestWidth = 320;
+static const int TestHeight = 240;
+
+// The largest difference allowed in any red, green, or blue component of a pixel, and the largest number of pixels allowed to differ at all, e.g., from a compiler that rounds the floating-point operations differently.
+// A pixel on the other side of an edge, or sampled from another texel, differs by much more than TestComponentTolerance.
+static const int TestComponentTolerance = 2;
+static const int TestPixelsTolerance = 30;
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// Render the scene with SampleCount samples per pixel, with or without SSE instructions, into Result.
+static void RenderScene(const Mesh& Object, const Image& Texture, int SampleCount, bool SimdEnabled, Image& Result)
+{
+	// The first instance, at the origin, is turned 0.6 radians around the y-axis, and the second, 3 units above it, the other way, as in a frame of the objRenderer program.
+	InstanceTransformArrays transforms;
+	ResizeInstanceTransforms(transforms, 2);
+	for (int i = 0; i < 2; i++)
+	{
+		InstanceTransform transform = GetInstanceTransform(transforms, i);
+		XMStoreFloat4(&transform.Rotation, XMQuaternionRotationRollPitchYaw(0.0f, i == 0 ? 0.6f : -0.6f, 0.0f));
+		transform.Position.y = i == 0 ? 0.0f : 3.0f;
+		SetInstanceTransform(transforms, i, transform);
+	}
+	vector<INSTANCEDATA> instances(2);
+	TransformInstances(transforms, nullptr, 2, instances.data());
+
+	// The camera, light, and ambient light of the RenderFrame function.
+	SoftwareShaderConstants constants;
+	XMMATRIX matView = XMMatrixLookAtLH(XMVectorSet(0.0f, 9.0f, 24.0f, 0.0f), XMVectorSet(0.0f, 0.0f, 0.0f, 0.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+	XMMATRIX matProjection = XMMatrixPerspectiveFovLH(XMConvertToRadians(45), (float)TestWidth / (float)TestHeight, 1.0f, 100.0f);
+	XMStoreFloat4x4(&constants.matViewProjection, matView * matProjection);
+	constants.LightVector = XMFLOAT4(1.0f, 1.0f, 1.0f, 0.0f);
+	constants.LightColor = XMFLOAT4(0.5f, 0.5f, 0.5f, 1.0f);
+	constants.AmbientColor = XMFLOAT4(0.2f, 0.2f, 0.2f, 1.0f);
+
+	SoftwareDraw draw = { Object.PrimitivesTotal * 3, 0, 2, 0 };
+	SoftwareRenderTarget target;
+	CreateSoftwareRenderTarget(target, TestWidth, TestHeight, SampleCount);
+	SoftwareRasterizerSimdEnabled = SimdEnabled;
+	BenchmarkSoftwareRasterizer(target, Object.Vertices.data(), Object.Indices.data(), instances.data(), &draw, 1, constants, Texture, 1, Result);
+	SoftwareRasterizerSimdEnabled = true;
+}
+
+// main function: Definition
+int main(int argc, char* argv[])
+{
+	if (!CHECK(argc == 2))
+		return TestResult();
+	string directory = argv[1];
+
+	Mesh object;
+	LoadObjOptions options;
+	Image texture, reference;
+	if (!CHECK(LoadObj((directory + "/Text.obj").c_str(), options, object) == 0) || !CHECK(LoadPngFile((directory + "/Wood.png").c_str(), texture) == 0))
+		return TestResult();
+
+	// The frames rendered with and without SSE instructions are the same.
+	Image frame, scalarFrame;
+	RenderScene(object, texture, 1, true, frame);
+	RenderScene(object, texture, 1, false, scalarFrame);
+	CHECK(frame.Pixels == scalarFrame.Pixels);
+	RenderScene(object, texture, 4, false, scalarFrame);
+	RenderScene(object, texture, 4, true, frame);
+	CHECK(frame.Pixels == scalarFrame.Pixels);
+	SaveBmpFile("softwareRasterizerTest.bmp", frame);
+
+	// The frame with 4 samples per pixel matches the reference image. Its alpha components are not compared, as .bmp files, from which it is made, have none.
+	if (!CHECK(LoadPngFile((directory + "/tests/softwareRasterizerTest.png").c_str(), reference) == 0) || !CHECK(frame.Width == reference.Width && frame.Height == reference.Height))
+		return TestResult();
+	int largest = 0, differing = 0, background = 0;
+	for (int p = 0; p < frame.Width * frame.Height; p++)
+	{
+		int difference = 0;
+		for (int c = 0; c < 3; c++)
+		{
+			int component = abs(frame.Pixels[p * 4 + c] - reference.Pixels[p * 4 + c]);
+			difference = component > difference ? component : difference;
+		}
+		largest = difference > largest ? difference : largest;
+		differing += difference > 0;
+		background += frame.Pixels[p * 4] == 0 && frame.Pixels[p * 4 + 1] == 51 && frame.Pixels[p * 4 + 2] == 102;	// The clear color (0.0, 0.2, 0.4).
+	}
+	printf("%d of %d pixels differ from the reference image, by at most %d; %d pixels are the clear color.\n", differing, frame.Width * frame.Height, largest, background);
+	CHECK(largest <= TestComponentTolerance);
+	CHECK(differing <= TestPixelsTolerance);
+
+	// The objects are drawn, covering a small part of the frame, as they do in the objRenderer program's window.
+	CHECK(background > frame.Width * frame.Height / 2);
+	CHECK(background < frame.Width * frame.Height * 99 / 100);
+
+	JobSystemShutdown();
+	return TestResult();
+}
+
+// End: Function Definitions.
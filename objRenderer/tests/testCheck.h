@@ -0,0 +1,54 @@
+// testCheck Header File
+// Version 3.1
+//
+// Description
+// Test check Header File
+// This header file contains the check used by the test programs of the objRenderer modules (objRenderer/tests, see CMakeLists.txt).
+// Each test program calls CHECK for every condition it tests, and returns TestResult() from its main function: 0 if every condition held, or 1 if any did not, as CTest expects.
+// A condition that does not hold is printed with its file, line, and text, and the test program continues, so one run reports every failed condition.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Standard Input and Output Functions.
+#include <cstdio>											// printf, fprintf.
+
+// The number of conditions checked, and the number that did not hold, by the test program.
+inline int TestChecksTotal = 0;
+inline int TestFailuresTotal = 0;
+
+// TestCheck function: Definition
+//   This function counts one condition, and prints it if it did not hold. It returns Condition, so a test can skip the checks that depend on it.
+inline bool TestCheck(bool Condition, const char* Text, const char* FileName, int Line)
+{
+	TestChecksTotal++;
+	if (!Condition)
+	{
+		TestFailuresTotal++;
+		fprintf(stderr, "%s(%d): check failed: %s\n", FileName, Line, Text);
+	}
+	return Condition;
+}
+
+// CHECK evaluates Condition once, and passes its text, file, and line to the TestCheck function.
+#define CHECK(Condition) TestCheck((Condition), #Condition, __FILE__, __LINE__)
+
+// TestResult function: Definition
+//   This function prints the number of conditions checked and failed, and returns the return code of the test program.
+inline int TestResult()
+{
+	printf("%d checks, %d failed\n", TestChecksTotal, TestFailuresTotal);
+	return TestFailuresTotal == 0 ? 0 : 1;
+}
+
+// End: Global Declarations.
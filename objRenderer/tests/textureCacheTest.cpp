@@ -0,0 +1,199 @@
+// textureCacheTest
+// Version 3.1
+//
+// Description
+// Tests that texture images encoded by the CompressTexture function into BC1 and BC7 blocks, and decoded by the DecompressTexture function, differ from the original by no more than the error bound of each format (TestBounds):
+// the peak signal-to-noise ratio (PSNR) of the red, green, and blue components (and of alpha, for BC7) must be at least the bound's, and no component may differ by more than the bound's largest difference.
+// The texture images are Wood.png and each level of its mipmap chain, solid colors, and gradients, of sizes that are and are not multiples of 4 pixels.
+// It also tests that a texture cache file saved by the TextureCacheSave function is loaded by the TextureCacheLoad function with the same blocks, and is out of date once its source file changes.
+//
+// Usage
+// textureCacheTest SourceDirectory
+//   SourceDirectory  The objRenderer directory, holding Wood.png.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Test check Header File.
+#include "testCheck.h"
+
+// Texture cache Header File.
+#include "textureCache.h"
+
+// Job system Header File.
+#include "jobSystem.h"
+
+// Standard Encapsulated Data and Functions for Manipulating String Data.
+#include <string>											// String class, used to build the file names.
+
+// Mathematical Functions.
+#include <cmath>											// Mathematical function log10.
+
+// Memory Functions.
+#include <cstring>											// Memory function memcmp.
+
+// File System Functions.
+#include <filesystem>										// File system functions copy_file, remove.
+
+// File Stream Functions.
+#include <fstream>											// File stream class, used to change the source file.
+
+// Using Declarations and Directives.
+using std::vector;
+using std::string;
+using std::memcmp;
+namespace fs = std::filesystem;
+
+// The texture image whose texture cache file is saved and loaded, copied to the current directory.
+static const char* const TestSourceFileName = "textureCacheTest.png";
+
+// Declare the TestErrorBound 'named structure' data type.
+// The error bound of a format, a few decibels and units below what the encoder achieves, so that a change that makes it encode noticeably worse fails the test.
+struct TestErrorBound {
+	unsigned int Format;
+	const char* Name;
+	int Channels;											// The components compared: red, green, and blue for BC1 (which is opaque), and alpha as well for BC7.
+	double MinimumPsnr;										// The lowest PSNR, in decibels, of each level of Wood.png.
+	double MinimumGradientPsnr;								// The lowest PSNR of a steep gradient, which changes more across each block than Wood.png does, so is fitted less closely by the colors between the two endpoints.
+	int MaximumError;										// The largest difference in any component of any pixel.
+	int MaximumSolidError;									// The largest difference in any component of a solid color: BC1 rounds it to a 5:6:5 color or a third of the way between two, and the BC7 mode 6 endpoints share a p-bit between their components.
+};
+
+static const TestErrorBound TestBounds[] = {
+	{ TEXTURE_FORMAT_BC1_UNORM, "BC1", 3, 38.0, 35.0, 16, 4 },
+	{ TEXTURE_FORMAT_BC7_UNORM, "BC7", 4, 47.0, 37.0, 10, 1 },
+};
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// Encode Source into Bound.Format, decode it, and check that its PSNR is at least MinimumPsnr, and that no component differs by more than MaximumError.
+static void TestRoundTrip(const Image& Source, const TestErrorBound& Bound, double MinimumPsnr, int MaximumError, const char* Description)
+{
+	vector<unsigned char> blocks;
+	CompressTexture(Source, Bound.Format, blocks);
+	Image decoded;
+	if (!CHECK(blocks.size() == (size_t)((Source.Width + 3) / 4) * ((Source.Height + 3) / 4) * (Bound.Format == TEXTURE_FORMAT_BC1_UNORM ? 8 : 16)) ||
+		!CHECK(DecompressTexture(blocks.data(), Bound.Format, Source.Width, Source.Height, decoded) == 0) ||
+		!CHECK(decoded.Width == Source.Width && decoded.Height == Source.Height && decoded.Pixels.size() == Source.Pixels.size()))
+		return;
+
+	double squaredError = 0.0;
+	int largest = 0;
+	for (size_t p = 0; p < Source.Pixels.size(); p += 4)
+		for (int c = 0; c < Bound.Channels; c++)
+		{
+			int difference = (int)decoded.Pixels[p + c] - (int)Source.Pixels[p + c];
+			squaredError += (double)difference * difference;
+			largest = difference > largest ? difference : -difference > largest ? -difference : largest;
+		}
+	double meanSquaredError = squaredError / ((double)Source.Width * Source.Height * Bound.Channels);
+	double psnr = meanSquaredError > 0.0 ? 10.0 * log10(255.0 * 255.0 / meanSquaredError) : 99.0;
+	printf("%s, %s (%dx%d): PSNR %.2f dB, largest difference %d\n", Bound.Name, Description, Source.Width, Source.Height, psnr, largest);
+	CHECK(psnr >= MinimumPsnr);
+	CHECK(largest <= MaximumError);
+
+	// BC1 textures are opaque.
+	if (Bound.Format == TEXTURE_FORMAT_BC1_UNORM)
+	{
+		bool opaque = true;
+		for (size_t p = 3; p < decoded.Pixels.size(); p += 4)
+			opaque = opaque && decoded.Pixels[p] == 255;
+		CHECK(opaque);
+	}
+}
+
+// Return a Width x Height texture image whose pixels are given by Pixel(x, y, Components).
+template <typename PixelFunction>
+static Image TestImage(int Width, int Height, PixelFunction Pixel)
+{
+	Image result;
+	result.Width = Width;
+	result.Height = Height;
+	result.Pixels.resize((size_t)Width * Height * 4);
+	for (int y = 0; y < Height; y++)
+		for (int x = 0; x < Width; x++)
+			Pixel(x, y, &result.Pixels[((size_t)y * Width + x) * 4]);
+	return result;
+}
+
+// The texture cache file saved from the mipmap chain of Source is loaded with the same blocks as the CompressTexture function encodes, and is out of date once the source file changes.
+static void TestCacheFile(const vector<Image>& Mips, const TestErrorBound& Bound)
+{
+	TextureCacheFormat = Bound.Format;
+	if (!CHECK(TextureCacheSave(TestSourceFileName, Bound.Format, Mips) == 0))
+		return;
+	TextureCacheView view;
+	if (!CHECK(TextureCacheLoad(TestSourceFileName, view) == 0))
+		return;
+	CHECK(view.Format == Bound.Format && view.Width == Mips[0].Width && view.Height == Mips[0].Height && view.MipLevels == (int)Mips.size());
+	bool same = true;
+	for (int level = 0; level < view.MipLevels; level++)
+	{
+		vector<unsigned char> blocks;
+		CompressTexture(Mips[level], Bound.Format, blocks);
+		same = same && view.MipSize[level] == (int)blocks.size() && memcmp(view.MipData[level], blocks.data(), blocks.size()) == 0;
+	}
+	CHECK(same);
+	TextureCacheUnload(view);
+
+	// A cache file cooked in the other format is out of date.
+	TextureCacheFormat = Bound.Format == TEXTURE_FORMAT_BC1_UNORM ? TEXTURE_FORMAT_BC7_UNORM : TEXTURE_FORMAT_BC1_UNORM;
+	CHECK(TextureCacheLoad(TestSourceFileName, view) == 1);
+	TextureCacheFormat = Bound.Format;
+}
+
+// main function: Definition
+int main(int argc, char* argv[])
+{
+	if (!CHECK(argc == 2))
+		return TestResult();
+	std::error_code error;
+	fs::copy_file(string(argv[1]) + "/Wood.png", TestSourceFileName, fs::copy_options::overwrite_existing, error);
+	Image wood;
+	if (!CHECK(!error) || !CHECK(LoadPngFile(TestSourceFileName, wood) == 0))
+		return TestResult();
+	vector<Image> mips;
+	BuildMipChain(wood, mips);
+
+	for (const TestErrorBound& bound : TestBounds)
+	{
+		// Wood.png, and every level of its mipmap chain, down to 1 x 1 pixel.
+		for (size_t level = 0; level < mips.size(); level++)
+			TestRoundTrip(mips[level], bound, bound.MinimumPsnr, bound.MaximumError, ("Wood.png level " + std::to_string(level)).c_str());
+
+		// Solid colors, including black, white, and colors between the 5:6:5 colors of BC1, each filling a texture image that is not a multiple of 4 pixels.
+		const unsigned char solid[][4] = { { 0, 0, 0, 255 }, { 255, 255, 255, 255 }, { 13, 131, 250, 255 }, { 200, 100, 50, 255 }, { 90, 180, 30, 128 } };
+		for (const unsigned char* color : solid)
+			TestRoundTrip(TestImage(6, 5, [color](int, int, unsigned char* Components) { memcpy(Components, color, 4); }), bound, 0.0, bound.MaximumSolidError, "solid color");
+
+		// Horizontal, vertical, and diagonal gradients of color across each 4x4 block, and a gradient of gray and alpha. Alpha changes in the same direction as gray, as the colors of a BC7 mode 6 block lie on one line in RGBA space.
+		TestRoundTrip(TestImage(64, 64, [](int x, int y, unsigned char* Components) {
+			Components[0] = (unsigned char)(x * 4), Components[1] = (unsigned char)(y * 4), Components[2] = (unsigned char)((x + y) * 2), Components[3] = 255; }), bound, bound.MinimumGradientPsnr, bound.MaximumError, "color gradient");
+		TestRoundTrip(TestImage(30, 18, [](int x, int y, unsigned char* Components) {
+			Components[0] = Components[1] = Components[2] = (unsigned char)(x * 8 + y), Components[3] = (unsigned char)(255 - x * 8); }), bound, bound.MinimumGradientPsnr, bound.MaximumError, "gray and alpha gradient");
+
+		TestCacheFile(mips, bound);
+	}
+
+	// A changed source file makes its texture cache file out of date.
+	std::ofstream source(TestSourceFileName, std::ios::out | std::ios::binary | std::ios::app);
+	source.put(0);
+	source.close();
+	TextureCacheView view;
+	CHECK(TextureCacheLoad(TestSourceFileName, view) == 1);
+
+	fs::remove(TestSourceFileName, error);
+	fs::remove(string(TestSourceFileName) + ".dds", error);
+	JobSystemShutdown();
+	return TestResult();
+}
+
+// End: Function Definitions.
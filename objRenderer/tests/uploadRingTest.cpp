@@ -0,0 +1,182 @@
+// uploadRingTest
+// Version 3.1
+//
+// Description
+// Tests the allocations of the UploadRingAllocate function as frames end and are retired:
+// allocations follow one another and are aligned; an allocation that does not fit before the end of the buffer wraps to its beginning, without discarding it, once the frames there are retired;
+// an allocation that would overwrite a frame not yet retired discards the buffer instead; and retiring a frame frees exactly the allocations of the frames up to it.
+// A long run of frames of random allocations, retired after a random number of frames as the GPU finishes them, checks that no allocation overlaps one the GPU may still be reading from the same buffer memory.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Test check Header File.
+#include "testCheck.h"
+
+// Upload ring Header File.
+#include "uploadRing.h"
+
+// Vector Container Class.
+#include <vector>											// Vector class, used to hold the allocations of the frames in flight.
+
+// Random Number Generation.
+#include <random>											// Mersenne twister engine.
+
+// Using Declarations and Directives.
+using std::vector;
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// Allocate Size bytes from Ring, and check that the allocation is at ExpectedOffset and discards the buffer or not as expected.
+static bool AllocateAndCheck(UploadRing& Ring, unsigned int Size, unsigned int ExpectedOffset, bool ExpectedDiscard)
+{
+	UploadRingAllocation allocation;
+	return CHECK(UploadRingAllocate(Ring, Size, allocation) == 0) && CHECK(allocation.Offset == ExpectedOffset) && CHECK(allocation.Discard == ExpectedDiscard) &&
+		CHECK(allocation.Size >= Size && allocation.Size % Ring.Alignment == 0);
+}
+
+// A ring of four 256-byte constant buffers, through each case in turn.
+static void TestWrapAndRetire()
+{
+	UploadRing ring;
+	CreateUploadRing(ring, 1024, UPLOAD_RING_CONSTANT_ALIGNMENT);
+	UploadRingAllocation allocation;
+	CHECK(UploadRingAllocate(ring, 0, allocation) == 1);	// An empty allocation, and one larger than the ring, are rejected.
+	CHECK(UploadRingAllocate(ring, 1025, allocation) == 1);
+
+	// The first allocation discards the buffer, as the first map of a buffer must. The next follows it, rounded up to the alignment.
+	AllocateAndCheck(ring, 112, 0, true);
+	AllocateAndCheck(ring, 48, 256, false);
+	UploadRingEndFrame(ring, 0);
+	AllocateAndCheck(ring, 300, 512, false);				// 512 bytes, to the end of the buffer.
+	UploadRingEndFrame(ring, 1);
+	CHECK(ring.Frames.size() == 2);
+
+	// The buffer is full, and frame 0 is not retired: the next allocation discards the buffer, and forgets the frames, which read its old memory.
+	AllocateAndCheck(ring, 256, 0, true);
+	CHECK(ring.Frames.empty());
+	UploadRingEndFrame(ring, 2);
+	AllocateAndCheck(ring, 512, 256, false);
+	UploadRingEndFrame(ring, 3);
+
+	// A frame without allocations is not recorded.
+	UploadRingEndFrame(ring, 4);
+	CHECK(ring.Frames.size() == 2 && ring.Frames.back().Frame == 3);
+
+	// Retiring frame 2 frees bytes 0 to 256 only. 512 bytes do not fit in the 256 bytes at the end of the buffer, so they wrap to its beginning, where bytes 256 to 768 of frame 3 are still read: discard.
+	UploadRingRetire(ring, 2);
+	CHECK(ring.Frames.size() == 1 && ring.Frames.front().Frame == 3);
+	AllocateAndCheck(ring, 512, 0, true);
+	UploadRingEndFrame(ring, 5);
+
+	// Once frame 5 is retired, the allocations wrap without discarding the buffer.
+	UploadRingRetire(ring, 5);
+	CHECK(ring.Frames.empty() && ring.Tail == ring.Head);
+	AllocateAndCheck(ring, 256, 512, false);
+	AllocateAndCheck(ring, 512, 0, false);				// Skips the 256 bytes at the end of the buffer.
+	CHECK(ring.Wraps == 1);
+	UploadRingEndFrame(ring, 6);
+
+	// Retiring an older frame, or one already retired, frees nothing.
+	unsigned long long tail = ring.Tail;
+	UploadRingRetire(ring, 5);
+	CHECK(ring.Tail == tail && ring.Frames.size() == 1);
+
+	// An allocation the size of the whole ring discards the buffer unless every frame is retired.
+	AllocateAndCheck(ring, 1024, 0, true);
+	UploadRingEndFrame(ring, 7);
+	UploadRingRetire(ring, 7);
+	AllocateAndCheck(ring, 1024, 0, false);
+	CHECK(ring.Allocations == 10 && ring.Discards == 4 && ring.Wraps == 1);
+}
+
+// Declare the TestFrame 'named structure' data type.
+// A frame the simulated GPU has not finished: the ranges it reads, and the buffer memory they are in (a discard gives the buffer new memory).
+struct TestFrame {
+	unsigned long long Frame;
+	vector<UploadRingAllocation> Ranges;
+};
+
+// Return true if two ranges of the buffer overlap.
+static bool Overlap(const UploadRingAllocation& a, const UploadRingAllocation& b)
+{
+	return a.Offset < b.Offset + b.Size && b.Offset < a.Offset + a.Size;
+}
+
+// Many frames of random allocations, each retired after a random latency of up to MaximumLatency frames, as the objRenderer program retires the frames the GPU has finished (a query per frame).
+// No allocation may overlap an allocation, of its own frame or of a frame not yet retired, in the same buffer memory. When the frames in flight (at most three: two not retired, and the current frame)
+// fit in the ring together with the bytes skipped at its end when it wraps, the ring never discards the buffer after the first allocation: retiring frees the space the next frames need.
+static void TestRandomFrames(int MaximumLatency, unsigned int MaximumFrameBytes, bool ExpectNoDiscards)
+{
+	std::mt19937 random(MaximumLatency * 7919 + MaximumFrameBytes);
+	UploadRing ring;
+	CreateUploadRing(ring, 65536, UPLOAD_RING_CONSTANT_ALIGNMENT);
+	vector<TestFrame> inFlight;								// Oldest first, in the current buffer memory.
+	bool valid = true, aligned = true;
+	for (unsigned long long frame = 0; frame < 20000; frame++)
+	{
+		// The GPU finishes the frames older than the latency.
+		int latency = (int)(random() % (MaximumLatency + 1));
+		while ((int)inFlight.size() > latency)
+		{
+			UploadRingRetire(ring, inFlight.front().Frame);
+			inFlight.erase(inFlight.begin());
+		}
+
+		TestFrame current = { frame, {} };
+		unsigned int frameBytes = 0;
+		while (true)
+		{
+			unsigned int size = 1 + (unsigned int)(random() % 3000);
+			unsigned int alignedSize = (size + UPLOAD_RING_CONSTANT_ALIGNMENT - 1) & ~(UPLOAD_RING_CONSTANT_ALIGNMENT - 1);
+			if (frameBytes + alignedSize > MaximumFrameBytes)
+				break;
+			frameBytes += alignedSize;
+			UploadRingAllocation allocation;
+			if (!CHECK(UploadRingAllocate(ring, size, allocation) == 0))
+				return;
+			aligned = aligned && allocation.Offset % UPLOAD_RING_CONSTANT_ALIGNMENT == 0 && allocation.Size >= size && allocation.Offset + allocation.Size <= ring.Size;
+			if (allocation.Discard)
+			{
+				inFlight.clear();							// The frames in flight read the old memory.
+				current.Ranges.clear();
+			}
+			for (const TestFrame& other : inFlight)
+				for (const UploadRingAllocation& range : other.Ranges)
+					valid = valid && !Overlap(allocation, range);
+			for (const UploadRingAllocation& range : current.Ranges)
+				valid = valid && !Overlap(allocation, range);
+			current.Ranges.push_back(allocation);
+		}
+		UploadRingEndFrame(ring, frame);
+		if (!current.Ranges.empty())
+			inFlight.push_back(current);
+	}
+	printf("Latency up to %d frames, up to %u bytes per frame: %llu allocations, %llu discards, %llu wraps\n", MaximumLatency, MaximumFrameBytes, ring.Allocations, ring.Discards, ring.Wraps);
+	CHECK(valid);
+	CHECK(aligned);
+	CHECK(ring.Wraps > 0);
+	if (ExpectNoDiscards)
+		CHECK(ring.Discards == 1);
+	else
+		CHECK(ring.Discards > 1);
+}
+
+// main function: Definition
+int main()
+{
+	TestWrapAndRetire();
+	TestRandomFrames(2, 20480, true);						// Three frames of 20480 bytes, and up to 3072 bytes skipped at the end of the ring, fit in its 65536 bytes.
+	TestRandomFrames(3, 30000, false);						// Four frames of 30000 bytes do not.
+	return TestResult();
+}
+
+// End: Function Definitions.
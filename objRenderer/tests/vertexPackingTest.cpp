@@ -0,0 +1,180 @@
+// vertexPackingTest
+// Version 3.1
+//
+// Description
+// Tests that vertices packed by the PackVertices function and unpacked by the UnpackVertices function are within the error the VertexPackingErrorBound function guarantees, as measured by the MeasureVertexPackingError function:
+// vertices with random geometric vertices, texture coordinates, and vertex normal vectors pointing every way (the lower half of the octahedron, z < 0, is folded onto the corners of the square), and vertex normal vectors along each axis, either way.
+// A coordinate that every vertex shares (a scale of 0) is unpacked exactly as its minimum, and 32-bit indices up to 65535 are converted by the PackIndices function to the same 16-bit indices.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Test check Header File.
+#include "testCheck.h"
+
+// Packed vertex format Header File.
+#include "vertexPacking.h"
+
+// Vector Container Class.
+#include <vector>											// Vector class, used to hold the vertices packed.
+
+// Random Number Generation.
+#include <random>											// Mersenne twister engine, uniform real distribution.
+
+// Mathematical Functions.
+#include <cmath>											// Mathematical function sqrt.
+
+// Using Declarations and Directives.
+using std::vector;
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// Pack and unpack Vertices, print the error measured and the bound, and check that each measured error is within its bound.
+static void CheckError(const vector<VERTEX>& Vertices, const char* Description)
+{
+	VertexPackingBounds bounds;
+	ComputeVertexPackingBounds(Vertices.data(), (int)Vertices.size(), bounds);
+	VertexPackingError bound, measured;
+	VertexPackingErrorBound(bounds, bound);
+	MeasureVertexPackingError(Vertices.data(), (int)Vertices.size(), bounds, measured);
+	printf("%s: geometric vertex error %g (bound %g), vertex normal vector error %g (bound %g), texture coordinate error %g (bound %g)\n", Description,
+		measured.GeometricVertex, bound.GeometricVertex, measured.VertexNormalVector, bound.VertexNormalVector, measured.VertexTextureCoordinate, bound.VertexTextureCoordinate);
+	CHECK(measured.GeometricVertex <= bound.GeometricVertex);
+	CHECK(measured.VertexNormalVector <= bound.VertexNormalVector);
+	CHECK(measured.VertexTextureCoordinate <= bound.VertexTextureCoordinate);
+}
+
+// Random vertices, with vertex normal vectors of random directions and lengths, among them many with z < 0, are packed within the bounds.
+static void TestRandom()
+{
+	std::mt19937 random(9);
+	std::uniform_real_distribution<float> position(-250.0f, 1000.0f), coordinate(-2.0f, 3.0f), direction(-1.0f, 1.0f), length(0.01f, 100.0f);
+	vector<VERTEX> vertices(100000);
+	int lowerHalf = 0;
+	for (VERTEX& vertex : vertices)
+	{
+		vertex.GeometricVertex = XMFLOAT3(position(random), position(random), position(random));
+		vertex.VertexTextureCoordinate = XMFLOAT2(coordinate(random), coordinate(random));
+		float x = direction(random), y = direction(random), z = direction(random), l = std::sqrt(x * x + y * y + z * z);
+		if (l == 0.0f)
+			z = l = 1.0f;
+		float s = length(random) / l;
+		vertex.VertexNormalVector = XMFLOAT3(x * s, y * s, z * s);
+		lowerHalf += z < 0.0f;
+	}
+	CHECK(lowerHalf > 40000);
+	CheckError(vertices, "Random vertices");
+
+	// The same vertices within a small range, so the quantization steps are small.
+	for (VERTEX& vertex : vertices)
+	{
+		vertex.GeometricVertex = XMFLOAT3(vertex.GeometricVertex.x * 1.0e-3f, vertex.GeometricVertex.y * 1.0e-3f, vertex.GeometricVertex.z * 1.0e-3f);
+		vertex.VertexTextureCoordinate = XMFLOAT2(vertex.VertexTextureCoordinate.x * 0.01f + 0.5f, vertex.VertexTextureCoordinate.y * 0.01f + 0.5f);
+	}
+	CheckError(vertices, "Random vertices, small range");
+}
+
+// Vertex normal vectors along each axis, either way, and along the diagonals between the axes, where the octahedron is folded, are packed within the bound, and the axes are unpacked exactly.
+static void TestAxes()
+{
+	const XMFLOAT3 normals[] = {
+		XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 1.0f, 0.0f), XMFLOAT3(0.0f, -1.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT3(0.0f, 0.0f, -1.0f),
+		XMFLOAT3(0.0f, 0.0f, -0.0f), XMFLOAT3(1.0f, 1.0f, 0.0f), XMFLOAT3(-1.0f, 0.0f, -1.0f), XMFLOAT3(0.0f, -1.0f, -1.0f), XMFLOAT3(1.0f, -1.0f, -1.0f), XMFLOAT3(-1.0f, -1.0f, -1.0f),
+	};
+	const int normalsTotal = sizeof(normals) / sizeof(normals[0]);
+	vector<VERTEX> vertices(normalsTotal);
+	for (int v = 0; v < normalsTotal; v++)
+	{
+		vertices[v].GeometricVertex = XMFLOAT3((float)v, 0.0f, 0.0f);
+		vertices[v].VertexNormalVector = normals[v];
+		vertices[v].VertexTextureCoordinate = XMFLOAT2(0.0f, (float)v);
+	}
+	CheckError(vertices, "Axis-aligned vertex normal vectors");
+
+	VertexPackingBounds bounds;
+	ComputeVertexPackingBounds(vertices.data(), normalsTotal, bounds);
+	vector<PACKEDVERTEX> packed(normalsTotal);
+	vector<VERTEX> unpacked(normalsTotal);
+	PackVertices(vertices.data(), normalsTotal, bounds, packed.data());
+	UnpackVertices(packed.data(), normalsTotal, bounds, unpacked.data());
+	bool exact = true;
+	for (int v = 0; v < 6; v++)
+		exact = exact && unpacked[v].VertexNormalVector.x == normals[v].x && unpacked[v].VertexNormalVector.y == normals[v].y && unpacked[v].VertexNormalVector.z == normals[v].z;
+	CHECK(exact);
+	CHECK(unpacked[6].VertexNormalVector.x == 0.0f && unpacked[6].VertexNormalVector.y == 0.0f && unpacked[6].VertexNormalVector.z == 1.0f);	// A vertex normal vector of length 0 is unpacked as (0, 0, 1).
+}
+
+// A coordinate every vertex shares has a scale of 0, and is unpacked exactly as its minimum, however far it is from 0; a flat mesh has no error in that coordinate.
+static void TestZeroScale()
+{
+	vector<VERTEX> vertices(1000);
+	std::mt19937 random(3);
+	std::uniform_real_distribution<float> position(-1.0f, 1.0f);
+	for (VERTEX& vertex : vertices)
+	{
+		vertex.GeometricVertex = XMFLOAT3(position(random), 1234.567f, position(random));
+		vertex.VertexNormalVector = XMFLOAT3(0.0f, 1.0f, 0.0f);
+		vertex.VertexTextureCoordinate = XMFLOAT2(-0.3125f, position(random));
+	}
+	VertexPackingBounds bounds;
+	ComputeVertexPackingBounds(vertices.data(), (int)vertices.size(), bounds);
+	CHECK(bounds.GeometricVertexScale.y == 0.0f && bounds.VertexTextureCoordinateScale.x == 0.0f);
+	vector<PACKEDVERTEX> packed(vertices.size());
+	vector<VERTEX> unpacked(vertices.size());
+	PackVertices(vertices.data(), (int)vertices.size(), bounds, packed.data());
+	UnpackVertices(packed.data(), (int)vertices.size(), bounds, unpacked.data());
+	bool exact = true;
+	for (const VERTEX& vertex : unpacked)
+		exact = exact && vertex.GeometricVertex.y == bounds.GeometricVertexMinimum.y && vertex.GeometricVertex.y == 1234.567f &&
+			vertex.VertexTextureCoordinate.x == bounds.VertexTextureCoordinateMinimum.x && vertex.VertexTextureCoordinate.x == -0.3125f;
+	CHECK(exact);
+	CheckError(vertices, "A flat mesh");
+
+	// A single vertex has a scale of 0 in every coordinate, and is unpacked exactly.
+	VertexPackingBounds one;
+	ComputeVertexPackingBounds(vertices.data(), 1, one);
+	PACKEDVERTEX onePacked;
+	VERTEX oneUnpacked;
+	PackVertices(vertices.data(), 1, one, &onePacked);
+	UnpackVertices(&onePacked, 1, one, &oneUnpacked);
+	CHECK(oneUnpacked.GeometricVertex.x == vertices[0].GeometricVertex.x && oneUnpacked.GeometricVertex.y == vertices[0].GeometricVertex.y && oneUnpacked.GeometricVertex.z == vertices[0].GeometricVertex.z &&
+		oneUnpacked.VertexTextureCoordinate.x == vertices[0].VertexTextureCoordinate.x && oneUnpacked.VertexTextureCoordinate.y == vertices[0].VertexTextureCoordinate.y);
+}
+
+// Every index from 0 to 65535 is converted to the same 16-bit index.
+static void TestIndices()
+{
+	vector<DWORD> indices(65536 + 3);
+	for (DWORD i = 0; i < 65536; i++)
+		indices[i] = 65535 - i;
+	indices[65536] = 65535;
+	indices[65537] = 0;
+	indices[65538] = 32768;
+	vector<unsigned short> packed(indices.size() + 1, 0xABCD);	// One index more, which must not be written.
+	PackIndices(indices.data(), indices.size(), packed.data());
+	bool same = true;
+	for (size_t i = 0; i < indices.size(); i++)
+		same = same && (DWORD)packed[i] == indices[i];
+	CHECK(same);
+	CHECK(packed[indices.size()] == 0xABCD);
+}
+
+// main function: Definition
+int main()
+{
+	TestRandom();
+	TestAxes();
+	TestZeroScale();
+	TestIndices();
+	return TestResult();
+}
+
+// End: Function Definitions.
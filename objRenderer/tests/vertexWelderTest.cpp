@@ -0,0 +1,335 @@
+// vertexWelderTest
+// Version 3.1
+//
+// Description
+// Tests the WeldVertices function: sets of vertex attributes within the position, vertex normal vector, and texture coordinate tolerances are merged into the set of vertex attributes kept first, and those just outside any one tolerance are kept apart,
+// including geometric vertices on either side of a cell boundary of the spatial hash, in one, two, or three axes. Random clustered vertices are welded exactly as by comparing each with every set of vertex attributes kept before it, in order.
+// With tolerances of 0, welding a Wavefront .obj file loaded without deduplication by attributes gives the same Mesh as the exact deduplication of the LoadObj function, which merges -0 and +0, but not vertex normal vectors of different lengths or a rounding apart.
+// Triangles left with two identical indices are removed, and the statistics count the sets of vertex attributes and triangles removed, and the bytes saved.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Test check Header File.
+#include "testCheck.h"
+
+// Vertex welding Header File.
+#include "vertexWelder.h"
+
+// Standard Encapsulated Data and Functions for Manipulating String Data.
+#include <string>											// String class, used to build the Wavefront .obj file.
+
+// File Stream Functions.
+#include <fstream>											// File stream class member functions write, close, etc.
+
+// Random Number Generation.
+#include <random>											// Mersenne twister engine, uniform real and integer distributions.
+
+// Mathematical Functions.
+#include <cmath>											// Mathematical functions cos, sin, sqrt, fabs.
+
+// Memory Functions.
+#include <cstring>											// Memory function memcmp.
+
+// File System Functions.
+#include <filesystem>										// File system function remove.
+
+// Using Declarations and Directives.
+using std::vector;
+using std::string;
+namespace fs = std::filesystem;
+
+// The Wavefront .obj file loaded by the TestZeroTolerances function, in the current directory.
+static const char* const TestFileName = "vertexWelderTest.obj";
+
+// The tolerances most tests weld with. The cells of the spatial hash are 0.02 wide.
+static VertexWeldOptions TestOptions()
+{
+	VertexWeldOptions options;
+	options.PositionTolerance = 0.01f;
+	options.NormalAngleDegrees = 5.0f;
+	options.TextureCoordinateTolerance = 0.01f;
+	return options;
+}
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// Return a set of vertex attributes.
+static VERTEX MakeVertex(float x, float y, float z, float nx = 0.0f, float ny = 0.0f, float nz = 1.0f, float u = 0.0f, float v = 0.0f)
+{
+	VERTEX vertex;
+	vertex.GeometricVertex = XMFLOAT3(x, y, z);
+	vertex.VertexNormalVector = XMFLOAT3(nx, ny, nz);
+	vertex.VertexTextureCoordinate = XMFLOAT2(u, v);
+	return vertex;
+}
+
+// Return true if a and b are the same set of vertex attributes, bit for bit.
+static bool SameVertex(const VERTEX& a, const VERTEX& b)
+{
+	return std::memcmp(&a, &b, sizeof(VERTEX)) == 0;
+}
+
+// Weld Vertices, and return the index each set of vertex attributes was welded to.
+// Each set of vertex attributes is the first vertex of one triangle, whose other two are two sets of vertex attributes far from all the others, added after them, so no triangle is removed and the first index of each triangle is the index welded to.
+static vector<DWORD> Weld(vector<VERTEX>& Vertices, const VertexWeldOptions& Options, VertexWeldStatistics& Statistics)
+{
+	DWORD total = (DWORD)Vertices.size();
+	Vertices.push_back(MakeVertex(1.0e6f, 0.0f, 0.0f));
+	Vertices.push_back(MakeVertex(0.0f, 1.0e6f, 0.0f));
+	vector<DWORD> indices;
+	for (DWORD v = 0; v < total; v++)
+	{
+		indices.push_back(v);
+		indices.push_back(total);
+		indices.push_back(total + 1);
+	}
+	WeldVertices(Vertices, indices, Options, Statistics);
+	vector<DWORD> remap;
+	for (size_t i = 0; i < indices.size(); i += 3)
+		remap.push_back(indices[i]);
+	Vertices.resize(Vertices.size() - 2);
+	return remap;
+}
+
+// Return true if b is within the tolerances of a, compared as described in the vertexWelder.h header file, independently of the WeldVertices function.
+static bool ReferenceWithin(const VERTEX& a, const VERTEX& b, const VertexWeldOptions& Options)
+{
+	double dx = (double)a.GeometricVertex.x - b.GeometricVertex.x, dy = (double)a.GeometricVertex.y - b.GeometricVertex.y, dz = (double)a.GeometricVertex.z - b.GeometricVertex.z;
+	if (std::sqrt(dx * dx + dy * dy + dz * dz) > Options.PositionTolerance)
+		return false;
+	if (std::fabs((double)a.VertexTextureCoordinate.x - b.VertexTextureCoordinate.x) > Options.TextureCoordinateTolerance ||
+		std::fabs((double)a.VertexTextureCoordinate.y - b.VertexTextureCoordinate.y) > Options.TextureCoordinateTolerance)
+		return false;
+	const XMFLOAT3& na = a.VertexNormalVector;
+	const XMFLOAT3& nb = b.VertexNormalVector;
+	double lengths = std::sqrt(((double)na.x * na.x + (double)na.y * na.y + (double)na.z * na.z) * ((double)nb.x * nb.x + (double)nb.y * nb.y + (double)nb.z * nb.z));
+	return lengths > 0.0 && ((double)na.x * nb.x + (double)na.y * nb.y + (double)na.z * nb.z) / lengths >= std::cos(Options.NormalAngleDegrees * 3.14159265358979323846 / 180.0);
+}
+
+// Sets of vertex attributes within every tolerance of a set of vertex attributes kept are merged into it, and the set of vertex attributes kept first is preferred, even when one kept later is nearer.
+static void TestWithin()
+{
+	float angle = 4.9f * 3.14159265f / 180.0f;
+	vector<VERTEX> vertices = {
+		MakeVertex(0.5f, 0.5f, 0.5f, 0.0f, 0.0f, 1.0f, 0.25f, 0.75f),						// 0: kept.
+		MakeVertex(0.5f + 0.0099f, 0.5f, 0.5f, 0.0f, 0.0f, 1.0f, 0.25f, 0.75f),				// 1: within the position tolerance of 0.
+		MakeVertex(0.5f, 0.5f, 0.5f, std::sin(angle), 0.0f, std::cos(angle), 0.25f, 0.75f),	// 2: within the vertex normal vector tolerance of 0.
+		MakeVertex(0.5f, 0.5f, 0.5f, 0.0f, 0.0f, 7.0f, 0.25f, 0.75f),						// 3: a longer vertex normal vector in the same direction as 0's.
+		MakeVertex(0.5f, 0.5f, 0.5f, 0.0f, 0.0f, 1.0f, 0.25f + 0.0099f, 0.75f - 0.0099f),	// 4: within the texture coordinate tolerance of 0, in both coordinates.
+		MakeVertex(0.5f + 0.0055f, 0.5f + 0.0055f, 0.5f - 0.0055f, std::sin(angle), 0.0f, std::cos(angle), 0.25f + 0.0099f, 0.75f),	// 5: within every tolerance of 0 at once.
+
+		// The set of vertex attributes kept first is preferred: 7 is kept in the cell after 6's, and 8, in 7's cell, is within the tolerances of both, nearer 7.
+		MakeVertex(0.019f, 2.0f, 2.0f),														// 6: kept, in cell 0 of x.
+		MakeVertex(0.034f, 2.0f, 2.0f),														// 7: kept, 0.015 from 6, in cell 1 of x.
+		MakeVertex(0.027f, 2.0f, 2.0f),														// 8: 0.008 from 6 and 0.007 from 7.
+
+		// A chain of sets of vertex attributes, each within the tolerances of the one before it, is not merged into one: 10 is within the tolerances of 9, but 11 is only within the tolerances of 10, which is not kept.
+		MakeVertex(3.0f, 3.0f, 3.0f),														// 9: kept.
+		MakeVertex(3.008f, 3.0f, 3.0f),														// 10: merged into 9.
+		MakeVertex(3.016f, 3.0f, 3.0f),														// 11: kept.
+	};
+	VertexWeldStatistics statistics;
+	vector<VERTEX> kept = vertices;
+	vector<DWORD> remap = Weld(kept, TestOptions(), statistics);
+	const DWORD expected[] = { 0, 0, 0, 0, 0, 0, 1, 2, 1, 3, 3, 4 };
+	bool same = remap.size() == 12;
+	for (size_t v = 0; same && v < 12; v++)
+		same = remap[v] == expected[v];
+	CHECK(same);
+	CHECK(kept.size() == 5 && SameVertex(kept[0], vertices[0]) && SameVertex(kept[1], vertices[6]) && SameVertex(kept[2], vertices[7]) && SameVertex(kept[3], vertices[9]) && SameVertex(kept[4], vertices[11]));
+}
+
+// Sets of vertex attributes just outside any one tolerance are kept apart; geometric vertices within the position tolerance on either side of a cell boundary, in one, two, or three axes, are merged.
+static void TestOutside()
+{
+	float angle = 5.1f * 3.14159265f / 180.0f;
+	vector<VERTEX> vertices = {
+		MakeVertex(0.5f, 0.5f, 0.5f, 0.0f, 0.0f, 1.0f, 0.25f, 0.75f),						// 0: kept.
+		MakeVertex(0.5f + 0.0101f, 0.5f, 0.5f, 0.0f, 0.0f, 1.0f, 0.25f, 0.75f),				// 1: just outside the position tolerance of 0.
+		MakeVertex(0.5f - 0.0059f, 0.5f + 0.0059f, 0.5f - 0.0059f, 0.0f, 0.0f, 1.0f, 0.25f, 0.75f),	// 2: just outside the position tolerance of 0, diagonally (0.01022).
+		MakeVertex(0.5f, 0.5f, 0.5f, 0.0f, std::sin(angle), std::cos(angle), 0.25f, 0.75f),	// 3: just outside the vertex normal vector tolerance of 0.
+		MakeVertex(0.5f, 0.5f, 0.5f, 0.0f, 0.0f, 1.0f, 0.25f + 0.0101f, 0.75f),				// 4: just outside the texture coordinate tolerance of 0, in u.
+		MakeVertex(0.5f, 0.5f, 0.5f, 0.0f, 0.0f, 1.0f, 0.25f, 0.75f - 0.0101f),				// 5: just outside the texture coordinate tolerance of 0, in v.
+		MakeVertex(0.5f, 0.5f, 0.5f, 0.0f, 0.0f, 0.0f, 0.25f, 0.75f),						// 6: a vertex normal vector of length 0, only within the tolerance of another of length 0.
+		MakeVertex(0.5f, 0.5f, 0.5f, 0.0f, 0.0f, -0.0f, 0.25f, 0.75f),						// 7: merged into 6.
+
+		// Geometric vertices within the position tolerance, on either side of the cell boundaries at 2.0 (cell 100 of each axis), and of those at 0.
+		MakeVertex(1.9995f, 5.0f, 5.0f),													// 8: kept, at the top of its cell in x.
+		MakeVertex(2.0005f, 5.0f, 5.0f),													// 9: merged into 8 across the boundary in x.
+		MakeVertex(5.0f, 2.0005f, 2.0005f),													// 10: kept.
+		MakeVertex(5.0f, 1.9995f, 1.9995f),													// 11: merged into 10 across the boundaries in y and z.
+		MakeVertex(1.9995f, 1.9995f, 2.0005f),												// 12: kept.
+		MakeVertex(2.0005f, 2.0005f, 1.9995f),												// 13: merged into 12 across the boundaries in x, y, and z.
+		MakeVertex(-0.001f, -0.001f, -0.001f),												// 14: kept, in cell -1 of each axis.
+		MakeVertex(0.001f, 0.001f, 0.001f),													// 15: merged into 14 across the boundaries at 0.
+		MakeVertex(2.0101f, 5.0f, 5.0f),													// 16: kept, 0.0106 from 8 across the boundary, and within the tolerances only of 9, which is not kept.
+	};
+	VertexWeldStatistics statistics;
+	vector<VERTEX> kept = vertices;
+	vector<DWORD> remap = Weld(kept, TestOptions(), statistics);
+	const DWORD expected[] = { 0, 1, 2, 3, 4, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11 };
+	bool same = remap.size() == 17;
+	for (size_t v = 0; same && v < 17; v++)
+		same = remap[v] == expected[v];
+	if (!CHECK(same))
+		for (size_t v = 0; v < remap.size(); v++)
+			printf("Set of vertex attributes %d welded to %u, expected %u\n", (int)v, remap[v], expected[v]);
+	CHECK(statistics.VerticesBefore == 19 && statistics.VerticesAfter == 14 && statistics.PrimitivesRemoved == 0);
+}
+
+// Random clusters of sets of vertex attributes, many within the tolerances of each other and many just outside them, are welded exactly as by comparing each with every set of vertex attributes kept before it, in order.
+static void TestRandom()
+{
+	std::mt19937 random(25);
+	std::uniform_real_distribution<float> center(-1.0f, 1.0f), offset(-0.012f, 0.012f), tilt(-0.08f, 0.08f), unit(0.0f, 1.0f);
+	std::uniform_int_distribution<int> cluster(0, 299);
+	VertexWeldOptions options = TestOptions();
+	vector<VERTEX> centers(300);
+	for (VERTEX& c : centers)
+		c = MakeVertex(center(random), center(random), center(random), center(random), center(random), center(random), unit(random), unit(random));
+	vector<VERTEX> vertices(4000);
+	for (VERTEX& vertex : vertices)
+	{
+		const VERTEX& c = centers[cluster(random)];
+		vertex = MakeVertex(c.GeometricVertex.x + offset(random), c.GeometricVertex.y + offset(random), c.GeometricVertex.z + offset(random),
+			c.VertexNormalVector.x + tilt(random), c.VertexNormalVector.y + tilt(random), c.VertexNormalVector.z + tilt(random),
+			c.VertexTextureCoordinate.x + offset(random), c.VertexTextureCoordinate.y + offset(random));
+	}
+
+	// The reference: each set of vertex attributes is merged into the first one kept within its tolerances, searching all of them.
+	vector<VERTEX> referenceKept;
+	vector<int> reference(vertices.size(), -1);
+	for (size_t v = 0; v < vertices.size(); v++)
+	{
+		for (size_t k = 0; k < referenceKept.size() && reference[v] == -1; k++)
+			if (ReferenceWithin(referenceKept[k], vertices[v], options))
+				reference[v] = (int)k;
+		if (reference[v] == -1)
+		{
+			reference[v] = (int)referenceKept.size();
+			referenceKept.push_back(vertices[v]);
+		}
+	}
+
+	VertexWeldStatistics statistics;
+	vector<VERTEX> kept = vertices;
+	vector<DWORD> remap = Weld(kept, options, statistics);
+	int merged = 0;
+	bool same = remap.size() == vertices.size() && kept.size() == referenceKept.size();
+	for (size_t v = 0; same && v < vertices.size(); v++)
+	{
+		same = remap[v] == (DWORD)reference[v];
+		merged += !SameVertex(kept[remap[v]], vertices[v]);
+	}
+	for (size_t k = 0; same && k < kept.size(); k++)
+		same = SameVertex(kept[k], referenceKept[k]);
+	printf("Random clusters: %d sets of vertex attributes welded to %d, %d merged\n", (int)vertices.size(), (int)kept.size(), merged);
+	CHECK(same);
+	CHECK(merged > 500 && kept.size() > 1000);								// Many sets of vertex attributes are merged, and many are kept apart.
+}
+
+// With tolerances of 0, welding gives the same Mesh as the exact deduplication of the LoadObj function, which merges a geometric vertex, vertex normal vector, or texture coordinate of -0 with one of +0.
+static void TestZeroTolerances()
+{
+	string text =
+		"v 0 0 0\nv 1 0 0\nv 0 1 0\nv 0 0 -0\nv -0 1 0\nv 1 0 0.000001\nv 1 0 0\n"
+		"vt 0 0\nvt 1 0\nvt 0 1\nvt -0 0\n"
+		"vn 0 0 1\nvn -0 0 1\nvn 0 0 1.0000001\nvn 0 0.000001 1\n";
+	// Each triangle refers to a different face element triplet for the same set of vertex attributes, or one that differs in a single float, and no triangle refers to the same set of vertex attributes twice.
+	text += "f 1/1/1 2/2/1 3/3/1\n"
+			"f 4/4/2 7/2/1 5/3/2\n"								// The same sets of vertex attributes as the first triangle, with -0 for +0.
+			"f 1/1/3 6/2/1 3/3/1\n"								// A longer vertex normal vector in the same direction, and a geometric vertex z 0.000001 from the first triangle's.
+			"f 4/1/1 2/2/2 5/3/1\n"
+			"f 1/1/4 2/2/1 3/3/1\n";							// A vertex normal vector tilted 0.000001 radians, whose cosine with the first triangle's rounds to 1.
+	std::ofstream file(TestFileName, std::ios::out | std::ios::binary | std::ios::trunc);
+	file << text;
+	file.close();
+	CHECK((bool)file);
+
+	LoadObjOptions exact, triplets;
+	triplets.DedupByAttributes = false;
+	Mesh exactMesh, weldedMesh;
+	CHECK(LoadObj(TestFileName, exact, exactMesh) == 0);
+	CHECK(LoadObj(TestFileName, triplets, weldedMesh) == 0);
+	CHECK(weldedMesh.Vertices.size() > exactMesh.Vertices.size());
+
+	VertexWeldOptions zero;
+	zero.PositionTolerance = 0.0f;
+	zero.NormalAngleDegrees = 0.0f;
+	zero.TextureCoordinateTolerance = 0.0f;
+	VertexWeldStatistics statistics;
+	WeldVertices(weldedMesh.Vertices, weldedMesh.Indices, zero, statistics);
+	CHECK(exactMesh.Vertices.size() == 6 && weldedMesh.Vertices.size() == exactMesh.Vertices.size() && weldedMesh.Indices == exactMesh.Indices &&
+		  std::memcmp(weldedMesh.Vertices.data(), exactMesh.Vertices.data(), exactMesh.Vertices.size() * sizeof(VERTEX)) == 0);
+	CHECK(statistics.PrimitivesRemoved == 0);
+
+	std::error_code error;
+	fs::remove(TestFileName, error);
+}
+
+// Triangles left with two or three identical indices are removed, the set of vertex attributes only they referred to is kept, and the statistics count what was removed.
+static void TestDegenerate()
+{
+	vector<VERTEX> vertices = {
+		MakeVertex(0.0f, 0.0f, 0.0f),						// 0: kept.
+		MakeVertex(1.0f, 0.0f, 0.0f),						// 1: kept.
+		MakeVertex(0.0f, 1.0f, 0.0f),						// 2: kept.
+		MakeVertex(0.005f, 0.0f, 0.0f),						// 3: merged into 0.
+		MakeVertex(1.0f, 0.005f, 0.0f),						// 4: merged into 1.
+		MakeVertex(5.0f, 5.0f, 5.0f),						// 5: kept, referred to only by a triangle removed.
+		MakeVertex(0.0f, 1.005f, 0.0f),						// 6: merged into 2.
+	};
+	vector<DWORD> indices = {
+		0, 1, 2,											// Kept.
+		0, 3, 5,											// Removed: 0 and 3 are merged.
+		4, 2, 1,											// Removed: 4 and 1 are merged.
+		2, 3, 4,											// Kept, as 2, 0, 1.
+		6, 5, 2,											// Removed: 6 and 2 are merged, with the third index last.
+		3, 0, 0,											// Removed: all three are merged.
+		3, 1, 6,											// Kept, as 0, 1, 2.
+	};
+	VertexWeldStatistics statistics;
+	WeldVertices(vertices, indices, TestOptions(), statistics);
+	const vector<DWORD> expected = { 0, 1, 2, 2, 0, 1, 0, 1, 2 };
+	CHECK(indices == expected);
+	CHECK(vertices.size() == 4 && vertices[3].GeometricVertex.x == 5.0f);
+	CHECK(statistics.VerticesBefore == 7 && statistics.VerticesAfter == 4 && statistics.PrimitivesRemoved == 4);
+
+	// The bytes saved are those of the sets of vertex attributes and indices removed.
+	CHECK(statistics.BytesSaved == (size_t)(7 - 4) * sizeof(VERTEX) + (size_t)(21 - 9) * sizeof(DWORD));
+	CHECK(statistics.BytesSaved == 3 * 32 + 12 * 4);
+
+	// Nothing within the tolerances saves nothing.
+	vector<VERTEX> apart = { MakeVertex(0.0f, 0.0f, 0.0f), MakeVertex(1.0f, 0.0f, 0.0f), MakeVertex(0.0f, 1.0f, 0.0f) };
+	vector<DWORD> apartIndices = { 0, 1, 2 };
+	WeldVertices(apart, apartIndices, TestOptions(), statistics);
+	CHECK(apart.size() == 3 && apartIndices.size() == 3 && statistics.VerticesAfter == 3 && statistics.PrimitivesRemoved == 0 && statistics.BytesSaved == 0);
+
+	// An empty mesh is welded to an empty mesh.
+	vector<VERTEX> none;
+	vector<DWORD> noIndices;
+	WeldVertices(none, noIndices, TestOptions(), statistics);
+	CHECK(none.empty() && noIndices.empty() && statistics.VerticesBefore == 0 && statistics.VerticesAfter == 0 && statistics.BytesSaved == 0);
+}
+
+// main function: Definition
+int main()
+{
+	TestWithin();
+	TestOutside();
+	TestRandom();
+	TestZeroTolerances();
+	TestDegenerate();
+	return TestResult();
+}
+
+// End: Function Definitions.
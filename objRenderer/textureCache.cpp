@@ -0,0 +1,754 @@
+// textureCache
+// Version 3.1
+//
+// Description
+// These functions cook a texture image file (a .png file) into a texture cache file (.dds file), and load the texture cache file back by mapping it into memory.
+// Cooking builds the mipmap chain of the texture image, averaging each 2x2 pixels of one level into one pixel of the next in linear light (the texture image's colors are sRGB-encoded, so averaging the encoded values would darken the smaller levels),
+// then encodes every level into 4x4 pixel blocks of a block-compressed format, BC1 or BC7, dividing the rows of blocks among the threads of the job system (see jobSystem.h).
+// Loading a texture cache file does no decoding: the blocks are copied by the operating system from the file directly into the calling program's address space, in the layout Direct3D reads them in.
+//
+// Each block is encoded by fitting a line through its pixels' colors: the line through their mean along the principal axis of their covariance, found by power iteration.
+// The endpoints of the block are the ends of the pixels' projections onto the line; each pixel's index selects the color nearest it of those the format interpolates between the quantized endpoints,
+// then the endpoints are refitted to the selected interpolation weights by least squares, and the encoding with the smaller error is kept.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Texture cache (.dds file) I/O Header File.
+// Includes the Image file I/O Header File and the read-only memory-mapped file I/O Header File.
+#include "textureCache.h"
+
+// Job system Header File.
+#include "jobSystem.h"
+
+// Standard Encapsulated Data and Functions for Manipulating String Data.
+#include <string>											// String class member functions c_str, etc.
+
+// File Stream Functions.
+#include <fstream>											// File stream class member functions write, close, etc.
+
+// File System Functions.
+#include <filesystem>										// File system functions rename, remove.
+
+// Algorithm Functions.
+#include <algorithm>										// Algorithm functions min, max, swap.
+
+// Mathematical Functions.
+#include <cmath>											// Mathematical functions powf, sqrtf, floorf.
+
+// Memory Functions.
+#include <cstring>											// Memory functions memcpy, memcmp, memset.
+
+// Using Declarations and Directives.
+using std::string;
+using std::vector;
+using std::ofstream;
+using std::ios;
+using std::error_code;
+using std::min;
+using std::max;
+using std::memcpy;
+using std::memset;
+namespace fs = std::filesystem;
+
+//***
+// External Variable Global Definitions.
+//***
+
+bool TextureCacheEnabled = true;
+unsigned int TextureCacheFormat = TEXTURE_FORMAT_BC1_UNORM;
+
+// End: External Variable Global Definitions.
+
+// Constants of the .dds file format, and of texture cache files.
+static const unsigned int DdsMagic = 0x20534444;			// "DDS ".
+static const unsigned int DdsFourCCDx10 = 0x30315844;		// "DX10".
+static const unsigned int TextureCacheTag = 0x544A424F;		// "OBJT", in DDS_HEADER.dwReserved1[0].
+
+// The interpolation weights, out of 64, of the 16 colors of a BC7 mode 6 block.
+static const int Bc7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+// The interpolation weights of the 4 colors of a BC1 block (color 0, color 1, 2/3 color 0 + 1/3 color 1, 1/3 color 0 + 2/3 color 1), as the fraction of color 1.
+static const float Bc1Weights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+// The number of times the endpoints of a block are refitted to its indices.
+static const int TextureRefitIterations = 2;
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// TextureCacheFileName function: Definition
+//   This function returns the name of the texture cache file of a source texture image file, i.e., the source file name followed by ".dds" (Wood.png -> Wood.png.dds).
+static string TextureCacheFileName(const char* SourceFileName)
+{
+	return string(SourceFileName) + ".dds";
+}
+
+// TextureSourceHash function: Definition
+//   This function sets Hash to the 64-bit FNV-1a hash of the contents of the source texture image file, which identifies the version of the source file a texture cache file was cooked from.
+//   It returns 0 on success, or 1 if the source file cannot be read.
+static int TextureSourceHash(const char* SourceFileName, unsigned long long& Hash)
+{
+	MappedFile source;
+	if (MapFile(SourceFileName, source) == 1)
+		return 1;
+	Hash = 14695981039346656037ull;
+	for (size_t i = 0; i < source.Size; i++)
+		Hash = (Hash ^ (unsigned char)source.Data[i]) * 1099511628211ull;
+	UnmapFile(source);
+	return 0;
+}
+
+// TextureBlockBytes function: Definition
+//   This function returns the size, in bytes, of one 4x4 pixel block of Format, or 0 if Format is not TEXTURE_FORMAT_BC1_UNORM or TEXTURE_FORMAT_BC7_UNORM.
+static int TextureBlockBytes(unsigned int Format)
+{
+	return Format == TEXTURE_FORMAT_BC1_UNORM ? 8 : Format == TEXTURE_FORMAT_BC7_UNORM ? 16 : 0;
+}
+
+// TextureSrgbToLinear function: Definition
+//   This function returns the linear light value (0 to 1) of each 8-bit sRGB-encoded value, from a table computed once.
+static float TextureSrgbToLinear(unsigned char Value)
+{
+	static const vector<float> table = []
+	{
+		vector<float> values(256);
+		for (int i = 0; i < 256; i++)
+		{
+			float s = i / 255.0f;
+			values[i] = s <= 0.04045f ? s / 12.92f : powf((s + 0.055f) / 1.055f, 2.4f);
+		}
+		return values;
+	}();
+	return table[Value];
+}
+
+// TextureLinearToSrgb function: Definition
+//   This function returns the 8-bit sRGB-encoded value of a linear light value (0 to 1), rounded to the nearest integer.
+static unsigned char TextureLinearToSrgb(float Value)
+{
+	float s = Value <= 0.0031308f ? Value * 12.92f : 1.055f * powf(Value, 1.0f / 2.4f) - 0.055f;
+	s = s < 0.0f ? 0.0f : s > 1.0f ? 1.0f : s;
+	return (unsigned char)(s * 255.0f + 0.5f);
+}
+
+// BuildMipChain function: Definition
+//   This function sets Mips to the mipmap chain of Source. Each pixel of a level is the average of 2x2 pixels of the level before it: red, green, and blue are averaged in linear light, and alpha is averaged as is.
+//   When a level's width or height is odd, its last column or row is not averaged into the next level. The rows of each level are divided among the threads of the job system.
+void BuildMipChain(const Image& Source, vector<Image>& Mips)
+{
+	Mips.assign(1, Source);
+	while (Mips.back().Width > 1 || Mips.back().Height > 1)
+	{
+		const Image& previous = Mips.back();
+		Image next;
+		next.Width = max(1, previous.Width / 2);
+		next.Height = max(1, previous.Height / 2);
+		next.Pixels.resize((size_t)next.Width * next.Height * 4);
+		JobParallelFor(next.Height, 16, [&](int Begin, int End)
+			{
+				for (int y = Begin; y < End; y++)
+					for (int x = 0; x < next.Width; x++)
+					{
+						const int sourceX[2] = { min(2 * x, previous.Width - 1), min(2 * x + 1, previous.Width - 1) };
+						const int sourceY[2] = { min(2 * y, previous.Height - 1), min(2 * y + 1, previous.Height - 1) };
+						float color[3] = { 0.0f, 0.0f, 0.0f };
+						int alpha = 0;
+						for (int j = 0; j < 2; j++)
+							for (int i = 0; i < 2; i++)
+							{
+								const unsigned char* pixel = &previous.Pixels[((size_t)sourceY[j] * previous.Width + sourceX[i]) * 4];
+								for (int c = 0; c < 3; c++)
+									color[c] += TextureSrgbToLinear(pixel[c]);
+								alpha += pixel[3];
+							}
+						unsigned char* pixel = &next.Pixels[((size_t)y * next.Width + x) * 4];
+						for (int c = 0; c < 3; c++)
+							pixel[c] = TextureLinearToSrgb(color[c] * 0.25f);
+						pixel[3] = (unsigned char)((alpha + 2) / 4);
+					}
+			});
+		Mips.push_back(std::move(next));
+	}
+}
+
+// TextureFitLine function: Definition
+//   This function finds the line through the mean of the first Channels components of the 16 pixels of a block, along the principal axis of their covariance (found by power iteration),
+//   and sets Start and End to the points of the line at the smallest and largest projection of a pixel onto it, clamped between 0 and 255.
+static void TextureFitLine(const float Pixels[16][4], int Channels, float Start[4], float End[4])
+{
+	float mean[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	for (int p = 0; p < 16; p++)
+		for (int c = 0; c < Channels; c++)
+			mean[c] += Pixels[p][c] / 16.0f;
+
+	float covariance[4][4] = {};
+	for (int p = 0; p < 16; p++)
+		for (int r = 0; r < Channels; r++)
+			for (int c = 0; c < Channels; c++)
+				covariance[r][c] += (Pixels[p][r] - mean[r]) * (Pixels[p][c] - mean[c]);
+
+	// Start from the column of the covariance of the component that varies most, which is never perpendicular to the principal axis.
+	int largest = 0;
+	for (int c = 1; c < Channels; c++)
+		if (covariance[c][c] > covariance[largest][largest])
+			largest = c;
+	float axis[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	if (covariance[largest][largest] > 0.0f)
+		for (int c = 0; c < Channels; c++)
+			axis[c] = covariance[c][largest];
+	for (int iteration = 0; iteration < 8; iteration++)
+	{
+		float next[4] = { 0.0f, 0.0f, 0.0f, 0.0f }, length = 0.0f;
+		for (int r = 0; r < Channels; r++)
+		{
+			for (int c = 0; c < Channels; c++)
+				next[r] += covariance[r][c] * axis[c];
+			length += next[r] * next[r];
+		}
+		if (length < 1e-12f)
+			break;											// The pixels are (nearly) one color, and any axis will do.
+		length = 1.0f / sqrtf(length);
+		for (int c = 0; c < Channels; c++)
+			axis[c] = next[c] * length;
+	}
+
+	float minimum = 0.0f, maximum = 0.0f;
+	for (int p = 0; p < 16; p++)
+	{
+		float projection = 0.0f;
+		for (int c = 0; c < Channels; c++)
+			projection += (Pixels[p][c] - mean[c]) * axis[c];
+		minimum = min(minimum, projection);
+		maximum = max(maximum, projection);
+	}
+	for (int c = 0; c < Channels; c++)
+	{
+		Start[c] = min(255.0f, max(0.0f, mean[c] + axis[c] * minimum));
+		End[c] = min(255.0f, max(0.0f, mean[c] + axis[c] * maximum));
+	}
+}
+
+// TextureRefitLine function: Definition
+//   This function sets Start and End to the endpoints that best reproduce the 16 pixels of a block by least squares, when pixel p is (1 - Weights[p]) * Start + Weights[p] * End, clamped between 0 and 255.
+//   It returns false, leaving Start and End unchanged, if the weights do not determine the endpoints (e.g., every pixel has the same weight).
+static bool TextureRefitLine(const float Pixels[16][4], int Channels, const float Weights[16], float Start[4], float End[4])
+{
+	float startStart = 0.0f, startEnd = 0.0f, endEnd = 0.0f;
+	for (int p = 0; p < 16; p++)
+	{
+		startStart += (1.0f - Weights[p]) * (1.0f - Weights[p]);
+		startEnd += (1.0f - Weights[p]) * Weights[p];
+		endEnd += Weights[p] * Weights[p];
+	}
+	float determinant = startStart * endEnd - startEnd * startEnd;
+	if (fabsf(determinant) < 1e-6f)
+		return false;
+
+	for (int c = 0; c < Channels; c++)
+	{
+		float startPixel = 0.0f, endPixel = 0.0f;
+		for (int p = 0; p < 16; p++)
+		{
+			startPixel += (1.0f - Weights[p]) * Pixels[p][c];
+			endPixel += Weights[p] * Pixels[p][c];
+		}
+		Start[c] = min(255.0f, max(0.0f, (endEnd * startPixel - startEnd * endPixel) / determinant));
+		End[c] = min(255.0f, max(0.0f, (startStart * endPixel - startEnd * startPixel) / determinant));
+	}
+	return true;
+}
+
+// TextureNearestColors function: Definition
+//   This function sets Indices to the color of Palette (ColorsTotal colors) nearest each of the 16 pixels of a block, comparing the first Channels components, and returns the sum of their squared errors.
+static int TextureNearestColors(const float Pixels[16][4], int Channels, const int Palette[16][4], int ColorsTotal, int Indices[16])
+{
+	int errorTotal = 0;
+	for (int p = 0; p < 16; p++)
+	{
+		int bestError = 0x7FFFFFFF;
+		for (int i = 0; i < ColorsTotal; i++)
+		{
+			int error = 0;
+			for (int c = 0; c < Channels; c++)
+			{
+				int difference = Palette[i][c] - (int)Pixels[p][c];
+				error += difference * difference;
+			}
+			if (error < bestError)
+			{
+				bestError = error;
+				Indices[p] = i;
+			}
+		}
+		errorTotal += bestError;
+	}
+	return errorTotal;
+}
+
+// Bc1Quantize function: Definition
+//   This function returns the 5:6:5 color (red in the most significant 5 bits) nearest a color.
+static unsigned short Bc1Quantize(const float Color[4])
+{
+	int red = (int)(Color[0] * 31.0f / 255.0f + 0.5f), green = (int)(Color[1] * 63.0f / 255.0f + 0.5f), blue = (int)(Color[2] * 31.0f / 255.0f + 0.5f);
+	return (unsigned short)((red << 11) | (green << 5) | blue);
+}
+
+// Bc1Palette function: Definition
+//   This function sets Palette to the colors of a BC1 block with endpoints Color0 and Color1: if Color0 > Color1, the endpoints and the two colors a third and two thirds of the way between them,
+//   otherwise the endpoints, the color halfway between them, and transparent black.
+static void Bc1Palette(unsigned short Color0, unsigned short Color1, int Palette[16][4])
+{
+	const unsigned short colors[2] = { Color0, Color1 };
+	for (int e = 0; e < 2; e++)
+	{
+		int red = colors[e] >> 11, green = (colors[e] >> 5) & 63, blue = colors[e] & 31;
+		Palette[e][0] = (red << 3) | (red >> 2);
+		Palette[e][1] = (green << 2) | (green >> 4);
+		Palette[e][2] = (blue << 3) | (blue >> 2);
+		Palette[e][3] = 255;
+	}
+	for (int c = 0; c < 3; c++)
+	{
+		if (Color0 > Color1)
+		{
+			Palette[2][c] = (2 * Palette[0][c] + Palette[1][c] + 1) / 3;
+			Palette[3][c] = (Palette[0][c] + 2 * Palette[1][c] + 1) / 3;
+		}
+		else
+		{
+			Palette[2][c] = (Palette[0][c] + Palette[1][c]) / 2;
+			Palette[3][c] = 0;
+		}
+	}
+	Palette[2][3] = 255;
+	Palette[3][3] = Color0 > Color1 ? 255 : 0;
+}
+
+// EncodeBc1Block function: Definition
+//   This function encodes the 16 pixels of a block (red, green, and blue; alpha is ignored) into an 8-byte BC1 block, always with 4 colors (color 0 > color 1), or 1 if the endpoints quantize to the same color.
+static void EncodeBc1Block(const float Pixels[16][4], unsigned char Block[8])
+{
+	float start[4], end[4];
+	TextureFitLine(Pixels, 3, start, end);
+
+	int bestError = 0x7FFFFFFF;
+	unsigned short bestColors[2] = { 0, 0 };
+	int bestIndices[16] = {};
+	for (int iteration = 0; iteration <= TextureRefitIterations; iteration++)
+	{
+		int indices[16], palette[16][4];
+		unsigned short color0 = Bc1Quantize(end), color1 = Bc1Quantize(start);
+		if (color0 < color1)
+		{
+			std::swap(color0, color1);
+			std::swap(start, end);							// end remains the endpoint quantized to color 0.
+		}
+		Bc1Palette(color0, color1, palette);
+		int error = TextureNearestColors(Pixels, 3, palette, color0 == color1 ? 1 : 4, indices);
+		if (error < bestError)
+		{
+			bestError = error;
+			bestColors[0] = color0;
+			bestColors[1] = color1;
+			memcpy(bestIndices, indices, sizeof(indices));
+		}
+		if (color0 == color1 || iteration == TextureRefitIterations)
+			break;
+
+		// Refit the endpoints to the indices: start is color 0 and end is color 1.
+		float weights[16];
+		for (int p = 0; p < 16; p++)
+			weights[p] = Bc1Weights[indices[p]];
+		if (!TextureRefitLine(Pixels, 3, weights, end, start))
+			break;
+	}
+
+	unsigned int indexBits = 0;
+	for (int p = 0; p < 16; p++)
+		indexBits |= (unsigned int)bestIndices[p] << (2 * p);
+	Block[0] = (unsigned char)bestColors[0];
+	Block[1] = (unsigned char)(bestColors[0] >> 8);
+	Block[2] = (unsigned char)bestColors[1];
+	Block[3] = (unsigned char)(bestColors[1] >> 8);
+	for (int b = 0; b < 4; b++)
+		Block[4 + b] = (unsigned char)(indexBits >> (8 * b));
+}
+
+// DecodeBc1Block function: Definition
+//   This function decodes an 8-byte BC1 block into the 16 pixels (red, green, blue, alpha) of Pixels.
+static void DecodeBc1Block(const unsigned char Block[8], unsigned char Pixels[16][4])
+{
+	int palette[16][4];
+	Bc1Palette((unsigned short)(Block[0] | (Block[1] << 8)), (unsigned short)(Block[2] | (Block[3] << 8)), palette);
+	unsigned int indexBits = Block[4] | (Block[5] << 8) | (Block[6] << 16) | ((unsigned int)Block[7] << 24);
+	for (int p = 0; p < 16; p++)
+		for (int c = 0; c < 4; c++)
+			Pixels[p][c] = (unsigned char)palette[(indexBits >> (2 * p)) & 3][c];
+}
+
+// Bc7QuantizeEndpoint function: Definition
+//   This function sets Quantized (7 bits per component) and PBit (the shared least significant bit of the 8-bit components) to the BC7 mode 6 endpoint nearest Color.
+static void Bc7QuantizeEndpoint(const float Color[4], int Quantized[4], int& PBit)
+{
+	float bestError = 1e30f;
+	for (int p = 0; p < 2; p++)
+	{
+		int quantized[4];
+		float error = 0.0f;
+		for (int c = 0; c < 4; c++)
+		{
+			quantized[c] = min(127, max(0, (int)floorf((Color[c] - p) / 2.0f + 0.5f)));
+			float difference = (float)((quantized[c] << 1) | p) - Color[c];
+			error += difference * difference;
+		}
+		if (error < bestError)
+		{
+			bestError = error;
+			PBit = p;
+			memcpy(Quantized, quantized, sizeof(quantized));
+		}
+	}
+}
+
+// Bc7Palette function: Definition
+//   This function sets Palette to the 16 colors of a BC7 mode 6 block with the quantized endpoints Quantized0 and Quantized1 and their p-bits.
+static void Bc7Palette(const int Quantized0[4], int PBit0, const int Quantized1[4], int PBit1, int Palette[16][4])
+{
+	for (int c = 0; c < 4; c++)
+	{
+		int endpoint0 = (Quantized0[c] << 1) | PBit0, endpoint1 = (Quantized1[c] << 1) | PBit1;
+		for (int i = 0; i < 16; i++)
+			Palette[i][c] = ((64 - Bc7Weights[i]) * endpoint0 + Bc7Weights[i] * endpoint1 + 32) >> 6;
+	}
+}
+
+// TextureWriteBits function: Definition
+//   This function writes the Bits least significant bits of Value to Block, from bit Position onward (bit 0 is the least significant bit of byte 0), and advances Position.
+static void TextureWriteBits(unsigned char Block[16], int& Position, unsigned int Value, int Bits)
+{
+	for (int b = 0; b < Bits; b++, Position++)
+		if ((Value >> b) & 1)
+			Block[Position >> 3] |= (unsigned char)(1 << (Position & 7));
+}
+
+// TextureReadBits function: Definition
+//   This function returns Bits bits of Block, from bit Position onward, and advances Position.
+static unsigned int TextureReadBits(const unsigned char Block[16], int& Position, int Bits)
+{
+	unsigned int value = 0;
+	for (int b = 0; b < Bits; b++, Position++)
+		value |= (unsigned int)((Block[Position >> 3] >> (Position & 7)) & 1) << b;
+	return value;
+}
+
+// EncodeBc7Block function: Definition
+//   This function encodes the 16 pixels of a block (red, green, blue, and alpha) into a 16-byte BC7 block, with mode 6: one pair of 7-bit RGBA endpoints, each with a p-bit, and a 4-bit index per pixel.
+static void EncodeBc7Block(const float Pixels[16][4], unsigned char Block[16])
+{
+	float start[4], end[4];
+	TextureFitLine(Pixels, 4, start, end);
+
+	int bestError = 0x7FFFFFFF;
+	int bestQuantized[2][4] = {}, bestPBits[2] = { 0, 0 }, bestIndices[16] = {};
+	for (int iteration = 0; iteration <= TextureRefitIterations; iteration++)
+	{
+		int quantized[2][4], pBits[2], indices[16], palette[16][4];
+		Bc7QuantizeEndpoint(start, quantized[0], pBits[0]);
+		Bc7QuantizeEndpoint(end, quantized[1], pBits[1]);
+		Bc7Palette(quantized[0], pBits[0], quantized[1], pBits[1], palette);
+		int error = TextureNearestColors(Pixels, 4, palette, 16, indices);
+		if (error < bestError)
+		{
+			bestError = error;
+			memcpy(bestQuantized, quantized, sizeof(quantized));
+			memcpy(bestPBits, pBits, sizeof(pBits));
+			memcpy(bestIndices, indices, sizeof(indices));
+		}
+		if (iteration == TextureRefitIterations)
+			break;
+
+		float weights[16];
+		for (int p = 0; p < 16; p++)
+			weights[p] = Bc7Weights[indices[p]] / 64.0f;
+		if (!TextureRefitLine(Pixels, 4, weights, start, end))
+			break;
+	}
+
+	// The most significant bit of the first pixel's index is not stored, and is 0: if it would be 1, swap the endpoints, which reverses the order of the colors.
+	if (bestIndices[0] & 8)
+	{
+		for (int c = 0; c < 4; c++)
+			std::swap(bestQuantized[0][c], bestQuantized[1][c]);
+		std::swap(bestPBits[0], bestPBits[1]);
+		for (int p = 0; p < 16; p++)
+			bestIndices[p] = 15 - bestIndices[p];
+	}
+
+	memset(Block, 0, 16);
+	int position = 0;
+	TextureWriteBits(Block, position, 1 << 6, 7);			// Mode 6: six 0 bits, then a 1 bit.
+	for (int c = 0; c < 4; c++)
+	{
+		TextureWriteBits(Block, position, bestQuantized[0][c], 7);
+		TextureWriteBits(Block, position, bestQuantized[1][c], 7);
+	}
+	TextureWriteBits(Block, position, bestPBits[0], 1);
+	TextureWriteBits(Block, position, bestPBits[1], 1);
+	for (int p = 0; p < 16; p++)
+		TextureWriteBits(Block, position, bestIndices[p], p == 0 ? 3 : 4);
+}
+
+// DecodeBc7Block function: Definition
+//   This function decodes a 16-byte BC7 mode 6 block into the 16 pixels (red, green, blue, alpha) of Pixels. It returns 0 on success, or 1 if the block uses another mode.
+static int DecodeBc7Block(const unsigned char Block[16], unsigned char Pixels[16][4])
+{
+	if ((Block[0] & 0x7F) != 0x40)
+		return 1;
+
+	int position = 7;
+	int quantized[2][4], pBits[2], palette[16][4];
+	for (int c = 0; c < 4; c++)
+	{
+		quantized[0][c] = (int)TextureReadBits(Block, position, 7);
+		quantized[1][c] = (int)TextureReadBits(Block, position, 7);
+	}
+	pBits[0] = (int)TextureReadBits(Block, position, 1);
+	pBits[1] = (int)TextureReadBits(Block, position, 1);
+	Bc7Palette(quantized[0], pBits[0], quantized[1], pBits[1], palette);
+	for (int p = 0; p < 16; p++)
+	{
+		int index = (int)TextureReadBits(Block, position, p == 0 ? 3 : 4);
+		for (int c = 0; c < 4; c++)
+			Pixels[p][c] = (unsigned char)palette[index][c];
+	}
+	return 0;
+}
+
+// CompressTexture function: Definition
+//   This function encodes Source into the 4x4 pixel blocks of Format. A block extending past the right or bottom edge of Source (only in levels smaller than 4 pixels) repeats the last column or row.
+//   The rows of blocks are divided among the threads of the job system.
+void CompressTexture(const Image& Source, unsigned int Format, vector<unsigned char>& Blocks)
+{
+	int blockBytes = TextureBlockBytes(Format);
+	int blocksX = max(1, (Source.Width + 3) / 4), blocksY = max(1, (Source.Height + 3) / 4);
+	Blocks.assign((size_t)blocksX * blocksY * blockBytes, 0);
+	if (blockBytes == 0)
+		return;
+	JobParallelFor(blocksY, 1, [&](int Begin, int End)
+		{
+			for (int blockY = Begin; blockY < End; blockY++)
+				for (int blockX = 0; blockX < blocksX; blockX++)
+				{
+					float pixels[16][4];
+					for (int p = 0; p < 16; p++)
+					{
+						int x = min(blockX * 4 + (p & 3), Source.Width - 1), y = min(blockY * 4 + (p >> 2), Source.Height - 1);
+						for (int c = 0; c < 4; c++)
+							pixels[p][c] = Source.Pixels[((size_t)y * Source.Width + x) * 4 + c];
+					}
+					unsigned char* block = &Blocks[((size_t)blockY * blocksX + blockX) * blockBytes];
+					if (Format == TEXTURE_FORMAT_BC1_UNORM)
+						EncodeBc1Block(pixels, block);
+					else
+						EncodeBc7Block(pixels, block);
+				}
+		});
+}
+
+// DecompressTexture function: Definition
+//   This function decodes the blocks of a Width x Height level of Format into Result, as the GPU decodes them when sampling the texture.
+//   It returns 0 on success, or 1 if Format is not TEXTURE_FORMAT_BC1_UNORM or TEXTURE_FORMAT_BC7_UNORM, or a BC7 block uses a mode other than mode 6 (the only mode the CompressTexture function writes).
+int DecompressTexture(const unsigned char* Blocks, unsigned int Format, int Width, int Height, Image& Result)
+{
+	int blockBytes = TextureBlockBytes(Format);
+	if (blockBytes == 0)
+		return 1;
+	Result.Width = Width;
+	Result.Height = Height;
+	Result.Pixels.resize((size_t)Width * Height * 4);
+	int blocksX = max(1, (Width + 3) / 4), blocksY = max(1, (Height + 3) / 4);
+	for (int blockY = 0; blockY < blocksY; blockY++)
+		for (int blockX = 0; blockX < blocksX; blockX++)
+		{
+			unsigned char pixels[16][4];
+			const unsigned char* block = Blocks + ((size_t)blockY * blocksX + blockX) * blockBytes;
+			if (Format == TEXTURE_FORMAT_BC1_UNORM)
+				DecodeBc1Block(block, pixels);
+			else if (DecodeBc7Block(block, pixels) == 1)
+				return 1;
+			for (int p = 0; p < 16; p++)
+			{
+				int x = blockX * 4 + (p & 3), y = blockY * 4 + (p >> 2);
+				if (x < Width && y < Height)
+					memcpy(&Result.Pixels[((size_t)y * Width + x) * 4], pixels[p], 4);
+			}
+		}
+	return 0;
+}
+
+// CookTexture function: Definition
+//   This function reads SourceFileName, builds its mipmap chain, and saves its texture cache file in Format.
+//   It returns 0 on success, or 1 if the source file cannot be read, its width or height is not a multiple of 4 (Direct3D requires it of level 0 of a block-compressed texture), or the cache file cannot be written.
+int CookTexture(const char* SourceFileName, unsigned int Format)
+{
+	Image source;
+	if (LoadPngFile(SourceFileName, source) == 1)
+		return 1;
+	if (source.Width % 4 != 0 || source.Height % 4 != 0)
+		return 1;
+	vector<Image> mips;
+	BuildMipChain(source, mips);
+	return TextureCacheSave(SourceFileName, Format, mips);
+}
+
+// TextureCacheLoad function: Definition
+//   This function maps the texture cache file of SourceFileName into memory and checks that it is valid:
+//   - The header is a .dds header of a 2D block-compressed texture in TextureCacheFormat, with a mipmap chain down to 1 x 1 pixel, cooked by this program (tag and TEXTURE_CACHE_VERSION).
+//   - The header's source hash matches the contents of the source texture image file, i.e., the source file has not changed since the cache file was cooked.
+//   - The file's size matches the sizes of the levels.
+//   It returns 0 if the cache file is valid, in which case View.MipData points into the mapped cache file, or 1 otherwise, in which case View is empty.
+int TextureCacheLoad(const char* SourceFileName, TextureCacheView& View)
+{
+	TextureCacheUnload(View);
+
+	unsigned long long sourceHash;
+	if (TextureSourceHash(SourceFileName, sourceHash) == 1)
+		return 1;
+
+	if (MapFile(TextureCacheFileName(SourceFileName).c_str(), View.File) == 1)
+		return 1;											// There is no texture cache file.
+
+	// Check the header.
+	TextureCacheHeader header;
+	if (View.File.Size < sizeof(TextureCacheHeader))
+	{
+		TextureCacheUnload(View);
+		return 1;
+	}
+	memcpy(&header, View.File.Data, sizeof(TextureCacheHeader));
+	int blockBytes = TextureBlockBytes(header.Format);
+	unsigned int mipLevels = 1;
+	while (mipLevels < TEXTURE_MIP_LEVELS_MAXIMUM && (header.Width >> mipLevels > 0 || header.Height >> mipLevels > 0))
+		mipLevels++;
+	if (header.Magic != DdsMagic ||
+		header.FourCC != DdsFourCCDx10 ||
+		header.Reserved1[0] != TextureCacheTag ||
+		header.Reserved1[1] != TEXTURE_CACHE_VERSION ||
+		header.Reserved1[2] != (unsigned int)sourceHash ||
+		header.Reserved1[3] != (unsigned int)(sourceHash >> 32) ||
+		header.Format != TextureCacheFormat ||
+		blockBytes == 0 ||
+		header.ResourceDimension != 3 ||
+		header.ArraySize != 1 ||
+		header.Width == 0 || header.Height == 0 || header.Width > 32768 || header.Height > 32768 ||
+		header.MipLevels != mipLevels)
+	{
+		// The texture cache file is out of date or damaged.
+		TextureCacheUnload(View);
+		return 1;
+	}
+
+	// The levels follow the header, from level 0.
+	size_t offset = sizeof(TextureCacheHeader);
+	for (int level = 0; level < (int)mipLevels; level++)
+	{
+		int blocksX = max(1u, ((header.Width >> level) + 3) / 4), blocksY = max(1u, ((header.Height >> level) + 3) / 4);
+		View.MipRowPitch[level] = blocksX * blockBytes;
+		View.MipSize[level] = blocksX * blocksY * blockBytes;
+		View.MipData[level] = (const unsigned char*)View.File.Data + offset;
+		offset += View.MipSize[level];
+	}
+	if (View.File.Size != offset)
+	{
+		TextureCacheUnload(View);
+		return 1;
+	}
+	View.Format = header.Format;
+	View.Width = (int)header.Width;
+	View.Height = (int)header.Height;
+	View.MipLevels = (int)mipLevels;
+
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
+
+// TextureCacheUnload function: Definition
+void TextureCacheUnload(TextureCacheView& View)
+{
+	UnmapFile(View.File);
+	View = TextureCacheView();
+}
+
+// TextureCacheSave function: Definition
+//   This function compresses the mipmap chain Mips (see the BuildMipChain function) into Format, and saves the texture cache file of SourceFileName.
+//   The file is first written under a temporary name and then renamed, so a program loading the cache file at the same time never sees a partially written file.
+//   It returns 0 on success, or 1 if Format is not TEXTURE_FORMAT_BC1_UNORM or TEXTURE_FORMAT_BC7_UNORM, Mips is not a complete mipmap chain, or the file cannot be written.
+int TextureCacheSave(const char* SourceFileName, unsigned int Format, const vector<Image>& Mips)
+{
+	if (TextureBlockBytes(Format) == 0 || Mips.empty() || Mips.size() > TEXTURE_MIP_LEVELS_MAXIMUM || Mips.back().Width != 1 || Mips.back().Height != 1)
+		return 1;
+
+	unsigned long long sourceHash;
+	if (TextureSourceHash(SourceFileName, sourceHash) == 1)
+		return 1;
+
+	TextureCacheHeader header;
+	memset(&header, 0, sizeof(header));
+	header.Magic = DdsMagic;
+	header.Size = 124;
+	header.Flags = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000;	// DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT | DDSD_LINEARSIZE.
+	header.Width = (unsigned int)Mips[0].Width;
+	header.Height = (unsigned int)Mips[0].Height;
+	header.LinearSize = (unsigned int)(max(1, (Mips[0].Width + 3) / 4) * max(1, (Mips[0].Height + 3) / 4) * TextureBlockBytes(Format));
+	header.MipLevels = (unsigned int)Mips.size();
+	header.Reserved1[0] = TextureCacheTag;
+	header.Reserved1[1] = TEXTURE_CACHE_VERSION;
+	header.Reserved1[2] = (unsigned int)sourceHash;
+	header.Reserved1[3] = (unsigned int)(sourceHash >> 32);
+	header.PixelFormatSize = 32;
+	header.PixelFormatFlags = 0x4;							// DDPF_FOURCC.
+	header.FourCC = DdsFourCCDx10;
+	header.Caps = 0x8 | 0x400000 | 0x1000;					// DDSCAPS_COMPLEX | DDSCAPS_MIPMAP | DDSCAPS_TEXTURE.
+	header.Format = Format;
+	header.ResourceDimension = 3;							// D3D11_RESOURCE_DIMENSION_TEXTURE2D.
+	header.ArraySize = 1;
+
+	string cacheFileName = TextureCacheFileName(SourceFileName);
+	string temporaryFileName = cacheFileName + ".tmp";
+
+	ofstream cache(temporaryFileName, ios::out | ios::binary | ios::trunc);
+	if (!cache)
+		return 1;
+	cache.write((const char*)&header, sizeof(header));
+	vector<unsigned char> blocks;
+	for (const Image& mip : Mips)
+	{
+		CompressTexture(mip, Format, blocks);
+		cache.write((const char*)blocks.data(), (std::streamsize)blocks.size());
+	}
+	cache.close();
+
+	error_code error;
+	if (!cache)
+	{
+		fs::remove(temporaryFileName, error);
+		return 1;
+	}
+	fs::rename(temporaryFileName, cacheFileName, error);
+	if (error)
+	{
+		fs::remove(temporaryFileName, error);
+		return 1;
+	}
+
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
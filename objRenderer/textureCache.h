@@ -0,0 +1,118 @@
+// textureCache Header File
+// Version 3.1
+//
+// Description
+// Texture cache (.dds file) I/O Header File
+// This header file contains the declarations used to cook a texture image file (a .png file) into a texture cache file: a mipmap chain built with a gamma-correct filter, block-compressed (BC1 or BC7) by the job system's threads,
+// and saved as a .dds file that Direct3D reads directly, so the renderer neither decodes the .png file nor builds the mipmap chain when it starts.
+// None of these functions use Direct3D. Include it in all source files that cook or load texture cache files, e.g., the objRenderer program.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Image file I/O Header File.
+// Declares the Image structure, and includes the Vector Container Class.
+#include "imageFile.h"
+
+// Read-only memory-mapped file I/O Header File.
+#include "mappedFile.h"
+
+// Defines.
+// The version of the texture cache file format. Increment it whenever the file format, the mipmap filter, or the block encoders change, so that existing cache files are cooked again.
+#define TEXTURE_CACHE_VERSION 1
+//
+// The block-compressed formats a texture can be cooked into. The values are those of the DXGI_FORMAT enumerated type, so they are written to the .dds file, and passed to Direct3D, unchanged.
+#define TEXTURE_FORMAT_BC1_UNORM 71							// DXGI_FORMAT_BC1_UNORM: 8 bytes per 4x4 block (1/8 the size of R8G8B8A8_UNORM). Two 5:6:5 colors and two colors between them. Opaque textures only.
+#define TEXTURE_FORMAT_BC7_UNORM 98							// DXGI_FORMAT_BC7_UNORM: 16 bytes per 4x4 block (1/4 the size of R8G8B8A8_UNORM). Written with BC7 mode 6: two 8-bit RGBA colors and 14 colors between them.
+//
+// The largest number of levels in a mipmap chain, i.e., a mipmap chain of a 32768 x 32768 texture image.
+#define TEXTURE_MIP_LEVELS_MAXIMUM 16
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the TextureCacheHeader 'named structure' data type.
+// A texture cache file is named after its source texture image file, followed by ".dds" (e.g., Wood.png.dds for Wood.png), and is comprised of:
+//   1. A TextureCacheHeader: the "DDS " magic number, the DDS_HEADER structure, and the DDS_HEADER_DXT10 structure of the .dds file format.
+//   2. The blocks of each level of the mipmap chain, from the largest (level 0) to the smallest (1 x 1 pixel), each level row by row of 4x4 pixel blocks from the top.
+// The DDS_HEADER's reserved members, which programs reading .dds files ignore, identify the cache file: Reserved1[0] is 'OBJT', Reserved1[1] is TEXTURE_CACHE_VERSION, and Reserved1[2] and Reserved1[3] are the low and high 32 bits
+// of a 64-bit hash of the contents of the source texture image file. The cache file is valid only while the source file has the same hash, i.e., the same contents, as when the cache file was saved.
+struct TextureCacheHeader {
+	unsigned int Magic;										// "DDS ".
+	unsigned int Size;										// DDS_HEADER.dwSize: 124, the size of the DDS_HEADER structure.
+	unsigned int Flags;										// DDS_HEADER.dwFlags: DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT | DDSD_LINEARSIZE.
+	unsigned int Height;									// DDS_HEADER.dwHeight: the height of level 0, in pixels.
+	unsigned int Width;										// DDS_HEADER.dwWidth: the width of level 0, in pixels.
+	unsigned int LinearSize;								// DDS_HEADER.dwPitchOrLinearSize: the size of level 0, in bytes.
+	unsigned int Depth;										// DDS_HEADER.dwDepth: 0 (not a volume texture).
+	unsigned int MipLevels;									// DDS_HEADER.dwMipMapCount: the number of levels in the mipmap chain.
+	unsigned int Reserved1[11];								// DDS_HEADER.dwReserved1: identifies the cache file (see above). The remaining members are 0.
+	unsigned int PixelFormatSize;							// DDS_PIXELFORMAT.dwSize: 32.
+	unsigned int PixelFormatFlags;							// DDS_PIXELFORMAT.dwFlags: DDPF_FOURCC.
+	unsigned int FourCC;									// DDS_PIXELFORMAT.dwFourCC: "DX10", i.e., a DDS_HEADER_DXT10 structure follows the DDS_HEADER structure.
+	unsigned int PixelFormatUnused[5];						// DDS_PIXELFORMAT.dwRGBBitCount to dwABitMask: 0.
+	unsigned int Caps;										// DDS_HEADER.dwCaps: DDSCAPS_COMPLEX | DDSCAPS_MIPMAP | DDSCAPS_TEXTURE.
+	unsigned int Caps2, Caps3, Caps4, Reserved2;			// DDS_HEADER.dwCaps2 to dwReserved2: 0.
+	unsigned int Format;									// DDS_HEADER_DXT10.dxgiFormat: TEXTURE_FORMAT_BC1_UNORM or TEXTURE_FORMAT_BC7_UNORM.
+	unsigned int ResourceDimension;							// DDS_HEADER_DXT10.resourceDimension: 3, D3D11_RESOURCE_DIMENSION_TEXTURE2D.
+	unsigned int MiscFlag;									// DDS_HEADER_DXT10.miscFlag: 0.
+	unsigned int ArraySize;									// DDS_HEADER_DXT10.arraySize: 1.
+	unsigned int MiscFlags2;								// DDS_HEADER_DXT10.miscFlags2: 0 (DDS_ALPHA_MODE_UNKNOWN).
+};
+
+// Declare the TextureCacheView 'named structure' data type.
+// A TextureCacheView describes a texture cache file loaded by the TextureCacheLoad function.
+// MipData points directly into the memory-mapped cache file, and remains valid until the TextureCacheUnload function is called.
+struct TextureCacheView {
+	MappedFile File;										// The memory-mapped texture cache file.
+	unsigned int Format = 0;								// TEXTURE_FORMAT_BC1_UNORM or TEXTURE_FORMAT_BC7_UNORM.
+	int Width = 0;											// The width of level 0, in pixels.
+	int Height = 0;											// The height of level 0, in pixels.
+	int MipLevels = 0;										// The number of levels in the mipmap chain.
+	const unsigned char* MipData[TEXTURE_MIP_LEVELS_MAXIMUM] = {};	// The blocks of each level.
+	int MipRowPitch[TEXTURE_MIP_LEVELS_MAXIMUM] = {};		// The size, in bytes, of one row of 4x4 pixel blocks of each level, i.e., the SysMemPitch of its D3D11_SUBRESOURCE_DATA structure.
+	int MipSize[TEXTURE_MIP_LEVELS_MAXIMUM] = {};			// The size, in bytes, of each level.
+};
+
+// End: Structure Declarations.
+
+//***
+// External Variable Global Declarations.
+//***
+
+// TextureCacheEnabled selects whether the objRenderer program loads its texture image from a texture cache file, cooking the texture cache file first if it is missing or out of date. It is true by default.
+// When it is false, or the texture image cannot be cooked (e.g., its width or height is not a multiple of 4), the texture image file is loaded with the CreateWICTextureFromFile function, without a mipmap chain.
+extern bool TextureCacheEnabled;
+//
+// TextureCacheFormat selects the block-compressed format of cooked texture cache files: TEXTURE_FORMAT_BC1_UNORM (the default), or TEXTURE_FORMAT_BC7_UNORM, which is twice the size but preserves alpha and fine color gradients better.
+// A texture cache file cooked with another format is out of date.
+extern unsigned int TextureCacheFormat;
+
+// End: External Variable Global Declarations.
+
+//***
+// Global Function Declarations.
+//***
+
+void BuildMipChain(const Image& Source, std::vector<Image>& Mips);																// The BuildMipChain function sets Mips to the mipmap chain of Source: Source itself, then each level half the size of the one before (rounded down, at least 1 pixel), down to 1 x 1 pixel.
+void CompressTexture(const Image& Source, unsigned int Format, std::vector<unsigned char>& Blocks);								// The CompressTexture function encodes Source into the 4x4 pixel blocks of Format (TEXTURE_FORMAT_BC1_UNORM or TEXTURE_FORMAT_BC7_UNORM), row by row of blocks from the top.
+int DecompressTexture(const unsigned char* Blocks, unsigned int Format, int Width, int Height, Image& Result);					// The DecompressTexture function decodes the blocks of a Width x Height level of Format into Result. It returns 0 on success, or 1 if a block uses a BC7 mode other than mode 6.
+int CookTexture(const char* SourceFileName, unsigned int Format);																	// The CookTexture function reads SourceFileName (a .png file), builds and compresses its mipmap chain, and saves its texture cache file. It returns 0 on success, or 1 if it fails.
+int TextureCacheLoad(const char* SourceFileName, TextureCacheView& View);															// The TextureCacheLoad function maps the texture cache file of SourceFileName into memory. It returns 0 if the cache file is valid and in TextureCacheFormat, or 1 if it is missing, out of date, or damaged.
+void TextureCacheUnload(TextureCacheView& View);																					// The TextureCacheUnload function unmaps a texture cache file loaded by the TextureCacheLoad function.
+int TextureCacheSave(const char* SourceFileName, unsigned int Format, const std::vector<Image>& Mips);							// The TextureCacheSave function compresses the mipmap chain Mips into Format and saves the texture cache file of SourceFileName. It returns 0 on success, or 1 if the file cannot be written.
+
+// End: Global Function Declarations.
+
+// End: Global Declarations.
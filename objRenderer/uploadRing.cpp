@@ -0,0 +1,101 @@
+// uploadRing
+// Version 3.1
+//
+// Description
+// These functions sub-allocate one large dynamic buffer as a ring: each frame's allocations follow the previous frame's, and are freed when the calling program retires the frame, i.e., when the GPU has finished it.
+// Each allocation reports whether the buffer can be mapped with D3D11_MAP_WRITE_NO_OVERWRITE to write it, or must be mapped with D3D11_MAP_WRITE_DISCARD because the ring is full.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Upload ring allocator Header File.
+// Includes the Double-Ended Queue Container Class.
+#include "uploadRing.h"
+
+//***
+// External Variable Global Definitions.
+//***
+
+bool UploadRingEnabled = true;
+
+// End: External Variable Global Definitions.
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// CreateUploadRing function: Definition
+void CreateUploadRing(UploadRing& Ring, unsigned int Size, unsigned int Alignment)
+{
+	Ring = UploadRing();
+	Ring.Size = Size;
+	Ring.Alignment = Alignment;
+}
+
+// UploadRingAllocate function: Definition
+//   This function sets Allocation to a range of Size bytes, rounded up to a multiple of the ring's alignment, that no frame the GPU may still be reading uses:
+//   1. The range follows the previous allocation, unless it would run past the end of the buffer, in which case it starts at the beginning of the buffer. An allocation never wraps around the end of the buffer, because the shader must read it as one range.
+//   2. If the range would overwrite a frame that has not been retired, the buffer is discarded instead: the range starts at the beginning of the buffer, and every frame not yet retired is forgotten, because it keeps reading the buffer's old memory.
+//   It returns 0 on success, or 1 if Size is 0 or larger than the ring.
+int UploadRingAllocate(UploadRing& Ring, unsigned int Size, UploadRingAllocation& Allocation)
+{
+	unsigned long long size = ((unsigned long long)Size + Ring.Alignment - 1) & ~((unsigned long long)Ring.Alignment - 1);
+	if (Size == 0 || size > Ring.Size)
+		return 1;
+
+	// 1. Find the position of the range, skipping the bytes at the end of the buffer if the range does not fit before the end.
+	unsigned long long offset = Ring.Head % Ring.Size;
+	unsigned long long position = Ring.Head;
+	bool wrap = offset + size > Ring.Size;
+	if (wrap)
+		position += Ring.Size - offset;
+
+	// 2. Discard the buffer if it has never been mapped, or if the range would overwrite bytes that may still be read by the GPU.
+	Allocation.Discard = !Ring.Mapped || position + size - Ring.Tail > Ring.Size;
+	if (Allocation.Discard)
+	{
+		if (offset != 0)
+			Ring.Head += Ring.Size - offset;				// Start the ring again from the beginning of the buffer.
+		position = Ring.Head;
+		Ring.Tail = Ring.Head;								// The frames not yet retired read the old memory, so none of the new memory is in use.
+		Ring.Frames.clear();
+		Ring.Mapped = true;
+		Ring.Discards++;
+	}
+	else if (wrap)
+		Ring.Wraps++;
+
+	Allocation.Offset = (unsigned int)(position % Ring.Size);
+	Allocation.Size = (unsigned int)size;
+	Ring.Head = position + size;
+	Ring.Allocations++;
+
+	// Return to the calling program with a return code indicating success.
+	return 0;
+}
+
+// UploadRingEndFrame function: Definition
+//   This function records that the allocations since the last frame ended belong to frame number Frame. Frame numbers must increase.
+//   A frame without allocations is not recorded, because retiring it frees nothing.
+void UploadRingEndFrame(UploadRing& Ring, unsigned long long Frame)
+{
+	if (Ring.Frames.empty() ? Ring.Head != Ring.Tail : Ring.Head != Ring.Frames.back().End)
+		Ring.Frames.push_back({ Frame, Ring.Head });
+}
+
+// UploadRingRetire function: Definition
+//   This function frees the allocations of every frame up to and including frame number Frame, i.e., moves the ring's tail to the end of the last of them.
+void UploadRingRetire(UploadRing& Ring, unsigned long long Frame)
+{
+	while (!Ring.Frames.empty() && Ring.Frames.front().Frame <= Frame)
+	{
+		Ring.Tail = Ring.Frames.front().End;
+		Ring.Frames.pop_front();
+	}
+}
@@ -0,0 +1,91 @@
+// uploadRing Header File
+// Version 3.1
+//
+// Description
+// Upload ring allocator Header File
+// This header file contains the declarations used to sub-allocate one large dynamic buffer as a ring, e.g., the buffer the objRenderer program writes its constant buffers to each frame.
+// Each allocation is written by mapping the buffer with D3D11_MAP_WRITE_NO_OVERWRITE, which promises the driver that no range the GPU may still be reading is overwritten, so the driver neither waits for the GPU nor copies the buffer.
+// A range is known to be free once the GPU has finished the frame that used it: the calling program ends each frame with a fence (e.g., a D3D11_QUERY_EVENT query), and retires the frame when the fence is reached.
+// When the ring is full of frames the GPU has not finished, the next allocation starts the ring again from the beginning, mapped with D3D11_MAP_WRITE_DISCARD, which gives the buffer new memory and leaves the old memory to the frames still using it.
+// None of these functions use Direct3D. Include it in all source files that sub-allocate a dynamic buffer, e.g., the objRenderer program.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Double-Ended Queue Container Class.
+#include <deque>											// Deque class, used to hold the frames not yet retired.
+
+// Defines.
+// The alignment, in bytes, of each allocation from a ring of constant buffers. A constant buffer bound with VSSetConstantBuffers1 must start at a multiple of 16 constants (256 bytes), and its size must be a multiple of 16 constants.
+#define UPLOAD_RING_CONSTANT_ALIGNMENT 256
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the UploadRingFrame 'named structure' data type.
+// A frame whose allocations the GPU may still be reading.
+struct UploadRingFrame {
+	unsigned long long Frame;								// The number of the frame, as passed to the UploadRingEndFrame function.
+	unsigned long long End;									// The position of the ring's head when the frame ended, i.e., one byte past the frame's last allocation.
+};
+
+// Declare the UploadRingAllocation 'named structure' data type.
+// One range of the buffer returned by the UploadRingAllocate function.
+struct UploadRingAllocation {
+	unsigned int Offset;									// The location, in bytes, of the range in the buffer. A multiple of the ring's alignment.
+	unsigned int Size;										// The size, in bytes, of the range: the size requested, rounded up to a multiple of the ring's alignment.
+	bool Discard;											// True if the buffer must be mapped with D3D11_MAP_WRITE_DISCARD to write the range, or false if it can be mapped with D3D11_MAP_WRITE_NO_OVERWRITE.
+};
+
+// Declare the UploadRing 'named structure' data type.
+// An UploadRing describes the allocations of a buffer of Size bytes.
+// Positions in the ring only increase: the location in the buffer of position p is p % Size. Every byte from Tail to Head belongs to a frame the GPU may still be reading, and every other byte is free.
+struct UploadRing {
+	unsigned int Size = 0;									// The size, in bytes, of the buffer.
+	unsigned int Alignment = 1;								// The alignment, in bytes, of each allocation. A power of two.
+	unsigned long long Head = 0;							// The position of the next allocation.
+	unsigned long long Tail = 0;							// The position of the first byte that may still be read by the GPU.
+	bool Mapped = false;									// True once the buffer has been mapped. The first map of a buffer must discard it.
+	std::deque<UploadRingFrame> Frames;						// The frames not yet retired, oldest first.
+
+	unsigned long long Allocations = 0;						// The number of allocations.
+	unsigned long long Discards = 0;						// The number of allocations that discarded the buffer, including the first.
+	unsigned long long Wraps = 0;							// The number of allocations that started the ring again from the beginning without discarding the buffer.
+};
+
+// End: Structure Declarations.
+
+//***
+// External Variable Global Declarations.
+//***
+
+// UploadRingEnabled selects whether the objRenderer program writes its constant buffers to one ring-allocated dynamic buffer, bound with VSSetConstantBuffers1. It is true by default.
+// When it is false, or the Direct3D device cannot bind part of a constant buffer (ID3D11DeviceContext1, D3D11_FEATURE_D3D11_OPTIONS.ConstantBufferOffsetting and MapNoOverwriteOnDynamicConstantBuffer),
+// each constant buffer is a separate dynamic buffer, mapped with D3D11_MAP_WRITE_DISCARD each time it is written.
+extern bool UploadRingEnabled;
+
+// End: External Variable Global Declarations.
+
+//***
+// Global Function Declarations.
+//***
+
+void CreateUploadRing(UploadRing& Ring, unsigned int Size, unsigned int Alignment);						// The CreateUploadRing function sets Ring to an empty ring of Size bytes, whose allocations are multiples of Alignment (a power of two) bytes.
+int UploadRingAllocate(UploadRing& Ring, unsigned int Size, UploadRingAllocation& Allocation);			// The UploadRingAllocate function sets Allocation to a free range of at least Size bytes. It returns 0 on success, or 1 if Size is 0 or larger than the ring.
+void UploadRingEndFrame(UploadRing& Ring, unsigned long long Frame);									// The UploadRingEndFrame function records that the allocations since the last frame ended belong to frame number Frame.
+void UploadRingRetire(UploadRing& Ring, unsigned long long Frame);										// The UploadRingRetire function frees the allocations of every frame up to and including frame number Frame, i.e., the GPU has finished them.
+
+// End: Global Function Declarations.
+
+// End: Global Declarations.
@@ -0,0 +1,232 @@
+// vertexPacking
+// Version 3.1
+//
+// Description
+// These functions pack VERTEX structures into PACKEDVERTEX structures and 32-bit indices into 16-bit indices, unpack PACKEDVERTEX structures, and measure the error introduced by packing.
+//
+// Most of the memory read by the GPU while drawing a large mesh is the vertex buffer, so halving the size of each vertex halves the memory read by the input-assembler stage of the graphics pipeline.
+// Each coordinate is stored with 16 bits of precision over the range of that coordinate in the mesh, which is far more precise than the screen can show for positions, and than a texture image's texels for texture coordinates.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Packed vertex format Header File.
+#include "vertexPacking.h"
+
+// Vector Container Class.
+#include <vector>											// Vector class member functions data, etc.
+
+// Mathematical Functions.
+#include <cmath>											// Mathematical functions fabs, floor, sqrt.
+#include <algorithm>										// Functions min, max.
+
+// Using Declarations and Directives.
+using std::vector;
+using std::fabs;
+using std::floor;
+using std::sqrt;
+using std::min;
+using std::max;
+
+//***
+// External Variable Global Definitions.
+//***
+
+bool VertexPackingEnabled = false;
+
+// End: External Variable Global Definitions.
+
+// The largest 16-bit unsigned integer (the quantized maximum of a coordinate) and the largest 16-bit signed integer used (the quantized 1.0 of an octahedral coordinate).
+static const float VertexPackingUnsignedMaximum = 65535.0f;
+static const float VertexPackingSignedMaximum = 32767.0f;
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// ComputeVertexPackingBounds function: Definition
+void ComputeVertexPackingBounds(const VERTEX* Vertices, int VertexAttributeSetsTotal, VertexPackingBounds& Bounds)
+{
+	Bounds = VertexPackingBounds();
+	if (VertexAttributeSetsTotal <= 0)
+		return;
+
+	XMFLOAT3 minimum = Vertices[0].GeometricVertex, maximum = Vertices[0].GeometricVertex;
+	XMFLOAT2 uvMinimum = Vertices[0].VertexTextureCoordinate, uvMaximum = Vertices[0].VertexTextureCoordinate;
+	for (int i = 1; i < VertexAttributeSetsTotal; i++)
+	{
+		const XMFLOAT3& p = Vertices[i].GeometricVertex;
+		const XMFLOAT2& t = Vertices[i].VertexTextureCoordinate;
+		minimum.x = min(minimum.x, p.x); maximum.x = max(maximum.x, p.x);
+		minimum.y = min(minimum.y, p.y); maximum.y = max(maximum.y, p.y);
+		minimum.z = min(minimum.z, p.z); maximum.z = max(maximum.z, p.z);
+		uvMinimum.x = min(uvMinimum.x, t.x); uvMaximum.x = max(uvMaximum.x, t.x);
+		uvMinimum.y = min(uvMinimum.y, t.y); uvMaximum.y = max(uvMaximum.y, t.y);
+	}
+
+	Bounds.GeometricVertexMinimum = minimum;
+	Bounds.GeometricVertexScale = XMFLOAT3(maximum.x - minimum.x, maximum.y - minimum.y, maximum.z - minimum.z);
+	Bounds.VertexTextureCoordinateMinimum = uvMinimum;
+	Bounds.VertexTextureCoordinateScale = XMFLOAT2(uvMaximum.x - uvMinimum.x, uvMaximum.y - uvMinimum.y);
+}
+
+// Quantize function: Definition
+//   This function quantizes the coordinate Value, between Minimum and Minimum + Scale, to the nearest 16-bit unsigned integer.
+static unsigned short Quantize(float Value, float Minimum, float Scale)
+{
+	if (Scale <= 0.0f)
+		return 0;											// Every vertex has the same value of this coordinate, which is unpacked exactly as Minimum.
+	float q = floor((Value - Minimum) / Scale * VertexPackingUnsignedMaximum + 0.5f);
+	if (q < 0.0f) q = 0.0f;
+	if (q > VertexPackingUnsignedMaximum) q = VertexPackingUnsignedMaximum;
+	return (unsigned short)q;
+}
+
+// Dequantize function: Definition
+//   This function unpacks a quantized coordinate, with the same arithmetic as the VShader function (the input-assembler stage converts q to the UNORM value q / 65535).
+static float Dequantize(unsigned short Quantized, float Minimum, float Scale)
+{
+	return (float)Quantized / VertexPackingUnsignedMaximum * Scale + Minimum;
+}
+
+// PackVertices function: Definition
+//   The octahedral encoding of a vertex normal vector (x, y, z):
+//   1. Divide the vector by |x| + |y| + |z|, which moves it onto the surface of the octahedron |x| + |y| + |z| = 1.
+//   2. The upper half of the octahedron (z >= 0) projects onto the diamond |x| + |y| <= 1 of the square [-1, 1] x [-1, 1]. The lower half (z < 0) is folded outward over the diamond's edges onto the four corners of the square.
+//   3. Quantize x and y, each between -1 and 1, to 16-bit signed integers.
+//   A vertex normal vector of length 0 is packed as (0, 0), which is unpacked as (0, 0, 1).
+void PackVertices(const VERTEX* Vertices, int VertexAttributeSetsTotal, const VertexPackingBounds& Bounds, PACKEDVERTEX* PackedVertices)
+{
+	for (int i = 0; i < VertexAttributeSetsTotal; i++)
+	{
+		const VERTEX& vertex = Vertices[i];
+		PACKEDVERTEX& packed = PackedVertices[i];
+
+		packed.GeometricVertex[0] = Quantize(vertex.GeometricVertex.x, Bounds.GeometricVertexMinimum.x, Bounds.GeometricVertexScale.x);
+		packed.GeometricVertex[1] = Quantize(vertex.GeometricVertex.y, Bounds.GeometricVertexMinimum.y, Bounds.GeometricVertexScale.y);
+		packed.GeometricVertex[2] = Quantize(vertex.GeometricVertex.z, Bounds.GeometricVertexMinimum.z, Bounds.GeometricVertexScale.z);
+		packed.GeometricVertex[3] = 0;
+
+		const XMFLOAT3& n = vertex.VertexNormalVector;
+		float length1 = fabs(n.x) + fabs(n.y) + fabs(n.z);
+		float ox = 0.0f, oy = 0.0f;
+		if (length1 > 0.0f)
+		{
+			ox = n.x / length1;
+			oy = n.y / length1;
+			if (n.z < 0.0f)
+			{
+				float fx = (1.0f - fabs(oy)) * (ox >= 0.0f ? 1.0f : -1.0f);
+				float fy = (1.0f - fabs(ox)) * (oy >= 0.0f ? 1.0f : -1.0f);
+				ox = fx;
+				oy = fy;
+			}
+		}
+		packed.VertexNormalVector[0] = (short)floor(ox * VertexPackingSignedMaximum + 0.5f);
+		packed.VertexNormalVector[1] = (short)floor(oy * VertexPackingSignedMaximum + 0.5f);
+
+		packed.VertexTextureCoordinate[0] = Quantize(vertex.VertexTextureCoordinate.x, Bounds.VertexTextureCoordinateMinimum.x, Bounds.VertexTextureCoordinateScale.x);
+		packed.VertexTextureCoordinate[1] = Quantize(vertex.VertexTextureCoordinate.y, Bounds.VertexTextureCoordinateMinimum.y, Bounds.VertexTextureCoordinateScale.y);
+	}
+}
+
+// UnpackVertices function: Definition
+//   The octahedral decoding reverses the encoding: a point of the square inside the diamond is on the upper half of the octahedron, with z = 1 - |x| - |y|; a point outside the diamond (z < 0) is folded back inward. The result is normalized.
+void UnpackVertices(const PACKEDVERTEX* PackedVertices, int VertexAttributeSetsTotal, const VertexPackingBounds& Bounds, VERTEX* Vertices)
+{
+	for (int i = 0; i < VertexAttributeSetsTotal; i++)
+	{
+		const PACKEDVERTEX& packed = PackedVertices[i];
+		VERTEX& vertex = Vertices[i];
+
+		vertex.GeometricVertex.x = Dequantize(packed.GeometricVertex[0], Bounds.GeometricVertexMinimum.x, Bounds.GeometricVertexScale.x);
+		vertex.GeometricVertex.y = Dequantize(packed.GeometricVertex[1], Bounds.GeometricVertexMinimum.y, Bounds.GeometricVertexScale.y);
+		vertex.GeometricVertex.z = Dequantize(packed.GeometricVertex[2], Bounds.GeometricVertexMinimum.z, Bounds.GeometricVertexScale.z);
+
+		// The input-assembler stage converts a SNORM value q to q / 32767, clamped to -1.
+		float x = (float)packed.VertexNormalVector[0] / VertexPackingSignedMaximum; if (x < -1.0f) x = -1.0f;
+		float y = (float)packed.VertexNormalVector[1] / VertexPackingSignedMaximum; if (y < -1.0f) y = -1.0f;
+		float z = 1.0f - fabs(x) - fabs(y);
+		float t = z < 0.0f ? -z : 0.0f;
+		x += x >= 0.0f ? -t : t;
+		y += y >= 0.0f ? -t : t;
+		float length = sqrt(x * x + y * y + z * z);
+		vertex.VertexNormalVector = XMFLOAT3(x / length, y / length, z / length);
+
+		vertex.VertexTextureCoordinate.x = Dequantize(packed.VertexTextureCoordinate[0], Bounds.VertexTextureCoordinateMinimum.x, Bounds.VertexTextureCoordinateScale.x);
+		vertex.VertexTextureCoordinate.y = Dequantize(packed.VertexTextureCoordinate[1], Bounds.VertexTextureCoordinateMinimum.y, Bounds.VertexTextureCoordinateScale.y);
+	}
+}
+
+// PackIndices function: Definition
+void PackIndices(const DWORD* Indices, size_t IndicesTotal, unsigned short* PackedIndices)
+{
+	for (size_t i = 0; i < IndicesTotal; i++)
+		PackedIndices[i] = (unsigned short)Indices[i];
+}
+
+// VertexPackingErrorBound function: Definition
+//   A quantized coordinate is rounded to the nearest of 65536 evenly spaced values, so it is off by at most half a step, Scale / 65535 / 2. The three coordinates of a geometric vertex are each off by at most that much.
+//   An octahedral coordinate is off by at most half a step, d = 1 / 32767 / 2. Before normalization, the point on the octahedron is then off by at most 2 * sqrt(2) * d (the fold doubles the change of x and y, and z changes by the sum of their changes),
+//   and normalizing divides this by the length of the point, which is at least 1 / sqrt(3), and at most doubles it again when projecting onto the unit sphere. So the unit vector is off by at most 4 * sqrt(6) * d.
+//   A small allowance is added to each bound for floating-point rounding.
+void VertexPackingErrorBound(const VertexPackingBounds& Bounds, VertexPackingError& Error)
+{
+	const float rounding = 1.0e-6f;							// Relative allowance for floating-point rounding.
+	float px = Bounds.GeometricVertexScale.x / VertexPackingUnsignedMaximum / 2.0f;
+	float py = Bounds.GeometricVertexScale.y / VertexPackingUnsignedMaximum / 2.0f;
+	float pz = Bounds.GeometricVertexScale.z / VertexPackingUnsignedMaximum / 2.0f;
+	float pm = fabs(Bounds.GeometricVertexMinimum.x) + fabs(Bounds.GeometricVertexMinimum.y) + fabs(Bounds.GeometricVertexMinimum.z) + Bounds.GeometricVertexScale.x + Bounds.GeometricVertexScale.y + Bounds.GeometricVertexScale.z;
+	Error.GeometricVertex = sqrt(px * px + py * py + pz * pz) + pm * rounding;
+
+	float d = 1.0f / VertexPackingSignedMaximum / 2.0f;
+	Error.VertexNormalVector = 4.0f * sqrt(6.0f) * d + rounding;
+
+	float tx = Bounds.VertexTextureCoordinateScale.x / VertexPackingUnsignedMaximum / 2.0f;
+	float ty = Bounds.VertexTextureCoordinateScale.y / VertexPackingUnsignedMaximum / 2.0f;
+	float tm = fabs(Bounds.VertexTextureCoordinateMinimum.x) + fabs(Bounds.VertexTextureCoordinateMinimum.y) + Bounds.VertexTextureCoordinateScale.x + Bounds.VertexTextureCoordinateScale.y;
+	Error.VertexTextureCoordinate = sqrt(tx * tx + ty * ty) + tm * rounding;
+}
+
+// MeasureVertexPackingError function: Definition
+//   The error of a vertex normal vector is measured between the unit vectors of the original and unpacked directions, because only the direction is packed. Vertex normal vectors of length 0 are not measured.
+void MeasureVertexPackingError(const VERTEX* Vertices, int VertexAttributeSetsTotal, const VertexPackingBounds& Bounds, VertexPackingError& Error)
+{
+	Error = VertexPackingError();
+	if (VertexAttributeSetsTotal <= 0)
+		return;
+
+	vector<PACKEDVERTEX> packed(VertexAttributeSetsTotal);
+	vector<VERTEX> unpacked(VertexAttributeSetsTotal);
+	PackVertices(Vertices, VertexAttributeSetsTotal, Bounds, packed.data());
+	UnpackVertices(packed.data(), VertexAttributeSetsTotal, Bounds, unpacked.data());
+
+	for (int i = 0; i < VertexAttributeSetsTotal; i++)
+	{
+		const VERTEX& a = Vertices[i];
+		const VERTEX& b = unpacked[i];
+
+		float dx = a.GeometricVertex.x - b.GeometricVertex.x, dy = a.GeometricVertex.y - b.GeometricVertex.y, dz = a.GeometricVertex.z - b.GeometricVertex.z;
+		float e = sqrt(dx * dx + dy * dy + dz * dz);
+		if (e > Error.GeometricVertex) Error.GeometricVertex = e;
+
+		const XMFLOAT3& n = a.VertexNormalVector;
+		float length = sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+		if (length > 0.0f)
+		{
+			dx = n.x / length - b.VertexNormalVector.x; dy = n.y / length - b.VertexNormalVector.y; dz = n.z / length - b.VertexNormalVector.z;
+			e = sqrt(dx * dx + dy * dy + dz * dz);
+			if (e > Error.VertexNormalVector) Error.VertexNormalVector = e;
+		}
+
+		dx = a.VertexTextureCoordinate.x - b.VertexTextureCoordinate.x; dy = a.VertexTextureCoordinate.y - b.VertexTextureCoordinate.y;
+		e = sqrt(dx * dx + dy * dy);
+		if (e > Error.VertexTextureCoordinate) Error.VertexTextureCoordinate = e;
+	}
+}
@@ -0,0 +1,89 @@
+// vertexPacking Header File
+// Version 3.1
+//
+// Description
+// Packed vertex format Header File
+// This header file contains the declarations used to pack the 32 byte VERTEX structures of OurVertices into 16 byte PACKEDVERTEX structures, halving the size of the vertex buffer and the memory read by the GPU to fetch each vertex,
+// and to unpack them again exactly as the vertex shader does, so that the error introduced by packing can be measured on the CPU.
+// Include it in all source files that pack vertices, e.g., the objRenderer program.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Wavefront .obj file I/O Header File.
+// Declares the VERTEX structure and the DWORD data type, and includes the DirectXMath Header File.
+#include "objReader.h"
+
+// Standard Definitions.
+#include <cstddef>											// Required for the size_t data type.
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the PACKEDVERTEX 'named structure' data type.
+// A PACKEDVERTEX holds the same vertex attributes as a VERTEX, in 16 bytes instead of 32:
+//   GeometricVertex:		  Each coordinate is quantized to a 16-bit unsigned integer, from 0 at the minimum to 65535 at the maximum of that coordinate over all vertices (the mesh's axis-aligned bounding box, see VertexPackingBounds).
+//							  The fourth integer is unused and always 0, because the input-assembler stage of the graphics pipeline has no three-component 16-bit format.
+//   VertexNormalVector:	  The direction of the vertex normal vector is mapped onto an octahedron, which is unfolded onto a square, and the two coordinates of the square are each stored as a 16-bit signed integer, from -32767 (-1.0) to 32767 (1.0).
+//   VertexTextureCoordinate: Each coordinate is quantized to a 16-bit unsigned integer, from 0 at the minimum to 65535 at the maximum of that coordinate over all vertices.
+// If the PACKEDVERTEX structure is changed then the packed input element description structure (defined in objRenderer.cpp) and the PACKED_VERTEX part of the VShader function (defined in shaders.hlsl) must be changed accordingly.
+struct PACKEDVERTEX {
+	unsigned short GeometricVertex[4];						// DXGI_FORMAT_R16G16B16A16_UNORM.
+	short VertexNormalVector[2];							// DXGI_FORMAT_R16G16_SNORM.
+	unsigned short VertexTextureCoordinate[2];				// DXGI_FORMAT_R16G16_UNORM.
+};
+
+// Declare the VertexPackingBounds 'named structure' data type.
+// The range of each quantized coordinate, computed from all vertices of a mesh by the ComputeVertexPackingBounds function.
+// A quantized coordinate q (0 to 65535) is unpacked as Minimum + q / 65535 * Scale, where Scale is the maximum minus the minimum. The vertex shader receives these values in the constant buffer.
+struct VertexPackingBounds {
+	XMFLOAT3 GeometricVertexMinimum = { 0.0f, 0.0f, 0.0f };
+	XMFLOAT3 GeometricVertexScale = { 0.0f, 0.0f, 0.0f };
+	XMFLOAT2 VertexTextureCoordinateMinimum = { 0.0f, 0.0f };
+	XMFLOAT2 VertexTextureCoordinateScale = { 0.0f, 0.0f };
+};
+
+// Declare the VertexPackingError 'named structure' data type.
+// The largest distance between a vertex attribute and the same vertex attribute after it is packed and unpacked, as either guaranteed by the VertexPackingErrorBound function or measured by the MeasureVertexPackingError function.
+struct VertexPackingError {
+	float GeometricVertex = 0.0f;							// In the units of the Wavefront .obj file.
+	float VertexNormalVector = 0.0f;						// Between unit vectors, i.e., approximately the angle in radians.
+	float VertexTextureCoordinate = 0.0f;					// In texture coordinates (1.0 is the width or height of the texture image).
+};
+
+// End: Structure Declarations.
+
+//***
+// External Variable Global Declarations.
+//***
+
+// VertexPackingEnabled selects whether the objRenderer program copies PACKEDVERTEX structures (true) or VERTEX structures (false) to the vertex buffer. It is false by default, because packing changes the vertex attributes slightly (see VertexPackingErrorBound).
+extern bool VertexPackingEnabled;
+
+// End: External Variable Global Declarations.
+
+//***
+// Global Function Declarations.
+//***
+
+void ComputeVertexPackingBounds(const VERTEX* Vertices, int VertexAttributeSetsTotal, VertexPackingBounds& Bounds);								// The ComputeVertexPackingBounds function computes the range of each coordinate over all Vertices.
+void PackVertices(const VERTEX* Vertices, int VertexAttributeSetsTotal, const VertexPackingBounds& Bounds, PACKEDVERTEX* PackedVertices);		// The PackVertices function packs Vertices into PackedVertices.
+void UnpackVertices(const PACKEDVERTEX* PackedVertices, int VertexAttributeSetsTotal, const VertexPackingBounds& Bounds, VERTEX* Vertices);	// The UnpackVertices function unpacks PackedVertices into Vertices, with the same arithmetic as the VShader function. Each vertex normal vector is unpacked as a unit vector.
+void PackIndices(const DWORD* Indices, size_t IndicesTotal, unsigned short* PackedIndices);														// The PackIndices function converts 32-bit indices to 16-bit indices. Every index must be less than 65536.
+void VertexPackingErrorBound(const VertexPackingBounds& Bounds, VertexPackingError& Error);														// The VertexPackingErrorBound function returns the largest error that packing vertices within Bounds can introduce.
+void MeasureVertexPackingError(const VERTEX* Vertices, int VertexAttributeSetsTotal, const VertexPackingBounds& Bounds, VertexPackingError& Error);	// The MeasureVertexPackingError function packs and unpacks Vertices, and returns the largest error found.
+
+// End: Global Function Declarations.
+
+// End: Global Declarations.
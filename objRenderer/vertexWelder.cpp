@@ -0,0 +1,219 @@
+// vertexWelder
+// Version 3.1
+//
+// Description
+// These functions merge the sets of vertex attributes of a mesh that are within a tolerance of each other, rather than exactly equal, and change its indices to match.
+//
+// Each set of vertex attributes is compared, in order, with the sets of vertex attributes already kept whose geometric vertices lie in the 8 cells of the spatial hash nearest its own.
+// It is merged with the one kept first that is within every tolerance; otherwise it is kept, and added to the spatial hash. Merging only with sets of vertex attributes already kept, rather than with any set of vertex attributes within the tolerances,
+// means that a chain of sets of vertex attributes, each within the tolerances of the next, cannot be merged into one set of vertex attributes far from some of them.
+// The sets of vertex attributes kept remain in the order they were first found in the Wavefront .obj file, and are not changed.
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Vertex welding Header File.
+// Includes the Wavefront .obj file I/O Header File.
+#include "vertexWelder.h"
+
+// Unordered Map Container Class.
+#include <unordered_map>									// Unordered map class, used to hold the spatial hash.
+
+// Mathematical Functions.
+#include <cmath>											// Mathematical functions floor, cos, sqrt, fabs.
+
+// Memory Functions.
+#include <cstring>											// Memory function memcpy.
+
+// Using Declarations and Directives.
+using std::vector;
+using std::unordered_map;
+using std::floor;
+using std::cos;
+using std::sqrt;
+using std::fabs;
+using std::memcpy;
+
+//***
+// External Variable Global Definitions.
+//***
+
+bool VertexWelderEnabled = false;
+VertexWeldOptions VertexWelderTolerances;
+VertexWeldStatistics VertexWeldResult;
+
+// End: External Variable Global Definitions.
+
+// The cell of the spatial hash holding a geometric vertex.
+struct WeldCellKey {
+	long long x;
+	long long y;
+	long long z;
+	bool operator==(const WeldCellKey& other) const { return x == other.x && y == other.y && z == other.z; }
+};
+struct WeldCellKeyHash {
+	size_t operator()(const WeldCellKey& key) const
+	{
+		// Combine the three cell coordinates into one 64-bit value and mix its bits, so that neighboring cells are spread across the hash table.
+		unsigned long long h = (unsigned long long)key.x;
+		h = h * 0x9E3779B97F4A7C15ULL + (unsigned long long)key.y;
+		h = h * 0x9E3779B97F4A7C15ULL + (unsigned long long)key.z;
+		h ^= h >> 29;
+		return (size_t)h;
+	}
+};
+
+// The largest cell coordinate, so that a geometric vertex far from the origin, relative to the position tolerance, does not overflow a cell coordinate. Geometric vertices beyond it share the outermost cells.
+static const double WeldCellCoordinateLimit = 1099511627776.0;	// 2 to the power of 40.
+
+// End: Global Declarations.
+
+//***
+// Function Definitions.
+//***
+
+// WeldCellCoordinate function: Definition
+//   This function returns the cell coordinate of one coordinate of a geometric vertex, and in Side the direction (-1 or 1) of the neighboring cell nearer the coordinate, which is the only neighboring cell in that direction that can hold a coordinate within the position tolerance.
+//   With a position tolerance of 0 (InverseCellSize 0), the cell coordinate is the bits of the coordinate, so only exactly equal coordinates share a cell, and Side is 0.
+static long long WeldCellCoordinate(float Coordinate, double InverseCellSize, int& Side)
+{
+	if (InverseCellSize == 0.0)
+	{
+		float value = Coordinate + 0.0f;					// Adding 0.0f converts -0.0f to 0.0f, because -0.0f == 0.0f is true and both must therefore share a cell.
+		unsigned int bits;
+		memcpy(&bits, &value, sizeof(bits));
+		Side = 0;
+		return bits;
+	}
+	double scaled = Coordinate * InverseCellSize;
+	double cell = floor(scaled);
+	Side = scaled - cell < 0.5 ? -1 : 1;
+	if (cell > WeldCellCoordinateLimit)
+		cell = WeldCellCoordinateLimit;
+	if (cell < -WeldCellCoordinateLimit)
+		cell = -WeldCellCoordinateLimit;
+	return (long long)cell;
+}
+
+// WeldWithin function: Definition
+//   This function returns true if the set of vertex attributes b is within the tolerances of the set of vertex attributes a.
+//   Vertex normal vectors need not be unit vectors, so the cosine of the angle between them is compared as their dot product divided by the product of their lengths. A zero vector is only within the tolerance of a zero vector.
+static bool WeldWithin(const VERTEX& a, const VERTEX& b, float PositionToleranceSquared, float NormalCosineTolerance, float TextureCoordinateTolerance)
+{
+	float dx = a.GeometricVertex.x - b.GeometricVertex.x;
+	float dy = a.GeometricVertex.y - b.GeometricVertex.y;
+	float dz = a.GeometricVertex.z - b.GeometricVertex.z;
+	if (dx * dx + dy * dy + dz * dz > PositionToleranceSquared)
+		return false;
+
+	if (fabs(a.VertexTextureCoordinate.x - b.VertexTextureCoordinate.x) > TextureCoordinateTolerance ||
+		fabs(a.VertexTextureCoordinate.y - b.VertexTextureCoordinate.y) > TextureCoordinateTolerance)
+		return false;
+
+	const XMFLOAT3& na = a.VertexNormalVector;
+	const XMFLOAT3& nb = b.VertexNormalVector;
+	if (na.x == nb.x && na.y == nb.y && na.z == nb.z)
+		return true;
+	float dot = na.x * nb.x + na.y * nb.y + na.z * nb.z;
+	float lengthsSquared = (na.x * na.x + na.y * na.y + na.z * na.z) * (nb.x * nb.x + nb.y * nb.y + nb.z * nb.z);
+	if (lengthsSquared == 0.0f)
+		return false;
+	return dot >= NormalCosineTolerance * sqrt(lengthsSquared);
+}
+
+// WeldVertices function: Definition
+//   The sets of vertex attributes kept are moved to the front of Vertices in place, because a set of vertex attributes kept is never moved after a later one.
+//   A triangle left with two identical indices is removed, because it has no area and is not drawn, so Indices may be shorter after welding. Its third set of vertex attributes may then be referenced by no index, but is kept.
+void WeldVertices(vector<VERTEX>& Vertices, vector<DWORD>& Indices, const VertexWeldOptions& Options, VertexWeldStatistics& Statistics)
+{
+	Statistics = VertexWeldStatistics();
+	Statistics.VerticesBefore = (int)Vertices.size();
+
+	// The tolerances, in the form they are compared in. A negative tolerance is treated as 0.
+	// A vertex normal vector tolerance of 0 is compared as a cosine of 2, which no two vertex normal vectors reach, so only exactly equal vertex normal vectors are within it, as in the objReader function,
+	// rather than a cosine of 1, which vertex normal vectors of different lengths, or a few units in the last place apart, reach after rounding.
+	float positionTolerance = Options.PositionTolerance > 0.0f ? Options.PositionTolerance : 0.0f;
+	float positionToleranceSquared = positionTolerance * positionTolerance;
+	float normalCosineTolerance = Options.NormalAngleDegrees > 0.0f ? (float)cos(Options.NormalAngleDegrees * 3.14159265358979323846 / 180.0) : 2.0f;
+	float textureCoordinateTolerance = Options.TextureCoordinateTolerance > 0.0f ? Options.TextureCoordinateTolerance : 0.0f;
+
+	// Each cell is twice as wide as the position tolerance, so a geometric vertex within the tolerance of another lies in the same cell, or in the neighboring cell on the nearer side in one or more axes: 8 cells in all, rather than the 27 searched with cells as wide as the tolerance.
+	// With a position tolerance of 0, only the cell of the geometric vertex itself is searched.
+	double inverseCellSize = positionTolerance > 0.0f ? 0.5 / positionTolerance : 0.0;
+
+	// The spatial hash: CellFirst maps a cell to the set of vertex attributes kept in it most recently, and CellNext links each set of vertex attributes kept to the one kept before it in the same cell (-1 for none).
+	unordered_map<WeldCellKey, int, WeldCellKeyHash> CellFirst;
+	CellFirst.reserve(Vertices.size());
+	vector<int> CellNext;
+	CellNext.reserve(Vertices.size());
+
+	// Remap maps the index of each set of vertex attributes before welding to its index after welding.
+	vector<DWORD> Remap(Vertices.size());
+	int kept = 0;											// The number of sets of vertex attributes kept so far.
+
+	for (size_t v = 0; v < Vertices.size(); v++)
+	{
+		const VERTEX vertex = Vertices[v];
+		int side[3];
+		WeldCellKey cell = { WeldCellCoordinate(vertex.GeometricVertex.x, inverseCellSize, side[0]),
+							 WeldCellCoordinate(vertex.GeometricVertex.y, inverseCellSize, side[1]),
+							 WeldCellCoordinate(vertex.GeometricVertex.z, inverseCellSize, side[2]) };
+		int cellsTotal = side[0] == 0 ? 1 : 8;
+
+		// Search the cells around the geometric vertex for the first set of vertex attributes kept that is within the tolerances.
+		// Every cell is searched, and the set of vertex attributes found first in the Wavefront .obj file is preferred, so the result does not depend on the order the cells and their lists are searched in.
+		int match = -1;
+		for (int c = 0; c < cellsTotal; c++)
+		{
+			// Bits 0, 1, and 2 of c select whether the neighboring cell is taken in the x, y, and z axis.
+			auto found = CellFirst.find(WeldCellKey{ cell.x + (c & 1 ? side[0] : 0), cell.y + (c & 2 ? side[1] : 0), cell.z + (c & 4 ? side[2] : 0) });
+			if (found == CellFirst.end())
+				continue;
+			for (int candidate = found->second; candidate != -1; candidate = CellNext[candidate])
+				if ((match == -1 || candidate < match) && WeldWithin(Vertices[candidate], vertex, positionToleranceSquared, normalCosineTolerance, textureCoordinateTolerance))
+					match = candidate;
+		}
+
+		if (match != -1)
+		{
+			Remap[v] = (DWORD)match;
+			continue;
+		}
+
+		// Keep the set of vertex attributes, and add it to the front of its cell's list.
+		Vertices[kept] = vertex;
+		auto inserted = CellFirst.emplace(cell, kept);
+		CellNext.push_back(inserted.second ? -1 : inserted.first->second);
+		inserted.first->second = kept;
+		Remap[v] = (DWORD)kept;
+		kept++;
+	}
+	Vertices.resize(kept);
+	Vertices.shrink_to_fit();
+
+	// Change the indices to match, removing the triangles left with two identical indices.
+	size_t indicesKept = 0;
+	for (size_t t = 0; t + 2 < Indices.size(); t += 3)
+	{
+		DWORD a = Remap[Indices[t]];
+		DWORD b = Remap[Indices[t + 1]];
+		DWORD c = Remap[Indices[t + 2]];
+		if (a == b || b == c || c == a)
+		{
+			Statistics.PrimitivesRemoved++;
+			continue;
+		}
+		Indices[indicesKept++] = a;
+		Indices[indicesKept++] = b;
+		Indices[indicesKept++] = c;
+	}
+	Indices.resize(indicesKept);
+	Indices.shrink_to_fit();
+
+	Statistics.VerticesAfter = kept;
+	Statistics.BytesSaved = (size_t)(Statistics.VerticesBefore - Statistics.VerticesAfter) * sizeof(VERTEX) + (size_t)Statistics.PrimitivesRemoved * 3 * sizeof(DWORD);
+}
@@ -0,0 +1,80 @@
+// vertexWelder Header File
+// Version 3.1
+//
+// Description
+// Vertex welding Header File
+// This header file contains the declarations used to merge ("weld") sets of vertex attributes of OurVertices that are nearly, rather than exactly, identical.
+// The objReader function merges two sets of vertex attributes only if their floating-point values are exactly equal (==). Wavefront .obj files exported by modeling tools often contain tiny floating-point differences
+// between what is meant to be the same vertex, e.g., a vertex shared by two faces written twice with different rounding, so such sets of vertex attributes are kept apart and the vertex buffer is larger than necessary.
+// Welding merges two sets of vertex attributes when every attribute is within its own tolerance: the distance between the geometric vertices, the angle between the vertex normal vectors, and the difference of each vertex texture coordinate.
+// The geometric vertices are placed in a grid of cells twice as wide as the position tolerance, held in a hash table (a spatial hash), so each set of vertex attributes is only compared with those in the 8 cells nearest it, and welding takes time proportional to the number of vertices.
+// Include it in all source files that weld vertices, e.g., the objRenderer program.
+//
+// Header files should not contain "using directives" (such as "using namespace std") or "using declarations" (such as "using std::cout").
+//
+// Authorship
+// Robert John Tortorelli
+
+//***
+// Global Declarations.
+//***
+
+// Pragma Directives.
+// Specify that the compiler include this header file only once when compiling source code files.
+#pragma once
+
+// Wavefront .obj file I/O Header File.
+// Declares the VERTEX structure and the DWORD data type, and includes the Vector Container Class.
+#include "objReader.h"
+
+// Standard Definitions.
+#include <cstddef>											// Required for the size_t data type.
+
+//***
+// Structure Declarations.
+//***
+
+// Declare the VertexWeldOptions 'named structure' data type.
+// The tolerances within which the WeldVertices function merges two sets of vertex attributes. All three must be met.
+struct VertexWeldOptions {
+	float PositionTolerance = 1.0e-5f;						// The largest distance between the geometric vertices, in object space units. 0 merges only geometric vertices that are exactly equal.
+	float NormalAngleDegrees = 1.0f;						// The largest angle between the vertex normal vectors, in degrees. 0 merges only vertex normal vectors that are exactly equal.
+	float TextureCoordinateTolerance = 1.0e-5f;				// The largest difference of each vertex texture coordinate (u and v), in texture space units.
+};
+
+// Declare the VertexWeldStatistics 'named structure' data type.
+// What the WeldVertices function saved.
+struct VertexWeldStatistics {
+	int VerticesBefore = 0;									// The number of sets of vertex attributes before welding.
+	int VerticesAfter = 0;									// The number of sets of vertex attributes after welding.
+	int PrimitivesRemoved = 0;								// The number of triangle primitives removed because welding merged two of their vertices, i.e., triangles too small to be drawn.
+	size_t BytesSaved = 0;									// The bytes by which the vertex attributes and indices are smaller after welding.
+};
+
+// End: Structure Declarations.
+
+//***
+// External Variable Global Declarations.
+//***
+
+// VertexWelderEnabled selects whether the objRenderer program welds OurVertices with the WeldVertices function after parsing the Wavefront .obj file, before optimizing the mesh. It is false by default.
+// Welding may change the image slightly, because each merged set of vertex attributes is replaced by the first one found, which differs from it by at most the tolerances.
+extern bool VertexWelderEnabled;
+//
+// VertexWelderTolerances are the tolerances the objRenderer program welds with.
+extern VertexWeldOptions VertexWelderTolerances;
+//
+// VertexWeldResult is the VertexWeldStatistics of the most recent welding by the objRenderer program.
+extern VertexWeldStatistics VertexWeldResult;
+
+// End: External Variable Global Declarations.
+
+//***
+// Global Function Declarations.
+//***
+
+void WeldVertices(std::vector<VERTEX>& Vertices, std::vector<DWORD>& Indices, const VertexWeldOptions& Options, VertexWeldStatistics& Statistics);	// The WeldVertices function merges the sets of vertex attributes of Vertices that are within the tolerances of Options, changes Indices to match, and removes the triangles left with two identical indices.
+
+// End: Global Function Declarations.
+
+// End: Global Declarations.